@@ -114,10 +114,15 @@ private:
 	void LoadActiveDirectory();
 
 	/**
-	@brief Check and reload unloaded resources from the assets folder
+	@brief Import the new source files of the assets folder and import again the changed ones, when they are not watched
 	*/
 	void CheckResourceToReload();
 
+	/**
+	@brief Import the source files reported by the watcher of the assets folder
+	*/
+	void ReimportWatchedFiles();
+
 	/**
 	@brief Change active directory to the directory with the given path
 
@@ -35,7 +35,7 @@ static const char* pickingVertexShaderStr = R"GLSL(
 
 // Attributes
 
-layout(location = 0) in vec3 aPosition;
+layout(location = 0) in vec4 aPosition;
 
 //  Uniform Buffers
 
@@ -49,11 +49,17 @@ layout (std140, binding = 0) uniform UBO_matrices
 
 uniform mat4 uModel;
 
+//  VERTEX DECODING :
+//    position offset     |       ...
+//    position scale      |       ...
+
+uniform vec4 uVertexDecode[2];
+
 //  Functions
 
 void main()
 {
-    gl_Position = uProjection * uView * uModel * vec4(aPosition, 1.0);
+    gl_Position = uProjection * uView * uModel * vec4(uVertexDecode[0].xyz + aPosition.xyz * uVertexDecode[1].xyz, 1.0);
 
 })GLSL";
 
@@ -214,15 +220,16 @@ void RenderPicking::Initialize()
 
 void RenderPicking::DrawMesh(const MeshInstance* instance)
 {
+    if (instance->mesh->GPUData == nullptr || instance->mesh->GPUData->uploadTicket != 0)
+        return;
+
     m_meshShader.SendUniform("uModel", instance->transform->GetWorldMatrix().elements);
 
-    glDrawElementsBaseVertex(
-        GL_TRIANGLES,
-        static_cast<GLsizei>(instance->mesh->indices.size()),
-        GL_UNSIGNED_INT,
-        instance->mesh->indices.data(),
-        instance->mesh->GPUData->offset
-    );
+    RenderSystem& renderSystem = SystemManager::GetRenderSystem();
+    renderSystem.GPUWrapper.GetMeshVAO(instance->mesh->GPUData->layout).Bind();
+    RenderGPUWrapper::SendVertexDecoding(m_meshShader.GetLocationFromUniformName("uVertexDecode[0]"), *instance->mesh->GPUData);
+
+    RenderGPUWrapper::DrawElements(*instance->mesh);
 }
 
 
@@ -231,13 +238,7 @@ void RenderPicking::DrawSkeletalMesh(const SkeletalMeshInstance* instance)
     m_skeletalMeshShader.SendUniform("uModel", instance->transform->GetWorldMatrix().elements);
     m_skeletalMeshShader.SendUniform("uSkinningMatrices[0]", instance->skeleton->boneTransforms.data(), static_cast<int>(instance->skeleton->boneTransforms.size()));
 
-    glDrawElementsBaseVertex(
-        GL_TRIANGLES,
-        static_cast<GLsizei>(instance->mesh->indices.size()),
-        GL_UNSIGNED_INT,
-        instance->mesh->indices.data(),
-        instance->mesh->GPUData->offset
-    );
+    RenderGPUWrapper::DrawElements(*instance->mesh);
 }
 
 template<DerivedComponent comp>
@@ -284,7 +285,6 @@ void RenderPicking::RenderIDs()
     RenderSystem& renderSystem = SystemManager::GetRenderSystem();
 
     m_meshShader.Bind();
-    renderSystem.GPUWrapper.meshVAO.Bind();
 
     int i = 0;
 
@@ -307,6 +307,10 @@ void RenderPicking::RenderIDs()
 
     Matrix4 billboardRotationMatrix = Quaternion::ToMatrix(SystemManager::GetCameraSystem().renderingCamera->GetBillboardRotation());
 
+    // The gizmo rect has float positions
+    const float gizmoDecoding[8] = { 0.f, 0.f, 0.f, 0.f, 1.f, 1.f, 1.f, 0.f };
+    m_meshShader.SendUniform("uVertexDecode[0]", gizmoDecoding, 2);
+
     m_rectVAO.Bind();
     for (const GameObject* instance : m_gizmoGameObjects)
     {
@@ -113,9 +113,9 @@ const MeshShader& GetMeshShader(ShaderType type)
 
 void RenderPreview::RenderMaterials()
 {
-	if (!m_materialSphereMesh) return;
+	if (!m_materialSphereMesh || !m_materialSphereMesh->GPUData) return;
 
-	glBindVertexArray(SystemManager::GetRenderSystem().GPUWrapper.meshVAO.GetID());
+	SystemManager::GetRenderSystem().GPUWrapper.GetMeshVAO(m_materialSphereMesh->GPUData->layout).Bind();
 
 	std::sort(m_materialsToRenderPreview.begin(), m_materialsToRenderPreview.end(), [](Material const* mat0, Material const* mat1) {
 		return mat0->surface < mat1->surface;
@@ -184,8 +184,8 @@ void RenderPreview::RenderMeshes()
 {
 	RenderSystem& renderSystem = SystemManager::GetRenderSystem();
 
-	glBindVertexArray(renderSystem.GPUWrapper.meshVAO.GetID());
 	renderSystem.litShader.BindMeshShader();
+	const VertexArray* boundVAO = nullptr;
 
 	for (const Mesh* mesh : m_meshesToRenderPreview)
 	{
@@ -203,6 +203,10 @@ void RenderPreview::RenderMeshes()
 
 		for (const MeshData& subMesh : mesh->subMeshes)
 		{
+			if (!subMesh.GPUData) continue;
+
+			renderSystem.GPUWrapper.BindMeshVAO(*subMesh.GPUData, boundVAO);
+
 			MaterialData const* data = subMesh.material ? &subMesh.material->data : nullptr;
 			SystemManager::GetRenderSystem().litShader.DrawMesh(modelMatrix, subMesh, data);
 		}
@@ -325,12 +329,13 @@ void RenderPreview::RenderModels()
 
 			//	Else if it is a mesh
 
-			//	Bind MESH vao
-			glBindVertexArray(renderSystem.GPUWrapper.meshVAO.GetID());
-
 			int i = 0;
 			for (const MeshData& subMesh : mesh->subMeshes)
 			{
+				//	Bind the vao of the vertex layout
+				if (subMesh.GPUData)
+					renderSystem.GPUWrapper.GetMeshVAO(subMesh.GPUData->layout).Bind();
+
 				//	Get material and binded shader
 				const Material* material = (matCount > 0 && materials[i % matCount]) ? materials[i % matCount] : nullptr;
 				const MeshShader& shader = material ? GetMeshShader(material->shader) : renderSystem.litShader;
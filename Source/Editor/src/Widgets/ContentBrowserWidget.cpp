@@ -11,6 +11,7 @@
 #include <IO/Mouse.hpp>
 #include <IO/Window.hpp>
 #include <Core/Time.hpp>
+#include <Core/Logger.hpp>
 #include <Core/TaskQueue.hpp>
 #include <EngineContext.hpp>
 #include <Renderer/RenderSystem.hpp>
@@ -23,8 +24,10 @@
 #include <Resources/Resource/Terrain.hpp>
 #include <Resources/Loaders/ResourcesLoader.hpp>
 #include <Resources/SceneManager.hpp>
+#include <Resources/SourceAssetTracker.hpp>
 #include <Refureku/Refureku.h>
 #include <Tools/Curves.hpp>
+#include <Tools/FileWatcher.hpp>
 
 #include "PathConfig.hpp"
 #include "EditorContext.hpp"
@@ -104,6 +107,13 @@ struct PimplContentBrowser
 
 	CallbackID focusReloadID;
 
+	//	Records of the source files of the assets, only the changed ones are imported again
+	SourceAssetTracker sourceAssets = SourceAssetTracker(ASSETS_ROOT_RAW, SourceAssetTracker::GetDefaultManifestPath(ASSETS_ROOT_RAW));
+
+	//	Changes of the source files reported while the editor runs, the tree is only walked again on lost events
+	FileWatcher sourceWatcher = FileWatcher(ASSETS_ROOT_RAW, &SourceAssetTracker::IsSourceAsset);
+	std::vector<FileWatcher::Event> sourceEvents;
+
 	std::vector<std::string> showedExtensions = 
 	{
 		".model",
@@ -155,6 +165,10 @@ ContentBrowserWidget::ContentBrowserWidget(const std::string& widgetName, const
 	m_pimpl->prefabTexture = img->LoadImage(R"(Icons\Prefab.texture)");
 	
 	LoadDirectoryTree(m_pimpl->rootDir);
+
+	//	Files changed while the editor was closed, the watcher reports the next changes
+	CheckResourceToReload();
+	m_pimpl->sourceWatcher.Start();
 	
 	m_pimpl->focusReloadID = EditorContext::Instance().window->focusEvent.AddCallback(&ContentBrowserWidget::CheckResourceToReload, *this);
 	m_pimpl->focusReloadID = EditorContext::Instance().window->focusEvent.AddCallback(&ContentBrowserWidget::LoadActiveDirectory, *this);
@@ -173,6 +187,8 @@ ContentBrowserWidget::~ContentBrowserWidget()
 void ContentBrowserWidget::Update()
 {
 	m_pimpl->consumeClick = false;
+	ReimportWatchedFiles();
+
 	if (m_pimpl->refreshFolder)
 	{
 		LoadActiveDirectory();
@@ -215,7 +231,44 @@ void ContentBrowserWidget::UnloadDirectoryTree(Directory& directory)
 
 void ContentBrowserWidget::CheckResourceToReload()
 {
-	ResourcesLoader::LoadNotCachedResources(m_pimpl->rootDir.path.string());
+	//	The watcher already reports the changes made while the editor was not focused
+	if (m_pimpl->sourceWatcher.IsRunning())
+		return;
+
+	std::vector<Resource*> reimported;
+	ResourcesLoader::ReimportChangedResources(m_pimpl->sourceAssets, reimported);
+
+	for (Resource* resource : reimported)
+		EditorContext::Instance().resourcePreview->GenerateResourcePreview(*resource);
+}
+
+void ContentBrowserWidget::ReimportWatchedFiles()
+{
+	std::vector<FileWatcher::Event>& events = m_pimpl->sourceEvents;
+	events.clear();
+	if (!m_pimpl->sourceWatcher.PollEvents(events))
+		return;
+
+	std::vector<Resource*> reimported;
+	if (events.front().type == FileWatcher::EEvent::RESCAN)
+	{
+		Logger::Warning("Source assets events were lost, check of the whole assets folder");
+		ResourcesLoader::ReimportChangedResources(m_pimpl->sourceAssets, reimported);
+	}
+	else
+	{
+		std::vector<std::string> paths;
+		paths.reserve(events.size());
+		for (const FileWatcher::Event& event : events)
+			paths.emplace_back(event.path);
+
+		ResourcesLoader::ReimportChangedFiles(m_pimpl->sourceAssets, paths, reimported);
+	}
+
+	for (Resource* resource : reimported)
+		EditorContext::Instance().resourcePreview->GenerateResourcePreview(*resource);
+
+	m_pimpl->refreshFolder = true;
 }
 
 void ContentBrowserWidget::LoadActiveDirectory()
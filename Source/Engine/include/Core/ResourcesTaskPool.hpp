@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mutex>
 #include <thread>
 #include <queue>
 #include <atomic>
@@ -14,6 +15,18 @@ class ResourcesTaskPool
 {
 	using Task = std::function<void()>;
 
+	/**
+	@brief Progress of a ParallelFor call, shared between the caller and its helper tasks
+	*/
+	struct ParallelForState
+	{
+		std::atomic<size_t> nextChunk = { 0 };
+		std::atomic<size_t> remainingChunks = { 0 };
+
+		std::mutex doneMutex;
+		std::condition_variable doneNotifier;
+	};
+
 private:
 	// Mutex to synchronize access to task queue
 	std::mutex m_queueMutex;
@@ -29,7 +42,7 @@ private:
 	std::queue<Task> m_singleTasks;
 	std::vector<std::jthread> m_threads;
 
-	bool m_shutDown = false;
+	std::atomic<bool> m_shutDown = false;
 
 
 public:
@@ -74,6 +87,16 @@ public:
 	@brief Wait till the task pool is running
 	*/
 	void WaitingForMultiTasksCompletion();
+
+	/**
+	@brief Split a range in chunks run by the caller and by multi tasks, and wait for the completion of these chunks only.
+	Can be called from a task of the pool.
+
+	@param count : Number of elements of the range
+	@param chunkSize : Max number of elements handled by one task
+	@param function : Called with the [begin, end) range of each chunk
+	*/
+	void ParallelFor(size_t count, size_t chunkSize, const std::function<void(size_t, size_t)>& function);
 };
 
 #include "Core/ResourcesTaskPool.inl"
\ No newline at end of file
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <string>
+
+#include "Core/SlabPool.hpp"
+#include "ECS/GameObject.hpp"
+#include "EngineDLL.hpp"
+
+/**
+@brief Memory owned by a scene. GameObjects have their own typed pool and components are
+spread in size class pools, so objects of one scene live contiguously and are freed all together.
+Allocations and deallocations are thread-safe, the pools lock themselves.
+*/
+class SceneAllocator
+{
+public:
+	/**
+	@brief Redirect component allocations of the current thread to an allocator while alive
+	*/
+	class Scope
+	{
+	private:
+		SceneAllocator* m_previous = nullptr;
+
+	public:
+		Scope(SceneAllocator* allocator);
+		~Scope();
+
+		Scope(Scope const&) = delete;
+		Scope& operator=(Scope const&) = delete;
+	};
+
+//	Variables
+
+private:
+	SlabPool m_gameObjectPool;
+
+	// One pool per size class, sorted by block size
+	std::vector<std::unique_ptr<SlabPool>> m_componentPools;
+
+//	Constructors
+
+public:
+	SceneAllocator();
+	~SceneAllocator() = default;
+
+	SceneAllocator(SceneAllocator const&) = delete;
+	SceneAllocator& operator=(SceneAllocator const&) = delete;
+
+//	Functions
+
+public:
+	/**
+	@brief Construct a gameobject in the gameobject pool
+
+	@param args : GameObject constructor arguments
+
+	@return PoolPtr<GameObject> : Created gameobject
+	*/
+	template <typename... TArgs>
+	PoolPtr<GameObject> NewGameObject(TArgs&&... args);
+
+	/**
+	@brief Allocate memory for a component in the smallest size class that fits.
+	Sizes bigger than the largest class fall back to the heap.
+
+	@param size : Size of the component
+
+	@return void* : Memory allocated
+	*/
+	void* AllocateComponent(size_t size);
+
+	/**
+	@brief Allocate memory for a component with the allocator of the current scope,
+	on the heap if there is no scope
+
+	@param size : Size of the component
+
+	@return void* : Memory allocated
+	*/
+	static void* Allocate(size_t size);
+
+	/**
+	@brief Free memory allocated by any scene allocator or its heap fallback
+
+	@param ptr : Memory to free
+	*/
+	static void Deallocate(void* ptr);
+
+	/**
+	@brief Free all pools at once, should be called once every object of the scene is destroyed
+
+	@return bool : true if every pool has been released
+	*/
+	bool Release();
+
+	/**
+	@brief Get the occupancy of every pool, the gameobject pool comes first
+
+	@return std::vector<PoolStats> : Stats of each pool
+	*/
+	ENGINE_API std::vector<PoolStats> GetStats() const;
+
+	/**
+	@brief Log the occupancy and fragmentation of the non empty pools
+
+	@param ownerName : Name displayed in the log
+	*/
+	ENGINE_API void LogStats(const std::string& ownerName) const;
+};
+
+#include "Core/SceneAllocator.inl"
@@ -0,0 +1,9 @@
+#include <new>
+#include <utility>
+
+template <typename... TArgs>
+PoolPtr<GameObject> SceneAllocator::NewGameObject(TArgs&&... args)
+{
+	void* memory = m_gameObjectPool.Allocate();
+	return PoolPtr<GameObject>(new (memory) GameObject(std::forward<TArgs>(args)...));
+}
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <cstddef>
+
+#include "EngineDLL.hpp"
+
+/**
+@brief Snapshot of a pool occupancy
+*/
+struct PoolStats
+{
+	size_t blockSize = 0;	// Size of one object in the pool
+	size_t slabCount = 0;	// Number of slabs currently allocated
+	size_t capacity = 0;	// Number of blocks of all slabs
+	size_t liveCount = 0;	// Number of blocks currently in use
+	size_t peakCount = 0;	// Highest number of blocks used at the same time
+	size_t holeCount = 0;	// Free blocks held by slabs that still contain live blocks
+
+	/**
+	@brief Get the ratio of used blocks
+
+	@return float : live blocks / capacity (0 if the pool is empty)
+	*/
+	inline float Occupancy() const;
+
+	/**
+	@brief Get the ratio of free blocks that can't be given back because their slab is still in use
+
+	@return float : holes / free blocks (0 if there is no free block)
+	*/
+	inline float Fragmentation() const;
+};
+
+/**
+@brief Fixed size block allocator. Blocks are carved from slabs allocated on demand
+and released all together, so objects allocated in a row live contiguously.
+Every block is prefixed by a header pointing to its pool, allowing to free it without knowing its pool.
+Thread-safe : components are created and destroyed by loading workers as well as by the main thread.
+*/
+class SlabPool
+{
+public:
+	struct alignas(__STDCPP_DEFAULT_NEW_ALIGNMENT__) BlockHeader
+	{
+		SlabPool* pool = nullptr;	// nullptr when the block comes from the heap
+		size_t slabIndex = 0;
+	};
+
+private:
+	struct Slab
+	{
+		std::unique_ptr<std::byte[]> memory;
+		size_t liveCount = 0;
+	};
+
+//	Variables
+
+private:
+	size_t m_blockSize = 0;
+	size_t m_stride = 0;
+	size_t m_blocksPerSlab = 0;
+
+	std::vector<Slab> m_slabs;
+
+	// Free blocks store the next free block in their first bytes
+	BlockHeader* m_freeList = nullptr;
+
+	size_t m_liveCount = 0;
+	size_t m_peakCount = 0;
+
+	mutable std::mutex m_mutex;
+
+//	Constructors
+
+public:
+	/**
+	@param blockSize : Size of the objects stored in the pool
+	@param blocksPerSlab : Number of objects allocated at once when the pool is full
+	*/
+	SlabPool(size_t blockSize, size_t blocksPerSlab = 64);
+	~SlabPool();
+
+	SlabPool(SlabPool const&) = delete;
+	SlabPool& operator=(SlabPool const&) = delete;
+
+//	Functions
+
+private:
+	/**
+	@brief Allocate a new slab and chain its blocks in the free list, m_mutex must be locked
+	*/
+	void AddSlab();
+
+public:
+	/**
+	@brief Get a free block of the pool, a new slab is allocated if needed
+
+	@return void* : Memory of the block (aligned like a default operator new)
+	*/
+	void* Allocate();
+
+	/**
+	@brief Give a block back to its pool
+
+	@param ptr : Memory returned by Allocate
+	*/
+	void Deallocate(void* ptr);
+
+	/**
+	@brief Free every slab at once. Live blocks at release are an error : the slabs are kept so their objects stay valid.
+
+	@return bool : true if the memory has been released
+	*/
+	bool Release();
+
+	/**
+	@brief Get the occupancy of the pool
+
+	@return PoolStats : Current stats
+	*/
+	ENGINE_API PoolStats GetStats() const;
+
+	/**
+	@brief Get the size of the objects stored in the pool
+
+	@return size_t : Block size
+	*/
+	inline size_t GetBlockSize() const;
+
+	/**
+	@brief Get the header of a block
+
+	@param ptr : Memory of the block
+
+	@return BlockHeader& : Header stored right before the block
+	*/
+	static inline BlockHeader& GetHeader(void* ptr);
+
+	/**
+	@brief Allocate memory on the heap with a block header, so it can be freed like a pool block
+
+	@param size : Size of the memory to allocate
+
+	@return void* : Memory allocated
+	*/
+	static void* AllocateFromHeap(size_t size);
+
+	/**
+	@brief Free a block wherever it comes from (pool or heap)
+
+	@param ptr : Memory returned by Allocate or AllocateFromHeap
+	*/
+	static void Free(void* ptr);
+};
+
+/**
+@brief Deleter to store pooled objects in std::unique_ptr
+*/
+template <typename T>
+struct PoolDeleter
+{
+	void operator()(T* ptr) const;
+};
+
+template <typename T>
+using PoolPtr = std::unique_ptr<T, PoolDeleter<T>>;
+
+#include "Core/SlabPool.inl"
@@ -0,0 +1,30 @@
+inline float PoolStats::Occupancy() const
+{
+	return capacity > 0 ? static_cast<float>(liveCount) / static_cast<float>(capacity) : 0.f;
+}
+
+inline float PoolStats::Fragmentation() const
+{
+	const size_t freeCount = capacity - liveCount;
+	return freeCount > 0 ? static_cast<float>(holeCount) / static_cast<float>(freeCount) : 0.f;
+}
+
+inline size_t SlabPool::GetBlockSize() const
+{
+	return m_blockSize;
+}
+
+inline SlabPool::BlockHeader& SlabPool::GetHeader(void* ptr)
+{
+	return *(static_cast<BlockHeader*>(ptr) - 1);
+}
+
+template <typename T>
+void PoolDeleter<T>::operator()(T* ptr) const
+{
+	if (ptr == nullptr)
+		return;
+
+	ptr->~T();
+	SlabPool::Free(ptr);
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <new>
 #include <Refureku/Object.h>
 #include <Refureku/Properties/Instantiator.h>
 
@@ -49,6 +50,15 @@ public:
 
 	virtual ~Component();
 
+	/**
+	@brief Components are allocated in the pools of the scene being filled (see SceneAllocator::Scope),
+	on the heap otherwise
+	*/
+	static void* operator new(size_t size);
+	static void* operator new(size_t size, std::align_val_t alignment);
+	static void operator delete(void* ptr);
+	static void operator delete(void* ptr, std::align_val_t alignment);
+
 public:
 
 	/**
@@ -13,11 +13,15 @@
 
 #include "Generated/GameObject.rfkh.h"
 
+class SceneAllocator;
+
 /**
 @brief Base game entity
 */
 class HY_CLASS() GameObject : public SceneObject
 {
+	friend class Scene;
+
 private:
 	//std::unordered_map<HYGUID, int> m_compLink;
 	std::vector<Component*> m_components;
@@ -25,6 +29,12 @@ private:
 	GameObject* m_parent = nullptr;
 	std::vector<GameObject*> m_children;
 
+	// Unique identifier of the scene owning the gameobject
+	HYGUID m_sceneID;
+
+	// Memory of the scene owning the gameobject, its components are allocated in it
+	SceneAllocator* m_sceneAllocator = nullptr;
+
 #pragma warning(disable:4251) // Warning disabled because std::string of this DLL could conflict with the std::string of the project it is used by.
 	std::string m_tag = "Default";
 #pragma warning(default:4251) // But only our Editor & Game projects will use it, so it will be fine
@@ -134,6 +144,20 @@ public:
 	*/
 	ENGINE_API void OnDestroy(bool shoulCallOnDestroy);
 
+	/**
+	@brief Get the unique identifier of the scene owning the gameobject
+
+	@return const HYGUID& : Scene unique identifier
+	*/
+	const HYGUID& GetSceneID() const;
+
+	/**
+	@brief Get the allocator of the scene owning the gameobject
+
+	@return SceneAllocator* : Scene allocator, nullptr if the gameobject is not owned by a scene
+	*/
+	SceneAllocator* GetSceneAllocator() const;
+
 	/**
 	@brief Check if the given gameobject is a parent of this gameobject
 
@@ -21,6 +21,16 @@ inline void GameObject::SetAsDestroyed()
 		child->SetAsDestroyed();
 }
 
+inline const HYGUID& GameObject::GetSceneID() const
+{
+	return m_sceneID;
+}
+
+inline SceneAllocator* GameObject::GetSceneAllocator() const
+{
+	return m_sceneAllocator;
+}
+
 inline const std::vector<GameObject*>& GameObject::GetChildren() const
 {
 	return m_children;
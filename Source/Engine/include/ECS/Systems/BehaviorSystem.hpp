@@ -4,10 +4,10 @@
 #include <Refureku/TypeInfo/Archetypes/Struct.h>
 
 #include "Tools/Event.hpp"
+#include "Types/GUID.hpp"
 
 class Behavior;
 class GameObject;
-class HYGUID;
 
 /**
 @brief System that handle every behaviors in the game
@@ -27,6 +27,15 @@ private:
 	Event<> m_awakeInitialize;
 	Event<> m_startInitialize;
 
+	// Callbacks of the initialize events with the scene of their behavior, to remove them with the scene
+	struct PendingInitialize
+	{
+		HYGUID sceneID;
+		CallbackID awakeID = 0;
+		CallbackID startID = 0;
+	};
+	std::vector<PendingInitialize> m_pendingInitializes;
+
 	/**
 	@brief Invoke and clear initialize events
 	*/
@@ -88,4 +97,11 @@ public:
 	@param behavior : behavior to remove
 	*/
 	void RemoveBehaviorInstance(Behavior& behavior);
+
+	/**
+	@brief Remove every behavior owned by the given scene in one pass
+
+	@param sceneID : Unique identifier of the scene to clear
+	*/
+	void RemoveSceneInstances(const HYGUID& sceneID);
 };
\ No newline at end of file
@@ -81,4 +81,11 @@ public:
 	@param camera : camera to remove
 	*/
 	void RemoveCameraInstance(CameraComponent& camera);
+
+	/**
+	@brief Remove every camera owned by the given scene in one pass
+
+	@param sceneID : Unique identifier of the scene to clear
+	*/
+	void RemoveSceneInstances(const HYGUID& sceneID);
 };
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <unordered_map>
+
+/**
+@brief Components owned by a system with O(1) removal.
+The index of each component in the dense array is kept in a map, removal moves the last component in the freed slot
+and patches its index. The order of the components is not stable across removals.
+*/
+template <typename TComponent>
+class ComponentList
+{
+//	Variables
+
+private:
+
+	std::vector<std::unique_ptr<TComponent>> m_components;
+	std::unordered_map<const TComponent*, size_t> m_indices;
+
+//	Functions
+
+private:
+
+	/**
+	@brief Remove the component at the given index by swapping it with the last one
+
+	@param index : index of the component to remove
+	*/
+	void EraseAt(size_t index);
+
+public:
+
+	/**
+	@brief Take ownership of a component, added at the end of the dense array
+
+	@param component : component to add, must not be null
+
+	@return TComponent& : added component
+	*/
+	TComponent& Add(std::unique_ptr<TComponent> component);
+
+	/**
+	@brief Check if a component is owned by the list
+
+	@param component : component to check
+
+	@return bool : true if owned, false otherwise
+	*/
+	bool Contains(const TComponent& component) const;
+
+	/**
+	@brief Destroy a component by swapping it with the last one
+
+	@param component : component to remove
+
+	@return bool : true if removed, false if not owned by the list
+	*/
+	bool Erase(const TComponent& component);
+
+	/**
+	@brief Destroy every component matching a predicate in one pass
+
+	@param predicate : called with each component, returns true to destroy it
+
+	@return size_t : destroyed component count
+	*/
+	template <typename TPredicate>
+	size_t EraseIf(TPredicate&& predicate);
+
+	size_t Size() const;
+	bool   Empty() const;
+
+	typename std::vector<std::unique_ptr<TComponent>>::const_iterator begin() const;
+	typename std::vector<std::unique_ptr<TComponent>>::const_iterator end() const;
+};
+
+#include "ECS/Systems/ComponentList.inl"
@@ -0,0 +1,92 @@
+#include "ECS/Systems/ComponentList.hpp"
+
+template <typename TComponent>
+inline void ComponentList<TComponent>::EraseAt(size_t index)
+{
+	m_indices.erase(m_components[index].get());
+
+	// Move the last component in the freed slot and patch its index
+	if (index + 1 != m_components.size())
+	{
+		m_components[index] = std::move(m_components.back());
+		m_indices[m_components[index].get()] = index;
+	}
+
+	m_components.pop_back();
+}
+
+template <typename TComponent>
+inline TComponent& ComponentList<TComponent>::Add(std::unique_ptr<TComponent> component)
+{
+	TComponent& added = *component;
+
+	m_indices.emplace(&added, m_components.size());
+	m_components.emplace_back(std::move(component));
+
+	return added;
+}
+
+template <typename TComponent>
+inline bool ComponentList<TComponent>::Contains(const TComponent& component) const
+{
+	return m_indices.find(&component) != m_indices.end();
+}
+
+template <typename TComponent>
+inline bool ComponentList<TComponent>::Erase(const TComponent& component)
+{
+	auto it = m_indices.find(&component);
+	if (it == m_indices.end())
+		return false;
+
+	EraseAt(it->second);
+
+	return true;
+}
+
+template <typename TComponent>
+template <typename TPredicate>
+inline size_t ComponentList<TComponent>::EraseIf(TPredicate&& predicate)
+{
+	size_t erasedCount = 0;
+
+	// The component swapped in the freed slot is checked on the next iteration
+	for (size_t i = 0; i < m_components.size();)
+	{
+		if (predicate(*m_components[i]))
+		{
+			EraseAt(i);
+			erasedCount++;
+		}
+		else
+		{
+			i++;
+		}
+	}
+
+	return erasedCount;
+}
+
+template <typename TComponent>
+inline size_t ComponentList<TComponent>::Size() const
+{
+	return m_components.size();
+}
+
+template <typename TComponent>
+inline bool ComponentList<TComponent>::Empty() const
+{
+	return m_components.empty();
+}
+
+template <typename TComponent>
+inline typename std::vector<std::unique_ptr<TComponent>>::const_iterator ComponentList<TComponent>::begin() const
+{
+	return m_components.begin();
+}
+
+template <typename TComponent>
+inline typename std::vector<std::unique_ptr<TComponent>>::const_iterator ComponentList<TComponent>::end() const
+{
+	return m_components.end();
+}
@@ -3,12 +3,15 @@
 #include <Refureku/TypeInfo/Archetypes/Struct.h>
 #include <unordered_map>
 #include <memory>
+#include <vector>
 #include <deque>
 
 #include "EngineDll.hpp"
 #include "Renderer/MaterialSurface.hpp"
 #include "Renderer/ShaderType.hpp"
 #include "Renderer/MeshInstance.hpp"
+#include "Renderer/RenderProxyRegistry.hpp"
+#include "ECS/Systems/ComponentList.hpp"
 
 class SkeletalMeshComponent;
 class MeshComponent;
@@ -23,6 +26,24 @@ class Mesh;
 */
 class MeshSystem
 {
+public:
+
+	/**
+	@brief Registration batch kept open for the lifetime of the object, it is ended even if the scope is left by an exception
+	*/
+	class RegistrationBatch
+	{
+	private:
+		MeshSystem& m_meshSystem;
+
+	public:
+		explicit RegistrationBatch(MeshSystem& meshSystem) : m_meshSystem(meshSystem) { m_meshSystem.BeginRegistrationBatch(); }
+		~RegistrationBatch() { m_meshSystem.EndRegistrationBatch(); }
+
+		RegistrationBatch(RegistrationBatch const&) = delete;
+		RegistrationBatch& operator=(RegistrationBatch const&) = delete;
+	};
+
 private:
 
 	struct MaterialPipeline
@@ -58,14 +79,21 @@ private:
 
 private:
 
-	std::vector<std::unique_ptr<MeshComponent>> m_meshComponents;
-	std::vector<std::unique_ptr<SkeletalMeshComponent>> m_skeletakMeshComponents;
+	ComponentList<MeshComponent> m_meshComponents;
+	ComponentList<SkeletalMeshComponent> m_skeletakMeshComponents;
 
 	std::unordered_map<MeshComponent*, SubmeshesInstances> m_meshCompInstances;
-	std::unordered_map<Material*, std::vector<MeshInstance*>> m_meshInstancesFromMat;
+	std::unordered_map<Material*, RenderProxyRegistry<MeshInstance, ERenderProxySlot::Material>> m_meshInstancesFromMat;
 
 	std::unordered_map<SkeletalMeshComponent*, SubSkeletalMeshesInstances> m_skMeshCompInstances;
-	std::unordered_map<Material*, std::vector<SkeletalMeshInstance*>> m_skeletalMeshInstancesFromMat;
+	std::unordered_map<Material*, RenderProxyRegistry<SkeletalMeshInstance, ERenderProxySlot::Material>> m_skeletalMeshInstancesFromMat;
+
+	//	While greater than 0, generated instances are kept unregistered and sent in one batch at the end
+	unsigned int m_registrationBatchDepth = 0;
+
+	//	Components whose instances were generated during the batch, only these are sent at its end
+	std::vector<MeshComponent*> m_pendingMeshComps;
+	std::vector<SkeletalMeshComponent*> m_pendingSkMeshComps;
 
 //	Functions
 
@@ -79,6 +107,16 @@ private:
 	template<typename TPairComponentInstances>
 	void SendInstancesToRenderSystem(TPairComponentInstances& componentInstances);
 
+	/**
+	@brief Unregister and drop every (skeletal)mesh instance generated from components of the given scene
+
+	@param compInstances : (skeletal)mesh components to their sub-(skeletal)mesh instances
+	@param instancesFromMat : (skeletal)mesh instances sorted by material
+	@param sceneID : Unique identifier of the scene to clear
+	*/
+	template<typename TInstance, typename TCompInstancesMap, typename TMatInstancesMap>
+	void RemoveSceneSubMeshesInstances(TCompInstancesMap& compInstances, TMatInstancesMap& instancesFromMat, const HYGUID& sceneID);
+
 	/**
 	@brief Generate sub meshes instances from a mesh component
 
@@ -118,6 +156,17 @@ public:
 	*/
 	void Initialize() {};
 
+	/**
+	@brief Start a registration batch, generated instances are not sent to the render system
+	until the matching EndRegistrationBatch call. Batches can be nested.
+	*/
+	ENGINE_API void BeginRegistrationBatch();
+
+	/**
+	@brief End a registration batch, all pending instances are sent to the render system at once
+	*/
+	ENGINE_API void EndRegistrationBatch();
+
 	/**
 	@brief Update mesh system and send unregistered meshes to the render system if possible.
 	This is a dirty functions, if a better method is ossible try it !!
@@ -147,11 +196,11 @@ public:
 
 
 	/**
-	@brief Send all sub meshes of a mesh to the render system
+	@brief Send all sub meshes of a mesh component to the render system, or keep them pending during a registration batch
 
-	@param subMeshinstances : packed instances to send
+	@param meshComp : mesh component whose instances are sent
 	*/
-	void SendToRenderSystem(SubmeshesInstances& subMeshinstances);
+	void SendToRenderSystem(MeshComponent& meshComp);
 
 	/**
 	@brief Remove all sub meshes of a mesh from the render system
@@ -162,11 +211,11 @@ public:
 
 
 	/**
-	@brief Send all sub skeletal meshes of a skeletal mesh to the render system
+	@brief Send all sub skeletal meshes of a skeletal mesh component to the render system, or keep them pending during a registration batch
 
-	@param subSkeletalMeshinstances : packed instances to send
+	@param skMeshComp : skeletal mesh component whose instances are sent
 	*/
-	void SendToRenderSystem(SubSkeletalMeshesInstances& subSkeletalMeshinstances);
+	void SendToRenderSystem(SkeletalMeshComponent& skMeshComp);
 
 	/**
 	@brief Remove all sub skeletal meshes of a skeletal mesh from the render system
@@ -208,4 +257,11 @@ public:
 	@param skmesh component : skmesh component to remove
 	*/
 	void RemoveSkMeshInstance(SkeletalMeshComponent& skMeshComp);
+
+	/**
+	@brief Remove every mesh and skmesh component owned by the given scene in one pass
+
+	@param sceneID : Unique identifier of the scene to clear
+	*/
+	void RemoveSceneInstances(const HYGUID& sceneID);
 };
\ No newline at end of file
@@ -7,10 +7,10 @@
 
 #include "EngineDll.hpp"
 #include "Tools/Event.hpp"
+#include "Types/GUID.hpp"
 
 class ParticleComponent;
 class GameObject;
-class HYGUID;
 
 /**
 @brief System that handle every particle components in the game
@@ -30,6 +30,15 @@ private:
 	Event<> m_awakeInitialize;
 	Event<> m_startInitialize;
 
+	// Callbacks of the initialize events with the scene of their component, to remove them with the scene
+	struct PendingInitialize
+	{
+		HYGUID sceneID;
+		CallbackID awakeID = 0;
+		CallbackID startID = 0;
+	};
+	std::vector<PendingInitialize> m_pendingInitializes;
+
 	/**
 	@brief Invoke and clear initialize events
 	*/
@@ -98,4 +107,11 @@ public:
 	@param particleComp : particle component to remove
 	*/
 	void RemoveParticleInstance(ParticleComponent& particleComp);
+
+	/**
+	@brief Remove every particle component owned by the given scene in one pass
+
+	@param sceneID : Unique identifier of the scene to clear
+	*/
+	void RemoveSceneInstances(const HYGUID& sceneID);
 };
\ No newline at end of file
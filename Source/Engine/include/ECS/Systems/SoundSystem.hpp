@@ -7,12 +7,12 @@
 
 #include "EngineDll.hpp"
 #include "Tools/Event.hpp"
+#include "Types/GUID.hpp"
 
 class SoundEmitter;
 class SoundListener;
 class Sound;
 class GameObject;
-class HYGUID;
 
 struct ma_engine;
 
@@ -34,6 +34,9 @@ private:
 
 	Event<> m_eNewSoundStart;
 
+	// Callbacks of m_eNewSoundStart with the scene of their emitter, to remove them with the scene
+	std::vector<std::pair<HYGUID, CallbackID>> m_pendingStarts;
+
 public:
 	SoundSystem();
 	~SoundSystem();
@@ -122,4 +125,11 @@ public:
 	@param listener : sound listener to remove
 	*/
 	void RemoveListenerInstance(SoundListener& listener);
+
+	/**
+	@brief Remove every sound emitter and listener owned by the given scene in one pass
+
+	@param sceneID : Unique identifier of the scene to clear
+	*/
+	void RemoveSceneInstances(const HYGUID& sceneID);
 };
\ No newline at end of file
@@ -45,6 +45,13 @@ public:
 	ENGINE_API Component* CreateComponent(rfk::Class const& compClass, GameObject& owner, const HYGUID& id);
 	void DestroyComponent(Component& comp);
 
+	/**
+	@brief Destroy every component owned by the given scene, each system clears its instances in one pass
+
+	@param sceneID : Unique identifier of the scene to clear
+	*/
+	void DestroySceneComponents(const HYGUID& sceneID);
+
 	static ENGINE_API BehaviorSystem&	GetBehaviorSystem();
 	static ENGINE_API ParticleSystem&	GetParticleSystem();
 	static ENGINE_API PhysicsSystem&	GetPhysicsSystem();
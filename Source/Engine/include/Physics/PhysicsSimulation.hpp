@@ -144,6 +144,13 @@ public:
 	*/
 	void RemoveActorFromSimulation(PxActor& actor);
 
+	/**
+	@brief Remove many PxActors from the current PhysX simulation scene in a single call
+	@param actors : PxActor* array to remove
+	@param count : PxU32 number of actors in the array
+	*/
+	void RemoveActorsFromSimulation(PxActor* const* actors, PxU32 count);
+
 	/**
 	@brief Launch a ray in the simulation and retreive hits
 	*/
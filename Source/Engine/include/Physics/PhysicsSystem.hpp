@@ -10,6 +10,7 @@
 #include "Physics/PhysicsActor.hpp"
 
 class GameObject;
+class HYGUID;
 class Collider;
 class Rigidbody;
 
@@ -90,6 +91,13 @@ public:
 	*/
 	void RemoveRigidbodyInstance(Rigidbody& rigidbody);
 
+	/**
+	@brief Remove every collider, rigidbody and physics actor owned by the given scene in one pass.
+	The actors are removed from the simulation with a single batched call
+	@param sceneID : Unique identifier of the scene to clear
+	*/
+	void RemoveSceneInstances(const HYGUID& sceneID);
+
 	/**
 	@brief Update at a fixed timestep the physics simulation
 	@param fixedDeltaTime : float - fixed tick delta time
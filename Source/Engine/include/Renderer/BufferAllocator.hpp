@@ -0,0 +1,156 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
+
+/**
+@brief Two-level segregated fit (TLSF) suballocator of the ranges of a GPU buffer. It makes no GL call, offsets and sizes are in the units
+of its owner, vertices or bytes. Free ranges are listed by size class : the first level is the power of two of the size, the second one
+splits it in linear steps, a bitmap of each level finds a free range large enough in constant time. Freed ranges are merged with their free
+neighbours. The buffer can grow, and allocated ranges can be moved down one at a time to compact it.
+*/
+class BufferAllocator
+{
+public:
+	static constexpr size_t InvalidOffset = ~static_cast<size_t>(0);
+
+	/**
+	@brief Move of an allocated range to a free one lower in the buffer, planned by PlanMove
+	*/
+	struct Move
+	{
+		size_t source = InvalidOffset;
+		size_t destination = InvalidOffset;
+		size_t size = 0;
+	};
+
+	struct Stats
+	{
+		size_t capacity = 0;
+		size_t usedSize = 0;
+		size_t allocationCount = 0;
+		size_t freeRangeCount = 0;
+		size_t largestFreeRange = 0;
+	};
+
+private:
+	static constexpr unsigned int SecondLevelBits = 4;
+	static constexpr unsigned int SecondLevelCount = 1u << SecondLevelBits;
+	static constexpr unsigned int FirstLevelCount = 64 - SecondLevelBits + 1;
+
+	static constexpr uint32_t NoBlock = ~0u;
+
+	struct Block
+	{
+		size_t	 offset = 0;
+		size_t	 size = 0;
+		uint32_t previousPhysical = NoBlock;
+		uint32_t nextPhysical = NoBlock;
+		uint32_t previousFree = NoBlock;
+		uint32_t nextFree = NoBlock;
+		bool	 free = false;
+	};
+
+//	Variables
+
+private:
+	size_t m_capacity = 0;
+	size_t m_alignment = 1;
+	size_t m_usedSize = 0;
+
+	std::vector<Block>	  m_blocks;
+	std::vector<uint32_t> m_unusedBlocks;
+	uint32_t			  m_lastBlock = NoBlock;		// Highest block of the buffer
+
+	uint64_t m_firstLevelBitmap = 0;
+	uint32_t m_secondLevelBitmaps[FirstLevelCount] = {};
+	uint32_t m_freeLists[FirstLevelCount][SecondLevelCount];
+
+	std::unordered_map<size_t, uint32_t> m_allocations;	// Block of each allocated offset
+
+	bool m_compacted = true;	// No range could move down since the last free
+
+//	Constructors
+
+public:
+	/**
+	@param capacity : Size of the buffer
+	@param alignment : Offsets and sizes are multiples of it
+	*/
+	BufferAllocator(size_t capacity = 0, size_t alignment = 1);
+
+//	Functions
+
+private:
+	/**
+	@brief Get the size class of a size, rounded down : every free range of the class is at least that large
+	*/
+	void Mapping(size_t size, unsigned int& firstLevel, unsigned int& secondLevel) const;
+
+	uint32_t CreateBlock(size_t offset, size_t size);
+	void	 DestroyBlock(uint32_t block);
+
+	void InsertFree(uint32_t block);
+	void RemoveFree(uint32_t block);
+
+	/**
+	@brief Find a free block of at least size, from the size class above it so that any block of the class fits
+	*/
+	uint32_t FindFree(size_t size) const;
+
+	/**
+	@brief Take size from the start of a free block and mark it allocated, the rest stays free
+	*/
+	size_t Use(uint32_t block, size_t size);
+
+	size_t Align(size_t size) const;
+
+public:
+	/**
+	@brief Allocate a range
+
+	@param size : Size of the range, rounded up to the alignment
+	@return size_t : Offset of the range, InvalidOffset if no free range is large enough
+	*/
+	size_t Allocate(size_t size);
+
+	/**
+	@brief Free an allocated range, it is merged with its free neighbours
+
+	@param offset : Offset returned by Allocate
+	@return bool : false if no range is allocated at this offset
+	*/
+	bool Free(size_t offset);
+
+	/**
+	@brief Get the size of an allocated range, 0 if none is allocated at this offset
+	*/
+	size_t GetSize(size_t offset) const;
+
+	/**
+	@brief Extend the buffer, the new space is free. Smaller capacities are ignored.
+	*/
+	void Grow(size_t capacity);
+
+	/**
+	@brief Plan the move of an allocated range to the lowest free range below it large enough to hold it, starting from the highest ranges.
+	The destination is allocated, the owner copies the content, then frees the source.
+
+	@param move : Filled with the planned move
+	@param canMove : Tells if the range at an offset can be moved now, every range can be moved if empty
+	@return bool : false if no range can move down
+	*/
+	bool PlanMove(Move& move, const std::function<bool(size_t offset)>& canMove = {});
+
+	/**
+	@brief Get if no range can move down since the last free, PlanMove then returns false at once
+	*/
+	bool IsCompacted() const;
+
+	Stats GetStats() const;
+	size_t GetCapacity() const;
+	size_t GetAlignment() const;
+};
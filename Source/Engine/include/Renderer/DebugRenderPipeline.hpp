@@ -61,6 +61,11 @@ private:
 
 public:
 
+	/**
+	@brief Submit the debug shader
+	*/
+	void GenerateShaders() override;
+
 	/**
 	@brief Initialize shader
 	*/
@@ -1,7 +1,29 @@
 #pragma once
 
+#include <cstdint>
+
+#include "Maths/Vector3.hpp"
+#include "Resources/Parsers/ParserFlags.hpp"
+
 struct GPUMeshData
 {
 	unsigned int offset = 0;
 	unsigned int size = 0;
+
+	//	Range of the indices in the index buffer, in bytes, 16 bits indices when the sub mesh has few vertices
+	unsigned int indexOffset = 0;
+	unsigned int indexCount = 0;
+	bool		 shortIndices = false;
+
+	//	Layout of the vertices, packed positions are offset + position * scale
+	EVertexLayout layout = EVertexLayout::FLOAT;
+	Vector3 positionOffset = { 0.f, 0.f, 0.f };
+	Vector3 positionScale = { 1.f, 1.f, 1.f };
+
+	//	Bounding sphere in mesh space
+	Vector3 boundsCenter;
+	float boundsRadius = 0.f;
+
+	//	Upload queue request filling the range, 0 once the vertices are on the GPU and the range can be drawn
+	uint64_t uploadTicket = 0;
 };
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 struct GLTexture;
 struct GLTextureArray;
 
@@ -7,6 +9,9 @@ struct GPUTextureData
 {
 	GLTexture* generatedTexture = nullptr;
 
+	//	Upload queue request filling the texture, 0 once the pixels are on the GPU
+	uint64_t uploadTicket = 0;
+
 	//	When copied in a texture array
 	GLTextureArray* registeredTextureArray = nullptr;
 	int arrayIndex = -1;
@@ -25,6 +25,19 @@ struct ENGINE_API GraphicsSettings
 	float maxExposure = 10.0f;
 	float constantExposure = 1.f;
 
+	unsigned int uploadBudgetPerFrame = 8 * 1024 * 1024;	// Bytes copied by the upload queue each frame
+	unsigned int meshDefragmentBudgetPerFrame = 4 * 1024 * 1024;	// Bytes moved in the mesh buffers each frame to fill removed meshes holes
+
+	bool		 textureStreaming = true;
+	unsigned int textureStreamingBudgetMB = 512;			// VRAM of the streamed textures
+
+	bool  meshLOD = true;
+	float meshLODPixelError = 1.f;							// Error on screen allowed for a mesh level of detail, in pixels
+	float meshLODHysteresis = 0.25f;
+	bool  meshLODCrossfade = false;							// Dither between the levels of detail instead of switching at once
+
+	bool  meshletCulling = true;							// Cull the meshlets of the large meshes on the CPU
+
 	void Save(nlohmann::json& jsonField);
 	void Load(nlohmann::json& jsonField);
 
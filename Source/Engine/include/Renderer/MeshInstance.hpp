@@ -1,12 +1,18 @@
 #pragma once
 
+#include <vector>
+#include <cstdint>
+
+#include "Renderer/RenderProxyRegistry.hpp"
+#include "Renderer/MeshLODSelector.hpp"
+#include "Renderer/MeshletCuller.hpp"
 
 class	Material;
 struct	MeshData;
 class	Transform;
 struct	SkeletalData;
 class	MeshRenderPipeline;
-
+class	Camera;
 
 /**
 @brief Mesh instance that contains all need informations to render a mesh
@@ -21,6 +27,16 @@ struct MeshInstance
 	Transform* transform   = nullptr;
 
 	MeshRenderPipeline* savedPipeline = nullptr;
+
+	//	Level of detail selected by the render system for the camera of the pass being rendered, copied from viewLodStates
+	MeshLODState lodState;
+	std::vector<ViewLODState> viewLodStates;
+
+	//	Meshlets of the finest level left after culling for the camera of the pass being rendered, culled again by each pass
+	MeshletBatch meshletBatch;
+
+	//	Back-indices in the render proxy registries this instance is registered in
+	size_t proxySlots[static_cast<size_t>(ERenderProxySlot::COUNT)] = { InvalidProxySlot, InvalidProxySlot, InvalidProxySlot };
 };
 
 
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <span>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "Resources/Types.hpp"
+
+struct MeshletBatch;
+class Camera;
+
+/**
+@brief Level of detail a mesh instance is drawn at, and the one it fades from during a crossfade
+*/
+struct MeshLODState
+{
+	uint32_t lod = 0;
+	uint32_t previousLod = 0;
+	float	 fade = 1.f;		// Progress of the crossfade from previousLod to lod, 1 once done
+};
+
+/**
+@brief Level of detail of a mesh instance for one camera, each viewport keeps its own hysteresis and crossfade
+*/
+struct ViewLODState
+{
+	const Camera* camera = nullptr;	// Only compared, the camera may be destroyed
+	uint64_t lastRender = 0;		// Render call the state was last updated by
+	MeshLODState state;
+};
+
+/**
+@brief Draw of a level of detail, with the dithered coverage it fades in or out with
+*/
+struct MeshLODDraw
+{
+	uint32_t lod = 0;
+	float	 fade = 0.f;			// Coverage of the level fading in
+	float	 fadeDirection = 0.f;	// 0 : opaque, 1 : fading in, -1 : fading out
+
+	const MeshletBatch* meshlets = nullptr;	// Meshlets left after culling, drawn instead of the whole level when set
+};
+
+/**
+@brief Choice of the level of detail of the mesh instances from the size of their bounding sphere on screen.
+A level is drawn while its error covers less than maxPixelError pixels, a coarser level is only taken once its error is
+a hysteresis fraction under that so instances at the limit do not switch every frame.
+It makes no GL call, the render system gives it the projected sizes and draws what it returns.
+*/
+class MeshLODSelector
+{
+public:
+	struct Settings
+	{
+		bool  enabled = true;
+		float maxPixelError = 1.f;			// Error on screen allowed for a level, in pixels
+		float hysteresis = 0.25f;			// Fraction of maxPixelError a coarser level must be under to be taken
+		bool  crossfade = false;			// Dither between the levels instead of switching at once
+		float crossfadeDuration = 0.25f;	// Seconds
+	};
+
+	// Cameras a mesh instance keeps a level of detail state for, the least recently rendered one is forgotten past that
+	static constexpr size_t MaxViewStates = 4;
+
+//	Functions
+
+public:
+	/**
+	@brief Select the level of detail of a sub mesh
+
+	@param lods : Levels of the sub mesh, from the finest, empty if it has one level
+	@param radiusPixels : Radius of the bounding sphere of the sub mesh on screen, in pixels
+	@param current : Level drawn last frame
+	@param settings : Selection settings
+	@return uint32_t : Level to draw
+	*/
+	static uint32_t SelectLOD(std::span<const MeshLOD> lods, float radiusPixels, uint32_t current, const Settings& settings);
+
+	/**
+	@brief Move an instance to its selected level, at once or by starting a crossfade. A crossfade in progress finishes first.
+
+	@param state : Level state of the instance
+	@param target : Level selected this frame
+	@param deltaTime : Seconds since last frame
+	@param settings : Selection settings
+	*/
+	static void Update(MeshLODState& state, uint32_t target, float deltaTime, const Settings& settings);
+
+	/**
+	@brief Get the draws of an instance : its level, and the level it fades from during a crossfade
+
+	@param state : Level state of the instance
+	@param draws : Filled with the draws
+	@return size_t : Number of draws, 1 or 2
+	*/
+	static size_t GetDraws(const MeshLODState& state, MeshLODDraw (&draws)[2]);
+
+	/**
+	@brief Get the level of detail state of a mesh instance for a camera, created at the finest level on its first render
+
+	@param views : States of the instance, one per camera it was rendered by
+	@param camera : Camera being rendered
+	@param renderCount : Render call being made, marks the state as used
+	@return MeshLODState& : State of the camera, valid until the next call
+	*/
+	static MeshLODState& GetViewState(std::vector<ViewLODState>& views, const Camera& camera, uint64_t renderCount);
+};
@@ -4,6 +4,7 @@
 
 #include "Renderer/Primitives/ShaderProgram.hpp"
 #include "Renderer/MeshRenderPipeline.hpp"
+#include "Renderer/MeshInstance.hpp"
 
 struct MeshData;
 struct SkeletalData;
@@ -23,6 +24,8 @@ struct MeshPBRUniformsLocation : public PBRUniformsLocation
 {
 	int32_t matModel;
 	int32_t matModelNormal;
+	int32_t vertexDecode;
+	int32_t ditherFade;
 };
 
 struct SkMeshPBRUniformsLocation : public PBRUniformsLocation
@@ -48,8 +51,8 @@ protected:
 	MeshPBRUniformsLocation		m_meshLocations;
 	SkMeshPBRUniformsLocation	m_skMeshLocations;
 
-	std::vector<const MeshInstance*> m_meshInstances;
-	std::vector<const SkeletalMeshInstance*> m_skeletalMeshInstances;
+	RenderProxyRegistry<MeshInstance, ERenderProxySlot::Pipeline>		   m_meshInstances;
+	RenderProxyRegistry<SkeletalMeshInstance, ERenderProxySlot::Pipeline> m_skeletalMeshInstances;
 
 	ShaderProgram m_meshShader;
 	ShaderProgram m_skeletalMeshShader;
@@ -159,8 +162,9 @@ public:
 	@param model : world model matrix used to place the mesh in space
 	@param mesh : mesh to render
 	@param material : material to render the mesh with
+	@param lod : level of detail to draw, with its dithered crossfade coverage
 	*/
-	ENGINE_API virtual void DrawMesh(const Matrix4& model, const MeshData& mesh, const MaterialData* material) const = 0;
+	ENGINE_API virtual void DrawMesh(const Matrix4& model, const MeshData& mesh, const MaterialData* material, const MeshLODDraw& lod = {}) const = 0;
 
 	/**
 	@brief Draw a skeletal mesh given a model, a skeletal mesh, a skeletal data and an optionnal material. Shader and VAO must be bound before.
@@ -20,6 +20,11 @@ private:
 
 public:
 
+	/**
+	@brief Submit the mesh and skeletal mesh programs
+	*/
+	void GenerateShaders() override;
+
 	/**
 	@brief Initialize this shader class
 	*/
@@ -32,7 +37,7 @@ public:
 	@param mesh : mesh to render
 	@param material : material to render the mesh with
 	*/
-	ENGINE_API void DrawMesh(const Matrix4& model, const MeshData& mesh, const MaterialData* material) const override;
+	ENGINE_API void DrawMesh(const Matrix4& model, const MeshData& mesh, const MaterialData* material, const MeshLODDraw& lod = {}) const override;
 
 	/**
 	@brief Draw a skeletal mesh given a model, a skeletal mesh, a skeletal data and an optionnal material. Shader and VAO must be bound before.
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <span>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "Maths/Matrix4.hpp"
+#include "Resources/Types.hpp"
+
+/**
+@brief Index ranges of the meshlets of a sub mesh left after culling, contiguous ranges merged, drawn with one multi draw
+*/
+struct MeshletBatch
+{
+	std::vector<uint32_t> firstIndices;
+	std::vector<int32_t>  indexCounts;
+
+	bool active = false;	// Culled for the camera rendering the frame, the sub mesh is drawn whole otherwise
+
+	void Clear();
+};
+
+struct MeshletCullingStats
+{
+	size_t meshletCount = 0;
+	size_t frustumCulled = 0;
+	size_t coneCulled = 0;
+	size_t triangleCount = 0;
+	size_t culledTriangles = 0;
+	size_t drawCount = 0;		// Ranges left after merging
+};
+
+/**
+@brief CPU culling of meshlets against the view frustum and by their normal cone.
+Tests are made in the space of the sub mesh, so they stay exact under non uniform scales. It makes no GL call.
+*/
+class MeshletCuller
+{
+public:
+	struct Frustum
+	{
+		Vector4 planes[6];	// xyz : normal pointing inside, w : distance, normalized
+	};
+
+//	Functions
+
+public:
+	/**
+	@brief Extract the frustum planes from a projection matrix
+
+	@param modelViewProjection : projection * view * model, the planes are in the space of the model
+	@return Frustum : normalized planes
+	*/
+	static Frustum ExtractFrustum(const Matrix4& modelViewProjection);
+
+	/**
+	@brief Cull the meshlets of a sub mesh and fill the batch with the index ranges left
+
+	@param meshlets : Meshlets of the sub mesh
+	@param frustum : Frustum in the space of the sub mesh
+	@param cameraPosition : Position of the camera in the space of the sub mesh
+	@param batch : Filled with the ranges to draw
+	@param stats : Culled meshlets and triangles added to it, optional
+	*/
+	static void Cull(std::span<const Meshlet> meshlets, const Frustum& frustum, const Vector3& cameraPosition, MeshletBatch& batch,
+		MeshletCullingStats* stats = nullptr);
+
+	/**
+	@brief Test if a meshlet is outside the frustum
+	*/
+	static bool IsOutsideFrustum(const Meshlet& meshlet, const Frustum& frustum);
+
+	/**
+	@brief Test if all the triangles of a meshlet face away from the camera
+	*/
+	static bool IsBackFacing(const Meshlet& meshlet, const Vector3& cameraPosition);
+};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <vector>
+#include <span>
 
 #include "Renderer/RenderPipeline.hpp"
 #include "Renderer/Primitives/VertexArray.hpp"
@@ -149,6 +150,11 @@ private:
 
 public:
 
+	/**
+	@brief Submit the particle shader
+	*/
+	void GenerateShaders() override;
+
 	/**
 	@brief Initialiez shader, buffers and vertex array
 	*/
@@ -181,6 +187,14 @@ public:
 	ENGINE_API void RemoveParticleInstance(ParticleComponent* particleComponent);
 
 
+	/**
+	@brief Unregister many particles component instances from this pipeline in a single pass
+
+	@param particleComponents : Particle Component instances to remove
+	*/
+	ENGINE_API void RemoveParticleInstances(std::span<ParticleComponent* const> particleComponents);
+
+
 	/**
 	@brief Render all registered mesh and skeletal mesh instance with fewer openGL calls
 	*/
@@ -3,6 +3,7 @@
 #include "Renderer/Primitives/GLPrimitive.hpp"
 
 class Texture;
+struct TextureData;
 
 struct ENGINE_API GLTexture : public GLPrimitive
 {
@@ -21,5 +22,45 @@ struct ENGINE_API GLTexture : public GLPrimitive
 	void Unbind() const;
 	void UnbindUnit(int unit) const;
 
+	/**
+	@brief Create the texture and upload its pixels synchronously
+	*/
 	void Generate(const Texture& texture);
+
+	/**
+	@brief Create the immutable storage of a texture with a precomputed mip chain, its levels are filled by the upload queue
+
+	@param texture : Texture giving the sampling parameters
+	@param data : Data with the mip chain
+	@param firstLevel : Level of the mip chain stored as the level 0 of the storage
+	*/
+	void Allocate(const Texture& texture, const TextureData& data, int firstLevel = 0);
+
+	/**
+	@brief Move the texture to a new storage starting at another level of its mip chain.
+	The levels both storages have are copied on the GPU, sampling is clamped to them until the others are uploaded.
+
+	@param texture : Texture giving the sampling parameters
+	@param data : Data with the mip chain
+	@param currentLevel : Level of the mip chain stored as the level 0 of the current storage
+	@param newLevel : Level of the mip chain stored as the level 0 of the new storage
+	*/
+	void MoveToLevel(const Texture& texture, const TextureData& data, int currentLevel, int newLevel);
+
+	/**
+	@brief Upload a level of the mip chain synchronously, from the client memory
+
+	@param data : Data with the mip chain
+	@param level : Level of the mip chain
+	@param storageLevel : Level of the storage receiving it
+	*/
+	void UploadLevel(const TextureData& data, int level, int storageLevel);
+
+	/**
+	@brief Clamp sampling to the levels from a base level
+	*/
+	void SetBaseLevel(int level);
+
+private:
+	void SetParameters(const Texture& texture) const;
 };
\ No newline at end of file
@@ -4,6 +4,7 @@
 
 #include "Renderer/Primitives/GLPrimitive.hpp"
 #include "Resources/Resource/Shader.hpp"
+#include "Tools/ContentHash.hpp"
 
 struct GLUniform
 {
@@ -18,14 +19,25 @@ private:
 #pragma warning(disable:4251)
 	std::string m_name;
 
-	std::unordered_map<std::string, GLUniform> m_uniforms;
+	// Filled once the program is linked, on first use
+	mutable std::unordered_map<std::string, GLUniform> m_uniforms;
 #pragma warning(default:4251)
 
 	Shader fragment;
 	Shader vertex;
 	Shader geometry;
 
-	void CreateUniforms();
+	Hash128 m_sourceHash;
+
+	// The link status is not queried yet : the driver may still be compiling the program on its threads
+	mutable bool m_linkPending = false;
+
+	void CreateUniforms() const;
+
+	/**
+	@brief Wait for the link of the program, then read its uniforms and store its binary in the shader cache
+	*/
+	void WaitForLink() const;
 
 public:
 	ShaderProgram();
@@ -37,6 +49,9 @@ public:
 
 	~ShaderProgram();
 
+	/**
+	@brief Link the program from the shader cache, or start its compilation : it is only waited for when the program is first used
+	*/
 	void Generate(const char* vertexShader, const char* fragmentShader, const char* geomertyShader = nullptr);
 	void Bind() const;
 	void Unbind() const;
@@ -44,5 +59,10 @@ public:
 
 	int GetLocationFromUniformName(const std::string& uniformName);
 
+	/**
+	@brief Get the GL program, linked
+	*/
+	unsigned int GetID() const;
+
 	const std::string& GetName() const;
 };
\ No newline at end of file
@@ -1,9 +1,13 @@
 #pragma once
 
+#include <cstddef>
+
 constexpr unsigned int Max_Lights_Count = 8; 
 constexpr unsigned int Cascade_Count = 4; 
 
 constexpr unsigned int UBOIndex_Camera = 0;
 constexpr unsigned int UBOIndex_Lights = 1;
 constexpr unsigned int UBOIndex_Shadows = 2;
-constexpr unsigned int UBOIndex_Graphics_Settings = 3; 
\ No newline at end of file
+constexpr unsigned int UBOIndex_Graphics_Settings = 3; 
+
+constexpr size_t Upload_Staging_Size = 64 * 1024 * 1024;
\ No newline at end of file
@@ -1,10 +1,15 @@
 #pragma once
 #include <deque>
 #include <list>
+#include <vector>
+#include <unordered_map>
 
 #include "Renderer/GPUMeshData.hpp"
 #include "Renderer/GPUSkeletalData.hpp"
 #include "Renderer/GPUTextureData.hpp"
+#include "Renderer/UploadQueue.hpp"
+#include "Renderer/TextureStreamer.hpp"
+#include "Renderer/BufferAllocator.hpp"
 
 #include "Renderer/Primitives/GLTexture.hpp"
 #include "Renderer/Primitives/GLCubeMap.hpp"
@@ -14,6 +19,8 @@
 #include "Renderer/Primitives/GLTextureArray.hpp"
 
 class Mesh;
+struct MeshData;
+struct MeshLODDraw;
 class SkeletalMesh;
 class Texture;
 class Skybox;
@@ -24,6 +31,22 @@ struct VertexObject
 	VertexBuffer VBO;
 };
 
+/**
+@brief Buffer of mesh ranges placed by its allocator, in vertices or in bytes. It starts small and is copied in a larger buffer when full.
+*/
+struct MeshBuffer
+{
+	VertexBuffer	buffer;
+	BufferAllocator allocator;
+	size_t			elementSize = 1;	//	Bytes of one unit of the allocator
+	size_t			maxCapacity = 0;	//	Units the buffer can grow to
+
+	//	Mesh drawn from each allocated offset, patched when its range is moved
+	std::unordered_map<size_t, GPUMeshData*> owners;
+
+	MeshBuffer(size_t elementSize, size_t initialCapacity, size_t maxCapacity, size_t alignment = 1);
+};
+
 
 struct RenderGPUWrapper
 {
@@ -32,12 +55,23 @@ struct RenderGPUWrapper
 
 private:
 
-	VertexBuffer meshVBO;
-	VertexBuffer skeletalMeshVBO;
+	MeshBuffer meshVBO;
+	MeshBuffer packedMeshVBO;
+	MeshBuffer skeletalMeshVBO;
+
+	//	Bone data of the skeletal vertices, at the same offsets and grown with their buffer since the base vertex of a draw applies to both
 	VertexBuffer skeletalDataVBO;
 
+	//	Indices of every mesh and skeletal mesh, allocated in bytes
+	MeshBuffer meshIBO;
+
+	//	Vertex arrays drawing from their own vertices with the index buffer, attached again when it grows
+	std::vector<unsigned int> indexedVAOs;
+
 public:
 	VertexArray  meshVAO;
+	VertexArray  packedMeshVAO;
+	VertexArray  halfPackedMeshVAO;
 	VertexArray  skeletalMeshVAO;
 
 	std::list<GPUMeshData> GPUMeshDatas;
@@ -54,6 +88,9 @@ public:
 
 	std::list<GLCubeMap>	   GPUSkyboxDatas;
 
+	UploadQueue uploadQueue;
+	TextureStreamer textureStreamer;
+
 //	Functions
 
 public:
@@ -62,14 +99,140 @@ public:
 	~RenderGPUWrapper();
 
 	/**
-	@brief Create both VAO and VBO for mesh
+	@brief Create the VAOs, VBOs and the IBO for meshes
 	*/
 	void CreateVertexObjects();
 
+private:
+	/**
+	@brief Link the mesh buffers to the vertex arrays, again each time one of them grows
+	*/
+	void AttachMeshBuffers();
+
+	/**
+	@brief Allocate a range in a mesh buffer, growing it when no free range is large enough
+
+	@param meshBuffer : buffer to allocate in
+	@param size : size of the range, in the units of the buffer
+	@return size_t : offset of the range, BufferAllocator::InvalidOffset if the buffer cannot grow enough
+	*/
+	size_t AllocateRange(MeshBuffer& meshBuffer, size_t size);
+
+	/**
+	@brief Copy a mesh buffer in a larger one, queued uploads are flushed first since they target the old buffer
+	*/
+	void GrowMeshBuffer(MeshBuffer& meshBuffer, size_t capacity);
+
+	/**
+	@brief Free the vertex range of a mesh in its buffer and its index range
+	*/
+	void FreeMeshRanges(MeshBuffer& meshBuffer, const GPUMeshData& gpuData);
+
+	/**
+	@brief Move ranges of a mesh buffer down to fill the holes left by removed meshes
+
+	@param meshBuffer : buffer to compact
+	@param budget : bytes left to copy this frame, updated
+	*/
+	void DefragmentMeshBuffer(MeshBuffer& meshBuffer, size_t& budget);
+
+public:
+	/**
+	@brief Compact the mesh buffers a few ranges at a time, each range is copied within its buffer and the offsets of its mesh are patched.
+	Ranges waiting for their upload are left in place.
+
+	@param budget : bytes copied at most this frame, one range is moved even if larger
+	*/
+	void Defragment(size_t budget);
+
+	/**
+	@brief Get the occupancy of the vertex buffer of a layout, in vertices
+	*/
+	ENGINE_API BufferAllocator::Stats GetVertexBufferStats(EVertexLayout layout) const;
+
+	/**
+	@brief Get the occupancy of the index buffer, in bytes
+	*/
+	ENGINE_API BufferAllocator::Stats GetIndexBufferStats() const;
+
+	/**
+	@brief Read the indices of a sub mesh back from the index buffer, for the meshes saved after their indices were released
+
+	@param data : sub mesh whose upload is done
+	@param indices : filled with the indices of every level of detail
+	@return bool : false if the sub mesh has no range in the index buffer yet
+	*/
+	bool ReadIndices(const MeshData& data, std::vector<int>& indices) const;
+
+	//	Draw functions
+
+	/**
+	@brief Get the vertex array of the meshes of a vertex layout
+	*/
+	const VertexArray& GetMeshVAO(EVertexLayout layout) const;
+
+	/**
+	@brief Bind the vertex array of a mesh if it is not the one bound by the previous draw
+
+	@param gpuData : mesh to draw
+	@param bound : vertex array bound by the draw loop, updated
+	*/
+	void BindMeshVAO(const GPUMeshData& gpuData, const VertexArray*& bound) const;
+
+	/**
+	@brief Use the index buffer of the meshes in a vertex array drawing them from its own vertices
+
+	@param vao : vertex array to attach the index buffer to
+	*/
+	void AttachMeshIndices(const VertexArray& vao);
+
+	/**
+	@brief Send the vec4[2] decoding uniform of the vertices of a mesh : position offset and packed flag, then position scale
+
+	@param location : location of the uniform
+	@param gpuData : mesh to draw
+	*/
+	static void SendVertexDecoding(int location, const GPUMeshData& gpuData);
+
+	/**
+	@brief Draw the triangles of a level of detail of a sub mesh from its indices in the index buffer and its first vertex in the vertex buffer
+
+	@param mesh : sub mesh to draw
+	@param lod : level of detail, clamped to the levels of the sub mesh
+	*/
+	static void DrawElements(const MeshData& mesh, uint32_t lod = 0);
+
+	/**
+	@brief Draw a level of detail of a sub mesh, or the meshlets left after culling with one multi draw when the draw has them
+
+	@param mesh : sub mesh to draw
+	@param draw : level of detail and meshlets to draw
+	*/
+	static void DrawElements(const MeshData& mesh, const MeshLODDraw& draw);
+
+	//	Staging functions, callable from any thread
+
+	/**
+	@brief Copy the vertices of a mesh in the staging memory, CreateMeshData then only queues their copy
+
+	@param mesh : mesh to stage
+	@return bool : false if the staging memory is full
+	*/
+	bool StageMeshData(Mesh& mesh);
+
+	/**
+	@brief Copy the mip chain of a texture in the staging memory, CreateTextureData then only queues its copy.
+	Streamed textures only stage the levels they are created with.
+
+	@param text : texture to stage
+	@return bool : false if the texture has no precomputed mip chain or the staging memory is full
+	*/
+	bool StageTextureData(Texture& text);
+
 	//	Create datas functions
 
 	/**
-	@brief Send Mesh datas to GPU
+	@brief Send Mesh datas to GPU through the upload queue, the mesh is GPU ready once the copy is done
 
 	@param mesh : mesh to send
 	*/
@@ -83,7 +246,7 @@ public:
 	void CreateSkeletalMeshData(SkeletalMesh& skMesh);
 
 	/**
-	@brief Send Texture datas to GPU
+	@brief Send Texture datas to GPU through the upload queue, the texture is GPU ready once the copy is done
 
 	@param text : texture to send
 	*/
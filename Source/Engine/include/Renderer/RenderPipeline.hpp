@@ -18,6 +18,11 @@ public:
 	*/
 	virtual void Initialize() = 0;
 
+	/**
+	@brief Submit the shader programs of the render pipeline, called for every pipeline before Initialize : the driver links them together
+	*/
+	virtual void GenerateShaders() {};
+
 	/**
 	@brief Prerender function of the render pipeline
 	*/
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <vector>
+#include <span>
+#include <limits>
+#include <algorithm>
+
+/**
+@brief Back-index slots stored in each render proxy, one per registry kind a proxy can be registered in
+*/
+enum class ERenderProxySlot : unsigned int
+{
+	System,
+	Pipeline,
+	Material,
+
+	COUNT
+};
+
+constexpr size_t InvalidProxySlot = std::numeric_limits<size_t>::max();
+
+/**
+@brief Dense array of render proxies with O(1) registration and removal.
+Each proxy stores its index in the array (back-index) in the slot given by the template parameter,
+removal swaps the last proxy in place and patches its back-index.
+
+Proxies must expose a "proxySlots" array indexed with ERenderProxySlot.
+*/
+template <typename TProxy, ERenderProxySlot Slot>
+class RenderProxyRegistry
+{
+//	Variables
+
+private:
+
+	std::vector<TProxy*> m_proxies;
+
+//	Functions
+
+private:
+
+	/**
+	@brief Get the back-index of a proxy for this registry kind
+
+	@param proxy : proxy to get the back-index from
+	*/
+	static size_t& BackIndex(TProxy* proxy);
+
+public:
+
+	/**
+	@brief Check if a proxy is registered in this registry
+
+	@param proxy : proxy to check
+
+	@return bool : true if registered, false otherwise
+	*/
+	bool Contains(const TProxy* proxy) const;
+
+	/**
+	@brief Register a proxy at the end of the dense array
+
+	@param proxy : proxy to add
+
+	@return bool : true if added, false if null or already registered
+	*/
+	bool Add(TProxy* proxy);
+
+	/**
+	@brief Remove a proxy by swapping it with the last one
+
+	@param proxy : proxy to remove
+
+	@return bool : true if removed, false if not registered in this registry
+	*/
+	bool Remove(TProxy* proxy);
+
+	/**
+	@brief Register a batch of proxies, the dense array is grown once
+
+	@param proxies : proxies to add
+	*/
+	void AddMany(std::span<TProxy* const> proxies);
+
+	/**
+	@brief Remove a batch of proxies
+
+	@param proxies : proxies to remove
+	*/
+	void RemoveMany(std::span<TProxy* const> proxies);
+
+	/**
+	@brief Remove all proxies and reset their back-indices
+	*/
+	void Clear();
+
+	/**
+	@brief Reserve memory for a given proxy count, capacity grows geometrically
+
+	@param count : proxy count to reserve
+	*/
+	void Reserve(size_t count);
+
+	size_t Size() const;
+	bool   Empty() const;
+
+	/**
+	@brief Get the dense array of proxies. Order is not stable across removals.
+
+	@return const std::vector<TProxy*>& : registered proxies
+	*/
+	const std::vector<TProxy*>& GetProxies() const;
+
+	typename std::vector<TProxy*>::const_iterator begin() const;
+	typename std::vector<TProxy*>::const_iterator end() const;
+};
+
+#include "Renderer/RenderProxyRegistry.inl"
@@ -0,0 +1,114 @@
+#include "Renderer/RenderProxyRegistry.hpp"
+
+template <typename TProxy, ERenderProxySlot Slot>
+inline size_t& RenderProxyRegistry<TProxy, Slot>::BackIndex(TProxy* proxy)
+{
+	return proxy->proxySlots[static_cast<size_t>(Slot)];
+}
+
+template <typename TProxy, ERenderProxySlot Slot>
+inline bool RenderProxyRegistry<TProxy, Slot>::Contains(const TProxy* proxy) const
+{
+	if (proxy == nullptr)
+		return false;
+
+	// The back-index may come from another registry of the same kind, check it points back to the proxy
+	size_t index = proxy->proxySlots[static_cast<size_t>(Slot)];
+	return index < m_proxies.size() && m_proxies[index] == proxy;
+}
+
+template <typename TProxy, ERenderProxySlot Slot>
+inline bool RenderProxyRegistry<TProxy, Slot>::Add(TProxy* proxy)
+{
+	if (proxy == nullptr || Contains(proxy))
+		return false;
+
+	BackIndex(proxy) = m_proxies.size();
+	m_proxies.emplace_back(proxy);
+
+	return true;
+}
+
+template <typename TProxy, ERenderProxySlot Slot>
+inline bool RenderProxyRegistry<TProxy, Slot>::Remove(TProxy* proxy)
+{
+	if (!Contains(proxy))
+		return false;
+
+	size_t index = BackIndex(proxy);
+
+	// Move the last proxy in the freed slot and patch its back-index
+	TProxy* last = m_proxies.back();
+	m_proxies[index] = last;
+	BackIndex(last) = index;
+
+	m_proxies.pop_back();
+	BackIndex(proxy) = InvalidProxySlot;
+
+	return true;
+}
+
+template <typename TProxy, ERenderProxySlot Slot>
+inline void RenderProxyRegistry<TProxy, Slot>::AddMany(std::span<TProxy* const> proxies)
+{
+	Reserve(m_proxies.size() + proxies.size());
+
+	for (TProxy* proxy : proxies)
+		Add(proxy);
+}
+
+template <typename TProxy, ERenderProxySlot Slot>
+inline void RenderProxyRegistry<TProxy, Slot>::RemoveMany(std::span<TProxy* const> proxies)
+{
+	for (TProxy* proxy : proxies)
+		Remove(proxy);
+}
+
+template <typename TProxy, ERenderProxySlot Slot>
+inline void RenderProxyRegistry<TProxy, Slot>::Clear()
+{
+	for (TProxy* proxy : m_proxies)
+		BackIndex(proxy) = InvalidProxySlot;
+
+	m_proxies.clear();
+}
+
+template <typename TProxy, ERenderProxySlot Slot>
+inline void RenderProxyRegistry<TProxy, Slot>::Reserve(size_t count)
+{
+	if (count <= m_proxies.capacity())
+		return;
+
+	// Keep a geometric growth, small batches must not reallocate on each call
+	m_proxies.reserve(std::max(count, m_proxies.capacity() * 2));
+}
+
+template <typename TProxy, ERenderProxySlot Slot>
+inline size_t RenderProxyRegistry<TProxy, Slot>::Size() const
+{
+	return m_proxies.size();
+}
+
+template <typename TProxy, ERenderProxySlot Slot>
+inline bool RenderProxyRegistry<TProxy, Slot>::Empty() const
+{
+	return m_proxies.empty();
+}
+
+template <typename TProxy, ERenderProxySlot Slot>
+inline const std::vector<TProxy*>& RenderProxyRegistry<TProxy, Slot>::GetProxies() const
+{
+	return m_proxies;
+}
+
+template <typename TProxy, ERenderProxySlot Slot>
+inline typename std::vector<TProxy*>::const_iterator RenderProxyRegistry<TProxy, Slot>::begin() const
+{
+	return m_proxies.begin();
+}
+
+template <typename TProxy, ERenderProxySlot Slot>
+inline typename std::vector<TProxy*>::const_iterator RenderProxyRegistry<TProxy, Slot>::end() const
+{
+	return m_proxies.end();
+}
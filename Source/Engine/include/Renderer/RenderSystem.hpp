@@ -2,6 +2,7 @@
 
 #include <queue>
 #include <memory>
+#include <span>
 
 #include <Refureku/TypeInfo/Archetypes/Struct.h>
 
@@ -25,6 +26,8 @@
 #include "Renderer/GraphicsSettings.hpp"
 #include "Renderer/ShadowProcess.hpp"
 #include "Renderer/RenderUtils.hpp"
+#include "Renderer/RenderProxyRegistry.hpp"
+#include "Renderer/MeshletCuller.hpp"
 #include "Tools/Event.hpp"
 
 //	Forward declarations
@@ -68,8 +71,13 @@ private:
 	std::vector<unsigned int>    m_renderPipelinesCallOrder;
 	std::vector<RenderPipeline*> m_renderPipelines;
 
-	std::vector<const MeshInstance*>		   m_allMeshInstances;
-	std::vector<const SkeletalMeshInstance*>   m_allSkeletalMeshInstances;
+	RenderProxyRegistry<MeshInstance, ERenderProxySlot::System>		    m_allMeshInstances;
+	RenderProxyRegistry<SkeletalMeshInstance, ERenderProxySlot::System> m_allSkeletalMeshInstances;
+
+	MeshletCullingStats m_meshletStats;
+
+	//	Render calls made since startup, orders the level of detail states of the cameras
+	uint64_t m_renderCount = 0;
 
 public:
 
@@ -102,6 +110,30 @@ private:
 	*/
 	void UpdateLightUBO();
 
+	/**
+	@brief Tell the texture streamer the texels each material covers on screen
+
+	@param camera : camera rendering the frame
+	@param viewportHeight : height of the viewport in pixels
+	*/
+	void RequestStreamedTextures(const Camera& camera, float viewportHeight);
+
+	/**
+	@brief Select the level of detail of the mesh instances from the size of their bounding sphere on screen.
+	The state of each camera is kept, so the selection and the crossfades of a viewport are not moved by the others
+
+	@param camera : camera rendering the frame
+	@param viewportHeight : height of the viewport in pixels
+	*/
+	void SelectMeshLODs(const Camera& camera, float viewportHeight);
+
+	/**
+	@brief Cull the meshlets of the mesh instances drawn at their finest level against the camera frustum and by their normal cone
+
+	@param camera : camera rendering the frame
+	*/
+	void CullMeshlets(const Camera& camera);
+
 public:
 
 	/**
@@ -116,6 +148,11 @@ public:
 	*/
 	ENGINE_API void Render(RenderpassParameters& param);
 
+	/**
+	@brief Update the texture residency, complete the finished GPU uploads and issue the queued ones within the frame budget, once per frame
+	*/
+	void UpdateUploads();
+
 	/**
 	@brief Attach a new skybox to the render system
 
@@ -152,6 +189,34 @@ public:
 	@param instance : skeletal mesh instance to unregister
 	*/
 	void Unregister(SkeletalMeshInstance* instance);
+
+	/**
+	@brief Register a batch of mesh instances, registries are grown once for the whole batch
+
+	@param instances : mesh instances to register
+	*/
+	void RegisterMany(std::span<MeshInstance* const> instances);
+
+	/**
+	@brief Unregister a batch of mesh instances from the renderer system
+
+	@param instances : mesh instances to unregister
+	*/
+	void UnregisterMany(std::span<MeshInstance* const> instances);
+
+	/**
+	@brief Register a batch of skeletal mesh instances, registries are grown once for the whole batch
+
+	@param instances : skeletal mesh instances to register
+	*/
+	void RegisterMany(std::span<SkeletalMeshInstance* const> instances);
+
+	/**
+	@brief Unregister a batch of skeletal mesh instances from the renderer system
+
+	@param instances : skeletal mesh instances to unregister
+	*/
+	void UnregisterMany(std::span<SkeletalMeshInstance* const> instances);
 	
 	/**
 	@brief Register a particle component to the renderer system
@@ -167,6 +232,13 @@ public:
 	*/
 	void Unregister(ParticleComponent* particleComp);
 
+	/**
+	@brief Unregister many particle components from the renderer system at once
+
+	@param particleComps : particle components to unregister
+	*/
+	void UnregisterMany(std::span<ParticleComponent* const> particleComps);
+
 	/**
 	@brief Add a new light to the system
 
@@ -185,19 +257,31 @@ public:
 	*/
 	void RemoveLightInstance(LightComponent& lightComp);
 
+	/**
+	@brief Remove every light owned by the given scene in one pass
+
+	@param sceneID : Unique identifier of the scene to clear
+	*/
+	void RemoveSceneLightInstances(const HYGUID& sceneID);
+
 	/**
 	@brief Get all mesh instances that were registered in the render system
 
 	@return A vector of all mesh instances
 	*/
-	ENGINE_API const std::vector<const MeshInstance*>& GetAllMeshInstances() const;
+	ENGINE_API const std::vector<MeshInstance*>& GetAllMeshInstances() const;
 
 	/**
 	@brief Get all skeletal mesh instances that were registered in the render system
 
 	@return A vector of all skeletal mesh instances
 	*/
-	ENGINE_API const std::vector<const SkeletalMeshInstance*>& GetAllSkeletalMeshInstances() const;
+	ENGINE_API const std::vector<SkeletalMeshInstance*>& GetAllSkeletalMeshInstances() const;
+
+	/**
+	@brief Get the meshlets culled for the last camera rendered
+	*/
+	ENGINE_API const MeshletCullingStats& GetMeshletCullingStats() const;
 
 	/**
 	@brief Get all skeletal lights that were registered in the render system
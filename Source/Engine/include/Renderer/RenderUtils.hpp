@@ -20,6 +20,7 @@ public:
 
 public:
 
+	void GenerateShaders();
 	void Initialize();
 	void DrawImageScreen(unsigned int image);
 	void DrawRect();
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+
+#include "Tools/ContentHash.hpp"
+
+/**
+@brief Cache of the linked shader programs in the cache folder, read back with glProgramBinary instead of compiling the GLSL again.
+Programs are keyed by the hash of their sources, each binary also stores the driver it was built by and is compiled again on mismatch.
+Programs compiled while GL_KHR_parallel_shader_compile is available are built by the driver threads, see ShaderProgram.
+*/
+class ShaderCache
+{
+public:
+	struct Stats
+	{
+		uint32_t loadedPrograms = 0;	// Read from the cache
+		uint32_t compiledPrograms = 0;	// Compiled from the sources, the cache was cold or invalid
+	};
+
+//	Functions
+
+public:
+	/**
+	@brief Read the driver strings and enable the parallel compilation, called once the GL functions are loaded
+	*/
+	static void Initialize();
+
+	/**
+	@brief Hash the sources of a program
+
+	@param vertexShader : Vertex shader source
+	@param fragmentShader : Fragment shader source
+	@param geometryShader : Geometry shader source, nullptr if none
+	@return Hash128 : Key of the program in the cache
+	*/
+	static Hash128 HashSources(const char* vertexShader, const char* fragmentShader, const char* geometryShader);
+
+	/**
+	@brief Link a program from its cached binary
+
+	@param program : Program without shader attached
+	@param sourceHash : Hash of its sources
+	@return bool : false if the binary is missing, was built by another driver or was rejected : the program must be compiled
+	*/
+	static bool LoadProgram(unsigned int program, const Hash128& sourceHash);
+
+	/**
+	@brief Store the binary of a linked program, it must have been linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+
+	@param program : Linked program
+	@param sourceHash : Hash of its sources
+	*/
+	static void SaveProgram(unsigned int program, const Hash128& sourceHash);
+
+	/**
+	@brief Get the programs loaded and compiled since the start
+	*/
+	static Stats GetStats();
+};
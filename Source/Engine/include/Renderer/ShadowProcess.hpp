@@ -118,6 +118,11 @@ private:
 
 public:
 
+	/**
+	@brief Submit the shadow map programs, called with the ones of the render pipelines before Initialize
+	*/
+	void GenerateShaders();
+
 	/**
 	@brief Initialize shadow process
 	*/
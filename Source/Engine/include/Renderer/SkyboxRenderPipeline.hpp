@@ -41,6 +41,7 @@ private:
 
 public:
 
+	void GenerateShaders() override;
 	void Initialize() override;
 
 	/**
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+struct StagingRange
+{
+	uint64_t id = 0;				// Allocation id in the upload queue, 0 when not allocated
+	size_t offset = 0;				// Offset in the staging buffer
+	size_t size = 0;
+	unsigned char* data = nullptr;	// Persistently mapped memory, written by any thread
+
+	bool IsValid() const { return data != nullptr; }
+};
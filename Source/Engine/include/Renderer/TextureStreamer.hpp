@@ -0,0 +1,211 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "Renderer/StagingRange.hpp"
+#include "Resources/Resource/Texture.hpp"
+#include "Tools/FlatHashMap.hpp"
+
+class UploadQueue;
+class ResourcesTaskPool;
+
+struct TextureStreamingStats
+{
+	size_t budgetBytes = 0;
+	size_t residentBytes = 0;		// Levels in VRAM of the streamed textures
+	size_t wantedBytes = 0;			// Resident levels and levels asked for by the draws of last frame, before the budget is applied
+	size_t streamedTextures = 0;
+	size_t pendingStreamIns = 0;
+	size_t streamedInLevels = 0;	// Since startup
+	size_t evictedLevels = 0;		// Since startup
+};
+
+/**
+@brief Streaming of texture mip levels under a VRAM budget. Textures are created with the low levels of their mip chain only,
+the levels needed by the draws of last frame are streamed in, and the least recently used then least covered textures lose their top levels when the budget is exceeded.
+In simulation mode no GL call nor task is made and every change is immediate, so the residency policy runs without a GPU.
+*/
+class TextureStreamer
+{
+public:
+	struct Settings
+	{
+		bool enabled = true;
+		size_t budgetBytes = 512ull * 1024 * 1024;
+		int initialSize = 64;			// Largest side of the levels created with the texture, these are never evicted
+		int maxStreamInsPerFrame = 4;	// Textures gaining levels each frame
+	};
+
+private:
+	struct StreamJob
+	{
+		const Texture* texture = nullptr;
+		TextureData source;
+		int firstLevel = 0;		// Levels [firstLevel, lastLevel[ are streamed in, one at a time from the smallest
+		int lastLevel = 0;
+		int level = 0;			// Level being staged and uploaded
+		StagingRange staging;
+		uint64_t uploadTicket = 0;
+		std::atomic<bool> cancelled = false;
+	};
+
+	// Shared with the worker tasks, a task still running when the streamer is destroyed only touches this
+	struct JobMailbox
+	{
+		std::mutex mutex;
+		std::vector<std::shared_ptr<StreamJob>> stagedJobs;
+	};
+
+	struct Entry
+	{
+		Texture* texture = nullptr;
+		TextureData source;			// Whole mip chain, mapped from the texture cache
+
+		int initialLevel = 0;		// First level created with the texture
+		int residentLevel = 0;		// First level allocated in VRAM
+		int requestedLevel = -1;	// Best level needed by the draws of last frame, -1 if not drawn
+		int targetLevel = 0;
+		float priority = 0.f;		// Texels covered on screen last frame
+		uint64_t lastUsedFrame = 0;
+
+		std::shared_ptr<StreamJob> job;	// Levels being streamed in, the entry does not change until it is done
+	};
+
+//	Variables
+
+private:
+	// The settings are read by the loading workers through GetInitialLevel, everything else is main thread only
+	mutable std::mutex m_settingsMutex;
+	Settings m_settings;
+
+	bool m_simulate = false;
+
+	UploadQueue* m_uploadQueue = nullptr;
+	ResourcesTaskPool* m_taskPool = nullptr;
+
+	uint64_t m_frame = 1;
+	FlatHashMap<const Texture*, Entry> m_entries;
+	std::shared_ptr<JobMailbox> m_mailbox = std::make_shared<JobMailbox>();
+
+	TextureStreamingStats m_stats;
+
+//	Constructors & Destructors
+
+public:
+	/**
+	@param simulate : Residency changes are only computed, nothing is sent to the GPU
+	*/
+	explicit TextureStreamer(bool simulate = false);
+	~TextureStreamer();
+
+	TextureStreamer(const TextureStreamer&) = delete;
+	TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+//	Functions
+
+private:
+	/**
+	@brief Send the level of the job of an entry, staged by a worker or directly if it can't fit in the staging buffer
+	*/
+	void StreamLevel(Entry& entry);
+
+	/**
+	@brief Make the level of the job of an entry sampled, then stream the next one until the job is done
+	*/
+	void CompleteLevel(Entry& entry);
+
+	/**
+	@brief Stage the level of a job in a worker task
+	*/
+	void DispatchJob(const std::shared_ptr<StreamJob>& job);
+
+	/**
+	@brief Queue the copies of the jobs staged by the workers
+	*/
+	void SubmitStagedJobs();
+
+	/**
+	@brief Check if the storage of a texture can't be changed yet : levels are being streamed in,
+	or the first upload of the texture is still queued and would be copied to a deleted storage
+	*/
+	bool IsBusy(const Entry& entry) const;
+
+	/**
+	@brief Drop the top levels of a texture
+
+	@param newLevel : New first level, greater than the resident one
+	*/
+	void Evict(Entry& entry, int newLevel);
+
+	/**
+	@brief Allocate the top levels of a texture and stream their pixels in
+
+	@param newLevel : New first level, lower than the resident one
+	*/
+	void StreamIn(Entry& entry, int newLevel);
+
+public:
+	/**
+	@brief Give the queue used to send the streamed levels and the pool staging them, not needed in simulation mode
+	*/
+	void Initialize(UploadQueue* uploadQueue, ResourcesTaskPool* taskPool);
+
+	void SetSettings(const Settings& settings);
+	Settings GetSettings() const;
+
+	bool IsSimulated() const;
+
+	/**
+	@brief Get the size of the levels of a mip chain from a first level to the smallest one
+	*/
+	static size_t GetLevelsSize(const std::vector<TextureMipLevel>& levels, int firstLevel);
+
+	/**
+	@brief Get the first level a texture is created with, thread-safe.
+	The settings may change between two calls, the level a texture was staged with must not be computed again later.
+
+	@param data : Texture data with its mip chain
+	@return int : 0 if the texture is not streamed
+	*/
+	int GetInitialLevel(const TextureData& data) const;
+
+	/**
+	@brief Stream the levels of a texture from now on, its pixels are kept by the streamer
+
+	@param texture : Texture created with the levels from initialLevel
+	@param source : Data of the texture with its whole mip chain
+	@param initialLevel : First level allocated in VRAM
+	*/
+	void Register(Texture& texture, const TextureData& source, int initialLevel);
+
+	/**
+	@brief Stop streaming a texture, before its GPU data is destroyed
+	*/
+	void Unregister(const Texture& texture);
+
+	/**
+	@brief Get the first level of a texture allocated in VRAM
+
+	@return int : -1 if the texture is not streamed
+	*/
+	int GetResidentLevel(const Texture& texture) const;
+
+	/**
+	@brief Tell a texture is drawn this frame, called by the renderer
+
+	@param texture : Texture of the material of a draw
+	@param texels : Texels needed along the largest side of the texture to cover the draw on screen
+	*/
+	void RequestTexels(const Texture* texture, float texels);
+
+	/**
+	@brief Apply the requests of last frame : evict over the budget and start the stream-ins. Called once per frame by the main thread.
+	*/
+	void Update();
+
+	TextureStreamingStats GetStats() const;
+};
@@ -31,8 +31,8 @@ public:
 
 public:
 
-	std::vector<const MeshInstance*> meshes;
-	std::vector<const SkeletalMeshInstance*> skeletalMeshes;
+	RenderProxyRegistry<MeshInstance, ERenderProxySlot::Pipeline>		   meshes;
+	RenderProxyRegistry<SkeletalMeshInstance, ERenderProxySlot::Pipeline> skeletalMeshes;
 
 	MeshUnlitShader* unlitShader = nullptr;
 	MeshLitShader* litShader = nullptr;
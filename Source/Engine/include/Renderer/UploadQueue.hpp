@@ -0,0 +1,201 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "Renderer/StagingRange.hpp"
+
+struct UploadStats
+{
+	size_t queuedRequests = 0;		// Waiting for the frame budget
+	size_t queuedBytes = 0;
+	size_t inFlightRequests = 0;	// Copies issued, fence not signaled yet
+	size_t inFlightBytes = 0;
+	size_t uploadedBytesLastFrame = 0;
+	size_t completedRequests = 0;
+	size_t failedAllocations = 0;	// Staging buffer full, the data has been uploaded another way
+	double averageLatencyMs = 0.0;	// From Submit to the fence signal
+	double maxLatencyMs = 0.0;
+};
+
+/**
+@brief Asynchronous uploads to the GPU. Any thread writes its data in a persistently mapped staging ring buffer,
+then the main thread issues the copies to their buffers and textures under a budget of bytes per frame.
+Every frame of copies is tracked with a fence, the staging memory is reused and the requests complete once it is signaled.
+*/
+class UploadQueue
+{
+public:
+	struct BufferCopy
+	{
+		unsigned int buffer = 0;
+		size_t srcOffset = 0;	// Offset in the staging buffer
+		size_t dstOffset = 0;
+		size_t size = 0;
+	};
+
+	struct TextureCopy
+	{
+		unsigned int texture = 0;
+		int level = 0;
+		int width = 0;
+		int height = 0;
+		int format = 0;			// Compressed internal format when compressed
+		int type = 0;
+		bool compressed = false;
+		size_t srcOffset = 0;	// Offset in the staging buffer
+		size_t size = 0;
+	};
+
+	struct Request
+	{
+		StagingRange staging;
+		std::vector<BufferCopy> bufferCopies;
+		std::vector<TextureCopy> textureCopies;
+
+		// Called by the main thread once the GPU has the data
+		std::function<void()> onComplete;
+	};
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	struct Allocation
+	{
+		uint64_t id = 0;
+		size_t offset = 0;
+		size_t size = 0;
+		bool released = false;
+	};
+
+	struct PendingRequest
+	{
+		Request request;
+		size_t size = 0;
+		Clock::time_point submitTime;
+	};
+
+	struct Batch
+	{
+		void* fence = nullptr;
+		std::vector<PendingRequest> requests;
+	};
+
+//	Variables
+
+private:
+	unsigned int m_stagingBuffer = 0;
+	unsigned char* m_mappedData = nullptr;
+	size_t m_capacity = 0;
+
+	// Guards everything below : other threads allocate and submit, and read the stats.
+	// The in flight batches are only modified by the main thread, which can read them without the lock
+	mutable std::mutex m_mutex;
+	std::deque<Allocation> m_allocations;
+	uint64_t m_nextID = 1;
+	std::deque<PendingRequest> m_queued;
+
+	std::deque<Batch> m_inFlight;
+
+	UploadStats m_stats;
+	double m_totalLatencyMs = 0.0;
+
+//	Constructors & Destructors
+
+public:
+	UploadQueue() = default;
+	~UploadQueue();
+
+	UploadQueue(const UploadQueue&) = delete;
+	UploadQueue& operator=(const UploadQueue&) = delete;
+
+//	Functions
+
+private:
+	/**
+	@brief Give back a staging allocation, the ring space is reused once every older allocation is released. m_mutex must be locked.
+	*/
+	void ReleaseUnsafe(uint64_t id);
+
+	/**
+	@brief Record the copies of a request in the GL command stream
+	*/
+	void IssueCopies(const Request& request) const;
+
+	/**
+	@brief Issue the queued requests in submission order until the budget is spent, at least one request is issued
+
+	@param budget : Bytes to copy
+	*/
+	void IssueRequests(size_t budget);
+
+	/**
+	@brief Complete the batches whose fence is signaled
+
+	@param wait : Block until every batch is complete
+	*/
+	void RetireBatches(bool wait);
+
+public:
+	/**
+	@brief Create and map the staging buffer, main thread only
+
+	@param stagingSize : Size of the staging ring buffer in bytes
+	*/
+	void Initialize(size_t stagingSize);
+
+	/**
+	@brief Reserve staging memory, thread-safe and never blocking
+
+	@param size : Bytes to write
+	@return StagingRange : Invalid if the ring buffer has no room left or is not initialized
+	*/
+	StagingRange Allocate(size_t size);
+
+	/**
+	@brief Check if a range of this size can ever be allocated, once the staging buffer is empty
+
+	@param size : Bytes to write
+	*/
+	bool FitsInStaging(size_t size) const;
+
+	/**
+	@brief Give back a staging range that will not be submitted, thread-safe
+	*/
+	void Release(const StagingRange& range);
+
+	/**
+	@brief Queue the copies of a staging range, thread-safe. The range belongs to the queue afterwards.
+
+	@return uint64_t : Ticket of the request, used to cancel it
+	*/
+	uint64_t Submit(Request&& request);
+
+	/**
+	@brief Drop a request whose destination is destroyed, its completion callback is not called anymore. Main thread only.
+	*/
+	void Cancel(uint64_t ticket);
+
+	/**
+	@brief Complete the finished copies, then issue the queued ones. Called once per frame by the main thread.
+
+	@param frameBudget : Bytes copied this frame
+	*/
+	void Update(size_t frameBudget);
+
+	/**
+	@brief Issue every queued request and wait for the GPU, main thread only
+	*/
+	void Flush();
+
+	/**
+	@brief true if requests are queued or in flight
+	*/
+	bool HasPendingRequests() const;
+
+	UploadStats GetStats() const;
+};
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <filesystem>
+
+#include "Types/GUID.hpp"
+#include "Tools/FlatHashMap.hpp"
+
+class ResourcesTaskPool;
+
+/**
+@brief Information of an asset known without opening its .meta file
+*/
+struct AssetRecord
+{
+	HYGUID				uid;
+	std::string			typeName = "";		/** @brief Reflected name of the resource class */
+	std::string			path = "";			/** @brief Path of the resource file (path of the .meta without its extension) */
+	uint32_t			directoryIndex = 0;	/** @brief Directory containing the .meta */
+
+	int64_t				metaTime = 0;		/** @brief Last write time of the .meta when the record was built */
+	uint64_t			fileSize = 0;		/** @brief Size of the resource file when the record was built */
+	int64_t				fileTime = 0;		/** @brief Last write time of the resource file when the record was built */
+
+	std::vector<HYGUID>	dependencies;		/** @brief Resources referenced by this one */
+
+	uint64_t			cookedOffset = 0;	/** @brief Location of cooked data in a cooked cache, 0 if none */
+	uint64_t			cookedSize = 0;
+};
+
+/**
+@brief Persistent database of the assets of a directory, stored in a binary manifest mapped in memory at startup.
+Records are validated with the last write time of their directory and of their .meta : unchanged directories are not
+enumerated, only the .meta of their records are checked, changed ones are enumerated again.
+In both cases only the new or modified .meta files are parsed.
+*/
+class AssetDatabase
+{
+public:
+	/**
+	@brief Counters of the last refresh
+	*/
+	struct RefreshStats
+	{
+		bool		manifestLoaded = false;
+		size_t		reusedRecords = 0;
+		size_t		parsedRecords = 0;
+		size_t		removedRecords = 0;
+		size_t		scannedDirectories = 0;
+	};
+
+private:
+	struct DirectoryRecord
+	{
+		std::string	path = "";
+		int64_t		time = 0;
+	};
+
+	std::string m_rootPath;
+	std::string m_manifestPath;
+
+	std::vector<DirectoryRecord> m_directories;
+	std::vector<AssetRecord> m_records;
+	FlatHashMap<HYGUID, size_t> m_recordsByUID;
+
+	RefreshStats m_stats;
+	bool m_dirty = false;
+
+//	Constructors
+
+public:
+	/**
+	@param rootPath : Directory of the assets
+	@param manifestPath : File storing the database
+	*/
+	AssetDatabase(const std::string& rootPath, const std::string& manifestPath);
+
+//	Functions
+
+private:
+	/**
+	@brief Read the manifest, the database stays empty if it is missing or invalid
+
+	@return bool : true if the manifest has been loaded
+	*/
+	bool LoadManifest();
+
+	/**
+	@brief Parse a .meta file and stat its resource file
+
+	@param metaPath : Path of the .meta
+	@param record : Record to fill
+
+	@return bool : true if the .meta is valid
+	*/
+	static bool ParseMeta(const std::filesystem::path& metaPath, AssetRecord& record);
+
+public:
+	/**
+	@brief Get the path of the manifest of a directory in the cache folder
+
+	@param rootPath : Directory of the assets
+	*/
+	static std::string GetDefaultManifestPath(const std::string& rootPath);
+
+	/**
+	@brief Load the manifest and bring it up to date with the file system
+
+	@param taskPool : Pool used to scan new directories and parse .meta files
+	*/
+	void Refresh(ResourcesTaskPool& taskPool);
+
+	/**
+	@brief Set the dependencies of a record, the database is marked as modified if they changed
+
+	@param uid : GUID of the asset
+	@param dependencies : GUID of the resources it references
+	*/
+	void SetDependencies(const HYGUID& uid, const std::vector<HYGUID>& dependencies);
+
+	/**
+	@brief Write the manifest if the database changed since it has been loaded
+
+	@return bool : true if the manifest is up to date on disk
+	*/
+	bool Save();
+
+	const std::vector<AssetRecord>& GetRecords() const;
+	const AssetRecord* GetRecord(const HYGUID& uid) const;
+	const RefreshStats& GetStats() const;
+};
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <functional>
+
+#include "Resources/ResourceType.hpp"
+#include "Tools/ContentHash.hpp"
+#include "Tools/FlatHashMap.hpp"
+#include "Types/GUID.hpp"
+
+class Resource;
+class ResourcesManager;
+
+/**
+@brief Content addressed index of the sub-assets created by imports (embedded textures, materials and meshes) : a content imported
+again maps to the resource imported first, so it is stored, loaded and uploaded once. The index is kept in a binary file of the cache
+folder, entries whose resource no longer exists are dropped when they are found.
+Each resource also keeps the imports referencing it : a resource shared by several models is never imported again in place.
+*/
+class ImportContentIndex
+{
+public:
+	/**
+	@brief Create a resource for a content not imported yet, called with the index locked
+	*/
+	using CreateFunction = std::function<Resource*()>;
+
+	/**
+	@brief Size and second hash of a content (see ContentHash::ComputeCheck), compared on a hit before a content is mapped to a resource.
+	Left empty for contents small enough to be hashed whole, like the materials
+	*/
+	struct ContentCheck
+	{
+		uint64_t size = 0;
+		uint64_t hash = 0;
+
+		bool operator==(const ContentCheck& other) const = default;
+	};
+
+private:
+	struct Key
+	{
+		Hash128			hash;
+		RESOURCE_TYPE	type = RESOURCE_TYPE::UNKNOWN;
+
+		bool operator==(const Key& other) const = default;
+	};
+
+	struct KeyHash
+	{
+		size_t operator()(const Key& key) const
+		{
+			// The content hash is already well mixed, the type only moves keys of different types apart
+			return static_cast<size_t>(key.hash.low ^ details::Mix64(static_cast<uint64_t>(key.type)));
+		}
+	};
+
+	struct Entry
+	{
+		HYGUID			uid;
+		ContentCheck	check;
+	};
+
+//	Variables
+
+private:
+	ResourcesManager& m_resources;
+	std::string m_path;
+
+	std::mutex m_mutex;
+	bool m_loaded = false;
+	bool m_dirty = false;
+
+	FlatHashMap<Key, Entry, KeyHash> m_entries;
+
+	//	Content of each resource, to replace its entry when it is imported again with another content
+	FlatHashMap<HYGUID, Key> m_keys;
+
+	//	Imports (models) referencing each resource
+	FlatHashMap<HYGUID, std::vector<HYGUID>> m_referencers;
+
+//	Constructors
+
+public:
+	/**
+	@param resources : Manager of the indexed resources
+	@param path : File of the index
+	*/
+	ImportContentIndex(ResourcesManager& resources, const std::string& path);
+
+	ImportContentIndex(ImportContentIndex const&) = delete;
+	ImportContentIndex& operator=(ImportContentIndex const&) = delete;
+
+//	Functions
+
+private:
+	/**
+	@brief Load the index file on first use, m_mutex must be locked
+	*/
+	void LoadIfNeeded();
+
+	/**
+	@brief Get the entry of a content if its resource still exists, the entry is erased if its resource was deleted or changed type.
+	m_mutex must be locked
+	*/
+	Entry* FindUnsafe(const Key& key);
+
+	/**
+	@brief Map a content to a resource, replacing the previous content of the resource. m_mutex must be locked
+	*/
+	void SetUnsafe(const Key& key, const Entry& entry);
+
+	/**
+	@brief Add an import to the referencers of a resource. m_mutex must be locked
+	*/
+	void AddReferencerUnsafe(const HYGUID& uid, const HYGUID& referencer);
+
+public:
+	/**
+	@brief Get the resource imported with a content, or create it. Thread-safe : two imports of the same content create one resource
+
+	@param type : Type of the resource
+	@param hash : Hash of the content the resource is imported from, with its import settings
+	@param check : Check of the content, a hit with another check is a hash collision and gets a new resource
+	@param referencer : Import asking for the resource, added to its referencers
+	@param create : Create the resource if the content is not indexed, may return nullptr
+	@param created : true if the resource was created by create
+	@return Resource* : Resource of the content
+	*/
+	Resource* FindOrCreate(RESOURCE_TYPE type, const Hash128& hash, const ContentCheck& check, const HYGUID& referencer,
+		const CreateFunction& create, bool& created);
+
+	/**
+	@brief Map the new content of a resource about to be imported again in place, thread-safe.
+	Referencers which no longer exist are dropped first.
+
+	@param resource : Resource keeping its GUID
+	@param hash : Hash of its new content
+	@param check : Check of its new content
+	@param referencer : Import of the resource
+	@return bool : false if another import references the resource : it is left unchanged, the referencer is removed from it
+	and the new content must be imported in another resource
+	*/
+	bool Reuse(const Resource& resource, const Hash128& hash, const ContentCheck& check, const HYGUID& referencer);
+
+	/**
+	@brief Write the index in its file if it changed, thread-safe
+
+	@return bool : false if the file could not be written
+	*/
+	bool Save();
+};
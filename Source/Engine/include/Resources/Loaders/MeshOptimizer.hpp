@@ -0,0 +1,78 @@
+#pragma once
+
+#include <span>
+#include <vector>
+#include <cstddef>
+
+#include "Resources/Types.hpp"
+
+/**
+@brief Reorder the triangles and vertices of imported sub meshes for the GPU : post transform vertex cache (Tipsify),
+view independent overdraw (clusters sorted from the outside in) and vertex fetch (vertices in first use order).
+*/
+class MeshOptimizer
+{
+public:
+	// FIFO size of the simulated post transform cache
+	static constexpr unsigned int VertexCacheSize = 16;
+
+	// Remap value of the vertices no triangle uses
+	static constexpr unsigned int UnusedVertex = ~0u;
+
+	struct VertexCacheStats
+	{
+		size_t triangleCount = 0;
+		size_t vertexCount = 0;				// Vertices used by the triangles
+		size_t transformedVertexCount = 0;	// Cache misses
+
+		float ACMR = 0.f;	// Average cache miss ratio, transformed vertices per triangle
+		float ATVR = 0.f;	// Average transformed vertex ratio, transformed vertices per used vertex (1 is optimal)
+	};
+
+//	Functions
+
+public:
+	/**
+	@brief Simulate a FIFO post transform cache on a triangle list
+
+	@param indices : Triangle list
+	@param vertexCount : Number of vertices indexed
+	@param cacheSize : Entries of the cache
+	@return VertexCacheStats : Misses of the cache
+	*/
+	static VertexCacheStats AnalyzeVertexCache(std::span<const int> indices, size_t vertexCount, unsigned int cacheSize = VertexCacheSize);
+
+	/**
+	@brief Reorder the triangles for the post transform cache with Tipsify (Sander et al. 2007), fanning around the vertices still in cache
+	*/
+	static void OptimizeVertexCache(std::vector<int>& indices, size_t vertexCount, unsigned int cacheSize = VertexCacheSize);
+
+	/**
+	@brief Reorder clusters of triangles so the ones facing away from the center are drawn first and occlude the others.
+	Triangles should be optimized for the vertex cache first, clusters are cut where it does not lose more than threshold in ACMR.
+
+	@param indices : Triangle list
+	@param vertices : Vertices indexed
+	@param threshold : Allowed ACMR ratio over the cache optimized order, 1.05 loses at most 5%
+	@param cacheSize : Entries of the simulated cache
+	*/
+	static void OptimizeOverdraw(std::vector<int>& indices, std::span<const Vertex> vertices, float threshold = 1.05f, unsigned int cacheSize = VertexCacheSize);
+
+	/**
+	@brief Number the vertices in the order the triangles use them, unused vertices are dropped
+
+	@param indices : Triangle list, remapped
+	@param vertexCount : Number of vertices indexed
+	@param remap : Filled with the new index of each vertex, UnusedVertex if no triangle uses it
+	@return size_t : Number of vertices left
+	*/
+	static size_t OptimizeVertexFetch(std::vector<int>& indices, size_t vertexCount, std::vector<unsigned int>& remap);
+
+	/**
+	@brief Move vertex attributes to the indices given by OptimizeVertexFetch
+	*/
+	template<typename T>
+	static void RemapVertices(std::vector<T>& vertices, const std::vector<unsigned int>& remap, size_t vertexCount);
+};
+
+#include "Resources/Loaders/MeshOptimizer.inl"
@@ -0,0 +1,14 @@
+
+template<typename T>
+inline void MeshOptimizer::RemapVertices(std::vector<T>& vertices, const std::vector<unsigned int>& remap, size_t vertexCount)
+{
+	std::vector<T> remapped(vertexCount);
+
+	for (size_t i = 0; i < vertices.size() && i < remap.size(); ++i)
+	{
+		if (remap[i] != UnusedVertex)
+			remapped[remap[i]] = vertices[i];
+	}
+
+	vertices.swap(remapped);
+}
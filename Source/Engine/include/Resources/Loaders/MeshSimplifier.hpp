@@ -0,0 +1,44 @@
+#pragma once
+
+#include <span>
+#include <vector>
+#include <cstddef>
+
+#include "Resources/Types.hpp"
+
+/**
+@brief Quadric error metric simplification (Garland and Heckbert) of triangle lists by edge collapses onto existing vertices,
+so the output indexes the same vertex buffer. Vertices on UV seams and attribute borders only move along their seam or border,
+and corners where more than two attribute sets meet never move.
+*/
+class MeshSimplifier
+{
+public:
+	struct ChainSettings
+	{
+		unsigned int levelCount = 4;	// Levels including the full detail one
+		float reduction = 0.5f;			// Triangles kept from one level to the next
+		float maxError = 0.05f;			// Relative to the bounding sphere radius, levels stop past it
+	};
+
+//	Functions
+
+public:
+	/**
+	@brief Simplify a triangle list
+
+	@param indices : Triangle list
+	@param vertices : Vertices indexed
+	@param targetIndexCount : Stop once the output has this many indices or less
+	@param maxError : Stop before collapses with a larger error, relative to GetScale
+	@param output : Simplified triangle list, indexing vertices
+	@return float : Error of the output, relative to GetScale
+	*/
+	static float Simplify(std::span<const int> indices, std::span<const Vertex> vertices, size_t targetIndexCount, float maxError,
+		std::vector<int>& output);
+
+	/**
+	@brief Get the distance errors are relative to : the radius of the sphere around the bounds of the vertices
+	*/
+	static float GetScale(std::span<const Vertex> vertices);
+};
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <span>
+#include <vector>
+#include <cstddef>
+
+#include "Resources/Types.hpp"
+
+/**
+@brief Split of the triangles of large sub meshes in meshlets : clusters of neighbour triangles with a bounded number of vertices and triangles,
+grown from a seed triangle by the neighbours adding the fewest vertices, then the closest ones. Each meshlet keeps a bounding sphere and a normal cone for culling.
+*/
+class MeshletBuilder
+{
+public:
+	static constexpr unsigned int MaxVertices = 64;
+	static constexpr unsigned int MaxTriangles = 124;
+
+	// Sub meshes with less triangles are drawn whole, their meshlets would cost more to cull than they save
+	static constexpr size_t MinTriangleCount = 4096;
+
+//	Functions
+
+public:
+	/**
+	@brief Split a triangle list in meshlets, the triangles are reordered meshlet after meshlet and for the vertex cache inside each meshlet
+
+	@param indices : Triangle list, reordered
+	@param vertices : Vertices indexed
+	@param meshlets : Filled with the meshlets, ranges of indices
+	@param maxVertices : Vertices of a meshlet
+	@param maxTriangles : Triangles of a meshlet
+	*/
+	static void Build(std::vector<int>& indices, std::span<const Vertex> vertices, std::vector<Meshlet>& meshlets,
+		unsigned int maxVertices = MaxVertices, unsigned int maxTriangles = MaxTriangles);
+
+	/**
+	@brief Compute the bounding sphere and the normal cone of a meshlet from its triangles
+
+	@param indices : Triangles of the meshlet
+	@param vertices : Vertices indexed
+	@param meshlet : Meshlet to fill, its index range is kept
+	*/
+	static void ComputeBounds(std::span<const int> indices, std::span<const Vertex> vertices, Meshlet& meshlet);
+};
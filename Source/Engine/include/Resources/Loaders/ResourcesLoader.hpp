@@ -3,7 +3,9 @@
 #include <string>
 
 #include "Resources/Parsers/AssimpParser.hpp"
+#include "Resources/SourceAssetTracker.hpp"
 #include "Tools/PathConfig.hpp"
+#include "Tools/FlatHashMap.hpp"
 
 #include "Resources/Resource/Model.hpp"
 #include "Resources/Resource/Texture.hpp"
@@ -14,7 +16,7 @@
 #include "EngineDLL.hpp"
 
 template <typename OBJ>
-using RefContainer = std::unordered_map<HYGUID, OBJ>;
+using RefContainer = FlatHashMap<HYGUID, OBJ>;
 
 enum class ExtensionType
 {
@@ -126,6 +128,15 @@ private:
 	*/
 	static void LoadNotCachedRecurse(const std::filesystem::path& path, bool& foundResource);
 
+	/**
+	@brief Import the new source files and import again the changed ones with the resources depending on them, then save the tracker
+
+	@param tracker : Records of the source files, refreshed
+	@param changes : Changes found by the refresh of the tracker
+	@param reimported : Resources imported again or rebuilt from a reimported dependency
+	*/
+	static void ApplySourceChanges(SourceAssetTracker& tracker, const std::vector<SourceAssetTracker::Change>& changes, std::vector<Resource*>& reimported);
+
 public:
 
 	/**
@@ -143,6 +154,24 @@ public:
 	*/
 	static ENGINE_API void LoadNotCachedResources(std::string_view path);
 
+	/**
+	Import the new source files of the directory of a tracker, and import again the source files whose content or import settings changed
+	with the resources depending on them. Unchanged files are not read. This function will not return until all tasks are completed.
+
+	@param tracker : Records of the source files, saved once the resources are up to date
+	@param reimported : Resources imported again or rebuilt from a reimported dependency
+	*/
+	static ENGINE_API void ReimportChangedResources(SourceAssetTracker& tracker, std::vector<Resource*>& reimported);
+
+	/**
+	Same as ReimportChangedResources, only the given files are checked : the paths reported by a file watcher.
+
+	@param tracker : Records of the source files, saved once the resources are up to date
+	@param paths : Files which may have been added, modified or removed, and removed directories
+	@param reimported : Resources imported again or rebuilt from a reimported dependency
+	*/
+	static ENGINE_API void ReimportChangedFiles(SourceAssetTracker& tracker, const std::vector<std::string>& paths, std::vector<Resource*>& reimported);
+
 
 	//void LoadDefaultResources();
 
@@ -204,9 +233,10 @@ public:
 	@brief Load a model from its filepath with ASSIMP
 
 	@param Model& : model reference
+	@param reused : meshes and materials of the previous import of the model, they are filled again
 	@return bool : true if success, false if failure 
 	*/
-	static bool LoadModel(Model& model);
+	static bool LoadModel(Model& model, const AssimpParser::ReusedResources& reused = {});
 
 	/**
 	@brief Load a texture from its filepath with STB_IMAGE
@@ -218,7 +248,7 @@ public:
 
 
 	/**
-	@brief Load a texture from its filepath with STB_IMAGE, data not free
+	@brief Load a texture from its texture cache, or from its filepath with STB_IMAGE then cook its cache, data not free
 
 	@param Texture& : texture reference
 	@return bool : true if success, false if failure
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Resources/Parsers/ParserFlags.hpp"
+#include "Tools/Flags.hpp"
+
+struct TextureData;
+struct TextureMipLevel;
+
+/**
+@brief Cache of decoded textures. A .texcache file stores the pixels of a texture with its whole mip chain,
+so later loads map the file and upload it as is instead of decoding the source image and generating mips.
+*/
+class TextureCache
+{
+public:
+	enum class MipFilter
+	{
+		BOX,	// Average of the covered texels, no ringing
+		KAISER,	// Kaiser windowed sinc, sharper
+	};
+
+//	Functions
+
+public:
+	/**
+	@brief Get the cache file of a source image loaded with given flags
+	*/
+	static std::string GetCachePath(const std::string& sourcePath, const Flags<EImageSTB>& flags);
+
+	/**
+	@brief Load a texture from its cache file, the pixels stay mapped until the texture data is freed
+
+	@param cachePath : Cache file of the texture
+	@param sourcePath : Source image of the texture
+	@param flags : Loading flags of the texture
+	@param data : Loaded texture, only written on success
+	@return bool : true if the cache exists and is up to date with the source image and the flags
+	*/
+	static bool Load(const std::string& cachePath, const std::string& sourcePath, const Flags<EImageSTB>& flags, TextureData& data);
+
+	/**
+	@brief Build the mip chain of a decoded image and compress it when its flags ask for it
+
+	@param data : Image decoded with stb_image
+	@param flags : Loading flags of the texture
+	@param cooked : Cooked texture, its pixels are owned by its storage
+	@return bool : false if the image is empty
+	*/
+	static bool Cook(const TextureData& data, const Flags<EImageSTB>& flags, TextureData& cooked);
+
+	/**
+	@brief Write the cache file of a cooked texture
+
+	@param cachePath : Cache file of the texture
+	@param sourcePath : Source image of the texture, its size and write time are stored to validate the cache
+	@param flags : Loading flags of the texture
+	@param cooked : Texture returned by Cook
+	@return bool : true if the cache file has been written
+	*/
+	static bool Save(const std::string& cachePath, const std::string& sourcePath, const Flags<EImageSTB>& flags, const TextureData& cooked);
+
+	/**
+	@brief Build a mip chain down to 1x1, the first level being a copy of the image
+
+	@param data : Image (8 or 16 bits per channel)
+	@param filter : Downsampling filter
+	@param isSRGB : Color channels are filtered in linear space, alpha is always linear
+	@param wrap : Texels out of the image are wrapped instead of clamped
+	@param levels : Levels of the chain, offsets in pixels
+	@param pixels : Pixels of every level, one after the other
+	*/
+	static void BuildMipChain(const TextureData& data, MipFilter filter, bool isSRGB, bool wrap,
+		std::vector<TextureMipLevel>& levels, std::vector<unsigned char>& pixels);
+};
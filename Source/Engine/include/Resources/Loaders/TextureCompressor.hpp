@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include "Resources/Parsers/ParserFlags.hpp"
+#include "Tools/Flags.hpp"
+
+enum class BlockFormat : uint8_t
+{
+	NONE,
+	BC1,	// RGB, 4 bits per texel
+	BC3,	// RGBA, 8 bits per texel (BC1 color + BC4 alpha)
+	BC4,	// R, 4 bits per texel
+	BC5,	// RG, 8 bits per texel (two BC4)
+	BC7,	// RGBA, 8 bits per texel (mode 6 only)
+};
+
+/**
+@brief CPU encoder of 4x4 block compressed formats, used when textures are cooked.
+The format of a texture is chosen with its IMG_COMPRESS_* loading flags.
+*/
+class TextureCompressor
+{
+public:
+	/**
+	@brief Get the format used by a texture
+
+	@param flags : Loading flags of the texture
+	@param channels : Number of channels of the decoded image
+	@param is16Bits : true if the image has 16 bits per channel, these are never compressed
+
+	@return BlockFormat : NONE if the texture stays uncompressed
+	*/
+	static BlockFormat ChooseFormat(const Flags<EImageSTB>& flags, int channels, bool is16Bits);
+
+	/**
+	@brief Get the OpenGL internal format of a block format
+	*/
+	static int GetGLFormat(BlockFormat format);
+
+	/**
+	@brief Get the size of a 4x4 block in bytes (8 or 16)
+	*/
+	static size_t GetBlockSize(BlockFormat format);
+
+	/**
+	@brief Get the size of a compressed image in bytes
+	*/
+	static size_t GetCompressedSize(BlockFormat format, int width, int height);
+
+	/**
+	@brief Encode a 4x4 block
+
+	@param format : Format of the block
+	@param rgba : 16 texels, 4 bytes each, row by row
+	@param output : GetBlockSize(format) bytes
+	*/
+	static void CompressBlock(BlockFormat format, const uint8_t* rgba, uint8_t* output);
+
+	/**
+	@brief Encode a whole 8 bits image, edge texels are repeated in partial blocks
+
+	@param format : Format of the compressed image
+	@param pixels : Image, row by row
+	@param width : Width of the image
+	@param height : Height of the image
+	@param channels : Number of channels (1 to 4), missing channels are read as 0 and alpha as 255
+	@param output : GetCompressedSize(format, width, height) bytes
+	*/
+	static void CompressImage(BlockFormat format, const uint8_t* pixels, int width, int height, int channels, uint8_t* output);
+};
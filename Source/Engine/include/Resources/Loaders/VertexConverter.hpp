@@ -0,0 +1,37 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+#include "Resources/Types.hpp"
+
+/**
+@brief Interleave the vertex streams of an imported sub mesh into vertices, with SSE2 loads and stores where available
+*/
+class VertexConverter
+{
+public:
+	/**
+	@brief Attribute streams of packed 3 floats elements, as assimp stores them. Missing streams are nullptr and converted to zero
+	*/
+	struct Streams
+	{
+		const float* positions = nullptr;
+		const float* normals = nullptr;
+		const float* uvs = nullptr;			// The third float of each element is not read
+		const float* tangents = nullptr;
+		size_t count = 0;
+	};
+
+//	Functions
+
+public:
+	/**
+	@brief Convert the streams in one pass, the vertices are sized once. Bitangents are zeroed, they are rebuilt by the import
+
+	@param streams : Streams of the sub mesh, positions are required when count is not zero
+	@param vertices : Converted vertices, previous content is overwritten
+	@param useSIMD : false to convert with the scalar loop only, the output is the same
+	*/
+	static void Convert(const Streams& streams, std::vector<Vertex>& vertices, bool useSIMD = true);
+};
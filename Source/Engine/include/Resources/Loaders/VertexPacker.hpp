@@ -0,0 +1,85 @@
+#pragma once
+
+#include <span>
+#include <cstdint>
+#include <cstddef>
+
+#include "Resources/Types.hpp"
+#include "Resources/Parsers/ParserFlags.hpp"
+
+/**
+@brief Encoder and decoder of the vertex layouts. Positions of the packed layouts are stored in the bounds of their sub mesh,
+normals and tangents are octahedral and the bitangent is rebuilt from its sign.
+*/
+class VertexPacker
+{
+public:
+	/**
+	@brief Get the size of a vertex in bytes
+	*/
+	static size_t GetVertexSize(EVertexLayout layout);
+
+	/**
+	@brief Check if a sub mesh can be indexed with 16 bits indices
+	*/
+	static bool CanUseShortIndices(size_t vertexCount);
+
+	/**
+	@brief Get the box around the positions of vertices, zero if there are none
+	*/
+	static void ComputeBounds(std::span<const Vertex> vertices, Vector3& min, Vector3& max);
+
+	/**
+	@brief Get the transform from the packed positions in [-1, 1] to the positions in mesh space
+
+	@param layout : Layout of the positions, FLOAT positions are not transformed
+	@param min : Minimum of the bounds the positions are packed in
+	@param max : Maximum of the bounds the positions are packed in
+	@param offset : Center of the bounds
+	@param scale : Half size of the bounds, never zero
+	*/
+	static void GetPositionTransform(EVertexLayout layout, const Vector3& min, const Vector3& max, Vector3& offset, Vector3& scale);
+
+	/**
+	@brief Encode vertices
+
+	@param layout : Layout of the output
+	@param vertices : Vertices to encode
+	@param min : Minimum of the bounds of the vertices
+	@param max : Maximum of the bounds of the vertices
+	@param output : vertices.size() * GetVertexSize(layout) bytes
+	*/
+	static void Pack(EVertexLayout layout, std::span<const Vertex> vertices, const Vector3& min, const Vector3& max, unsigned char* output);
+
+	/**
+	@brief Decode vertices, the bitangents of the packed layouts are rebuilt
+
+	@param layout : Layout of the input
+	@param input : count * GetVertexSize(layout) bytes
+	@param count : Number of vertices
+	@param min : Minimum of the bounds the vertices were encoded with
+	@param max : Maximum of the bounds the vertices were encoded with
+	@param output : count vertices
+	*/
+	static void Unpack(EVertexLayout layout, const unsigned char* input, size_t count, const Vector3& min, const Vector3& max, Vertex* output);
+
+	/**
+	@brief Convert a float to a half float, rounded to the nearest even
+	*/
+	static uint16_t FloatToHalf(float value);
+
+	/**
+	@brief Convert a half float to a float
+	*/
+	static float HalfToFloat(uint16_t value);
+
+	/**
+	@brief Encode a unit vector on an octahedron, keeping the closest of the four nearest snorm16 values
+	*/
+	static void EncodeOctahedral(const Vector3& vector, int16_t output[2]);
+
+	/**
+	@brief Decode a unit vector from its octahedral snorm16 encoding
+	*/
+	static Vector3 DecodeOctahedral(const int16_t input[2]);
+};
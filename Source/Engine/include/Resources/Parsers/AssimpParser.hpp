@@ -3,29 +3,44 @@
 #include <string>
 #include <vector>
 #include <mutex>
+#include <unordered_map>
 
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
 
 #include "Tools/Flags.hpp"
+#include "Tools/ContentHash.hpp"
+#include "Resources/ImportContentIndex.hpp"
 #include "Resources/Parsers/ParserFlags.hpp"
+#include "Resources/Loaders/MeshSimplifier.hpp"
 
+class Resource;
 class Model;
 class Mesh;
+struct MeshData;
+struct SkeletalData;
 class Texture;
+class Material;
 class ResourcesManager;
+struct Vertex;
 
 class AssimpParser
 {
 public:
+	/*
+	@brief Meshes and materials of a model being reimported, by path : they are filled again instead of created and keep their GUID
+	*/
+	using ReusedResources = std::unordered_map<std::string, Resource*>;
+
 	/*
 	@brief Try to load a model with its filepath
 
 	@param model : Model&
 	@param flags : int - Assimp Load Flags
+	@param reused : const ReusedResources& - resources of the previous import of the model, filled on the calling thread
 	*/
-	static bool LoadModel(Model& model, int flags);
+	static bool LoadModel(Model& model, int flags, const ReusedResources& reused = {});
 
 	/*
 	@brief Try to load a texture with its filepath
@@ -37,17 +52,126 @@ public:
 	static bool LoadTexture(Texture& texture, const Flags<EImageSTB>& flags, bool shouldFreeData);
 
 	/*
-	@brief Free the texture s
+	@brief Free the texture pixels, decoded by stb_image or owned by the texture cache
 
 	@param texture : Texture&
 	*/
 	static void FreeTexture(Texture& texture);
 
 private:
-	static void ProcessMaterials(Model& model, const aiScene* scene);
+	/*
+	@brief Sub-assets of an import mapped to resources imported before from the same content, instead of being written and loaded again
+	*/
+	struct DedupReport
+	{
+		uint32_t textures = 0;
+		uint32_t materials = 0;
+		uint32_t meshes = 0;
+		size_t savedBytes = 0;
+	};
+
+	/*
+	@brief State of the import of a model, only used by the importing thread
+	*/
+	struct ImportState
+	{
+		const ReusedResources& reused;
+		DedupReport report;
+
+		// Embedded textures are hashed once, for their material then for themselves
+		std::unordered_map<const aiTexture*, Hash128> textureHashes;
+	};
+
+	static void ProcessMaterials(Model& model, const aiScene* scene, ImportState& state);
+
+	static void ProcessNode(Model& model, aiNode* node, const aiScene* scene, const std::string& parentID, ImportState& state);
+
+	/*
+	@brief Hash the image of an embedded texture, as it is stored in the model
+
+	@param state : ImportState& - import keeping the hashes
+	@param aiTexture : const aiTexture* - embedded texture
+	@return Hash128 - hash of the image
+	*/
+	static Hash128 HashEmbeddedTexture(ImportState& state, const aiTexture* aiTexture);
+
+	/*
+	@brief Hash what a material is imported from : its colors and the content or path of its textures
+
+	@param state : ImportState& - import keeping the texture hashes
+	@param model : const Model& - model of the material, its textures are searched in its directory
+	@param material : const aiMaterial* - assimp material
+	@param scene : const aiScene* - scene of the embedded textures
+	@return Hash128 - hash of the material
+	*/
+	static Hash128 HashMaterial(ImportState& state, const Model& model, const aiMaterial* material, const aiScene* scene);
+
+	/*
+	@brief Hash the sub meshes of a node with their material and the import settings of the model
+
+	@param model : const Model& - model of the mesh, its materials are processed
+	@param node : const aiNode* - node of the sub meshes
+	@param scene : const aiScene* - scene of the assimp meshes
+	@param isSkeletal : bool - the bones are hashed too
+	@param materials : std::vector<Material*>& - material of each sub mesh
+	@param check : ImportContentIndex::ContentCheck& - size and second hash of the hashed data, to tell a hash collision from a shared mesh
+	@return Hash128 - hash of the mesh
+	*/
+	static Hash128 HashMesh(const Model& model, const aiNode* node, const aiScene* scene, bool isSkeletal, std::vector<Material*>& materials,
+		ImportContentIndex::ContentCheck& check);
 
-	static void ProcessNode(Model& model, aiNode* node, const aiScene* scene, const std::string& parentID);
-	static void ProcessMesh(Model& model, Mesh* mesh, aiMesh* aimesh, const aiScene* scene);
+	/*
+	@brief Fill the slot of a sub mesh from its assimp mesh, slots are sized before the tasks so that sub meshes keep the order of the node
+
+	@param model : Model& - model of the mesh
+	@param data : MeshData& - slot of the sub mesh
+	@param skeletalData : SkeletalData* - slot of its bone data, nullptr if the mesh is not skeletal
+	@param aimesh : const aiMesh* - assimp sub mesh
+	*/
+	static void ProcessMesh(Model& model, MeshData& data, SkeletalData* skeletalData, const aiMesh* aimesh);
+
+	/*
+	@brief Convert the vertex streams of an assimp mesh in one pass with the VertexConverter, the vertices are sized once
+
+	@param aimesh : const aiMesh* - assimp sub mesh
+	@param vertices : std::vector<Vertex>& - converted vertices
+	*/
+	static void ConvertVertices(const aiMesh* aimesh, std::vector<Vertex>& vertices);
+
+	/*
+	@brief Write an embedded texture on disk : compressed images as they are stored in the model, raw texels as a PNG
+
+	@param aiTexture : const aiTexture* - embedded texture
+	@param path : const std::string& - file to write
+	@return bool - false if the file could not be written
+	*/
+	static bool WriteEmbeddedTexture(const aiTexture* aiTexture, const std::string& path);
+
+	/*
+	@brief Reorder the triangles and vertices of a sub mesh for the vertex cache, overdraw and vertex fetch, then log the cache stats
+
+	@param data : MeshData& - sub mesh
+	@param skeletalData : SkeletalData* - bone weights remapped with the vertices, nullptr if the mesh is not skeletal
+	@param meshName : const std::string& - name in the log
+	*/
+	static void OptimizeMesh(MeshData& data, SkeletalData* skeletalData, const std::string& meshName);
+
+	/*
+	@brief Append the coarser levels of detail of a sub mesh to its indices, each one simplified from the previous one, then log their triangles and error
+
+	@param data : MeshData& - sub mesh, optimized
+	@param settings : const MeshSimplifier::ChainSettings& - levels to generate
+	@param meshName : const std::string& - name in the log
+	*/
+	static void GenerateLODs(MeshData& data, const MeshSimplifier::ChainSettings& settings, const std::string& meshName);
+
+	/*
+	@brief Split a large sub mesh in meshlets, reorder its vertices for the new triangle order, then log the meshlets size
+
+	@param data : MeshData& - sub mesh, optimized and without levels of detail yet
+	@param meshName : const std::string& - name in the log
+	*/
+	static void GenerateMeshlets(MeshData& data, const std::string& meshName);
 	
-	static void LoadMaterialTextures(Texture** texture, Model& model, aiMaterial* mat, aiTextureType type, const aiScene* scene, Texture* defaultTexture);
+	static void LoadMaterialTextures(Texture** texture, Model& model, aiMaterial* mat, aiTextureType type, const aiScene* scene, Texture* defaultTexture, ImportState& state);
 };
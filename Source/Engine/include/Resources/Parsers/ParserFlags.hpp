@@ -11,6 +11,18 @@ enum class HY_ENUM() EImageSTB
 	IMG_FORCE_RGBA = 1 << 4,
 	IMG_GEN_MIPMAPS = 1 << 5,
 	IMG_WRAP_REPEAT = 1 << 6,
+	IMG_SRGB = 1 << 7,
+	IMG_COMPRESS_COLOR = 1 << 8,	// BC7, or BC1/BC3 with IMG_COMPRESS_FAST
+	IMG_COMPRESS_NORMAL = 1 << 9,	// BC5, red and green only
+	IMG_COMPRESS_MASK = 1 << 10,	// BC4, red only
+	IMG_COMPRESS_FAST = 1 << 11,
+};
+
+enum class HY_ENUM() EVertexLayout
+{
+	FLOAT,			// 56 bytes : float position, normal, UVs, tangent and bitangent
+	PACKED_SNORM,	// 20 bytes : snorm16 position in the sub mesh bounds, octahedral normal and tangent, half UVs
+	PACKED_HALF,	// 20 bytes : half float position in the sub mesh bounds, octahedral normal and tangent, half UVs
 };
 
 File_ParserFlags_GENERATED
\ No newline at end of file
@@ -73,6 +73,8 @@ public:
 	virtual void Serialize() override;
 	virtual void Deserialize() override;
 
+	virtual void GetDependencies(std::vector<HYGUID>& dependencies) const override;
+
 	Material_GENERATED
 };
 
@@ -1,10 +1,14 @@
 #pragma once
 
+#include <span>
 #include <vector>
 
 #include "Resources/Resource/Resource.hpp"
 #include "Resources/Types.hpp"
+#include "Resources/Parsers/ParserFlags.hpp"
 #include "Resources/Animation/Bone.hpp"
+#include "Renderer/StagingRange.hpp"
+#include "Tools/MappedFile.hpp"
 
 #include "Generated/Mesh.rfkh.h"
 
@@ -17,6 +21,64 @@ struct MeshData
 	std::vector<int> indices;
 	Material* material;
 	GPUMeshData* GPUData = nullptr;
+
+	//	Streams of the mapped mesh file, used instead of the vectors when the mesh is loaded from it
+	std::span<const unsigned char> mappedVertices;
+	std::span<const unsigned char> mappedIndices;
+	EVertexLayout	mappedLayout = EVertexLayout::FLOAT;
+	bool			mappedShortIndices = false;
+
+	//	Box around the vertices, the positions of the packed layouts are stored in it
+	Vector3 boundsMin;
+	Vector3 boundsMax;
+
+	//	Levels of detail, from the finest. The index stream holds every level one after the other, empty if the sub mesh has one level
+	std::vector<MeshLOD> lods;
+
+	//	Clusters of the finest level culled one by one, empty for small sub meshes drawn whole
+	std::vector<Meshlet> meshlets;
+
+	size_t GetVertexCount() const;
+
+	/**
+	@brief Get the indices of every level of detail
+	*/
+	size_t GetIndexCount() const;
+
+	/**
+	@brief Get the number of levels of detail, at least one
+	*/
+	size_t GetLODCount() const;
+
+	/**
+	@brief Get the range of indices of a level of detail, the full stream for the first level of a sub mesh without levels
+	*/
+	MeshLOD GetLOD(size_t level) const;
+
+	/**
+	@brief Get the vertices as floats
+
+	@param buffer : Storage of the vertices when they are packed in the mapped file
+	@return std::span<const Vertex> : the vertices, in buffer or in place
+	*/
+	std::span<const Vertex> GetVertices(std::vector<Vertex>& buffer) const;
+
+	/**
+	@brief Get the indices in memory, 16 bits indices if HasShortIndices
+	*/
+	const void* GetIndexData() const;
+	bool HasShortIndices() const;
+
+	/**
+	@brief Get if the indices are still in memory or in the mapped file, the indices in memory are released once in the index buffer
+	*/
+	bool HasIndexData() const;
+
+	/**
+	@brief Free the indices in memory once they are in the index buffer, their count is then read from the GPU data.
+	The mapped stream is kept : its pages are backed by the mesh file, it costs no memory the system can't take back.
+	*/
+	void ReleaseIndices();
 };
 
 struct BoundingBox
@@ -38,24 +100,62 @@ protected:
 
 	BoundingBox	  m_boundingBox;
 
+	//	Layout of the vertices in the mesh file and on the GPU, chosen when the model is imported
+	EVertexLayout m_vertexLayout = EVertexLayout::FLOAT;
+
+	//	Mesh file the sub meshes streams point to, kept open while they are used
+	MappedFile	  m_mappedFile;
+
 public:
 	std::vector<MeshData> subMeshes;
+	StagingRange		  stagingData;
 
 protected:
 	Mesh(const HYGUID & uid, const std::string & name);
 
+private:
+	/**
+	@brief Load the sub meshes from the mapped mesh file, the streams are used in place
+
+	@return bool : false if the file is not a valid mesh file of this version
+	*/
+	bool DeserializeMapped();
+
+	/**
+	@brief Load a mesh file written before the mapped format, the streams are copied
+	*/
+	void DeserializeLegacy();
+
+	/**
+	@brief Copy the mapped streams in the sub meshes vectors and unmap the file, before it is written
+	*/
+	void DetachMappedData();
+
 public:
 	Mesh(const HYGUID& uid);
 
+	virtual void StageGPUData() override;
 	virtual void LoadInGPUMemory() override;
 	virtual void UnloadFromGPUMemory() override;
+	virtual bool IsGPUUploadPending() const override;
+	virtual void ReleaseFiles() override;
 
 	virtual void Serialize() override;
 	virtual void Deserialize() override;
 
+	virtual void GetDependencies(std::vector<HYGUID>& dependencies) const override;
+
+	/**
+	@brief Release the sub meshes and unmap the mesh file before the mesh is imported again, its GPU data must be unloaded first
+	*/
+	virtual void ClearSubMeshes();
+
 	ENGINE_API const BoundingBox& GetBoudingBox() const;
 	void SetBoudingBox(const Vector3& min, const Vector3& max);
 
+	EVertexLayout GetVertexLayout() const;
+	void SetVertexLayout(EVertexLayout layout);
+
 	Mesh_GENERATED
 };
 
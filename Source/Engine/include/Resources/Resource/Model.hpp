@@ -5,6 +5,7 @@
 #include "Resources/Resource/Prefab.hpp"
 #include "Resources/Resource/Material.hpp"
 #include "Resources/Resource/Mesh.hpp"
+#include "Resources/Loaders/MeshSimplifier.hpp"
 #include "ECS/TransformData.hpp"
 
 #include "Generated/Model.rfkh.h"
@@ -22,6 +23,21 @@ private:
 	
 	BoundingBox m_boundingBox;
 
+	// Layout of the vertices of the static meshes imported with the model
+	HY_FIELD() EVertexLayout m_vertexLayout = EVertexLayout::PACKED_SNORM;
+
+	// Levels of detail generated for each static sub mesh, including the full detail one
+	HY_FIELD() unsigned int m_lodCount = 4;
+
+	// Triangles kept from one level of detail to the next
+	HY_FIELD() float m_lodReduction = 0.5f;
+
+	// Largest error of a level of detail, relative to the bounding sphere radius of the sub mesh
+	HY_FIELD() float m_lodMaxError = 0.05f;
+
+	// Split the large static sub meshes in meshlets culled on their own
+	HY_FIELD() bool m_buildMeshlets = true;
+
 protected:
 	std::vector<Mesh*> m_meshes = {};
 	std::vector<TransformData> m_meshesOffsets = {};
@@ -61,11 +77,34 @@ public:
 	virtual void LoadInGPUMemory() override {}
 	virtual void UnloadFromGPUMemory() override {}
 
+	virtual void GetImportSettings(std::string& settings) const override;
+	virtual bool Reimport() override;
+
 	virtual void Serialize() override;
 	virtual void Deserialize() override;
 
+	virtual void GetDependencies(std::vector<HYGUID>& dependencies) const override;
+
 	void AddMaterial(Material& material);
 
+	/*
+	@brief Get the layout the static meshes of the model are packed with, skeletal meshes are always FLOAT
+	*/
+	ENGINE_API EVertexLayout GetVertexLayout() const;
+	ENGINE_API void SetVertexLayout(EVertexLayout layout);
+
+	/*
+	@brief Get the settings of the levels of detail generated for the static meshes of the model
+	*/
+	ENGINE_API MeshSimplifier::ChainSettings GetLODSettings() const;
+	ENGINE_API void SetLODSettings(const MeshSimplifier::ChainSettings& settings);
+
+	/*
+	@brief Get if the large static sub meshes of the model are split in meshlets
+	*/
+	ENGINE_API bool GetBuildMeshlets() const;
+	ENGINE_API void SetBuildMeshlets(bool buildMeshlets);
+
 	ENGINE_API const BoundingBox& GetBoudingBox() const;
 	void SetBoudingBox(const Vector3& min, const Vector3& max);
 	void ComputeBoudingBox();
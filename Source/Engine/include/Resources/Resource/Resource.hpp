@@ -1,20 +1,53 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #include <Refureku/Object.h>
 #include <Refureku/Properties/Instantiator.h>
 
 #include "ECS/SceneObject.hpp"
 #include "Resources/ResourceType.hpp"
+#include "Resources/ResourceState.hpp"
 #include "Types/GUID.hpp"
 #include "Types/Serializable.hpp"
 
 #include "Generated/Resource.rfkh.h"
 
 class ResourcesLoader;
+class ResourcesManager;
+class Resource;
+
+/**
+@brief Intrusive links of a resource in the lookup indices of its ResourcesManager
+*/
+struct ResourceIndexLinks
+{
+	ResourcesManager*	owner = nullptr;			/** @brief Manager indexing the resource, nullptr if not indexed */
+
+	std::string			pathKey = "";				/** @brief Filepath the resource is indexed with */
+	std::string			filenameKey = "";			/** @brief Filename the resource is indexed with */
+	RESOURCE_TYPE		typeKey = RESOURCE_TYPE::UNKNOWN;
+
+	Resource*			nextSamePath = nullptr;		/** @brief Next resource indexed with the same path */
+	Resource*			nextSameFilename = nullptr;	/** @brief Next resource indexed with the same filename */
+	Resource*			previousOfType = nullptr;
+	Resource*			nextOfType = nullptr;
+};
 
 class HY_CLASS() ENGINE_API Resource : public SceneObject, public Serializable
 {
+	friend ResourcesManager;
+
+private:
+#pragma warning(disable:4251)
+	ResourceIndexLinks m_indexLinks;
+#pragma warning(default:4251)
+
+	/**
+	@brief Update the indices of the owning ResourcesManager after a change of filepath, filename or type
+	*/
+	void UpdateIndex();
+
 protected:
 // 'std::string' : dll-export can clash if projects don't have same version of std library, but in this case we know it is good
 #pragma warning(disable:4251) 
@@ -25,6 +58,18 @@ protected:
 
 	RESOURCE_TYPE	m_type = RESOURCE_TYPE::UNKNOWN;
 
+	/**
+	@brief Add the GUID of a resource to a dependency list, if not null
+
+	@param dependencies : list to fill
+	@param resource : dependency
+	*/
+	static void AddDependency(std::vector<HYGUID>& dependencies, const Resource* resource);
+
+#pragma warning(disable:4251)
+	ResourceStateMachine m_state;
+#pragma warning(default:4251)
+
 public:
 	Resource(const HYGUID& uid, const std::string& name);
 
@@ -52,6 +97,27 @@ public:
 	*/
 	RESOURCE_TYPE GetType() const;
 
+	/**
+	@brief Get the loading state of the resource
+
+	@return RESOURCE_STATE : state
+	*/
+	RESOURCE_STATE GetState() const;
+
+	/**
+	@brief Move to another loading state, only if it is the next one, UNLOADED, or CPU_READY from GPU_READY.
+	Safe to call from several threads : only one thread can move the resource to LOADING.
+
+	@param state : desired state
+	@return bool : true if the state changed
+	*/
+	bool TrySetState(RESOURCE_STATE state);
+
+	/**
+	@brief Block the caller while another thread is loading the resource
+	*/
+	void WaitWhileLoading() const;
+
 	/**
 	@brief Set file access information from current path (filePath, filename)
 
@@ -108,16 +174,53 @@ public:
 	*/
 	virtual bool Import(const std::string& path);
 
+	/**
+	@brief Get the resources this resource references, they must be loaded before it
+
+	@param dependencies : list to fill with their GUID
+	*/
+	virtual void GetDependencies(std::vector<HYGUID>& dependencies) const {}
+
+	/**
+	@brief Copy the data to upload in the staging memory of the renderer, called by the loading workers before LoadInGPUMemory
+	*/
+	virtual void StageGPUData() {}
+
 	/**
 	@brief Loads the resource on GPU
 	*/
 	virtual void LoadInGPUMemory() {}
 
+	/**
+	@brief true while the data sent by LoadInGPUMemory is still in the upload queue, the resource becomes GPU_READY once it is done
+	*/
+	virtual bool IsGPUUploadPending() const { return false; }
+
 	/**
 	@brief Unloads the resource from GPU
 	*/
 	virtual void UnloadFromGPUMemory() {}
 
+	/**
+	@brief Close the files the resource keeps open, before they are deleted
+	*/
+	virtual void ReleaseFiles() {}
+
+	/**
+	@brief Get the settings the source file of the resource is imported with, the resource is imported again when they change
+
+	@param settings : string to fill with the settings
+	*/
+	virtual void GetImportSettings(std::string& settings) const {}
+
+	/**
+	@brief Import again the changed source file of the resource, or rebuild it from a reimported dependency.
+	Called on the main thread, the resource keeps its GUID.
+
+	@return bool : true if the resource changed, the resources depending on it are then rebuilt too
+	*/
+	virtual bool Reimport() { return false; }
+
 	Resource_GENERATED
 };
 
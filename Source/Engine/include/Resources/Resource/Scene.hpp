@@ -3,6 +3,8 @@
 #include "Resources/Resource/Resource.hpp"
 
 #include "ECS/GameObject.hpp"
+#include "Core/SceneAllocator.hpp"
+#include "Tools/FlatHashMap.hpp"
 #include "EngineDLL.hpp"
 
 #include <nlohmann/json.hpp>
@@ -23,8 +25,11 @@ private:
 		static rfk::UniquePtr<Scene> defaultInstantiator(const HYGUID & uid);
 
 private:
+	// Declared first so the memory outlives the gameobjects and components it holds
+	SceneAllocator m_allocator;
+
 	GameObject m_root;
-	std::unordered_map<HYGUID, std::unique_ptr<GameObject>> m_gameObjects;
+	FlatHashMap<HYGUID, PoolPtr<GameObject>> m_gameObjects;
 
 	bool isLoaded = false;
 
@@ -121,6 +126,13 @@ public:
 	*/
 	GameObject* GetGameObjectFromName(const HyString& name);
 
+	/**
+	@brief Get the allocator holding gameObjects and components of the scene (for pool stats)
+
+	@return const SceneAllocator& : scene allocator
+	*/
+	ENGINE_API const SceneAllocator& GetAllocator() const;
+
 	/**
 	@brief Create a new GameObject (or re-create one with an already existing GUID)
 
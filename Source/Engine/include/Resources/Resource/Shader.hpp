@@ -32,4 +32,16 @@ public:
 	bool Create(const std::string& filePath, std::string& shaderStr);
 	void Generate(const char* content, unsigned int type);
 
+	/**
+	@brief Start the compilation of the shader without waiting for it, with parallel compilation the driver builds it on its threads
+	*/
+	void Compile(const char* content, unsigned int type);
+
+	/**
+	@brief Wait for the compilation of the shader and log its errors
+
+	@return bool : true if the shader compiled
+	*/
+	bool CheckCompileStatus() const;
+
 };
@@ -46,12 +46,16 @@ public:
 
 	SkeletalMesh(const HYGUID& uid);
 
+	//	Skeletal meshes and their bone data are uploaded synchronously
+	virtual void StageGPUData() override {}
 	virtual void LoadInGPUMemory() override;
 	virtual void UnloadFromGPUMemory() override;
 
 	virtual void Serialize() override;
 	virtual void Deserialize() override;
 
+	virtual void ClearSubMeshes() override;
+
 	SkeletalMesh_GENERATED
 };
 
@@ -32,12 +32,15 @@ public:
 	ENGINE_API Skybox(const HYGUID& uid);
 
 	ENGINE_API void Reload();
+	virtual bool Reimport() override;
 	virtual void LoadInGPUMemory() override;
 	virtual void UnloadFromGPUMemory() override;
 
 	virtual void Serialize() override;
 	virtual void Deserialize() override;
 
+	virtual void GetDependencies(std::vector<HYGUID>& dependencies) const override;
+
 	Skybox_GENERATED
 };
 
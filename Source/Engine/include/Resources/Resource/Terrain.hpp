@@ -34,6 +34,7 @@ public:
 	ENGINE_API Terrain(const HYGUID& uid);
 
 	ENGINE_API void Reload(bool forceReload);
+	virtual bool Reimport() override;
 
 	virtual void LoadInGPUMemory() override;
 	virtual void UnloadFromGPUMemory() override {}
@@ -41,6 +42,8 @@ public:
 	virtual void Serialize() override;
 	virtual void Deserialize() override;
 
+	virtual void GetDependencies(std::vector<HYGUID>& dependencies) const override;
+
 	Terrain_GENERATED
 };
 
@@ -1,16 +1,26 @@
 #pragma once
 
 #include <vector>
+#include <memory>
 
 #include "Resources/Resource/Resource.hpp"
 #include "Resources/Parsers/ParserFlags.hpp"
 #include "Renderer/GPUTextureData.hpp"
+#include "Renderer/StagingRange.hpp"
 #include "Tools/Flags.hpp"
 
 #include "Generated/Texture.rfkh.h"
 
 struct GLTexture;
 
+struct TextureMipLevel
+{
+	int width = 0;
+	int height = 0;
+	size_t offset = 0;	// Offset from TextureData::data
+	size_t size = 0;
+};
+
 struct TextureData
 {
 	int width = 0;
@@ -19,7 +29,24 @@ struct TextureData
 	int internalFormat = 0;
 	int format = 0;
 	int type = 0;
+	bool compressed = false;	// Block compressed, internalFormat is the compressed format
 	unsigned char* data = nullptr;
+
+	// Precomputed mip chain, level 0 included, empty when mipmaps are generated by the driver
+	std::vector<TextureMipLevel> mipLevels;
+
+	// Owner of data when it does not come from stb_image (cooked buffer or mapped texture cache)
+	std::shared_ptr<void> storage;
+};
+
+/**
+@brief Use of a texture in the slots of a material, chooses its compression and how its mips are filtered
+*/
+enum class ETextureUsage
+{
+	COLOR,	// Albedo and emissive : sRGB, BC7
+	NORMAL,	// Tangent space normal, red and green : BC5
+	MASK,	// Metallic, roughness, occlusion, specular and mask, red only : BC4
 };
 
 /**
@@ -37,14 +64,32 @@ public:
 	std::string originalPath;
 	TextureData data;
 	GPUTextureData*  GPUData;
+	StagingRange	 stagingData;
 
 	Texture(const HYGUID& uid);
 
 	Flags<EImageSTB> const& GetLoadingFlags() const;
+	void SetLoadingFlags(const Flags<EImageSTB>& flags);
+
+	/**
+	@brief Set the sRGB and compression loading flags of a usage, before the texture is loaded
+	*/
+	void SetUsage(ETextureUsage usage);
+
+	/**
+	@brief Check that the channels kept by the compression of the texture are enough for a usage
+
+	@return bool : false if the texture is compressed for a usage with fewer channels
+	*/
+	bool CanBeUsedAs(ETextureUsage usage) const;
 
 	virtual bool Import(const std::string& path) override;
+	virtual void GetImportSettings(std::string& settings) const override;
+	virtual bool Reimport() override;
+	virtual void StageGPUData() override;
 	virtual void LoadInGPUMemory() override;
 	virtual void UnloadFromGPUMemory() override;
+	virtual bool IsGPUUploadPending() const override;
 
 	virtual void Serialize() override;
 	virtual void Deserialize() override;
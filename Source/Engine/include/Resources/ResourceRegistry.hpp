@@ -0,0 +1,113 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+
+#include "Types/GUID.hpp"
+#include "Tools/FlatHashMap.hpp"
+
+class Resource;
+
+/**
+@brief Storage of the resources by GUID, split in shards each guarded by its own reader-writer lock.
+Threads reading or inserting resources of different shards never wait for each other, and readers
+of the same shard run concurrently.
+*/
+class ResourceRegistry
+{
+public:
+	static constexpr size_t ShardBits = 4;
+	static constexpr size_t ShardCount = size_t(1) << ShardBits;
+
+private:
+	// Shards are cache line aligned so that their locks don't share cache lines
+	struct alignas(64) Shard
+	{
+		mutable std::shared_mutex mutex;
+		FlatHashMap<HYGUID, std::unique_ptr<Resource>> resources;
+	};
+
+	std::array<Shard, ShardCount> m_shards;
+	std::atomic<size_t> m_size = 0;
+
+//	Constructors
+
+public:
+	ResourceRegistry();
+	~ResourceRegistry();
+
+	ResourceRegistry(ResourceRegistry const&) = delete;
+	ResourceRegistry& operator=(ResourceRegistry const&) = delete;
+
+//	Functions
+
+private:
+	/**
+	@brief Get the shard of a GUID (high bits of its hash, the low ones are used inside the shard)
+	*/
+	Shard& GetShard(const HYGUID& id);
+	const Shard& GetShard(const HYGUID& id) const;
+
+public:
+	/**
+	@brief Get a resource by its GUID
+
+	@param id : Unique identifier
+	@return Resource* : Resource pointer, nullptr if not found
+	*/
+	Resource* Find(const HYGUID& id) const;
+
+	/**
+	@brief Tell if a resource is stored
+
+	@param id : Unique identifier
+	@return bool : true if found
+	*/
+	bool Contains(const HYGUID& id) const;
+
+	/**
+	@brief Store a resource if its GUID is not stored yet. The lookup and the insertion are atomic :
+	when several threads insert the same GUID, only one resource is stored.
+	The resource is built by the caller, no user code runs under the lock of the shard.
+
+	@param id : Unique identifier
+	@param resource : Resource to store, moved from only if it has been inserted. A resource not inserted is left
+	to the caller, so it is destroyed out of the lock
+
+	@return std::pair<Resource*, bool> : Resource of the GUID, true if it is the inserted one
+	*/
+	std::pair<Resource*, bool> TryInsert(const HYGUID& id, std::unique_ptr<Resource>& resource);
+
+	/**
+	@brief Remove a resource and give its ownership to the caller, so it is destroyed outside of the lock
+
+	@param id : Unique identifier
+	@return std::unique_ptr<Resource> : Removed resource, nullptr if not found
+	*/
+	std::unique_ptr<Resource> Extract(const HYGUID& id);
+
+	/**
+	@brief Call a function on every resource, one shard at a time under its read lock.
+	The function must not insert or remove resources.
+
+	@param function : Callable taking a Resource*
+	*/
+	template <typename TFunction>
+	void ForEach(TFunction&& function) const;
+
+	/**
+	@brief Get a snapshot of every stored resource
+	*/
+	std::vector<Resource*> GetAll() const;
+
+	/**
+	@brief Get the number of stored resources
+	*/
+	size_t Size() const;
+};
+
+#include "Resources/ResourceRegistry.inl"
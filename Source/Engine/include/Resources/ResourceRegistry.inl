@@ -0,0 +1,13 @@
+#include <mutex>
+
+template <typename TFunction>
+void ResourceRegistry::ForEach(TFunction&& function) const
+{
+	for (const Shard& shard : m_shards)
+	{
+		std::shared_lock readGuard(shard.mutex);
+
+		for (const auto& [id, resource] : shard.resources)
+			function(resource.get());
+	}
+}
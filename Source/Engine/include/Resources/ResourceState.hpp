@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+/**
+@brief Loading state of a resource, in loading order
+*/
+enum class RESOURCE_STATE : uint8_t
+{
+	UNLOADED,	/** @brief Only known by its GUID and file info */
+	LOADING,	/** @brief A thread is reading or importing its data */
+	CPU_READY,	/** @brief Data is in memory, waiting for GPU upload */
+	GPU_READY	/** @brief Data is uploaded, the resource is usable by the renderer */
+};
+
+/**
+@brief Thread-safe state of a resource. A state can only move to the next one (UNLOADED -> LOADING -> CPU_READY -> GPU_READY),
+back to UNLOADED, or from GPU_READY back to CPU_READY. Threads can wait for a resource loaded by another thread.
+*/
+class ResourceStateMachine
+{
+private:
+	std::atomic<RESOURCE_STATE> m_state = RESOURCE_STATE::UNLOADED;
+
+public:
+	ResourceStateMachine() = default;
+
+	// The state is copied as a value so that resources stay copyable
+	ResourceStateMachine(const ResourceStateMachine& other);
+	ResourceStateMachine& operator=(const ResourceStateMachine& other);
+
+	/**
+	@brief Tell if a state can directly follow another one
+
+	@param from : Current state
+	@param to : Desired state
+
+	@return bool : true if the transition is allowed
+	*/
+	static bool IsValidTransition(RESOURCE_STATE from, RESOURCE_STATE to);
+
+	/**
+	@brief Get the current state
+	*/
+	RESOURCE_STATE Get() const;
+
+	/**
+	@brief Atomically move to a new state if the transition from the current state is allowed.
+	Only one of several threads trying the same transition succeeds.
+
+	@param to : Desired state
+
+	@return bool : true if the state changed
+	*/
+	bool TryTransition(RESOURCE_STATE to);
+
+	/**
+	@brief Block the caller while the state is LOADING
+	*/
+	void WaitWhileLoading() const;
+};
+
+#include "Resources/ResourceState.inl"
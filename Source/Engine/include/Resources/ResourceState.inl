@@ -0,0 +1,51 @@
+
+inline ResourceStateMachine::ResourceStateMachine(const ResourceStateMachine& other)
+	: m_state(other.Get())
+{ }
+
+inline ResourceStateMachine& ResourceStateMachine::operator=(const ResourceStateMachine& other)
+{
+	m_state.store(other.Get(), std::memory_order_release);
+	m_state.notify_all();
+	return *this;
+}
+
+inline bool ResourceStateMachine::IsValidTransition(RESOURCE_STATE from, RESOURCE_STATE to)
+{
+	// Move forward one state at a time
+	if (static_cast<uint8_t>(to) == static_cast<uint8_t>(from) + 1)
+		return true;
+
+	// Unload, or only free the GPU data
+	return (to == RESOURCE_STATE::UNLOADED && from != RESOURCE_STATE::UNLOADED)
+		|| (to == RESOURCE_STATE::CPU_READY && from == RESOURCE_STATE::GPU_READY);
+}
+
+inline RESOURCE_STATE ResourceStateMachine::Get() const
+{
+	return m_state.load(std::memory_order_acquire);
+}
+
+inline bool ResourceStateMachine::TryTransition(RESOURCE_STATE to)
+{
+	RESOURCE_STATE current = Get();
+
+	do
+	{
+		if (!IsValidTransition(current, to))
+			return false;
+	} while (!m_state.compare_exchange_weak(current, to, std::memory_order_acq_rel, std::memory_order_acquire));
+
+	m_state.notify_all();
+	return true;
+}
+
+inline void ResourceStateMachine::WaitWhileLoading() const
+{
+	RESOURCE_STATE current = Get();
+	while (current == RESOURCE_STATE::LOADING)
+	{
+		m_state.wait(current, std::memory_order_acquire);
+		current = Get();
+	}
+}
@@ -4,22 +4,105 @@
 #include <memory>
 #include <unordered_map>
 #include <type_traits>
+#include <array>
+#include <shared_mutex>
 
 #include "Resources/Resource/Resource.hpp"
 #include "Tools/StringHelper.hpp"
+#include "Tools/FlatHashMap.hpp"
+#include "Resources/ResourceRegistry.hpp"
+#include "Resources/ImportContentIndex.hpp"
 #include "Core/ResourcesTaskPool.hpp"
 
 /**
-@brief Resources Manager handle resource creation and storage
+@brief Resources Manager handle resource creation and storage.
+Resources are stored in a sharded registry so loader threads can query and insert them concurrently,
+the path, filename and type indices are guarded by a reader-writer lock.
 */
 class ResourcesManager
 {
+	friend Resource;
+
 private:
-	std::unordered_map<HYGUID, std::unique_ptr<Resource>> m_resources;
+	static constexpr size_t ResourceTypeCount = static_cast<size_t>(RESOURCE_TYPE::UNKNOWN) + 1;
+
+	// Key to the first resource of an intrusive list of resources sharing that key (see ResourceIndexLinks)
+	using ResourceIndex = FlatHashMap<std::string, Resource*, StringHelper::PathHash, StringHelper::PathEqual>;
+
+	ResourceRegistry m_registry;
+
+	// Lookup indices, maintained on creation, destruction and file info changes.
+	// m_indexMutex is never locked while holding a registry shard lock (the other way is allowed).
+	// A resource is inserted in m_registry and indexed under the same m_indexMutex write lock, and a destroyed
+	// resource is unindexed under that lock before being freed, so it is never freed before being indexed.
+	std::shared_mutex m_indexMutex;
+	ResourceIndex m_pathIndex;
+	ResourceIndex m_filenameIndex;
+	std::array<Resource*, ResourceTypeCount> m_typeLists = {};
+	std::array<size_t, ResourceTypeCount> m_typeCounts = {};
 
 	ResourcesTaskPool m_taskPool;
-	std::mutex m_resourceMutex;
-	
+
+	// Sub-assets created by the imports by content, shared by the models importing the same content
+	ImportContentIndex m_importIndex;
+
+private:
+	/**
+	@brief Store a resource in the registry and index it, if its GUID is not stored yet. m_indexMutex must be locked for writing.
+
+	@param id : Unique identifier of the resource
+	@param resource : Resource built by the caller, moved from only if it has been inserted
+	@return std::pair<Resource*, bool> : Resource of the GUID, true if it is the inserted one
+	*/
+	std::pair<Resource*, bool> InsertResource(const HYGUID& id, std::unique_ptr<Resource>& resource);
+
+	/**
+	@brief Check that a resource found in the path index is a TResource
+
+	@tparam <TResource> : Resource derived class, expected type of the resource
+	@param resource : Resource found at path
+	@param path : Path of the resource, for the error message
+	@return TResource* : The resource, nullptr if it is not a TResource
+	*/
+	template <DerivedResource TResource>
+	TResource* CheckIndexedResource(Resource* resource, const std::string& path);
+
+	/**
+	@brief Add a resource to the path, filename and type indices. m_indexMutex must be locked for writing.
+
+	@param resource : Resource stored in m_registry
+	*/
+	void IndexResource(Resource* resource);
+
+	/**
+	@brief Remove a resource from the path, filename and type indices. m_indexMutex must be locked for writing.
+
+	@param resource : Resource previously indexed
+	*/
+	void UnindexResource(Resource* resource);
+
+	/**
+	@brief Update the indices of a resource whose filepath, filename or type changed
+
+	@param resource : Resource previously indexed
+	*/
+	void ReindexResource(Resource* resource);
+
+	/**
+	@brief Add a resource to the list of a key of an index, after the first one so previous lookups keep their result
+
+	@param index : Path or filename index
+	@param key : Key of the resource in the index
+	@param resource : Resource to add
+	@param next : Link to the next resource with the same key in ResourceIndexLinks
+	*/
+	static void LinkInIndex(ResourceIndex& index, const std::string& key, Resource* resource, Resource* ResourceIndexLinks::* next);
+
+	/**
+	@brief Remove a resource from the list of a key of an index, the key is erased if no resource is left
+	*/
+	static void UnlinkFromIndex(ResourceIndex& index, const std::string& key, Resource* resource, Resource* ResourceIndexLinks::* next);
+
 public:
 	ResourcesManager();
 	~ResourcesManager();
@@ -65,6 +148,19 @@ public:
 	template <DerivedResource TResource>
 	TResource* CreateResource(const std::string& path);
 
+	/**
+	@brief Get the resource stored at a path, or create a new empty Resource of type TResource there.
+	Atomic : when several threads ask for the same path, only one creates the resource.
+
+	@tparam <TResource> : Resource derived class, expected type of the existing resource
+	@param path : Path of the resource
+	@param created : Set to true if the resource has been created by this call
+
+	@return TResource* : Existing or created resource, nullptr if the resource at path is not a TResource
+	*/
+	template <DerivedResource TResource>
+	TResource* GetOrCreateResource(const std::string& path, bool& created);
+
 	/**
 	@brief Create a new empty Resource of typeString with an existing GUID. Engine-Only meant for Deserialization.
 
@@ -74,6 +170,18 @@ public:
 	*/
 	Resource* CreateResource(const std::string& typeString, const HYGUID& id);
 
+	/**
+	@brief Get the resource of an existing GUID, or create a new empty Resource of typeString with it.
+	Atomic : when several threads ask for the same GUID, only one creates the resource.
+
+	@param typeString : Reflected name of the resource class
+	@param id : Unique identifier
+	@param created : Set to true if the resource has been created by this call
+
+	@return Resource* : Existing or created resource, nullptr if typeString is not a resource class
+	*/
+	Resource* GetOrCreateResource(const std::string& typeString, const HYGUID& id, bool& created);
+
 	// Delete Resource functions
 	// -------------------------
 
@@ -134,6 +242,16 @@ public:
 	template <DerivedResource TResource>
 	void ImportResource(const std::string& path);
 
+	/**
+	@brief Load a resource from its path, its import settings are set before it is imported
+
+	@tparam <TResource> : Resource derived class
+	@param path : the file path of the resource
+	@param setup : Function called with the new resource before its import
+	*/
+	template <DerivedResource TResource, typename TSetup>
+	void ImportResource(const std::string& path, TSetup&& setup);
+
 	/**
 	@brief Load a resource, recognizing its type with its extension
 
@@ -165,11 +283,11 @@ public:
 	ENGINE_API Resource* GetResource(const HYGUID& id);
 
 	/**
-	@brief Get all resources vector.
+	@brief Get a snapshot of all the resources.
 	
-	@return Resource* : Resource pointer, nullptr if resource not found
+	@return std::vector<Resource*> : every resource stored when called
 	*/
-	ENGINE_API std::unordered_map<HYGUID, std::unique_ptr<Resource>>& GetResources();
+	ENGINE_API std::vector<Resource*> GetResources();
 
 	/**
 	@brief Get a resource by its path.
@@ -202,6 +320,8 @@ public:
 	ENGINE_API std::vector<std::string> GetResourcesNamesList(RESOURCE_TYPE type);
 
 	ResourcesTaskPool& GetTaskPool();
+
+	ImportContentIndex& GetImportContentIndex();
 };
 
 #include "Resources/ResourcesManager.inl"
\ No newline at end of file
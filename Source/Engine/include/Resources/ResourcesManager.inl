@@ -1,21 +1,73 @@
 
 inline void ResourcesManager::DestroyResource(const HYGUID& uid)
 {
-	std::lock_guard resGuard(m_resourceMutex);
+	// Take the ownership first, only the caller which got it unindexes the resource
+	std::unique_ptr<Resource> resource = m_registry.Extract(uid);
+	if (resource == nullptr)
+		return;
+
+	std::unique_lock indexGuard(m_indexMutex);
+	UnindexResource(resource.get());
+	indexGuard.unlock();
 
-	// Erase the resource
-	m_resources.erase(uid);
+	// The resource is destroyed out of the locks
 }
 
 template <DerivedResource TResource>
 TResource* ResourcesManager::CreateResource()
 {
-	std::lock_guard queueGuard(m_resourceMutex);
+	HYGUID id = HYGUID::NewGUID();
+	std::unique_ptr<Resource> newResource = std::make_unique<TResource>(id);
+
+	std::unique_lock indexGuard(m_indexMutex);
+	Resource* resource = InsertResource(id, newResource).first;
+
+	return static_cast<TResource*>(resource);
+}
+
+template <DerivedResource TResource>
+TResource* ResourcesManager::CheckIndexedResource(Resource* resource, const std::string& path)
+{
+	rfk::Class const& archetype = resource->getArchetype();
+	if (&archetype != &TResource::staticGetArchetype() && !archetype.isSubclassOf(TResource::staticGetArchetype()))
+	{
+		Logger::Error("ResourcesManager - '" + path + "' is a " + archetype.getName() + ", not a " + TResource::staticGetArchetype().getName());
+		return nullptr;
+	}
+
+	return static_cast<TResource*>(resource);
+}
+
+template <DerivedResource TResource>
+TResource* ResourcesManager::GetOrCreateResource(const std::string& path, bool& created)
+{
+	created = false;
+
+	// Most calls find an existing resource, try with the read lock first
+	{
+		std::shared_lock readGuard(m_indexMutex);
+
+		auto it = m_pathIndex.find(path);
+		if (it != m_pathIndex.end())
+			return CheckIndexedResource<TResource>(it->second, path);
+	}
 
+	// Build the resource out of the locks, it is destroyed below if another thread created the path first
 	HYGUID id = HYGUID::NewGUID();
-	m_resources.emplace(id, std::make_unique<TResource>(id));
+	std::unique_ptr<Resource> newResource = std::make_unique<TResource>(id);
+	newResource->SetFileInfo(path); // Not indexed yet, doesn't lock m_indexMutex
 
-	return static_cast<TResource*>(m_resources[id].get());
+	// The write lock is kept from the lookup to the indexing of the new resource so that the path is only created once
+	std::unique_lock indexGuard(m_indexMutex);
+
+	auto it = m_pathIndex.find(path);
+	if (it != m_pathIndex.end())
+		return CheckIndexedResource<TResource>(it->second, path);
+
+	Resource* resource = InsertResource(id, newResource).first;
+
+	created = true;
+	return static_cast<TResource*>(resource);
 }
 
 template <DerivedResource TResource>
@@ -36,16 +88,27 @@ TResource* ResourcesManager::GetResource(const HYGUID& id)
 
 template <DerivedResource TResource>
 void ResourcesManager::ImportResource(const std::string& path)
+{
+	ImportResource<TResource>(path, [](TResource&) {});
+}
+
+template <DerivedResource TResource, typename TSetup>
+void ResourcesManager::ImportResource(const std::string& path, TSetup&& setup)
 {
 	// Create empty resource from type
 	TResource* newResource = CreateResource<TResource>();
+	newResource->TrySetState(RESOURCE_STATE::LOADING);
+	setup(*newResource);
 
 	if (newResource->Import(path))
 	{
 		CreateResourceFiles(newResource);
+		newResource->TrySetState(RESOURCE_STATE::CPU_READY);
 
 		m_taskPool.AddSingleThreadTask([newResource]() {
 			newResource->LoadInGPUMemory();
+			if (!newResource->IsGPUUploadPending())
+				newResource->TrySetState(RESOURCE_STATE::GPU_READY);
 			});
 		return;
 	}
@@ -53,5 +116,6 @@ void ResourcesManager::ImportResource(const std::string& path)
 	Logger::Error("ResourcesManager - Failed to load '" + path + "'");
 
 	// Erase the resource if not valid
+	newResource->TrySetState(RESOURCE_STATE::UNLOADED);
 	DestroyResource(newResource->GetUID());
 }
\ No newline at end of file
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <functional>
+
+#include "Tools/ContentHash.hpp"
+#include "Tools/FlatHashMap.hpp"
+#include "Tools/StringHelper.hpp"
+#include "EngineDLL.hpp"
+
+class ResourcesTaskPool;
+
+/**
+@brief State of a source asset (model, texture or sound file) when it was last imported or checked
+*/
+struct SourceAssetRecord
+{
+	std::string	path = "";				/** @brief Path of the source file */
+	uint32_t	directoryIndex = 0;		/** @brief Directory containing the file */
+
+	uint64_t	size = 0;				/** @brief Size of the file when it was hashed */
+	int64_t		time = 0;				/** @brief Last write time of the file when it was hashed */
+
+	Hash128		contentHash;			/** @brief Hash of the content of the file */
+	Hash128		settingsHash;			/** @brief Hash of the settings the file is imported with */
+};
+
+/**
+@brief Content addressed change detection of the source assets of a directory, stored in a binary manifest in the cache folder.
+Files keeping their size and write time are trusted without being read, the others are hashed and only reported if their content
+or their import settings changed. New files are only searched in the directories whose write time changed, or only the files reported
+by a file watcher are checked.
+*/
+class SourceAssetTracker
+{
+public:
+	enum class EChange
+	{
+		ADDED,
+		MODIFIED,
+		REMOVED
+	};
+
+	struct Change
+	{
+		std::string path = "";
+		EChange		type = EChange::ADDED;
+	};
+
+	/**
+	@brief Counters of the last refresh
+	*/
+	struct RefreshStats
+	{
+		bool		manifestLoaded = false;
+		size_t		checkedFiles = 0;
+		size_t		hashedFiles = 0;
+		size_t		scannedDirectories = 0;
+	};
+
+	/**
+	@brief Get the import settings of a source file, empty if it has none. Called from the workers of the task pool.
+	*/
+	using SettingsGetter = std::function<std::string(const std::string& sourcePath)>;
+
+private:
+	struct DirectoryRecord
+	{
+		std::string	path = "";
+		int64_t		time = 0;
+	};
+
+	std::string m_rootPath;
+	std::string m_manifestPath;
+
+	std::vector<DirectoryRecord> m_directories;
+	std::vector<SourceAssetRecord> m_records;
+
+	//	Index of the records and directories by path
+	FlatHashMap<std::string, size_t, StringHelper::PathHash, StringHelper::PathEqual> m_recordIndex;
+	FlatHashMap<std::string, uint32_t, StringHelper::PathHash, StringHelper::PathEqual> m_directoryIndex;
+
+	RefreshStats m_stats;
+	bool m_loaded = false;
+	bool m_dirty = false;
+
+//	Constructors
+
+public:
+	/**
+	@param rootPath : Directory of the assets
+	@param manifestPath : File storing the records
+	*/
+	ENGINE_API SourceAssetTracker(const std::string& rootPath, const std::string& manifestPath);
+
+//	Functions
+
+private:
+	/**
+	@brief Read the manifest, the tracker stays empty if it is missing or invalid
+
+	@return bool : true if the manifest has been loaded
+	*/
+	bool LoadManifest();
+
+	/**
+	@brief Index the records and directories by path, after they changed
+	*/
+	void IndexRecords();
+
+	/**
+	@brief Get the directory of a new file, the directories missing between it and the root are added
+
+	@return uint32_t : Index of the directory, ~0u if the file is not in the root directory
+	*/
+	uint32_t GetOrAddDirectory(const std::string& directoryPath);
+
+public:
+	/**
+	@brief Get if a file is a source asset, imported in a resource of the engine
+	*/
+	static ENGINE_API bool IsSourceAsset(const std::string& path);
+
+	/**
+	@brief Get the path of the manifest of a directory in the cache folder
+
+	@param rootPath : Directory of the assets
+	*/
+	static ENGINE_API std::string GetDefaultManifestPath(const std::string& rootPath);
+
+	/**
+	@brief Bring the records up to date with the file system. The manifest is loaded by the first refresh, the records stay in memory then.
+	Every file is reported as added by the refresh building the manifest.
+
+	@param taskPool : Pool used to stat and hash the files
+	@param getSettings : Import settings of a source file
+	@param changes : Changed files, sorted by path
+	*/
+	ENGINE_API void Refresh(ResourcesTaskPool& taskPool, const SettingsGetter& getSettings, std::vector<Change>& changes);
+
+	/**
+	@brief Bring the records of some paths up to date, reported by a file watcher : the other files and the directories are not checked.
+	The first refresh of the tracker is a full one.
+
+	@param taskPool : Pool used to stat and hash the files
+	@param getSettings : Import settings of a source file
+	@param paths : Files which may have been added, modified or removed, and removed directories
+	@param changes : Changed files, sorted by path
+	*/
+	ENGINE_API void RefreshFiles(ResourcesTaskPool& taskPool, const SettingsGetter& getSettings, const std::vector<std::string>& paths, std::vector<Change>& changes);
+
+	/**
+	@brief Write the manifest if the records changed since it has been loaded
+
+	@return bool : true if the manifest is up to date on disk
+	*/
+	ENGINE_API bool Save();
+
+	ENGINE_API const std::vector<SourceAssetRecord>& GetRecords() const;
+	ENGINE_API const RefreshStats& GetStats() const;
+};
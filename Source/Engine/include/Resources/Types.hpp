@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 #include "Maths/Vector3.hpp"
 #include "Maths/Vector2.hpp"
 
@@ -14,6 +16,43 @@ struct Vertex
 	Vector3 bitangent = { 0, 0, 0 };
 };
 
+/**
+@brief Vertex of the packed layouts, 20 bytes. The bitangent is rebuilt from the normal, the tangent and its sign.
+*/
+struct PackedVertex
+{
+	uint16_t position[4];	// xyz in the sub mesh bounds (snorm16 or half float bits), w : bitangent sign
+	int16_t  normal[2];		// Octahedral, snorm16
+	int16_t  tangent[2];	// Octahedral, snorm16
+	uint16_t uvs[2];		// Half floats
+};
+
+
+/**
+@brief Range of the index stream of a sub mesh drawn at a level of detail
+*/
+struct MeshLOD
+{
+	uint32_t indexOffset = 0;
+	uint32_t indexCount = 0;
+	float	 error = 0.f;		// Distance to the full detail surface, relative to the bounding sphere radius of the sub mesh
+};
+
+/**
+@brief Cluster of triangles of a sub mesh, culled as a whole against the view frustum and by the cone of its normals
+*/
+struct Meshlet
+{
+	uint32_t indexOffset = 0;
+	uint32_t indexCount = 0;
+
+	Vector3	 center = { 0, 0, 0 };		// Bounding sphere, in sub mesh space
+	float	 radius = 0.f;
+
+	Vector3	 coneAxis = { 0, 0, 0 };	// Average normal of the triangles
+	float	 coneCutoff = 1.f;			// Sine of the spread of the normals around coneAxis, 1 if the cluster can't be back facing as a whole
+};
+
 
 /**
 @brief Defines how many bones can influence a vertex position (and they should be weighted).
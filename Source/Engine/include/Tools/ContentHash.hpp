@@ -0,0 +1,55 @@
+#pragma once
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+/**
+@brief 128 bits hash of a content
+*/
+struct Hash128
+{
+	uint64_t low = 0;
+	uint64_t high = 0;
+
+	bool operator==(const Hash128& other) const = default;
+};
+
+/**
+@brief Fast non-cryptographic 128 bits hash of file contents, to tell if an asset changed.
+Built like XXH3 : 64 bytes stripes are accumulated in 8 lanes with 32x32 bits multiplies, the lanes are then folded with 64x64 bits multiplies.
+*/
+namespace ContentHash
+{
+	/**
+	@brief Hash a memory range
+
+	@param data : Content
+	@param size : Size of the content in bytes
+	@param seed : Changes the whole hash, to hash a content with its context
+	*/
+	Hash128 Compute(const void* data, size_t size, uint64_t seed = 0);
+
+	/**
+	@brief Hash a string
+	*/
+	Hash128 Compute(const std::string& string, uint64_t seed = 0);
+
+	/**
+	@brief Second 64 bits hash of a memory range, built unlike Compute : two contents with the same Hash128 and the same check are taken as equal
+
+	@param data : Content
+	@param size : Size of the content in bytes
+	@param seed : Changes the whole hash, a check is chained over several ranges by passing the previous one
+	*/
+	uint64_t ComputeCheck(const void* data, size_t size, uint64_t seed = 0);
+
+	/**
+	@brief Hash the content of a file, mapped in memory
+
+	@param path : Path of the file
+	@param hash : Hash of the content, of an empty content if the file is empty
+	@return bool : false if the file could not be read
+	*/
+	bool ComputeFile(const std::string& path, Hash128& hash);
+}
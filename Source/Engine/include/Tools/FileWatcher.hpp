@@ -0,0 +1,167 @@
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <functional>
+
+#include "Tools/FlatHashMap.hpp"
+#include "Tools/StringHelper.hpp"
+#include "EngineDLL.hpp"
+
+/**
+@brief Watch the files of a directory tree from a background thread : ReadDirectoryChangesW on Windows, inotify on Linux,
+polling of the tree when they are not available. The events of a burst are coalesced by file and reported together once
+the tree stayed quiet for the debounce delay, so that the cost of a change does not depend on the size of the tree.
+*/
+class FileWatcher
+{
+public:
+	enum class EEvent
+	{
+		ADDED,
+		MODIFIED,
+		REMOVED,	// Files and directories, a renamed file is removed then added
+		RESCAN		// Events were lost, the whole tree must be checked again
+	};
+
+	struct Event
+	{
+		std::string path = "";
+		EEvent		type = EEvent::MODIFIED;
+	};
+
+	/**
+	@brief Get if the events of a file are reported, called from the watcher thread
+	*/
+	using Filter = std::function<bool(const std::string& path)>;
+
+	using Clock = std::chrono::steady_clock;
+
+	/**
+	@brief Source of the raw events of a platform : ReadDirectoryChangesW, inotify or the polling of the tree
+	*/
+	class Backend
+	{
+	public:
+		virtual ~Backend() = default;
+
+		/**
+		@brief Wait for changes in the tree, at most for a timeout
+
+		@param timeout : Longest wait
+		@param events : Raw events of the changed files and directories, added directories are walked by the watcher
+		*/
+		virtual void Wait(std::chrono::milliseconds timeout, std::vector<Event>& events) = 0;
+	};
+
+//	Variables
+
+private:
+	std::string m_rootPath;
+	Filter		m_filter;
+
+	std::chrono::milliseconds m_debounceDelay;
+	std::chrono::milliseconds m_maxLatency;
+	std::chrono::milliseconds m_pollingInterval;
+
+	std::unique_ptr<Backend> m_backend;
+	std::thread				 m_thread;
+	std::atomic<bool>		 m_running = false;
+	bool					 m_polling = false;
+
+	//	Events of the current burst by file, only used by the watcher thread
+	FlatHashMap<std::string, EEvent, StringHelper::PathHash, StringHelper::PathEqual> m_pending;
+	Clock::time_point m_burstStart;
+	Clock::time_point m_lastEvent;
+	bool			  m_rescanPending = false;
+
+	//	Coalesced events waiting to be taken
+	mutable std::mutex m_readyMutex;
+	std::vector<Event> m_ready;
+
+//	Constructors
+
+public:
+	/**
+	@param rootPath : Directory to watch, with its sub directories
+	@param filter : Files to report, every file if empty. Removed paths are always reported, they may be directories
+	@param debounceDelay : Time without event before a burst is reported
+	@param maxLatency : Longest time a burst is held, for files written continuously
+	*/
+	ENGINE_API FileWatcher(const std::string& rootPath, const Filter& filter = nullptr,
+		std::chrono::milliseconds debounceDelay = std::chrono::milliseconds(200), std::chrono::milliseconds maxLatency = std::chrono::milliseconds(2000));
+	ENGINE_API ~FileWatcher();
+
+	FileWatcher(FileWatcher const&) = delete;
+	FileWatcher& operator=(FileWatcher const&) = delete;
+
+//	Functions
+
+private:
+	/**
+	@brief Loop of the watcher thread
+	*/
+	void Run();
+
+	/**
+	@brief Add an event to the current burst, merged with the previous event of the file
+	*/
+	void AddEvent(const std::string& path, EEvent type, Clock::time_point now);
+
+	/**
+	@brief Add the files of a new directory, their own events may have been sent before the directory was watched
+	*/
+	void AddDirectory(const std::string& path, Clock::time_point now);
+
+	/**
+	@brief Hand the burst over to PollEvents once it is settled
+	*/
+	void FlushSettledEvents(Clock::time_point now);
+
+public:
+	/**
+	@brief Start the watcher thread, with the native backend of the platform or by polling the tree
+
+	@param forcePolling : Use the polling backend even if the native one is available
+	@return bool : false if the root directory can't be watched
+	*/
+	ENGINE_API bool Start(bool forcePolling = false);
+
+	/**
+	@brief Start the watcher thread with the events of a given backend, the tests replay the events of the native backends with it
+
+	@param backend : Source of the raw events, owned by the watcher until it stops
+	@return bool : false if there is no backend
+	*/
+	ENGINE_API bool Start(std::unique_ptr<Backend> backend);
+
+	/**
+	@brief Stop the watcher thread, the events not reported yet are lost
+	*/
+	ENGINE_API void Stop();
+
+	ENGINE_API bool IsRunning() const;
+
+	/**
+	@brief Get if the tree is polled, the native backend being unavailable
+	*/
+	ENGINE_API bool IsPolling() const;
+
+	/**
+	@brief Set the time between two walks of the tree by the polling backend, taken by the next Start
+	*/
+	ENGINE_API void SetPollingInterval(std::chrono::milliseconds interval);
+
+	/**
+	@brief Take the coalesced events, thread-safe
+
+	@param events : Events of the settled bursts, sorted by path in each burst. A RESCAN event replaces the others
+	@return bool : true if there are events
+	*/
+	ENGINE_API bool PollEvents(std::vector<Event>& events);
+};
@@ -0,0 +1,286 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <tuple>
+#include <functional>
+#include <iterator>
+
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HY_FLAT_HASH_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace FlatHash
+{
+	using Ctrl = int8_t;
+
+	// Control byte of a slot : empty, deleted (tombstone) or the 7 low bits of the key hash when full
+	constexpr Ctrl Empty = -128;
+	constexpr Ctrl Deleted = -2;
+
+	// Number of control bytes probed at once
+	constexpr size_t GroupWidth = 16;
+
+	/**
+	@brief Set of slots matching a probe in a group, one bit per slot
+	*/
+	struct BitMask
+	{
+		uint32_t mask = 0;
+
+		inline bool Any() const;
+		inline uint32_t Lowest() const;
+		inline void ClearLowest();
+	};
+
+	/**
+	@brief GroupWidth control bytes loaded at once (SSE2 when available)
+	*/
+	struct Group
+	{
+#ifdef HY_FLAT_HASH_SSE2
+		__m128i ctrl;
+#else
+		Ctrl ctrl[GroupWidth];
+#endif
+
+		inline explicit Group(const Ctrl* pos);
+
+		inline BitMask Match(Ctrl h2) const;
+		inline BitMask MatchEmpty() const;
+		inline BitMask MatchEmptyOrDeleted() const;
+	};
+}
+
+/**
+@brief Open addressing hash map with flat storage (Swiss table layout).
+Slots are stored in one array next to a control byte array probed GroupWidth slots at a time.
+Erasing an element never moves the others so iterators stay valid until the next insertion.
+
+@tparam TKey : Key type
+@tparam TValue : Mapped type
+@tparam THash : Hash of the key, should mix all its bits
+@tparam TKeyEqual : Key equality
+*/
+template <typename TKey, typename TValue, typename THash = std::hash<TKey>, typename TKeyEqual = std::equal_to<TKey>>
+class FlatHashMap
+{
+public:
+	using key_type = TKey;
+	using mapped_type = TValue;
+	using value_type = std::pair<const TKey, TValue>;
+	using size_type = size_t;
+
+	template <bool IsConst>
+	class Iterator
+	{
+		friend FlatHashMap;
+
+		template <bool>
+		friend class Iterator;
+
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = FlatHashMap::value_type;
+		using difference_type = std::ptrdiff_t;
+		using reference = std::conditional_t<IsConst, const value_type&, value_type&>;
+		using pointer = std::conditional_t<IsConst, const value_type*, value_type*>;
+
+	private:
+		const FlatHash::Ctrl* m_ctrl = nullptr;
+		const FlatHash::Ctrl* m_ctrlEnd = nullptr;
+		pointer m_slot = nullptr;
+
+		Iterator(const FlatHash::Ctrl* ctrl, const FlatHash::Ctrl* ctrlEnd, pointer slot)
+			: m_ctrl(ctrl), m_ctrlEnd(ctrlEnd), m_slot(slot)
+		{ }
+
+		/**
+		@brief Move forward until a full slot or the end is reached
+		*/
+		void SkipFreeSlots()
+		{
+			while (m_ctrl != m_ctrlEnd && *m_ctrl < 0)
+			{
+				++m_ctrl;
+				++m_slot;
+			}
+		}
+
+	public:
+		Iterator() = default;
+
+		// Allow iterator to const_iterator conversion
+		operator Iterator<true>() const { return Iterator<true>(m_ctrl, m_ctrlEnd, m_slot); }
+
+		reference operator*() const { return *m_slot; }
+		pointer operator->() const { return m_slot; }
+
+		Iterator& operator++()
+		{
+			++m_ctrl;
+			++m_slot;
+			SkipFreeSlots();
+			return *this;
+		}
+
+		Iterator operator++(int)
+		{
+			Iterator previous = *this;
+			++(*this);
+			return previous;
+		}
+
+		bool operator==(const Iterator& other) const { return m_ctrl == other.m_ctrl; }
+		bool operator!=(const Iterator& other) const { return m_ctrl != other.m_ctrl; }
+	};
+
+	using iterator = Iterator<false>;
+	using const_iterator = Iterator<true>;
+
+//	Variables
+
+private:
+	// Capacity + GroupWidth bytes, the last GroupWidth bytes mirror the first ones so a group never wraps
+	FlatHash::Ctrl* m_ctrl = nullptr;
+	value_type* m_slots = nullptr;
+
+	size_t m_capacity = 0;
+	size_t m_size = 0;
+
+	// Number of elements that can still be inserted in empty slots before rehashing
+	size_t m_growthLeft = 0;
+
+	THash m_hasher;
+	TKeyEqual m_keyEqual;
+
+//	Constructors
+
+public:
+	FlatHashMap() = default;
+	FlatHashMap(FlatHashMap&& other) noexcept;
+	FlatHashMap(FlatHashMap const&) = delete;
+	~FlatHashMap();
+
+	FlatHashMap& operator=(FlatHashMap&& other) noexcept;
+	FlatHashMap& operator=(FlatHashMap const&) = delete;
+
+//	Functions
+
+private:
+	static inline size_t H1(size_t hash);
+	static inline FlatHash::Ctrl H2(size_t hash);
+
+	/**
+	@brief Max number of elements stored in a given capacity (7/8 load factor)
+	*/
+	static inline size_t CapacityToGrowth(size_t capacity);
+
+	/**
+	@brief Set a control byte and its mirrored copy
+	*/
+	void SetCtrl(size_t index, FlatHash::Ctrl value);
+
+	/**
+	@brief Find the slot of a key
+
+	@return size_t : slot index, m_capacity if not found
+	*/
+	size_t FindIndex(const TKey& key, size_t hash) const;
+
+	/**
+	@brief Find the first empty or deleted slot of the probe sequence of a hash
+	*/
+	size_t FindFreeSlot(size_t hash) const;
+
+	/**
+	@brief Get a slot to insert a new key, rehashing the table if needed
+	*/
+	size_t PrepareInsert(size_t hash);
+
+	/**
+	@brief Move every element in a new table of the given capacity (power of two)
+	*/
+	void Rehash(size_t newCapacity);
+
+	/**
+	@brief Destroy every element and free the table
+	*/
+	void Destroy();
+
+	iterator MakeIterator(size_t index);
+	const_iterator MakeIterator(size_t index) const;
+
+public:
+	iterator begin();
+	iterator end();
+	const_iterator begin() const;
+	const_iterator end() const;
+
+	size_t size() const;
+	bool empty() const;
+	size_t capacity() const;
+
+	/**
+	@brief Get the ratio of full slots
+	*/
+	float load_factor() const;
+
+	/**
+	@brief Allocate enough slots to store a number of elements without rehashing
+
+	@param count : number of elements
+	*/
+	void reserve(size_t count);
+
+	/**
+	@brief Destroy every element, the capacity is kept
+	*/
+	void clear();
+
+	iterator find(const TKey& key);
+	const_iterator find(const TKey& key) const;
+
+	bool contains(const TKey& key) const;
+	size_t count(const TKey& key) const;
+
+	/**
+	@brief Insert an element constructed from args if the key is not in the map yet
+
+	@return std::pair<iterator, bool> : element of the key, true if it has been inserted
+	*/
+	template <typename TKeyArg, typename... TArgs>
+	std::pair<iterator, bool> try_emplace(TKeyArg&& key, TArgs&&... args);
+
+	/**
+	@brief Insert an element if the key is not in the map yet
+
+	@return std::pair<iterator, bool> : element of the key, true if it has been inserted
+	*/
+	template <typename TKeyArg, typename TValueArg>
+	std::pair<iterator, bool> emplace(TKeyArg&& key, TValueArg&& value);
+
+	/**
+	@brief Get the value of a key, a default value is inserted if the key is not in the map
+	*/
+	TValue& operator[](const TKey& key);
+
+	/**
+	@brief Erase the element of a key
+
+	@return size_t : number of erased elements (0 or 1)
+	*/
+	size_t erase(const TKey& key);
+
+	/**
+	@brief Erase the element pointed by an iterator
+
+	@return iterator : next element
+	*/
+	iterator erase(const_iterator it);
+};
+
+#include "Tools/FlatHashMap.inl"
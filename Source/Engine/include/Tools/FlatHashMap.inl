@@ -0,0 +1,445 @@
+#include <bit>
+#include <algorithm>
+
+//	FLATHASH GROUP
+//	--------------
+
+inline bool FlatHash::BitMask::Any() const
+{
+	return mask != 0;
+}
+
+inline uint32_t FlatHash::BitMask::Lowest() const
+{
+	return static_cast<uint32_t>(std::countr_zero(mask));
+}
+
+inline void FlatHash::BitMask::ClearLowest()
+{
+	mask &= mask - 1;
+}
+
+#ifdef HY_FLAT_HASH_SSE2
+
+inline FlatHash::Group::Group(const Ctrl* pos)
+	: ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos)))
+{ }
+
+inline FlatHash::BitMask FlatHash::Group::Match(Ctrl h2) const
+{
+	return { static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(h2)))) };
+}
+
+inline FlatHash::BitMask FlatHash::Group::MatchEmpty() const
+{
+	return Match(Empty);
+}
+
+inline FlatHash::BitMask FlatHash::Group::MatchEmptyOrDeleted() const
+{
+	// Empty and Deleted are the only control bytes lower than -1
+	return { static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), ctrl))) };
+}
+
+#else
+
+inline FlatHash::Group::Group(const Ctrl* pos)
+{
+	std::copy_n(pos, GroupWidth, ctrl);
+}
+
+inline FlatHash::BitMask FlatHash::Group::Match(Ctrl h2) const
+{
+	BitMask result;
+	for (uint32_t i = 0; i < GroupWidth; ++i)
+		result.mask |= static_cast<uint32_t>(ctrl[i] == h2) << i;
+	return result;
+}
+
+inline FlatHash::BitMask FlatHash::Group::MatchEmpty() const
+{
+	return Match(Empty);
+}
+
+inline FlatHash::BitMask FlatHash::Group::MatchEmptyOrDeleted() const
+{
+	BitMask result;
+	for (uint32_t i = 0; i < GroupWidth; ++i)
+		result.mask |= static_cast<uint32_t>(ctrl[i] < -1) << i;
+	return result;
+}
+
+#endif
+
+
+//	FLATHASHMAP CONSTRUCTORS
+//	------------------------
+
+template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+FlatHashMap<TKey, TValue, THash, TKeyEqual>::FlatHashMap(FlatHashMap&& other) noexcept
+	: m_ctrl(std::exchange(other.m_ctrl, nullptr)), m_slots(std::exchange(other.m_slots, nullptr)),
+	m_capacity(std::exchange(other.m_capacity, 0)), m_size(std::exchange(other.m_size, 0)),
+	m_growthLeft(std::exchange(other.m_growthLeft, 0)),
+	m_hasher(std::move(other.m_hasher)), m_keyEqual(std::move(other.m_keyEqual))
+{ }
+
+template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+FlatHashMap<TKey, TValue, THash, TKeyEqual>::~FlatHashMap()
+{
+	Destroy();
+}
+
+template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+FlatHashMap<TKey, TValue, THash, TKeyEqual>& FlatHashMap<TKey, TValue, THash, TKeyEqual>::operator=(FlatHashMap&& other) noexcept
+{
+	if (this != &other)
+	{
+		Destroy();
+
+		m_ctrl = std::exchange(other.m_ctrl, nullptr);
+		m_slots = std::exchange(other.m_slots, nullptr);
+		m_capacity = std::exchange(other.m_capacity, 0);
+		m_size = std::exchange(other.m_size, 0);
+		m_growthLeft = std::exchange(other.m_growthLeft, 0);
+		m_hasher = std::move(other.m_hasher);
+		m_keyEqual = std::move(other.m_keyEqual);
+	}
+
+	return *this;
+}
+
+
+//	FLATHASHMAP INTERNAL FUNCTIONS
+//	------------------------------
+
+template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+inline size_t FlatHashMap<TKey, TValue, THash, TKeyEqual>::H1(size_t hash)
+{
+	return hash >> 7;
+}
+
+template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+inline FlatHash::Ctrl FlatHashMap<TKey, TValue, THash, TKeyEqual>::H2(size_t hash)
+{
+	return static_cast<FlatHash::Ctrl>(hash & 0x7F);
+}
+
+template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+inline size_t FlatHashMap<TKey, TValue, THash, TKeyEqual>::CapacityToGrowth(size_t capacity)
+{
+	return capacity - capacity / 8;
+}
+
+template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+void FlatHashMap<TKey, TValue, THash, TKeyEqual>::SetCtrl(size_t index, FlatHash::Ctrl value)
+{
+	m_ctrl[index] = value;
+
+	// Keep the mirrored bytes up to date
+	if (index < FlatHash::GroupWidth)
+		m_ctrl[m_capacity + index] = value;
+}
+
+template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+size_t FlatHashMap<TKey, TValue, THash, TKeyEqual>::FindIndex(const TKey& key, size_t hash) const
+{
+	if (m_capacity == 0)
+		return 0;
+
+	const size_t mask = m_capacity - 1;
+	const FlatHash::Ctrl h2 = H2(hash);
+
+	size_t pos = H1(hash) & mask;
+	size_t step = 0;
+
+	while (true)
+	{
+		FlatHash::Group group(m_ctrl + pos);
+
+		for (FlatHash::BitMask match = group.Match(h2); match.Any(); match.ClearLowest())
+		{
+			const size_t index = (pos + match.Lowest()) & mask;
+			if (m_keyEqual(m_slots[index].first, key))
+				return index;
+		}
+
+		// An empty slot stops the probe sequence, the key has never been inserted after it
+		if (group.MatchEmpty().Any())
+			return m_capacity;
+
+		step += FlatHash::GroupWidth;
+		pos = (pos + step) & mask;
+	}
+}
+
+template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+size_t FlatHashMap<TKey, TValue, THash, TKeyEqual>::FindFreeSlot(size_t hash) const
+{
+	const size_t mask = m_capacity - 1;
+
+	size_t pos = H1(hash) & mask;
+	size_t step = 0;
+
+	while (true)
+	{
+		FlatHash::BitMask freeSlots = FlatHash::Group(m_ctrl + pos).MatchEmptyOrDeleted();
+		if (freeSlots.Any())
+			return (pos + freeSlots.Lowest()) & mask;
+
+		step += FlatHash::GroupWidth;
+		pos = (pos + step) & mask;
+	}
+}
+
+template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+size_t FlatHashMap<TKey, TValue, THash, TKeyEqual>::PrepareInsert(size_t hash)
+{
+	size_t index = m_capacity > 0 ? FindFreeSlot(hash) : 0;
+
+	if (m_capacity == 0 || (m_growthLeft == 0 && m_ctrl[index] == FlatHash::Empty))
+	{
+		// Rehash in place if tombstones take most of the room, grow otherwise
+		if (m_capacity > 0 && m_size <= CapacityToGrowth(m_capacity) / 2)
+			Rehash(m_capacity);
+		else
+			Rehash(std::max(m_capacity * 2, FlatHash::GroupWidth));
+
+		index = FindFreeSlot(hash);
+	}
+
+	if (m_ctrl[index] == FlatHash::Empty)
+		m_growthLeft--;
+
+	SetCtrl(index, H2(hash));
+	m_size++;
+
+	return index;
+}
+
+template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+void FlatHashMap<TKey, TValue, THash, TKeyEqual>::Rehash(size_t newCapacity)
+{
+	FlatHash::Ctrl* oldCtrl = m_ctrl;
+	value_type* oldSlots = m_slots;
+	const size_t oldCapacity = m_capacity;
+
+	m_capacity = newCapacity;
+	m_ctrl = new FlatHash::Ctrl[m_capacity + FlatHash::GroupWidth];
+	m_slots = std::allocator<value_type>().allocate(m_capacity);
+	std::fill_n(m_ctrl, m_capacity + FlatHash::GroupWidth, FlatHash::Empty);
+
+	for (size_t i = 0; i < oldCapacity; ++i)
+	{
+		if (oldCtrl[i] < 0)
+			continue;
+
+		const size_t hash = m_hasher(oldSlots[i].first);
+		const size_t index = FindFreeSlot(hash);
+
+		SetCtrl(index, H2(hash));
+		std::construct_at(m_slots + index, std::move(oldSlots[i]));
+		std::destroy_at(oldSlots + i);
+	}
+
+	m_growthLeft = CapacityToGrowth(m_capacity) - m_size;
+
+	if (oldCapacity > 0)
+	{
+		delete[] oldCtrl;
+		std::allocator<value_type>().deallocate(oldSlots, oldCapacity);
+	}
+}
+
+template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+void FlatHashMap<TKey, TValue, THash, TKeyEqual>::Destroy()
+{
+	if (m_capacity == 0)
+		return;
+
+	clear();
+
+	delete[] m_ctrl;
+	std::allocator<value_type>().deallocate(m_slots, m_capacity);
+
+	m_ctrl = nullptr;
+	m_slots = nullptr;
+	m_capacity = 0;
+	m_growthLeft = 0;
+}
+
+template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+typename FlatHashMap<TKey, TValue, THash, TKeyEqual>::iterator FlatHashMap<TKey, TValue, THash, TKeyEqual>::MakeIterator(size_t index)
+{
+	return iterator(m_ctrl + index, m_ctrl + m_capacity, m_slots + index);
+}
+
+template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+typename FlatHashMap<TKey, TValue, THash, TKeyEqual>::const_iterator FlatHashMap<TKey, TValue, THash, TKeyEqual>::MakeIterator(size_t index) const
+{
+	return const_iterator(m_ctrl + index, m_ctrl + m_capacity, m_slots + index);
+}
+
+
+//	FLATHASHMAP FUNCTIONS
+//	---------------------
+
+template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+typename FlatHashMap<TKey, TValue, THash, TKeyEqual>::iterator FlatHashMap<TKey, TValue, THash, TKeyEqual>::begin()
+{
+	iterator it = MakeIterator(0);
+	it.SkipFreeSlots();
+	return it;
+}
+
+template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+typename FlatHashMap<TKey, TValue, THash, TKeyEqual>::iterator FlatHashMap<TKey, TValue, THash, TKeyEqual>::end()
+{
+	return MakeIterator(m_capacity);
+}
+
+template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+typename FlatHashMap<TKey, TValue, THash, TKeyEqual>::const_iterator FlatHashMap<TKey, TValue, THash, TKeyEqual>::begin() const
+{
+	const_iterator it = MakeIterator(0);
+	it.SkipFreeSlots();
+	return it;
+}
+
+template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+typename FlatHashMap<TKey, TValue, THash, TKeyEqual>::const_iterator FlatHashMap<TKey, TValue, THash, TKeyEqual>::end() const
+{
+	return MakeIterator(m_capacity);
+}
+
+template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+size_t FlatHashMap<TKey, TValue, THash, TKeyEqual>::size() const
+{
+	return m_size;
+}
+
+template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+bool FlatHashMap<TKey, TValue, THash, TKeyEqual>::empty() const
+{
+	return m_size == 0;
+}
+
+template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+size_t FlatHashMap<TKey, TValue, THash, TKeyEqual>::capacity() const
+{
+	return m_capacity;
+}
+
+template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+float FlatHashMap<TKey, TValue, THash, TKeyEqual>::load_factor() const
+{
+	return m_capacity > 0 ? static_cast<float>(m_size) / static_cast<float>(m_capacity) : 0.f;
+}
+
+template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+void FlatHashMap<TKey, TValue, THash, TKeyEqual>::reserve(size_t count)
+{
+	size_t newCapacity = std::max(m_capacity, FlatHash::GroupWidth);
+	while (CapacityToGrowth(newCapacity) < count)
+		newCapacity *= 2;
+
+	if (newCapacity != m_capacity)
+		Rehash(newCapacity);
+}
+
+template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+void FlatHashMap<TKey, TValue, THash, TKeyEqual>::clear()
+{
+	if (m_capacity == 0)
+		return;
+
+	for (size_t i = 0; i < m_capacity; ++i)
+	{
+		if (m_ctrl[i] >= 0)
+			std::destroy_at(m_slots + i);
+	}
+
+	std::fill_n(m_ctrl, m_capacity + FlatHash::GroupWidth, FlatHash::Empty);
+	m_size = 0;
+	m_growthLeft = CapacityToGrowth(m_capacity);
+}
+
+template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+typename FlatHashMap<TKey, TValue, THash, TKeyEqual>::iterator FlatHashMap<TKey, TValue, THash, TKeyEqual>::find(const TKey& key)
+{
+	return MakeIterator(FindIndex(key, m_hasher(key)));
+}
+
+template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+typename FlatHashMap<TKey, TValue, THash, TKeyEqual>::const_iterator FlatHashMap<TKey, TValue, THash, TKeyEqual>::find(const TKey& key) const
+{
+	return MakeIterator(FindIndex(key, m_hasher(key)));
+}
+
+template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+bool FlatHashMap<TKey, TValue, THash, TKeyEqual>::contains(const TKey& key) const
+{
+	return FindIndex(key, m_hasher(key)) != m_capacity;
+}
+
+template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+size_t FlatHashMap<TKey, TValue, THash, TKeyEqual>::count(const TKey& key) const
+{
+	return contains(key) ? 1 : 0;
+}
+
+template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+template <typename TKeyArg, typename... TArgs>
+std::pair<typename FlatHashMap<TKey, TValue, THash, TKeyEqual>::iterator, bool> FlatHashMap<TKey, TValue, THash, TKeyEqual>::try_emplace(TKeyArg&& key, TArgs&&... args)
+{
+	const size_t hash = m_hasher(key);
+
+	const size_t foundIndex = FindIndex(key, hash);
+	if (foundIndex != m_capacity)
+		return { MakeIterator(foundIndex), false };
+
+	const size_t index = PrepareInsert(hash);
+	std::construct_at(m_slots + index, std::piecewise_construct,
+		std::forward_as_tuple(std::forward<TKeyArg>(key)), std::forward_as_tuple(std::forward<TArgs>(args)...));
+
+	return { MakeIterator(index), true };
+}
+
+template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+template <typename TKeyArg, typename TValueArg>
+std::pair<typename FlatHashMap<TKey, TValue, THash, TKeyEqual>::iterator, bool> FlatHashMap<TKey, TValue, THash, TKeyEqual>::emplace(TKeyArg&& key, TValueArg&& value)
+{
+	return try_emplace(std::forward<TKeyArg>(key), std::forward<TValueArg>(value));
+}
+
+template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+TValue& FlatHashMap<TKey, TValue, THash, TKeyEqual>::operator[](const TKey& key)
+{
+	return try_emplace(key).first->second;
+}
+
+template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+size_t FlatHashMap<TKey, TValue, THash, TKeyEqual>::erase(const TKey& key)
+{
+	const size_t index = FindIndex(key, m_hasher(key));
+	if (index == m_capacity)
+		return 0;
+
+	erase(MakeIterator(index));
+	return 1;
+}
+
+template <typename TKey, typename TValue, typename THash, typename TKeyEqual>
+typename FlatHashMap<TKey, TValue, THash, TKeyEqual>::iterator FlatHashMap<TKey, TValue, THash, TKeyEqual>::erase(const_iterator it)
+{
+	const size_t index = static_cast<size_t>(it.m_ctrl - m_ctrl);
+
+	std::destroy_at(m_slots + index);
+
+	// Leave a tombstone so the probe sequences going through this slot are not cut
+	SetCtrl(index, FlatHash::Deleted);
+	m_size--;
+
+	iterator next = MakeIterator(index);
+	++next;
+	return next;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+/**
+@brief Read-only memory mapping of a whole file. The content is paged in by the OS on access, nothing is copied.
+*/
+class MappedFile
+{
+//	Variables
+
+private:
+	const unsigned char* m_data = nullptr;
+	size_t m_size = 0;
+
+#ifdef _WIN32
+	void* m_file = nullptr;
+	void* m_mapping = nullptr;
+#else
+	int m_descriptor = -1;
+#endif
+
+//	Constructors
+
+public:
+	MappedFile() = default;
+	~MappedFile();
+
+	MappedFile(MappedFile&& other) noexcept;
+	MappedFile& operator=(MappedFile&& other) noexcept;
+
+	MappedFile(MappedFile const&) = delete;
+	MappedFile& operator=(MappedFile const&) = delete;
+
+//	Functions
+
+public:
+	/**
+	@brief Map a file, the previous mapping is closed
+
+	@param path : Path of the file
+	@return bool : true if the file is mapped (empty files can't be mapped)
+	*/
+	bool Open(const std::string& path);
+
+	/**
+	@brief Unmap the file, pointers to its content become invalid
+	*/
+	void Close();
+
+	bool IsOpen() const;
+	const unsigned char* GetData() const;
+	size_t GetSize() const;
+
+	/**
+	@brief Get a typed view of a range of the file, bound checked
+
+	@tparam T : Trivially copyable type stored in the file
+	@param offset : Offset of the first element in bytes
+	@param count : Number of elements
+
+	@return const T* : Pointer to the first element, nullptr if the range is out of the file
+	*/
+	template <typename T>
+	const T* View(uint64_t offset, uint64_t count = 1) const;
+};
+
+#include "Tools/MappedFile.inl"
@@ -0,0 +1,31 @@
+#include <type_traits>
+
+inline bool MappedFile::IsOpen() const
+{
+	return m_data != nullptr;
+}
+
+inline const unsigned char* MappedFile::GetData() const
+{
+	return m_data;
+}
+
+inline size_t MappedFile::GetSize() const
+{
+	return m_size;
+}
+
+template <typename T>
+const T* MappedFile::View(uint64_t offset, uint64_t count) const
+{
+	static_assert(std::is_trivially_copyable_v<T>, "Mapped data can only be viewed as trivially copyable types");
+
+	if (offset > m_size || count > (m_size - offset) / sizeof(T))
+		return nullptr;
+
+	// Unaligned views would be undefined behavior
+	if (reinterpret_cast<uintptr_t>(m_data + offset) % alignof(T) != 0)
+		return nullptr;
+
+	return reinterpret_cast<const T*>(m_data + offset);
+}
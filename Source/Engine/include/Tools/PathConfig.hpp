@@ -15,6 +15,9 @@ constexpr char INTERNAL_ENGINE_SCRIPTING_ROOT_RAW[] = R"(..\Source\Scripting)";
 constexpr char BINARIES_ROOT[]						= R"(.\)";
 constexpr char BINARIES_ROOT_RAW[]					= R"(.\)";
 
+constexpr char CACHE_ROOT[]							= R"(..\Cache\)";
+constexpr char CACHE_ROOT_RAW[]						= R"(..\Cache)";
+
 #else
 constexpr char ASSETS_ROOT[]						= R"(..\..\..\Assets\)";
 constexpr char ASSETS_ROOT_RAW[]					= R"(..\..\..\Assets)";
@@ -25,6 +28,9 @@ constexpr char INTERNAL_ENGINE_RESOURCES_ROOT_RAW[] = R"(..\..\..\Internal\Resou
 constexpr char INTERNAL_ENGINE_SCRIPTING_ROOT[]		= R"(..\..\..\Source\Scripting\)";
 constexpr char INTERNAL_ENGINE_SCRIPTING_ROOT_RAW[] = R"(..\..\..\Source\Scripting)";
 
+constexpr char CACHE_ROOT[]							= R"(..\..\..\Cache\)";
+constexpr char CACHE_ROOT_RAW[]						= R"(..\..\..\Cache)";
+
 #ifdef _DEBUG
 constexpr char BINARIES_ROOT[] = R"(..\..\..\Binaries\Debug\)";
 constexpr char BINARIES_ROOT_RAW[] = R"(..\..\..\Binaries\Debug)";
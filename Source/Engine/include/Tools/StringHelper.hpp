@@ -2,6 +2,8 @@
 
 #include <string>
 #include <filesystem>
+#include <cstdint>
+#include <cstring>
 
 #include "EngineDll.hpp"
 #include "Core/Logger.hpp"
@@ -110,6 +112,22 @@ namespace StringHelper
     */
     ENGINE_API bool StrStrCaseUnsensitive(const std::string& str1, const std::string& str2);
 
+    /*
+    @brief Hash of a path ignoring upper/lower case and separator kind ('/' or '\\')
+    */
+    struct PathHash
+    {
+        size_t operator()(const std::string& path) const;
+    };
+
+    /*
+    @brief Equality of two paths ignoring upper/lower case and separator kind ('/' or '\\')
+    */
+    struct PathEqual
+    {
+        bool operator()(const std::string& path1, const std::string& path2) const;
+    };
+
 }
 
 #include "Tools/StringHelper.inl"
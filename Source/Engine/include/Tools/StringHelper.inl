@@ -83,4 +83,82 @@ inline std::string StringHelper::GetFileExtensionFromPath(const std::string& fil
 inline std::string StringHelper::GetDirectory(const std::string& filepath)
 {
     return fs::path(filepath).remove_filename().string();
-}
\ No newline at end of file
+}
+
+namespace StringHelper::details
+{
+    constexpr uint64_t ByteOnes = 0x0101010101010101ull;
+    constexpr uint64_t ByteHighBits = 0x8080808080808080ull;
+
+    /*
+    @brief Fold 8 path characters at once : upper case ASCII letters become lower case and '/' becomes '\\'
+    */
+    inline uint64_t FoldPathWord(uint64_t word)
+    {
+        // High bit set in each byte between 'A' and 'Z' (bytes >= 0x80 are left untouched)
+        const uint64_t low7 = word & ~ByteHighBits;
+        const uint64_t aboveA = low7 + ByteOnes * (0x80 - 'A');
+        const uint64_t aboveZ = low7 + ByteOnes * (0x80 - 'Z' - 1);
+        const uint64_t upper = (aboveA ^ aboveZ) & ~word & ByteHighBits;
+        word |= upper >> 2;
+
+        // High bit set in each byte equal to '/'
+        const uint64_t slashDiff = word ^ (ByteOnes * '/');
+        const uint64_t slash = ~(((slashDiff & ~ByteHighBits) + ~ByteHighBits) | slashDiff | ~ByteHighBits);
+        return word ^ ((slash >> 7) * ('/' ^ '\\'));
+    }
+
+    /*
+    @brief Load up to 8 characters of a path, missing characters are 0
+    */
+    inline uint64_t LoadPathWord(const char* chars, size_t count)
+    {
+        uint64_t word = 0;
+        if (count >= 8)
+        {
+            std::memcpy(&word, chars, 8);
+            return word;
+        }
+
+        for (size_t i = 0; i < count; ++i)
+            word |= static_cast<uint64_t>(static_cast<unsigned char>(chars[i])) << (i * 8);
+        return word;
+    }
+}
+
+inline size_t StringHelper::PathHash::operator()(const std::string& path) const
+{
+    uint64_t hash = path.size() * 0x9E3779B97F4A7C15ull;
+
+    for (size_t i = 0; i < path.size(); i += 8)
+    {
+        hash ^= details::FoldPathWord(details::LoadPathWord(path.data() + i, path.size() - i));
+        hash *= 0xFF51AFD7ED558CCDull;
+        hash ^= hash >> 32;
+    }
+
+    // Final mix so that every bit of the result depends on the whole path
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ull;
+    hash ^= hash >> 33;
+    return static_cast<size_t>(hash);
+}
+
+inline bool StringHelper::PathEqual::operator()(const std::string& path1, const std::string& path2) const
+{
+    if (path1.size() != path2.size())
+        return false;
+
+    // Paths are usually looked up with the exact same spelling
+    if (std::memcmp(path1.data(), path2.data(), path1.size()) == 0)
+        return true;
+
+    for (size_t i = 0; i < path1.size(); i += 8)
+    {
+        const size_t count = path1.size() - i;
+        if (details::FoldPathWord(details::LoadPathWord(path1.data() + i, count)) != details::FoldPathWord(details::LoadPathWord(path2.data() + i, count)))
+            return false;
+    }
+
+    return true;
+}
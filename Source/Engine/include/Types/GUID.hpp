@@ -1,7 +1,10 @@
 #pragma once
 
 #include <array>
+#include <span>
 #include <iostream>
+#include <cstring>
+#include <cstdint>
 
 #include "EngineDLL.hpp"
 
@@ -28,8 +31,18 @@ private:
 	std::string ToString() const;
 
 public:
+	/**
+	@brief Generate a random (version 4) GUID with the generator of the current thread
+	*/
 	static HYGUID NewGUID();
 
+	/**
+	@brief Generate many random GUIDs at once
+
+	@param guids : GUIDs to fill
+	*/
+	static void NewMany(std::span<HYGUID> guids);
+
 	const std::array<unsigned char, 16>& Bytes() const;
 
 	operator std::string() const;
@@ -64,15 +77,35 @@ namespace details
 	};
 }
 
+namespace details
+{
+	/**
+	@brief Bijective 64 bits finalizer (splitmix64), every input bit affects every output bit
+	*/
+	constexpr uint64_t Mix64(uint64_t value)
+	{
+		value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+		value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+		return value ^ (value >> 31);
+	}
+}
+
 namespace std
 {
 	template<>
 	struct hash<HYGUID>
 	{
+		/**
+		@brief Fold the 128 bits of the GUID into 64 well mixed bits,
+		open addressing tables use both the low and high bits of the result
+		*/
 		std::size_t operator()(const HYGUID& guid) const
 		{
-			const uint64_t* p = reinterpret_cast<const uint64_t*>(guid.Bytes().data());
-			return details::hash<uint64_t, uint64_t>{}(p[0], p[1]);
+			uint64_t low, high;
+			std::memcpy(&low, guid.Bytes().data(), sizeof(uint64_t));
+			std::memcpy(&high, guid.Bytes().data() + sizeof(uint64_t), sizeof(uint64_t));
+
+			return static_cast<std::size_t>(details::Mix64(low ^ details::Mix64(high + 0x9E3779B97F4A7C15ull)));
 		}
 	};
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "Core/ResourcesTaskPool.hpp"
 
+#include <memory>
 #include <algorithm>
 
 ResourcesTaskPool::ResourcesTaskPool()
@@ -34,6 +35,46 @@ void ResourcesTaskPool::WaitingForMultiTasksCompletion()
 	m_destroyNotifier.wait(lq, [&] { return !IsRunning(); });
 }
 
+void ResourcesTaskPool::ParallelFor(size_t count, size_t chunkSize, const std::function<void(size_t, size_t)>& function)
+{
+	if (count == 0)
+		return;
+
+	chunkSize = std::max<size_t>(chunkSize, 1);
+	const size_t chunkCount = (count + chunkSize - 1) / chunkSize;
+
+	// Shared with the helper tasks, which may only be picked up once every chunk is done
+	std::shared_ptr<ParallelForState> state = std::make_shared<ParallelForState>();
+	state->remainingChunks = chunkCount;
+
+	auto runChunks = [state, chunkCount, chunkSize, count, &function]()
+	{
+		for (size_t chunk = state->nextChunk.fetch_add(1); chunk < chunkCount; chunk = state->nextChunk.fetch_add(1))
+		{
+			const size_t begin = chunk * chunkSize;
+			function(begin, std::min(begin + chunkSize, count));
+
+			if (state->remainingChunks.fetch_sub(1) == 1)
+			{
+				// Lock before notifying so the caller can't miss the notification between its check and its wait
+				std::lock_guard doneGuard(state->doneMutex);
+				state->doneNotifier.notify_all();
+			}
+		}
+	};
+
+	const size_t helperCount = std::min<size_t>(chunkCount - 1, m_threadCount);
+	for (size_t i = 0; i < helperCount; i++)
+		AddMultiThreadTask(runChunks);
+
+	// The caller takes chunks too : the call completes even from a task of the pool with every thread busy
+	runChunks();
+
+	// Only wait for the chunks of this call still run by the helpers
+	std::unique_lock doneLock(state->doneMutex);
+	state->doneNotifier.wait(doneLock, [&state] { return state->remainingChunks.load() == 0; });
+}
+
 void ResourcesTaskPool::AddMultiThreadTask(Task newTask)
 {
 	std::lock_guard queueGuard(m_queueMutex);
@@ -100,8 +141,13 @@ void ResourcesTaskPool::ThreadRoutine()
 		// Remove thread from global count
 		m_runningThreadCount.fetch_sub(1);
 
+		// Lock the queue before notifying so a waiter can't miss the notification between its check and its wait
+		{
+			std::lock_guard queueGuard(m_queueMutex);
+		}
+
 		// Notify the destructor condition to kill the pool if needed
-		m_destroyNotifier.notify_one();
+		m_destroyNotifier.notify_all();
 	}
 
 	// Log end thread
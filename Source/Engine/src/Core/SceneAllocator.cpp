@@ -0,0 +1,98 @@
+#include "Core/SceneAllocator.hpp"
+
+#include <array>
+
+#include "Core/Logger.hpp"
+
+namespace
+{
+	// Component size classes, bigger components are allocated on the heap
+	constexpr std::array<size_t, 10> ComponentSizeClasses = { 64, 128, 192, 256, 384, 512, 768, 1024, 1536, 2048 };
+
+	// Allocator used by component allocations of the current thread
+	thread_local SceneAllocator* currentAllocator = nullptr;
+}
+
+SceneAllocator::Scope::Scope(SceneAllocator* allocator)
+	: m_previous(currentAllocator)
+{
+	currentAllocator = allocator;
+}
+
+SceneAllocator::Scope::~Scope()
+{
+	currentAllocator = m_previous;
+}
+
+SceneAllocator::SceneAllocator()
+	: m_gameObjectPool(sizeof(GameObject))
+{
+	m_componentPools.reserve(ComponentSizeClasses.size());
+
+	for (size_t sizeClass : ComponentSizeClasses)
+		m_componentPools.emplace_back(std::make_unique<SlabPool>(sizeClass, 32));
+}
+
+void* SceneAllocator::AllocateComponent(size_t size)
+{
+	for (auto& pool : m_componentPools)
+	{
+		if (size <= pool->GetBlockSize())
+			return pool->Allocate();
+	}
+
+	return SlabPool::AllocateFromHeap(size);
+}
+
+void* SceneAllocator::Allocate(size_t size)
+{
+	if (currentAllocator)
+		return currentAllocator->AllocateComponent(size);
+
+	return SlabPool::AllocateFromHeap(size);
+}
+
+void SceneAllocator::Deallocate(void* ptr)
+{
+	SlabPool::Free(ptr);
+}
+
+bool SceneAllocator::Release()
+{
+	bool released = m_gameObjectPool.Release();
+
+	for (auto& pool : m_componentPools)
+		released &= pool->Release();
+
+	return released;
+}
+
+std::vector<PoolStats> SceneAllocator::GetStats() const
+{
+	std::vector<PoolStats> stats;
+	stats.reserve(m_componentPools.size() + 1);
+
+	stats.emplace_back(m_gameObjectPool.GetStats());
+
+	for (const auto& pool : m_componentPools)
+		stats.emplace_back(pool->GetStats());
+
+	return stats;
+}
+
+void SceneAllocator::LogStats(const std::string& ownerName) const
+{
+	std::vector<PoolStats> stats = GetStats();
+
+	for (size_t i = 0; i < stats.size(); ++i)
+	{
+		const PoolStats& pool = stats[i];
+		if (pool.slabCount == 0)
+			continue;
+
+		Logger::Info(ownerName + " - " + (i == 0 ? "GameObject" : "Component") + " pool (" + std::to_string(pool.blockSize) + " bytes) : "
+			+ std::to_string(pool.liveCount) + "/" + std::to_string(pool.capacity) + " blocks in " + std::to_string(pool.slabCount) + " slabs, peak "
+			+ std::to_string(pool.peakCount) + ", occupancy " + std::to_string(static_cast<int>(pool.Occupancy() * 100.f)) + "%, fragmentation "
+			+ std::to_string(static_cast<int>(pool.Fragmentation() * 100.f)) + "%");
+	}
+}
@@ -0,0 +1,146 @@
+#include "Core/SlabPool.hpp"
+
+#include <new>
+#include <algorithm>
+
+#include "Core/Logger.hpp"
+
+namespace
+{
+	constexpr size_t BlockAlignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+	size_t AlignUp(size_t size, size_t alignment)
+	{
+		return (size + alignment - 1) & ~(alignment - 1);
+	}
+
+	// Free blocks store the next free header right after their own header
+	SlabPool::BlockHeader*& NextFree(SlabPool::BlockHeader* header)
+	{
+		return *reinterpret_cast<SlabPool::BlockHeader**>(header + 1);
+	}
+}
+
+SlabPool::SlabPool(size_t blockSize, size_t blocksPerSlab)
+	: m_blockSize(blockSize),
+	m_stride(AlignUp(sizeof(BlockHeader) + std::max(blockSize, sizeof(BlockHeader*)), BlockAlignment)),
+	m_blocksPerSlab(std::max<size_t>(blocksPerSlab, 1))
+{ }
+
+SlabPool::~SlabPool()
+{
+	// Never free memory under live objects, they are leaked instead
+	if (m_liveCount > 0)
+	{
+		Logger::Error("SlabPool - Destroyed with " + std::to_string(m_liveCount) + " live blocks, their memory is leaked");
+
+		for (Slab& slab : m_slabs)
+			(void)slab.memory.release();
+	}
+}
+
+void SlabPool::AddSlab()
+{
+	const size_t slabIndex = m_slabs.size();
+
+	Slab& slab = m_slabs.emplace_back();
+	slab.memory = std::make_unique_for_overwrite<std::byte[]>(m_stride * m_blocksPerSlab);
+
+	// Chain blocks in address order so consecutive allocations are contiguous
+	for (size_t i = m_blocksPerSlab; i-- > 0;)
+	{
+		BlockHeader* header = reinterpret_cast<BlockHeader*>(slab.memory.get() + i * m_stride);
+		header->pool = this;
+		header->slabIndex = slabIndex;
+
+		NextFree(header) = m_freeList;
+		m_freeList = header;
+	}
+}
+
+void* SlabPool::Allocate()
+{
+	std::lock_guard lock(m_mutex);
+
+	if (m_freeList == nullptr)
+		AddSlab();
+
+	BlockHeader* header = m_freeList;
+	m_freeList = NextFree(header);
+
+	m_slabs[header->slabIndex].liveCount++;
+	m_peakCount = std::max(m_peakCount, ++m_liveCount);
+
+	return header + 1;
+}
+
+void SlabPool::Deallocate(void* ptr)
+{
+	BlockHeader& header = GetHeader(ptr);
+
+	std::lock_guard lock(m_mutex);
+
+	m_slabs[header.slabIndex].liveCount--;
+	m_liveCount--;
+
+	NextFree(&header) = m_freeList;
+	m_freeList = &header;
+}
+
+bool SlabPool::Release()
+{
+	std::lock_guard lock(m_mutex);
+
+	if (m_liveCount > 0)
+	{
+		Logger::Error("SlabPool - Can't release a pool that still holds " + std::to_string(m_liveCount) + " live blocks");
+		return false;
+	}
+
+	m_slabs.clear();
+	m_freeList = nullptr;
+
+	return true;
+}
+
+PoolStats SlabPool::GetStats() const
+{
+	std::lock_guard lock(m_mutex);
+
+	PoolStats stats;
+	stats.blockSize = m_blockSize;
+	stats.slabCount = m_slabs.size();
+	stats.capacity = m_slabs.size() * m_blocksPerSlab;
+	stats.liveCount = m_liveCount;
+	stats.peakCount = m_peakCount;
+
+	for (const Slab& slab : m_slabs)
+	{
+		if (slab.liveCount > 0)
+			stats.holeCount += m_blocksPerSlab - slab.liveCount;
+	}
+
+	return stats;
+}
+
+void* SlabPool::AllocateFromHeap(size_t size)
+{
+	BlockHeader* header = static_cast<BlockHeader*>(::operator new(sizeof(BlockHeader) + size));
+	header->pool = nullptr;
+	header->slabIndex = 0;
+
+	return header + 1;
+}
+
+void SlabPool::Free(void* ptr)
+{
+	if (ptr == nullptr)
+		return;
+
+	BlockHeader& header = GetHeader(ptr);
+
+	if (header.pool)
+		header.pool->Deallocate(ptr);
+	else
+		::operator delete(&header);
+}
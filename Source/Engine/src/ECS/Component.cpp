@@ -1,4 +1,5 @@
 #include "ECS/GameObject.hpp"
+#include "Core/SceneAllocator.hpp"
 
 #include "Generated/Component.rfks.h"
 
@@ -12,6 +13,27 @@ Component::~Component()
 {
 }
 
+void* Component::operator new(size_t size)
+{
+	return SceneAllocator::Allocate(size);
+}
+
+void* Component::operator new(size_t size, std::align_val_t alignment)
+{
+	// Pools only guarantee the default alignment
+	return ::operator new(size, alignment);
+}
+
+void Component::operator delete(void* ptr)
+{
+	SceneAllocator::Deallocate(ptr);
+}
+
+void Component::operator delete(void* ptr, std::align_val_t alignment)
+{
+	::operator delete(ptr, alignment);
+}
+
 bool Component::IsUnique() const
 {
 	return m_isUnique;
@@ -19,6 +19,7 @@ void BehaviorSystem::StopSystem()
 	m_shouldInitiateBehavior = false;
 	m_startInitialize.ClearCallbacks();
 	m_awakeInitialize.ClearCallbacks();
+	m_pendingInitializes.clear();
 }
 
 void BehaviorSystem::InitializeNewBehaviors()
@@ -35,6 +36,8 @@ void BehaviorSystem::InitializeNewBehaviors()
 	// Call Start on behaviors added in game
 	m_startInitialize.Invoke();
 	m_startInitialize.ClearCallbacks();
+
+	m_pendingInitializes.clear();
 }
 
 void BehaviorSystem::AwakeAll()
@@ -106,8 +109,11 @@ Behavior* BehaviorSystem::AddBehaviorInstance(rfk::Class const& archetype, GameO
 	if (m_shouldInitiateBehavior)
 	{
 		m_addBehavior = true;
-		m_awakeInitialize.AddCallback(&Behavior::Awake, behavior);
-		m_startInitialize.AddCallback(&Behavior::Start, behavior);
+
+		PendingInitialize& pending = m_pendingInitializes.emplace_back();
+		pending.sceneID = owner.GetSceneID();
+		pending.awakeID = m_awakeInitialize.AddCallback(&Behavior::Awake, behavior);
+		pending.startID = m_startInitialize.AddCallback(&Behavior::Start, behavior);
 	}
 
 	return &behavior;
@@ -128,4 +134,22 @@ void BehaviorSystem::RemoveBehaviorInstance(Behavior& behavior)
 
 	// Remove the behavior
 	m_behaviors.erase(it);
+}
+
+void BehaviorSystem::RemoveSceneInstances(const HYGUID& sceneID)
+{
+	// Pending Awake/Start callbacks of the scene reference removed behaviors, those of the other scenes are kept
+	std::erase_if(m_pendingInitializes, [this, &sceneID](const PendingInitialize& pending)
+	{
+		if (pending.sceneID != sceneID)
+			return false;
+
+		m_awakeInitialize.RemoveCallback(pending.awakeID);
+		m_startInitialize.RemoveCallback(pending.startID);
+		return true;
+	});
+	m_addBehavior = m_addBehavior && !m_pendingInitializes.empty();
+
+	std::erase_if(m_behaviors,
+		[&sceneID](std::unique_ptr<Behavior>& behavior) { return behavior->gameObject.GetSceneID() == sceneID; });
 }
\ No newline at end of file
@@ -77,4 +77,16 @@ void CameraSystem::RemoveCameraInstance(CameraComponent& camera)
 
 	// Remove the camera
 	m_cameras.erase(it);
+}
+
+void CameraSystem::RemoveSceneInstances(const HYGUID& sceneID)
+{
+	if (m_activeCamera && m_activeCamera->gameObject.GetSceneID() == sceneID)
+		m_activeCamera = nullptr;
+
+	std::erase_if(m_cameras,
+		[&sceneID](std::unique_ptr<CameraComponent>& camera) { return camera->gameObject.GetSceneID() == sceneID; });
+
+	if (!m_activeCamera && !m_cameras.empty())
+		m_activeCamera = m_cameras[0].get();
 }
\ No newline at end of file
@@ -14,33 +14,126 @@ void MeshSystem::SendInstancesToRenderSystem(TPairComponentInstances& componentI
 	{
 		if (GenerateSubMeshesInstances(*componentInstances.first))
 		{
-			SendToRenderSystem(componentInstances.second);
+			SendToRenderSystem(*componentInstances.first);
 		}
 		return;
 	}
 	if (!componentInstances.second.registered)
 	{
-		SendToRenderSystem(componentInstances.second);
+		SendToRenderSystem(*componentInstances.first);
 	}
 }
 
 
+template<typename TInstance, typename TCompInstancesMap, typename TMatInstancesMap>
+void MeshSystem::RemoveSceneSubMeshesInstances(TCompInstancesMap& compInstances, TMatInstancesMap& instancesFromMat, const HYGUID& sceneID)
+{
+	std::vector<TInstance*> removedInstances;
+	for (auto& [comp, subInstances] : compInstances)
+	{
+		if (comp->gameObject.GetSceneID() != sceneID) continue;
+
+		for (TInstance& instance : subInstances.instances)
+		{
+			removedInstances.emplace_back(&instance);
+
+			if (instance.material == nullptr) continue;
+
+			auto matIt = instancesFromMat.find(instance.material);
+			if (matIt != instancesFromMat.end())
+				matIt->second.Remove(&instance);
+		}
+	}
+
+	if (removedInstances.empty()) return;
+
+	//	Unregister all instances before they are destroyed
+	SystemManager::GetRenderSystem().UnregisterMany(removedInstances);
+
+	std::erase_if(instancesFromMat, [](const auto& matInstances) { return matInstances.second.Empty(); });
+	std::erase_if(compInstances, [&sceneID](const auto& subInstances) { return subInstances.first->gameObject.GetSceneID() == sceneID; });
+}
+
+
 void MeshSystem::UpdateMeshesWithMaterial(Material* material)
 {
 	RenderSystem& renderSystem = SystemManager::GetRenderSystem();
-	for (MeshInstance* instance : m_meshInstancesFromMat[material])
+
+	auto meshIt = m_meshInstancesFromMat.find(material);
+	if (meshIt != m_meshInstancesFromMat.end())
 	{
-		renderSystem.Unregister(instance);
-		renderSystem.Register(instance);
+		for (MeshInstance* instance : meshIt->second)
+		{
+			renderSystem.Unregister(instance);
+			renderSystem.Register(instance);
+		}
 	}
 
-	for (SkeletalMeshInstance* instance : m_skeletalMeshInstancesFromMat[material])
+	auto skMeshIt = m_skeletalMeshInstancesFromMat.find(material);
+	if (skMeshIt != m_skeletalMeshInstancesFromMat.end())
 	{
-		renderSystem.Unregister(instance);
-		renderSystem.Register(instance);
+		for (SkeletalMeshInstance* instance : skMeshIt->second)
+		{
+			renderSystem.Unregister(instance);
+			renderSystem.Register(instance);
+		}
 	}
 }
 
+void MeshSystem::BeginRegistrationBatch()
+{
+	m_registrationBatchDepth++;
+}
+
+void MeshSystem::EndRegistrationBatch()
+{
+	if (m_registrationBatchDepth == 0)
+	{
+		Logger::Warning("MeshSystem - EndRegistrationBatch called without a matching BeginRegistrationBatch");
+		return;
+	}
+
+	if (--m_registrationBatchDepth > 0)
+		return;
+
+	//	Gather the instances kept aside during the batch, components removed since then are no longer in the maps
+	std::vector<MeshInstance*> pendingInstances;
+	for (MeshComponent* meshComp : m_pendingMeshComps)
+	{
+		auto it = m_meshCompInstances.find(meshComp);
+		if (it == m_meshCompInstances.end()) continue;
+
+		SubmeshesInstances& submeshesInstances = it->second;
+		if (submeshesInstances.registered || submeshesInstances.currentMesh == nullptr) continue;
+
+		for (MeshInstance& instance : submeshesInstances.instances)
+			pendingInstances.emplace_back(&instance);
+
+		submeshesInstances.registered = true;
+	}
+	m_pendingMeshComps.clear();
+
+	std::vector<SkeletalMeshInstance*> pendingSkInstances;
+	for (SkeletalMeshComponent* skMeshComp : m_pendingSkMeshComps)
+	{
+		auto it = m_skMeshCompInstances.find(skMeshComp);
+		if (it == m_skMeshCompInstances.end()) continue;
+
+		SubSkeletalMeshesInstances& subSkeletalMeshesInstances = it->second;
+		if (subSkeletalMeshesInstances.registered || subSkeletalMeshesInstances.currentMesh == nullptr) continue;
+
+		for (SkeletalMeshInstance& instance : subSkeletalMeshesInstances.instances)
+			pendingSkInstances.emplace_back(&instance);
+
+		subSkeletalMeshesInstances.registered = true;
+	}
+	m_pendingSkMeshComps.clear();
+
+	RenderSystem& renderSystem = SystemManager::GetRenderSystem();
+	renderSystem.RegisterMany(pendingInstances);
+	renderSystem.RegisterMany(pendingSkInstances);
+}
+
 void MeshSystem::Update()
 {
 	for (auto& element : m_skMeshCompInstances)
@@ -76,7 +169,7 @@ bool MeshSystem::GenerateSubMeshesInstances(MeshComponent& meshComp)
 		MeshInstance& instance = instances.emplace_back(&mesh->subMeshes[i], material, &meshComp.gameObject.transform);
 		instance.isActive = meshComp.IsActive();
 
-		if (material) m_meshInstancesFromMat[material].emplace_back(&instance);
+		if (material) m_meshInstancesFromMat[material].Add(&instance);
 	}
 
 	for (const Material* mat : meshComp.materials)
@@ -101,14 +194,13 @@ void MeshSystem::DegenerateSubMeshesInstances(MeshComponent& meshComp)
 		{
 			if (instance.material == nullptr) continue;
 
-			auto& boundInstance = m_meshInstancesFromMat[instance.material];
+			auto matIt = m_meshInstancesFromMat.find(instance.material);
+			if (matIt == m_meshInstancesFromMat.end()) continue;
 
-			auto it = std::find(boundInstance.begin(), boundInstance.end(), &instance);
+			matIt->second.Remove(&instance);
 
-			if (it != boundInstance.end())
-			{
-				boundInstance.erase(it);
-			}
+			if (matIt->second.Empty())
+				m_meshInstancesFromMat.erase(matIt);
 		}
 
 		m_meshCompInstances.erase(it);
@@ -123,7 +215,7 @@ void MeshSystem::UpdateMeshComponent(MeshComponent& meshComp)
 	{
 		if (GenerateSubMeshesInstances(meshComp))
 		{
-			SendToRenderSystem(m_meshCompInstances[&meshComp]);
+			SendToRenderSystem(meshComp);
 		}
 
 		return;
@@ -135,18 +227,26 @@ void MeshSystem::UpdateMeshComponent(MeshComponent& meshComp)
 
 	if (GenerateSubMeshesInstances(meshComp))
 	{
-		SendToRenderSystem(m_meshCompInstances[&meshComp]);
+		SendToRenderSystem(meshComp);
 	}
 }
 
 
-void MeshSystem::SendToRenderSystem(SubmeshesInstances& meshComp)
+void MeshSystem::SendToRenderSystem(MeshComponent& meshComp)
 {
-	for (MeshInstance& instance : meshComp.instances)
+	//	Registration is deferred to the end of the batch
+	if (m_registrationBatchDepth > 0)
+	{
+		m_pendingMeshComps.emplace_back(&meshComp);
+		return;
+	}
+
+	SubmeshesInstances& submeshesInstances = m_meshCompInstances[&meshComp];
+	for (MeshInstance& instance : submeshesInstances.instances)
 	{
 		SystemManager::GetRenderSystem().Register(&instance);
 	}
-	meshComp.registered = true;
+	submeshesInstances.registered = true;
 }
 
 
@@ -162,20 +262,17 @@ void MeshSystem::RemoveFromRenderSystem(SubmeshesInstances& meshComp)
 
 MeshComponent* MeshSystem::AddMeshInstance(rfk::Class const& archetype, GameObject& owner, const HYGUID& id)
 {
-	MeshComponent& meshComp = *m_meshComponents.emplace_back(archetype.makeUniqueInstance<MeshComponent>(owner, id));
+	MeshComponent& meshComp = m_meshComponents.Add(archetype.makeUniqueInstance<MeshComponent>(owner, id));
 
 	if (GenerateSubMeshesInstances(meshComp))
-		SendToRenderSystem(m_meshCompInstances[&meshComp]);
+		SendToRenderSystem(meshComp);
 
 	return &meshComp;
 }
 
 void MeshSystem::RemoveMeshInstance(MeshComponent& meshComp)
 {
-	auto it = std::find_if(m_meshComponents.begin(), m_meshComponents.end(),
-		[&meshComp](std::unique_ptr<MeshComponent>& mesh) { return mesh.get() == &meshComp; });
-
-	if (it == m_meshComponents.end())
+	if (!m_meshComponents.Contains(meshComp))
 	{
 		Logger::Error("MeshSystem - The mesh component you tried to remove not exists");
 		return;
@@ -183,7 +280,7 @@ void MeshSystem::RemoveMeshInstance(MeshComponent& meshComp)
 
 	// Erase skeletal component
 	DegenerateSubMeshesInstances(meshComp);
-	m_meshComponents.erase(it);
+	m_meshComponents.Erase(meshComp);
 }
 
 //	SKELETAL MESHES	FUNCTIONS
@@ -213,7 +310,7 @@ bool MeshSystem::GenerateSubMeshesInstances(SkeletalMeshComponent& skMeshComp)
 		SkeletalMeshInstance& instance = instances.emplace_back(&skmesh->subMeshes[i], material, &skMeshComp.gameObject.transform, skeleton);
 		instance.isActive = skMeshComp.IsActive();
 
-		if (material) m_skeletalMeshInstancesFromMat[material].emplace_back(&instance);
+		if (material) m_skeletalMeshInstancesFromMat[material].Add(&instance);
 	}
 
 	for (const Material* mat : skMeshComp.materials)
@@ -233,19 +330,18 @@ void MeshSystem::DegenerateSubMeshesInstances(SkeletalMeshComponent& skMeshComp)
 	{
 		RemoveFromRenderSystem(m_skMeshCompInstances[&skMeshComp]);
 
-		//	Remove instances from "m_meshInstancesFromMat"
-		for (MeshInstance& instance : m_skMeshCompInstances[&skMeshComp].instances)
+		//	Remove instances from "m_skeletalMeshInstancesFromMat"
+		for (SkeletalMeshInstance& instance : m_skMeshCompInstances[&skMeshComp].instances)
 		{
 			if (instance.material == nullptr) continue;
 
-			auto& boundInstance = m_skeletalMeshInstancesFromMat[instance.material];
+			auto matIt = m_skeletalMeshInstancesFromMat.find(instance.material);
+			if (matIt == m_skeletalMeshInstancesFromMat.end()) continue;
 
-			auto it = std::find(boundInstance.begin(), boundInstance.end(), &instance);
+			matIt->second.Remove(&instance);
 
-			if (it != boundInstance.end())
-			{
-				boundInstance.erase(it);
-			}
+			if (matIt->second.Empty())
+				m_skeletalMeshInstancesFromMat.erase(matIt);
 		}
 
 		m_skMeshCompInstances.erase(it);
@@ -260,7 +356,7 @@ void MeshSystem::UpdateSkeletalMeshComponent(SkeletalMeshComponent& skMeshComp)
 	{
 		if (GenerateSubMeshesInstances(skMeshComp))
 		{
-			SendToRenderSystem(m_skMeshCompInstances[&skMeshComp]);
+			SendToRenderSystem(skMeshComp);
 		}
 
 		return;
@@ -272,13 +368,21 @@ void MeshSystem::UpdateSkeletalMeshComponent(SkeletalMeshComponent& skMeshComp)
 
 	if (GenerateSubMeshesInstances(skMeshComp))
 	{
-		SendToRenderSystem(m_skMeshCompInstances[&skMeshComp]);
+		SendToRenderSystem(skMeshComp);
 	}
 }
 
 
-void MeshSystem::SendToRenderSystem(SubSkeletalMeshesInstances& subSkeletalMeshinstances)
+void MeshSystem::SendToRenderSystem(SkeletalMeshComponent& skMeshComp)
 {
+	//	Registration is deferred to the end of the batch
+	if (m_registrationBatchDepth > 0)
+	{
+		m_pendingSkMeshComps.emplace_back(&skMeshComp);
+		return;
+	}
+
+	SubSkeletalMeshesInstances& subSkeletalMeshinstances = m_skMeshCompInstances[&skMeshComp];
 	for (SkeletalMeshInstance& instance : subSkeletalMeshinstances.instances)
 	{
 		SystemManager::GetRenderSystem().Register(&instance);
@@ -299,20 +403,17 @@ void MeshSystem::RemoveFromRenderSystem(SubSkeletalMeshesInstances& subSkeletalM
 
 SkeletalMeshComponent* MeshSystem::AddSkMeshInstance(rfk::Class const& archetype, GameObject& owner, const HYGUID& id)
 {
-	SkeletalMeshComponent& meshComp = *m_skeletakMeshComponents.emplace_back(archetype.makeUniqueInstance<SkeletalMeshComponent>(owner, id));
+	SkeletalMeshComponent& meshComp = m_skeletakMeshComponents.Add(archetype.makeUniqueInstance<SkeletalMeshComponent>(owner, id));
 
 	if (GenerateSubMeshesInstances(meshComp))
-		SendToRenderSystem(m_skMeshCompInstances[&meshComp]);
+		SendToRenderSystem(meshComp);
 
 	return &meshComp;
 }
 
 void MeshSystem::RemoveSkMeshInstance(SkeletalMeshComponent& skMeshComp)
 {
-	auto it = std::find_if(m_skeletakMeshComponents.begin(), m_skeletakMeshComponents.end(), 
-		[&skMeshComp](std::unique_ptr<SkeletalMeshComponent>& skMesh) { return skMesh.get() == &skMeshComp; });
-
-	if (it == m_skeletakMeshComponents.end())
+	if (!m_skeletakMeshComponents.Contains(skMeshComp))
 	{
 		Logger::Error("MeshSystem - The skmesh component you tried to remove not exists");
 		return;
@@ -320,5 +421,17 @@ void MeshSystem::RemoveSkMeshInstance(SkeletalMeshComponent& skMeshComp)
 
 	// Erase skeletal component
 	DegenerateSubMeshesInstances(skMeshComp);
-	m_skeletakMeshComponents.erase(it);
+	m_skeletakMeshComponents.Erase(skMeshComp);
+}
+
+//	SCENE FUNCTIONS
+//	---------------
+
+void MeshSystem::RemoveSceneInstances(const HYGUID& sceneID)
+{
+	RemoveSceneSubMeshesInstances<MeshInstance>(m_meshCompInstances, m_meshInstancesFromMat, sceneID);
+	RemoveSceneSubMeshesInstances<SkeletalMeshInstance>(m_skMeshCompInstances, m_skeletalMeshInstancesFromMat, sceneID);
+
+	m_meshComponents.EraseIf([&sceneID](const MeshComponent& meshComp) { return meshComp.gameObject.GetSceneID() == sceneID; });
+	m_skeletakMeshComponents.EraseIf([&sceneID](const SkeletalMeshComponent& skMeshComp) { return skMeshComp.gameObject.GetSceneID() == sceneID; });
 }
\ No newline at end of file
@@ -36,6 +36,8 @@ void ParticleSystem::InitializeNewParticles()
 	// Call Start on behaviors added in game
 	m_startInitialize.Invoke();
 	m_startInitialize.ClearCallbacks();
+
+	m_pendingInitializes.clear();
 }
 
 const std::vector<std::unique_ptr<ParticleComponent>>& ParticleSystem::GetAllParticleComponents() const
@@ -97,8 +99,11 @@ ParticleComponent* ParticleSystem::AddParticleInstance(rfk::Class const& archety
 	if (m_shouldInitiateParticle)
 	{
 		m_addParticle = true;
-		m_awakeInitialize.AddCallback(&ParticleComponent::Awake, particleComp);
-		m_startInitialize.AddCallback(&ParticleComponent::Start, particleComp);
+
+		PendingInitialize& pending = m_pendingInitializes.emplace_back();
+		pending.sceneID = owner.GetSceneID();
+		pending.awakeID = m_awakeInitialize.AddCallback(&ParticleComponent::Awake, particleComp);
+		pending.startID = m_startInitialize.AddCallback(&ParticleComponent::Start, particleComp);
 	}
 
 	return &particleComp;
@@ -117,4 +122,34 @@ void ParticleSystem::RemoveParticleInstance(ParticleComponent& particleComp)
 
 	SystemManager::GetRenderSystem().Unregister(&particleComp);
 	m_particleComponents.erase(it);
-}
\ No newline at end of file
+}
+
+void ParticleSystem::RemoveSceneInstances(const HYGUID& sceneID)
+{
+	// Pending Awake/Start callbacks of the scene reference removed components, those of the other scenes are kept
+	std::erase_if(m_pendingInitializes, [this, &sceneID](const PendingInitialize& pending)
+	{
+		if (pending.sceneID != sceneID)
+			return false;
+
+		m_awakeInitialize.RemoveCallback(pending.awakeID);
+		m_startInitialize.RemoveCallback(pending.startID);
+		return true;
+	});
+	m_addParticle = m_addParticle && !m_pendingInitializes.empty();
+
+	std::vector<ParticleComponent*> removedComps;
+	for (auto& particleComp : m_particleComponents)
+	{
+		if (particleComp->gameObject.GetSceneID() == sceneID)
+			removedComps.emplace_back(particleComp.get());
+	}
+
+	if (removedComps.empty())
+		return;
+
+	SystemManager::GetRenderSystem().UnregisterMany(removedComps);
+
+	std::erase_if(m_particleComponents,
+		[&sceneID](std::unique_ptr<ParticleComponent>& particleComp) { return particleComp->gameObject.GetSceneID() == sceneID; });
+}
@@ -71,6 +71,7 @@ void SoundSystem::Update()
 	// Start emitters added in game then remove from event
 	m_eNewSoundStart.Invoke();
 	m_eNewSoundStart.ClearCallbacks();
+	m_pendingStarts.clear();
 
 	// Update emitters
 	for (auto& emitter : m_emitters)
@@ -140,7 +141,7 @@ SoundEmitter* SoundSystem::AddEmitterInstance(rfk::Class const& archetype, GameO
 	SoundEmitter& emitter = *m_emitters.emplace_back(archetype.makeUniqueInstance<SoundEmitter>(owner, id));
 
 	if (m_systemStarted)
-		m_eNewSoundStart.AddCallback(&SoundEmitter::Start, emitter);
+		m_pendingStarts.emplace_back(owner.GetSceneID(), m_eNewSoundStart.AddCallback(&SoundEmitter::Start, emitter));
 
 	return &emitter;
 }
@@ -192,4 +193,26 @@ void SoundSystem::RemoveListenerInstance(SoundListener& listener)
 		m_activeListener = nullptr;
 }
 
+void SoundSystem::RemoveSceneInstances(const HYGUID& sceneID)
+{
+	// Pending Start callbacks of the scene reference removed emitters, those of the other scenes are kept
+	std::erase_if(m_pendingStarts, [this, &sceneID](const std::pair<HYGUID, CallbackID>& pending)
+	{
+		if (pending.first != sceneID)
+			return false;
+
+		m_eNewSoundStart.RemoveCallback(pending.second);
+		return true;
+	});
+
+	std::erase_if(m_emitters,
+		[&sceneID](std::unique_ptr<SoundEmitter>& emitter) { return emitter->gameObject.GetSceneID() == sceneID; });
+
+	if (m_activeListener && m_activeListener->gameObject.GetSceneID() == sceneID)
+		m_activeListener = nullptr;
+
+	std::erase_if(m_listeners,
+		[&sceneID](std::unique_ptr<SoundListener>& listener) { return listener->gameObject.GetSceneID() == sceneID; });
+}
+
 #pragma endregion
\ No newline at end of file
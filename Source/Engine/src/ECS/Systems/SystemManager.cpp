@@ -26,6 +26,7 @@
 
 #include "Core/Time.hpp"
 #include "Core/Logger.hpp"
+#include "Core/SceneAllocator.hpp"
 
 struct PimplSystems
 {
@@ -73,6 +74,7 @@ void SystemManager::Stop()
 void SystemManager::FrameStart()
 {
 	m_pimpl->m_renderSystem.debugRenderPipeline.ClearPrimitives();
+	m_pimpl->m_renderSystem.UpdateUploads();
 }
 
 void SystemManager::PermanentUpdate()
@@ -119,6 +121,9 @@ void SystemManager::LateUpdate()
 
 Component* SystemManager::CreateComponent(rfk::Class const& compClass, GameObject& owner, const HYGUID& id)
 {
+	// Allocate the component in the pools of its owner scene
+	SceneAllocator::Scope allocatorScope(owner.GetSceneAllocator());
+
 	// Behaviors
 	if (Behavior::staticGetArchetype().isBaseOf(compClass))
 		return m_pimpl->m_behaviorSystem.AddBehaviorInstance(compClass, owner, id);
@@ -186,6 +191,24 @@ void SystemManager::DestroyComponent(Component& comp)
 	Logger::Error("SystemManager - Component '" + std::string(compClass.getName()) + "' is not attached to a system");
 }
 
+void SystemManager::DestroySceneComponents(const HYGUID& sceneID)
+{
+	// Behaviors
+	m_pimpl->m_behaviorSystem.RemoveSceneInstances(sceneID);
+
+	// Rendering components
+	m_pimpl->m_meshSystem.RemoveSceneInstances(sceneID);
+	m_pimpl->m_renderSystem.RemoveSceneLightInstances(sceneID);
+	m_pimpl->m_cameraSystem.RemoveSceneInstances(sceneID);
+	m_pimpl->m_particleSystem.RemoveSceneInstances(sceneID);
+
+	// Physic components
+	m_pimpl->m_physicsSystem.RemoveSceneInstances(sceneID);
+
+	// Sound components
+	m_pimpl->m_soundSystem.RemoveSceneInstances(sceneID);
+}
+
 BehaviorSystem& SystemManager::GetBehaviorSystem()
 {
 	return EngineContext::Instance().systemManager->m_pimpl->m_behaviorSystem;
@@ -11,6 +11,7 @@
 #include "Resources/Resource/Terrain.hpp"
 #include "Resources/Resource/Texture.hpp"
 #include "Resources/Resource/Mesh.hpp"
+#include "Resources/Loaders/MeshletBuilder.hpp"
 #include "Maths/Vector3.hpp"
 
 #include "EngineContext.hpp"
@@ -250,6 +251,13 @@ bool PhysicsSimulation::GenerateTerrain(Terrain* terrain)
 		}
 	}
 
+	// Meshlets culled out of the view and facing away, only the triangles are reordered : the terrain collider reads the vertices as a grid
+	if (mesh.indices.size() / 3 >= MeshletBuilder::MinTriangleCount)
+	{
+		MeshletBuilder::Build(mesh.indices, mesh.vertices, mesh.meshlets);
+		Logger::Info("Terrain meshlets - " + terrain->GetFilepath() + " : " + std::to_string(mesh.meshlets.size()) + " meshlets");
+	}
+
 	return true;
 }
 
@@ -268,6 +276,14 @@ void PhysicsSimulation::RemoveActorFromSimulation(PxActor& actor)
 	m_scene->removeActor(actor);
 }
 
+void PhysicsSimulation::RemoveActorsFromSimulation(PxActor* const* actors, PxU32 count)
+{
+	if (count == 0)
+		return;
+
+	m_scene->removeActors(actors, count);
+}
+
 bool PhysicsSimulation::Raycast(const Vector3& origin, const Vector3& unitDirection, float maxDistance, PxRaycastBuffer& outHit, PxU32 layerMask)
 {
 	//const PxHitFlags outputFlags = PxHitFlag::ePOSITION | PxHitFlag::eNORMAL;
@@ -258,4 +258,32 @@ void PhysicsSystem::RemoveRigidbodyInstance(Rigidbody& rigidbody)
 	}
 
 	m_rigidbodies.erase(it);
+}
+
+void PhysicsSystem::RemoveSceneInstances(const HYGUID& sceneID)
+{
+	// Gather simulated actors of the scene to remove them all at once
+	std::vector<PxActor*> pxActors;
+	for (auto& actor : m_actors)
+	{
+		if (actor->GetGameObject().GetSceneID() == sceneID && actor->GetRigidActor())
+			pxActors.emplace_back(actor->GetRigidActor());
+	}
+
+	if (!pxActors.empty())
+		m_simulation.RemoveActorsFromSimulation(pxActors.data(), static_cast<PxU32>(pxActors.size()));
+
+	std::erase_if(m_actors, [&sceneID](std::unique_ptr<PhysicsActor>& actor)
+	{
+		if (actor->GetGameObject().GetSceneID() != sceneID)
+			return false;
+
+		actor->RemoveFromSimulation();
+		return true;
+	});
+
+	std::erase_if(m_colliders,
+		[&sceneID](std::unique_ptr<Collider>& collider) { return collider->gameObject.GetSceneID() == sceneID; });
+	std::erase_if(m_rigidbodies,
+		[&sceneID](std::unique_ptr<Rigidbody>& rigidbody) { return rigidbody->gameObject.GetSceneID() == sceneID; });
 }
\ No newline at end of file
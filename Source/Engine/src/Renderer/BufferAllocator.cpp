@@ -0,0 +1,354 @@
+#include "Renderer/BufferAllocator.hpp"
+
+#include <bit>
+#include <algorithm>
+
+BufferAllocator::BufferAllocator(size_t capacity, size_t alignment)
+	: m_alignment(alignment > 0 ? alignment : 1)
+{
+	for (auto& lists : m_freeLists)
+		std::fill(std::begin(lists), std::end(lists), NoBlock);
+
+	Grow(capacity);
+}
+
+#pragma region BLOCKS
+
+void BufferAllocator::Mapping(size_t size, unsigned int& firstLevel, unsigned int& secondLevel) const
+{
+	// Small sizes are split linearly in the first class
+	if (size < SecondLevelCount)
+	{
+		firstLevel = 0;
+		secondLevel = static_cast<unsigned int>(size);
+		return;
+	}
+
+	const unsigned int power = static_cast<unsigned int>(std::bit_width(size)) - 1;
+	firstLevel = power - SecondLevelBits + 1;
+	secondLevel = static_cast<unsigned int>(size >> (power - SecondLevelBits)) - SecondLevelCount;
+}
+
+uint32_t BufferAllocator::CreateBlock(size_t offset, size_t size)
+{
+	uint32_t block;
+	if (!m_unusedBlocks.empty())
+	{
+		block = m_unusedBlocks.back();
+		m_unusedBlocks.pop_back();
+		m_blocks[block] = Block();
+	}
+	else
+	{
+		block = static_cast<uint32_t>(m_blocks.size());
+		m_blocks.emplace_back();
+	}
+
+	m_blocks[block].offset = offset;
+	m_blocks[block].size = size;
+	return block;
+}
+
+void BufferAllocator::DestroyBlock(uint32_t block)
+{
+	m_unusedBlocks.push_back(block);
+}
+
+void BufferAllocator::InsertFree(uint32_t block)
+{
+	unsigned int firstLevel, secondLevel;
+	Mapping(m_blocks[block].size, firstLevel, secondLevel);
+
+	Block& data = m_blocks[block];
+	data.free = true;
+	data.previousFree = NoBlock;
+	data.nextFree = m_freeLists[firstLevel][secondLevel];
+	if (data.nextFree != NoBlock)
+		m_blocks[data.nextFree].previousFree = block;
+
+	m_freeLists[firstLevel][secondLevel] = block;
+	m_secondLevelBitmaps[firstLevel] |= 1u << secondLevel;
+	m_firstLevelBitmap |= uint64_t(1) << firstLevel;
+}
+
+void BufferAllocator::RemoveFree(uint32_t block)
+{
+	unsigned int firstLevel, secondLevel;
+	Mapping(m_blocks[block].size, firstLevel, secondLevel);
+
+	Block& data = m_blocks[block];
+	if (data.previousFree != NoBlock)
+		m_blocks[data.previousFree].nextFree = data.nextFree;
+	else
+		m_freeLists[firstLevel][secondLevel] = data.nextFree;
+
+	if (data.nextFree != NoBlock)
+		m_blocks[data.nextFree].previousFree = data.previousFree;
+
+	data.free = false;
+	data.previousFree = NoBlock;
+	data.nextFree = NoBlock;
+
+	if (m_freeLists[firstLevel][secondLevel] == NoBlock)
+	{
+		m_secondLevelBitmaps[firstLevel] &= ~(1u << secondLevel);
+		if (m_secondLevelBitmaps[firstLevel] == 0)
+			m_firstLevelBitmap &= ~(uint64_t(1) << firstLevel);
+	}
+}
+
+uint32_t BufferAllocator::FindFree(size_t size) const
+{
+	// Round the size up to the next class, every block listed from there is large enough
+	size_t rounded = size;
+	if (size >= SecondLevelCount)
+	{
+		const unsigned int power = static_cast<unsigned int>(std::bit_width(size)) - 1;
+		rounded += (size_t(1) << (power - SecondLevelBits)) - 1;
+		if (rounded < size)
+			return NoBlock;
+	}
+
+	unsigned int firstLevel, secondLevel;
+	Mapping(rounded, firstLevel, secondLevel);
+	if (firstLevel >= FirstLevelCount)
+		return NoBlock;
+
+	// Class of this first level, or the smallest non empty first level above it
+	uint32_t secondLevelMap = m_secondLevelBitmaps[firstLevel] & (~0u << secondLevel);
+	if (secondLevelMap == 0)
+	{
+		const uint64_t firstLevelMap = firstLevel + 1 < 64 ? m_firstLevelBitmap & (~uint64_t(0) << (firstLevel + 1)) : 0;
+		if (firstLevelMap == 0)
+			return NoBlock;
+
+		firstLevel = static_cast<unsigned int>(std::countr_zero(firstLevelMap));
+		secondLevelMap = m_secondLevelBitmaps[firstLevel];
+	}
+
+	secondLevel = static_cast<unsigned int>(std::countr_zero(secondLevelMap));
+	return m_freeLists[firstLevel][secondLevel];
+}
+
+size_t BufferAllocator::Use(uint32_t block, size_t size)
+{
+	RemoveFree(block);
+
+	// The rest of the block stays free after the range
+	if (m_blocks[block].size > size)
+	{
+		const uint32_t rest = CreateBlock(m_blocks[block].offset + size, m_blocks[block].size - size);
+
+		Block& data = m_blocks[block];
+		m_blocks[rest].previousPhysical = block;
+		m_blocks[rest].nextPhysical = data.nextPhysical;
+		if (data.nextPhysical != NoBlock)
+			m_blocks[data.nextPhysical].previousPhysical = rest;
+		else
+			m_lastBlock = rest;
+
+		data.nextPhysical = rest;
+		data.size = size;
+		InsertFree(rest);
+	}
+
+	m_allocations[m_blocks[block].offset] = block;
+	m_usedSize += size;
+	return m_blocks[block].offset;
+}
+
+size_t BufferAllocator::Align(size_t size) const
+{
+	return (size + m_alignment - 1) / m_alignment * m_alignment;
+}
+
+#pragma endregion
+
+#pragma region ALLOCATIONS
+
+size_t BufferAllocator::Allocate(size_t size)
+{
+	if (size == 0)
+		return InvalidOffset;
+
+	const size_t alignedSize = Align(size);
+	const uint32_t block = FindFree(alignedSize);
+	if (block == NoBlock)
+		return InvalidOffset;
+
+	return Use(block, alignedSize);
+}
+
+bool BufferAllocator::Free(size_t offset)
+{
+	auto it = m_allocations.find(offset);
+	if (it == m_allocations.end())
+		return false;
+
+	uint32_t block = it->second;
+	m_allocations.erase(it);
+	m_usedSize -= m_blocks[block].size;
+
+	// Merge with the free block before
+	const uint32_t previous = m_blocks[block].previousPhysical;
+	if (previous != NoBlock && m_blocks[previous].free)
+	{
+		RemoveFree(previous);
+
+		m_blocks[previous].size += m_blocks[block].size;
+		m_blocks[previous].nextPhysical = m_blocks[block].nextPhysical;
+		if (m_blocks[block].nextPhysical != NoBlock)
+			m_blocks[m_blocks[block].nextPhysical].previousPhysical = previous;
+		else
+			m_lastBlock = previous;
+
+		DestroyBlock(block);
+		block = previous;
+	}
+
+	// And with the free block after
+	const uint32_t next = m_blocks[block].nextPhysical;
+	if (next != NoBlock && m_blocks[next].free)
+	{
+		RemoveFree(next);
+
+		m_blocks[block].size += m_blocks[next].size;
+		m_blocks[block].nextPhysical = m_blocks[next].nextPhysical;
+		if (m_blocks[next].nextPhysical != NoBlock)
+			m_blocks[m_blocks[next].nextPhysical].previousPhysical = block;
+		else
+			m_lastBlock = block;
+
+		DestroyBlock(next);
+	}
+
+	InsertFree(block);
+	m_compacted = false;
+	return true;
+}
+
+size_t BufferAllocator::GetSize(size_t offset) const
+{
+	auto it = m_allocations.find(offset);
+	return it != m_allocations.end() ? m_blocks[it->second].size : 0;
+}
+
+void BufferAllocator::Grow(size_t capacity)
+{
+	capacity = capacity / m_alignment * m_alignment;
+	if (capacity <= m_capacity)
+		return;
+
+	const size_t added = capacity - m_capacity;
+
+	// The free block at the end of the buffer is extended
+	if (m_lastBlock != NoBlock && m_blocks[m_lastBlock].free)
+	{
+		RemoveFree(m_lastBlock);
+		m_blocks[m_lastBlock].size += added;
+		InsertFree(m_lastBlock);
+	}
+	else
+	{
+		const uint32_t block = CreateBlock(m_capacity, added);
+		m_blocks[block].previousPhysical = m_lastBlock;
+		if (m_lastBlock != NoBlock)
+			m_blocks[m_lastBlock].nextPhysical = block;
+
+		m_lastBlock = block;
+		InsertFree(block);
+	}
+
+	m_capacity = capacity;
+}
+
+#pragma endregion
+
+#pragma region DEFRAGMENTATION
+
+bool BufferAllocator::PlanMove(Move& move, const std::function<bool(size_t offset)>& canMove)
+{
+	if (m_compacted || m_lastBlock == NoBlock)
+		return false;
+
+	// Free blocks from the start of the buffer, with the largest size up to each of them
+	std::vector<uint32_t> freeBlocks;
+	std::vector<size_t> largestSizes;
+
+	uint32_t first = m_lastBlock;
+	while (m_blocks[first].previousPhysical != NoBlock)
+		first = m_blocks[first].previousPhysical;
+
+	for (uint32_t block = first; block != NoBlock; block = m_blocks[block].nextPhysical)
+	{
+		if (!m_blocks[block].free)
+			continue;
+
+		freeBlocks.push_back(block);
+		largestSizes.push_back(std::max(m_blocks[block].size, largestSizes.empty() ? size_t(0) : largestSizes.back()));
+	}
+
+	// Highest ranges first, each one to the lowest free block holding it
+	bool skipped = false;
+	for (uint32_t block = m_lastBlock; block != NoBlock; block = m_blocks[block].previousPhysical)
+	{
+		const Block& data = m_blocks[block];
+		if (data.free)
+			continue;
+
+		const size_t index = std::lower_bound(largestSizes.begin(), largestSizes.end(), data.size) - largestSizes.begin();
+		if (index == freeBlocks.size() || m_blocks[freeBlocks[index]].offset > data.offset)
+			continue;
+
+		if (canMove && !canMove(data.offset))
+		{
+			skipped = true;
+			continue;
+		}
+
+		move.source = data.offset;
+		move.size = data.size;
+		move.destination = Use(freeBlocks[index], data.size);
+		return true;
+	}
+
+	// Ranges waiting to be movable are tried again
+	m_compacted = !skipped;
+	return false;
+}
+
+bool BufferAllocator::IsCompacted() const
+{
+	return m_compacted;
+}
+
+#pragma endregion
+
+BufferAllocator::Stats BufferAllocator::GetStats() const
+{
+	Stats stats;
+	stats.capacity = m_capacity;
+	stats.usedSize = m_usedSize;
+	stats.allocationCount = m_allocations.size();
+
+	for (uint32_t block = m_lastBlock; block != NoBlock; block = m_blocks[block].previousPhysical)
+	{
+		if (!m_blocks[block].free)
+			continue;
+
+		stats.freeRangeCount++;
+		stats.largestFreeRange = std::max(stats.largestFreeRange, m_blocks[block].size);
+	}
+
+	return stats;
+}
+
+size_t BufferAllocator::GetCapacity() const
+{
+	return m_capacity;
+}
+
+size_t BufferAllocator::GetAlignment() const
+{
+	return m_alignment;
+}
@@ -101,7 +101,7 @@ DebugRenderPipeline::~DebugRenderPipeline()
 }
 
 
-void DebugRenderPipeline::Initialize()
+void DebugRenderPipeline::GenerateShaders()
 {
 	//  Load Shader
 
@@ -109,6 +109,12 @@ void DebugRenderPipeline::Initialize()
 }
 
 
+void DebugRenderPipeline::Initialize()
+{
+	// The shader is linked on its first bind
+}
+
+
 void DebugRenderPipeline::Render()
 {
 	m_shader.Bind();
@@ -38,6 +38,15 @@ void GraphicsSettings::Save(nlohmann::json& jsonField)
 	jsonGraphics["maxExposure"] = maxExposure; 
 	jsonGraphics["constantExposure"] = constantExposure;
 	jsonGraphics["shadows"] = GPUSettings.shadows;
+	jsonGraphics["uploadBudgetPerFrame"] = uploadBudgetPerFrame;
+	jsonGraphics["meshDefragmentBudgetPerFrame"] = meshDefragmentBudgetPerFrame;
+	jsonGraphics["textureStreaming"] = textureStreaming;
+	jsonGraphics["textureStreamingBudgetMB"] = textureStreamingBudgetMB;
+	jsonGraphics["meshLOD"] = meshLOD;
+	jsonGraphics["meshLODPixelError"] = meshLODPixelError;
+	jsonGraphics["meshLODHysteresis"] = meshLODHysteresis;
+	jsonGraphics["meshLODCrossfade"] = meshLODCrossfade;
+	jsonGraphics["meshletCulling"] = meshletCulling;
 }
 
 void GraphicsSettings::Load(nlohmann::json& jsonField)
@@ -53,4 +62,13 @@ void GraphicsSettings::Load(nlohmann::json& jsonField)
 	Serialization::TryGetValue(jsonGraphics, "maxExposure", maxExposure);
 	Serialization::TryGetValue(jsonGraphics, "constantExposure", constantExposure);
 	Serialization::TryGetValue(jsonGraphics, "shadows", GPUSettings.shadows);
+	Serialization::TryGetValue(jsonGraphics, "uploadBudgetPerFrame", uploadBudgetPerFrame);
+	Serialization::TryGetValue(jsonGraphics, "meshDefragmentBudgetPerFrame", meshDefragmentBudgetPerFrame);
+	Serialization::TryGetValue(jsonGraphics, "textureStreaming", textureStreaming);
+	Serialization::TryGetValue(jsonGraphics, "textureStreamingBudgetMB", textureStreamingBudgetMB);
+	Serialization::TryGetValue(jsonGraphics, "meshLOD", meshLOD);
+	Serialization::TryGetValue(jsonGraphics, "meshLODPixelError", meshLODPixelError);
+	Serialization::TryGetValue(jsonGraphics, "meshLODHysteresis", meshLODHysteresis);
+	Serialization::TryGetValue(jsonGraphics, "meshLODCrossfade", meshLODCrossfade);
+	Serialization::TryGetValue(jsonGraphics, "meshletCulling", meshletCulling);
 }
\ No newline at end of file
@@ -0,0 +1,91 @@
+#include "Renderer/MeshLODSelector.hpp"
+
+#include <algorithm>
+
+uint32_t MeshLODSelector::SelectLOD(std::span<const MeshLOD> lods, float radiusPixels, uint32_t current, const Settings& settings)
+{
+	if (!settings.enabled || lods.size() < 2)
+		return 0;
+
+	auto screenError = [&](uint32_t level) {
+		return lods[level].error * radiusPixels;
+	};
+
+	uint32_t lod = std::min(current, static_cast<uint32_t>(lods.size() - 1));
+
+	// Finer levels while the current one is visibly wrong
+	while (lod > 0 && screenError(lod) > settings.maxPixelError)
+		lod--;
+
+	// Coarser levels once they are well under the limit
+	const float coarserLimit = settings.maxPixelError * (1.f - settings.hysteresis);
+	while (lod + 1 < lods.size() && screenError(lod + 1) <= coarserLimit)
+		lod++;
+
+	return lod;
+}
+
+void MeshLODSelector::Update(MeshLODState& state, uint32_t target, float deltaTime, const Settings& settings)
+{
+	if (!settings.crossfade || settings.crossfadeDuration <= 0.f)
+	{
+		state.lod = target;
+		state.previousLod = target;
+		state.fade = 1.f;
+		return;
+	}
+
+	if (state.fade < 1.f)
+	{
+		state.fade = std::min(state.fade + deltaTime / settings.crossfadeDuration, 1.f);
+		if (state.fade >= 1.f)
+			state.previousLod = state.lod;
+		return;
+	}
+
+	if (target == state.lod)
+		return;
+
+	state.previousLod = state.lod;
+	state.lod = target;
+	state.fade = std::min(deltaTime / settings.crossfadeDuration, 1.f);
+	if (state.fade >= 1.f)
+		state.previousLod = state.lod;
+}
+
+size_t MeshLODSelector::GetDraws(const MeshLODState& state, MeshLODDraw (&draws)[2])
+{
+	if (state.fade >= 1.f || state.previousLod == state.lod)
+	{
+		draws[0] = { state.lod, 1.f, 0.f };
+		return 1;
+	}
+
+	// Both levels dither with complementary patterns, every pixel is covered by one of them
+	draws[0] = { state.lod, state.fade, 1.f };
+	draws[1] = { state.previousLod, state.fade, -1.f };
+	return 2;
+}
+
+MeshLODState& MeshLODSelector::GetViewState(std::vector<ViewLODState>& views, const Camera& camera, uint64_t renderCount)
+{
+	for (ViewLODState& view : views)
+	{
+		if (view.camera != &camera) continue;
+
+		view.lastRender = renderCount;
+		return view.state;
+	}
+
+	if (views.size() >= MaxViewStates)
+	{
+		auto oldest = std::min_element(views.begin(), views.end(),
+			[](const ViewLODState& lhs, const ViewLODState& rhs) { return lhs.lastRender < rhs.lastRender; });
+		views.erase(oldest);
+	}
+
+	ViewLODState& view = views.emplace_back();
+	view.camera = &camera;
+	view.lastRender = renderCount;
+	return view.state;
+}
@@ -19,10 +19,10 @@ static const char* PBRVertexShaderStr = R"GLSL(
 
 // Attributes
 
-layout(location = 0) in vec3 aPosition;
+layout(location = 0) in vec4 aPosition;    // w : bitangent sign of the packed layouts
 layout(location = 1) in vec2 aUV;
-layout(location = 2) in vec3 aNormal;
-layout(location = 3) in vec3 aTangent;
+layout(location = 2) in vec3 aNormal;      // xy : octahedral normal of the packed layouts
+layout(location = 3) in vec3 aTangent;     // xy : octahedral tangent of the packed layouts
 
 //  Uniform Buffers
 
@@ -38,6 +38,12 @@ layout (std140, binding = 0) uniform UBO_camera
 uniform mat4 uModel;
 uniform mat4 uModelNormalMatrix;
 
+//  VERTEX DECODING :
+//    position offset     |  packed normal and tangent
+//    position scale      |           ...
+
+uniform vec4 uVertexDecode[2];
+
 //  PACKED MAT 01 :
 //        Xoffset         |      Yoffset     |      Utiling     
 //        Vtiling         | emissiveStrength |    useDiffuse    
@@ -58,27 +64,41 @@ out VS_OUT
 
 //  Functions
 
-mat3 ComputeTBN()
+vec3 DecodeOctahedral(vec2 e)
 {
-    vec3 T = normalize(mat3(uModel) * aTangent);
-    vec3 N =  normalize(mat3(uModel)* aNormal);
+    vec3 v = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    if (v.z < 0.0)
+        v.xy = (1.0 - abs(v.yx)) * vec2(v.x >= 0.0 ? 1.0 : -1.0, v.y >= 0.0 ? 1.0 : -1.0);
+
+    return normalize(v);
+}
+
+mat3 ComputeTBN(vec3 normal, vec3 tangent, float bitangentSign)
+{
+    vec3 T = normalize(mat3(uModel) * tangent);
+    vec3 N =  normalize(mat3(uModel)* normal);
     T = normalize(T - dot(T, N) * N);
-    vec3 B = cross(N, T);
+    vec3 B = cross(N, T) * bitangentSign;
 
     return mat3(T, B, N); 
 }
 
 void main()
 {
-    vec4 pos4 = uModel * vec4(aPosition, 1.0);
+    bool packedVertex = uVertexDecode[0].w > 0.5;
+    vec3 position = uVertexDecode[0].xyz + aPosition.xyz * uVertexDecode[1].xyz;
+    vec3 normal   = packedVertex ? DecodeOctahedral(aNormal.xy) : aNormal;
+    vec3 tangent  = packedVertex ? DecodeOctahedral(aTangent.xy) : aTangent;
+
+    vec4 pos4 = uModel * vec4(position, 1.0);
 
     vec2 offset = uPackedMat01[0].xy;
     vec2 tiling = vec2(uPackedMat01[0][2],uPackedMat01[1][0]);
     vs_out.uv = offset + aUV * tiling;
 
     vs_out.pos    = pos4.xyz / pos4.w;
-    vs_out.normal = normalize(vec3(uModelNormalMatrix * vec4(aNormal, 0.0)));
-    vs_out.TBN    = ComputeTBN();
+    vs_out.normal = normalize(vec3(uModelNormalMatrix * vec4(normal, 0.0)));
+    vs_out.TBN    = ComputeTBN(normal, tangent, aPosition.w < 0.0 ? -1.0 : 1.0);
 
     gl_Position   = uProjection * uView * pos4;
 })GLSL";
@@ -282,6 +302,11 @@ uniform mat3 uPackedMat01;
 
 uniform mat3 uPackedMat02;
 
+//  LOD CROSSFADE :
+//    coverage of the level fading in    |    1 : fading in, -1 : fading out, 0 : opaque
+
+uniform vec2 uDitherFade;
+
 //  Global variables
 
 int    cascadeCount = 4;
@@ -553,8 +578,22 @@ vec4 GetTexturePixel(in sampler2D text, in vec2 uv, in float isUsed, in float is
     return isDefaultWhite * (1.0 - isUsed) + isUsed * texture(text, uv);
 }
 
+//  The level fading in keeps the pixels under its coverage in a 4x4 Bayer pattern, the level fading out keeps the others
+void DitherLODFade()
+{
+    if (uDitherFade.y == 0.0) return;
+
+    const float bayer[16] = float[16](0.0, 8.0, 2.0, 10.0, 12.0, 4.0, 14.0, 6.0, 3.0, 11.0, 1.0, 9.0, 15.0, 7.0, 13.0, 5.0);
+    ivec2 pixel = ivec2(gl_FragCoord.xy) & 3;
+    float threshold = (bayer[pixel.y * 4 + pixel.x] + 0.5) / 16.0;
+
+    if ((threshold < uDitherFade.x) != (uDitherFade.y > 0.0)) discard;
+}
+
 void main()
 {
+    DitherLODFade();
+
     bool useMaskTexture = uPackedMat01[2][2] == 1.0;
     if(useMaskTexture)
     {
@@ -566,7 +605,10 @@ void main()
     float useNormalTexture    = uPackedMat01[2][0];
     float useEmissiveTexture  = uPackedMat01[2][1];
 
-    Normal = (1.0 - useNormalTexture) * fs_in.normal + useNormalTexture * normalize(fs_in.TBN * normalize(texture(uNormalTexture, fs_in.uv).rgb * 2.0 - 1.0));
+    //  Z is rebuilt from XY, BC5 normal maps only store two channels
+    vec2 normalXY = texture(uNormalTexture, fs_in.uv).rg * 2.0 - 1.0;
+    vec3 normalTS = vec3(normalXY, sqrt(max(1.0 - dot(normalXY, normalXY), 0.0)));
+    Normal = (1.0 - useNormalTexture) * fs_in.normal + useNormalTexture * normalize(fs_in.TBN * normalTS);
 
     vec4 diffuseColor  = uMatColors[0];
     vec3 ambientColor  = uMatColors[1].xyz;
@@ -626,11 +668,14 @@ void main()
 
 #pragma endregion
 
-void MeshPBRShader::Initialize()
+void MeshPBRShader::GenerateShaders()
 {
     m_meshShader.Generate(PBRVertexShaderStr, PBRFragmentShaderStr);
     m_skeletalMeshShader.Generate(skeletalPBRVertexShaderStr, PBRFragmentShaderStr);
+}
 
+void MeshPBRShader::Initialize()
+{
     glUseProgram(m_meshShader.GetID());
     glUniform1i(glGetUniformLocation(m_meshShader.GetID(), "uDiffuseTexture"), 0);
     glUniform1i(glGetUniformLocation(m_meshShader.GetID(), "uNormalTexture"), 1);
@@ -644,6 +689,8 @@ void MeshPBRShader::Initialize()
     m_meshLocations.packedMat1      = m_meshShader.GetLocationFromUniformName("uPackedMat01");
     m_meshLocations.packedMat2      = m_meshShader.GetLocationFromUniformName("uPackedMat02");
     m_meshLocations.matModel        = m_meshShader.GetLocationFromUniformName("uModel");
+    m_meshLocations.vertexDecode    = m_meshShader.GetLocationFromUniformName("uVertexDecode[0]");
+    m_meshLocations.ditherFade      = m_meshShader.GetLocationFromUniformName("uDitherFade");
     m_meshLocations.matModelNormal  = m_meshShader.GetLocationFromUniformName("uModelNormalMatrix");
 
     glUseProgram(m_skeletalMeshShader.GetID());
@@ -731,10 +778,15 @@ void MeshPBRShader::SendMaterialDatas(MaterialData& material, PBRUniformsLocatio
 }
 
 
-void MeshPBRShader::DrawMesh(const Matrix4& model, const MeshData& mesh, const MaterialData* material) const
+void MeshPBRShader::DrawMesh(const Matrix4& model, const MeshData& mesh, const MaterialData* material, const MeshLODDraw& lod) const
 {
+    // Vertices still waiting in the upload queue
+    if (mesh.GPUData == nullptr || mesh.GPUData->uploadTicket != 0) return;
+
     Matrix4 normalMatrix = Matrix4::Transpose(Matrix4::Inverse(model));
     glUniformMatrix4fv(m_meshLocations.matModel, 1, GL_FALSE, model.elements);
+    RenderGPUWrapper::SendVertexDecoding(m_meshLocations.vertexDecode, *mesh.GPUData);
+    glUniform2f(m_meshLocations.ditherFade, lod.fade, lod.fadeDirection);
     glUniformMatrix4fv(m_meshLocations.matModelNormal, 1, GL_FALSE, normalMatrix.elements);
 
     const MaterialData* mat = material ? material : m_defaultMat;
@@ -743,13 +795,7 @@ void MeshPBRShader::DrawMesh(const Matrix4& model, const MeshData& mesh, const M
         SendMaterialDatas(const_cast<MaterialData&>(*mat), m_meshLocations);
     }
 
-    glDrawElementsBaseVertex(
-        GL_TRIANGLES,
-        static_cast<GLsizei>(mesh.indices.size()),
-        GL_UNSIGNED_INT,
-        mesh.indices.data(),
-        mesh.GPUData->offset
-    );
+    RenderGPUWrapper::DrawElements(mesh, lod);
 
     glBindTextureUnit(0, 0);
     glBindTextureUnit(1, 0);
@@ -774,13 +820,7 @@ void MeshPBRShader::DrawSkeletalMesh(const Matrix4& model, const MeshData& mesh,
         SendMaterialDatas(const_cast<MaterialData&>(*mat), m_skMeshLocations);
     }
 
-    glDrawElementsBaseVertex(
-        GL_TRIANGLES,
-        static_cast<GLsizei>(mesh.indices.size()),
-        GL_UNSIGNED_INT,
-        mesh.indices.data(),
-        mesh.GPUData->offset
-    );
+    RenderGPUWrapper::DrawElements(mesh);
 
     glBindTextureUnit(0, 0);
     glBindTextureUnit(1, 0);
@@ -10,6 +10,24 @@
 #include "Resources/Resource/Material.hpp"
 #include "EngineContext.hpp"
 
+namespace
+{
+    /**
+    @brief Get the draws of an instance, the finest level draws the meshlets left after culling when they were culled this frame
+    */
+    size_t GetInstanceDraws(const MeshInstance& instance, MeshLODDraw (&draws)[2])
+    {
+        const size_t drawCount = MeshLODSelector::GetDraws(instance.lodState, draws);
+        for (size_t i = 0; i < drawCount; ++i)
+        {
+            if (draws[i].lod == 0 && instance.meshletBatch.active)
+                draws[i].meshlets = &instance.meshletBatch;
+        }
+
+        return drawCount;
+    }
+}
+
 
 MeshShader::MeshShader()
 {
@@ -38,7 +56,10 @@ void MeshShader::UnbindShader() const
 
 void MeshShader::ClearMeshInstances()
 {
-    m_meshInstances.clear();
+    for (MeshInstance* instance : m_meshInstances)
+        instance->savedPipeline = nullptr;
+
+    m_meshInstances.Clear();
 }
 
 
@@ -46,62 +67,49 @@ void MeshShader::AddMeshInstance(MeshInstance* instance)
 {
     if (instance == nullptr) return;
 
-    auto foundComp = std::find(m_meshInstances.begin(), m_meshInstances.end(), instance);
-
-    if (foundComp != m_meshInstances.end())
+    if (!m_meshInstances.Add(instance))
     {
         Logger::Warning("MeshShader - Can't register one mesh component instance multiple times");
         return;
     }
 
     instance->savedPipeline = this;
-    m_meshInstances.emplace_back(instance);
 }
 
 
 void MeshShader::RemoveMeshInstance(MeshInstance* instance)
 {
-    if (instance == nullptr || m_meshInstances.empty()) return;
-
-    auto foundComp = std::find(m_meshInstances.begin(), m_meshInstances.end(), instance);
-
-    if (foundComp == m_meshInstances.end())
+    if (!m_meshInstances.Remove(instance))
     {
         return;
     }
 
     instance->savedPipeline = nullptr;
-    m_meshInstances.erase(foundComp);
 }
 
 
 void MeshShader::AddSkeletalMeshInstance(SkeletalMeshInstance* instance)
 {
-    auto foundComp = std::find(m_skeletalMeshInstances.begin(), m_skeletalMeshInstances.end(), instance);
+    if (instance == nullptr) return;
 
-    if (foundComp != m_skeletalMeshInstances.end())
+    if (!m_skeletalMeshInstances.Add(instance))
     {
         Logger::Warning("MeshShader - Can't register mesh components multiple times");
         return;
     }
 
     instance->savedPipeline = this;
-    m_skeletalMeshInstances.emplace_back(instance);
 }
 
 
 void MeshShader::RemoveSkeletalMeshInstance(SkeletalMeshInstance* instance)
 {
-    auto foundComp = std::find(m_skeletalMeshInstances.begin(), m_skeletalMeshInstances.end(), instance);
-
-    if (foundComp == m_skeletalMeshInstances.end())
+    if (!m_skeletalMeshInstances.Remove(instance))
     {
-        Logger::Error("MeshShader - Failed to unregister a non-existing mesh component");
         return;
     }
 
     instance->savedPipeline = nullptr;
-    m_skeletalMeshInstances.erase(foundComp);
 }
 
 void MeshShader::RenderSingleInstance(const MeshInstance* instance) const
@@ -114,12 +122,19 @@ void MeshShader::RenderSingleInstance(const MeshInstance* instance) const
 
     RenderSystem& render = SystemManager::GetRenderSystem();
 
+    if (!mesh.GPUData) return;
+
+    const VertexArray& vao = render.GPUWrapper.GetMeshVAO(mesh.GPUData->layout);
+
     BindMeshShader();
-    render.GPUWrapper.meshVAO.Bind();
-    
-    DrawMesh(model, mesh, mat);
+    vao.Bind();
 
-    render.GPUWrapper.meshVAO.Unbind();
+    MeshLODDraw draws[2];
+    const size_t drawCount = GetInstanceDraws(*instance, draws);
+    for (size_t i = 0; i < drawCount; ++i)
+        DrawMesh(model, mesh, mat, draws[i]);
+
+    vao.Unbind();
     UnbindShader();
 }
 
@@ -149,17 +164,25 @@ void MeshShader::Render()
     RenderSystem& render = SystemManager::GetRenderSystem();
 
     m_meshShader.Bind();
-    render.GPUWrapper.meshVAO.Bind();
+
+    // Instances are drawn with the vertex array of their vertex layout
+    const VertexArray* boundVAO = nullptr;
 
     for (const MeshInstance* instance : m_meshInstances)
     {
-        if (!instance->mesh || !instance->isActive) continue;
+        if (!instance->mesh || !instance->isActive || !instance->mesh->GPUData) continue;
 
         Matrix4 model = instance->transform ? instance->transform->GetWorldMatrix() : Matrix4::Identity;
         MeshData& mesh = *instance->mesh;
         MaterialData* mat = instance->material ? &instance->material->data : nullptr;
 
-        DrawMesh(model, mesh, mat);
+        render.GPUWrapper.BindMeshVAO(*mesh.GPUData, boundVAO);
+
+        // Two draws while the instance crossfades between levels of detail
+        MeshLODDraw draws[2];
+        const size_t drawCount = GetInstanceDraws(*instance, draws);
+        for (size_t i = 0; i < drawCount; ++i)
+            DrawMesh(model, mesh, mat, draws[i]);
     }
 
     m_skeletalMeshShader.Bind();
@@ -18,7 +18,7 @@ static const char* unlitVertexShaderStr = R"GLSL(
 
 // Attributes
 
-layout(location = 0) in vec3 aPosition;
+layout(location = 0) in vec4 aPosition;
 layout(location = 1) in vec2 aUV;
 
 //  Uniform Buffers
@@ -34,6 +34,12 @@ layout (std140, binding = 0) uniform UBO_matrices
 
 uniform mat4 uModel;
 
+//  VERTEX DECODING :
+//    position offset     |       ...
+//    position scale      |       ...
+
+uniform vec4 uVertexDecode[2];
+
 //  PACKED MAT :
 //        Xoffset         |      Yoffset     |      Utiling      |      Vtiling      
 //       Rdiffuse         |     Gdiffuse     |     Bdiffuse      |     Adiffuse      
@@ -58,7 +64,7 @@ void main()
     vec2 tiling = uPackedMat[0].zw;
     vs_out.uv = offset + aUV * tiling;
 
-    gl_Position = uProjection * uView * uModel * vec4(aPosition, 1.0);
+    gl_Position = uProjection * uView * uModel * vec4(uVertexDecode[0].xyz + aPosition.xyz * uVertexDecode[1].xyz, 1.0);
 })GLSL";
 
 
@@ -162,6 +168,11 @@ uniform sampler2D uMaskTexture;
 
 uniform mat4 uPackedMat;
 
+//  LOD CROSSFADE :
+//    coverage of the level fading in    |    1 : fading in, -1 : fading out, 0 : opaque
+
+uniform vec2 uDitherFade;
+
 //  Functions
 
 vec4 GetTexturePixel(in sampler2D text, in vec2 uv, in float isUsed, in float isDefaultWhite)
@@ -169,8 +180,22 @@ vec4 GetTexturePixel(in sampler2D text, in vec2 uv, in float isUsed, in float is
     return isDefaultWhite * (1.0 - isUsed) + isUsed * texture(text, uv);
 }
 
+//  The level fading in keeps the pixels under its coverage in a 4x4 Bayer pattern, the level fading out keeps the others
+void DitherLODFade()
+{
+    if (uDitherFade.y == 0.0) return;
+
+    const float bayer[16] = float[16](0.0, 8.0, 2.0, 10.0, 12.0, 4.0, 14.0, 6.0, 3.0, 11.0, 1.0, 9.0, 15.0, 7.0, 13.0, 5.0);
+    ivec2 pixel = ivec2(gl_FragCoord.xy) & 3;
+    float threshold = (bayer[pixel.y * 4 + pixel.x] + 0.5) / 16.0;
+
+    if ((threshold < uDitherFade.x) != (uDitherFade.y > 0.0)) discard;
+}
+
 void main()
 {
+    DitherLODFade();
+
     bool useMaskTexture = uPackedMat[3][3] == 1.0;
     if(useMaskTexture)
     {
@@ -198,13 +223,14 @@ void main()
 #pragma endregion
 
 
-void MeshUnlitShader::Initialize()
+void MeshUnlitShader::GenerateShaders()
 {
-    //  Load Shader
-
     m_meshShader.Generate(unlitVertexShaderStr, unlitFragmentShaderStr);
     m_skeletalMeshShader.Generate(skeletalUnlitVertexShaderStr, unlitFragmentShaderStr);
+}
 
+void MeshUnlitShader::Initialize()
+{
     glUseProgram(m_meshShader.GetID());
     glUniform1i(glGetUniformLocation(m_meshShader.GetID(), "uDiffuseTexture"), 0);
     glUniform1i(glGetUniformLocation(m_meshShader.GetID(), "uEmissiveTexture"), 1);
@@ -212,6 +238,8 @@ void MeshUnlitShader::Initialize()
 
     m_meshLocations.packedMat1 = m_meshShader.GetLocationFromUniformName("uPackedMat");
     m_meshLocations.matModel = m_meshShader.GetLocationFromUniformName("uModel");
+    m_meshLocations.vertexDecode = m_meshShader.GetLocationFromUniformName("uVertexDecode[0]");
+    m_meshLocations.ditherFade = m_meshShader.GetLocationFromUniformName("uDitherFade");
 
     glUseProgram(m_skeletalMeshShader.GetID());
     glUniform1i(glGetUniformLocation(m_skeletalMeshShader.GetID(), "uDiffuseTexture"), 0);
@@ -259,9 +287,14 @@ void MeshUnlitShader::SendMaterialDatas(MaterialData& material, PBRUniformsLocat
 }
 
 
-void MeshUnlitShader::DrawMesh(const Matrix4& model, const MeshData& mesh, const MaterialData* material) const
+void MeshUnlitShader::DrawMesh(const Matrix4& model, const MeshData& mesh, const MaterialData* material, const MeshLODDraw& lod) const
 {
+    // Vertices still waiting in the upload queue
+    if (mesh.GPUData == nullptr || mesh.GPUData->uploadTicket != 0) return;
+
     glUniformMatrix4fv(m_meshLocations.matModel, 1, GL_FALSE, model.elements);
+    RenderGPUWrapper::SendVertexDecoding(m_meshLocations.vertexDecode, *mesh.GPUData);
+    glUniform2f(m_meshLocations.ditherFade, lod.fade, lod.fadeDirection);
 
     const MaterialData* mat = material ? material : m_defaultMat;
     if (mat)
@@ -269,13 +302,7 @@ void MeshUnlitShader::DrawMesh(const Matrix4& model, const MeshData& mesh, const
         SendMaterialDatas(const_cast<MaterialData&>(*mat), m_meshLocations);
     }
 
-    glDrawElementsBaseVertex(
-        GL_TRIANGLES,
-        static_cast<GLsizei>(mesh.indices.size()),
-        GL_UNSIGNED_INT,
-        mesh.indices.data(),
-        mesh.GPUData->offset
-    );
+    RenderGPUWrapper::DrawElements(mesh, lod);
 
     glBindTextureUnit(0, 0);
     glBindTextureUnit(1, 0);
@@ -293,13 +320,7 @@ void MeshUnlitShader::DrawSkeletalMesh(const Matrix4& model, const MeshData& mes
         SendMaterialDatas(const_cast<MaterialData&>(*mat), m_skMeshLocations);
     }
 
-    glDrawElementsBaseVertex(
-        GL_TRIANGLES,
-        static_cast<GLsizei>(mesh.indices.size()),
-        GL_UNSIGNED_INT,
-        mesh.indices.data(),
-        mesh.GPUData->offset
-    );
+    RenderGPUWrapper::DrawElements(mesh);
 
     glBindTextureUnit(0, 0);
     glBindTextureUnit(1, 0);
@@ -0,0 +1,98 @@
+#include "Renderer/MeshletCuller.hpp"
+
+#include <cmath>
+
+void MeshletBatch::Clear()
+{
+	firstIndices.clear();
+	indexCounts.clear();
+	active = false;
+}
+
+MeshletCuller::Frustum MeshletCuller::ExtractFrustum(const Matrix4& modelViewProjection)
+{
+	// Rows of the column major matrix (Gribb and Hartmann)
+	auto row = [&](int r) {
+		return Vector4(modelViewProjection.columns[0][r], modelViewProjection.columns[1][r],
+			modelViewProjection.columns[2][r], modelViewProjection.columns[3][r]);
+	};
+
+	const Vector4 x = row(0);
+	const Vector4 y = row(1);
+	const Vector4 z = row(2);
+	const Vector4 w = row(3);
+
+	Frustum frustum;
+	frustum.planes[0] = w + x;	// Left
+	frustum.planes[1] = w - x;	// Right
+	frustum.planes[2] = w + y;	// Bottom
+	frustum.planes[3] = w - y;	// Top
+	frustum.planes[4] = w + z;	// Near
+	frustum.planes[5] = w - z;	// Far
+
+	for (Vector4& plane : frustum.planes)
+	{
+		const float length = plane.xyz.Magnitude();
+		if (length > 0.f)
+			plane = plane / length;
+	}
+
+	return frustum;
+}
+
+bool MeshletCuller::IsOutsideFrustum(const Meshlet& meshlet, const Frustum& frustum)
+{
+	for (const Vector4& plane : frustum.planes)
+	{
+		if (Vector3::DotProduct(plane.xyz, meshlet.center) + plane.w < -meshlet.radius)
+			return true;
+	}
+
+	return false;
+}
+
+bool MeshletCuller::IsBackFacing(const Meshlet& meshlet, const Vector3& cameraPosition)
+{
+	// The camera is in the cone the normals all point away from, widened by the bounding sphere
+	const Vector3 toCenter = meshlet.center - cameraPosition;
+	return Vector3::DotProduct(toCenter, meshlet.coneAxis) >= meshlet.coneCutoff * toCenter.Magnitude() + meshlet.radius;
+}
+
+void MeshletCuller::Cull(std::span<const Meshlet> meshlets, const Frustum& frustum, const Vector3& cameraPosition, MeshletBatch& batch,
+	MeshletCullingStats* stats)
+{
+	batch.firstIndices.clear();
+	batch.indexCounts.clear();
+	batch.active = true;
+
+	for (const Meshlet& meshlet : meshlets)
+	{
+		const bool outside = IsOutsideFrustum(meshlet, frustum);
+		const bool backFacing = !outside && IsBackFacing(meshlet, cameraPosition);
+
+		if (stats)
+		{
+			stats->meshletCount++;
+			stats->triangleCount += meshlet.indexCount / 3;
+			stats->frustumCulled += outside ? 1 : 0;
+			stats->coneCulled += backFacing ? 1 : 0;
+			stats->culledTriangles += outside || backFacing ? meshlet.indexCount / 3 : 0;
+		}
+
+		if (outside || backFacing)
+			continue;
+
+		// Meshlets are stored one after the other, neighbours left are drawn as one range
+		if (!batch.firstIndices.empty() && batch.firstIndices.back() + static_cast<uint32_t>(batch.indexCounts.back()) == meshlet.indexOffset)
+		{
+			batch.indexCounts.back() += static_cast<int32_t>(meshlet.indexCount);
+			continue;
+		}
+
+		batch.firstIndices.push_back(meshlet.indexOffset);
+		batch.indexCounts.push_back(static_cast<int32_t>(meshlet.indexCount));
+	}
+
+	if (stats)
+		stats->drawCount += batch.firstIndices.size();
+}
@@ -81,7 +81,7 @@ void OpaqueRenderPipeline::AddSkeletalMeshInstance(SkeletalMeshInstance* instanc
 
 void OpaqueRenderPipeline::RemoveSkeletalMeshInstance(SkeletalMeshInstance* instance)
 {
-    if(instance->savedPipeline) instance->savedPipeline->RemoveMeshInstance(instance);
+    if(instance->savedPipeline) instance->savedPipeline->RemoveSkeletalMeshInstance(instance);
 
     unlitShader->RemoveSkeletalMeshInstance(instance);
 }
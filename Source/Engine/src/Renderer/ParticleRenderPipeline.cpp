@@ -1,5 +1,7 @@
 #include "Renderer/ParticleRenderPipeline.hpp"
 
+#include <unordered_set>
+
 #include <glad/gl.h>
 
 #include "Core/Logger.hpp"
@@ -156,10 +158,13 @@ ParticleRenderPipeline::ParticleRenderPipeline()
 {
 }
 
-void ParticleRenderPipeline::Initialize()
+void ParticleRenderPipeline::GenerateShaders()
 {
     m_shader.Generate(particleVertexShaderStr, particleFragmentShaderStr);
+}
 
+void ParticleRenderPipeline::Initialize()
+{
     GLuint vao = m_VAO.GetID();
 
     {
@@ -270,6 +275,17 @@ void ParticleRenderPipeline::RemoveParticleInstance(ParticleComponent* particleC
     m_particleComponents.erase(foundComp);
 }
 
+
+void ParticleRenderPipeline::RemoveParticleInstances(std::span<ParticleComponent* const> particleComponents)
+{
+    if (particleComponents.empty() || m_particleComponents.empty()) return;
+
+    const std::unordered_set<ParticleComponent*> toRemove(particleComponents.begin(), particleComponents.end());
+
+    std::erase_if(m_particleComponents,
+        [&toRemove](ParticleComponent* particleComponent) { return toRemove.contains(particleComponent); });
+}
+
 typedef struct {
     unsigned int vertexCount;
     unsigned int instanceCount;
@@ -153,6 +153,12 @@ void PostProcess::Initialize()
 	GLint previousFramebuffer;
 	glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousFramebuffer);
 
+	//	The four programs are submitted before the first one is bound, the driver links them together
+	m_hdrShader.Generate(postProcessDefaultVertexShaderStr, hdrFragmentShader);
+	m_luminanceShader.Generate(postProcessDefaultVertexShaderStr, luminanceFragmentShader);
+	m_blurShader.Generate(postProcessDefaultVertexShaderStr, bloomBlurFragmentShaderStr);
+	m_finalShader.Generate(postProcessDefaultVertexShaderStr, bloomFragmentShader);
+
 	//	Set up a special frame buffer for the post process so we don't use the common FrameBuffer class
 	InitializeCaptureProcess();
 	InitializeLuminanceProcess();
@@ -167,8 +173,6 @@ void PostProcess::InitializeCaptureProcess()
 {
 	//	Shaders initializations
 
-	m_hdrShader.Generate(postProcessDefaultVertexShaderStr, hdrFragmentShader);
-
 	m_hdrShader.Bind();
 	glUniform1i(glGetUniformLocation(m_hdrShader.GetID(), "uScreenTexture"), 0);
 
@@ -233,7 +237,6 @@ void PostProcess::InitializeCaptureProcess()
 
 void PostProcess::InitializeLuminanceProcess()
 {
-	m_luminanceShader.Generate(postProcessDefaultVertexShaderStr, luminanceFragmentShader);
 	m_luminanceShader.Bind();
 
 	glUniform1i(glGetUniformLocation(m_luminanceShader.GetID(), "uScreenTexture"), 0);
@@ -277,9 +280,6 @@ void PostProcess::InitializeBloomProcess()
 {
 	//	Shaders initializations
 
-	m_blurShader.Generate(postProcessDefaultVertexShaderStr, bloomBlurFragmentShaderStr);
-	m_finalShader.Generate(postProcessDefaultVertexShaderStr, bloomFragmentShader);
-
 	m_finalShader.Bind();
 	glUniform1i(glGetUniformLocation(m_finalShader.GetID(), "uColorTexture"), 0);
 	glUniform1i(glGetUniformLocation(m_finalShader.GetID(), "uBloomTexture"), 1);
@@ -4,7 +4,7 @@
 
 #include "Resources/Resource/Skybox.hpp"
 #include "Resources/Resource/Texture.hpp"
-#include "Resources/Parsers/AssimpParser.hpp"
+#include "Resources/Loaders/ResourcesLoader.hpp"
 
 GLCubeMap::GLCubeMap()
 {
@@ -105,16 +105,20 @@ void GLCubeMap::Generate(Skybox& skybox)
 		// Create temp texture to load data
 		Texture tex = Texture(HYGUID("0"));
 		tex.originalPath = face->originalPath;
+		tex.SetLoadingFlags(face->GetLoadingFlags());
 
-		// Load texture
-		if (!AssimpParser::LoadTexture(tex, face->GetLoadingFlags(), false))
+		// Load texture, from the cache of the face when it exists
+		if (!ResourcesLoader::LoadTextureUnsafe(tex))
 			continue;
 
 		// Set skybox data
-		glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB, width, height, 0, GL_RGB, type, tex.data.data);
+		if (tex.data.compressed && !tex.data.mipLevels.empty())
+			glCompressedTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, tex.data.internalFormat, width, height, 0, static_cast<GLsizei>(tex.data.mipLevels[0].size), tex.data.data);
+		else
+			glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB, width, height, 0, GL_RGB, type, tex.data.data);
 
 		// Free texture
-		AssimpParser::FreeTexture(tex);
+		ResourcesLoader::FreeTextureData(tex);
 	}
 
 	// Set cube map texture parameters
@@ -1,5 +1,7 @@
 #include "Renderer/Primitives/GLTexture.hpp"
 
+#include <algorithm>
+
 #include <glad/gl.h>
 
 #include "Resources/Resource/Texture.hpp"
@@ -51,6 +53,89 @@ void GLTexture::UnbindUnit(int unit) const
 	glBindTextureUnit(unit, 0);
 }
 
+// Sized format of an uncompressed texture, immutable storage does not take base formats
+static GLenum GetSizedFormat(GLenum format, GLenum type)
+{
+	const bool is16Bits = type == GL_UNSIGNED_SHORT;
+
+	switch (format)
+	{
+	case GL_RED: return is16Bits ? GL_R16 : GL_R8;
+	case GL_RG:	 return is16Bits ? GL_RG16 : GL_RG8;
+	case GL_RGB: return is16Bits ? GL_RGB16 : GL_RGB8;
+	default:	 return is16Bits ? GL_RGBA16 : GL_RGBA8;
+	}
+}
+
+void GLTexture::SetParameters(const Texture& texture) const
+{
+	GLint texParamWrap = texture.GetLoadingFlags().TestBit(EImageSTB::IMG_WRAP_REPEAT) ? GL_REPEAT : GL_CLAMP_TO_EDGE;
+
+	bool hasMipmaps = texture.GetLoadingFlags().TestBit(EImageSTB::IMG_GEN_MIPMAPS);
+	GLint texParamFilter = hasMipmaps ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR;
+
+	glTextureParameteri(m_ID, GL_TEXTURE_WRAP_S, texParamWrap);
+	glTextureParameteri(m_ID, GL_TEXTURE_WRAP_T, texParamWrap);
+	glTextureParameteri(m_ID, GL_TEXTURE_MIN_FILTER, texParamFilter);
+	glTextureParameteri(m_ID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+}
+
+void GLTexture::Allocate(const Texture& texture, const TextureData& data, int firstLevel)
+{
+	const std::vector<TextureMipLevel>& mipLevels = data.mipLevels;
+	if (firstLevel < 0 || firstLevel >= static_cast<int>(mipLevels.size()))
+	{
+		return;
+	}
+
+	SetParameters(texture);
+
+	const TextureMipLevel& first = mipLevels[firstLevel];
+	GLenum internalFormat = data.compressed ? data.internalFormat : GetSizedFormat(data.format, data.type);
+	glTextureStorage2D(m_ID, static_cast<GLsizei>(mipLevels.size()) - firstLevel, internalFormat, first.width, first.height);
+}
+
+void GLTexture::MoveToLevel(const Texture& texture, const TextureData& data, int currentLevel, int newLevel)
+{
+	GLuint previousID = m_ID;
+
+	glCreateTextures(GL_TEXTURE_2D, 1, &m_ID);
+	Allocate(texture, data, newLevel);
+
+	const int firstCopied = std::max(currentLevel, newLevel);
+	for (int level = firstCopied; level < static_cast<int>(data.mipLevels.size()); ++level)
+	{
+		const TextureMipLevel& mip = data.mipLevels[level];
+		glCopyImageSubData(previousID, GL_TEXTURE_2D, level - currentLevel, 0, 0, 0,
+			m_ID, GL_TEXTURE_2D, level - newLevel, 0, 0, 0, mip.width, mip.height, 1);
+	}
+
+	SetBaseLevel(firstCopied - newLevel);
+
+	glDeleteTextures(1, &previousID);
+}
+
+void GLTexture::UploadLevel(const TextureData& data, int level, int storageLevel)
+{
+	const TextureMipLevel& mip = data.mipLevels[level];
+
+	GLint unpackAlignment = 4;
+	glGetIntegerv(GL_UNPACK_ALIGNMENT, &unpackAlignment);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+	if (data.compressed)
+		glCompressedTextureSubImage2D(m_ID, storageLevel, 0, 0, mip.width, mip.height, data.internalFormat, static_cast<GLsizei>(mip.size), data.data + mip.offset);
+	else
+		glTextureSubImage2D(m_ID, storageLevel, 0, 0, mip.width, mip.height, data.format, data.type, data.data + mip.offset);
+
+	glPixelStorei(GL_UNPACK_ALIGNMENT, unpackAlignment);
+}
+
+void GLTexture::SetBaseLevel(int level)
+{
+	glTextureParameteri(m_ID, GL_TEXTURE_BASE_LEVEL, level);
+}
+
 void GLTexture::Generate(const Texture& texture)
 {
 	if (texture.data.data == nullptr)
@@ -60,21 +145,43 @@ void GLTexture::Generate(const Texture& texture)
 
 	Bind();
 
-	GLint texParamWrap = texture.GetLoadingFlags().TestBit(EImageSTB::IMG_WRAP_REPEAT) ? GL_REPEAT : GL_CLAMP_TO_EDGE;
+	SetParameters(texture);
 
 	bool hasMipmaps = texture.GetLoadingFlags().TestBit(EImageSTB::IMG_GEN_MIPMAPS);
-	GLint texParamFilter = hasMipmaps ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR;
-
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, texParamWrap);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, texParamWrap);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, texParamFilter);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
 	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-	glTexImage2D(GL_TEXTURE_2D, 0, texture.data.format, texture.data.width, texture.data.height, 0, texture.data.format, texture.data.type, texture.data.data);
 
-	if (hasMipmaps)
-		glGenerateMipmap(GL_TEXTURE_2D);
+	const std::vector<TextureMipLevel>& mipLevels = texture.data.mipLevels;
+	if (texture.data.compressed && !mipLevels.empty())
+	{
+		// Block compressed texture, immutable storage filled level by level
+		glTextureStorage2D(m_ID, static_cast<GLsizei>(mipLevels.size()), texture.data.internalFormat, texture.data.width, texture.data.height);
+
+		for (size_t level = 0; level < mipLevels.size(); ++level)
+		{
+			const TextureMipLevel& mip = mipLevels[level];
+			glCompressedTextureSubImage2D(m_ID, static_cast<GLint>(level), 0, 0, mip.width, mip.height, texture.data.internalFormat,
+				static_cast<GLsizei>(mip.size), texture.data.data + mip.offset);
+		}
+	}
+	else if (!mipLevels.empty())
+	{
+		// Cooked texture, its mip chain is uploaded as is
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(mipLevels.size()) - 1);
+
+		for (size_t level = 0; level < mipLevels.size(); ++level)
+		{
+			const TextureMipLevel& mip = mipLevels[level];
+			glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), texture.data.format, mip.width, mip.height, 0, texture.data.format, texture.data.type, texture.data.data + mip.offset);
+		}
+	}
+	else
+	{
+		glTexImage2D(GL_TEXTURE_2D, 0, texture.data.format, texture.data.width, texture.data.height, 0, texture.data.format, texture.data.type, texture.data.data);
+
+		if (hasMipmaps)
+			glGenerateMipmap(GL_TEXTURE_2D);
+	}
 
 	Unbind();
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <glad/gl.h>
 
 #include "Core/Logger.hpp"
+#include "Renderer/ShaderCache.hpp"
 
 ShaderProgram::ShaderProgram()
 {
@@ -14,8 +15,11 @@ ShaderProgram::ShaderProgram(ShaderProgram&& cpy) noexcept
 	m_ID = cpy.m_ID;
 	vertex = std::move(cpy.vertex);
 	fragment = std::move(cpy.fragment);
+	geometry = std::move(cpy.geometry);
 	m_uniforms = cpy.m_uniforms;
 	m_name = cpy.m_name;
+	m_sourceHash = cpy.m_sourceHash;
+	m_linkPending = cpy.m_linkPending;
 
 	cpy.m_ID = 0;
 }
@@ -27,8 +31,11 @@ ShaderProgram& ShaderProgram::operator=(ShaderProgram&& cpy) noexcept
 	m_ID = cpy.m_ID;
 	vertex = std::move(cpy.vertex);
 	fragment = std::move(cpy.fragment);
+	geometry = std::move(cpy.geometry);
 	m_uniforms = cpy.m_uniforms;
 	m_name = cpy.m_name;
+	m_sourceHash = cpy.m_sourceHash;
+	m_linkPending = cpy.m_linkPending;
 
 	cpy.m_ID = 0;
 
@@ -42,10 +49,19 @@ ShaderProgram::~ShaderProgram()
 
 void ShaderProgram::Generate(const char* vertexShader, const char* fragmentShader, const char* geomertyShader)
 {
-	// TODO: Get shader from ID
-	vertex.Generate(vertexShader, GL_VERTEX_SHADER);
-	fragment.Generate(fragmentShader, GL_FRAGMENT_SHADER);
-	if(geomertyShader) geometry.Generate(geomertyShader, GL_GEOMETRY_SHADER);
+	m_sourceHash = ShaderCache::HashSources(vertexShader, fragmentShader, geomertyShader);
+
+	// Binary of a previous run, built by the same driver from the same sources
+	if (ShaderCache::LoadProgram(m_ID, m_sourceHash))
+	{
+		CreateUniforms();
+		return;
+	}
+
+	// No status is queried here : with parallel compilation the driver builds the programs generated before their first use together
+	vertex.Compile(vertexShader, GL_VERTEX_SHADER);
+	fragment.Compile(fragmentShader, GL_FRAGMENT_SHADER);
+	if(geomertyShader) geometry.Compile(geomertyShader, GL_GEOMETRY_SHADER);
 
 
 	// Attach shaders to the program
@@ -53,14 +69,29 @@ void ShaderProgram::Generate(const char* vertexShader, const char* fragmentShade
 	glAttachShader(m_ID, fragment.ID);
 	if (geomertyShader) glAttachShader(m_ID, geometry.ID);
 
-	// Link the program
+	// Link the program, its binary is stored in the shader cache once linked
+	glProgramParameteri(m_ID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
 	glLinkProgram(m_ID);
 
+	m_linkPending = true;
+}
+
+void ShaderProgram::WaitForLink() const
+{
+	if (!m_linkPending)
+		return;
+
+	m_linkPending = false;
+
 	// Check for link error(s)
 	GLint success;
 	glGetProgramiv(m_ID, GL_LINK_STATUS, &success);
 	if (!success)
 	{
+		vertex.CheckCompileStatus();
+		fragment.CheckCompileStatus();
+		if (geometry.ID) geometry.CheckCompileStatus();
+
 		const GLsizei infoSize = 256;
 		GLchar infoLog[infoSize];
 		glGetProgramInfoLog(m_ID, infoSize, NULL, infoLog);
@@ -70,10 +101,12 @@ void ShaderProgram::Generate(const char* vertexShader, const char* fragmentShade
 	}
 
 	CreateUniforms();
+	ShaderCache::SaveProgram(m_ID, m_sourceHash);
 }
 
 void ShaderProgram::Bind() const
 {
+	WaitForLink();
 	glUseProgram(m_ID);
 }
 
@@ -82,7 +115,7 @@ void ShaderProgram::Unbind() const
 	glUseProgram(0);
 }
 
-void ShaderProgram::CreateUniforms()
+void ShaderProgram::CreateUniforms() const
 {
 	// Get the active uniforms count
 	GLint uniformCount;
@@ -112,6 +145,8 @@ void ShaderProgram::CreateUniforms()
 
 void ShaderProgram::SendUniform(const std::string& uniformName, const void* data, int count, bool transpose) const
 {
+	WaitForLink();
+
 	// Check if the uniform exists
 	auto found = m_uniforms.find(uniformName);
 	if (found == m_uniforms.end())
@@ -186,6 +221,8 @@ void ShaderProgram::SendUniform(const std::string& uniformName, const void* data
 
 int ShaderProgram::GetLocationFromUniformName(const std::string& uniformName)
 {
+	WaitForLink();
+
 	// Check if the uniform exists
 	auto found = m_uniforms.find(uniformName);
 	if (found == m_uniforms.end())
@@ -197,6 +234,12 @@ int ShaderProgram::GetLocationFromUniformName(const std::string& uniformName)
 	return found->second.location;
 }
 
+unsigned int ShaderProgram::GetID() const
+{
+	WaitForLink();
+	return m_ID;
+}
+
 const std::string& ShaderProgram::GetName() const
 {
 	return m_name;
@@ -1,5 +1,7 @@
 #include "Renderer/RenderGPUWrapper.hpp"
 
+#include <cstring>
+
 #include <glad/gl.h>
 
 #include "Resources/Resource/Texture.hpp"
@@ -7,9 +9,20 @@
 #include "Resources/Resource/Mesh.hpp"
 #include "Resources/Resource/SkeletalMesh.hpp"
 #include "Renderer/RenderSystem.hpp"
+#include "Renderer/MeshInstance.hpp"
+#include "Resources/Loaders/VertexPacker.hpp"
 #include "Core/Logger.hpp"
+#include "Maths/Maths.hpp"
+
+// Mesh buffers start at these capacities and double when full, up to the max ones
+constexpr size_t InitialVboCapacity = 1 << 18;			// Vertices
+constexpr size_t InitialSkeletalVboCapacity = 1 << 16;	// Vertices
+constexpr size_t InitialIboCapacity = 1 << 22;			// Bytes
+constexpr size_t MaxVboCapacity = 10000000;
+constexpr size_t MaxIboCapacity = 30000000 * sizeof(int);
 
-constexpr GLsizeiptr MaxVboSize = 10000000 * sizeof(Vertex);
+// Index streams start on a 4 bytes boundary in the index buffer and in the staging memory
+constexpr size_t IndexAlignment = sizeof(int);
 
 TextureArrayConfig shadowMapConfig =
 { 
@@ -51,7 +64,77 @@ TextureArrayConfig cascadeShadowMapConfig =
 };
 
 
+// Bounding sphere of the box around the vertices and transform of the packed positions
+static void SetBounds(EVertexLayout layout, const Vector3& min, const Vector3& max, GPUMeshData& gpuData)
+{
+	gpuData.boundsCenter = (min + max) * 0.5f;
+	gpuData.boundsRadius = (max - min).Magnitude() * 0.5f;
+
+	VertexPacker::GetPositionTransform(layout, min, max, gpuData.positionOffset, gpuData.positionScale);
+}
+
+static size_t AlignIndices(size_t size)
+{
+	return (size + IndexAlignment - 1) & ~(IndexAlignment - 1);
+}
+
+// Size of the indices of a sub mesh in the index buffer, 16 bits indices are used when the vertices allow it
+static size_t GetIndexStreamSize(const MeshData& data)
+{
+	const bool shortIndices = VertexPacker::CanUseShortIndices(data.GetVertexCount());
+	return data.GetIndexCount() * (shortIndices ? sizeof(uint16_t) : sizeof(int));
+}
+
+// Write the indices of a sub mesh in their type in the index buffer, mapped streams already in this type are copied as they are
+static void WriteIndices(const MeshData& data, unsigned char* dst)
+{
+	const bool shortIndices = VertexPacker::CanUseShortIndices(data.GetVertexCount());
+	const size_t count = data.GetIndexCount();
+
+	if (data.HasShortIndices() == shortIndices)
+	{
+		std::memcpy(dst, data.GetIndexData(), GetIndexStreamSize(data));
+		return;
+	}
+
+	// Only int indices converted to 16 bits indices are left
+	const int* indices = static_cast<const int*>(data.GetIndexData());
+	uint16_t* shortDst = reinterpret_cast<uint16_t*>(dst);
+	for (size_t i = 0; i < count; ++i)
+		shortDst[i] = static_cast<uint16_t>(indices[i]);
+}
+
+// Write the vertices of a sub mesh in a vertex layout and keep their bounds, mapped streams already in this layout are copied as they are
+static void WriteVertices(EVertexLayout layout, MeshData& data, unsigned char* dst)
+{
+	if (!data.mappedVertices.empty() && data.mappedLayout == layout)
+	{
+		std::memcpy(dst, data.mappedVertices.data(), data.mappedVertices.size());
+		return;
+	}
+
+	std::vector<Vertex> buffer;
+	std::span<const Vertex> vertices = data.GetVertices(buffer);
+
+	VertexPacker::ComputeBounds(vertices, data.boundsMin, data.boundsMax);
+	VertexPacker::Pack(layout, vertices, data.boundsMin, data.boundsMax, dst);
+}
+
+
+MeshBuffer::MeshBuffer(size_t elementSize, size_t initialCapacity, size_t maxCapacity, size_t alignment) :
+	allocator(initialCapacity, alignment),
+	elementSize(elementSize),
+	maxCapacity(maxCapacity)
+{
+
+}
+
+
 RenderGPUWrapper::RenderGPUWrapper() :
+	meshVBO(sizeof(Vertex), InitialVboCapacity, MaxVboCapacity),
+	packedMeshVBO(sizeof(PackedVertex), InitialVboCapacity, MaxVboCapacity),
+	skeletalMeshVBO(sizeof(Vertex), InitialSkeletalVboCapacity, MaxVboCapacity),
+	meshIBO(1, InitialIboCapacity, MaxIboCapacity, IndexAlignment),
 	GeneratedTextureArray(),
 	GeneratedDepthMapTextureArray(shadowMapConfig),
 	GeneratedDepthCubeMapTextureArray(shadowCubeMapConfig),
@@ -69,18 +152,17 @@ RenderGPUWrapper::~RenderGPUWrapper()
 
 void RenderGPUWrapper::CreateVertexObjects()
 {
+	//	Mesh buffers storage (empty), grown when full
+	for (MeshBuffer* meshBuffer : { &meshVBO, &packedMeshVBO, &skeletalMeshVBO, &meshIBO })
+		glNamedBufferStorage(meshBuffer->buffer.GetID(), meshBuffer->allocator.GetCapacity() * meshBuffer->elementSize, nullptr, GL_DYNAMIC_STORAGE_BIT);
+
+	glNamedBufferStorage(skeletalDataVBO.GetID(), skeletalMeshVBO.allocator.GetCapacity() * sizeof(VertexBoneData), nullptr, GL_DYNAMIC_STORAGE_BIT);
 
 	//	Meshes VAO & VBO setting
 	{
 		//	Meshes Vertex Array
 		GLuint vao = meshVAO.GetID();
 
-		// Allocate vertex buffer storage (empty)
-		glNamedBufferStorage(meshVBO.GetID(), MaxVboSize, nullptr, GL_DYNAMIC_STORAGE_BIT);
-
-		// Link array and buffer (binding 0)
-		glVertexArrayVertexBuffer(vao, 0, meshVBO.GetID(), 0, sizeof(Vertex));
-
 		// Enable attributes
 		glEnableVertexArrayAttrib(vao, 0);	//	Position
 		glEnableVertexArrayAttrib(vao, 1);	//	UVs
@@ -100,6 +182,34 @@ void RenderGPUWrapper::CreateVertexObjects()
 		glVertexArrayAttribFormat(vao, 3, 3, GL_FLOAT, GL_FALSE, offsetof(Vertex, tangent));
 	}
 
+	//	Packed meshes VAOs & VBO setting
+	{
+		// Both packed layouts share the buffer, only the type of the positions differs
+		for (EVertexLayout layout : { EVertexLayout::PACKED_SNORM, EVertexLayout::PACKED_HALF })
+		{
+			GLuint vao = GetMeshVAO(layout).GetID();
+
+			glEnableVertexArrayAttrib(vao, 0);	//	Position and bitangent sign
+			glEnableVertexArrayAttrib(vao, 1);	//	UVs
+			glEnableVertexArrayAttrib(vao, 2);	//	Octahedral normal
+			glEnableVertexArrayAttrib(vao, 3);	//	Octahedral tangent
+
+			glVertexArrayAttribBinding(vao, 0, 0);
+			glVertexArrayAttribBinding(vao, 1, 0);
+			glVertexArrayAttribBinding(vao, 2, 0);
+			glVertexArrayAttribBinding(vao, 3, 0);
+
+			if (layout == EVertexLayout::PACKED_HALF)
+				glVertexArrayAttribFormat(vao, 0, 4, GL_HALF_FLOAT, GL_FALSE, offsetof(PackedVertex, position));
+			else
+				glVertexArrayAttribFormat(vao, 0, 4, GL_SHORT, GL_TRUE, offsetof(PackedVertex, position));
+
+			glVertexArrayAttribFormat(vao, 1, 2, GL_HALF_FLOAT, GL_FALSE, offsetof(PackedVertex, uvs));
+			glVertexArrayAttribFormat(vao, 2, 2, GL_SHORT, GL_TRUE, offsetof(PackedVertex, normal));
+			glVertexArrayAttribFormat(vao, 3, 2, GL_SHORT, GL_TRUE, offsetof(PackedVertex, tangent));
+		}
+	}
+
 	//	Skeletal Mesh VAO & VBO setting
 	{
 		//	Meshes Vertex Array
@@ -107,12 +217,6 @@ void RenderGPUWrapper::CreateVertexObjects()
 
 		//	SKELETAL MESH VERTEX BUFFER
 		//	---------------------------
-		
-		// Allocate vertex buffer storage (empty)
-		glNamedBufferStorage(skeletalMeshVBO.GetID(), MaxVboSize, nullptr, GL_DYNAMIC_STORAGE_BIT);
-
-		// Link array and buffer (binding 0)
-		glVertexArrayVertexBuffer(vao, 0, skeletalMeshVBO.GetID(), 0, sizeof(Vertex));
 
 		// Enable attributes
 		glEnableVertexArrayAttrib(vao, 0);	//	Position
@@ -136,10 +240,6 @@ void RenderGPUWrapper::CreateVertexObjects()
 		//	SKELETAL DATA VERTEX BUFFER
 		//	---------------------------
 
-		glNamedBufferStorage(skeletalDataVBO.GetID(), MaxVboSize, nullptr, GL_DYNAMIC_STORAGE_BIT);
-
-		glVertexArrayVertexBuffer(vao, 1, skeletalDataVBO.GetID(), 0, sizeof(VertexBoneData));
-
 		glEnableVertexArrayAttrib(vao, 4);	//	BoneIndices
 		glEnableVertexArrayAttrib(vao, 5);	//	BoneWeights
 
@@ -149,94 +249,538 @@ void RenderGPUWrapper::CreateVertexObjects()
 		glVertexArrayAttribFormat(vao, 4, MAX_BONE_INFLUENCE, GL_INT, GL_FALSE, offsetof(VertexBoneData, boneIDs));
 		glVertexArrayAttribFormat(vao, 5, MAX_BONE_INFLUENCE, GL_FLOAT, GL_FALSE, offsetof(VertexBoneData, weights));
 	}
+
+	AttachMeshBuffers();
+}
+
+void RenderGPUWrapper::AttachMeshBuffers()
+{
+	// Link arrays and buffers (binding 0, bone data on binding 1)
+	glVertexArrayVertexBuffer(meshVAO.GetID(), 0, meshVBO.buffer.GetID(), 0, sizeof(Vertex));
+	glVertexArrayVertexBuffer(packedMeshVAO.GetID(), 0, packedMeshVBO.buffer.GetID(), 0, sizeof(PackedVertex));
+	glVertexArrayVertexBuffer(halfPackedMeshVAO.GetID(), 0, packedMeshVBO.buffer.GetID(), 0, sizeof(PackedVertex));
+	glVertexArrayVertexBuffer(skeletalMeshVAO.GetID(), 0, skeletalMeshVBO.buffer.GetID(), 0, sizeof(Vertex));
+	glVertexArrayVertexBuffer(skeletalMeshVAO.GetID(), 1, skeletalDataVBO.GetID(), 0, sizeof(VertexBoneData));
+
+	// The index buffer is shared by every mesh vertex array
+	for (const VertexArray* vao : { &meshVAO, &packedMeshVAO, &halfPackedMeshVAO, &skeletalMeshVAO })
+		glVertexArrayElementBuffer(vao->GetID(), meshIBO.buffer.GetID());
+
+	for (GLuint vao : indexedVAOs)
+	{
+		if (glIsVertexArray(vao))
+			glVertexArrayElementBuffer(vao, meshIBO.buffer.GetID());
+	}
+}
+
+size_t RenderGPUWrapper::AllocateRange(MeshBuffer& meshBuffer, size_t size)
+{
+	// Empty sub meshes still get their own offset
+	size = std::max<size_t>(size, 1);
+
+	size_t offset = meshBuffer.allocator.Allocate(size);
+	while (offset == BufferAllocator::InvalidOffset)
+	{
+		const size_t capacity = meshBuffer.allocator.GetCapacity();
+		if (capacity >= meshBuffer.maxCapacity)
+			return BufferAllocator::InvalidOffset;
+
+		GrowMeshBuffer(meshBuffer, std::min(std::max(capacity * 2, capacity + size), meshBuffer.maxCapacity));
+		offset = meshBuffer.allocator.Allocate(size);
+	}
+
+	return offset;
+}
+
+void RenderGPUWrapper::GrowMeshBuffer(MeshBuffer& meshBuffer, size_t capacity)
+{
+	// Queued copies write in the old buffer, they are done before it is copied
+	uploadQueue.Flush();
+
+	const size_t oldCapacity = meshBuffer.allocator.GetCapacity();
+
+	VertexBuffer buffer;
+	glNamedBufferStorage(buffer.GetID(), capacity * meshBuffer.elementSize, nullptr, GL_DYNAMIC_STORAGE_BIT);
+	glCopyNamedBufferSubData(meshBuffer.buffer.GetID(), buffer.GetID(), 0, 0, oldCapacity * meshBuffer.elementSize);
+	meshBuffer.buffer = std::move(buffer);
+
+	// Bone data follows the skeletal vertices
+	if (&meshBuffer == &skeletalMeshVBO)
+	{
+		VertexBuffer dataBuffer;
+		glNamedBufferStorage(dataBuffer.GetID(), capacity * sizeof(VertexBoneData), nullptr, GL_DYNAMIC_STORAGE_BIT);
+		glCopyNamedBufferSubData(skeletalDataVBO.GetID(), dataBuffer.GetID(), 0, 0, oldCapacity * sizeof(VertexBoneData));
+		skeletalDataVBO = std::move(dataBuffer);
+	}
+
+	meshBuffer.allocator.Grow(capacity);
+	AttachMeshBuffers();
+
+	Logger::Info("RenderGPUWrapper - Mesh buffer grown to " + std::to_string(capacity * meshBuffer.elementSize / (1024 * 1024)) + " MB");
 }
 
+void RenderGPUWrapper::FreeMeshRanges(MeshBuffer& meshBuffer, const GPUMeshData& gpuData)
+{
+	meshBuffer.allocator.Free(gpuData.offset);
+	meshBuffer.owners.erase(gpuData.offset);
+
+	meshIBO.allocator.Free(gpuData.indexOffset);
+	meshIBO.owners.erase(gpuData.indexOffset);
+}
+
+void RenderGPUWrapper::DefragmentMeshBuffer(MeshBuffer& meshBuffer, size_t& budget)
+{
+	const bool indices = &meshBuffer == &meshIBO;
+	const bool skeletal = &meshBuffer == &skeletalMeshVBO;
+
+	// Ranges still waiting for their copy from the staging memory stay in place
+	auto canMove = [&meshBuffer](size_t offset) {
+		auto it = meshBuffer.owners.find(offset);
+		return it == meshBuffer.owners.end() || it->second->uploadTicket == 0;
+		};
+
+	BufferAllocator::Move move;
+	while (budget > 0 && meshBuffer.allocator.PlanMove(move, canMove))
+	{
+		const size_t size = move.size * meshBuffer.elementSize;
+		glCopyNamedBufferSubData(meshBuffer.buffer.GetID(), meshBuffer.buffer.GetID(),
+			move.source * meshBuffer.elementSize, move.destination * meshBuffer.elementSize, size);
+
+		meshBuffer.allocator.Free(move.source);
+		budget -= std::min(budget, size);
+
+		auto it = meshBuffer.owners.find(move.source);
+		if (it == meshBuffer.owners.end())
+			continue;
+
+		GPUMeshData* gpuData = it->second;
+		meshBuffer.owners.erase(it);
+		meshBuffer.owners[move.destination] = gpuData;
+
+		if (indices)
+		{
+			gpuData->indexOffset = static_cast<unsigned int>(move.destination);
+			continue;
+		}
+
+		gpuData->offset = static_cast<unsigned int>(move.destination);
+
+		// Bone data is read with the same base vertex, it moves with the vertices
+		if (skeletal)
+		{
+			glCopyNamedBufferSubData(skeletalDataVBO.GetID(), skeletalDataVBO.GetID(),
+				move.source * sizeof(VertexBoneData), move.destination * sizeof(VertexBoneData), move.size * sizeof(VertexBoneData));
+
+			for (GPUSkeletalData& skeletalData : GPUSkeletalDatas)
+			{
+				if (skeletalData.offset == move.source)
+					skeletalData.offset = static_cast<unsigned int>(move.destination);
+			}
+		}
+	}
+}
+
+void RenderGPUWrapper::Defragment(size_t budget)
+{
+	for (MeshBuffer* meshBuffer : { &meshVBO, &packedMeshVBO, &skeletalMeshVBO, &meshIBO })
+	{
+		if (budget == 0)
+			return;
+
+		DefragmentMeshBuffer(*meshBuffer, budget);
+	}
+}
+
+BufferAllocator::Stats RenderGPUWrapper::GetVertexBufferStats(EVertexLayout layout) const
+{
+	return layout == EVertexLayout::FLOAT ? meshVBO.allocator.GetStats() : packedMeshVBO.allocator.GetStats();
+}
+
+BufferAllocator::Stats RenderGPUWrapper::GetIndexBufferStats() const
+{
+	return meshIBO.allocator.GetStats();
+}
+
+bool RenderGPUWrapper::ReadIndices(const MeshData& data, std::vector<int>& indices) const
+{
+	const GPUMeshData* gpuData = data.GPUData;
+	if (gpuData == nullptr || gpuData->uploadTicket != 0)
+		return false;
+
+	indices.resize(gpuData->indexCount);
+	if (!gpuData->shortIndices)
+	{
+		glGetNamedBufferSubData(meshIBO.buffer.GetID(), gpuData->indexOffset, indices.size() * sizeof(int), indices.data());
+		return true;
+	}
+
+	std::vector<uint16_t> shortIndices(gpuData->indexCount);
+	glGetNamedBufferSubData(meshIBO.buffer.GetID(), gpuData->indexOffset, shortIndices.size() * sizeof(uint16_t), shortIndices.data());
+	indices.assign(shortIndices.begin(), shortIndices.end());
+	return true;
+}
+
+
+#pragma region DRAW_MESH_DATA
+
+const VertexArray& RenderGPUWrapper::GetMeshVAO(EVertexLayout layout) const
+{
+	switch (layout)
+	{
+	case EVertexLayout::PACKED_SNORM:	return packedMeshVAO;
+	case EVertexLayout::PACKED_HALF:	return halfPackedMeshVAO;
+	default:							return meshVAO;
+	}
+}
+
+void RenderGPUWrapper::BindMeshVAO(const GPUMeshData& gpuData, const VertexArray*& bound) const
+{
+	const VertexArray& vao = GetMeshVAO(gpuData.layout);
+	if (&vao == bound)
+		return;
+
+	vao.Bind();
+	bound = &vao;
+}
+
+void RenderGPUWrapper::AttachMeshIndices(const VertexArray& vao)
+{
+	glVertexArrayElementBuffer(vao.GetID(), meshIBO.buffer.GetID());
+	if (std::find(indexedVAOs.begin(), indexedVAOs.end(), vao.GetID()) == indexedVAOs.end())
+		indexedVAOs.push_back(vao.GetID());
+}
+
+void RenderGPUWrapper::SendVertexDecoding(int location, const GPUMeshData& gpuData)
+{
+	const float decoding[8] = {
+		gpuData.positionOffset.x, gpuData.positionOffset.y, gpuData.positionOffset.z, gpuData.layout == EVertexLayout::FLOAT ? 0.f : 1.f,
+		gpuData.positionScale.x, gpuData.positionScale.y, gpuData.positionScale.z, 0.f
+	};
+
+	glUniform4fv(location, 2, decoding);
+}
+
+void RenderGPUWrapper::DrawElements(const MeshData& mesh, uint32_t lod)
+{
+	const GPUMeshData& gpuData = *mesh.GPUData;
+	const MeshLOD range = mesh.GetLOD(lod);
+	const size_t indexSize = gpuData.shortIndices ? sizeof(uint16_t) : sizeof(int);
+
+	// Offset in the bound index buffer
+	glDrawElementsBaseVertex(
+		GL_TRIANGLES,
+		static_cast<GLsizei>(range.indexCount),
+		gpuData.shortIndices ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT,
+		reinterpret_cast<const void*>(static_cast<uintptr_t>(gpuData.indexOffset + range.indexOffset * indexSize)),
+		gpuData.offset
+	);
+}
+
+void RenderGPUWrapper::DrawElements(const MeshData& mesh, const MeshLODDraw& draw)
+{
+	if (draw.meshlets == nullptr)
+	{
+		DrawElements(mesh, draw.lod);
+		return;
+	}
+
+	const MeshletBatch& batch = *draw.meshlets;
+	if (batch.firstIndices.empty())
+		return;
+
+	// Ranges are rebuilt as offsets in the bound index buffer, the arrays are kept between draws
+	static std::vector<const void*> offsets;
+	static std::vector<GLint> baseVertices;
+
+	const GPUMeshData& gpuData = *mesh.GPUData;
+	const size_t indexSize = gpuData.shortIndices ? sizeof(uint16_t) : sizeof(int);
+
+	offsets.resize(batch.firstIndices.size());
+	baseVertices.assign(batch.firstIndices.size(), static_cast<GLint>(gpuData.offset));
+	for (size_t i = 0; i < batch.firstIndices.size(); ++i)
+		offsets[i] = reinterpret_cast<const void*>(static_cast<uintptr_t>(gpuData.indexOffset + batch.firstIndices[i] * indexSize));
+
+	glMultiDrawElementsBaseVertex(
+		GL_TRIANGLES,
+		batch.indexCounts.data(),
+		gpuData.shortIndices ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT,
+		offsets.data(),
+		static_cast<GLsizei>(batch.firstIndices.size()),
+		baseVertices.data()
+	);
+}
+
+#pragma endregion
+
+
+#pragma region STAGING_GPU_DATA
+
+bool RenderGPUWrapper::StageMeshData(Mesh& mesh)
+{
+	if (mesh.stagingData.IsValid())
+		return true;
+
+	const EVertexLayout layout = mesh.GetVertexLayout();
+	const size_t vertexSize = VertexPacker::GetVertexSize(layout);
+
+	// Vertices of every sub mesh, then their indices
+	size_t size = 0;
+	for (const MeshData& data : mesh.subMeshes)
+		size += data.GetVertexCount() * vertexSize;
+	size = AlignIndices(size);
+	for (const MeshData& data : mesh.subMeshes)
+		size += AlignIndices(GetIndexStreamSize(data));
+
+	StagingRange range = uploadQueue.Allocate(size);
+	if (!range.IsValid())
+		return false;
+
+	// Sub meshes are written one after the other in the layout of the mesh, mapped vertices are read from the mesh file pages
+	unsigned char* dst = range.data;
+	for (MeshData& data : mesh.subMeshes)
+	{
+		WriteVertices(layout, data, dst);
+		dst += data.GetVertexCount() * vertexSize;
+	}
+
+	dst = range.data + AlignIndices(dst - range.data);
+	for (const MeshData& data : mesh.subMeshes)
+	{
+		WriteIndices(data, dst);
+		dst += AlignIndices(GetIndexStreamSize(data));
+	}
+
+	mesh.stagingData = range;
+	return true;
+}
+
+
+
+bool RenderGPUWrapper::StageTextureData(Texture& text)
+{
+	if (text.stagingData.IsValid())
+		return true;
+
+	// Textures whose mipmaps are generated by the driver are uploaded by GLTexture::Generate
+	const std::vector<TextureMipLevel>& mipLevels = text.data.mipLevels;
+	if (text.data.data == nullptr || mipLevels.empty())
+		return false;
+
+	const size_t begin = mipLevels[textureStreamer.GetInitialLevel(text.data)].offset;
+	const size_t size = mipLevels.back().offset + mipLevels.back().size - begin;
+
+	StagingRange range = uploadQueue.Allocate(size);
+	if (!range.IsValid())
+		return false;
+
+	std::memcpy(range.data, text.data.data + begin, size);
+
+	text.stagingData = range;
+	return true;
+}
+
+#pragma endregion
+
 
 #pragma region CREATE_GPU_DATA
 void RenderGPUWrapper::CreateMeshData(Mesh& mesh)
 {
-	for (MeshData& data : mesh.subMeshes)
+	// Vertices not staged by a loading worker are staged now, a full staging memory is emptied once before sending them directly
+	if (!StageMeshData(mesh) && uploadQueue.HasPendingRequests())
+	{
+		uploadQueue.Flush();
+		StageMeshData(mesh);
+	}
+
+	UploadQueue::Request request;
+	request.staging = mesh.stagingData;
+	mesh.stagingData = {};
+
+	std::vector<GPUMeshData*> queuedDatas;
+	size_t stagingOffset = request.staging.offset;
+
+	// Packed layouts share their own vertex buffer
+	const EVertexLayout layout = mesh.GetVertexLayout();
+	const size_t vertexSize = VertexPacker::GetVertexSize(layout);
+	MeshBuffer& vbo = layout == EVertexLayout::FLOAT ? meshVBO : packedMeshVBO;
+
+	// Ranges are allocated before any copy is queued, growing a buffer replaces it
+	std::vector<size_t> vertexOffsets(mesh.subMeshes.size(), BufferAllocator::InvalidOffset);
+	std::vector<size_t> indexOffsets(mesh.subMeshes.size(), BufferAllocator::InvalidOffset);
+	for (size_t i = 0; i < mesh.subMeshes.size(); ++i)
 	{
+		const MeshData& data = mesh.subMeshes[i];
 		if (data.GPUData != nullptr) continue;
 
-		// Get mesh vertices size and new vbo size
-		unsigned int size = static_cast<unsigned int>(data.vertices.size());
-		unsigned int newVBOSize = (meshVBO.size + size) * sizeof(Vertex);
+		vertexOffsets[i] = AllocateRange(vbo, data.GetVertexCount());
+		indexOffsets[i] = AllocateRange(meshIBO, GetIndexStreamSize(data));
 
-		// Check if the vertex buffer is enough large to contain the new mesh
-		if (newVBOSize < MaxVboSize)
+		// Check if the vertex and index buffers can contain the new mesh
+		if (vertexOffsets[i] == BufferAllocator::InvalidOffset || indexOffsets[i] == BufferAllocator::InvalidOffset)
 		{
-			// Add new gpu mesh data
-			GPUMeshData& gpuData = GPUMeshDatas.emplace_back();
+			vbo.allocator.Free(vertexOffsets[i]);
+			meshIBO.allocator.Free(indexOffsets[i]);
+			vertexOffsets[i] = indexOffsets[i] = BufferAllocator::InvalidOffset;
+
+			Logger::Error("RenderGPUWrapper - CreateMeshData : Mesh buffers full, a sub mesh of " + mesh.GetName() + " is not sent");
+		}
+	}
+
+	// Indices are staged after the vertices of every sub mesh
+	size_t indexStagingOffset = 0;
+	for (const MeshData& data : mesh.subMeshes)
+		indexStagingOffset += data.GetVertexCount() * vertexSize;
+	indexStagingOffset = request.staging.offset + AlignIndices(indexStagingOffset);
+
+	for (size_t i = 0; i < mesh.subMeshes.size(); ++i)
+	{
+		MeshData& data = mesh.subMeshes[i];
 
-			gpuData.offset = meshVBO.size;
-			gpuData.size = size * sizeof(Vertex);
+		// Get mesh vertices size
+		unsigned int size = static_cast<unsigned int>(data.GetVertexCount());
 
-			data.GPUData = &gpuData;
+		size_t srcOffset = stagingOffset;
+		stagingOffset += size * vertexSize;
 
-			// Add the new mesh vertices data in the vertex buffer
-			glNamedBufferSubData(meshVBO.GetID(), meshVBO.size * sizeof(Vertex), gpuData.size, data.vertices.data());
+		const size_t indicesSize = GetIndexStreamSize(data);
 
-			meshVBO.size += size;
+		size_t srcIndexOffset = indexStagingOffset;
+		indexStagingOffset += AlignIndices(indicesSize);
+
+		if (data.GPUData != nullptr || vertexOffsets[i] == BufferAllocator::InvalidOffset) continue;
+
+		// Add new gpu mesh data
+		GPUMeshData& gpuData = GPUMeshDatas.emplace_back();
+
+		gpuData.offset = static_cast<unsigned int>(vertexOffsets[i]);
+		gpuData.size = static_cast<unsigned int>(size * vertexSize);
+		gpuData.layout = layout;
+
+		gpuData.indexOffset = static_cast<unsigned int>(indexOffsets[i]);
+		gpuData.indexCount = static_cast<unsigned int>(data.GetIndexCount());
+		gpuData.shortIndices = VertexPacker::CanUseShortIndices(size);
+
+		data.GPUData = &gpuData;
+		vbo.owners[gpuData.offset] = &gpuData;
+		meshIBO.owners[gpuData.indexOffset] = &gpuData;
+
+		// Add the new mesh vertices and indices data in the buffers
+		if (request.staging.IsValid())
+		{
+			request.bufferCopies.push_back({ vbo.buffer.GetID(), srcOffset, gpuData.offset * vertexSize, gpuData.size });
+			request.bufferCopies.push_back({ meshIBO.buffer.GetID(), srcIndexOffset, gpuData.indexOffset, indicesSize });
+			queuedDatas.push_back(&gpuData);
+		}
+		else
+		{
+			std::vector<unsigned char> vertices(gpuData.size);
+			WriteVertices(layout, data, vertices.data());
+			glNamedBufferSubData(vbo.buffer.GetID(), gpuData.offset * vertexSize, gpuData.size, vertices.data());
+
+			std::vector<unsigned char> indices(indicesSize);
+			WriteIndices(data, indices.data());
+			glNamedBufferSubData(meshIBO.buffer.GetID(), gpuData.indexOffset, indicesSize, indices.data());
+		}
+
+		// Bounds are known once the vertices are written
+		SetBounds(layout, data.boundsMin, data.boundsMax, gpuData);
+	}
+
+	if (queuedDatas.empty())
+	{
+		uploadQueue.Release(request.staging);
+
+		// Sent directly, the indices are drawn from the index buffer only
+		for (MeshData& data : mesh.subMeshes)
+		{
+			if (data.GPUData != nullptr && data.GPUData->uploadTicket == 0)
+				data.ReleaseIndices();
 		}
+		return;
 	}
+
+	// Ranges are not drawn until their copy is done, the indices are then drawn from the index buffer only
+	request.onComplete = [&mesh, queuedDatas]() {
+		for (GPUMeshData* gpuData : queuedDatas)
+			gpuData->uploadTicket = 0;
+
+		for (MeshData& data : mesh.subMeshes)
+		{
+			if (data.GPUData != nullptr && data.GPUData->uploadTicket == 0)
+				data.ReleaseIndices();
+		}
+
+		mesh.TrySetState(RESOURCE_STATE::GPU_READY);
+		};
+
+	uint64_t ticket = uploadQueue.Submit(std::move(request));
+	for (GPUMeshData* gpuData : queuedDatas)
+		gpuData->uploadTicket = ticket;
 }
 
 
 
 void RenderGPUWrapper::CreateSkeletalMeshData(SkeletalMesh& skMesh)
 {
-	for (MeshData& data : skMesh.subMeshes)
+	for (size_t i = 0; i < skMesh.subMeshes.size(); ++i)
 	{
+		MeshData& data = skMesh.subMeshes[i];
 		if (data.GPUData != nullptr) continue;
 
-		// Get mesh vertices size and new vbo size
+		// Get mesh vertices size
 		unsigned int size = static_cast<unsigned int>(data.vertices.size());
-		unsigned int newVBOSize = (skeletalMeshVBO.size + size) * sizeof(Vertex);
+		const size_t indicesSize = GetIndexStreamSize(data);
 
-		// Check if the vertex buffer is enough large to contain the new mesh
-		if (newVBOSize < MaxVboSize)
+		const size_t vertexOffset = AllocateRange(skeletalMeshVBO, size);
+		const size_t indexOffset = AllocateRange(meshIBO, indicesSize);
+
+		// Check if the vertex and index buffers can contain the new mesh
+		if (vertexOffset == BufferAllocator::InvalidOffset || indexOffset == BufferAllocator::InvalidOffset)
 		{
-			// Add new gpu mesh data
-			GPUMeshData& gpuData = GPUSkeletalMeshDatas.emplace_back();
+			skeletalMeshVBO.allocator.Free(vertexOffset);
+			meshIBO.allocator.Free(indexOffset);
 
-			gpuData.offset = skeletalMeshVBO.size;
-			gpuData.size = size * sizeof(Vertex);
+			Logger::Error("RenderGPUWrapper - CreateSkeletalMeshData : Mesh buffers full, a sub mesh of " + skMesh.GetName() + " is not sent");
+			continue;
+		}
 
-			data.GPUData = &gpuData;
+		// Add new gpu mesh data
+		GPUMeshData& gpuData = GPUSkeletalMeshDatas.emplace_back();
 
-			// Add the new mesh vertices data in the vertex buffer
-			glNamedBufferSubData(skeletalMeshVBO.GetID(), skeletalMeshVBO.size * (sizeof(Vertex)), gpuData.size, data.vertices.data());
+		gpuData.offset = static_cast<unsigned int>(vertexOffset);
+		gpuData.size = size * sizeof(Vertex);
+		VertexPacker::ComputeBounds(data.vertices, data.boundsMin, data.boundsMax);
+		SetBounds(EVertexLayout::FLOAT, data.boundsMin, data.boundsMax, gpuData);
 
-			skeletalMeshVBO.size += size;
-		}
-	}
+		gpuData.indexOffset = static_cast<unsigned int>(indexOffset);
+		gpuData.indexCount = static_cast<unsigned int>(data.GetIndexCount());
+		gpuData.shortIndices = VertexPacker::CanUseShortIndices(size);
 
-	//	TODO : TEST IF IT IS WORKING OR NOT v v v
+		data.GPUData = &gpuData;
+		skeletalMeshVBO.owners[gpuData.offset] = &gpuData;
+		meshIBO.owners[gpuData.indexOffset] = &gpuData;
 
-	for (SkeletalData& data : skMesh.skeletonDatas)
-	{
-		if (data.GPUData != nullptr) continue;
+		// Add the new mesh vertices data in the vertex buffer
+		glNamedBufferSubData(skeletalMeshVBO.buffer.GetID(), gpuData.offset * sizeof(Vertex), gpuData.size, data.vertices.data());
 
-		// Get mesh vertices size and new vbo size
-		unsigned int size = static_cast<unsigned int>(data.vertexBoneData.size());
-		unsigned int newVBOSize = (skeletalDataVBO.size + size) * sizeof(VertexBoneData);
+		// Indices are kept in memory, the skeletal mesh file is written from them
+		std::vector<unsigned char> indices(indicesSize);
+		WriteIndices(data, indices.data());
+		glNamedBufferSubData(meshIBO.buffer.GetID(), gpuData.indexOffset, indicesSize, indices.data());
 
-		// Check if the vertex buffer is enough large to contain the new mesh
-		if (newVBOSize < MaxVboSize)
-		{
-			// Add new gpu mesh data
-			GPUSkeletalData& gpuData = GPUSkeletalDatas.emplace_back();
+		// Bone data of the sub mesh is read with the same base vertex
+		if (i >= skMesh.skeletonDatas.size() || skMesh.skeletonDatas[i].GPUData != nullptr)
+			continue;
 
-			gpuData.offset = skeletalDataVBO.size;
-			gpuData.size = size * sizeof(VertexBoneData);
+		SkeletalData& skeleton = skMesh.skeletonDatas[i];
+		GPUSkeletalData& gpuSkeleton = GPUSkeletalDatas.emplace_back();
 
-			data.GPUData = &gpuData;
+		gpuSkeleton.offset = gpuData.offset;
+		gpuSkeleton.size = static_cast<unsigned int>(std::min<size_t>(skeleton.vertexBoneData.size(), size) * sizeof(VertexBoneData));
 
-			glNamedBufferSubData(skeletalDataVBO.GetID(), skeletalDataVBO.size * sizeof(VertexBoneData), gpuData.size, data.vertexBoneData.data());
+		skeleton.GPUData = &gpuSkeleton;
 
-			skeletalDataVBO.size += size;
-		}
+		glNamedBufferSubData(skeletalDataVBO.GetID(), gpuSkeleton.offset * sizeof(VertexBoneData), gpuSkeleton.size, skeleton.vertexBoneData.data());
 	}
 }
 
@@ -250,7 +794,58 @@ void RenderGPUWrapper::CreateTextureData(Texture& text)
 
 	text.GPUData = &gpuData;
 
-	generatedTexture.Generate(text);
+	// Pixels not staged by a loading worker are staged now, a full staging memory is emptied once before sending them directly
+	if (!StageTextureData(text) && text.data.data != nullptr && !text.data.mipLevels.empty() && uploadQueue.HasPendingRequests())
+	{
+		uploadQueue.Flush();
+		StageTextureData(text);
+	}
+
+	if (!text.stagingData.IsValid())
+	{
+		generatedTexture.Generate(text);
+		return;
+	}
+
+	// Streamed textures are created with their low levels only, the staged range gives the first one
+	// as the streaming settings may have changed since a worker staged it
+	const std::vector<TextureMipLevel>& mipLevels = text.data.mipLevels;
+	int firstLevel = 0;
+	while (firstLevel + 1 < static_cast<int>(mipLevels.size()) && TextureStreamer::GetLevelsSize(mipLevels, firstLevel) > text.stagingData.size)
+		firstLevel++;
+
+	const size_t begin = mipLevels[firstLevel].offset;
+
+	generatedTexture.Allocate(text, text.data, firstLevel);
+	if (firstLevel > 0)
+		textureStreamer.Register(text, text.data, firstLevel);
+
+	UploadQueue::Request request;
+	request.staging = text.stagingData;
+	text.stagingData = {};
+
+	for (int level = firstLevel; level < static_cast<int>(mipLevels.size()); ++level)
+	{
+		const TextureMipLevel& mip = mipLevels[level];
+
+		UploadQueue::TextureCopy& copy = request.textureCopies.emplace_back();
+		copy.texture = generatedTexture.GetID();
+		copy.level = level - firstLevel;
+		copy.width = mip.width;
+		copy.height = mip.height;
+		copy.format = text.data.compressed ? text.data.internalFormat : text.data.format;
+		copy.type = text.data.type;
+		copy.compressed = text.data.compressed;
+		copy.srcOffset = request.staging.offset + (mip.offset - begin);
+		copy.size = mip.size;
+	}
+
+	request.onComplete = [&text, &gpuData]() {
+		gpuData.uploadTicket = 0;
+		text.TrySetState(RESOURCE_STATE::GPU_READY);
+		};
+
+	gpuData.uploadTicket = uploadQueue.Submit(std::move(request));
 }
 
 
@@ -280,6 +875,9 @@ void RenderGPUWrapper::RemoveMeshData(Mesh& mesh)
 	unsigned int invalidGPUDataCount = 0;
 	unsigned int notFoundGPUDataCount = 0;
 
+	uploadQueue.Release(mesh.stagingData);
+	mesh.stagingData = {};
+
 	for (MeshData& data : mesh.subMeshes)
 	{
 		if (data.GPUData == nullptr)
@@ -290,6 +888,9 @@ void RenderGPUWrapper::RemoveMeshData(Mesh& mesh)
 
 		bool found = false;
 
+		// The vertices may still be waiting in the upload queue
+		uploadQueue.Cancel(data.GPUData->uploadTicket);
+
 		GPUMeshData const* gpuMeshData = data.GPUData;
 		auto gpuMeshIt = std::find_if(GPUMeshDatas.begin(), GPUMeshDatas.end(),
 			[gpuMeshData](GPUMeshData const& gpuData) { return &gpuData == gpuMeshData; });
@@ -298,10 +899,11 @@ void RenderGPUWrapper::RemoveMeshData(Mesh& mesh)
 		{
 			found = true;
 
-			// Free old space
-			glNamedBufferSubData(meshVBO.GetID(), data.GPUData->offset, data.GPUData->size, nullptr);
+			// Free old space, it is reused by the next meshes
+			FreeMeshRanges(data.GPUData->layout == EVertexLayout::FLOAT ? meshVBO : packedMeshVBO, *data.GPUData);
 
 			GPUMeshDatas.erase(gpuMeshIt);
+			data.GPUData = nullptr;
 		}
 
 		//for (auto const& gpuData : GPUMeshDatas)//size_t i = 0; i < GPUMeshDatas.size(); i++)
@@ -344,18 +946,19 @@ void RenderGPUWrapper::RemoveSkeletalMeshData(SkeletalMesh& skMesh)
 		bool found = false;
 
 		GPUMeshData const* gpuMeshData = data.GPUData;
-		auto gpuMeshIt = std::find_if(GPUMeshDatas.begin(), GPUMeshDatas.end(),
+		auto gpuMeshIt = std::find_if(GPUSkeletalMeshDatas.begin(), GPUSkeletalMeshDatas.end(),
 			[gpuMeshData](GPUMeshData const& gpuData) { return &gpuData == gpuMeshData; });
 
-		if (gpuMeshIt != GPUMeshDatas.end())
+		if (gpuMeshIt != GPUSkeletalMeshDatas.end())
 		{
 			found = true;
 
-			// Free old space
-			glNamedBufferSubData(skeletalMeshVBO.GetID(), data.GPUData->offset, data.GPUData->size, nullptr);
+			// Free old space, the bone data range follows the vertices
+			FreeMeshRanges(skeletalMeshVBO, *data.GPUData);
 
 			//	Then remove datas from the list
-			GPUMeshDatas.erase(gpuMeshIt);
+			GPUSkeletalMeshDatas.erase(gpuMeshIt);
+			data.GPUData = nullptr;
 		}
 
 		if (!found) notFoundGPUDataCount++;
@@ -384,10 +987,8 @@ void RenderGPUWrapper::RemoveSkeletalMeshData(SkeletalMesh& skMesh)
 		{
 			found = true;
 
-			// Free old space
-			glNamedBufferSubData(skeletalDataVBO.GetID(), data.GPUData->offset, data.GPUData->size, nullptr);
-
 			GPUSkeletalDatas.erase(gpuSkIt);
+			data.GPUData = nullptr;
 		}
 
 		if (!found)
@@ -404,6 +1005,11 @@ void RenderGPUWrapper::RemoveSkeletalMeshData(SkeletalMesh& skMesh)
 
 void RenderGPUWrapper::RemoveTextureData(Texture& text)
 {
+	uploadQueue.Release(text.stagingData);
+	text.stagingData = {};
+
+	textureStreamer.Unregister(text);
+
 	if (text.GPUData == nullptr)
 	{
 		Logger::Warning("RenderGPUWrapper - RemoveTextureData : GPUData not valid : " + text.GetName());
@@ -417,6 +1023,9 @@ void RenderGPUWrapper::RemoveTextureData(Texture& text)
 
 	if (gpuTexIt != GPUTextureDatas.end())
 	{
+		// The pixels may still be waiting in the upload queue
+		uploadQueue.Cancel(gpuTexIt->uploadTicket);
+
 		// Find the texture generated primitive
 		GLTexture const* genTex = gpuTexIt->generatedTexture;
 		auto genTexIt = std::find_if(GeneratedTextures.begin(), GeneratedTextures.end(),
@@ -1,17 +1,26 @@
 	#include "Renderer/RenderSystem.hpp"
 
+#include <chrono>
+#include <algorithm>
 #include <glad/gl.h>
 
 #include "Core/Logger.hpp"
+#include "Core/Time.hpp"
 #include "Maths/Maths.hpp"
 #include "Renderer/MeshInstance.hpp"
 #include "Renderer/Shadertype.hpp"
 #include "Renderer/MaterialSurface.hpp"
 #include "Renderer/RenderConfig.hpp"
+#include "Renderer/ShaderCache.hpp"
 #include "ECS/MeshComponent.hpp"
 #include "ECS/SkeletalMeshComponent.hpp"
 #include "ECS/LightComponent.hpp"
 #include "ECS/Systems/CameraSystem.hpp"
+#include "ECS/Transform.hpp"
+#include "Resources/ResourcesManager.hpp"
+#include "Resources/Resource/Material.hpp"
+#include "Resources/Resource/Mesh.hpp"
+#include "Renderer/GPUMeshData.hpp"
 #include "EngineContext.hpp"
 
 //	DEBUG
@@ -29,6 +38,8 @@ RenderSystem::RenderInitializer::RenderInitializer()
 	glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
 	glDebugMessageCallback(debugCallback, NULL);
 	glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DEBUG_SEVERITY_NOTIFICATION, 0, nullptr, GL_FALSE);
+
+	ShaderCache::Initialize();
 }
 
 RenderSystem::~RenderSystem()
@@ -40,14 +51,31 @@ RenderSystem::~RenderSystem()
 
 void RenderSystem::Initialize()
 {
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
 	graphicsSettings.Initialize();
 
+	//	Every program is submitted before the first one is used : with parallel compilation the driver links them together,
+	//	the Initialize calls below then wait for each one
+	unlitShader.GenerateShaders();
+	litShader.GenerateShaders();
+	pbrShader.GenerateShaders();
+	utils.GenerateShaders();
+	m_opaqueRenderPipeline.GenerateShaders();
+	m_transparentRenderPipeline.GenerateShaders();
+	m_skyboxRenderPipeline.GenerateShaders();
+	debugRenderPipeline.GenerateShaders();
+	m_particleRenderPipeline.GenerateShaders();
+	m_shadowProcess.GenerateShaders();
+
 	//	ShadersPipeline
 	unlitShader.Initialize();
 	litShader.Initialize();
 	pbrShader.Initialize();
 
 	GPUWrapper.CreateVertexObjects();
+	GPUWrapper.uploadQueue.Initialize(Upload_Staging_Size);
+	GPUWrapper.textureStreamer.Initialize(&GPUWrapper.uploadQueue, &EngineContext::Instance().resourcesManager->GetTaskPool());
 	GPUWrapper.GeneratedTextureArray.Generate();
 	GPUWrapper.GeneratedDepthMapTextureArray.Generate();
 	GPUWrapper.GeneratedDepthCubeMapTextureArray.Generate();
@@ -83,6 +111,12 @@ void RenderSystem::Initialize()
 	glBindBufferRange(GL_UNIFORM_BUFFER, UBOIndex_Lights, m_LightUBO, 0, sizeof(Light) * Max_Lights_Count + sizeof(int));
 	
 	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+	// Startup cost of the shaders, with a cold or a warm shader cache
+	const ShaderCache::Stats shaderStats = ShaderCache::GetStats();
+	const long long milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+	Logger::Info("RenderSystem - Initialized in " + std::to_string(milliseconds) + " ms : " + std::to_string(shaderStats.loadedPrograms)
+		+ " shader programs from the cache, " + std::to_string(shaderStats.compiledPrograms) + " compiled");
 }
 
 void RenderSystem::AttachNewSkybox(Skybox* skybox)
@@ -116,22 +150,14 @@ void RenderSystem::Register(MeshInstance* instance)
 		m_opaqueRenderPipeline.AddMeshInstance(instance);
 	}
 
-	auto it = std::find(m_allMeshInstances.begin(), m_allMeshInstances.end(), const_cast<MeshInstance*>(instance));
-	if (it == m_allMeshInstances.end())
-	{
-		m_allMeshInstances.emplace_back(instance);
-	}
+	m_allMeshInstances.Add(instance);
 }
 
 void RenderSystem::Unregister(MeshInstance* instance)
 {
 	if (instance->savedPipeline) instance->savedPipeline->RemoveMeshInstance(instance);
 
-	auto it = std::find(m_allMeshInstances.begin(), m_allMeshInstances.end(), const_cast<MeshInstance*>(instance));
-	if (it != m_allMeshInstances.end())
-	{
-		m_allMeshInstances.erase(it);
-	}
+	m_allMeshInstances.Remove(instance);
 }
 
 void RenderSystem::Register(SkeletalMeshInstance* instance)
@@ -155,22 +181,42 @@ void RenderSystem::Register(SkeletalMeshInstance* instance)
 		m_opaqueRenderPipeline.AddSkeletalMeshInstance(instance);
 	}
 
-	auto it = std::find(m_allSkeletalMeshInstances.begin(), m_allSkeletalMeshInstances.end(), const_cast<SkeletalMeshInstance*>(instance));
-	if (it == m_allSkeletalMeshInstances.end())
-	{
-		m_allSkeletalMeshInstances.emplace_back(instance);
-	}
+	m_allSkeletalMeshInstances.Add(instance);
 }
 
 void RenderSystem::Unregister(SkeletalMeshInstance* instance)
 {
 	if (instance->savedPipeline) instance->savedPipeline->RemoveSkeletalMeshInstance(instance);
-	
-	auto it = std::find(m_allSkeletalMeshInstances.begin(), m_allSkeletalMeshInstances.end(), const_cast<SkeletalMeshInstance*>(instance));
-	if (it != m_allSkeletalMeshInstances.end())
-	{
-		m_allSkeletalMeshInstances.erase(it);
-	}
+
+	m_allSkeletalMeshInstances.Remove(instance);
+}
+
+void RenderSystem::RegisterMany(std::span<MeshInstance* const> instances)
+{
+	m_allMeshInstances.Reserve(m_allMeshInstances.Size() + instances.size());
+
+	for (MeshInstance* instance : instances)
+		Register(instance);
+}
+
+void RenderSystem::UnregisterMany(std::span<MeshInstance* const> instances)
+{
+	for (MeshInstance* instance : instances)
+		Unregister(instance);
+}
+
+void RenderSystem::RegisterMany(std::span<SkeletalMeshInstance* const> instances)
+{
+	m_allSkeletalMeshInstances.Reserve(m_allSkeletalMeshInstances.Size() + instances.size());
+
+	for (SkeletalMeshInstance* instance : instances)
+		Register(instance);
+}
+
+void RenderSystem::UnregisterMany(std::span<SkeletalMeshInstance* const> instances)
+{
+	for (SkeletalMeshInstance* instance : instances)
+		Unregister(instance);
 }
 
 
@@ -184,6 +230,11 @@ void RenderSystem::Unregister(ParticleComponent* particleComp)
 	m_particleRenderPipeline.RemoveParticleInstance(particleComp);
 }
 
+void RenderSystem::UnregisterMany(std::span<ParticleComponent* const> particleComps)
+{
+	m_particleRenderPipeline.RemoveParticleInstances(particleComps);
+}
+
 
 LightComponent* RenderSystem::AddLightInstance(rfk::Class const& archetype, GameObject& owner, const HYGUID& id)
 {
@@ -208,14 +259,20 @@ void RenderSystem::RemoveLightInstance(LightComponent& lightComp)
 	m_lights.erase(it);
 }
 
-const std::vector<const MeshInstance*>& RenderSystem::GetAllMeshInstances() const
+void RenderSystem::RemoveSceneLightInstances(const HYGUID& sceneID)
 {
-	return m_allMeshInstances;
+	std::erase_if(m_lights,
+		[&sceneID](std::unique_ptr<LightComponent>& lightComp) { return lightComp->gameObject.GetSceneID() == sceneID; });
 }
 
-const std::vector<const SkeletalMeshInstance*>& RenderSystem::GetAllSkeletalMeshInstances() const
+const std::vector<MeshInstance*>& RenderSystem::GetAllMeshInstances() const
 {
-	return m_allSkeletalMeshInstances;
+	return m_allMeshInstances.GetProxies();
+}
+
+const std::vector<SkeletalMeshInstance*>& RenderSystem::GetAllSkeletalMeshInstances() const
+{
+	return m_allSkeletalMeshInstances.GetProxies();
 }
 
 const std::vector<std::unique_ptr<LightComponent>>& RenderSystem::GetAllLights() const
@@ -268,6 +325,10 @@ void RenderSystem::Render(RenderpassParameters& param)
 
 	glEnable(GL_DEPTH_TEST);
 
+	// Levels of detail are selected before the shadow maps, which draw them too
+	Vector2 viewportDimensions = param.GetViewportDimensions();
+	SelectMeshLODs(*currentCam, viewportDimensions.y);
+
 	for (unsigned int i : m_renderPipelinesCallOrder)
 	{
 		m_renderPipelines[i]->PreRender();
@@ -281,7 +342,8 @@ void RenderSystem::Render(RenderpassParameters& param)
 
 	glEnable(GL_CULL_FACE);
 
-	Vector2 viewportDimensions = param.GetViewportDimensions();
+	RequestStreamedTextures(*currentCam, viewportDimensions.y);
+	CullMeshlets(*currentCam);
 	glViewport(0, 0, static_cast<GLsizei>(viewportDimensions.x), static_cast<GLsizei>(viewportDimensions.y));
 	glClearColor(Maths::Pow(clearColor.r,2.2f), Maths::Pow(clearColor.g, 2.2f), Maths::Pow(clearColor.b, 2.2f), clearColor.a);
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
@@ -300,6 +362,131 @@ void RenderSystem::Render(RenderpassParameters& param)
 	SystemManager::GetCameraSystem().renderingCamera = nullptr;
 }
 
+void RenderSystem::UpdateUploads()
+{
+	TextureStreamer::Settings streamingSettings = GPUWrapper.textureStreamer.GetSettings();
+	streamingSettings.enabled = graphicsSettings.textureStreaming;
+	streamingSettings.budgetBytes = static_cast<size_t>(graphicsSettings.textureStreamingBudgetMB) * 1024 * 1024;
+	GPUWrapper.textureStreamer.SetSettings(streamingSettings);
+
+	GPUWrapper.textureStreamer.Update();
+	GPUWrapper.uploadQueue.Update(graphicsSettings.uploadBudgetPerFrame);
+	GPUWrapper.Defragment(graphicsSettings.meshDefragmentBudgetPerFrame);
+}
+
+void RenderSystem::RequestStreamedTextures(const Camera& camera, float viewportHeight)
+{
+	TextureStreamer& streamer = GPUWrapper.textureStreamer;
+	const Vector3 cameraPosition = camera.GetPosition();
+
+	// Pixels covered by one world unit seen at one unit from the camera
+	const float pixelsPerUnit = viewportHeight * 0.5f / Maths::Tan(camera.GetFOV() * Maths::DEGTORAD * 0.5f);
+
+	auto request = [&](const MeshInstance* instance)
+		{
+			if (!instance->isActive || !instance->mesh || !instance->material || !instance->transform) return;
+
+			const GPUMeshData* gpuData = instance->mesh->GPUData;
+			if (gpuData == nullptr) return;
+
+			// Size on screen of the bounding sphere, from its closest point. Points are row vectors : the world matrix is on the right
+			Vector4 center = Matrix4::Multiply(Vector4(gpuData->boundsCenter, 1.f), instance->transform->GetWorldMatrix());
+			float radius = gpuData->boundsRadius * instance->transform->Scale().GetAbsMax();
+			float distance = Maths::Max((Vector3(center.x, center.y, center.z) - cameraPosition).Magnitude() - radius, camera.GetNear());
+			float pixels = 2.f * radius * pixelsPerUnit / distance;
+
+			const MaterialData& material = instance->material->data;
+			float texels = pixels * Maths::Max(Maths::Abs(material.tiling.x), Maths::Abs(material.tiling.y));
+
+			for (const Texture* texture : { material.diffuseTexture, material.normalTexture, material.emissiveTexture, material.maskTexture,
+				material.specularTexture, material.metallicTexture, material.roughnessTexture, material.aoTexture })
+			{
+				if (texture) streamer.RequestTexels(texture, texels);
+			}
+		};
+
+	for (const MeshInstance* instance : GetAllMeshInstances())
+		request(instance);
+
+	for (const SkeletalMeshInstance* instance : GetAllSkeletalMeshInstances())
+		request(instance);
+}
+
+void RenderSystem::SelectMeshLODs(const Camera& camera, float viewportHeight)
+{
+	MeshLODSelector::Settings settings;
+	settings.enabled = graphicsSettings.meshLOD;
+	settings.maxPixelError = graphicsSettings.meshLODPixelError;
+	settings.hysteresis = graphicsSettings.meshLODHysteresis;
+	settings.crossfade = graphicsSettings.meshLODCrossfade;
+
+	// Each camera renders once a frame, its crossfades advance by one frame
+	const float deltaTime = EngineContext::Instance().time->GetUnscaledDeltaTime();
+	const Vector3 cameraPosition = camera.GetPosition();
+	const float pixelsPerUnit = viewportHeight * 0.5f / Maths::Tan(camera.GetFOV() * Maths::DEGTORAD * 0.5f);
+
+	m_renderCount++;
+
+	for (MeshInstance* instance : GetAllMeshInstances())
+	{
+		if (!instance->isActive || !instance->mesh || !instance->transform) continue;
+
+		const GPUMeshData* gpuData = instance->mesh->GPUData;
+		if (gpuData == nullptr || instance->mesh->lods.empty())
+		{
+			instance->lodState = MeshLODState();
+			instance->viewLodStates.clear();
+			continue;
+		}
+
+		// Radius on screen of the bounding sphere, from its closest point
+		Vector4 center = Matrix4::Multiply(Vector4(gpuData->boundsCenter, 1.f), instance->transform->GetWorldMatrix());
+		float radius = gpuData->boundsRadius * instance->transform->Scale().GetAbsMax();
+		float distance = Maths::Max((Vector3(center.x, center.y, center.z) - cameraPosition).Magnitude() - radius, camera.GetNear());
+		float pixels = radius * pixelsPerUnit / distance;
+
+		MeshLODState& viewState = MeshLODSelector::GetViewState(instance->viewLodStates, camera, m_renderCount);
+
+		uint32_t lod = MeshLODSelector::SelectLOD(instance->mesh->lods, pixels, viewState.lod, settings);
+		MeshLODSelector::Update(viewState, lod, deltaTime, settings);
+
+		// Drawn by the shadow maps and the pipelines of this pass
+		instance->lodState = viewState;
+	}
+}
+
+void RenderSystem::CullMeshlets(const Camera& camera)
+{
+	m_meshletStats = MeshletCullingStats();
+
+	const Matrix4 viewProjection = camera.GetProjectionMatrix() * camera.GetViewMatrix();
+	const Vector4 cameraPosition(camera.GetPosition(), 1.f);
+
+	for (MeshInstance* instance : GetAllMeshInstances())
+	{
+		// Instances drawn whole : the finest level is not drawn, or it has no meshlets
+		const bool drawsFinestLevel = instance->lodState.lod == 0 || (instance->lodState.previousLod == 0 && instance->lodState.fade < 1.f);
+		if (!graphicsSettings.meshletCulling || !instance->isActive || !instance->mesh || !instance->transform
+			|| instance->mesh->meshlets.empty() || !drawsFinestLevel)
+		{
+			instance->meshletBatch.Clear();
+			continue;
+		}
+
+		// Culled in the space of the sub mesh, the meshlets bounds are not transformed
+		const Matrix4& world = instance->transform->GetWorldMatrix();
+		const MeshletCuller::Frustum frustum = MeshletCuller::ExtractFrustum(viewProjection * world);
+		const Vector4 localCamera = Matrix4::Multiply(cameraPosition, Matrix4::Inverse(world));
+
+		MeshletCuller::Cull(instance->mesh->meshlets, frustum, localCamera.xyz, instance->meshletBatch, &m_meshletStats);
+	}
+}
+
+const MeshletCullingStats& RenderSystem::GetMeshletCullingStats() const
+{
+	return m_meshletStats;
+}
+
 void RenderSystem::UpdateLightUBO()
 {
 	GLsizei lightsSize = 0;
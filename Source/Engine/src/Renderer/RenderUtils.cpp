@@ -40,10 +40,14 @@ void main()
 
 #pragma endregion
 
-void RenderUtils::Initialize()
+void RenderUtils::GenerateShaders()
 {
 	m_imageScreenShader.Generate(imageScreenVertexShader, imageScreenFragmentShader);
+}
 
+void RenderUtils::Initialize()
+{
+	glUseProgram(m_imageScreenShader.GetID());
 	glUniform1i(glGetUniformLocation(m_imageScreenShader.GetID(), "uScreenTexture"), 0);
 
 	screenRect.Bind();
@@ -0,0 +1,237 @@
+#include "Renderer/ShaderCache.hpp"
+
+#include <vector>
+#include <fstream>
+#include <cstring>
+#include <sstream>
+#include <iomanip>
+#include <filesystem>
+
+#include <glad/gl.h>
+#include <GLFW/glfw3.h>
+
+#include "Core/Logger.hpp"
+#include "Tools/PathConfig.hpp"
+
+namespace fs = std::filesystem;
+
+namespace
+{
+	constexpr char BinaryMagic[4] = { 'H', 'Y', 'S', 'P' };
+	constexpr uint32_t BinaryVersion = 1;
+
+	// Let the driver choose its number of compiler threads
+	constexpr unsigned int AllCompilerThreads = 0xFFFFFFFF;
+
+	// Entry point of GL_KHR_parallel_shader_compile, loaded by hand : the extension may be missing from the loader
+	using MaxShaderCompilerThreadsFunction = void (*)(GLuint count);
+
+	/**
+	@brief Layout of a cached program : header then the driver binary
+	*/
+	struct BinaryHeader
+	{
+		char		magic[4];
+		uint32_t	version;
+		uint32_t	binaryFormat;
+		uint32_t	padding;
+		uint64_t	driverHash[2];
+		uint64_t	sourceHash[2];
+		uint64_t	binarySize;
+	};
+
+	bool s_binaryCacheEnabled = false;
+	Hash128 s_driverHash;
+	ShaderCache::Stats s_stats;
+
+	std::string GetGLString(GLenum name)
+	{
+		const GLubyte* string = glGetString(name);
+		return string ? reinterpret_cast<const char*>(string) : "";
+	}
+
+	bool HasExtension(const char* extension)
+	{
+		GLint extensionCount = 0;
+		glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+
+		for (GLint i = 0; i < extensionCount; ++i)
+		{
+			const GLubyte* name = glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i));
+			if (name && std::strcmp(reinterpret_cast<const char*>(name), extension) == 0)
+				return true;
+		}
+
+		return false;
+	}
+
+	std::string GetProgramPath(const Hash128& sourceHash)
+	{
+		std::stringstream name;
+		name << std::hex << std::setfill('0') << std::setw(16) << sourceHash.high << std::setw(16) << sourceHash.low << ".bin";
+
+		return std::string(CACHE_ROOT) + R"(Shaders\)" + name.str();
+	}
+}
+
+void ShaderCache::Initialize()
+{
+	const std::string renderer = GetGLString(GL_RENDERER);
+
+	// Binaries are only valid for the driver which built them, an update changes the version string
+	s_driverHash = ContentHash::Compute(GetGLString(GL_VENDOR) + '\n' + renderer + '\n' + GetGLString(GL_VERSION));
+
+	GLint binaryFormatCount = 0;
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binaryFormatCount);
+	s_binaryCacheEnabled = binaryFormatCount > 0;
+
+	MaxShaderCompilerThreadsFunction maxShaderCompilerThreads = nullptr;
+	if (HasExtension("GL_KHR_parallel_shader_compile"))
+		maxShaderCompilerThreads = reinterpret_cast<MaxShaderCompilerThreadsFunction>(glfwGetProcAddress("glMaxShaderCompilerThreadsKHR"));
+	else if (HasExtension("GL_ARB_parallel_shader_compile"))
+		maxShaderCompilerThreads = reinterpret_cast<MaxShaderCompilerThreadsFunction>(glfwGetProcAddress("glMaxShaderCompilerThreadsARB"));
+
+	if (maxShaderCompilerThreads)
+		maxShaderCompilerThreads(AllCompilerThreads);
+
+	Logger::Info("ShaderCache - " + renderer + " : binary cache " + (s_binaryCacheEnabled ? "on" : "off (no binary format)")
+		+ ", parallel compile " + (maxShaderCompilerThreads ? "on" : "off"));
+}
+
+Hash128 ShaderCache::HashSources(const char* vertexShader, const char* fragmentShader, const char* geometryShader)
+{
+	// Separators keep a source moved from one stage to the next from giving the same key
+	std::string sources = std::string(vertexShader) + '\0' + fragmentShader + '\0';
+	if (geometryShader)
+		sources += geometryShader;
+
+	return ContentHash::Compute(sources);
+}
+
+bool ShaderCache::LoadProgram(unsigned int program, const Hash128& sourceHash)
+{
+	if (!s_binaryCacheEnabled)
+	{
+		s_stats.compiledPrograms++;
+		return false;
+	}
+
+	const std::string path = GetProgramPath(sourceHash);
+	std::ifstream file(path, std::ios::binary);
+	if (!file.is_open())
+	{
+		s_stats.compiledPrograms++;
+		return false;
+	}
+
+	BinaryHeader header;
+	file.read(reinterpret_cast<char*>(&header), sizeof(BinaryHeader));
+
+	if (!file || std::memcmp(header.magic, BinaryMagic, sizeof(BinaryMagic)) != 0 || header.version != BinaryVersion
+		|| header.sourceHash[0] != sourceHash.low || header.sourceHash[1] != sourceHash.high)
+	{
+		Logger::Warning("ShaderCache - Invalid program binary, compiled again : " + path);
+		s_stats.compiledPrograms++;
+		return false;
+	}
+
+	if (header.driverHash[0] != s_driverHash.low || header.driverHash[1] != s_driverHash.high)
+	{
+		Logger::Info("ShaderCache - Program binary built by another driver, compiled again : " + path);
+		s_stats.compiledPrograms++;
+		return false;
+	}
+
+	std::vector<char> binary(header.binarySize);
+	file.read(binary.data(), static_cast<std::streamsize>(binary.size()));
+	if (!file)
+	{
+		Logger::Warning("ShaderCache - Truncated program binary, compiled again : " + path);
+		s_stats.compiledPrograms++;
+		return false;
+	}
+
+	glProgramBinary(program, header.binaryFormat, binary.data(), static_cast<GLsizei>(binary.size()));
+
+	// The driver may still reject a binary of the same version string, the program is then unlinked
+	GLint success = GL_FALSE;
+	glGetProgramiv(program, GL_LINK_STATUS, &success);
+	if (!success)
+	{
+		Logger::Info("ShaderCache - Program binary rejected by the driver, compiled again : " + path);
+		s_stats.compiledPrograms++;
+		return false;
+	}
+
+	s_stats.loadedPrograms++;
+	return true;
+}
+
+void ShaderCache::SaveProgram(unsigned int program, const Hash128& sourceHash)
+{
+	if (!s_binaryCacheEnabled)
+		return;
+
+	GLint binarySize = 0;
+	glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binarySize);
+	if (binarySize <= 0)
+		return;
+
+	std::vector<char> binary(static_cast<size_t>(binarySize));
+	GLenum binaryFormat = 0;
+	GLsizei writtenSize = 0;
+	glGetProgramBinary(program, binarySize, &writtenSize, &binaryFormat, binary.data());
+	if (writtenSize <= 0)
+		return;
+
+	BinaryHeader header;
+	std::memset(&header, 0, sizeof(BinaryHeader));
+	std::memcpy(header.magic, BinaryMagic, sizeof(BinaryMagic));
+	header.version = BinaryVersion;
+	header.binaryFormat = binaryFormat;
+	header.driverHash[0] = s_driverHash.low;
+	header.driverHash[1] = s_driverHash.high;
+	header.sourceHash[0] = sourceHash.low;
+	header.sourceHash[1] = sourceHash.high;
+	header.binarySize = static_cast<uint64_t>(writtenSize);
+
+	const std::string path = GetProgramPath(sourceHash);
+
+	std::error_code error;
+	fs::create_directories(fs::path(path).parent_path(), error);
+
+	// Write next to the binary then replace it, a crash never leaves a partial binary
+	const std::string temporaryPath = path + ".tmp";
+	{
+		std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+		if (!file.is_open())
+		{
+			Logger::Warning("ShaderCache - Can't open program binary : " + temporaryPath);
+			return;
+		}
+
+		file.write(reinterpret_cast<const char*>(&header), sizeof(BinaryHeader));
+		file.write(binary.data(), writtenSize);
+
+		// A full disk may only be reported when the stream is flushed
+		file.close();
+		if (file.fail())
+		{
+			fs::remove(temporaryPath, error);
+			Logger::Warning("ShaderCache - Can't write program binary : " + path);
+			return;
+		}
+	}
+
+	fs::rename(temporaryPath, path, error);
+	if (error)
+	{
+		fs::remove(temporaryPath, error);
+		Logger::Warning("ShaderCache - Can't replace program binary : " + path);
+	}
+}
+
+ShaderCache::Stats ShaderCache::GetStats()
+{
+	return s_stats;
+}
@@ -14,14 +14,20 @@ static const char* meshShadowMapVertexShaderStr = R"GLSL(
 #version 450 core
 
 // Attributes
-layout(location = 0) in vec3 aPosition;
+layout(location = 0) in vec4 aPosition;
 
 // Uniforms
 uniform mat4 uSpotLightMatrix;
 
+//  VERTEX DECODING :
+//    position offset     |       ...
+//    position scale      |       ...
+
+uniform vec4 uVertexDecode[2];
+
 void main()
 {
-    gl_Position = uSpotLightMatrix * vec4(aPosition, 1.0);
+    gl_Position = uSpotLightMatrix * vec4(uVertexDecode[0].xyz + aPosition.xyz * uVertexDecode[1].xyz, 1.0);
 })GLSL";
 
 static const char* skeletalMeshShadowMapVertexShaderStr = R"GLSL(
@@ -73,15 +79,21 @@ static const char* meshShadowCubeMapVertexShaderStr = R"GLSL(
 #version 450 core
 
 // Attributes
-layout(location = 0) in vec3 aPosition;
+layout(location = 0) in vec4 aPosition;
 
 // Uniforms
 
 uniform mat4 uModel;
 
+//  VERTEX DECODING :
+//    position offset     |       ...
+//    position scale      |       ...
+
+uniform vec4 uVertexDecode[2];
+
 void main()
 {
-    gl_Position = uModel * vec4(aPosition, 1.0);
+    gl_Position = uModel * vec4(uVertexDecode[0].xyz + aPosition.xyz * uVertexDecode[1].xyz, 1.0);
 })GLSL";
 
 static const char* skeletalMeshShadowCubeMapVertexShaderStr = R"GLSL(
@@ -207,15 +219,21 @@ static const char* meshCascadeShadowMapVertexShaderStr = R"GLSL(
 #version 450 core
 
 // Attributes
-layout(location = 0) in vec3 aPosition;
+layout(location = 0) in vec4 aPosition;
 
 // Uniforms
 
 uniform mat4 uModel;
 
+//  VERTEX DECODING :
+//    position offset     |       ...
+//    position scale      |       ...
+
+uniform vec4 uVertexDecode[2];
+
 void main()
 {
-    gl_Position = uModel * vec4(aPosition, 1.0);
+    gl_Position = uModel * vec4(uVertexDecode[0].xyz + aPosition.xyz * uVertexDecode[1].xyz, 1.0);
 })GLSL";
 
 static const char* skeletalMeshCascadeShadowMapVertexShaderStr = R"GLSL(
@@ -297,10 +315,8 @@ ShadowProcess::~ShadowProcess()
 {
 
 }
-void ShadowProcess::Initialize()
+void ShadowProcess::GenerateShaders()
 {
-    EngineContext& engineContext = EngineContext::Instance();
-
     m_meshShadowmapShader.Generate(meshShadowMapVertexShaderStr, shadowMapFragmentShaderStr);
     m_skeletalMeshShadowmapShader.Generate(skeletalMeshShadowMapVertexShaderStr, shadowMapFragmentShaderStr);
 
@@ -309,6 +325,11 @@ void ShadowProcess::Initialize()
 
     m_meshCascadeShadowmapShader.Generate(meshCascadeShadowMapVertexShaderStr, cascadeShadowMapFragmentShaderStr, cascadeShadowMapGeometryShaderStr);;
     m_skeletalMeshCascadeShadowmapShader.Generate(skeletalMeshCascadeShadowMapVertexShaderStr, cascadeShadowMapFragmentShaderStr, cascadeShadowMapGeometryShaderStr);;
+}
+
+void ShadowProcess::Initialize()
+{
+    EngineContext& engineContext = EngineContext::Instance();
 
     //  DEPTH MAP FrameBuffer   
     {
@@ -521,21 +542,22 @@ void ShadowProcess::RenderSpotLightScene(const Matrix4& lightViewProj)
 
     //  MESH RENDERING
 
-    renderSystem.GPUWrapper.meshVAO.Bind();
     m_meshShadowmapShader.Bind();
+    const int vertexDecodeLocation = m_meshShadowmapShader.GetLocationFromUniformName("uVertexDecode[0]");
+    const VertexArray* boundVAO = nullptr;
 
     for (const MeshInstance* instance : renderSystem.GetAllMeshInstances())
     {
+        if (instance->mesh->GPUData == nullptr || instance->mesh->GPUData->uploadTicket != 0)
+            continue;
+
         Matrix4 mvp = lightViewProj * instance->transform->GetWorldMatrix();
         m_meshShadowmapShader.SendUniform("uSpotLightMatrix", mvp.elements);
 
-        glDrawElementsBaseVertex(
-            GL_TRIANGLES,
-            static_cast<GLsizei>(instance->mesh->indices.size()),
-            GL_UNSIGNED_INT,
-            instance->mesh->indices.data(),
-            instance->mesh->GPUData->offset
-        );
+        renderSystem.GPUWrapper.BindMeshVAO(*instance->mesh->GPUData, boundVAO);
+        RenderGPUWrapper::SendVertexDecoding(vertexDecodeLocation, *instance->mesh->GPUData);
+
+        RenderGPUWrapper::DrawElements(*instance->mesh, instance->lodState.lod);
     }
     m_meshShadowmapShader.Unbind();
     renderSystem.GPUWrapper.meshVAO.Unbind();
@@ -553,13 +575,7 @@ void ShadowProcess::RenderSpotLightScene(const Matrix4& lightViewProj)
         const std::vector<Matrix4>& bonesTransform = instance->skeleton->boneTransforms;
         m_skeletalMeshShadowmapShader.SendUniform("uSkinningMatrices[0]", bonesTransform.data(), static_cast<int>(bonesTransform.size()));
 
-        glDrawElementsBaseVertex(
-            GL_TRIANGLES,
-            static_cast<GLsizei>(instance->mesh->indices.size()),
-            GL_UNSIGNED_INT,
-            instance->mesh->indices.data(),
-            instance->mesh->GPUData->offset
-        );
+        RenderGPUWrapper::DrawElements(*instance->mesh);
     }
     m_skeletalMeshShadowmapShader.Unbind();
     renderSystem.GPUWrapper.skeletalMeshVAO.Unbind();
@@ -576,23 +592,24 @@ void ShadowProcess::RenderPointLightScene(const Matrix4 lightViewProj[6], int in
 
     //  MESH RENDERING
 
-    renderSystem.GPUWrapper.meshVAO.Bind();
     m_meshShadowCubemapShader.Bind();
+    const int vertexDecodeLocation = m_meshShadowCubemapShader.GetLocationFromUniformName("uVertexDecode[0]");
+    const VertexArray* boundVAO = nullptr;
     m_meshShadowCubemapShader.SendUniform("uPointLightMatrix[0]", lightViewProj, 6);
     m_meshShadowCubemapShader.SendUniform("uIndex", &index);
     m_meshShadowCubemapShader.SendUniform("uPosition", &lightPosition);
 
     for (const MeshInstance* instance : renderSystem.GetAllMeshInstances())
     {
+        if (instance->mesh->GPUData == nullptr || instance->mesh->GPUData->uploadTicket != 0)
+            continue;
+
         m_meshShadowCubemapShader.SendUniform("uModel", instance->transform->GetWorldMatrix().elements);
 
-        glDrawElementsBaseVertex(
-            GL_TRIANGLES,
-            static_cast<GLsizei>(instance->mesh->indices.size()),
-            GL_UNSIGNED_INT,
-            instance->mesh->indices.data(),
-            instance->mesh->GPUData->offset
-        );
+        renderSystem.GPUWrapper.BindMeshVAO(*instance->mesh->GPUData, boundVAO);
+        RenderGPUWrapper::SendVertexDecoding(vertexDecodeLocation, *instance->mesh->GPUData);
+
+        RenderGPUWrapper::DrawElements(*instance->mesh, instance->lodState.lod);
     }
     m_meshShadowCubemapShader.Unbind();
     renderSystem.GPUWrapper.meshVAO.Unbind();
@@ -611,13 +628,7 @@ void ShadowProcess::RenderPointLightScene(const Matrix4 lightViewProj[6], int in
         m_skeletalMeshShadowCubemapShader.SendUniform("uSkinningMatrices[0]", bonesTransform.data(), static_cast<int>(bonesTransform.size()));
         m_skeletalMeshShadowCubemapShader.SendUniform("uModel", instance->transform->GetWorldMatrix().elements);
 
-        glDrawElementsBaseVertex(
-            GL_TRIANGLES,
-            static_cast<GLsizei>(instance->mesh->indices.size()),
-            GL_UNSIGNED_INT,
-            instance->mesh->indices.data(),
-            instance->mesh->GPUData->offset
-        );
+        RenderGPUWrapper::DrawElements(*instance->mesh);
     }
     m_skeletalMeshShadowCubemapShader.Unbind();
     renderSystem.GPUWrapper.skeletalMeshVAO.Unbind();
@@ -633,25 +644,26 @@ void ShadowProcess::RenderDirectionalLightScene(const Matrix4 lightViewProj[Casc
 
     //  MESH RENDERING
 
-    renderSystem.GPUWrapper.meshVAO.Bind();
     m_meshCascadeShadowmapShader.Bind();
+    const int vertexDecodeLocation = m_meshCascadeShadowmapShader.GetLocationFromUniformName("uVertexDecode[0]");
+    const VertexArray* boundVAO = nullptr;
     m_meshCascadeShadowmapShader.SendUniform("uDirectionalMatrix[0]", lightViewProj, Cascade_Count);
     m_meshCascadeShadowmapShader.SendUniform("uIndex", &index);
 
     for (const MeshInstance* instance : renderSystem.GetAllMeshInstances())
     {
+        if (instance->mesh->GPUData == nullptr || instance->mesh->GPUData->uploadTicket != 0)
+            continue;
+
         if (instance->isActive == false)
             continue;
 
         m_meshCascadeShadowmapShader.SendUniform("uModel", instance->transform->GetWorldMatrix().elements);
 
-        glDrawElementsBaseVertex(
-            GL_TRIANGLES,
-            static_cast<GLsizei>(instance->mesh->indices.size()),
-            GL_UNSIGNED_INT,
-            instance->mesh->indices.data(),
-            instance->mesh->GPUData->offset
-        );
+        renderSystem.GPUWrapper.BindMeshVAO(*instance->mesh->GPUData, boundVAO);
+        RenderGPUWrapper::SendVertexDecoding(vertexDecodeLocation, *instance->mesh->GPUData);
+
+        RenderGPUWrapper::DrawElements(*instance->mesh, instance->lodState.lod);
     }
     m_meshCascadeShadowmapShader.Unbind();
     renderSystem.GPUWrapper.meshVAO.Unbind();
@@ -672,13 +684,7 @@ void ShadowProcess::RenderDirectionalLightScene(const Matrix4 lightViewProj[Casc
         m_skeletalMeshCascadeShadowmapShader.SendUniform("uSkinningMatrices[0]", bonesTransform.data(), static_cast<int>(bonesTransform.size()));
         m_skeletalMeshCascadeShadowmapShader.SendUniform("uModel", instance->transform->GetWorldMatrix().elements);
 
-        glDrawElementsBaseVertex(
-            GL_TRIANGLES,
-            static_cast<GLsizei>(instance->mesh->indices.size()),
-            GL_UNSIGNED_INT,
-            instance->mesh->indices.data(),
-            instance->mesh->GPUData->offset
-        );
+        RenderGPUWrapper::DrawElements(*instance->mesh);
     }
     m_skeletalMeshCascadeShadowmapShader.Unbind();
     renderSystem.GPUWrapper.skeletalMeshVAO.Unbind();
@@ -10,6 +10,7 @@
 #include "Renderer/Primitives/GLCubeMap.hpp"
 #include "Renderer/RenderObjects/Camera.hpp"
 #include "Renderer/GPUMeshData.hpp"
+#include "Renderer/RenderSystem.hpp"
 
 #include "Resources/ResourcesManager.hpp"
 #include "Resources/Resource/Skybox.hpp"
@@ -59,12 +60,15 @@ SkyboxRenderPipeline::~SkyboxRenderPipeline()
 {
 }
 
+void SkyboxRenderPipeline::GenerateShaders()
+{
+    shader.Generate(skyboxVertexShaderStr, skyboxFragmentShaderStr);
+}
+
 void SkyboxRenderPipeline::Initialize()
 {
     int i = 0;
 
-    shader.Generate(skyboxVertexShaderStr, skyboxFragmentShaderStr);
-
     shader.Bind();
     shader.SendUniform("uSkyTexture", &i);
     shader.Unbind();
@@ -83,8 +87,11 @@ void SkyboxRenderPipeline::InitCube()
     GLuint vao = cubeVAO.GetID();
 
     // Allocate vertex buffer storage (empty)
+    // The cube keeps float positions whatever the layout of its mesh file
     MeshData const& data = cubeMesh->subMeshes[0];
-    glNamedBufferStorage(cubeVBO.GetID(), data.GPUData->size, data.vertices.data(), GL_DYNAMIC_STORAGE_BIT);
+    std::vector<Vertex> vertices;
+    std::span<const Vertex> cubeVertices = data.GetVertices(vertices);
+    glNamedBufferStorage(cubeVBO.GetID(), cubeVertices.size_bytes(), cubeVertices.data(), GL_DYNAMIC_STORAGE_BIT);
 
     // Link array and buffer (binding 0)
     glVertexArrayVertexBuffer(vao, 0, cubeVBO.GetID(), 0, sizeof(Vertex));
@@ -93,6 +100,9 @@ void SkyboxRenderPipeline::InitCube()
     glEnableVertexArrayAttrib(vao, 0);
     glVertexArrayAttribBinding(vao, 0, 0);
     glVertexArrayAttribFormat(vao, 0, 3, GL_FLOAT, GL_FALSE, offsetof(Vertex, position));
+
+    // The indices of the cube are read from the index buffer of the meshes
+    SystemManager::GetRenderSystem().GPUWrapper.AttachMeshIndices(cubeVAO);
 }
 
 void SkyboxRenderPipeline::Render()
@@ -110,6 +120,10 @@ void SkyboxRenderPipeline::Render()
         InitCube();
     }
 
+    const GPUMeshData* cubeData = cubeMesh->subMeshes.empty() ? nullptr : cubeMesh->subMeshes[0].GPUData;
+    if (cubeData == nullptr || cubeData->uploadTicket != 0)
+        return;
+
     glCullFace(GL_FRONT);
     glDepthFunc(GL_LEQUAL);
 
@@ -128,11 +142,12 @@ void SkyboxRenderPipeline::Render()
     glActiveTexture(GL_TEXTURE0);
     attachedSkybox->GPUData->Bind();
 
+    // The cube has its own vertex buffer, its first vertex is 0
     glDrawElementsBaseVertex(
         GL_TRIANGLES,
-        static_cast<GLsizei>(cubeMesh->subMeshes[0].indices.size()),
-        GL_UNSIGNED_INT,
-        cubeMesh->subMeshes[0].indices.data(),
+        static_cast<GLsizei>(cubeMesh->subMeshes[0].GetLOD(0).indexCount),
+        cubeData->shortIndices ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT,
+        reinterpret_cast<const void*>(static_cast<uintptr_t>(cubeData->indexOffset)),
         0
     );
 
@@ -0,0 +1,391 @@
+#include "Renderer/TextureStreamer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "Core/ResourcesTaskPool.hpp"
+#include "Renderer/UploadQueue.hpp"
+#include "Renderer/Primitives/GLTexture.hpp"
+
+TextureStreamer::TextureStreamer(bool simulate)
+	: m_simulate(simulate)
+{
+}
+
+TextureStreamer::~TextureStreamer()
+{
+	for (auto& [texture, entry] : m_entries)
+	{
+		if (entry.job)
+		{
+			entry.job->cancelled = true;
+			if (m_uploadQueue != nullptr)
+				m_uploadQueue->Cancel(entry.job->uploadTicket);
+		}
+	}
+}
+
+void TextureStreamer::Initialize(UploadQueue* uploadQueue, ResourcesTaskPool* taskPool)
+{
+	m_uploadQueue = uploadQueue;
+	m_taskPool = taskPool;
+}
+
+void TextureStreamer::SetSettings(const Settings& settings)
+{
+	std::lock_guard lock(m_settingsMutex);
+	m_settings = settings;
+}
+
+TextureStreamer::Settings TextureStreamer::GetSettings() const
+{
+	std::lock_guard lock(m_settingsMutex);
+	return m_settings;
+}
+
+bool TextureStreamer::IsSimulated() const
+{
+	return m_simulate;
+}
+
+
+#pragma region REGISTRATION
+
+size_t TextureStreamer::GetLevelsSize(const std::vector<TextureMipLevel>& levels, int firstLevel)
+{
+	size_t size = 0;
+	for (size_t level = static_cast<size_t>(std::max(firstLevel, 0)); level < levels.size(); ++level)
+		size += levels[level].size;
+
+	return size;
+}
+
+int TextureStreamer::GetInitialLevel(const TextureData& data) const
+{
+	// Called by the loading workers while the main thread may change the settings
+	const Settings settings = GetSettings();
+
+	// Only cooked textures are streamed, their pixels stay available to load the top levels later
+	if (!settings.enabled || !data.storage || data.mipLevels.size() < 2)
+		return 0;
+
+	int level = 0;
+	const int lastLevel = static_cast<int>(data.mipLevels.size()) - 1;
+	while (level < lastLevel && std::max(data.mipLevels[level].width, data.mipLevels[level].height) > settings.initialSize)
+		level++;
+
+	return level;
+}
+
+void TextureStreamer::Register(Texture& texture, const TextureData& source, int initialLevel)
+{
+	auto [it, inserted] = m_entries.try_emplace(&texture);
+	if (!inserted)
+		return;
+
+	Entry& entry = it->second;
+	entry.texture = &texture;
+	entry.source = source;
+	entry.initialLevel = initialLevel;
+	entry.residentLevel = initialLevel;
+	entry.targetLevel = initialLevel;
+	entry.lastUsedFrame = m_frame;
+}
+
+void TextureStreamer::Unregister(const Texture& texture)
+{
+	auto it = m_entries.find(&texture);
+	if (it == m_entries.end())
+		return;
+
+	if (StreamJob* job = it->second.job.get())
+	{
+		job->cancelled = true;
+		if (m_uploadQueue != nullptr)
+			m_uploadQueue->Cancel(job->uploadTicket);
+	}
+
+	m_entries.erase(&texture);
+}
+
+int TextureStreamer::GetResidentLevel(const Texture& texture) const
+{
+	auto it = m_entries.find(&texture);
+	return it != m_entries.end() ? it->second.residentLevel : -1;
+}
+
+void TextureStreamer::RequestTexels(const Texture* texture, float texels)
+{
+	auto it = m_entries.find(texture);
+	if (it == m_entries.end())
+		return;
+
+	Entry& entry = it->second;
+	const std::vector<TextureMipLevel>& levels = entry.source.mipLevels;
+	const float size = static_cast<float>(std::max(levels[0].width, levels[0].height));
+
+	// Each level halves the texels, the level whose size covers the texels on screen is enough
+	int level = texels > 0.f ? static_cast<int>(std::floor(std::log2(size / texels))) : static_cast<int>(levels.size()) - 1;
+	level = std::clamp(level, 0, static_cast<int>(levels.size()) - 1);
+
+	entry.requestedLevel = entry.requestedLevel < 0 ? level : std::min(entry.requestedLevel, level);
+	entry.priority = std::max(entry.priority, texels);
+	entry.lastUsedFrame = m_frame;
+}
+
+#pragma endregion
+
+
+#pragma region RESIDENCY
+
+void TextureStreamer::Update()
+{
+	SubmitStagedJobs();
+
+	const Settings settings = GetSettings();
+
+	std::vector<Entry*> entries;
+	entries.reserve(m_entries.size());
+
+	// Targets : textures drawn last frame get the levels they need, resident levels are kept while the budget allows it
+	size_t wantedBytes = 0;
+	for (auto& [texture, entry] : m_entries)
+	{
+		entry.targetLevel = entry.residentLevel;
+		if (entry.requestedLevel >= 0 && !IsBusy(entry))
+			entry.targetLevel = std::min(entry.requestedLevel, entry.residentLevel);
+
+		wantedBytes += GetLevelsSize(entry.source.mipLevels, entry.targetLevel);
+		entries.push_back(&entry);
+	}
+
+	// Over the budget, the least recently used then the least covered textures lose their top levels first
+	size_t totalBytes = wantedBytes;
+	if (totalBytes > settings.budgetBytes)
+	{
+		std::sort(entries.begin(), entries.end(), [](const Entry* lhs, const Entry* rhs) {
+			if (lhs->lastUsedFrame != rhs->lastUsedFrame)
+				return lhs->lastUsedFrame < rhs->lastUsedFrame;
+			return lhs->priority < rhs->priority;
+			});
+
+		for (Entry* entry : entries)
+		{
+			while (!IsBusy(*entry) && entry->targetLevel < entry->initialLevel && totalBytes > settings.budgetBytes)
+			{
+				totalBytes -= entry->source.mipLevels[entry->targetLevel].size;
+				entry->targetLevel++;
+			}
+
+			if (totalBytes <= settings.budgetBytes)
+				break;
+		}
+	}
+
+	// Evictions are applied at once, stream-ins by decreasing coverage within the frame limit
+	std::vector<Entry*> streamIns;
+	for (Entry* entry : entries)
+	{
+		if (IsBusy(*entry))
+			continue;
+
+		if (entry->targetLevel > entry->residentLevel)
+			Evict(*entry, entry->targetLevel);
+		else if (entry->targetLevel < entry->residentLevel)
+			streamIns.push_back(entry);
+	}
+
+	std::sort(streamIns.begin(), streamIns.end(), [](const Entry* lhs, const Entry* rhs) { return lhs->priority > rhs->priority; });
+	if (streamIns.size() > static_cast<size_t>(std::max(settings.maxStreamInsPerFrame, 0)))
+		streamIns.resize(static_cast<size_t>(std::max(settings.maxStreamInsPerFrame, 0)));
+
+	for (Entry* entry : streamIns)
+		StreamIn(*entry, entry->targetLevel);
+
+	// Requests are gathered again by the draws of this frame
+	for (Entry* entry : entries)
+	{
+		entry->requestedLevel = -1;
+		entry->priority = 0.f;
+	}
+
+	m_stats.wantedBytes = wantedBytes;
+	m_frame++;
+}
+
+bool TextureStreamer::IsBusy(const Entry& entry) const
+{
+	if (entry.job)
+		return true;
+
+	return !m_simulate && (entry.texture->GPUData == nullptr || entry.texture->GPUData->uploadTicket != 0);
+}
+
+void TextureStreamer::Evict(Entry& entry, int newLevel)
+{
+	if (!m_simulate)
+		entry.texture->GPUData->generatedTexture->MoveToLevel(*entry.texture, entry.source, entry.residentLevel, newLevel);
+
+	m_stats.evictedLevels += static_cast<size_t>(newLevel - entry.residentLevel);
+	entry.residentLevel = newLevel;
+}
+
+void TextureStreamer::StreamIn(Entry& entry, int newLevel)
+{
+	const int previousLevel = entry.residentLevel;
+	entry.residentLevel = newLevel;
+
+	if (m_simulate)
+	{
+		m_stats.streamedInLevels += static_cast<size_t>(previousLevel - newLevel);
+		return;
+	}
+
+	// The new storage is created now with the resident levels, the top ones are sampled once uploaded
+	entry.texture->GPUData->generatedTexture->MoveToLevel(*entry.texture, entry.source, previousLevel, newLevel);
+
+	auto job = std::make_shared<StreamJob>();
+	job->texture = entry.texture;
+	job->source = entry.source;
+	job->firstLevel = newLevel;
+	job->lastLevel = previousLevel;
+	job->level = previousLevel - 1;
+
+	entry.job = job;
+	StreamLevel(entry);
+}
+
+void TextureStreamer::StreamLevel(Entry& entry)
+{
+	StreamJob& job = *entry.job;
+	const TextureMipLevel& mip = job.source.mipLevels[job.level];
+
+	// A level larger than the staging buffer would never get its staging memory, it is sent directly
+	if (!m_uploadQueue->FitsInStaging(mip.size))
+	{
+		entry.texture->GPUData->generatedTexture->UploadLevel(job.source, job.level, job.level - job.firstLevel);
+		CompleteLevel(entry);
+		return;
+	}
+
+	DispatchJob(entry.job);
+}
+
+void TextureStreamer::CompleteLevel(Entry& entry)
+{
+	StreamJob& job = *entry.job;
+
+	// The storage starts at the first streamed level, sampling can use the levels uploaded so far
+	entry.texture->GPUData->generatedTexture->SetBaseLevel(job.level - job.firstLevel);
+	m_stats.streamedInLevels++;
+
+	if (job.level == job.firstLevel)
+	{
+		entry.job.reset();
+		return;
+	}
+
+	job.level--;
+	job.staging = {};
+	job.uploadTicket = 0;
+	StreamLevel(entry);
+}
+
+#pragma endregion
+
+
+#pragma region JOBS
+
+void TextureStreamer::DispatchJob(const std::shared_ptr<StreamJob>& job)
+{
+	auto stage = [job, mailbox = m_mailbox, uploadQueue = m_uploadQueue]() {
+		if (!job->cancelled)
+		{
+			const TextureMipLevel& mip = job->source.mipLevels[job->level];
+
+			// Reading the mapped cache may fault pages in, this stays out of the main thread
+			job->staging = uploadQueue->Allocate(mip.size);
+			if (job->staging.IsValid())
+				std::memcpy(job->staging.data, job->source.data + mip.offset, mip.size);
+		}
+
+		std::lock_guard lock(mailbox->mutex);
+		mailbox->stagedJobs.push_back(job);
+		};
+
+	if (m_taskPool != nullptr)
+		m_taskPool->AddMultiThreadTask(stage);
+	else
+		stage();
+}
+
+void TextureStreamer::SubmitStagedJobs()
+{
+	std::vector<std::shared_ptr<StreamJob>> jobs;
+	{
+		std::lock_guard lock(m_mailbox->mutex);
+		jobs.swap(m_mailbox->stagedJobs);
+	}
+
+	for (std::shared_ptr<StreamJob>& job : jobs)
+	{
+		if (job->cancelled)
+		{
+			m_uploadQueue->Release(job->staging);
+			continue;
+		}
+
+		// The staging memory was full, the level fits in it once the older uploads are done
+		if (!job->staging.IsValid())
+		{
+			DispatchJob(job);
+			continue;
+		}
+
+		const TextureMipLevel& mip = job->source.mipLevels[job->level];
+
+		UploadQueue::Request request;
+		request.staging = job->staging;
+
+		UploadQueue::TextureCopy& copy = request.textureCopies.emplace_back();
+		copy.texture = job->texture->GPUData->generatedTexture->GetID();
+		copy.level = job->level - job->firstLevel;
+		copy.width = mip.width;
+		copy.height = mip.height;
+		copy.format = job->source.compressed ? job->source.internalFormat : job->source.format;
+		copy.type = job->source.type;
+		copy.compressed = job->source.compressed;
+		copy.srcOffset = job->staging.offset;
+		copy.size = mip.size;
+
+		request.onComplete = [this, job]() {
+			auto it = m_entries.find(job->texture);
+			if (it == m_entries.end() || it->second.job != job)
+				return;
+
+			CompleteLevel(it->second);
+			};
+
+		job->uploadTicket = m_uploadQueue->Submit(std::move(request));
+	}
+}
+
+#pragma endregion
+
+
+TextureStreamingStats TextureStreamer::GetStats() const
+{
+	TextureStreamingStats stats = m_stats;
+	stats.budgetBytes = GetSettings().budgetBytes;
+	stats.streamedTextures = m_entries.size();
+
+	for (const auto& [texture, entry] : m_entries)
+	{
+		stats.residentBytes += GetLevelsSize(entry.source.mipLevels, entry.residentLevel);
+		if (entry.job)
+			stats.pendingStreamIns++;
+	}
+
+	return stats;
+}
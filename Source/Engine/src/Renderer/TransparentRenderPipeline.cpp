@@ -38,68 +38,54 @@ void TransparentRenderPipeline::AddMeshInstance(MeshInstance* instance)
 {
     if (instance == nullptr) return;
 
-    auto foundComp = std::find(meshes.begin(), meshes.end(), instance);
-
-    if (foundComp != meshes.end())
+    if (!meshes.Add(instance))
     {
         Logger::Warning("MeshRenderPipeline - Can't register one mesh component instance multiple times");
         return;
     }
 
     instance->savedPipeline = this;
-    meshes.emplace_back(instance);
 }
 
 void TransparentRenderPipeline::RemoveMeshInstance(MeshInstance* instance)
 {
-    if (instance == nullptr || meshes.empty()) return;
-
-    auto foundComp = std::find(meshes.begin(), meshes.end(), instance);
-
-    if (foundComp == meshes.end())
+    if (!meshes.Remove(instance))
     {
         return;
     }
 
     instance->savedPipeline = nullptr;
-    meshes.erase(foundComp);
 }
 
 void TransparentRenderPipeline::AddSkeletalMeshInstance(SkeletalMeshInstance* instance)
 {
     if (instance == nullptr) return;
 
-    auto foundComp = std::find(skeletalMeshes.begin(), skeletalMeshes.end(), instance);
-
-    if (foundComp != skeletalMeshes.end())
+    if (!skeletalMeshes.Add(instance))
     {
         Logger::Warning("MeshRenderPipeline - Can't register one mesh component instance multiple times");
         return;
     }
 
     instance->savedPipeline = this;
-    skeletalMeshes.emplace_back(instance);
 }
 
 void TransparentRenderPipeline::RemoveSkeletalMeshInstance(SkeletalMeshInstance* instance)
 {
-    if (instance == nullptr || skeletalMeshes.empty()) return;
-
-    auto foundComp = std::find(skeletalMeshes.begin(), skeletalMeshes.end(), instance);
-
-    if (foundComp == skeletalMeshes.end())
+    if (!skeletalMeshes.Remove(instance))
     {
         return;
     }
 
     instance->savedPipeline = nullptr;
-    skeletalMeshes.erase(foundComp);
 }
 
 
 std::vector<TransparentRenderPipeline::BlendMesh> TransparentRenderPipeline::SortMeshes()
 {
     std::vector<BlendMesh> out;
+    out.reserve(meshes.Size() + skeletalMeshes.Size());
+
     Vector3 camPos = SystemManager::GetCameraSystem().renderingCamera->GetPosition();
 
     for (const MeshInstance* instance : meshes)
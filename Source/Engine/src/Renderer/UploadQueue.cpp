@@ -0,0 +1,343 @@
+#include "Renderer/UploadQueue.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#include <glad/gl.h>
+
+#include "Core/Logger.hpp"
+
+// Staging offsets stay aligned on the strictest pixel and block alignment
+constexpr size_t StagingAlignment = 256;
+
+UploadQueue::~UploadQueue()
+{
+	for (Batch& batch : m_inFlight)
+		glDeleteSync(static_cast<GLsync>(batch.fence));
+
+	if (m_stagingBuffer != 0)
+	{
+		glUnmapNamedBuffer(m_stagingBuffer);
+		glDeleteBuffers(1, &m_stagingBuffer);
+	}
+}
+
+void UploadQueue::Initialize(size_t stagingSize)
+{
+	if (m_stagingBuffer != 0)
+		return;
+
+	const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+	glCreateBuffers(1, &m_stagingBuffer);
+	glNamedBufferStorage(m_stagingBuffer, static_cast<GLsizeiptr>(stagingSize), nullptr, flags);
+	m_mappedData = static_cast<unsigned char*>(glMapNamedBufferRange(m_stagingBuffer, 0, static_cast<GLsizeiptr>(stagingSize), flags));
+
+	if (m_mappedData == nullptr)
+	{
+		Logger::Error("UploadQueue - Initialize : Can't map the staging buffer, uploads stay synchronous");
+		glDeleteBuffers(1, &m_stagingBuffer);
+		m_stagingBuffer = 0;
+		return;
+	}
+
+	m_capacity = stagingSize;
+}
+
+
+#pragma region STAGING
+
+StagingRange UploadQueue::Allocate(size_t size)
+{
+	StagingRange range;
+	if (m_mappedData == nullptr || size == 0)
+		return range;
+
+	const size_t alignedSize = (size + StagingAlignment - 1) / StagingAlignment * StagingAlignment;
+
+	std::lock_guard lock(m_mutex);
+
+	// Allocations are placed one after the other and wrap at the end of the buffer,
+	// the free space is between the end of the newest allocation and the start of the oldest one
+	size_t offset = 0;
+	bool found = false;
+
+	if (m_allocations.empty())
+	{
+		found = alignedSize <= m_capacity;
+	}
+	else
+	{
+		const size_t tail = m_allocations.front().offset;
+		const size_t head = m_allocations.back().offset + m_allocations.back().size;
+
+		if (m_allocations.back().offset >= tail)
+		{
+			if (head + alignedSize <= m_capacity)
+			{
+				offset = head;
+				found = true;
+			}
+			else if (alignedSize <= tail)
+			{
+				found = true;
+			}
+		}
+		else if (head + alignedSize <= tail)
+		{
+			offset = head;
+			found = true;
+		}
+	}
+
+	if (!found)
+	{
+		m_stats.failedAllocations++;
+		return range;
+	}
+
+	Allocation& allocation = m_allocations.emplace_back();
+	allocation.id = m_nextID++;
+	allocation.offset = offset;
+	allocation.size = alignedSize;
+
+	range.id = allocation.id;
+	range.offset = offset;
+	range.size = size;
+	range.data = m_mappedData + offset;
+
+	return range;
+}
+
+void UploadQueue::ReleaseUnsafe(uint64_t id)
+{
+	// Ids are increasing, the allocations are sorted
+	auto it = std::lower_bound(m_allocations.begin(), m_allocations.end(), id,
+		[](const Allocation& allocation, uint64_t value) { return allocation.id < value; });
+
+	if (it == m_allocations.end() || it->id != id)
+		return;
+
+	it->released = true;
+
+	while (!m_allocations.empty() && m_allocations.front().released)
+		m_allocations.pop_front();
+}
+
+bool UploadQueue::FitsInStaging(size_t size) const
+{
+	return m_mappedData != nullptr && size != 0 && (size + StagingAlignment - 1) / StagingAlignment * StagingAlignment <= m_capacity;
+}
+
+void UploadQueue::Release(const StagingRange& range)
+{
+	if (!range.IsValid())
+		return;
+
+	std::lock_guard lock(m_mutex);
+	ReleaseUnsafe(range.id);
+}
+
+#pragma endregion
+
+
+#pragma region REQUESTS
+
+uint64_t UploadQueue::Submit(Request&& request)
+{
+	PendingRequest pending;
+	pending.size = request.staging.size;
+	pending.submitTime = Clock::now();
+	pending.request = std::move(request);
+
+	const uint64_t ticket = pending.request.staging.id;
+
+	std::lock_guard lock(m_mutex);
+	m_queued.emplace_back(std::move(pending));
+
+	return ticket;
+}
+
+void UploadQueue::Cancel(uint64_t ticket)
+{
+	if (ticket == 0)
+		return;
+
+	std::lock_guard lock(m_mutex);
+
+	auto it = std::find_if(m_queued.begin(), m_queued.end(),
+		[ticket](const PendingRequest& pending) { return pending.request.staging.id == ticket; });
+
+	if (it != m_queued.end())
+	{
+		ReleaseUnsafe(ticket);
+		m_queued.erase(it);
+		return;
+	}
+
+	// Already issued, the staging memory is released with its batch
+	for (Batch& batch : m_inFlight)
+	{
+		for (PendingRequest& pending : batch.requests)
+		{
+			if (pending.request.staging.id == ticket)
+			{
+				pending.request.onComplete = nullptr;
+				return;
+			}
+		}
+	}
+}
+
+void UploadQueue::IssueCopies(const Request& request) const
+{
+	for (const BufferCopy& copy : request.bufferCopies)
+	{
+		glCopyNamedBufferSubData(m_stagingBuffer, copy.buffer, static_cast<GLintptr>(copy.srcOffset),
+			static_cast<GLintptr>(copy.dstOffset), static_cast<GLsizeiptr>(copy.size));
+	}
+
+	if (request.textureCopies.empty())
+		return;
+
+	// Pixels are read from the staging buffer, the data pointers become offsets in it
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_stagingBuffer);
+
+	// Rows are tightly packed in the staging buffer, the alignment of the other uploads is restored after the copies
+	GLint unpackAlignment = 4;
+	glGetIntegerv(GL_UNPACK_ALIGNMENT, &unpackAlignment);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+	for (const TextureCopy& copy : request.textureCopies)
+	{
+		const void* offset = reinterpret_cast<const void*>(copy.srcOffset);
+
+		if (copy.compressed)
+			glCompressedTextureSubImage2D(copy.texture, copy.level, 0, 0, copy.width, copy.height, copy.format, static_cast<GLsizei>(copy.size), offset);
+		else
+			glTextureSubImage2D(copy.texture, copy.level, 0, 0, copy.width, copy.height, copy.format, copy.type, offset);
+	}
+
+	glPixelStorei(GL_UNPACK_ALIGNMENT, unpackAlignment);
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+void UploadQueue::IssueRequests(size_t budget)
+{
+	Batch batch;
+	size_t issuedBytes = 0;
+
+	{
+		std::lock_guard lock(m_mutex);
+
+		while (!m_queued.empty())
+		{
+			const size_t size = m_queued.front().size;
+			if (issuedBytes != 0 && issuedBytes + size > budget)
+				break;
+
+			issuedBytes += size;
+			batch.requests.emplace_back(std::move(m_queued.front()));
+			m_queued.pop_front();
+		}
+
+		m_stats.uploadedBytesLastFrame = issuedBytes;
+	}
+
+	if (batch.requests.empty())
+		return;
+
+	for (const PendingRequest& pending : batch.requests)
+		IssueCopies(pending.request);
+
+	batch.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+	std::lock_guard lock(m_mutex);
+	m_inFlight.emplace_back(std::move(batch));
+}
+
+void UploadQueue::RetireBatches(bool wait)
+{
+	// Fences are signaled in order, the first pending one ends the loop
+	while (!m_inFlight.empty())
+	{
+		Batch& batch = m_inFlight.front();
+		GLsync fence = static_cast<GLsync>(batch.fence);
+
+		const GLuint64 timeout = wait ? std::numeric_limits<GLuint64>::max() : 0;
+		const GLenum status = glClientWaitSync(fence, wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0, timeout);
+		if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+			return;
+
+		glDeleteSync(fence);
+
+		const Clock::time_point now = Clock::now();
+		std::vector<PendingRequest> requests;
+
+		{
+			std::lock_guard lock(m_mutex);
+
+			requests = std::move(batch.requests);
+			m_inFlight.pop_front();
+
+			for (const PendingRequest& pending : requests)
+			{
+				ReleaseUnsafe(pending.request.staging.id);
+
+				const double latency = std::chrono::duration<double, std::milli>(now - pending.submitTime).count();
+				m_totalLatencyMs += latency;
+				m_stats.maxLatencyMs = std::max(m_stats.maxLatencyMs, latency);
+				m_stats.completedRequests++;
+			}
+
+			m_stats.averageLatencyMs = m_totalLatencyMs / static_cast<double>(m_stats.completedRequests);
+		}
+
+		// Out of the lock, a callback may allocate and submit another request
+		for (PendingRequest& pending : requests)
+		{
+			if (pending.request.onComplete)
+				pending.request.onComplete();
+		}
+	}
+}
+
+void UploadQueue::Update(size_t frameBudget)
+{
+	RetireBatches(false);
+	IssueRequests(frameBudget);
+}
+
+void UploadQueue::Flush()
+{
+	IssueRequests(std::numeric_limits<size_t>::max());
+	RetireBatches(true);
+}
+
+bool UploadQueue::HasPendingRequests() const
+{
+	std::lock_guard lock(m_mutex);
+	return !m_queued.empty() || !m_inFlight.empty();
+}
+
+UploadStats UploadQueue::GetStats() const
+{
+	std::lock_guard lock(m_mutex);
+
+	UploadStats stats = m_stats;
+
+	for (const Batch& batch : m_inFlight)
+	{
+		stats.inFlightRequests += batch.requests.size();
+		for (const PendingRequest& pending : batch.requests)
+			stats.inFlightBytes += pending.size;
+	}
+
+	stats.queuedRequests = m_queued.size();
+	for (const PendingRequest& pending : m_queued)
+		stats.queuedBytes += pending.size;
+
+	return stats;
+}
+
+#pragma endregion
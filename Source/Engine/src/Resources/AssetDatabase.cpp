@@ -0,0 +1,599 @@
+#include "Resources/AssetDatabase.hpp"
+
+#include <fstream>
+#include <cstring>
+#include <sstream>
+#include <iomanip>
+
+#include <nlohmann/json.hpp>
+
+#include "Core/Logger.hpp"
+#include "Core/ResourcesTaskPool.hpp"
+
+#include "Tools/MappedFile.hpp"
+#include "Tools/StringHelper.hpp"
+#include "Tools/PathConfig.hpp"
+
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+namespace
+{
+	constexpr char ManifestMagic[4] = { 'H', 'Y', 'D', 'B' };
+	constexpr uint32_t ManifestVersion = 1;
+
+	// Number of known directories checked by one task
+	constexpr size_t DirectoryChunkSize = 16;
+
+	// Number of meta files parsed by one task
+	constexpr size_t MetaChunkSize = 32;
+
+	// Time given to directories never scanned, it never matches a real write time
+	constexpr int64_t UnknownTime = INT64_MIN;
+
+	/**
+	@brief Layout of the manifest : header, directories, records, dependencies then the string blob.
+	Strings are referenced by offset and size in the blob, paths are relative to the root directory.
+	*/
+	struct ManifestHeader
+	{
+		char		magic[4];
+		uint32_t	version;
+		uint32_t	directoryCount;
+		uint32_t	recordCount;
+		uint32_t	dependencyCount;
+		uint32_t	padding;
+		uint64_t	stringsSize;
+		uint64_t	directoriesOffset;
+		uint64_t	recordsOffset;
+		uint64_t	dependenciesOffset;
+		uint64_t	stringsOffset;
+	};
+
+	struct ManifestDirectory
+	{
+		uint32_t	pathOffset;
+		uint32_t	pathSize;
+		int64_t		time;
+	};
+
+	struct ManifestRecord
+	{
+		std::array<unsigned char, 16> uid;
+		uint32_t	typeOffset;
+		uint32_t	typeSize;
+		uint32_t	pathOffset;
+		uint32_t	pathSize;
+		uint32_t	directoryIndex;
+		uint32_t	dependencyIndex;
+		uint32_t	dependencyCount;
+		uint32_t	padding;
+		int64_t		metaTime;
+		uint64_t	fileSize;
+		int64_t		fileTime;
+		uint64_t	cookedOffset;
+		uint64_t	cookedSize;
+	};
+
+	using DependencyBytes = std::array<unsigned char, 16>;
+
+	/**
+	@brief Result of the check of a known directory
+	*/
+	struct DirectoryScan
+	{
+		bool exists = false;
+		bool changed = false;
+		int64_t time = UnknownTime;
+
+		std::vector<AssetRecord> keptRecords;
+		std::vector<fs::path> metaToParse;
+		std::vector<fs::path> newDirectories;
+	};
+
+	/**
+	@brief Result of the recursive scan of a directory unknown by the manifest
+	*/
+	struct NewDirectoryScan
+	{
+		std::vector<std::pair<fs::path, int64_t>> directories;
+		std::vector<std::vector<fs::path>> metaPaths;
+	};
+
+	int64_t GetWriteTime(const fs::path& path, std::error_code& error)
+	{
+		return static_cast<int64_t>(fs::last_write_time(path, error).time_since_epoch().count());
+	}
+
+	bool IsMetaFile(const fs::directory_entry& entry, std::error_code& error)
+	{
+		// Same test as ResourcesLoader::GetExtensionType for META, without a map lookup per file
+		return !entry.is_directory(error) && entry.path().extension() == ".meta";
+	}
+
+	/**
+	@brief Append a string to the blob
+
+	@return std::pair<uint32_t, uint32_t> : Offset and size of the string in the blob
+	*/
+	std::pair<uint32_t, uint32_t> AddString(std::string& blob, const std::string& string)
+	{
+		std::pair<uint32_t, uint32_t> location = { static_cast<uint32_t>(blob.size()), static_cast<uint32_t>(string.size()) };
+		blob += string;
+		return location;
+	}
+
+	bool GetString(const MappedFile& file, const ManifestHeader& header, uint32_t offset, uint32_t size, std::string& string)
+	{
+		if (static_cast<uint64_t>(offset) + size > header.stringsSize)
+			return false;
+
+		const char* data = file.View<char>(header.stringsOffset + offset, size);
+		if (data == nullptr)
+			return false;
+
+		string.assign(data, size);
+		return true;
+	}
+
+	/**
+	@brief Rebuild a path stored relative to the root, the root itself is stored as "."
+	*/
+	std::string GetPathFromRoot(const fs::path& root, const std::string& relativePath)
+	{
+		if (relativePath.empty() || relativePath == ".")
+			return root.string();
+
+		return (root / relativePath).string();
+	}
+
+	uint64_t AlignOffset(uint64_t offset)
+	{
+		return (offset + 7) & ~uint64_t(7);
+	}
+}
+
+AssetDatabase::AssetDatabase(const std::string& rootPath, const std::string& manifestPath)
+	: m_rootPath(rootPath), m_manifestPath(manifestPath)
+{
+
+}
+
+std::string AssetDatabase::GetDefaultManifestPath(const std::string& rootPath)
+{
+	std::string absoluteRoot = fs::absolute(rootPath).lexically_normal().string();
+
+	std::stringstream name;
+	name << "AssetDatabase_" << std::hex << std::setw(16) << std::setfill('0') << static_cast<uint64_t>(StringHelper::PathHash()(absoluteRoot)) << ".hydb";
+
+	return std::string(CACHE_ROOT) + name.str();
+}
+
+bool AssetDatabase::LoadManifest()
+{
+	m_directories.clear();
+	m_records.clear();
+
+	MappedFile file;
+	if (!file.Open(m_manifestPath))
+		return false;
+
+	const ManifestHeader* header = file.View<ManifestHeader>(0);
+	if (header == nullptr || std::memcmp(header->magic, ManifestMagic, sizeof(ManifestMagic)) != 0 || header->version != ManifestVersion)
+	{
+		Logger::Warning("AssetDatabase - Invalid manifest : " + m_manifestPath);
+		return false;
+	}
+
+	const ManifestDirectory* directories = file.View<ManifestDirectory>(header->directoriesOffset, header->directoryCount);
+	const ManifestRecord* records = file.View<ManifestRecord>(header->recordsOffset, header->recordCount);
+	const DependencyBytes* dependencies = file.View<DependencyBytes>(header->dependenciesOffset, header->dependencyCount);
+
+	if (directories == nullptr || records == nullptr || dependencies == nullptr || file.View<char>(header->stringsOffset, header->stringsSize) == nullptr)
+	{
+		Logger::Warning("AssetDatabase - Truncated manifest : " + m_manifestPath);
+		return false;
+	}
+
+	fs::path root = m_rootPath;
+	std::string relativePath;
+
+	m_directories.resize(header->directoryCount);
+	for (uint32_t i = 0; i < header->directoryCount; ++i)
+	{
+		if (!GetString(file, *header, directories[i].pathOffset, directories[i].pathSize, relativePath))
+			return false;
+
+		m_directories[i].path = GetPathFromRoot(root, relativePath);
+		m_directories[i].time = directories[i].time;
+	}
+
+	m_records.resize(header->recordCount);
+	for (uint32_t i = 0; i < header->recordCount; ++i)
+	{
+		const ManifestRecord& source = records[i];
+		AssetRecord& record = m_records[i];
+
+		if (source.directoryIndex >= header->directoryCount || static_cast<uint64_t>(source.dependencyIndex) + source.dependencyCount > header->dependencyCount)
+			return false;
+
+		if (!GetString(file, *header, source.typeOffset, source.typeSize, record.typeName) ||
+			!GetString(file, *header, source.pathOffset, source.pathSize, relativePath))
+			return false;
+
+		record.uid = HYGUID(source.uid);
+		record.path = GetPathFromRoot(root, relativePath);
+		record.directoryIndex = source.directoryIndex;
+		record.metaTime = source.metaTime;
+		record.fileSize = source.fileSize;
+		record.fileTime = source.fileTime;
+		record.cookedOffset = source.cookedOffset;
+		record.cookedSize = source.cookedSize;
+
+		record.dependencies.reserve(source.dependencyCount);
+		for (uint32_t j = 0; j < source.dependencyCount; ++j)
+			record.dependencies.emplace_back(dependencies[source.dependencyIndex + j]);
+	}
+
+	return true;
+}
+
+bool AssetDatabase::ParseMeta(const fs::path& metaPath, AssetRecord& record)
+{
+	std::error_code error;
+	record.metaTime = GetWriteTime(metaPath, error);
+	if (error)
+		return false;
+
+	std::ifstream i(metaPath);
+	if (!i.is_open())
+		return false;
+
+	json j = json::parse(i, nullptr, false);
+	i.close();
+
+	if (j.is_discarded() || !j.contains("uid") || !j.contains("type") || !j["uid"].is_string() || !j["type"].is_string())
+		return false;
+
+	record.uid = HYGUID(j["uid"].get<std::string>());
+	record.typeName = j["type"].get<std::string>();
+	record.path = StringHelper::GetFilePathWithoutExtension(metaPath.string());
+
+	// The resource file may not exist yet, its size and time stay null
+	uint64_t fileSize = fs::file_size(record.path, error);
+	record.fileSize = error ? 0 : fileSize;
+
+	int64_t fileTime = GetWriteTime(record.path, error);
+	record.fileTime = error ? 0 : fileTime;
+
+	return true;
+}
+
+void AssetDatabase::Refresh(ResourcesTaskPool& taskPool)
+{
+	m_stats = RefreshStats();
+	m_stats.manifestLoaded = LoadManifest();
+
+	// A missing manifest is a full scan from the root
+	if (!m_stats.manifestLoaded || m_directories.empty())
+	{
+		m_directories.clear();
+		m_records.clear();
+		m_directories.push_back({ fs::path(m_rootPath).string(), UnknownTime });
+	}
+
+	FlatHashMap<std::string, uint32_t, StringHelper::PathHash, StringHelper::PathEqual> knownDirectories;
+	knownDirectories.reserve(m_directories.size());
+	for (uint32_t i = 0; i < m_directories.size(); ++i)
+		knownDirectories.try_emplace(m_directories[i].path, i);
+
+	std::vector<std::vector<AssetRecord*>> directoryRecords(m_directories.size());
+	for (AssetRecord& record : m_records)
+		directoryRecords[record.directoryIndex].emplace_back(&record);
+
+	// Check known directories : unchanged ones keep their records without being enumerated
+	std::vector<DirectoryScan> scans(m_directories.size());
+	taskPool.ParallelFor(m_directories.size(), DirectoryChunkSize, [this, &scans, &directoryRecords, &knownDirectories](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i)
+		{
+			DirectoryScan& scan = scans[i];
+			std::error_code error;
+
+			scan.time = GetWriteTime(m_directories[i].path, error);
+			scan.exists = !error && fs::is_directory(m_directories[i].path, error);
+			if (!scan.exists)
+				continue;
+
+			scan.changed = scan.time != m_directories[i].time;
+			if (!scan.changed)
+			{
+				// An edit in place of a .meta doesn't change the time of its directory : each record checks the time of its .meta
+				for (AssetRecord* record : directoryRecords[i])
+				{
+					fs::path metaPath = record->path + ".meta";
+					int64_t metaTime = GetWriteTime(metaPath, error);
+
+					if (error)
+						continue;
+
+					if (metaTime == record->metaTime)
+						scan.keptRecords.emplace_back(std::move(*record));
+					else
+						scan.metaToParse.emplace_back(std::move(metaPath));
+				}
+				continue;
+			}
+
+			FlatHashMap<std::string, AssetRecord*, StringHelper::PathHash, StringHelper::PathEqual> oldRecords;
+			oldRecords.reserve(directoryRecords[i].size());
+			for (AssetRecord* record : directoryRecords[i])
+				oldRecords.try_emplace(record->path, record);
+
+			for (const auto& entry : fs::directory_iterator(m_directories[i].path, error))
+			{
+				if (entry.is_directory(error))
+				{
+					if (!knownDirectories.contains(entry.path().string()))
+						scan.newDirectories.emplace_back(entry.path());
+					continue;
+				}
+
+				if (!IsMetaFile(entry, error))
+					continue;
+
+				// Only new or modified meta files are parsed again
+				auto it = oldRecords.find(StringHelper::GetFilePathWithoutExtension(entry.path().string()));
+				if (it != oldRecords.end() && it->second->metaTime == GetWriteTime(entry.path(), error))
+					scan.keptRecords.emplace_back(std::move(*it->second));
+				else
+					scan.metaToParse.emplace_back(entry.path());
+			}
+		}
+		});
+
+	// Rebuild the directory list, dropping the directories which don't exist anymore
+	std::vector<DirectoryRecord> directories;
+	std::vector<AssetRecord> records;
+	std::vector<std::pair<fs::path, uint32_t>> metaToParse;
+	std::vector<fs::path> newDirectories;
+
+	records.reserve(m_records.size());
+	for (size_t i = 0; i < scans.size(); ++i)
+	{
+		DirectoryScan& scan = scans[i];
+		if (!scan.exists)
+		{
+			m_stats.removedRecords += directoryRecords[i].size();
+			continue;
+		}
+
+		uint32_t directoryIndex = static_cast<uint32_t>(directories.size());
+		directories.push_back({ std::move(m_directories[i].path), scan.time });
+
+		if (scan.changed)
+			m_stats.scannedDirectories++;
+
+		m_stats.removedRecords += directoryRecords[i].size() - scan.keptRecords.size();
+
+		for (AssetRecord& record : scan.keptRecords)
+		{
+			record.directoryIndex = directoryIndex;
+			records.emplace_back(std::move(record));
+		}
+
+		for (fs::path& metaPath : scan.metaToParse)
+			metaToParse.emplace_back(std::move(metaPath), directoryIndex);
+
+		newDirectories.insert(newDirectories.end(), std::make_move_iterator(scan.newDirectories.begin()), std::make_move_iterator(scan.newDirectories.end()));
+	}
+	m_stats.reusedRecords = records.size();
+
+	// New directories are enumerated recursively, each by its own task
+	std::vector<NewDirectoryScan> newScans(newDirectories.size());
+	taskPool.ParallelFor(newDirectories.size(), 1, [&newDirectories, &newScans](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i)
+		{
+			NewDirectoryScan& scan = newScans[i];
+			std::error_code error;
+
+			scan.directories.emplace_back(newDirectories[i], GetWriteTime(newDirectories[i], error));
+			scan.metaPaths.emplace_back();
+
+			std::vector<size_t> stack = { 0 };
+			while (!stack.empty())
+			{
+				size_t current = stack.back();
+				stack.pop_back();
+
+				fs::path directory = scan.directories[current].first;
+				for (const auto& entry : fs::directory_iterator(directory, error))
+				{
+					if (entry.is_directory(error))
+					{
+						stack.push_back(scan.directories.size());
+						scan.directories.emplace_back(entry.path(), GetWriteTime(entry.path(), error));
+						scan.metaPaths.emplace_back();
+					}
+					else if (IsMetaFile(entry, error))
+					{
+						scan.metaPaths[current].emplace_back(entry.path());
+					}
+				}
+			}
+		}
+		});
+
+	for (NewDirectoryScan& scan : newScans)
+	{
+		for (size_t i = 0; i < scan.directories.size(); ++i)
+		{
+			uint32_t directoryIndex = static_cast<uint32_t>(directories.size());
+			directories.push_back({ scan.directories[i].first.string(), scan.directories[i].second });
+			m_stats.scannedDirectories++;
+
+			for (fs::path& metaPath : scan.metaPaths[i])
+				metaToParse.emplace_back(std::move(metaPath), directoryIndex);
+		}
+	}
+
+	// Parse new and modified meta files
+	std::vector<AssetRecord> parsedRecords(metaToParse.size());
+	std::vector<char> parsed(metaToParse.size(), 0);
+	taskPool.ParallelFor(metaToParse.size(), MetaChunkSize, [&metaToParse, &parsedRecords, &parsed](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i)
+		{
+			parsed[i] = ParseMeta(metaToParse[i].first, parsedRecords[i]);
+			parsedRecords[i].directoryIndex = metaToParse[i].second;
+		}
+		});
+
+	for (size_t i = 0; i < parsedRecords.size(); ++i)
+	{
+		if (!parsed[i])
+			continue;
+
+		records.emplace_back(std::move(parsedRecords[i]));
+		m_stats.parsedRecords++;
+	}
+
+	m_dirty = !m_stats.manifestLoaded || m_stats.scannedDirectories != 0 || m_stats.removedRecords != 0 || m_stats.parsedRecords != 0
+		|| directories.size() != m_directories.size();
+
+	m_directories = std::move(directories);
+	m_records = std::move(records);
+
+	m_recordsByUID.clear();
+	m_recordsByUID.reserve(m_records.size());
+	for (size_t i = 0; i < m_records.size(); ++i)
+		m_recordsByUID.try_emplace(m_records[i].uid, i);
+}
+
+void AssetDatabase::SetDependencies(const HYGUID& uid, const std::vector<HYGUID>& dependencies)
+{
+	auto it = m_recordsByUID.find(uid);
+	if (it == m_recordsByUID.end())
+		return;
+
+	AssetRecord& record = m_records[it->second];
+	if (record.dependencies == dependencies)
+		return;
+
+	record.dependencies = dependencies;
+	m_dirty = true;
+}
+
+bool AssetDatabase::Save()
+{
+	if (!m_dirty)
+		return true;
+
+	fs::path root = m_rootPath;
+	std::string strings;
+
+	std::vector<ManifestDirectory> directories(m_directories.size());
+	for (size_t i = 0; i < m_directories.size(); ++i)
+	{
+		auto [offset, size] = AddString(strings, fs::path(m_directories[i].path).lexically_relative(root).string());
+		directories[i] = { offset, size, m_directories[i].time };
+	}
+
+	std::vector<ManifestRecord> records(m_records.size());
+	std::vector<DependencyBytes> dependencies;
+	for (size_t i = 0; i < m_records.size(); ++i)
+	{
+		const AssetRecord& source = m_records[i];
+		ManifestRecord& record = records[i];
+		std::memset(&record, 0, sizeof(ManifestRecord));
+
+		record.uid = source.uid.Bytes();
+		std::tie(record.typeOffset, record.typeSize) = AddString(strings, source.typeName);
+		std::tie(record.pathOffset, record.pathSize) = AddString(strings, fs::path(source.path).lexically_relative(root).string());
+		record.directoryIndex = source.directoryIndex;
+		record.dependencyIndex = static_cast<uint32_t>(dependencies.size());
+		record.dependencyCount = static_cast<uint32_t>(source.dependencies.size());
+		record.metaTime = source.metaTime;
+		record.fileSize = source.fileSize;
+		record.fileTime = source.fileTime;
+		record.cookedOffset = source.cookedOffset;
+		record.cookedSize = source.cookedSize;
+
+		for (const HYGUID& dependency : source.dependencies)
+			dependencies.emplace_back(dependency.Bytes());
+	}
+
+	ManifestHeader header;
+	std::memset(&header, 0, sizeof(ManifestHeader));
+	std::memcpy(header.magic, ManifestMagic, sizeof(ManifestMagic));
+	header.version = ManifestVersion;
+	header.directoryCount = static_cast<uint32_t>(directories.size());
+	header.recordCount = static_cast<uint32_t>(records.size());
+	header.dependencyCount = static_cast<uint32_t>(dependencies.size());
+	header.stringsSize = strings.size();
+	header.directoriesOffset = AlignOffset(sizeof(ManifestHeader));
+	header.recordsOffset = AlignOffset(header.directoriesOffset + directories.size() * sizeof(ManifestDirectory));
+	header.dependenciesOffset = AlignOffset(header.recordsOffset + records.size() * sizeof(ManifestRecord));
+	header.stringsOffset = AlignOffset(header.dependenciesOffset + dependencies.size() * sizeof(DependencyBytes));
+
+	// Write next to the manifest then replace it, a crash never leaves a partial manifest
+	std::error_code error;
+	fs::path manifestPath = m_manifestPath;
+	if (manifestPath.has_parent_path())
+		fs::create_directories(manifestPath.parent_path(), error);
+
+	std::string temporaryPath = m_manifestPath + ".tmp";
+	{
+		std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+		if (!file.is_open())
+		{
+			Logger::Warning("AssetDatabase - Can't write manifest : " + m_manifestPath);
+			return false;
+		}
+
+		auto writeAt = [&file](uint64_t offset, const void* data, size_t size) {
+			static const char zeros[8] = { 0 };
+			file.write(zeros, static_cast<std::streamsize>(offset - static_cast<uint64_t>(file.tellp())));
+			file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+		};
+
+		writeAt(0, &header, sizeof(ManifestHeader));
+		writeAt(header.directoriesOffset, directories.data(), directories.size() * sizeof(ManifestDirectory));
+		writeAt(header.recordsOffset, records.data(), records.size() * sizeof(ManifestRecord));
+		writeAt(header.dependenciesOffset, dependencies.data(), dependencies.size() * sizeof(DependencyBytes));
+		writeAt(header.stringsOffset, strings.data(), strings.size());
+
+		if (!file.good())
+		{
+			file.close();
+			fs::remove(temporaryPath, error);
+			Logger::Warning("AssetDatabase - Can't write manifest : " + m_manifestPath);
+			return false;
+		}
+	}
+
+	fs::rename(temporaryPath, m_manifestPath, error);
+	if (error)
+	{
+		fs::remove(temporaryPath, error);
+		Logger::Warning("AssetDatabase - Can't replace manifest : " + m_manifestPath);
+		return false;
+	}
+
+	m_dirty = false;
+	return true;
+}
+
+const std::vector<AssetRecord>& AssetDatabase::GetRecords() const
+{
+	return m_records;
+}
+
+const AssetRecord* AssetDatabase::GetRecord(const HYGUID& uid) const
+{
+	auto it = m_recordsByUID.find(uid);
+	return it != m_recordsByUID.end() ? &m_records[it->second] : nullptr;
+}
+
+const AssetDatabase::RefreshStats& AssetDatabase::GetStats() const
+{
+	return m_stats;
+}
@@ -0,0 +1,309 @@
+#include "Resources/ImportContentIndex.hpp"
+
+#include <vector>
+#include <fstream>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+
+#include "Core/Logger.hpp"
+
+#include "Resources/ResourcesManager.hpp"
+
+#include "Tools/MappedFile.hpp"
+
+namespace fs = std::filesystem;
+
+namespace
+{
+	constexpr char IndexMagic[4] = { 'H', 'Y', 'C', 'I' };
+	constexpr uint32_t IndexVersion = 2;
+
+	/**
+	@brief Layout of the index file : header, the entries, then the referencers of every entry one after the other
+	*/
+	struct IndexHeader
+	{
+		char		magic[4];
+		uint32_t	version;
+		uint64_t	entryCount;
+		uint64_t	referencerCount;
+	};
+
+	struct IndexEntry
+	{
+		uint64_t	hash[2];
+		uint32_t	type;
+		uint32_t	referencerCount;
+		uint8_t		uid[16];
+		uint64_t	checkSize;
+		uint64_t	checkHash;
+	};
+
+	struct IndexReferencer
+	{
+		uint8_t		uid[16];
+	};
+
+	HYGUID ReadGUID(const uint8_t* data)
+	{
+		std::array<unsigned char, 16> bytes;
+		std::memcpy(bytes.data(), data, bytes.size());
+		return HYGUID(bytes);
+	}
+}
+
+ImportContentIndex::ImportContentIndex(ResourcesManager& resources, const std::string& path)
+	: m_resources(resources), m_path(path)
+{
+}
+
+void ImportContentIndex::LoadIfNeeded()
+{
+	if (m_loaded)
+		return;
+
+	m_loaded = true;
+
+	MappedFile file;
+	if (!file.Open(m_path))
+		return;
+
+	// An index of another version is dropped, the contents are indexed again by the next imports
+	const IndexHeader* header = file.View<IndexHeader>(0);
+	if (header == nullptr || std::memcmp(header->magic, IndexMagic, sizeof(IndexMagic)) != 0 || header->version != IndexVersion)
+	{
+		Logger::Warning("ImportContentIndex - Invalid index : " + m_path);
+		return;
+	}
+
+	const uint64_t referencersOffset = sizeof(IndexHeader) + header->entryCount * sizeof(IndexEntry);
+	const IndexEntry* entries = file.View<IndexEntry>(sizeof(IndexHeader), header->entryCount);
+	const IndexReferencer* referencers = file.View<IndexReferencer>(referencersOffset, header->referencerCount);
+	if (entries == nullptr || (referencers == nullptr && header->referencerCount > 0))
+	{
+		Logger::Warning("ImportContentIndex - Truncated index : " + m_path);
+		return;
+	}
+
+	m_entries.reserve(header->entryCount);
+	m_keys.reserve(header->entryCount);
+	m_referencers.reserve(header->entryCount);
+
+	uint64_t referencer = 0;
+	for (uint64_t i = 0; i < header->entryCount; ++i)
+	{
+		const IndexEntry& indexEntry = entries[i];
+		if (referencer + indexEntry.referencerCount > header->referencerCount)
+		{
+			Logger::Warning("ImportContentIndex - Truncated index : " + m_path);
+			m_entries.clear();
+			m_keys.clear();
+			m_referencers.clear();
+			return;
+		}
+
+		const HYGUID uid = ReadGUID(indexEntry.uid);
+		const Key key = { { indexEntry.hash[0], indexEntry.hash[1] }, static_cast<RESOURCE_TYPE>(indexEntry.type) };
+		m_entries[key] = { uid, { indexEntry.checkSize, indexEntry.checkHash } };
+		m_keys[uid] = key;
+
+		if (indexEntry.referencerCount == 0)
+			continue;
+
+		std::vector<HYGUID>& entryReferencers = m_referencers[uid];
+		entryReferencers.reserve(indexEntry.referencerCount);
+		for (uint32_t j = 0; j < indexEntry.referencerCount; ++j)
+			entryReferencers.emplace_back(ReadGUID(referencers[referencer++].uid));
+	}
+}
+
+ImportContentIndex::Entry* ImportContentIndex::FindUnsafe(const Key& key)
+{
+	auto it = m_entries.find(key);
+	if (it == m_entries.end())
+		return nullptr;
+
+	Resource* resource = m_resources.GetResource(it->second.uid);
+	if (resource && resource->GetType() == key.type)
+		return &it->second;
+
+	// The resource was deleted, or its GUID reused by another resource
+	m_keys.erase(it->second.uid);
+	m_referencers.erase(it->second.uid);
+	m_entries.erase(key);
+	m_dirty = true;
+	return nullptr;
+}
+
+void ImportContentIndex::SetUnsafe(const Key& key, const Entry& entry)
+{
+	auto previous = m_keys.find(entry.uid);
+	if (previous != m_keys.end())
+	{
+		if (previous->second == key)
+		{
+			m_entries[key] = entry;
+			m_dirty = true;
+			return;
+		}
+
+		m_entries.erase(previous->second);
+	}
+
+	// The content was mapped to another resource, which no longer has an entry
+	auto replaced = m_entries.find(key);
+	if (replaced != m_entries.end() && replaced->second.uid != entry.uid)
+		m_keys.erase(replaced->second.uid);
+
+	m_entries[key] = entry;
+	m_keys[entry.uid] = key;
+	m_dirty = true;
+}
+
+void ImportContentIndex::AddReferencerUnsafe(const HYGUID& uid, const HYGUID& referencer)
+{
+	std::vector<HYGUID>& referencers = m_referencers[uid];
+	if (std::find(referencers.begin(), referencers.end(), referencer) != referencers.end())
+		return;
+
+	referencers.emplace_back(referencer);
+	m_dirty = true;
+}
+
+Resource* ImportContentIndex::FindOrCreate(RESOURCE_TYPE type, const Hash128& hash, const ContentCheck& check, const HYGUID& referencer,
+	const CreateFunction& create, bool& created)
+{
+	std::lock_guard lock(m_mutex);
+	LoadIfNeeded();
+
+	const Key key = { hash, type };
+
+	created = false;
+	bool collision = false;
+	if (Entry* entry = FindUnsafe(key))
+	{
+		if (entry->check == check)
+		{
+			AddReferencerUnsafe(entry->uid, referencer);
+			return m_resources.GetResource(entry->uid);
+		}
+
+		// Same hash for another content : the indexed resource keeps the entry, the content gets its own resource
+		Logger::Warning("ImportContentIndex - Hash collision between two contents of " + std::to_string(check.size) + " and "
+			+ std::to_string(entry->check.size) + " bytes, imported separately");
+		collision = true;
+	}
+
+	Resource* resource = create();
+	if (resource == nullptr)
+		return nullptr;
+
+	if (!collision)
+		SetUnsafe(key, { resource->GetUID(), check });
+
+	AddReferencerUnsafe(resource->GetUID(), referencer);
+	created = true;
+	return resource;
+}
+
+bool ImportContentIndex::Reuse(const Resource& resource, const Hash128& hash, const ContentCheck& check, const HYGUID& referencer)
+{
+	std::lock_guard lock(m_mutex);
+	LoadIfNeeded();
+
+	const HYGUID& uid = resource.GetUID();
+
+	auto referencersIt = m_referencers.find(uid);
+	if (referencersIt != m_referencers.end())
+	{
+		// Models deleted since they were imported no longer share the resource
+		std::vector<HYGUID>& referencers = referencersIt->second;
+		const size_t referencerCount = referencers.size();
+		std::erase_if(referencers, [this, &referencer](const HYGUID& other) { return other != referencer && m_resources.GetResource(other) == nullptr; });
+		m_dirty |= referencers.size() != referencerCount;
+
+		const bool shared = std::any_of(referencers.begin(), referencers.end(), [&referencer](const HYGUID& other) { return other != referencer; });
+		if (shared)
+		{
+			std::erase(referencers, referencer);
+			m_dirty = true;
+			return false;
+		}
+	}
+
+	SetUnsafe({ hash, resource.GetType() }, { uid, check });
+	AddReferencerUnsafe(uid, referencer);
+	return true;
+}
+
+bool ImportContentIndex::Save()
+{
+	std::lock_guard lock(m_mutex);
+	if (!m_dirty)
+		return true;
+
+	std::vector<IndexEntry> entries;
+	std::vector<IndexReferencer> referencers;
+	entries.reserve(m_entries.size());
+	for (const auto& [key, indexed] : m_entries)
+	{
+		IndexEntry& entry = entries.emplace_back();
+		std::memset(&entry, 0, sizeof(IndexEntry));
+
+		entry.hash[0] = key.hash.low;
+		entry.hash[1] = key.hash.high;
+		entry.type = static_cast<uint32_t>(key.type);
+		std::memcpy(entry.uid, indexed.uid.Bytes().data(), sizeof(entry.uid));
+		entry.checkSize = indexed.check.size;
+		entry.checkHash = indexed.check.hash;
+
+		auto referencersIt = m_referencers.find(indexed.uid);
+		if (referencersIt == m_referencers.end())
+			continue;
+
+		entry.referencerCount = static_cast<uint32_t>(referencersIt->second.size());
+		for (const HYGUID& referencer : referencersIt->second)
+			std::memcpy(referencers.emplace_back().uid, referencer.Bytes().data(), sizeof(IndexReferencer::uid));
+	}
+
+	IndexHeader header;
+	std::memset(&header, 0, sizeof(IndexHeader));
+	std::memcpy(header.magic, IndexMagic, sizeof(IndexMagic));
+	header.version = IndexVersion;
+	header.entryCount = entries.size();
+	header.referencerCount = referencers.size();
+
+	// Write next to the index then replace it, a crash never leaves a partial index
+	std::error_code error;
+	fs::path indexPath = m_path;
+	if (indexPath.has_parent_path())
+		fs::create_directories(indexPath.parent_path(), error);
+
+	std::string temporaryPath = m_path + ".tmp";
+	{
+		std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+		file.write(reinterpret_cast<const char*>(&header), sizeof(IndexHeader));
+		file.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(IndexEntry)));
+		file.write(reinterpret_cast<const char*>(referencers.data()), static_cast<std::streamsize>(referencers.size() * sizeof(IndexReferencer)));
+
+		if (!file.good())
+		{
+			file.close();
+			fs::remove(temporaryPath, error);
+			Logger::Warning("ImportContentIndex - Can't write index : " + m_path);
+			return false;
+		}
+	}
+
+	fs::rename(temporaryPath, m_path, error);
+	if (error)
+	{
+		fs::remove(temporaryPath, error);
+		Logger::Warning("ImportContentIndex - Can't replace index : " + m_path);
+		return false;
+	}
+
+	m_dirty = false;
+	return true;
+}
@@ -89,3 +89,16 @@ void Material::Deserialize()
 	Serialization::TryGetResource(j, "aoTexture", data.aoTexture);
 	Serialization::TryGetResource(j, "maskTexture", data.maskTexture);
 }
+
+void Material::GetDependencies(std::vector<HYGUID>& dependencies) const
+{
+	AddDependency(dependencies, data.diffuseTexture);
+	AddDependency(dependencies, data.ambientTexture);
+	AddDependency(dependencies, data.normalTexture);
+	AddDependency(dependencies, data.emissiveTexture);
+	AddDependency(dependencies, data.maskTexture);
+	AddDependency(dependencies, data.specularTexture);
+	AddDependency(dependencies, data.metallicTexture);
+	AddDependency(dependencies, data.roughnessTexture);
+	AddDependency(dependencies, data.aoTexture);
+}
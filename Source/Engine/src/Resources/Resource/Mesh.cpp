@@ -1,4 +1,7 @@
+#include <array>
 #include <fstream>
+#include <cstring>
+#include <algorithm>
 
 #include "Resources/Resource/Material.hpp"
 #include "ECS/Systems/SystemManager.hpp"
@@ -7,9 +10,157 @@
 #include "Core/Logger.hpp"
 #include "Renderer/RenderSystem.hpp"
 #include "Resources/ResourcesManager.hpp"
+#include "Resources/Loaders/VertexPacker.hpp"
 
 #include "Generated/Mesh.rfks.h"
 
+namespace
+{
+	constexpr char MeshFileMagic[4] = { 'H', 'Y', 'M', 'S' };
+	constexpr uint32_t MeshFileVersion = 4;
+
+	// Streams start on a 16 bytes boundary in the mesh file
+	constexpr uint64_t MeshStreamAlignment = 16;
+
+	/**
+	@brief Layout of a mesh file : header, sub meshes table, levels of detail tables, meshlets tables, then the vertices and indices of every sub mesh.
+	Offsets are from the start of the file, the streams are mapped and uploaded as they are stored.
+	*/
+	struct MeshFileHeader
+	{
+		char		magic[4];
+		uint32_t	version;
+		uint32_t	vertexLayout;
+		uint32_t	vertexSize;
+		uint32_t	subMeshCount;
+		uint32_t	padding;
+		float		boundsMin[3];
+		float		boundsMax[3];
+		uint64_t	subMeshesOffset;
+		uint64_t	streamsOffset;
+		uint64_t	streamsSize;
+	};
+
+	struct MeshFileSubMesh
+	{
+		std::array<unsigned char, 16> material;
+		float		boundsMin[3];
+		float		boundsMax[3];
+		uint32_t	vertexCount;
+		uint32_t	indexCount;
+		uint32_t	indexSize;
+		uint32_t	lodCount;
+		uint64_t	verticesOffset;
+		uint64_t	indicesOffset;
+		uint64_t	lodsOffset;
+		uint32_t	meshletCount;
+		uint32_t	padding;
+		uint64_t	meshletsOffset;
+	};
+
+	struct MeshFileLOD
+	{
+		uint32_t	indexOffset;
+		uint32_t	indexCount;
+		float		error;
+		uint32_t	padding;
+	};
+
+	struct MeshFileMeshlet
+	{
+		uint32_t	indexOffset;
+		uint32_t	indexCount;
+		float		center[3];
+		float		radius;
+		float		coneAxis[3];
+		float		coneCutoff;
+	};
+
+	uint64_t AlignStream(uint64_t offset)
+	{
+		return (offset + MeshStreamAlignment - 1) & ~(MeshStreamAlignment - 1);
+	}
+
+	void WriteVector(float (&out)[3], const Vector3& vector)
+	{
+		out[0] = vector.x;
+		out[1] = vector.y;
+		out[2] = vector.z;
+	}
+
+	Vector3 ReadVector(const float (&in)[3])
+	{
+		return Vector3(in[0], in[1], in[2]);
+	}
+}
+
+size_t MeshData::GetVertexCount() const
+{
+	return mappedVertices.empty() ? vertices.size() : mappedVertices.size() / VertexPacker::GetVertexSize(mappedLayout);
+}
+
+size_t MeshData::GetIndexCount() const
+{
+	if (!mappedIndices.empty())
+		return mappedIndices.size() / (mappedShortIndices ? sizeof(uint16_t) : sizeof(int));
+
+	// Released indices are only in the index buffer
+	if (indices.empty() && GPUData != nullptr)
+		return GPUData->indexCount;
+
+	return indices.size();
+}
+
+std::span<const Vertex> MeshData::GetVertices(std::vector<Vertex>& buffer) const
+{
+	if (mappedVertices.empty())
+		return vertices;
+
+	// Float streams are aligned in the file, they are read in place
+	const size_t count = GetVertexCount();
+	if (mappedLayout == EVertexLayout::FLOAT)
+		return std::span<const Vertex>(reinterpret_cast<const Vertex*>(mappedVertices.data()), count);
+
+	buffer.resize(count);
+	VertexPacker::Unpack(mappedLayout, mappedVertices.data(), count, boundsMin, boundsMax, buffer.data());
+	return buffer;
+}
+
+const void* MeshData::GetIndexData() const
+{
+	return mappedIndices.empty() ? static_cast<const void*>(indices.data()) : mappedIndices.data();
+}
+
+bool MeshData::HasShortIndices() const
+{
+	return !mappedIndices.empty() && mappedShortIndices;
+}
+
+bool MeshData::HasIndexData() const
+{
+	return !mappedIndices.empty() || !indices.empty();
+}
+
+void MeshData::ReleaseIndices()
+{
+	indices.clear();
+	indices.shrink_to_fit();
+}
+
+size_t MeshData::GetLODCount() const
+{
+	return lods.empty() ? 1 : lods.size();
+}
+
+MeshLOD MeshData::GetLOD(size_t level) const
+{
+	if (lods.empty())
+		return { 0, static_cast<uint32_t>(GetIndexCount()), 0.f };
+
+	return lods[level < lods.size() ? level : lods.size() - 1];
+}
+
+
 rfk::UniquePtr<Mesh> Mesh::defaultInstantiator(const HYGUID& uid)
 {
 	return rfk::makeUnique<Mesh>(uid);
@@ -28,6 +179,11 @@ Mesh::Mesh(const HYGUID& uid)
 	m_type = RESOURCE_TYPE::MESH;
 }
 
+void Mesh::StageGPUData()
+{
+	SystemManager::GetRenderSystem().GPUWrapper.StageMeshData(*this);
+}
+
 void Mesh::LoadInGPUMemory()
 {
 	SystemManager::GetRenderSystem().GPUWrapper.CreateMeshData(*this);
@@ -38,41 +194,292 @@ void Mesh::UnloadFromGPUMemory()
 	SystemManager::GetRenderSystem().GPUWrapper.RemoveMeshData(*this);
 }
 
+bool Mesh::IsGPUUploadPending() const
+{
+	for (const MeshData& data : subMeshes)
+	{
+		if (data.GPUData != nullptr && data.GPUData->uploadTicket != 0)
+			return true;
+	}
+
+	return false;
+}
+
+#pragma region SERIALIZATION
+
 void Mesh::Serialize()
 {
-	int subMeshesNb = static_cast<int>(subMeshes.size());
 	// If we erased vertices after creating data, we can't save again anymore
-	if (subMeshesNb <= 0 || subMeshes[0].vertices.size() <= 0)
+	if (subMeshes.empty() || subMeshes[0].GetVertexCount() == 0)
 		return;
 
+	// Once written, the indices of the uploaded sub meshes are only kept in the index buffer again
+	auto releaseUploadedIndices = [this]() {
+		for (MeshData& data : subMeshes)
+		{
+			if (data.GPUData != nullptr && data.GPUData->uploadTicket == 0)
+				data.ReleaseIndices();
+		}
+		};
+
+	// Indices released after their upload are read back from the index buffer
+	for (MeshData& data : subMeshes)
+	{
+		if (data.HasIndexData() || data.GetIndexCount() == 0)
+			continue;
+
+		if (!SystemManager::GetRenderSystem().GPUWrapper.ReadIndices(data, data.indices))
+		{
+			Logger::Warning("Cannot save mesh " + m_filepath + ", its indices could not be read from the index buffer");
+			releaseUploadedIndices();
+			return;
+		}
+	}
+
+	// The file can't be rewritten while it is mapped
+	DetachMappedData();
+
 	std::ofstream o(m_filepath, std::ifstream::binary);
 	if (!o)
 	{
 		Logger::Warning("Cannot open file " + m_filepath);
+		releaseUploadedIndices();
 		return;
 	}
-	o.write(reinterpret_cast<const char*>(&m_boundingBox.min), sizeof(Vector3));
-	o.write(reinterpret_cast<const char*>(&m_boundingBox.max), sizeof(Vector3));
 
-	o.write(reinterpret_cast<const char*>(&subMeshesNb), sizeof(int));
-	for (int i = 0; i < subMeshesNb; ++i)
+	const size_t vertexSize = VertexPacker::GetVertexSize(m_vertexLayout);
+
+	MeshFileHeader header = {};
+	std::memcpy(header.magic, MeshFileMagic, sizeof(MeshFileMagic));
+	header.version = MeshFileVersion;
+	header.vertexLayout = static_cast<uint32_t>(m_vertexLayout);
+	header.vertexSize = static_cast<uint32_t>(vertexSize);
+	header.subMeshCount = static_cast<uint32_t>(subMeshes.size());
+	WriteVector(header.boundsMin, m_boundingBox.min);
+	WriteVector(header.boundsMax, m_boundingBox.max);
+	header.subMeshesOffset = sizeof(MeshFileHeader);
+
+	// Levels of detail of all the sub meshes follow the sub meshes table
+	std::vector<MeshFileLOD> lodTable;
+	for (const MeshData& data : subMeshes)
+	{
+		for (const MeshLOD& lod : data.lods)
+			lodTable.push_back({ lod.indexOffset, lod.indexCount, lod.error, 0 });
+	}
+	const uint64_t lodsOffset = header.subMeshesOffset + subMeshes.size() * sizeof(MeshFileSubMesh);
+
+	// Then their meshlets
+	std::vector<MeshFileMeshlet> meshletTable;
+	for (const MeshData& data : subMeshes)
+	{
+		for (const Meshlet& meshlet : data.meshlets)
+		{
+			MeshFileMeshlet& entry = meshletTable.emplace_back();
+			entry.indexOffset = meshlet.indexOffset;
+			entry.indexCount = meshlet.indexCount;
+			WriteVector(entry.center, meshlet.center);
+			entry.radius = meshlet.radius;
+			WriteVector(entry.coneAxis, meshlet.coneAxis);
+			entry.coneCutoff = meshlet.coneCutoff;
+		}
+	}
+	const uint64_t meshletsOffset = lodsOffset + lodTable.size() * sizeof(MeshFileLOD);
+	header.streamsOffset = AlignStream(meshletsOffset + meshletTable.size() * sizeof(MeshFileMeshlet));
+
+	// Streams are laid out one after the other, each one aligned
+	std::vector<MeshFileSubMesh> table(subMeshes.size());
+	uint64_t offset = header.streamsOffset;
+	uint64_t lodOffset = lodsOffset;
+	uint64_t meshletOffset = meshletsOffset;
+	for (size_t i = 0; i < subMeshes.size(); ++i)
+	{
+		MeshData& data = subMeshes[i];
+		MeshFileSubMesh& subMesh = table[i];
+
+		subMesh.lodCount = static_cast<uint32_t>(data.lods.size());
+		subMesh.lodsOffset = lodOffset;
+		lodOffset += data.lods.size() * sizeof(MeshFileLOD);
+
+		subMesh.meshletCount = static_cast<uint32_t>(data.meshlets.size());
+		subMesh.meshletsOffset = meshletOffset;
+		meshletOffset += data.meshlets.size() * sizeof(MeshFileMeshlet);
+
+		VertexPacker::ComputeBounds(data.vertices, data.boundsMin, data.boundsMax);
+
+		subMesh.material = data.material ? data.material->GetUID().Bytes() : HYGUID().Bytes();
+		WriteVector(subMesh.boundsMin, data.boundsMin);
+		WriteVector(subMesh.boundsMax, data.boundsMax);
+		subMesh.vertexCount = static_cast<uint32_t>(data.vertices.size());
+		subMesh.indexCount = static_cast<uint32_t>(data.indices.size());
+		subMesh.indexSize = VertexPacker::CanUseShortIndices(data.vertices.size()) ? sizeof(uint16_t) : sizeof(int);
+
+		subMesh.verticesOffset = offset;
+		offset = AlignStream(offset + data.vertices.size() * vertexSize);
+		subMesh.indicesOffset = offset;
+		offset = AlignStream(offset + data.indices.size() * subMesh.indexSize);
+	}
+	header.streamsSize = offset - header.streamsOffset;
+
+	o.write(reinterpret_cast<const char*>(&header), sizeof(MeshFileHeader));
+	o.write(reinterpret_cast<const char*>(table.data()), table.size() * sizeof(MeshFileSubMesh));
+	o.write(reinterpret_cast<const char*>(lodTable.data()), lodTable.size() * sizeof(MeshFileLOD));
+	o.write(reinterpret_cast<const char*>(meshletTable.data()), meshletTable.size() * sizeof(MeshFileMeshlet));
+
+	const char padding[MeshStreamAlignment] = {};
+	uint64_t position = meshletOffset;
+	auto writeStream = [&](uint64_t streamOffset, const void* bytes, size_t size) {
+		o.write(padding, static_cast<std::streamsize>(streamOffset - position));
+		o.write(reinterpret_cast<const char*>(bytes), static_cast<std::streamsize>(size));
+		position = streamOffset + size;
+		};
+
+	std::vector<unsigned char> packedVertices;
+	std::vector<uint16_t> shortIndices;
+	for (size_t i = 0; i < subMeshes.size(); ++i)
 	{
 		const MeshData& data = subMeshes[i];
-		int verticesCount = static_cast<int>(data.vertices.size());
-		int indicesCount = static_cast<int>(data.indices.size());
 
-		HYGUID defaultGUID;
-		o.write(reinterpret_cast<const char*>(data.material ? &data.material->GetUID() : &defaultGUID), sizeof(HYGUID));
-		o.write(reinterpret_cast<const char*>(&verticesCount), sizeof(int));
-		o.write(reinterpret_cast<const char*>(&indicesCount), sizeof(int));
-		o.write(reinterpret_cast<const char*>(data.vertices.data()), data.vertices.size() * sizeof(Vertex));
-		o.write(reinterpret_cast<const char*>(data.indices.data()), data.indices.size() * sizeof(int));
+		packedVertices.resize(data.vertices.size() * vertexSize);
+		VertexPacker::Pack(m_vertexLayout, data.vertices, data.boundsMin, data.boundsMax, packedVertices.data());
+		writeStream(table[i].verticesOffset, packedVertices.data(), packedVertices.size());
+
+		if (table[i].indexSize == sizeof(uint16_t))
+		{
+			shortIndices.assign(data.indices.begin(), data.indices.end());
+			writeStream(table[i].indicesOffset, shortIndices.data(), shortIndices.size() * sizeof(uint16_t));
+		}
+		else
+		{
+			writeStream(table[i].indicesOffset, data.indices.data(), data.indices.size() * sizeof(int));
+		}
 	}
+	o.write(padding, static_cast<std::streamsize>(offset - position));
 
 	o.close();
+
+	releaseUploadedIndices();
 }
 
 void Mesh::Deserialize()
+{
+	subMeshes.clear();
+	m_mappedFile.Close();
+
+	if (!m_mappedFile.Open(m_filepath))
+	{
+		Logger::Warning("Can't load asset file : " + m_filepath);
+		return;
+	}
+
+	const MeshFileHeader* header = m_mappedFile.View<MeshFileHeader>(0);
+	if (header != nullptr && std::memcmp(header->magic, MeshFileMagic, sizeof(MeshFileMagic)) == 0)
+	{
+		if (!DeserializeMapped())
+		{
+			Logger::Warning("Invalid mesh file : " + m_filepath);
+			subMeshes.clear();
+			m_mappedFile.Close();
+		}
+		return;
+	}
+
+	// Files written before the mapped format are read once in memory, saving the mesh converts them
+	m_mappedFile.Close();
+	DeserializeLegacy();
+}
+
+bool Mesh::DeserializeMapped()
+{
+	const MeshFileHeader* header = m_mappedFile.View<MeshFileHeader>(0);
+	if (header->version != MeshFileVersion || header->vertexLayout > static_cast<uint32_t>(EVertexLayout::PACKED_HALF))
+		return false;
+
+	const EVertexLayout layout = static_cast<EVertexLayout>(header->vertexLayout);
+	const size_t vertexSize = VertexPacker::GetVertexSize(layout);
+	if (header->vertexSize != vertexSize)
+		return false;
+
+	const MeshFileSubMesh* table = m_mappedFile.View<MeshFileSubMesh>(header->subMeshesOffset, header->subMeshCount);
+	if (table == nullptr)
+		return false;
+
+	m_vertexLayout = layout;
+	m_boundingBox.min = ReadVector(header->boundsMin);
+	m_boundingBox.max = ReadVector(header->boundsMax);
+
+	subMeshes.resize(header->subMeshCount);
+	for (uint32_t k = 0; k < header->subMeshCount; ++k)
+	{
+		const MeshFileSubMesh& subMesh = table[k];
+		MeshData& data = subMeshes[k];
+
+		if (subMesh.indexSize != sizeof(uint16_t) && subMesh.indexSize != sizeof(int))
+			return false;
+
+		// Views are bound checked, the pages are only read when the streams are uploaded or drawn
+		const size_t verticesSize = static_cast<size_t>(subMesh.vertexCount) * vertexSize;
+		const size_t indicesSize = static_cast<size_t>(subMesh.indexCount) * subMesh.indexSize;
+		const unsigned char* vertices = m_mappedFile.View<unsigned char>(subMesh.verticesOffset, verticesSize);
+		const unsigned char* indices = m_mappedFile.View<unsigned char>(subMesh.indicesOffset, indicesSize);
+		if (vertices == nullptr || indices == nullptr)
+			return false;
+
+		data.lods.clear();
+		if (subMesh.lodCount > 0)
+		{
+			const MeshFileLOD* lods = m_mappedFile.View<MeshFileLOD>(subMesh.lodsOffset, subMesh.lodCount);
+			if (lods == nullptr)
+				return false;
+
+			for (uint32_t l = 0; l < subMesh.lodCount; ++l)
+			{
+				if (static_cast<uint64_t>(lods[l].indexOffset) + lods[l].indexCount > subMesh.indexCount)
+					return false;
+
+				data.lods.push_back({ lods[l].indexOffset, lods[l].indexCount, lods[l].error });
+			}
+		}
+
+		// Meshlets split the finest level
+		data.meshlets.clear();
+		if (subMesh.meshletCount > 0)
+		{
+			const MeshFileMeshlet* meshlets = m_mappedFile.View<MeshFileMeshlet>(subMesh.meshletsOffset, subMesh.meshletCount);
+			if (meshlets == nullptr)
+				return false;
+
+			const MeshLOD finest = subMesh.lodCount > 0 ? data.lods[0] : MeshLOD{ 0, subMesh.indexCount, 0.f };
+			data.meshlets.reserve(subMesh.meshletCount);
+			for (uint32_t m = 0; m < subMesh.meshletCount; ++m)
+			{
+				const MeshFileMeshlet& entry = meshlets[m];
+				if (entry.indexOffset < finest.indexOffset
+					|| static_cast<uint64_t>(entry.indexOffset) + entry.indexCount > static_cast<uint64_t>(finest.indexOffset) + finest.indexCount)
+					return false;
+
+				Meshlet& meshlet = data.meshlets.emplace_back();
+				meshlet.indexOffset = entry.indexOffset;
+				meshlet.indexCount = entry.indexCount;
+				meshlet.center = ReadVector(entry.center);
+				meshlet.radius = entry.radius;
+				meshlet.coneAxis = ReadVector(entry.coneAxis);
+				meshlet.coneCutoff = entry.coneCutoff;
+			}
+		}
+
+		data.mappedVertices = std::span<const unsigned char>(vertices, verticesSize);
+		data.mappedIndices = std::span<const unsigned char>(indices, indicesSize);
+		data.mappedLayout = layout;
+		data.mappedShortIndices = subMesh.indexSize == sizeof(uint16_t);
+		data.boundsMin = ReadVector(subMesh.boundsMin);
+		data.boundsMax = ReadVector(subMesh.boundsMax);
+		data.material = EngineContext::Instance().resourcesManager->GetResource<Material>(HYGUID(subMesh.material));
+	}
+
+	return true;
+}
+
+void Mesh::DeserializeLegacy()
 {
 	std::ifstream i(m_filepath, std::ifstream::binary);
 	if (!i)
@@ -81,8 +488,6 @@ void Mesh::Deserialize()
 		return;
 	}
 
-	subMeshes.clear();
-
 	i.read(reinterpret_cast<char*>(&m_boundingBox.min), sizeof(Vector3));
 	i.read(reinterpret_cast<char*>(&m_boundingBox.max), sizeof(Vector3));
 
@@ -112,6 +517,67 @@ void Mesh::Deserialize()
 	i.close();
 }
 
+void Mesh::DetachMappedData()
+{
+	if (!m_mappedFile.IsOpen())
+		return;
+
+	for (MeshData& data : subMeshes)
+	{
+		std::vector<Vertex> buffer;
+		std::span<const Vertex> vertices = data.GetVertices(buffer);
+		data.vertices.assign(vertices.begin(), vertices.end());
+
+		// Indices released after their upload are only on the GPU
+		if (data.HasShortIndices())
+		{
+			const uint16_t* indices = static_cast<const uint16_t*>(data.GetIndexData());
+			data.indices.assign(indices, indices + data.GetIndexCount());
+		}
+		else if (data.HasIndexData())
+		{
+			const int* indices = static_cast<const int*>(data.GetIndexData());
+			data.indices.assign(indices, indices + data.GetIndexCount());
+		}
+
+		data.mappedVertices = {};
+		data.mappedIndices = {};
+	}
+
+	m_mappedFile.Close();
+}
+
+#pragma endregion
+
+void Mesh::ReleaseFiles()
+{
+	// The mesh may still be drawn until it is destroyed, its streams are copied before the file is unmapped
+	DetachMappedData();
+}
+
+void Mesh::GetDependencies(std::vector<HYGUID>& dependencies) const
+{
+	for (const MeshData& subMesh : subMeshes)
+		AddDependency(dependencies, subMesh.material);
+}
+
+void Mesh::ClearSubMeshes()
+{
+	// The streams point to the mapped file, they are released before it
+	subMeshes.clear();
+	m_mappedFile.Close();
+}
+
+
+EVertexLayout Mesh::GetVertexLayout() const
+{
+	return m_vertexLayout;
+}
+
+void Mesh::SetVertexLayout(EVertexLayout layout)
+{
+	m_vertexLayout = layout;
+}
 
 const BoundingBox& Mesh::GetBoudingBox() const
 {
@@ -54,6 +54,38 @@ void Model::AddMaterial(Material& material)
 	m_materials.emplace_back(&material);
 }
 
+EVertexLayout Model::GetVertexLayout() const
+{
+	return m_vertexLayout;
+}
+
+void Model::SetVertexLayout(EVertexLayout layout)
+{
+	m_vertexLayout = layout;
+}
+
+MeshSimplifier::ChainSettings Model::GetLODSettings() const
+{
+	return { m_lodCount, m_lodReduction, m_lodMaxError };
+}
+
+void Model::SetLODSettings(const MeshSimplifier::ChainSettings& settings)
+{
+	m_lodCount = settings.levelCount;
+	m_lodReduction = settings.reduction;
+	m_lodMaxError = settings.maxError;
+}
+
+bool Model::GetBuildMeshlets() const
+{
+	return m_buildMeshlets;
+}
+
+void Model::SetBuildMeshlets(bool buildMeshlets)
+{
+	m_buildMeshlets = buildMeshlets;
+}
+
 // Call when a new resource is added to the project
 bool Model::Import(const std::string& path)
 {
@@ -63,11 +95,51 @@ bool Model::Import(const std::string& path)
 	return ResourcesLoader::LoadModel(*this);
 }
 
+void Model::GetImportSettings(std::string& settings) const
+{
+	settings = "layout=" + std::to_string(static_cast<int>(m_vertexLayout))
+		+ ";lods=" + std::to_string(m_lodCount)
+		+ ";reduction=" + std::to_string(m_lodReduction)
+		+ ";maxError=" + std::to_string(m_lodMaxError)
+		+ ";meshlets=" + std::to_string(m_buildMeshlets);
+}
+
+bool Model::Reimport()
+{
+	// Meshes and materials are filled again rather than created, the scenes referencing them stay valid.
+	// Those shared with another model are left unchanged by the parser, see ImportContentIndex::Reuse
+	AssimpParser::ReusedResources reused;
+	for (Mesh* mesh : m_meshes)
+		reused.emplace(mesh->GetFilepath(), mesh);
+	for (Material* material : m_materials)
+		reused.emplace(material->GetFilepath(), material);
+
+	std::vector<Mesh*> meshes = std::move(m_meshes);
+	std::vector<TransformData> meshesOffsets = std::move(m_meshesOffsets);
+	std::vector<Material*> materials = std::move(m_materials);
+	m_meshes.clear();
+	m_meshesOffsets.clear();
+	m_materials.clear();
+
+	if (ResourcesLoader::LoadModel(*this, reused))
+		return true;
+
+	m_meshes = std::move(meshes);
+	m_meshesOffsets = std::move(meshesOffsets);
+	m_materials = std::move(materials);
+	return false;
+}
+
 void Model::Serialize()
 {
 	json j;
 
 	j["extension"] = StringHelper::GetFileExtensionFromPath(m_originalPath);
+	j["vertexLayout"] = static_cast<int>(m_vertexLayout);
+	j["lodCount"] = m_lodCount;
+	j["lodReduction"] = m_lodReduction;
+	j["lodMaxError"] = m_lodMaxError;
+	j["buildMeshlets"] = m_buildMeshlets;
 
 	Serialization::SetContainer<float>(j["boudingBoxMin"], m_boundingBox.min);
 	Serialization::SetContainer<float>(j["boudingBoxMax"], m_boundingBox.max);
@@ -109,6 +181,15 @@ void Model::Deserialize()
 	Serialization::TryGetValue(j, "extension", ext);
 	m_originalPath = StringHelper::GetFilePathWithoutExtension(m_filepath) + ext;
 
+	int vertexLayout = 0;
+	if (Serialization::TryGetValue(j, "vertexLayout", vertexLayout))
+		m_vertexLayout = static_cast<EVertexLayout>(vertexLayout);
+
+	Serialization::TryGetValue(j, "lodCount", m_lodCount);
+	Serialization::TryGetValue(j, "lodReduction", m_lodReduction);
+	Serialization::TryGetValue(j, "lodMaxError", m_lodMaxError);
+	Serialization::TryGetValue(j, "buildMeshlets", m_buildMeshlets);
+
 	Serialization::TryGetContainer<float>(j, "boudingBoxMin", m_boundingBox.min);
 	Serialization::TryGetContainer<float>(j, "boudingBoxMax", m_boundingBox.max);
 
@@ -142,6 +223,15 @@ void Model::Deserialize()
 	m_jsonGraph = j["prefab"];
 }
 
+void Model::GetDependencies(std::vector<HYGUID>& dependencies) const
+{
+	for (const Mesh* mesh : m_meshes)
+		AddDependency(dependencies, mesh);
+
+	for (const Material* material : m_materials)
+		AddDependency(dependencies, material);
+}
+
 const BoundingBox& Model::GetBoudingBox() const
 {
 	return m_boundingBox;
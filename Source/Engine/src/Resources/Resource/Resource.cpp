@@ -2,6 +2,7 @@
 
 #include "Tools/StringHelper.hpp"
 #include "Resources/Loaders/ResourcesLoader.hpp"
+#include "Resources/ResourcesManager.hpp"
 
 #include "Generated/Resource.rfks.h"
 
@@ -26,6 +27,8 @@ void Resource::Copy(const Resource& resource)
 	m_filepath = resource.m_filepath;
 	m_filename = resource.m_filename;
 	m_type = resource.m_type;
+
+	UpdateIndex();
 }
 
 void Resource::Rename(std::string_view newName)
@@ -42,16 +45,40 @@ RESOURCE_TYPE Resource::GetType() const
 	return m_type;
 }
 
+void Resource::AddDependency(std::vector<HYGUID>& dependencies, const Resource* resource)
+{
+	if (resource)
+		dependencies.emplace_back(resource->GetUID());
+}
+
+RESOURCE_STATE Resource::GetState() const
+{
+	return m_state.Get();
+}
+
+bool Resource::TrySetState(RESOURCE_STATE state)
+{
+	return m_state.TryTransition(state);
+}
+
+void Resource::WaitWhileLoading() const
+{
+	m_state.WaitWhileLoading();
+}
+
 void Resource::SetType(RESOURCE_TYPE type)
 {
 	m_type = type;
+	UpdateIndex();
 }
 
 void Resource::SetFileInfo(const std::string& path)
 {
-	SetFilepath(path);
-	SetFilename(StringHelper::GetFileNameFromPath(m_filepath));
+	m_filepath = path;
+	m_filename = StringHelper::GetFileNameFromPath(m_filepath);
 	m_name = StringHelper::GetFileNameWithoutExtension(m_filename);
+
+	UpdateIndex();
 }
 
 const std::string& Resource::GetClassName() const
@@ -67,6 +94,7 @@ const std::string& Resource::GetFilename() const
 void Resource::SetFilename(const std::string& filename)
 {
 	m_filename = filename;
+	UpdateIndex();
 }
 
 const std::string& Resource::GetFilepath() const
@@ -77,6 +105,13 @@ const std::string& Resource::GetFilepath() const
 void Resource::SetFilepath(const std::string& path)
 {
 	m_filepath = path;
+	UpdateIndex();
+}
+
+void Resource::UpdateIndex()
+{
+	if (m_indexLinks.owner)
+		m_indexLinks.owner->ReindexResource(this);
 }
 
 bool Resource::Import(const std::string& path)
@@ -23,6 +23,8 @@ Scene::Scene(const HYGUID& uid)
 	: Resource(uid, staticGetArchetype().getName()), m_root("SCENE_ROOT")
 {
 	m_type = RESOURCE_TYPE::SCENE;
+	m_root.m_sceneID = uid;
+	m_root.m_sceneAllocator = &m_allocator;
 	EngineContext::Instance().sceneManager->Register(this);
 }
 
@@ -126,9 +128,16 @@ GameObject* Scene::GetGameObjectFromName(const HyString& name)
 	return nullptr;
 }
 
+const SceneAllocator& Scene::GetAllocator() const
+{
+	return m_allocator;
+}
+
 GameObject* Scene::CreateGameObject(const std::string& name, const HYGUID& uid)
 {
-	GameObject* go = (m_gameObjects[uid] = std::make_unique<GameObject>(name, uid)).get();
+	GameObject* go = (m_gameObjects[uid] = m_allocator.NewGameObject(name, uid)).get();
+	go->m_sceneID = GetUID();
+	go->m_sceneAllocator = &m_allocator;
 	go->SetParent(&m_root);
 
 	return go;
@@ -156,13 +165,18 @@ void Scene::Unload()
 	if (!isLoaded)
 		return;
 
-	// remove all gameObjects and components
-	while (m_root.GetChildCount() != 0)
-		DestroyGameObject(*m_root.GetChild(0), false);
+	// Remove all components, each system drops the scene instances in one pass
+	EngineContext::Instance().systemManager->DestroySceneComponents(GetUID());
 
-	//m_gameObjects.clear();
+	// Then free all gameObjects at once, no need to detach them one by one
+	m_gameObjects.clear();
 	m_root.Clear();
 
+	// Every object of the scene is destroyed, give the pools memory back.
+	// Live blocks mean an object outlives its scene, the pools are kept so it does not use freed memory
+	if (!m_allocator.Release())
+		Logger::Error("Scene - Objects of the scene " + GetFilename() + " are still alive after its unload, its memory is not released");
+
 	isLoaded = false;
 }
 
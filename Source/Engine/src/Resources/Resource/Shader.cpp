@@ -66,13 +66,22 @@ bool Shader::Create(const std::string& filePath, std::string& shaderStr)
 
 
 void Shader::Generate(const char* content, unsigned int type)
+{
+    Compile(content, type);
+    CheckCompileStatus();
+}
+
+void Shader::Compile(const char* content, unsigned int type)
 {
     ID = glCreateShader(type);
 
     glShaderSource(ID, 1, &content, NULL);
     // Compile the shader
     glCompileShader(ID);
+}
 
+bool Shader::CheckCompileStatus() const
+{
     // Check if the compilation has succeeded
     GLint success;
     glGetShaderiv(ID, GL_COMPILE_STATUS, &success);
@@ -83,5 +92,8 @@ void Shader::Generate(const char* content, unsigned int type)
         glGetShaderInfoLog(ID, infoSize, NULL, infoLog);
         Logger::Error("Shader - Filepath.ext TODO shader compilation failed" + std::string(infoLog));
 
+        return false;
     };
+
+    return true;
 }
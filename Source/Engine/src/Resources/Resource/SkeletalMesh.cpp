@@ -29,7 +29,13 @@ void SkeletalMesh::LoadInGPUMemory()
 
 void SkeletalMesh::UnloadFromGPUMemory()
 {
-	SystemManager::GetRenderSystem().GPUWrapper.CreateSkeletalMeshData(*this);
+	SystemManager::GetRenderSystem().GPUWrapper.RemoveSkeletalMeshData(*this);
+}
+
+void SkeletalMesh::ClearSubMeshes()
+{
+	Mesh::ClearSubMeshes();
+	skeletonDatas.clear();
 }
 
 void SkeletalMesh::Serialize()
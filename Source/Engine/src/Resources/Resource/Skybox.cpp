@@ -49,6 +49,12 @@ void Skybox::Reload()
 	GPUData->Generate(*this);
 }
 
+bool Skybox::Reimport()
+{
+	Reload();
+	return true;
+}
+
 void Skybox::Serialize()
 {
 	json j;
@@ -85,3 +91,13 @@ void Skybox::Deserialize()
 		down = RM->GetResource<Texture>(HYGUID(textureIds[5]));
 	}
 }
+
+void Skybox::GetDependencies(std::vector<HYGUID>& dependencies) const
+{
+	AddDependency(dependencies, front);
+	AddDependency(dependencies, back);
+	AddDependency(dependencies, left);
+	AddDependency(dependencies, right);
+	AddDependency(dependencies, up);
+	AddDependency(dependencies, down);
+}
@@ -34,6 +34,12 @@ void Terrain::Reload(bool forceReload)
 	ResourcesLoader::LoadTerrain(*this, forceReload);
 }
 
+bool Terrain::Reimport()
+{
+	// The height map changed, the mesh is generated again
+	return ResourcesLoader::LoadTerrain(*this, true);
+}
+
 void Terrain::Serialize()
 {
 	json j;
@@ -68,3 +74,9 @@ void Terrain::Deserialize()
 	Serialization::TryGetValue(j, "rowNb", rowNb);
 	Serialization::TryGetValue(j, "columnNb", columnNb);
 }
+
+void Terrain::GetDependencies(std::vector<HYGUID>& dependencies) const
+{
+	AddDependency(dependencies, heightMapTexture);
+	AddDependency(dependencies, heightMapMesh);
+}
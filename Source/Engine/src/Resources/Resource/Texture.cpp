@@ -31,6 +31,41 @@ Flags<EImageSTB> const& Texture::GetLoadingFlags() const
 	return m_flag;
 }
 
+void Texture::SetLoadingFlags(const Flags<EImageSTB>& flags)
+{
+	m_flag = flags;
+}
+
+void Texture::SetUsage(ETextureUsage usage)
+{
+	m_flag.Disable(EImageSTB::IMG_SRGB, EImageSTB::IMG_COMPRESS_COLOR, EImageSTB::IMG_COMPRESS_NORMAL, EImageSTB::IMG_COMPRESS_MASK);
+
+	switch (usage)
+	{
+	case ETextureUsage::COLOR:
+		m_flag.Enable(EImageSTB::IMG_SRGB, EImageSTB::IMG_COMPRESS_COLOR);
+		break;
+	case ETextureUsage::NORMAL:
+		m_flag.Enable(EImageSTB::IMG_COMPRESS_NORMAL);
+		break;
+	case ETextureUsage::MASK:
+		m_flag.Enable(EImageSTB::IMG_COMPRESS_MASK);
+		break;
+	}
+}
+
+bool Texture::CanBeUsedAs(ETextureUsage usage) const
+{
+	// BC4 only keeps red, BC5 red and green
+	if (m_flag.TestBit(EImageSTB::IMG_COMPRESS_MASK))
+		return usage == ETextureUsage::MASK;
+
+	if (m_flag.TestBit(EImageSTB::IMG_COMPRESS_NORMAL))
+		return usage != ETextureUsage::COLOR;
+
+	return true;
+}
+
 bool Texture::Import(const std::string& path)
 {
 	originalPath = path;
@@ -39,6 +74,32 @@ bool Texture::Import(const std::string& path)
 	return ResourcesLoader::LoadTextureUnsafe(*this);
 }
 
+void Texture::GetImportSettings(std::string& settings) const
+{
+	settings = "flags=" + std::to_string(m_flag.GetFlagAsInt());
+}
+
+bool Texture::Reimport()
+{
+	// The texture cache checks the source size and write time, a changed image is decoded again
+	if (!ResourcesLoader::LoadTextureUnsafe(*this))
+		return false;
+
+	UnloadFromGPUMemory();
+	TrySetState(RESOURCE_STATE::CPU_READY);
+
+	LoadInGPUMemory();
+	if (!IsGPUUploadPending())
+		TrySetState(RESOURCE_STATE::GPU_READY);
+
+	return true;
+}
+
+void Texture::StageGPUData()
+{
+	SystemManager::GetRenderSystem().GPUWrapper.StageTextureData(*this);
+}
+
 void Texture::LoadInGPUMemory()
 {
 	SystemManager::GetRenderSystem().GPUWrapper.CreateTextureData(*this);
@@ -50,6 +111,11 @@ void Texture::UnloadFromGPUMemory()
 	SystemManager::GetRenderSystem().GPUWrapper.RemoveTextureData(*this);
 }
 
+bool Texture::IsGPUUploadPending() const
+{
+	return GPUData != nullptr && GPUData->uploadTicket != 0;
+}
+
 void Texture::Serialize()
 {
 	json j;
@@ -0,0 +1,84 @@
+#include "Resources/ResourceRegistry.hpp"
+
+#include "Resources/Resource/Resource.hpp"
+
+ResourceRegistry::ResourceRegistry()
+{
+}
+
+ResourceRegistry::~ResourceRegistry()
+{
+}
+
+ResourceRegistry::Shard& ResourceRegistry::GetShard(const HYGUID& id)
+{
+	return m_shards[std::hash<HYGUID>()(id) >> (sizeof(size_t) * 8 - ShardBits)];
+}
+
+const ResourceRegistry::Shard& ResourceRegistry::GetShard(const HYGUID& id) const
+{
+	return m_shards[std::hash<HYGUID>()(id) >> (sizeof(size_t) * 8 - ShardBits)];
+}
+
+Resource* ResourceRegistry::Find(const HYGUID& id) const
+{
+	const Shard& shard = GetShard(id);
+	std::shared_lock readGuard(shard.mutex);
+
+	auto it = shard.resources.find(id);
+	return it != shard.resources.end() ? it->second.get() : nullptr;
+}
+
+bool ResourceRegistry::Contains(const HYGUID& id) const
+{
+	const Shard& shard = GetShard(id);
+	std::shared_lock readGuard(shard.mutex);
+
+	return shard.resources.contains(id);
+}
+
+std::pair<Resource*, bool> ResourceRegistry::TryInsert(const HYGUID& id, std::unique_ptr<Resource>& resource)
+{
+	Shard& shard = GetShard(id);
+	std::unique_lock writeGuard(shard.mutex);
+
+	auto [it, inserted] = shard.resources.try_emplace(id);
+	if (!inserted)
+		return { it->second.get(), false };
+
+	it->second = std::move(resource);
+
+	m_size.fetch_add(1, std::memory_order_relaxed);
+	return { it->second.get(), true };
+}
+
+std::unique_ptr<Resource> ResourceRegistry::Extract(const HYGUID& id)
+{
+	Shard& shard = GetShard(id);
+	std::unique_lock writeGuard(shard.mutex);
+
+	auto it = shard.resources.find(id);
+	if (it == shard.resources.end())
+		return nullptr;
+
+	std::unique_ptr<Resource> resource = std::move(it->second);
+	shard.resources.erase(it);
+
+	m_size.fetch_sub(1, std::memory_order_relaxed);
+	return resource;
+}
+
+std::vector<Resource*> ResourceRegistry::GetAll() const
+{
+	std::vector<Resource*> resources;
+	resources.reserve(Size());
+
+	ForEach([&resources](Resource* resource) { resources.emplace_back(resource); });
+
+	return resources;
+}
+
+size_t ResourceRegistry::Size() const
+{
+	return m_size.load(std::memory_order_relaxed);
+}
@@ -2,23 +2,16 @@
 
 #include "Resources/Loaders/ResourcesLoader.hpp"
 
-#include "Resources/Resource/Shader.hpp"
-#include "Resources/Resource/Texture.hpp"
-#include "Resources/Resource/Mesh.hpp"
-#include "Resources/Resource/Model.hpp"
 #include "Resources/Resource/Material.hpp"
-#include "Resources/Resource/Prefab.hpp"
-#include "Resources/Resource/Sound.hpp"
 #include "Renderer/MeshShader.hpp"
 
 #include "Tools/PathConfig.hpp"
-#include "Tools/StringHelper.hpp"
 
 #include "Core/Logger.hpp"
 
 
 
-ResourcesManager::ResourcesManager()
+ResourcesManager::ResourcesManager() : m_importIndex(*this, std::string(CACHE_ROOT) + "ImportContentIndex.hyci")
 {
 }
 
@@ -41,6 +34,14 @@ void ResourcesManager::CreateResourceFiles(Resource* resource)
 
 Resource* ResourcesManager::CreateResource(const std::string& typeString, const HYGUID& id)
 {
+	bool created = false;
+	return GetOrCreateResource(typeString, id, created);
+}
+
+Resource* ResourcesManager::GetOrCreateResource(const std::string& typeString, const HYGUID& id, bool& created)
+{
+	created = false;
+
 	// Check if the class is reflected and is a resource
 	rfk::Class const* c = rfk::getDatabase().getFileLevelClassByName(typeString.c_str());
 	if (!c || !c->isSubclassOf(Resource::staticGetArchetype()))
@@ -49,27 +50,158 @@ Resource* ResourcesManager::CreateResource(const std::string& typeString, const
 		return nullptr;
 	}
 
-	// Create the new resource
-	m_resources.emplace(id, c->makeUniqueInstance<Resource>(id));
+	if (Resource* resource = m_registry.Find(id))
+		return resource;
+
+	// Build the resource out of the locks, it is destroyed below if another thread inserted the GUID first
+	std::unique_ptr<Resource> newResource(c->makeUniqueInstance<Resource>(id));
+	if (!newResource)
+	{
+		Logger::Error("ResourcesManager - Failed to instantiate a " + typeString);
+		return nullptr;
+	}
+
+	std::unique_lock indexGuard(m_indexMutex);
+	auto [resource, inserted] = InsertResource(id, newResource);
+	indexGuard.unlock();
+
+	created = inserted;
+	return resource;
+}
+
+std::pair<Resource*, bool> ResourcesManager::InsertResource(const HYGUID& id, std::unique_ptr<Resource>& resource)
+{
+	auto [stored, inserted] = m_registry.TryInsert(id, resource);
+
+	// Still under the index lock : a DestroyResource extracting it now waits for this indexing before unindexing it
+	if (inserted)
+		IndexResource(stored);
+
+	return { stored, inserted };
+}
+
+void ResourcesManager::IndexResource(Resource* resource)
+{
+	ResourceIndexLinks& links = resource->m_indexLinks;
+	links.owner = this;
+
+	links.pathKey = resource->GetFilepath();
+	if (!links.pathKey.empty())
+		LinkInIndex(m_pathIndex, links.pathKey, resource, &ResourceIndexLinks::nextSamePath);
+
+	links.filenameKey = resource->GetFilename();
+	if (!links.filenameKey.empty())
+		LinkInIndex(m_filenameIndex, links.filenameKey, resource, &ResourceIndexLinks::nextSameFilename);
+
+	// Push front in the list of its type
+	links.typeKey = resource->GetType();
+	size_t typeIndex = static_cast<size_t>(links.typeKey);
+
+	links.previousOfType = nullptr;
+	links.nextOfType = m_typeLists[typeIndex];
+	if (links.nextOfType)
+		links.nextOfType->m_indexLinks.previousOfType = resource;
+
+	m_typeLists[typeIndex] = resource;
+	++m_typeCounts[typeIndex];
+}
+
+void ResourcesManager::UnindexResource(Resource* resource)
+{
+	ResourceIndexLinks& links = resource->m_indexLinks;
+	if (links.owner != this)
+		return;
+
+	if (!links.pathKey.empty())
+		UnlinkFromIndex(m_pathIndex, links.pathKey, resource, &ResourceIndexLinks::nextSamePath);
+
+	if (!links.filenameKey.empty())
+		UnlinkFromIndex(m_filenameIndex, links.filenameKey, resource, &ResourceIndexLinks::nextSameFilename);
+
+	size_t typeIndex = static_cast<size_t>(links.typeKey);
+
+	if (links.previousOfType)
+		links.previousOfType->m_indexLinks.nextOfType = links.nextOfType;
+	else
+		m_typeLists[typeIndex] = links.nextOfType;
+
+	if (links.nextOfType)
+		links.nextOfType->m_indexLinks.previousOfType = links.previousOfType;
+
+	--m_typeCounts[typeIndex];
+
+	links = ResourceIndexLinks();
+}
+
+void ResourcesManager::ReindexResource(Resource* resource)
+{
+	std::unique_lock indexGuard(m_indexMutex);
+
+	const ResourceIndexLinks& links = resource->m_indexLinks;
+	if (links.owner != this)
+		return;
+
+	// Keys are compared exactly so that a change of case is reflected in the stored keys
+	if (links.pathKey == resource->GetFilepath() && links.filenameKey == resource->GetFilename() && links.typeKey == resource->GetType())
+		return;
+
+	UnindexResource(resource);
+	IndexResource(resource);
+}
+
+void ResourcesManager::LinkInIndex(ResourceIndex& index, const std::string& key, Resource* resource, Resource* ResourceIndexLinks::* next)
+{
+	auto [it, inserted] = index.try_emplace(key, resource);
+	if (inserted)
+	{
+		resource->m_indexLinks.*next = nullptr;
+		return;
+	}
+
+	Resource* first = it->second;
+	resource->m_indexLinks.*next = first->m_indexLinks.*next;
+	first->m_indexLinks.*next = resource;
+}
+
+void ResourcesManager::UnlinkFromIndex(ResourceIndex& index, const std::string& key, Resource* resource, Resource* ResourceIndexLinks::* next)
+{
+	auto it = index.find(key);
+	if (it == index.end())
+		return;
+
+	// Walk the links of the key until the resource is found
+	Resource** link = &it->second;
+	while (*link && *link != resource)
+		link = &((*link)->m_indexLinks.*next);
+
+	if (*link == nullptr)
+		return;
+
+	*link = resource->m_indexLinks.*next;
+	resource->m_indexLinks.*next = nullptr;
 
-	return m_resources[id].get();
+	if (it->second == nullptr)
+		index.erase(it);
 }
 
 void ResourcesManager::DeleteResource(const HYGUID& uid)
 {
-	if (!HasResource(uid))
+	// Take the ownership first, a concurrent delete of the same resource gets nullptr and never touches it
+	std::unique_ptr<Resource> resource = m_registry.Extract(uid);
+	if (resource == nullptr)
 		return;
 
-	std::lock_guard resGuard(m_resourceMutex);
+	{
+		std::unique_lock indexGuard(m_indexMutex);
+		UnindexResource(resource.get());
+	}
 
 	// Delete files
-	ResourcesLoader::DeleteResourceFiles(m_resources[uid].get());
+	ResourcesLoader::DeleteResourceFiles(resource.get());
 
 	// Delete GPU memory (and remove from systems)
-	m_resources[uid]->UnloadFromGPUMemory();
-
-	// Destroy the resource
-	m_resources.erase(uid);
+	resource->UnloadFromGPUMemory();
+	resource->TrySetState(RESOURCE_STATE::UNLOADED);
 }
 
 void ResourcesManager::DeleteResource(Resource* resource)
@@ -82,94 +214,76 @@ void ResourcesManager::DeleteResource(Resource* resource)
 
 bool ResourcesManager::HasResource(const HYGUID& uid)
 {
-	std::lock_guard resGuard(m_resourceMutex);
-	return m_resources.find(uid) != m_resources.end();
+	return m_registry.Contains(uid);
 }
 
 bool ResourcesManager::HasResourceByPath(const std::string& path)
 {
-	std::lock_guard resGuard(m_resourceMutex);
-
-	for (auto& it : m_resources)
-	{
-		if (it.second->GetFilepath() == path)
-			return true;
-	}
-	return false;
+	std::shared_lock indexGuard(m_indexMutex);
+	return m_pathIndex.contains(path);
 }
 
 bool ResourcesManager::HasResourceByFilename(const std::string& name)
 {
-	std::lock_guard resGuard(m_resourceMutex);
-
-	for (auto& it : m_resources)
-	{
-		if (it.second->GetFilename() == name)
-			return true;
-	}
-	return false;
+	std::shared_lock indexGuard(m_indexMutex);
+	return m_filenameIndex.contains(name);
 }
 
 
 Resource* ResourcesManager::GetResource(const HYGUID& uid)
 {
-	if (HasResource(uid))
-		return m_resources[uid].get();
-
-	return nullptr;
+	return m_registry.Find(uid);
 }
 
-std::unordered_map<HYGUID, std::unique_ptr<Resource>>& ResourcesManager::GetResources()
+std::vector<Resource*> ResourcesManager::GetResources()
 {
-	return m_resources;
+	return m_registry.GetAll();
 }
 
 Resource* ResourcesManager::GetResourceByPath(const std::string& path)
 {
-	std::lock_guard resGuard(m_resourceMutex);
-
-	for (auto& it : m_resources)
-	{
-		if (it.second->GetFilepath() == path)
-			return it.second.get();
-	}
+	std::shared_lock indexGuard(m_indexMutex);
 
-	return nullptr;
+	auto it = m_pathIndex.find(path);
+	return it != m_pathIndex.end() ? it->second : nullptr;
 }
 
 Resource* ResourcesManager::GetResourceByFilename(const std::string& name)
 {
-	std::lock_guard resGuard(m_resourceMutex);
-
-	for (auto& it : m_resources)
-	{
-		std::string f = it.second->GetFilename();
-		if (f == name)
-			return it.second.get();
-	}
+	std::shared_lock indexGuard(m_indexMutex);
 
-	return nullptr;
+	auto it = m_filenameIndex.find(name);
+	return it != m_filenameIndex.end() ? it->second : nullptr;
 }
 
 std::vector<Resource*> ResourcesManager::GetResourcesList(RESOURCE_TYPE type)
 {
+	std::shared_lock indexGuard(m_indexMutex);
+
+	size_t typeIndex = static_cast<size_t>(type);
+
 	std::vector<Resource*> resourcesList;
-	for (auto& it : m_resources)
-	{
-		if (it.second->GetType() == type)
-			resourcesList.emplace_back(it.second.get());
-	}
+	resourcesList.reserve(m_typeCounts[typeIndex]);
+
+	for (Resource* resource = m_typeLists[typeIndex]; resource; resource = resource->m_indexLinks.nextOfType)
+		resourcesList.emplace_back(resource);
+
 	return resourcesList;
 }
 
 std::vector<std::string> ResourcesManager::GetResourcesNamesList(RESOURCE_TYPE type)
 {
+	std::shared_lock indexGuard(m_indexMutex);
+
+	size_t typeIndex = static_cast<size_t>(type);
+
 	std::vector<std::string> nameList;
-	for (auto& it : m_resources)
-	{
-		if (it.second->GetType() == type)
-			nameList.emplace_back(it.second->GetFilename());
-	}
+	nameList.reserve(m_typeCounts[typeIndex]);
+
+	// The indexed filename is guarded by m_indexMutex, the one of the resource may be changing on another thread
+	for (Resource* resource = m_typeLists[typeIndex]; resource; resource = resource->m_indexLinks.nextOfType)
+		nameList.emplace_back(resource->m_indexLinks.filenameKey);
+
 	return nameList;
 }
 
@@ -178,23 +292,7 @@ ResourcesTaskPool& ResourcesManager::GetTaskPool()
 	return m_taskPool;
 }
 
-void ResourcesManager::ImportNewResource(const std::string& path)
+ImportContentIndex& ResourcesManager::GetImportContentIndex()
 {
-	std::string ext = StringHelper::GetFileExtensionFromPath(path);
-	ExtensionType extType = ResourcesLoader::GetExtensionType(ext);
-
-	switch (extType)
-	{
-	case ExtensionType::MODEL:
-		ImportResource<Model>(path);
-		return;
-	case ExtensionType::TEXTURE:
-		ImportResource<Texture>(path);
-		return;
-	case ExtensionType::SOUND:
-		ImportResource<Sound>(path);
-		return;
-	default:
-		Logger::Warning("ResourcesManager : Failed to load new resource, file extension not supported of file " + std::string(path));
-	}
+	return m_importIndex;
 }
@@ -0,0 +1,32 @@
+#include "Resources/ResourcesManager.hpp"
+
+#include "Resources/Loaders/ResourcesLoader.hpp"
+
+#include "Resources/Resource/Texture.hpp"
+#include "Resources/Resource/Model.hpp"
+#include "Resources/Resource/Sound.hpp"
+
+#include "Tools/StringHelper.hpp"
+
+#include "Core/Logger.hpp"
+
+void ResourcesManager::ImportNewResource(const std::string& path)
+{
+	std::string ext = StringHelper::GetFileExtensionFromPath(path);
+	ExtensionType extType = ResourcesLoader::GetExtensionType(ext);
+
+	switch (extType)
+	{
+	case ExtensionType::MODEL:
+		ImportResource<Model>(path);
+		return;
+	case ExtensionType::TEXTURE:
+		ImportResource<Texture>(path);
+		return;
+	case ExtensionType::SOUND:
+		ImportResource<Sound>(path);
+		return;
+	default:
+		Logger::Warning("ResourcesManager : Failed to load new resource, file extension not supported of file " + std::string(path));
+	}
+}
@@ -0,0 +1,801 @@
+#include "Resources/SourceAssetTracker.hpp"
+
+#include <fstream>
+#include <cstring>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <filesystem>
+
+#include "Core/Logger.hpp"
+#include "Core/ResourcesTaskPool.hpp"
+
+#include "Resources/Loaders/ResourcesLoader.hpp"
+
+#include "Tools/MappedFile.hpp"
+#include "Tools/PathConfig.hpp"
+
+namespace fs = std::filesystem;
+
+namespace
+{
+	constexpr char ManifestMagic[4] = { 'H', 'Y', 'S', 'A' };
+	constexpr uint32_t ManifestVersion = 1;
+
+	// Number of known directories checked by one task
+	constexpr size_t DirectoryChunkSize = 16;
+
+	// Number of known files checked by one task, most of them are only stat
+	constexpr size_t FileChunkSize = 64;
+
+	// Time given to directories never scanned, it never matches a real write time
+	constexpr int64_t UnknownTime = INT64_MIN;
+
+	constexpr uint32_t RemovedDirectory = ~0u;
+
+	/**
+	@brief Layout of the manifest : header, directories, records then the string blob.
+	Strings are referenced by offset and size in the blob, paths are relative to the root directory.
+	*/
+	struct ManifestHeader
+	{
+		char		magic[4];
+		uint32_t	version;
+		uint32_t	directoryCount;
+		uint32_t	recordCount;
+		uint64_t	stringsSize;
+		uint64_t	directoriesOffset;
+		uint64_t	recordsOffset;
+		uint64_t	stringsOffset;
+	};
+
+	struct ManifestDirectory
+	{
+		uint32_t	pathOffset;
+		uint32_t	pathSize;
+		int64_t		time;
+	};
+
+	struct ManifestRecord
+	{
+		uint32_t	pathOffset;
+		uint32_t	pathSize;
+		uint32_t	directoryIndex;
+		uint32_t	padding;
+		uint64_t	size;
+		int64_t		time;
+		uint64_t	contentHash[2];
+		uint64_t	settingsHash[2];
+	};
+
+	enum class ERecordState : uint8_t
+	{
+		UNCHANGED,
+		TOUCHED,	// Size or time changed, same content and settings
+		MODIFIED,
+		REMOVED
+	};
+
+	/**
+	@brief Result of the check of a known directory
+	*/
+	struct DirectoryScan
+	{
+		bool exists = false;
+		bool changed = false;
+		int64_t time = UnknownTime;
+
+		std::vector<fs::path> sourcePaths;
+		std::vector<fs::path> newDirectories;
+	};
+
+	/**
+	@brief Result of the recursive scan of a directory unknown by the manifest
+	*/
+	struct NewDirectoryScan
+	{
+		std::vector<std::pair<fs::path, int64_t>> directories;
+		std::vector<std::vector<fs::path>> sourcePaths;
+	};
+
+	int64_t GetWriteTime(const fs::path& path, std::error_code& error)
+	{
+		return static_cast<int64_t>(fs::last_write_time(path, error).time_since_epoch().count());
+	}
+
+	bool IsSourceFile(const fs::directory_entry& entry, std::error_code& error)
+	{
+		return !entry.is_directory(error) && SourceAssetTracker::IsSourceAsset(entry.path().string());
+	}
+
+	std::pair<uint32_t, uint32_t> AddString(std::string& blob, const std::string& string)
+	{
+		std::pair<uint32_t, uint32_t> location = { static_cast<uint32_t>(blob.size()), static_cast<uint32_t>(string.size()) };
+		blob += string;
+		return location;
+	}
+
+	bool GetString(const MappedFile& file, const ManifestHeader& header, uint32_t offset, uint32_t size, std::string& string)
+	{
+		if (static_cast<uint64_t>(offset) + size > header.stringsSize)
+			return false;
+
+		const char* data = file.View<char>(header.stringsOffset + offset, size);
+		if (data == nullptr)
+			return false;
+
+		string.assign(data, size);
+		return true;
+	}
+
+	std::string GetPathFromRoot(const fs::path& root, const std::string& relativePath)
+	{
+		if (relativePath.empty() || relativePath == ".")
+			return root.string();
+
+		return (root / relativePath).string();
+	}
+
+	uint64_t AlignOffset(uint64_t offset)
+	{
+		return (offset + 7) & ~uint64_t(7);
+	}
+
+	/**
+	@brief Hash the content of a file and stat it
+
+	@param record : Record of the file, its path set
+	@return bool : false if the file could not be read
+	*/
+	bool HashFile(SourceAssetRecord& record)
+	{
+		std::error_code error;
+		const uint64_t size = fs::file_size(record.path, error);
+		if (error)
+			return false;
+
+		const int64_t time = GetWriteTime(record.path, error);
+		if (error || !ContentHash::ComputeFile(record.path, record.contentHash))
+			return false;
+
+		record.size = size;
+		record.time = time;
+		return true;
+	}
+
+	/**
+	@brief Check a known file : it is only read if its size or write time changed, its import settings are hashed again
+
+	@param record : Record of the file, updated
+	@param getSettings : Import settings of a source file
+	@param contentRead : Set to true if the content has been hashed
+	*/
+	ERecordState CheckRecord(SourceAssetRecord& record, const SourceAssetTracker::SettingsGetter& getSettings, bool& contentRead)
+	{
+		std::error_code error;
+		const uint64_t size = fs::file_size(record.path, error);
+		const int64_t time = error ? 0 : GetWriteTime(record.path, error);
+		if (error)
+			return ERecordState::REMOVED;
+
+		const Hash128 settingsHash = ContentHash::Compute(getSettings ? getSettings(record.path) : std::string());
+		const bool settingsChanged = settingsHash != record.settingsHash;
+
+		if (size == record.size && time == record.time)
+		{
+			record.settingsHash = settingsHash;
+			return settingsChanged ? ERecordState::MODIFIED : ERecordState::UNCHANGED;
+		}
+
+		// A file being written may not be readable yet, it is checked again by the next refresh
+		SourceAssetRecord hashed;
+		hashed.path = record.path;
+		if (!HashFile(hashed))
+			return ERecordState::UNCHANGED;
+
+		const bool contentChanged = hashed.contentHash != record.contentHash;
+		record.size = hashed.size;
+		record.time = hashed.time;
+		record.contentHash = hashed.contentHash;
+		record.settingsHash = settingsHash;
+		contentRead = true;
+
+		return contentChanged || settingsChanged ? ERecordState::MODIFIED : ERecordState::TOUCHED;
+	}
+
+	/**
+	@brief Get if a path is a directory or in it
+	*/
+	bool IsInDirectory(const std::string& path, const std::string& directory)
+	{
+		if (path.size() < directory.size() || !StringHelper::PathEqual()(path.substr(0, directory.size()), directory))
+			return false;
+
+		return path.size() == directory.size() || path[directory.size()] == '/' || path[directory.size()] == '\\';
+	}
+}
+
+SourceAssetTracker::SourceAssetTracker(const std::string& rootPath, const std::string& manifestPath)
+	: m_rootPath(rootPath), m_manifestPath(manifestPath)
+{
+
+}
+
+bool SourceAssetTracker::IsSourceAsset(const std::string& path)
+{
+	const ExtensionType type = ResourcesLoader::GetExtensionType(fs::path(path).extension().string());
+	return type == ExtensionType::MODEL || type == ExtensionType::TEXTURE || type == ExtensionType::SOUND;
+}
+
+std::string SourceAssetTracker::GetDefaultManifestPath(const std::string& rootPath)
+{
+	std::string absoluteRoot = fs::absolute(rootPath).lexically_normal().string();
+
+	std::stringstream name;
+	name << "SourceAssets_" << std::hex << std::setw(16) << std::setfill('0') << static_cast<uint64_t>(StringHelper::PathHash()(absoluteRoot)) << ".hysa";
+
+	return std::string(CACHE_ROOT) + name.str();
+}
+
+bool SourceAssetTracker::LoadManifest()
+{
+	m_directories.clear();
+	m_records.clear();
+
+	MappedFile file;
+	if (!file.Open(m_manifestPath))
+		return false;
+
+	const ManifestHeader* header = file.View<ManifestHeader>(0);
+	if (header == nullptr || std::memcmp(header->magic, ManifestMagic, sizeof(ManifestMagic)) != 0 || header->version != ManifestVersion)
+	{
+		Logger::Warning("SourceAssetTracker - Invalid manifest : " + m_manifestPath);
+		return false;
+	}
+
+	const ManifestDirectory* directories = file.View<ManifestDirectory>(header->directoriesOffset, header->directoryCount);
+	const ManifestRecord* records = file.View<ManifestRecord>(header->recordsOffset, header->recordCount);
+
+	if (directories == nullptr || records == nullptr || file.View<char>(header->stringsOffset, header->stringsSize) == nullptr)
+	{
+		Logger::Warning("SourceAssetTracker - Truncated manifest : " + m_manifestPath);
+		return false;
+	}
+
+	fs::path root = m_rootPath;
+	std::string relativePath;
+
+	m_directories.resize(header->directoryCount);
+	for (uint32_t i = 0; i < header->directoryCount; ++i)
+	{
+		if (!GetString(file, *header, directories[i].pathOffset, directories[i].pathSize, relativePath))
+			return false;
+
+		m_directories[i].path = GetPathFromRoot(root, relativePath);
+		m_directories[i].time = directories[i].time;
+	}
+
+	m_records.resize(header->recordCount);
+	for (uint32_t i = 0; i < header->recordCount; ++i)
+	{
+		const ManifestRecord& source = records[i];
+		SourceAssetRecord& record = m_records[i];
+
+		if (source.directoryIndex >= header->directoryCount || !GetString(file, *header, source.pathOffset, source.pathSize, relativePath))
+			return false;
+
+		record.path = GetPathFromRoot(root, relativePath);
+		record.directoryIndex = source.directoryIndex;
+		record.size = source.size;
+		record.time = source.time;
+		record.contentHash = { source.contentHash[0], source.contentHash[1] };
+		record.settingsHash = { source.settingsHash[0], source.settingsHash[1] };
+	}
+
+	return true;
+}
+
+void SourceAssetTracker::IndexRecords()
+{
+	m_recordIndex.clear();
+	m_recordIndex.reserve(m_records.size());
+	for (size_t i = 0; i < m_records.size(); ++i)
+		m_recordIndex.try_emplace(m_records[i].path, i);
+
+	m_directoryIndex.clear();
+	m_directoryIndex.reserve(m_directories.size());
+	for (uint32_t i = 0; i < m_directories.size(); ++i)
+		m_directoryIndex.try_emplace(m_directories[i].path, i);
+}
+
+uint32_t SourceAssetTracker::GetOrAddDirectory(const std::string& directoryPath)
+{
+	// Walk up to the first known directory, the root is always known
+	std::vector<std::string> missingDirectories;
+	fs::path directory = directoryPath;
+
+	auto it = m_directoryIndex.find(directory.string());
+	while (it == m_directoryIndex.end())
+	{
+		if (!directory.has_relative_path() || directory.parent_path() == directory)
+			return RemovedDirectory;
+
+		missingDirectories.push_back(directory.string());
+		directory = directory.parent_path();
+		it = m_directoryIndex.find(directory.string());
+	}
+
+	// The missing directories are enumerated by the next full refresh, their time matching no write time
+	uint32_t directoryIndex = it->second;
+	for (auto missing = missingDirectories.rbegin(); missing != missingDirectories.rend(); ++missing)
+	{
+		directoryIndex = static_cast<uint32_t>(m_directories.size());
+		m_directories.push_back({ *missing, UnknownTime });
+		m_directoryIndex.try_emplace(*missing, directoryIndex);
+	}
+
+	return directoryIndex;
+}
+
+void SourceAssetTracker::Refresh(ResourcesTaskPool& taskPool, const SettingsGetter& getSettings, std::vector<Change>& changes)
+{
+	changes.clear();
+
+	const bool firstRefresh = !m_loaded;
+	const bool manifestLoaded = m_stats.manifestLoaded;
+	m_stats = RefreshStats();
+	m_stats.manifestLoaded = manifestLoaded;
+
+	if (firstRefresh)
+	{
+		m_loaded = true;
+		m_stats.manifestLoaded = LoadManifest();
+
+		// A missing manifest is a full scan from the root
+		if (!m_stats.manifestLoaded || m_directories.empty())
+		{
+			m_directories.clear();
+			m_records.clear();
+			m_directories.push_back({ fs::path(m_rootPath).string(), UnknownTime });
+			m_dirty = true;
+		}
+	}
+
+	IndexRecords();
+	const auto& knownDirectories = m_directoryIndex;
+	const auto& knownFiles = m_recordIndex;
+
+	// Check known directories : only the changed ones are enumerated, for their new files and directories
+	std::vector<DirectoryScan> scans(m_directories.size());
+	taskPool.ParallelFor(m_directories.size(), DirectoryChunkSize, [this, &scans, &knownDirectories, &knownFiles](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i)
+		{
+			DirectoryScan& scan = scans[i];
+			std::error_code error;
+
+			scan.time = GetWriteTime(m_directories[i].path, error);
+			scan.exists = !error && fs::is_directory(m_directories[i].path, error);
+			scan.changed = scan.exists && scan.time != m_directories[i].time;
+			if (!scan.changed)
+				continue;
+
+			for (const auto& entry : fs::directory_iterator(m_directories[i].path, error))
+			{
+				if (entry.is_directory(error))
+				{
+					if (!knownDirectories.contains(entry.path().string()))
+						scan.newDirectories.emplace_back(entry.path());
+				}
+				else if (IsSourceFile(entry, error) && !knownFiles.contains(entry.path().string()))
+				{
+					scan.sourcePaths.emplace_back(entry.path());
+				}
+			}
+		}
+		});
+
+	// Check known files : the ones keeping their size and time are not read, only their import settings are hashed again
+	std::vector<ERecordState> states(m_records.size(), ERecordState::UNCHANGED);
+	std::vector<char> contentRead(m_records.size(), 0);
+	taskPool.ParallelFor(m_records.size(), FileChunkSize, [this, &scans, &states, &contentRead, &getSettings](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i)
+		{
+			SourceAssetRecord& record = m_records[i];
+			if (!scans[record.directoryIndex].exists)
+			{
+				states[i] = ERecordState::REMOVED;
+				continue;
+			}
+
+			bool read = false;
+			states[i] = CheckRecord(record, getSettings, read);
+			contentRead[i] = read;
+		}
+		});
+	m_stats.checkedFiles = m_records.size();
+
+	// Rebuild the directory list, dropping the directories which don't exist anymore
+	std::vector<DirectoryRecord> directories;
+	std::vector<uint32_t> directoryRemap(m_directories.size(), RemovedDirectory);
+	std::vector<std::pair<fs::path, uint32_t>> newFiles;
+	std::vector<fs::path> newDirectories;
+
+	for (size_t i = 0; i < scans.size(); ++i)
+	{
+		DirectoryScan& scan = scans[i];
+		if (!scan.exists)
+			continue;
+
+		directoryRemap[i] = static_cast<uint32_t>(directories.size());
+		directories.push_back({ std::move(m_directories[i].path), scan.time });
+
+		if (scan.changed)
+			m_stats.scannedDirectories++;
+
+		for (fs::path& path : scan.sourcePaths)
+			newFiles.emplace_back(std::move(path), directoryRemap[i]);
+
+		newDirectories.insert(newDirectories.end(), std::make_move_iterator(scan.newDirectories.begin()), std::make_move_iterator(scan.newDirectories.end()));
+	}
+
+	// New directories are enumerated recursively, each by its own task
+	std::vector<NewDirectoryScan> newScans(newDirectories.size());
+	taskPool.ParallelFor(newDirectories.size(), 1, [&newDirectories, &newScans](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i)
+		{
+			NewDirectoryScan& scan = newScans[i];
+			std::error_code error;
+
+			scan.directories.emplace_back(newDirectories[i], GetWriteTime(newDirectories[i], error));
+			scan.sourcePaths.emplace_back();
+
+			std::vector<size_t> stack = { 0 };
+			while (!stack.empty())
+			{
+				size_t current = stack.back();
+				stack.pop_back();
+
+				fs::path directory = scan.directories[current].first;
+				for (const auto& entry : fs::directory_iterator(directory, error))
+				{
+					if (entry.is_directory(error))
+					{
+						stack.push_back(scan.directories.size());
+						scan.directories.emplace_back(entry.path(), GetWriteTime(entry.path(), error));
+						scan.sourcePaths.emplace_back();
+					}
+					else if (IsSourceFile(entry, error))
+					{
+						scan.sourcePaths[current].emplace_back(entry.path());
+					}
+				}
+			}
+		}
+		});
+
+	for (NewDirectoryScan& scan : newScans)
+	{
+		for (size_t i = 0; i < scan.directories.size(); ++i)
+		{
+			uint32_t directoryIndex = static_cast<uint32_t>(directories.size());
+			directories.push_back({ scan.directories[i].first.string(), scan.directories[i].second });
+			m_stats.scannedDirectories++;
+
+			for (fs::path& path : scan.sourcePaths[i])
+				newFiles.emplace_back(std::move(path), directoryIndex);
+		}
+	}
+
+	// Hash new files with their settings
+	std::vector<SourceAssetRecord> newRecords(newFiles.size());
+	std::vector<char> hashed(newFiles.size(), 0);
+	taskPool.ParallelFor(newFiles.size(), 1, [&newFiles, &newRecords, &hashed, &getSettings](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i)
+		{
+			SourceAssetRecord& record = newRecords[i];
+			record.path = newFiles[i].first.string();
+			record.directoryIndex = newFiles[i].second;
+			record.settingsHash = ContentHash::Compute(getSettings ? getSettings(record.path) : std::string());
+			hashed[i] = HashFile(record);
+		}
+		});
+
+	// Keep the records of the existing files, then add the new ones
+	std::vector<SourceAssetRecord> records;
+	records.reserve(m_records.size() + newRecords.size());
+	for (size_t i = 0; i < m_records.size(); ++i)
+	{
+		SourceAssetRecord& record = m_records[i];
+		const uint32_t directoryIndex = directoryRemap[record.directoryIndex];
+
+		if (states[i] == ERecordState::REMOVED || directoryIndex == RemovedDirectory)
+		{
+			changes.push_back({ std::move(record.path), EChange::REMOVED });
+			continue;
+		}
+
+		if (states[i] == ERecordState::MODIFIED)
+			changes.push_back({ record.path, EChange::MODIFIED });
+
+		if (states[i] != ERecordState::UNCHANGED)
+			m_dirty = true;
+
+		m_stats.hashedFiles += contentRead[i];
+
+		record.directoryIndex = directoryIndex;
+		records.emplace_back(std::move(record));
+	}
+
+	for (size_t i = 0; i < newRecords.size(); ++i)
+	{
+		if (!hashed[i])
+			continue;
+
+		changes.push_back({ newRecords[i].path, EChange::ADDED });
+		records.emplace_back(std::move(newRecords[i]));
+		m_stats.hashedFiles++;
+	}
+
+	std::sort(changes.begin(), changes.end(), [](const Change& a, const Change& b) { return a.path < b.path; });
+
+	m_dirty |= !changes.empty() || m_stats.scannedDirectories != 0 || directories.size() != m_directories.size();
+
+	m_directories = std::move(directories);
+	m_records = std::move(records);
+	IndexRecords();
+}
+
+void SourceAssetTracker::RefreshFiles(ResourcesTaskPool& taskPool, const SettingsGetter& getSettings, const std::vector<std::string>& paths, std::vector<Change>& changes)
+{
+	// The records of the other files are loaded and checked once
+	if (!m_loaded)
+	{
+		Refresh(taskPool, getSettings, changes);
+		return;
+	}
+
+	changes.clear();
+
+	const bool manifestLoaded = m_stats.manifestLoaded;
+	m_stats = RefreshStats();
+	m_stats.manifestLoaded = manifestLoaded;
+
+	// Sort the paths : known files to check, new source files to hash and removed directories
+	std::vector<size_t> knownFiles;
+	std::vector<std::string> newFiles;
+	std::vector<std::string> removedDirectories;
+
+	FlatHashMap<std::string, bool, StringHelper::PathHash, StringHelper::PathEqual> visitedPaths;
+	for (const std::string& path : paths)
+	{
+		if (!visitedPaths.try_emplace(path, true).second)
+			continue;
+
+		auto record = m_recordIndex.find(path);
+		if (record != m_recordIndex.end())
+		{
+			knownFiles.push_back(record->second);
+			continue;
+		}
+
+		std::error_code error;
+		const bool exists = fs::exists(path, error);
+
+		if (!exists && m_directoryIndex.contains(path))
+			removedDirectories.push_back(path);
+		else if (exists && !fs::is_directory(path, error) && IsSourceAsset(path))
+			newFiles.push_back(path);
+	}
+
+	std::vector<ERecordState> states(knownFiles.size(), ERecordState::UNCHANGED);
+	std::vector<char> contentRead(knownFiles.size(), 0);
+	taskPool.ParallelFor(knownFiles.size(), 1, [this, &knownFiles, &states, &contentRead, &getSettings](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i)
+		{
+			bool read = false;
+			states[i] = CheckRecord(m_records[knownFiles[i]], getSettings, read);
+			contentRead[i] = read;
+		}
+		});
+
+	std::vector<SourceAssetRecord> newRecords(newFiles.size());
+	std::vector<char> hashed(newFiles.size(), 0);
+	taskPool.ParallelFor(newFiles.size(), 1, [&newFiles, &newRecords, &hashed, &getSettings](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i)
+		{
+			SourceAssetRecord& record = newRecords[i];
+			record.path = newFiles[i];
+			record.settingsHash = ContentHash::Compute(getSettings ? getSettings(record.path) : std::string());
+			hashed[i] = HashFile(record);
+		}
+		});
+	m_stats.checkedFiles = knownFiles.size() + newFiles.size();
+
+	// Files of the removed directories, they are not reported one by one on every platform
+	FlatHashMap<size_t, bool> removedRecords;
+	if (!removedDirectories.empty())
+	{
+		for (size_t i = 0; i < m_records.size(); ++i)
+		{
+			for (const std::string& directory : removedDirectories)
+			{
+				if (IsInDirectory(m_records[i].path, directory))
+				{
+					removedRecords.try_emplace(i, true);
+					break;
+				}
+			}
+		}
+	}
+
+	for (size_t i = 0; i < knownFiles.size(); ++i)
+	{
+		m_stats.hashedFiles += contentRead[i];
+
+		if (states[i] == ERecordState::REMOVED)
+			removedRecords.try_emplace(knownFiles[i], true);
+		else if (states[i] == ERecordState::MODIFIED)
+			changes.push_back({ m_records[knownFiles[i]].path, EChange::MODIFIED });
+
+		if (states[i] != ERecordState::UNCHANGED)
+			m_dirty = true;
+	}
+
+	if (!removedRecords.empty() || !removedDirectories.empty())
+	{
+		// Drop the removed directories, with their sub directories
+		std::vector<DirectoryRecord> directories;
+		std::vector<uint32_t> directoryRemap(m_directories.size(), RemovedDirectory);
+		for (uint32_t i = 0; i < m_directories.size(); ++i)
+		{
+			const bool removed = std::any_of(removedDirectories.begin(), removedDirectories.end(),
+				[this, i](const std::string& directory) { return IsInDirectory(m_directories[i].path, directory); });
+
+			if (removed)
+				continue;
+
+			directoryRemap[i] = static_cast<uint32_t>(directories.size());
+			directories.emplace_back(std::move(m_directories[i]));
+		}
+
+		std::vector<SourceAssetRecord> records;
+		records.reserve(m_records.size());
+		for (size_t i = 0; i < m_records.size(); ++i)
+		{
+			SourceAssetRecord& record = m_records[i];
+			if (removedRecords.contains(i) || directoryRemap[record.directoryIndex] == RemovedDirectory)
+			{
+				changes.push_back({ std::move(record.path), EChange::REMOVED });
+				continue;
+			}
+
+			record.directoryIndex = directoryRemap[record.directoryIndex];
+			records.emplace_back(std::move(record));
+		}
+
+		m_directories = std::move(directories);
+		m_records = std::move(records);
+		m_dirty = true;
+		IndexRecords();
+	}
+
+	for (size_t i = 0; i < newRecords.size(); ++i)
+	{
+		if (!hashed[i])
+			continue;
+
+		SourceAssetRecord& record = newRecords[i];
+		record.directoryIndex = GetOrAddDirectory(fs::path(record.path).parent_path().string());
+		if (record.directoryIndex == RemovedDirectory)
+			continue;
+
+		changes.push_back({ record.path, EChange::ADDED });
+		m_recordIndex.try_emplace(record.path, m_records.size());
+		m_records.emplace_back(std::move(record));
+
+		m_stats.hashedFiles++;
+		m_dirty = true;
+	}
+
+	std::sort(changes.begin(), changes.end(), [](const Change& a, const Change& b) { return a.path < b.path; });
+}
+
+bool SourceAssetTracker::Save()
+{
+	if (!m_dirty)
+		return true;
+
+	fs::path root = m_rootPath;
+	std::string strings;
+
+	std::vector<ManifestDirectory> directories(m_directories.size());
+	for (size_t i = 0; i < m_directories.size(); ++i)
+	{
+		auto [offset, size] = AddString(strings, fs::path(m_directories[i].path).lexically_relative(root).string());
+		directories[i] = { offset, size, m_directories[i].time };
+	}
+
+	std::vector<ManifestRecord> records(m_records.size());
+	for (size_t i = 0; i < m_records.size(); ++i)
+	{
+		const SourceAssetRecord& source = m_records[i];
+		ManifestRecord& record = records[i];
+		std::memset(&record, 0, sizeof(ManifestRecord));
+
+		std::tie(record.pathOffset, record.pathSize) = AddString(strings, fs::path(source.path).lexically_relative(root).string());
+		record.directoryIndex = source.directoryIndex;
+		record.size = source.size;
+		record.time = source.time;
+		record.contentHash[0] = source.contentHash.low;
+		record.contentHash[1] = source.contentHash.high;
+		record.settingsHash[0] = source.settingsHash.low;
+		record.settingsHash[1] = source.settingsHash.high;
+	}
+
+	ManifestHeader header;
+	std::memset(&header, 0, sizeof(ManifestHeader));
+	std::memcpy(header.magic, ManifestMagic, sizeof(ManifestMagic));
+	header.version = ManifestVersion;
+	header.directoryCount = static_cast<uint32_t>(directories.size());
+	header.recordCount = static_cast<uint32_t>(records.size());
+	header.stringsSize = strings.size();
+	header.directoriesOffset = AlignOffset(sizeof(ManifestHeader));
+	header.recordsOffset = AlignOffset(header.directoriesOffset + directories.size() * sizeof(ManifestDirectory));
+	header.stringsOffset = AlignOffset(header.recordsOffset + records.size() * sizeof(ManifestRecord));
+
+	// Write next to the manifest then replace it, a crash never leaves a partial manifest
+	std::error_code error;
+	fs::path manifestPath = m_manifestPath;
+	if (manifestPath.has_parent_path())
+		fs::create_directories(manifestPath.parent_path(), error);
+
+	std::string temporaryPath = m_manifestPath + ".tmp";
+	{
+		std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+		if (!file.is_open())
+		{
+			Logger::Warning("SourceAssetTracker - Can't write manifest : " + m_manifestPath);
+			return false;
+		}
+
+		auto writeAt = [&file](uint64_t offset, const void* data, size_t size) {
+			static const char zeros[8] = { 0 };
+			file.write(zeros, static_cast<std::streamsize>(offset - static_cast<uint64_t>(file.tellp())));
+			file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+		};
+
+		writeAt(0, &header, sizeof(ManifestHeader));
+		writeAt(header.directoriesOffset, directories.data(), directories.size() * sizeof(ManifestDirectory));
+		writeAt(header.recordsOffset, records.data(), records.size() * sizeof(ManifestRecord));
+		writeAt(header.stringsOffset, strings.data(), strings.size());
+
+		if (!file.good())
+		{
+			file.close();
+			fs::remove(temporaryPath, error);
+			Logger::Warning("SourceAssetTracker - Can't write manifest : " + m_manifestPath);
+			return false;
+		}
+	}
+
+	fs::rename(temporaryPath, m_manifestPath, error);
+	if (error)
+	{
+		fs::remove(temporaryPath, error);
+		Logger::Warning("SourceAssetTracker - Can't replace manifest : " + m_manifestPath);
+		return false;
+	}
+
+	m_dirty = false;
+	return true;
+}
+
+const std::vector<SourceAssetRecord>& SourceAssetTracker::GetRecords() const
+{
+	return m_records;
+}
+
+const SourceAssetTracker::RefreshStats& SourceAssetTracker::GetStats() const
+{
+	return m_stats;
+}
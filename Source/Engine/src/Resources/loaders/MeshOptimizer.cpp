@@ -0,0 +1,355 @@
+#include "Resources/Loaders/MeshOptimizer.hpp"
+
+#include <cstdint>
+#include <numeric>
+#include <algorithm>
+
+namespace
+{
+	/**
+	@brief FIFO cache simulated with timestamps : a vertex is in cache while less than cacheSize vertices were added after it
+	*/
+	struct CacheSimulator
+	{
+		std::vector<unsigned int> timestamps;
+		unsigned int time;
+		unsigned int size;
+
+		CacheSimulator(size_t vertexCount, unsigned int cacheSize)
+			: timestamps(vertexCount, 0), time(cacheSize + 1), size(cacheSize)
+		{}
+
+		bool IsCached(unsigned int vertex) const
+		{
+			return time - timestamps[vertex] <= size;
+		}
+
+		// Return true on a miss
+		bool Access(unsigned int vertex)
+		{
+			if (IsCached(vertex))
+				return false;
+
+			timestamps[vertex] = time++;
+			return true;
+		}
+
+		void Flush()
+		{
+			time += size + 1;
+		}
+	};
+
+	bool AreIndicesValid(std::span<const int> indices, size_t vertexCount)
+	{
+		return indices.size() % 3 == 0 && std::all_of(indices.begin(), indices.end(), [vertexCount](int index) {
+			return index >= 0 && static_cast<size_t>(index) < vertexCount;
+		});
+	}
+
+	/**
+	@brief Get the next vertex to fan around : the candidate with live triangles that stays the longest in cache
+	if all its triangles are emitted, else the last dead end vertex, else the next vertex in input order
+	*/
+	int64_t GetNextVertex(const std::vector<unsigned int>& candidates, const std::vector<unsigned int>& liveTriangles, const CacheSimulator& cache,
+		std::vector<unsigned int>& deadEnds, size_t& cursor)
+	{
+		int64_t best = -1;
+		int64_t bestPriority = -1;
+
+		for (unsigned int vertex : candidates)
+		{
+			if (liveTriangles[vertex] == 0)
+				continue;
+
+			// Age of the vertex once its triangles are emitted, zero if it would be out of cache
+			int64_t priority = 0;
+			const int64_t age = static_cast<int64_t>(cache.time - cache.timestamps[vertex]);
+			if (age + 2 * static_cast<int64_t>(liveTriangles[vertex]) <= cache.size)
+				priority = age;
+
+			if (priority > bestPriority)
+			{
+				bestPriority = priority;
+				best = vertex;
+			}
+		}
+
+		if (best >= 0)
+			return best;
+
+		while (!deadEnds.empty())
+		{
+			const unsigned int vertex = deadEnds.back();
+			deadEnds.pop_back();
+
+			if (liveTriangles[vertex] > 0)
+				return vertex;
+		}
+
+		for (; cursor < liveTriangles.size(); ++cursor)
+		{
+			if (liveTriangles[cursor] > 0)
+				return static_cast<int64_t>(cursor);
+		}
+
+		return -1;
+	}
+
+	struct TriangleCluster
+	{
+		size_t firstTriangle;
+		size_t triangleCount;
+		float sortKey;
+	};
+}
+
+MeshOptimizer::VertexCacheStats MeshOptimizer::AnalyzeVertexCache(std::span<const int> indices, size_t vertexCount, unsigned int cacheSize)
+{
+	VertexCacheStats stats;
+	if (!AreIndicesValid(indices, vertexCount))
+		return stats;
+
+	CacheSimulator cache(vertexCount, cacheSize);
+	std::vector<bool> used(vertexCount, false);
+
+	for (int index : indices)
+	{
+		if (cache.Access(index))
+			stats.transformedVertexCount++;
+
+		if (!used[index])
+		{
+			used[index] = true;
+			stats.vertexCount++;
+		}
+	}
+
+	stats.triangleCount = indices.size() / 3;
+	stats.ACMR = stats.triangleCount > 0 ? static_cast<float>(stats.transformedVertexCount) / static_cast<float>(stats.triangleCount) : 0.f;
+	stats.ATVR = stats.vertexCount > 0 ? static_cast<float>(stats.transformedVertexCount) / static_cast<float>(stats.vertexCount) : 0.f;
+
+	return stats;
+}
+
+
+#pragma region VERTEX_CACHE
+
+void MeshOptimizer::OptimizeVertexCache(std::vector<int>& indices, size_t vertexCount, unsigned int cacheSize)
+{
+	if (indices.empty() || !AreIndicesValid(indices, vertexCount))
+		return;
+
+	const size_t triangleCount = indices.size() / 3;
+
+	// Triangles around each vertex
+	std::vector<unsigned int> liveTriangles(vertexCount, 0);
+	for (int index : indices)
+		liveTriangles[index]++;
+
+	std::vector<size_t> adjacencyOffsets(vertexCount + 1, 0);
+	for (size_t vertex = 0; vertex < vertexCount; ++vertex)
+		adjacencyOffsets[vertex + 1] = adjacencyOffsets[vertex] + liveTriangles[vertex];
+
+	std::vector<unsigned int> adjacency(indices.size());
+	{
+		std::vector<size_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+		for (size_t i = 0; i < indices.size(); ++i)
+			adjacency[fill[indices[i]]++] = static_cast<unsigned int>(i / 3);
+	}
+
+	CacheSimulator cache(vertexCount, cacheSize);
+	std::vector<bool> emitted(triangleCount, false);
+	std::vector<unsigned int> deadEnds;
+	std::vector<unsigned int> candidates;
+	deadEnds.reserve(indices.size());
+
+	std::vector<int> output;
+	output.reserve(indices.size());
+
+	size_t cursor = 0;
+	int64_t fanning = GetNextVertex(candidates, liveTriangles, cache, deadEnds, cursor);
+
+	while (fanning >= 0)
+	{
+		candidates.clear();
+
+		for (size_t i = adjacencyOffsets[fanning]; i < adjacencyOffsets[fanning + 1]; ++i)
+		{
+			const unsigned int triangle = adjacency[i];
+			if (emitted[triangle])
+				continue;
+
+			for (size_t corner = 0; corner < 3; ++corner)
+			{
+				const unsigned int vertex = static_cast<unsigned int>(indices[triangle * 3 + corner]);
+
+				output.push_back(static_cast<int>(vertex));
+				deadEnds.push_back(vertex);
+				candidates.push_back(vertex);
+
+				liveTriangles[vertex]--;
+				cache.Access(vertex);
+			}
+
+			emitted[triangle] = true;
+		}
+
+		fanning = GetNextVertex(candidates, liveTriangles, cache, deadEnds, cursor);
+	}
+
+	indices.swap(output);
+}
+
+#pragma endregion
+
+
+#pragma region OVERDRAW
+
+void MeshOptimizer::OptimizeOverdraw(std::vector<int>& indices, std::span<const Vertex> vertices, float threshold, unsigned int cacheSize)
+{
+	if (indices.empty() || !AreIndicesValid(indices, vertices.size()))
+		return;
+
+	const size_t triangleCount = indices.size() / 3;
+	CacheSimulator cache(vertices.size(), cacheSize);
+
+	auto triangleMisses = [&](size_t triangle) {
+		int misses = 0;
+		for (size_t corner = 0; corner < 3; ++corner)
+			misses += cache.Access(indices[triangle * 3 + corner]) ? 1 : 0;
+		return misses;
+	};
+
+	// Hard boundaries, where the cache optimized order already starts from scratch
+	std::vector<size_t> hardBoundaries = { 0 };
+	for (size_t triangle = 0; triangle < triangleCount; ++triangle)
+	{
+		if (triangleMisses(triangle) == 3 && triangle > 0)
+			hardBoundaries.push_back(triangle);
+	}
+	hardBoundaries.push_back(triangleCount);
+
+	// Soft boundaries, cut inside a hard cluster as soon as the part before is efficient enough
+	std::vector<TriangleCluster> clusters;
+	for (size_t i = 0; i + 1 < hardBoundaries.size(); ++i)
+	{
+		const size_t start = hardBoundaries[i];
+		const size_t end = hardBoundaries[i + 1];
+
+		cache.Flush();
+		int clusterMisses = 0;
+		for (size_t triangle = start; triangle < end; ++triangle)
+			clusterMisses += triangleMisses(triangle);
+
+		const float clusterThreshold = threshold * static_cast<float>(clusterMisses) / static_cast<float>(end - start);
+
+		cache.Flush();
+		size_t clusterStart = start;
+		int runningMisses = 0;
+
+		for (size_t triangle = start; triangle < end; ++triangle)
+		{
+			runningMisses += triangleMisses(triangle);
+
+			const size_t runningTriangles = triangle + 1 - clusterStart;
+			if (triangle + 1 == end || static_cast<float>(runningMisses) <= clusterThreshold * static_cast<float>(runningTriangles))
+			{
+				clusters.push_back({ clusterStart, runningTriangles, 0.f });
+
+				clusterStart = triangle + 1;
+				runningMisses = 0;
+				cache.Flush();
+			}
+		}
+	}
+
+	// Clusters facing away from the center of the mesh come first
+	auto triangleArea = [&](size_t triangle, Vector3& center, Vector3& normal) {
+		const Vector3& a = vertices[indices[triangle * 3 + 0]].position;
+		const Vector3& b = vertices[indices[triangle * 3 + 1]].position;
+		const Vector3& c = vertices[indices[triangle * 3 + 2]].position;
+
+		normal = Vector3::CrossProduct(b - a, c - a);
+		center = (a + b + c) / 3.f;
+		return normal.Magnitude();
+	};
+
+	Vector3 meshCenter(0.f, 0.f, 0.f);
+	float meshArea = 0.f;
+	for (size_t triangle = 0; triangle < triangleCount; ++triangle)
+	{
+		Vector3 center, normal;
+		const float area = triangleArea(triangle, center, normal);
+		meshCenter = meshCenter + center * area;
+		meshArea += area;
+	}
+	if (meshArea > 0.f)
+		meshCenter = meshCenter / meshArea;
+
+	for (TriangleCluster& cluster : clusters)
+	{
+		Vector3 clusterCenter(0.f, 0.f, 0.f);
+		Vector3 clusterNormal(0.f, 0.f, 0.f);
+		float clusterArea = 0.f;
+
+		for (size_t triangle = cluster.firstTriangle; triangle < cluster.firstTriangle + cluster.triangleCount; ++triangle)
+		{
+			Vector3 center, normal;
+			const float area = triangleArea(triangle, center, normal);
+			clusterCenter = clusterCenter + center * area;
+			clusterNormal = clusterNormal + normal;
+			clusterArea += area;
+		}
+
+		if (clusterArea <= 0.f)
+			continue;
+
+		clusterCenter = clusterCenter / clusterArea;
+		cluster.sortKey = Vector3::DotProduct(clusterCenter - meshCenter, clusterNormal.SafeNormalized());
+	}
+
+	std::stable_sort(clusters.begin(), clusters.end(), [](const TriangleCluster& a, const TriangleCluster& b) {
+		return a.sortKey > b.sortKey;
+	});
+
+	std::vector<int> output;
+	output.reserve(indices.size());
+	for (const TriangleCluster& cluster : clusters)
+	{
+		auto first = indices.begin() + cluster.firstTriangle * 3;
+		output.insert(output.end(), first, first + cluster.triangleCount * 3);
+	}
+
+	indices.swap(output);
+}
+
+#pragma endregion
+
+
+#pragma region VERTEX_FETCH
+
+size_t MeshOptimizer::OptimizeVertexFetch(std::vector<int>& indices, size_t vertexCount, std::vector<unsigned int>& remap)
+{
+	if (!AreIndicesValid(indices, vertexCount))
+	{
+		remap.resize(vertexCount);
+		std::iota(remap.begin(), remap.end(), 0u);
+		return vertexCount;
+	}
+
+	remap.assign(vertexCount, UnusedVertex);
+
+	unsigned int nextVertex = 0;
+	for (int& index : indices)
+	{
+		if (remap[index] == UnusedVertex)
+			remap[index] = nextVertex++;
+
+		index = static_cast<int>(remap[index]);
+	}
+
+	return nextVertex;
+}
+
+#pragma endregion
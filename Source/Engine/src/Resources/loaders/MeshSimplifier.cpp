@@ -0,0 +1,644 @@
+#include "Resources/Loaders/MeshSimplifier.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+
+namespace
+{
+	// Weight of the planes keeping borders and seams in place, against the planes of the triangles
+	constexpr double EdgeQuadricWeight = 10.0;
+
+	// Bound on the passes, each one removes up to half of the triangles left to remove
+	constexpr size_t MaxPassCount = 100;
+
+	enum class VertexKind : uint8_t
+	{
+		MANIFOLD,	// Moves freely
+		BORDER,		// On an open edge, moves along it
+		SEAM,		// On an attribute seam between two vertices of the same position, both move along it
+		LOCKED,		// Corner of seams, borders or non manifold edges, never moves
+	};
+
+	/**
+	@brief Sum of squared distances to planes : x^T A x + 2 b.x + c, divided by weight
+	*/
+	struct Quadric
+	{
+		double a00 = 0.0, a11 = 0.0, a22 = 0.0;
+		double a10 = 0.0, a20 = 0.0, a21 = 0.0;
+		double b0 = 0.0, b1 = 0.0, b2 = 0.0;
+		double c = 0.0;
+		double weight = 0.0;
+
+		void AddPlane(double nx, double ny, double nz, double d, double planeWeight)
+		{
+			a00 += planeWeight * nx * nx;
+			a11 += planeWeight * ny * ny;
+			a22 += planeWeight * nz * nz;
+			a10 += planeWeight * ny * nx;
+			a20 += planeWeight * nz * nx;
+			a21 += planeWeight * nz * ny;
+			b0 += planeWeight * nx * d;
+			b1 += planeWeight * ny * d;
+			b2 += planeWeight * nz * d;
+			c += planeWeight * d * d;
+			weight += planeWeight;
+		}
+
+		void Add(const Quadric& other)
+		{
+			a00 += other.a00; a11 += other.a11; a22 += other.a22;
+			a10 += other.a10; a20 += other.a20; a21 += other.a21;
+			b0 += other.b0; b1 += other.b1; b2 += other.b2;
+			c += other.c;
+			weight += other.weight;
+		}
+
+		double Evaluate(const Vector3& point) const
+		{
+			const double x = point.x, y = point.y, z = point.z;
+			const double error = a00 * x * x + a11 * y * y + a22 * z * z
+				+ 2.0 * (a10 * x * y + a20 * x * z + a21 * y * z)
+				+ 2.0 * (b0 * x + b1 * y + b2 * z) + c;
+
+			return weight > 0.0 ? std::max(error, 0.0) / weight : 0.0;
+		}
+	};
+
+	struct EdgeRecord
+	{
+		unsigned int positionA, positionB;	// Sorted
+		unsigned int vertexA, vertexB;		// Sorted
+		unsigned int triangle;
+	};
+
+	struct Collapse
+	{
+		unsigned int from;
+		unsigned int to;
+		double error;
+	};
+
+	Vector3 TriangleNormal(const Vector3& a, const Vector3& b, const Vector3& c)
+	{
+		return Vector3::CrossProduct(b - a, c - a);
+	}
+
+	/**
+	@brief Topology of the input : vertices of the same position, kinds and quadrics
+	*/
+	struct SimplifierMesh
+	{
+		std::span<const Vertex> vertices;
+
+		std::vector<unsigned int> positionIds;	// First vertex of each position
+		std::vector<unsigned int> nextWedge;	// Circular list of the vertices of a position
+		std::vector<VertexKind> kinds;
+		std::vector<Quadric> quadrics;			// By position id
+
+		void BuildPositions()
+		{
+			const size_t count = vertices.size();
+			std::vector<unsigned int> order(count);
+			for (size_t i = 0; i < count; ++i)
+				order[i] = static_cast<unsigned int>(i);
+
+			auto less = [this](unsigned int a, unsigned int b) {
+				const Vector3& pa = vertices[a].position;
+				const Vector3& pb = vertices[b].position;
+				if (pa.x != pb.x) return pa.x < pb.x;
+				if (pa.y != pb.y) return pa.y < pb.y;
+				if (pa.z != pb.z) return pa.z < pb.z;
+				return a < b;
+			};
+			std::sort(order.begin(), order.end(), less);
+
+			positionIds.resize(count);
+			nextWedge.resize(count);
+			for (size_t i = 0; i < count;)
+			{
+				size_t end = i + 1;
+				while (end < count && vertices[order[end]].position == vertices[order[i]].position)
+					end++;
+
+				for (size_t k = i; k < end; ++k)
+				{
+					positionIds[order[k]] = order[i];
+					nextWedge[order[k]] = order[k + 1 < end ? k + 1 : i];
+				}
+				i = end;
+			}
+		}
+
+		size_t GetWedgeCount(unsigned int vertex) const
+		{
+			size_t wedges = 1;
+			for (unsigned int wedge = nextWedge[vertex]; wedge != vertex; wedge = nextWedge[wedge])
+				wedges++;
+			return wedges;
+		}
+
+		void AddEdgeQuadric(unsigned int a, unsigned int b, unsigned int c)
+		{
+			// Plane through the edge ab, perpendicular to the triangle abc
+			const Vector3& pa = vertices[a].position;
+			const Vector3& pb = vertices[b].position;
+			const Vector3 edge = pb - pa;
+			const Vector3 normal = TriangleNormal(pa, pb, vertices[c].position);
+
+			Vector3 planeNormal = Vector3::CrossProduct(edge, normal);
+			const float length = planeNormal.Magnitude();
+			if (length <= 0.f)
+				return;
+
+			planeNormal = planeNormal / length;
+			const double d = -Vector3::DotProduct(planeNormal, pa);
+			const double weight = EdgeQuadricWeight * Vector3::DotProduct(edge, edge);
+
+			quadrics[positionIds[a]].AddPlane(planeNormal.x, planeNormal.y, planeNormal.z, d, weight);
+			quadrics[positionIds[b]].AddPlane(planeNormal.x, planeNormal.y, planeNormal.z, d, weight);
+		}
+
+		void Classify(std::span<const int> indices)
+		{
+			const size_t count = vertices.size();
+			const size_t triangleCount = indices.size() / 3;
+
+			std::vector<EdgeRecord> edges;
+			edges.reserve(indices.size());
+			for (size_t triangle = 0; triangle < triangleCount; ++triangle)
+			{
+				for (size_t corner = 0; corner < 3; ++corner)
+				{
+					const unsigned int a = indices[triangle * 3 + corner];
+					const unsigned int b = indices[triangle * 3 + (corner + 1) % 3];
+					const unsigned int pa = positionIds[a], pb = positionIds[b];
+
+					edges.push_back({ std::min(pa, pb), std::max(pa, pb), std::min(a, b), std::max(a, b), static_cast<unsigned int>(triangle) });
+				}
+			}
+
+			std::sort(edges.begin(), edges.end(), [](const EdgeRecord& l, const EdgeRecord& r) {
+				if (l.positionA != r.positionA) return l.positionA < r.positionA;
+				if (l.positionB != r.positionB) return l.positionB < r.positionB;
+				if (l.vertexA != r.vertexA) return l.vertexA < r.vertexA;
+				if (l.vertexB != r.vertexB) return l.vertexB < r.vertexB;
+				return l.triangle < r.triangle;
+			});
+
+			std::vector<uint32_t> borderEdges(count, 0);
+			std::vector<uint32_t> seamEdges(count, 0);
+			std::vector<bool> nonManifold(count, false);
+
+			auto thirdVertex = [&](const EdgeRecord& edge) {
+				for (size_t corner = 0; corner < 3; ++corner)
+				{
+					const unsigned int vertex = indices[edge.triangle * 3 + corner];
+					if (vertex != edge.vertexA && vertex != edge.vertexB)
+						return vertex;
+				}
+				return edge.vertexA;
+			};
+
+			for (size_t i = 0; i < edges.size();)
+			{
+				size_t end = i + 1;
+				while (end < edges.size() && edges[end].positionA == edges[i].positionA && edges[end].positionB == edges[i].positionB)
+					end++;
+
+				const EdgeRecord& edge = edges[i];
+				const size_t triangles = end - i;
+
+				if (triangles == 1)
+				{
+					borderEdges[edge.positionA]++;
+					borderEdges[edge.positionB]++;
+					AddEdgeQuadric(edge.vertexA, edge.vertexB, thirdVertex(edge));
+				}
+				else if (triangles == 2)
+				{
+					// Both triangles use other vertices for the same positions
+					if (edges[i].vertexA != edges[i + 1].vertexA || edges[i].vertexB != edges[i + 1].vertexB)
+					{
+						seamEdges[edge.positionA]++;
+						seamEdges[edge.positionB]++;
+						AddEdgeQuadric(edges[i].vertexA, edges[i].vertexB, thirdVertex(edges[i]));
+						AddEdgeQuadric(edges[i + 1].vertexA, edges[i + 1].vertexB, thirdVertex(edges[i + 1]));
+					}
+				}
+				else
+				{
+					nonManifold[edge.positionA] = true;
+					nonManifold[edge.positionB] = true;
+				}
+
+				i = end;
+			}
+
+			kinds.resize(count);
+			for (size_t vertex = 0; vertex < count; ++vertex)
+			{
+				const unsigned int position = positionIds[vertex];
+				const size_t wedges = GetWedgeCount(static_cast<unsigned int>(vertex));
+				const uint32_t border = borderEdges[position];
+				const uint32_t seam = seamEdges[position];
+
+				VertexKind kind = VertexKind::LOCKED;
+				if (nonManifold[position])
+					kind = VertexKind::LOCKED;
+				else if (wedges == 1 && border == 0 && seam == 0)
+					kind = VertexKind::MANIFOLD;
+				else if (wedges == 1 && border == 2 && seam == 0)
+					kind = VertexKind::BORDER;
+				else if (wedges == 2 && border == 0 && seam == 2)
+					kind = VertexKind::SEAM;
+
+				kinds[vertex] = kind;
+			}
+		}
+
+		void BuildQuadrics(std::span<const int> indices)
+		{
+			quadrics.assign(vertices.size(), Quadric());
+
+			for (size_t i = 0; i < indices.size(); i += 3)
+			{
+				const Vector3& a = vertices[indices[i + 0]].position;
+				const Vector3& b = vertices[indices[i + 1]].position;
+				const Vector3& c = vertices[indices[i + 2]].position;
+
+				Vector3 normal = TriangleNormal(a, b, c);
+				const float length = normal.Magnitude();
+				if (length <= 0.f)
+					continue;
+
+				normal = normal / length;
+				const double d = -Vector3::DotProduct(normal, a);
+				const double area = length * 0.5;
+
+				for (size_t corner = 0; corner < 3; ++corner)
+					quadrics[positionIds[indices[i + corner]]].AddPlane(normal.x, normal.y, normal.z, d, area);
+			}
+		}
+	};
+
+	/**
+	@brief Triangles around each vertex of the current triangle list
+	*/
+	struct Adjacency
+	{
+		std::vector<unsigned int> offsets;
+		std::vector<unsigned int> triangles;
+
+		void Build(const std::vector<int>& indices, size_t vertexCount)
+		{
+			offsets.assign(vertexCount + 1, 0);
+			for (int index : indices)
+				offsets[index + 1]++;
+
+			for (size_t vertex = 0; vertex < vertexCount; ++vertex)
+				offsets[vertex + 1] += offsets[vertex];
+
+			triangles.resize(indices.size());
+			std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+			for (size_t i = 0; i < indices.size(); ++i)
+				triangles[fill[indices[i]]++] = static_cast<unsigned int>(i / 3);
+		}
+
+		std::span<const unsigned int> Get(unsigned int vertex) const
+		{
+			return std::span<const unsigned int>(triangles.data() + offsets[vertex], offsets[vertex + 1] - offsets[vertex]);
+		}
+	};
+
+	class Simplifier
+	{
+	public:
+		Simplifier(SimplifierMesh& mesh, std::vector<int>& indices)
+			: m_mesh(mesh), m_indices(indices)
+		{}
+
+		/**
+		@brief Vertex of the triangles of from at the position of to, -1 if they use several vertices there
+		*/
+		int64_t FindWedgeAt(unsigned int from, unsigned int position, size_t& triangleCount) const
+		{
+			int64_t found = -1;
+			triangleCount = 0;
+
+			for (unsigned int triangle : m_adjacency.Get(from))
+			{
+				for (size_t corner = 0; corner < 3; ++corner)
+				{
+					const unsigned int vertex = m_indices[triangle * 3 + corner];
+					if (m_mesh.positionIds[vertex] != position)
+						continue;
+
+					if (found >= 0 && found != vertex)
+						return -1;
+
+					found = vertex;
+					triangleCount++;
+				}
+			}
+
+			return found;
+		}
+
+		/**
+		@brief Check if from can collapse onto to, and get the other wedge collapse of a seam
+
+		@return bool : false if the collapse breaks a border, a seam or the attributes of the triangles around from
+		*/
+		bool IsCollapseValid(unsigned int from, unsigned int to, int64_t& seamFrom, int64_t& seamTo) const
+		{
+			seamFrom = seamTo = -1;
+
+			const VertexKind kind = m_mesh.kinds[from];
+			if (kind == VertexKind::LOCKED)
+				return false;
+
+			const unsigned int toPosition = m_mesh.positionIds[to];
+
+			size_t sharedTriangles = 0;
+			if (FindWedgeAt(from, toPosition, sharedTriangles) != to)
+				return false;
+
+			const VertexKind toKind = m_mesh.kinds[to];
+
+			if (kind == VertexKind::BORDER)
+				return sharedTriangles == 1 && (toKind == VertexKind::BORDER || toKind == VertexKind::LOCKED);
+
+			if (kind == VertexKind::SEAM)
+			{
+				if (sharedTriangles != 1 || (toKind != VertexKind::SEAM && toKind != VertexKind::LOCKED))
+					return false;
+
+				// The other side of the seam collapses along the same edge
+				const unsigned int otherFrom = m_mesh.nextWedge[from];
+				size_t otherShared = 0;
+				const int64_t otherTo = FindWedgeAt(otherFrom, toPosition, otherShared);
+				if (otherTo < 0 || otherShared != 1)
+					return false;
+
+				seamFrom = otherFrom;
+				seamTo = otherTo;
+			}
+
+			return true;
+		}
+
+		/**
+		@brief Check that no triangle around from turns over once from is at the position of to
+		*/
+		bool FlipsTriangles(unsigned int from, unsigned int to) const
+		{
+			const unsigned int toPosition = m_mesh.positionIds[to];
+			const Vector3& target = m_mesh.vertices[to].position;
+
+			for (unsigned int triangle : m_adjacency.Get(from))
+			{
+				Vector3 corners[3];
+				bool collapsed = false;
+				for (size_t corner = 0; corner < 3; ++corner)
+				{
+					const unsigned int vertex = m_indices[triangle * 3 + corner];
+					collapsed |= m_mesh.positionIds[vertex] == toPosition;
+					corners[corner] = m_mesh.vertices[vertex].position;
+				}
+
+				// Triangles along the edge are removed
+				if (collapsed)
+					continue;
+
+				const Vector3 before = TriangleNormal(corners[0], corners[1], corners[2]);
+				for (size_t corner = 0; corner < 3; ++corner)
+				{
+					if (m_indices[triangle * 3 + corner] == static_cast<int>(from))
+						corners[corner] = target;
+				}
+				const Vector3 after = TriangleNormal(corners[0], corners[1], corners[2]);
+
+				if (Vector3::DotProduct(before, after) <= 0.f)
+					return true;
+			}
+
+			return false;
+		}
+
+		double GetCollapseError(unsigned int from, unsigned int to) const
+		{
+			Quadric quadric = m_mesh.quadrics[m_mesh.positionIds[from]];
+			quadric.Add(m_mesh.quadrics[m_mesh.positionIds[to]]);
+			return quadric.Evaluate(m_mesh.vertices[to].position);
+		}
+
+		void GatherCollapses(std::vector<Collapse>& collapses) const
+		{
+			collapses.clear();
+
+			std::vector<std::pair<unsigned int, unsigned int>> edges;
+			edges.reserve(m_indices.size());
+			for (size_t i = 0; i < m_indices.size(); i += 3)
+			{
+				for (size_t corner = 0; corner < 3; ++corner)
+				{
+					const unsigned int a = m_indices[i + corner];
+					const unsigned int b = m_indices[i + (corner + 1) % 3];
+					edges.emplace_back(std::min(a, b), std::max(a, b));
+				}
+			}
+			std::sort(edges.begin(), edges.end());
+			edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+			for (const auto& [a, b] : edges)
+			{
+				int64_t seamFrom, seamTo;
+				const bool ab = IsCollapseValid(a, b, seamFrom, seamTo);
+				const bool ba = IsCollapseValid(b, a, seamFrom, seamTo);
+				if (!ab && !ba)
+					continue;
+
+				const double errorAB = ab ? GetCollapseError(a, b) : 0.0;
+				const double errorBA = ba ? GetCollapseError(b, a) : 0.0;
+
+				if (ab && (!ba || errorAB <= errorBA))
+					collapses.push_back({ a, b, errorAB });
+				else
+					collapses.push_back({ b, a, errorBA });
+			}
+
+			std::sort(collapses.begin(), collapses.end(), [](const Collapse& l, const Collapse& r) {
+				if (l.error != r.error) return l.error < r.error;
+				if (l.from != r.from) return l.from < r.from;
+				return l.to < r.to;
+			});
+		}
+
+		/**
+		@brief Collapse the cheapest independent edges once
+
+		@param relaxed : Allow every collapse under maxError, not only the ones close to the cheapest
+		@return size_t : Number of collapses
+		*/
+		size_t RunPass(size_t targetIndexCount, double maxError, bool relaxed, double& resultError)
+		{
+			const size_t vertexCount = m_mesh.vertices.size();
+			m_adjacency.Build(m_indices, vertexCount);
+
+			std::vector<Collapse> collapses;
+			GatherCollapses(collapses);
+			if (collapses.empty())
+				return 0;
+
+			// Each collapse removes about two triangles, half of the cheapest edges are enough
+			const size_t triangleCount = m_indices.size() / 3;
+			const size_t targetTriangles = targetIndexCount / 3;
+			const size_t goal = std::min(collapses.size() - 1, (triangleCount - targetTriangles) / 2);
+			const double passError = relaxed ? maxError : std::min(maxError, collapses[goal].error * 1.5);
+
+			std::vector<unsigned int> remap(vertexCount);
+			for (size_t i = 0; i < vertexCount; ++i)
+				remap[i] = static_cast<unsigned int>(i);
+
+			std::vector<bool> touched(vertexCount, false);
+			size_t removedTriangles = 0;
+			size_t collapseCount = 0;
+
+			auto touch = [&](unsigned int vertex) {
+				for (unsigned int triangle : m_adjacency.Get(vertex))
+				{
+					for (size_t corner = 0; corner < 3; ++corner)
+						touched[m_mesh.positionIds[m_indices[triangle * 3 + corner]]] = true;
+				}
+			};
+
+			for (const Collapse& collapse : collapses)
+			{
+				if (collapse.error > passError || triangleCount - removedTriangles <= targetTriangles)
+					break;
+
+				const unsigned int fromPosition = m_mesh.positionIds[collapse.from];
+				const unsigned int toPosition = m_mesh.positionIds[collapse.to];
+				if (touched[fromPosition] || touched[toPosition])
+					continue;
+
+				int64_t seamFrom, seamTo;
+				if (!IsCollapseValid(collapse.from, collapse.to, seamFrom, seamTo))
+					continue;
+
+				if (FlipsTriangles(collapse.from, collapse.to))
+					continue;
+				if (seamFrom >= 0 && FlipsTriangles(static_cast<unsigned int>(seamFrom), static_cast<unsigned int>(seamTo)))
+					continue;
+
+				size_t shared = 0;
+				FindWedgeAt(collapse.from, toPosition, shared);
+				removedTriangles += shared;
+				remap[collapse.from] = collapse.to;
+				touch(collapse.from);
+
+				if (seamFrom >= 0)
+				{
+					FindWedgeAt(static_cast<unsigned int>(seamFrom), toPosition, shared);
+					removedTriangles += shared;
+					remap[seamFrom] = static_cast<unsigned int>(seamTo);
+					touch(static_cast<unsigned int>(seamFrom));
+				}
+
+				m_mesh.quadrics[toPosition].Add(m_mesh.quadrics[fromPosition]);
+				resultError = std::max(resultError, collapse.error);
+				collapseCount++;
+			}
+
+			// Remove the triangles that lost an edge
+			size_t write = 0;
+			for (size_t i = 0; i < m_indices.size(); i += 3)
+			{
+				const unsigned int a = remap[m_indices[i + 0]];
+				const unsigned int b = remap[m_indices[i + 1]];
+				const unsigned int c = remap[m_indices[i + 2]];
+
+				const unsigned int pa = m_mesh.positionIds[a], pb = m_mesh.positionIds[b], pc = m_mesh.positionIds[c];
+				if (pa == pb || pb == pc || pa == pc)
+					continue;
+
+				m_indices[write++] = static_cast<int>(a);
+				m_indices[write++] = static_cast<int>(b);
+				m_indices[write++] = static_cast<int>(c);
+			}
+			m_indices.resize(write);
+
+			return collapseCount;
+		}
+
+	private:
+		SimplifierMesh& m_mesh;
+		std::vector<int>& m_indices;
+		Adjacency m_adjacency;
+	};
+}
+
+float MeshSimplifier::GetScale(std::span<const Vertex> vertices)
+{
+	if (vertices.empty())
+		return 0.f;
+
+	Vector3 min = vertices[0].position, max = vertices[0].position;
+	for (const Vertex& vertex : vertices)
+	{
+		min = Vector3(std::min(min.x, vertex.position.x), std::min(min.y, vertex.position.y), std::min(min.z, vertex.position.z));
+		max = Vector3(std::max(max.x, vertex.position.x), std::max(max.y, vertex.position.y), std::max(max.z, vertex.position.z));
+	}
+
+	return (max - min).Magnitude() * 0.5f;
+}
+
+float MeshSimplifier::Simplify(std::span<const int> indices, std::span<const Vertex> vertices, size_t targetIndexCount, float maxError,
+	std::vector<int>& output)
+{
+	output.clear();
+
+	const bool valid = indices.size() % 3 == 0 && std::all_of(indices.begin(), indices.end(), [&vertices](int index) {
+		return index >= 0 && static_cast<size_t>(index) < vertices.size();
+	});
+	if (!valid)
+	{
+		output.assign(indices.begin(), indices.end());
+		return 0.f;
+	}
+
+	SimplifierMesh mesh;
+	mesh.vertices = vertices;
+	mesh.BuildPositions();
+
+	// Triangles without area at the input have no edge to collapse
+	output.reserve(indices.size());
+	for (size_t i = 0; i < indices.size(); i += 3)
+	{
+		const unsigned int pa = mesh.positionIds[indices[i]], pb = mesh.positionIds[indices[i + 1]], pc = mesh.positionIds[indices[i + 2]];
+		if (pa != pb && pb != pc && pa != pc)
+			output.insert(output.end(), { indices[i], indices[i + 1], indices[i + 2] });
+	}
+
+	mesh.BuildQuadrics(output);
+	mesh.Classify(output);
+
+	const float scale = GetScale(vertices);
+	const double absoluteError = static_cast<double>(maxError) * scale;
+	const double maxSquaredError = absoluteError * absoluteError;
+
+	Simplifier simplifier(mesh, output);
+	double resultError = 0.0;
+
+	for (size_t pass = 0; pass < MaxPassCount && output.size() > targetIndexCount; ++pass)
+	{
+		// The cheapest edges may all flip triangles, the pass is tried again with every edge under the error limit
+		if (simplifier.RunPass(targetIndexCount, maxSquaredError, false, resultError) == 0
+			&& simplifier.RunPass(targetIndexCount, maxSquaredError, true, resultError) == 0)
+			break;
+	}
+
+	return scale > 0.f ? static_cast<float>(std::sqrt(resultError)) / scale : 0.f;
+}
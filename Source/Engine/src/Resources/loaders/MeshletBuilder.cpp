@@ -0,0 +1,227 @@
+#include "Resources/Loaders/MeshletBuilder.hpp"
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include "Resources/Loaders/MeshOptimizer.hpp"
+
+namespace
+{
+	constexpr unsigned int NoMeshlet = ~0u;
+
+	Vector3 GetTriangleCenter(std::span<const int> indices, std::span<const Vertex> vertices, size_t triangle)
+	{
+		return (vertices[indices[triangle * 3 + 0]].position
+			+ vertices[indices[triangle * 3 + 1]].position
+			+ vertices[indices[triangle * 3 + 2]].position) / 3.f;
+	}
+}
+
+void MeshletBuilder::Build(std::vector<int>& indices, std::span<const Vertex> vertices, std::vector<Meshlet>& meshlets,
+	unsigned int maxVertices, unsigned int maxTriangles)
+{
+	meshlets.clear();
+
+	const size_t vertexCount = vertices.size();
+	const bool validIndices = std::all_of(indices.begin(), indices.end(), [vertexCount](int index) {
+		return index >= 0 && static_cast<size_t>(index) < vertexCount;
+	});
+	if (indices.empty() || indices.size() % 3 != 0 || !validIndices || maxVertices < 3 || maxTriangles < 1)
+		return;
+
+	const size_t triangleCount = indices.size() / 3;
+
+	// Triangles around each vertex
+	std::vector<size_t> adjacencyOffsets(vertexCount + 1, 0);
+	for (int index : indices)
+		adjacencyOffsets[index + 1]++;
+	for (size_t vertex = 0; vertex < vertexCount; ++vertex)
+		adjacencyOffsets[vertex + 1] += adjacencyOffsets[vertex];
+
+	std::vector<unsigned int> adjacency(indices.size());
+	{
+		std::vector<size_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+		for (size_t i = 0; i < indices.size(); ++i)
+			adjacency[fill[indices[i]]++] = static_cast<unsigned int>(i / 3);
+	}
+
+	std::vector<bool> emitted(triangleCount, false);
+	std::vector<unsigned int> vertexMeshlet(vertexCount, NoMeshlet);		// Last meshlet using each vertex
+	std::vector<unsigned int> candidateMeshlet(triangleCount, NoMeshlet);	// Last meshlet each triangle was a candidate of
+	std::vector<int> localIndex(vertexCount, 0);
+
+	std::vector<unsigned int> meshletVertices;
+	std::vector<unsigned int> meshletTriangles;
+	std::vector<unsigned int> candidates;
+	std::vector<int> localIndices;
+
+	std::vector<int> output;
+	output.reserve(indices.size());
+
+	size_t cursor = 0;
+	while (true)
+	{
+		// Seed with the next triangle left in input order, the input is already ordered for the vertex cache so it is close to the last meshlet
+		while (cursor < triangleCount && emitted[cursor])
+			cursor++;
+		if (cursor == triangleCount)
+			break;
+
+		const unsigned int id = static_cast<unsigned int>(meshlets.size());
+		meshletVertices.clear();
+		meshletTriangles.clear();
+		candidates.clear();
+
+		Vector3 centerSum(0.f, 0.f, 0.f);
+
+		auto addTriangle = [&](unsigned int triangle) {
+			emitted[triangle] = true;
+			meshletTriangles.push_back(triangle);
+			centerSum = centerSum + GetTriangleCenter(indices, vertices, triangle);
+
+			for (size_t corner = 0; corner < 3; ++corner)
+			{
+				const int vertex = indices[triangle * 3 + corner];
+				if (vertexMeshlet[vertex] == id)
+					continue;
+
+				vertexMeshlet[vertex] = id;
+				meshletVertices.push_back(static_cast<unsigned int>(vertex));
+
+				for (size_t i = adjacencyOffsets[vertex]; i < adjacencyOffsets[vertex + 1]; ++i)
+				{
+					const unsigned int neighbour = adjacency[i];
+					if (!emitted[neighbour] && candidateMeshlet[neighbour] != id)
+					{
+						candidateMeshlet[neighbour] = id;
+						candidates.push_back(neighbour);
+					}
+				}
+			}
+		};
+
+		addTriangle(static_cast<unsigned int>(cursor));
+
+		// Grow with the neighbour adding the fewest vertices, then the closest to the center of the meshlet
+		while (meshletTriangles.size() < maxTriangles)
+		{
+			const Vector3 center = centerSum / static_cast<float>(meshletTriangles.size());
+
+			int64_t best = -1;
+			unsigned int bestExtra = 4;
+			float bestDistance = std::numeric_limits<float>::max();
+
+			size_t kept = 0;
+			for (unsigned int triangle : candidates)
+			{
+				if (emitted[triangle])
+					continue;
+				candidates[kept++] = triangle;
+
+				unsigned int extra = 0;
+				for (size_t corner = 0; corner < 3; ++corner)
+					extra += vertexMeshlet[indices[triangle * 3 + corner]] == id ? 0 : 1;
+
+				if (meshletVertices.size() + extra > maxVertices)
+					continue;
+
+				const float distance = (GetTriangleCenter(indices, vertices, triangle) - center).SquaredMagnitude();
+				if (extra < bestExtra || (extra == bestExtra && distance < bestDistance))
+				{
+					best = triangle;
+					bestExtra = extra;
+					bestDistance = distance;
+				}
+			}
+			candidates.resize(kept);
+
+			if (best < 0)
+				break;
+
+			addTriangle(static_cast<unsigned int>(best));
+		}
+
+		// Order the triangles of the meshlet for the vertex cache, on its own vertices
+		for (size_t i = 0; i < meshletVertices.size(); ++i)
+			localIndex[meshletVertices[i]] = static_cast<int>(i);
+
+		localIndices.clear();
+		for (unsigned int triangle : meshletTriangles)
+		{
+			for (size_t corner = 0; corner < 3; ++corner)
+				localIndices.push_back(localIndex[indices[triangle * 3 + corner]]);
+		}
+		MeshOptimizer::OptimizeVertexCache(localIndices, meshletVertices.size());
+
+		Meshlet meshlet;
+		meshlet.indexOffset = static_cast<uint32_t>(output.size());
+		meshlet.indexCount = static_cast<uint32_t>(localIndices.size());
+		for (int index : localIndices)
+			output.push_back(static_cast<int>(meshletVertices[index]));
+
+		ComputeBounds(std::span<const int>(output).subspan(meshlet.indexOffset, meshlet.indexCount), vertices, meshlet);
+		meshlets.push_back(meshlet);
+	}
+
+	indices.swap(output);
+}
+
+void MeshletBuilder::ComputeBounds(std::span<const int> indices, std::span<const Vertex> vertices, Meshlet& meshlet)
+{
+	if (indices.empty())
+		return;
+
+	// Sphere around the box of the vertices
+	Vector3 min = vertices[indices[0]].position;
+	Vector3 max = min;
+	for (int index : indices)
+	{
+		const Vector3& position = vertices[index].position;
+		min = Vector3(std::min(min.x, position.x), std::min(min.y, position.y), std::min(min.z, position.z));
+		max = Vector3(std::max(max.x, position.x), std::max(max.y, position.y), std::max(max.z, position.z));
+	}
+
+	meshlet.center = (min + max) * 0.5f;
+
+	float squaredRadius = 0.f;
+	for (int index : indices)
+		squaredRadius = std::max(squaredRadius, (vertices[index].position - meshlet.center).SquaredMagnitude());
+	meshlet.radius = std::sqrt(squaredRadius);
+
+	// Cone of the normals of the triangles, degenerate triangles face nowhere
+	std::vector<Vector3> normals;
+	normals.reserve(indices.size() / 3);
+
+	Vector3 axis(0.f, 0.f, 0.f);
+	for (size_t triangle = 0; triangle < indices.size() / 3; ++triangle)
+	{
+		const Vector3& a = vertices[indices[triangle * 3 + 0]].position;
+		const Vector3& b = vertices[indices[triangle * 3 + 1]].position;
+		const Vector3& c = vertices[indices[triangle * 3 + 2]].position;
+
+		const Vector3 normal = Vector3::CrossProduct(b - a, c - a);
+		const float length = normal.Magnitude();
+		if (length <= 0.f)
+			continue;
+
+		normals.push_back(normal / length);
+		axis = axis + normals.back();
+	}
+
+	meshlet.coneAxis = axis.SafeNormalized();
+	meshlet.coneCutoff = 1.f;
+
+	if (normals.empty() || axis.Magnitude() <= 0.f)
+		return;
+
+	float minDot = 1.f;
+	for (const Vector3& normal : normals)
+		minDot = std::min(minDot, Vector3::DotProduct(normal, meshlet.coneAxis));
+
+	// Normals spread over a half space or more, some triangle faces every viewer
+	if (minDot <= 0.f)
+		return;
+
+	meshlet.coneCutoff = std::sqrt(1.f - minDot * minDot);
+}
@@ -3,6 +3,8 @@
 #include <iostream>
 #include <stdio.h>
 #include <fstream>
+#include <chrono>
+#include <array>
 
 #include <assimp/postprocess.h>
 #include <glad/gl.h>
@@ -10,7 +12,10 @@
 #include "EngineContext.hpp"
 
 #include "Resources/ResourcesManager.hpp"
+#include "Resources/AssetDatabase.hpp"
+#include "Resources/SourceAssetTracker.hpp"
 #include "Resources/Parsers/AssimpParser.hpp"
+#include "Resources/Loaders/TextureCache.hpp"
 
 #include "Tools/SerializationUtils.hpp"
 #include "Tools/StringHelper.hpp"
@@ -18,6 +23,7 @@
 #include "Tools/RFKUtils.hpp"
 
 #include "ECS/GameObject.hpp"
+#include "ECS/Systems/MeshSystem.hpp"
 
 #include "Physics/PhysicsSimulation.hpp"
 
@@ -27,6 +33,118 @@ inline std::string GetFileString(const std::string& filepath)
 	return std::string((std::istreambuf_iterator<char>(ifs)), (std::istreambuf_iterator<char>()));
 }
 
+namespace
+{
+	// Number of resources created by one task
+	constexpr size_t ResourceChunkSize = 32;
+
+	// Number of resources deserialized by one task
+	constexpr size_t DeserializeChunkSize = 4;
+
+	constexpr size_t LoadingStageCount = 4;
+
+	/**
+	@brief Get the loading stage of a resource type, resources only reference resources of previous stages
+	(textures, then materials, then meshes, then models, prefabs and the others)
+	*/
+	size_t GetLoadingStage(RESOURCE_TYPE type)
+	{
+		switch (type)
+		{
+		case RESOURCE_TYPE::TEXTURE:
+		case RESOURCE_TYPE::SOUND:
+			return 0;
+		case RESOURCE_TYPE::MATERIAL:
+		case RESOURCE_TYPE::SKYBOX:
+			return 1;
+		case RESOURCE_TYPE::MESH:
+		case RESOURCE_TYPE::SKELETALMESH:
+			return 2;
+		default:
+			return 3;
+		}
+	}
+
+	/**
+	@brief Measure and log the duration of the successive stages of a loading
+	*/
+	class StageTimer
+	{
+		using Clock = std::chrono::steady_clock;
+
+	private:
+		Clock::time_point m_start = Clock::now();
+		Clock::time_point m_stageStart = m_start;
+
+	public:
+		void Log(const std::string& stageName, size_t count = 0, const std::string& countName = "")
+		{
+			Clock::time_point now = Clock::now();
+			long long milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(now - m_stageStart).count();
+			m_stageStart = now;
+
+			std::string countInfo = countName.empty() ? "" : " (" + std::to_string(count) + " " + countName + ")";
+			Logger::Info("=> " + stageName + " : " + std::to_string(milliseconds) + " ms" + countInfo);
+		}
+
+		long long GetTotalMilliseconds() const
+		{
+			return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - m_start).count();
+		}
+	};
+
+	/**
+	@brief Create the resource of an asset record, ready to be deserialized
+
+	@return Resource* : Created resource, nullptr if its type is unknown or its resource already exists
+	*/
+	Resource* CreateResourceFromRecord(ResourcesManager* RM, const AssetRecord& record)
+	{
+		// Skip unknown types and resources already loaded with the same GUID
+		bool created = false;
+		Resource* resource = RM->GetOrCreateResource(record.typeName, record.uid, created);
+		if (!created || !resource->TrySetState(RESOURCE_STATE::LOADING))
+			return nullptr;
+
+		resource->SetFileInfo(record.path);
+		return resource;
+	}
+
+	/**
+	@brief Get the path of the resource imported from a source file, empty if the file is not a source asset
+	*/
+	std::string GetImportedResourcePath(const std::string& sourcePath)
+	{
+		const std::string path = StringHelper::GetFilePathWithoutExtension(sourcePath);
+
+		switch (ResourcesLoader::GetExtensionType(StringHelper::GetFileExtensionFromPath(sourcePath)))
+		{
+		case ExtensionType::MODEL:
+			return path + ".model";
+		case ExtensionType::TEXTURE:
+			return path + ".texture";
+		case ExtensionType::SOUND:
+			return path + ".sound";
+		default:
+			return "";
+		}
+	}
+
+	/**
+	@brief Get the import settings of source files from their resource, called by the workers
+	*/
+	SourceAssetTracker::SettingsGetter GetImportSettingsGetter(ResourcesManager* RM)
+	{
+		return [RM](const std::string& sourcePath) {
+			std::string settings;
+			if (Resource* resource = RM->GetResourceByPath(GetImportedResourcePath(sourcePath)))
+				resource->GetImportSettings(settings);
+
+			return settings;
+		};
+	}
+}
+
 void ResourcesLoader::LoadNotCachedRecurse(const std::filesystem::path& path, bool& foundResource)
 {
 	std::unordered_map<std::string, std::string> newPotentialObjects;
@@ -114,76 +232,219 @@ void ResourcesLoader::LoadNotCachedResources(std::string_view path)
 	taskPool.RunSingleTasks();
 }
 
-void ResourcesLoader::LoadResourcesInDirectory(std::string_view path)
+void ResourcesLoader::ApplySourceChanges(SourceAssetTracker& tracker, const std::vector<SourceAssetTracker::Change>& changes, std::vector<Resource*>& reimported)
 {
 	ResourcesManager* RM = EngineContext::Instance().resourcesManager;
+	ResourcesTaskPool& taskPool = RM->GetTaskPool();
 
-	std::vector<Resource*> newResources;
+	reimported.clear();
+	StageTimer timer;
 
-	Logger::Info("=> Loading Project Resources...");
-	Logger::Info("=> Directory : " + std::string(path.data()));
-	Logger::Info("=> Meta import");
+	std::vector<Resource*> modified;
+	size_t importedCount = 0;
 
-	uint32_t resourceCount = 0;
-	for (const auto& file : fs::recursive_directory_iterator(path))
+	for (const SourceAssetTracker::Change& change : changes)
 	{
-		if (fs::is_directory(file.path()))
-			continue;
+		Resource* resource = RM->GetResourceByPath(GetImportedResourcePath(change.path));
+
+		switch (change.type)
+		{
+		case SourceAssetTracker::EChange::ADDED:
+		case SourceAssetTracker::EChange::MODIFIED:
+			// Files found by the scan building the manifest are often already imported, their record is then only the reference of the next checks
+			if (resource == nullptr)
+			{
+				taskPool.AddMultiThreadTask([RM, path = change.path]() { RM->ImportNewResource(path); });
+				importedCount++;
+			}
+			else if (change.type == SourceAssetTracker::EChange::MODIFIED)
+			{
+				Logger::Info("=> Reimport " + resource->GetFilepath() + " (" + std::string(resource->GetUID()) + ")");
+				modified.emplace_back(resource);
+			}
+			break;
+
+		case SourceAssetTracker::EChange::REMOVED:
+			Logger::Info("=> Source file removed, its resource is kept : " + change.path);
+			break;
+		}
+	}
 
-		std::string extension = file.path().extension().string();
-		ExtensionType extType = ResourcesLoader::GetExtensionType(extension);
+	// Wait for loading tasks to be completed
+	taskPool.WaitingForMultiTasksCompletion();
 
-		// TODO : Check if a meta file with this name already exists, else load has a new entry resource
-		if (extType != ExtensionType::META)
-			continue;
+	// Run post multi tasks
+	taskPool.RunSingleTasks();
+	timer.Log("New resources import", importedCount, "resources");
 
-		// Load the file
-		std::ifstream i(file.path().string());
-		if (!i.is_open())
-			continue;
+	if (!modified.empty())
+	{
+		// Resources referencing each resource, to rebuild them once it is reimported
+		FlatHashMap<HYGUID, std::vector<Resource*>> dependents;
+		std::vector<HYGUID> dependencies;
+		for (Resource* resource : RM->GetResources())
+		{
+			dependencies.clear();
+			resource->GetDependencies(dependencies);
+			for (const HYGUID& uid : dependencies)
+				dependents[uid].emplace_back(resource);
+		}
 
-		// Parse the file
-		json j = json::parse(i);
-		i.close();
+		// Reimports use the GL context, they run on the main thread one after the other, each resource once
+		FlatHashMap<HYGUID, bool> queued;
+		for (Resource* resource : modified)
+			queued.emplace(resource->GetUID(), true);
 
-		// Should not happen
-		if (!j.contains("uid") || !j.contains("type"))
-			continue;
+		for (size_t i = 0; i < modified.size(); ++i)
+		{
+			Resource* resource = modified[i];
+			if (!resource->Reimport())
+				continue;
 
-		// Get resource internal information
-		std::string typeString = j["type"].get<std::string>();
-		std::string uid = j["uid"].get<std::string>();
+			// The sub meshes of a model are processed by the workers
+			taskPool.WaitingForMultiTasksCompletion();
+			taskPool.RunSingleTasks();
 
-		HYGUID guid = HYGUID(uid);
+			reimported.emplace_back(resource);
 
-		Resource* resource = RM->CreateResource(typeString, guid);
-		resource->SetFileInfo(StringHelper::GetFilePathWithoutExtension(file.path().string()));
+			auto it = dependents.find(resource->GetUID());
+			if (it == dependents.end())
+				continue;
 
-		newResources.emplace_back(resource);
-		resourceCount++;
+			for (Resource* dependent : it->second)
+			{
+				if (queued.emplace(dependent->GetUID(), true).second)
+					modified.emplace_back(dependent);
+			}
+		}
+		timer.Log("Reimport", reimported.size(), "resources");
 	}
 
-	if (resourceCount != 0)
+	tracker.Save();
+
+	if (!changes.empty())
+		Logger::Info("=> Source assets up to date (" + std::to_string(timer.GetTotalMilliseconds()) + " ms)");
+}
+
+void ResourcesLoader::ReimportChangedResources(SourceAssetTracker& tracker, std::vector<Resource*>& reimported)
+{
+	ResourcesManager* RM = EngineContext::Instance().resourcesManager;
+	StageTimer timer;
+
+	// Source files keeping their size and write time are not read, only the settings of their resource are hashed
+	std::vector<SourceAssetTracker::Change> changes;
+	tracker.Refresh(RM->GetTaskPool(), GetImportSettingsGetter(RM), changes);
+
+	const SourceAssetTracker::RefreshStats& stats = tracker.GetStats();
+	timer.Log(std::string("Source assets ") + (stats.manifestLoaded ? "check" : "scan"), stats.checkedFiles, "files, "
+		+ std::to_string(stats.hashedFiles) + " hashed, " + std::to_string(stats.scannedDirectories) + " directories scanned");
+
+	ApplySourceChanges(tracker, changes, reimported);
+}
+
+void ResourcesLoader::ReimportChangedFiles(SourceAssetTracker& tracker, const std::vector<std::string>& paths, std::vector<Resource*>& reimported)
+{
+	ResourcesManager* RM = EngineContext::Instance().resourcesManager;
+	StageTimer timer;
+
+	// Only the reported files are checked, the cost does not depend on the number of assets
+	std::vector<SourceAssetTracker::Change> changes;
+	tracker.RefreshFiles(RM->GetTaskPool(), GetImportSettingsGetter(RM), paths, changes);
+
+	const SourceAssetTracker::RefreshStats& stats = tracker.GetStats();
+	timer.Log("Source assets check", stats.checkedFiles, "files, " + std::to_string(stats.hashedFiles) + " hashed");
+
+	ApplySourceChanges(tracker, changes, reimported);
+}
+
+void ResourcesLoader::LoadResourcesInDirectory(std::string_view path)
+{
+	ResourcesManager* RM = EngineContext::Instance().resourcesManager;
+	ResourcesTaskPool& taskPool = RM->GetTaskPool();
+
+	Logger::Info("=> Loading Project Resources...");
+	Logger::Info("=> Directory : " + std::string(path.data()));
+	Logger::Info("=> Meta import");
+
+	StageTimer timer;
+
+	// Asset database : only directories changed since the last run are enumerated and only their new or modified meta files are parsed
+	AssetDatabase database(std::string(path), AssetDatabase::GetDefaultManifestPath(std::string(path)));
+	database.Refresh(taskPool);
+
+	const AssetDatabase::RefreshStats& stats = database.GetStats();
+	timer.Log(std::string("Asset database ") + (stats.manifestLoaded ? "refresh" : "build"), database.GetRecords().size(), "assets, "
+		+ std::to_string(stats.parsedRecords) + " meta files parsed, " + std::to_string(stats.scannedDirectories) + " directories scanned");
+
+	// Resource creation : resources are created by the workers, the registry being thread-safe
+	const std::vector<AssetRecord>& records = database.GetRecords();
+	std::vector<Resource*> newResources(records.size(), nullptr);
+	taskPool.ParallelFor(records.size(), ResourceChunkSize, [RM, &records, &newResources](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i)
+			newResources[i] = CreateResourceFromRecord(RM, records[i]);
+		});
+	std::erase(newResources, nullptr);
+	timer.Log("Resource creation", newResources.size(), "resources");
+
+	if (newResources.size() != 0)
 	{
-		Logger::Info("=> Found " + std::to_string(resourceCount) + " cached resources");
+		Logger::Info("=> Found " + std::to_string(newResources.size()) + " cached resources");
 		Logger::Info("=> Reloading from cache");
 
-		for (auto& resource : newResources)
-			resource->Deserialize(); // LOAD ALL FILES
+		// Sort by dependency stage, each stage only references resources of the previous ones
+		std::array<std::vector<Resource*>, LoadingStageCount> stages;
+		for (Resource* resource : newResources)
+			stages[GetLoadingStage(resource->GetType())].emplace_back(resource);
+
+		// Deserialization : disk reads and decoding are spread over the workers, one stage after the other
+		for (std::vector<Resource*>& stage : stages)
+		{
+			taskPool.ParallelFor(stage.size(), DeserializeChunkSize, [&stage](size_t begin, size_t end) {
+				for (size_t i = begin; i < end; ++i)
+				{
+					stage[i]->Deserialize(); // LOAD ALL FILES
+					stage[i]->StageGPUData();
+					stage[i]->TrySetState(RESOURCE_STATE::CPU_READY);
+				}
+				});
+		}
+		timer.Log("Deserialization", newResources.size(), "resources");
+
+		// Keep the references between resources in the database
+		std::vector<HYGUID> dependencies;
+		for (Resource* resource : newResources)
+		{
+			dependencies.clear();
+			resource->GetDependencies(dependencies);
+			database.SetDependencies(resource->GetUID(), dependencies);
+		}
 
+		// GPU objects are created on the calling (main) thread which owns the GL context,
+		// staged data is copied by the upload queue and the resource is GPU ready once its copy is done
 		Logger::Info("=> Creating GPU memory");
-		for (auto& resource : newResources)
-			resource->LoadInGPUMemory();
+		for (std::vector<Resource*>& stage : stages)
+		{
+			for (Resource* resource : stage)
+			{
+				resource->LoadInGPUMemory();
+				if (!resource->IsGPUUploadPending())
+					resource->TrySetState(RESOURCE_STATE::GPU_READY);
+			}
+		}
+		timer.Log("GPU upload", newResources.size(), "resources");
 	}
 	else
 	{
 		Logger::Info("=> No cached resource found");
 	}
 
+	database.Save();
+
 	// Load all new resources
 	LoadNotCachedResources(path);
+	timer.Log("New resources import");
 
-	Logger::Info("=> Load resources folder success");
+	Logger::Info("=> Load resources folder success (" + std::to_string(timer.GetTotalMilliseconds()) + " ms)");
 }
 
 void ResourcesLoader::CreateResourceFiles(Resource* resource)
@@ -215,23 +476,26 @@ void ResourcesLoader::CreateResourceFiles(Resource* resource)
 
 void ResourcesLoader::DeleteResourceFiles(Resource* resource)
 {
-	// Try remove resource files
-	if (std::filesystem::exists(resource->GetFilepath()))
-		std::filesystem::remove(resource->GetFilepath());
+	// A file still mapped would only be removed once unmapped, and its path could not be used again until then
+	resource->ReleaseFiles();
 
-	std::filesystem::path metaPath = resource->GetFilepath() + ".meta";
-	if (std::filesystem::exists(metaPath))
-		std::filesystem::remove(metaPath);
+	// Try remove resource files, missing ones are not an error
+	for (const std::string& path : { resource->GetFilepath(), resource->GetFilepath() + ".meta" })
+	{
+		std::error_code error;
+		if (!std::filesystem::remove(path, error) && error)
+			Logger::Warning("Cannot delete " + path + " : " + error.message());
+	}
 }
 
-bool ResourcesLoader::LoadModel(Model& model)
+bool ResourcesLoader::LoadModel(Model& model, const AssimpParser::ReusedResources& reused)
 {
 	// TODO : We could improve that and provide some kind of ImportSettings
 	return AssimpParser::LoadModel(model, aiPostProcessSteps::aiProcess_Triangulate
 									| aiPostProcessSteps::aiProcess_GenSmoothNormals
 									| aiPostProcessSteps::aiProcess_CalcTangentSpace
 									| aiPostProcessSteps::aiProcess_JoinIdenticalVertices
-									| aiPostProcessSteps::aiProcess_GenBoundingBoxes);
+									| aiPostProcessSteps::aiProcess_GenBoundingBoxes, reused);
 								//| aiPostProcessSteps::aiProcess_FlipUVs // This is only used by DirectX
 								//| aiPostProcessSteps::aiProcess_GlobalScale // This is supposed to get fbx scale but most fbx don't use it
 								//| aiPostProcessSteps::aiProcess_ValidateDataStructure
@@ -244,7 +508,31 @@ bool ResourcesLoader::LoadTexture(Texture& texture)
 
 bool ResourcesLoader::LoadTextureUnsafe(Texture& texture)
 {
-	return AssimpParser::LoadTexture(texture, texture.GetLoadingFlags(), false);
+	const Flags<EImageSTB>& flags = texture.GetLoadingFlags();
+	const std::string cachePath = TextureCache::GetCachePath(texture.originalPath, flags);
+
+	TextureData cached;
+	if (TextureCache::Load(cachePath, texture.originalPath, flags, cached))
+	{
+		FreeTextureData(texture);
+		texture.data = std::move(cached);
+		return true;
+	}
+
+	if (!AssimpParser::LoadTexture(texture, flags, false))
+		return false;
+
+	// First load of this image with these flags, keep its decoded mip chain for the next ones.
+	// The decoded image is replaced by the cooked one, so this load and the next ones upload the same mips
+	TextureData cooked;
+	if (TextureCache::Cook(texture.data, flags, cooked))
+	{
+		FreeTextureData(texture);
+		texture.data = std::move(cooked);
+		TextureCache::Save(cachePath, texture.originalPath, flags, texture.data);
+	}
+
+	return true;
 }
 
 void ResourcesLoader::FreeTextureData(Texture& texture)
@@ -607,9 +895,13 @@ void ResourcesLoader::LoadGameEntity(json& jsonFile, RefContainer<SceneObject*>&
 GameObject* ResourcesLoader::LoadGameObjects(json& j, Scene& scene, bool shouldCreateNewId)
 {
 	RefContainer<SceneObject*> objRefs;
+	objRefs.reserve(j.size());
 
 	GameObject* root = nullptr;
 
+	// Send all created mesh instances to the render system in one batch
+	MeshSystem::RegistrationBatch registrationBatch(SystemManager::GetMeshSystem());
+
 	// Preload gameobjects and components
 	for (json::iterator internalIt = j.begin(); internalIt != j.end(); ++internalIt)
 	{
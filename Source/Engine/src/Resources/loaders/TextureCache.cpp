@@ -0,0 +1,497 @@
+#include "Resources/Loaders/TextureCache.hpp"
+
+#include <cmath>
+#include <array>
+#include <fstream>
+#include <cstring>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <filesystem>
+#include <glad/gl.h>
+
+#include "Core/Logger.hpp"
+
+#include "Resources/Resource/Texture.hpp"
+#include "Resources/Loaders/TextureCompressor.hpp"
+
+#include "Tools/MappedFile.hpp"
+#include "Tools/StringHelper.hpp"
+#include "Tools/PathConfig.hpp"
+
+namespace fs = std::filesystem;
+
+namespace
+{
+	constexpr char CacheMagic[4] = { 'H', 'Y', 'T', 'X' };
+	constexpr uint32_t CacheVersion = 2;
+
+	// Pixels start on a 16 bytes boundary in the cache file
+	constexpr uint64_t PixelsAlignment = 16;
+
+	// Half width of the Kaiser filter in destination texels and shape of its window
+	constexpr float KaiserRadius = 2.f;
+	constexpr float KaiserAlpha = 4.f;
+
+	constexpr float Pi = 3.14159265358979f;
+
+	/**
+	@brief Layout of a .texcache file : header, mip levels, then the pixels of every level.
+	The source size, write time and loading flags tell if the cache is still valid.
+	*/
+	struct CacheHeader
+	{
+		char		magic[4];
+		uint32_t	version;
+		uint64_t	flags;
+		uint64_t	sourceSize;
+		int64_t		sourceTime;
+		int32_t		width;
+		int32_t		height;
+		int32_t		channels;
+		int32_t		type;
+		int32_t		format;
+		int32_t		internalFormat;
+		uint32_t	levelCount;
+		uint32_t	compressed;
+		uint64_t	pixelsOffset;
+		uint64_t	pixelsSize;
+	};
+
+	struct CacheLevel
+	{
+		int32_t		width;
+		int32_t		height;
+		uint64_t	offset;
+		uint64_t	size;
+	};
+
+	/**
+	@brief Filter weights of a downsampling along one axis, tapCount source texels per destination texel
+	*/
+	struct FilterTaps
+	{
+		int tapCount = 0;
+		std::vector<int> indices;
+		std::vector<float> weights;
+	};
+
+	bool GetSourceInfo(const std::string& sourcePath, uint64_t& size, int64_t& time)
+	{
+		std::error_code error;
+		size = fs::file_size(sourcePath, error);
+		if (error)
+			return false;
+
+		time = static_cast<int64_t>(fs::last_write_time(sourcePath, error).time_since_epoch().count());
+		return !error;
+	}
+
+	// Modified Bessel function of the first kind, order 0
+	float BesselI0(float x)
+	{
+		float sum = 1.f;
+		float term = 1.f;
+		float halfX = x * 0.5f;
+
+		for (int k = 1; k < 32 && term > sum * 1e-8f; ++k)
+		{
+			term *= (halfX / k) * (halfX / k);
+			sum += term;
+		}
+
+		return sum;
+	}
+
+	float EvaluateFilter(TextureCache::MipFilter filter, float x)
+	{
+		x = std::abs(x);
+
+		if (filter == TextureCache::MipFilter::BOX)
+			return x < 0.5f ? 1.f : (x == 0.5f ? 0.5f : 0.f);
+
+		if (x >= KaiserRadius)
+			return 0.f;
+
+		float sinc = x < 1e-5f ? 1.f : std::sin(Pi * x) / (Pi * x);
+		float t = x / KaiserRadius;
+		return sinc * BesselI0(KaiserAlpha * std::sqrt(1.f - t * t)) / BesselI0(KaiserAlpha);
+	}
+
+	FilterTaps ComputeTaps(int sourceSize, int destinationSize, TextureCache::MipFilter filter, bool wrap)
+	{
+		const float scale = static_cast<float>(sourceSize) / destinationSize;
+		const float radius = filter == TextureCache::MipFilter::BOX ? 0.5f : KaiserRadius;
+		const float support = radius * scale;
+
+		FilterTaps taps;
+		taps.tapCount = static_cast<int>(std::ceil(2.f * support)) + 1;
+		taps.indices.resize(static_cast<size_t>(destinationSize) * taps.tapCount);
+		taps.weights.resize(taps.indices.size());
+
+		for (int x = 0; x < destinationSize; ++x)
+		{
+			const float center = (x + 0.5f) * scale;
+			const int first = static_cast<int>(std::floor(center - support));
+
+			int* indices = &taps.indices[static_cast<size_t>(x) * taps.tapCount];
+			float* weights = &taps.weights[static_cast<size_t>(x) * taps.tapCount];
+
+			float sum = 0.f;
+			for (int t = 0; t < taps.tapCount; ++t)
+			{
+				int s = first + t;
+				weights[t] = EvaluateFilter(filter, (s + 0.5f - center) / scale);
+				indices[t] = wrap ? ((s % sourceSize) + sourceSize) % sourceSize : std::clamp(s, 0, sourceSize - 1);
+				sum += weights[t];
+			}
+
+			for (int t = 0; t < taps.tapCount; ++t)
+				weights[t] /= sum;
+		}
+
+		return taps;
+	}
+
+	float SRGBToLinear(float value)
+	{
+		return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+	}
+
+	float LinearToSRGB(float value)
+	{
+		return value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.f / 2.4f) - 0.055f;
+	}
+
+	bool IsAlphaChannel(int channel, int channels)
+	{
+		return (channels == 2 || channels == 4) && channel == channels - 1;
+	}
+}
+
+std::string TextureCache::GetCachePath(const std::string& sourcePath, const Flags<EImageSTB>& flags)
+{
+	std::string absoluteSource = fs::absolute(sourcePath).lexically_normal().string();
+
+	uint64_t hash = static_cast<uint64_t>(StringHelper::PathHash()(absoluteSource));
+	hash ^= static_cast<uint64_t>(flags.GetFlagAsInt()) * 0x9E3779B97F4A7C15ull;
+
+	std::stringstream name;
+	name << StringHelper::GetFileNameWithoutExtension(StringHelper::GetFileNameFromPath(sourcePath)) << "_"
+		<< std::hex << std::setw(16) << std::setfill('0') << hash << ".texcache";
+
+	return (fs::path(CACHE_ROOT) / "Textures" / name.str()).string();
+}
+
+bool TextureCache::Load(const std::string& cachePath, const std::string& sourcePath, const Flags<EImageSTB>& flags, TextureData& data)
+{
+	uint64_t sourceSize = 0;
+	int64_t sourceTime = 0;
+	if (!GetSourceInfo(sourcePath, sourceSize, sourceTime))
+		return false;
+
+	auto file = std::make_shared<MappedFile>();
+	if (!file->Open(cachePath))
+		return false;
+
+	const CacheHeader* header = file->View<CacheHeader>(0);
+	if (header == nullptr || std::memcmp(header->magic, CacheMagic, sizeof(CacheMagic)) != 0 || header->version != CacheVersion)
+		return false;
+
+	// Outdated cache, the source image or the loading flags changed
+	if (header->flags != static_cast<uint64_t>(flags.GetFlagAsInt()) || header->sourceSize != sourceSize || header->sourceTime != sourceTime)
+		return false;
+
+	const CacheLevel* levels = file->View<CacheLevel>(sizeof(CacheHeader), header->levelCount);
+	const unsigned char* pixels = file->View<unsigned char>(header->pixelsOffset, header->pixelsSize);
+	if (levels == nullptr || pixels == nullptr || header->levelCount == 0)
+		return false;
+
+	for (uint32_t i = 0; i < header->levelCount; ++i)
+	{
+		if (levels[i].offset > header->pixelsSize || levels[i].size > header->pixelsSize - levels[i].offset)
+			return false;
+	}
+
+	data.width = header->width;
+	data.height = header->height;
+	data.channels = header->channels;
+	data.type = header->type;
+	data.format = header->format;
+	data.internalFormat = header->internalFormat;
+	data.compressed = header->compressed != 0;
+
+	data.mipLevels.resize(header->levelCount);
+	for (uint32_t i = 0; i < header->levelCount; ++i)
+		data.mipLevels[i] = { levels[i].width, levels[i].height, static_cast<size_t>(levels[i].offset), static_cast<size_t>(levels[i].size) };
+
+	// The mapping is read-only, the pixels are uploaded straight from it
+	data.data = const_cast<unsigned char*>(pixels);
+	data.storage = std::move(file);
+
+	return true;
+}
+
+bool TextureCache::Cook(const TextureData& data, const Flags<EImageSTB>& flags, TextureData& cooked)
+{
+	if (data.data == nullptr || data.width <= 0 || data.height <= 0 || data.channels <= 0)
+		return false;
+
+	std::vector<TextureMipLevel> levels;
+	auto pixels = std::make_shared<std::vector<unsigned char>>();
+
+	if (flags.TestBit(EImageSTB::IMG_GEN_MIPMAPS))
+	{
+		// Ringing of the Kaiser filter would create fake slopes in 16 bits height maps
+		MipFilter filter = data.type == GL_UNSIGNED_SHORT ? MipFilter::BOX : MipFilter::KAISER;
+		BuildMipChain(data, filter, flags.TestBit(EImageSTB::IMG_SRGB), flags.TestBit(EImageSTB::IMG_WRAP_REPEAT), levels, *pixels);
+	}
+	else
+	{
+		size_t size = static_cast<size_t>(data.width) * data.height * data.channels * (data.type == GL_UNSIGNED_SHORT ? 2 : 1);
+		levels.push_back({ data.width, data.height, 0, size });
+		pixels->assign(data.data, data.data + size);
+	}
+
+	// Block compression of every level, the decoded levels are dropped
+	BlockFormat blockFormat = TextureCompressor::ChooseFormat(flags, data.channels, data.type == GL_UNSIGNED_SHORT);
+	if (blockFormat != BlockFormat::NONE)
+	{
+		std::vector<TextureMipLevel> compressedLevels = levels;
+		size_t compressedSize = 0;
+		for (TextureMipLevel& level : compressedLevels)
+		{
+			level.offset = compressedSize;
+			level.size = TextureCompressor::GetCompressedSize(blockFormat, level.width, level.height);
+			compressedSize += level.size;
+		}
+
+		auto compressedPixels = std::make_shared<std::vector<unsigned char>>(compressedSize);
+		for (size_t i = 0; i < levels.size(); ++i)
+		{
+			TextureCompressor::CompressImage(blockFormat, pixels->data() + levels[i].offset, levels[i].width, levels[i].height, data.channels,
+				compressedPixels->data() + compressedLevels[i].offset);
+		}
+
+		levels = std::move(compressedLevels);
+		pixels = std::move(compressedPixels);
+	}
+
+	cooked = data;
+	cooked.data = pixels->data();
+	cooked.mipLevels = std::move(levels);
+	cooked.storage = std::move(pixels);
+	if (blockFormat != BlockFormat::NONE)
+	{
+		cooked.compressed = true;
+		cooked.internalFormat = TextureCompressor::GetGLFormat(blockFormat);
+	}
+
+	return true;
+}
+
+bool TextureCache::Save(const std::string& cachePath, const std::string& sourcePath, const Flags<EImageSTB>& flags, const TextureData& cooked)
+{
+	if (cooked.data == nullptr || cooked.mipLevels.empty())
+		return false;
+
+	uint64_t sourceSize = 0;
+	int64_t sourceTime = 0;
+	if (!GetSourceInfo(sourcePath, sourceSize, sourceTime))
+		return false;
+
+	const TextureMipLevel& lastLevel = cooked.mipLevels.back();
+	const size_t pixelsSize = lastLevel.offset + lastLevel.size;
+
+	CacheHeader header;
+	std::memset(&header, 0, sizeof(CacheHeader));
+	std::memcpy(header.magic, CacheMagic, sizeof(CacheMagic));
+	header.version = CacheVersion;
+	header.flags = static_cast<uint64_t>(flags.GetFlagAsInt());
+	header.sourceSize = sourceSize;
+	header.sourceTime = sourceTime;
+	header.width = cooked.width;
+	header.height = cooked.height;
+	header.channels = cooked.channels;
+	header.type = cooked.type;
+	header.format = cooked.format;
+	header.internalFormat = cooked.internalFormat;
+	header.levelCount = static_cast<uint32_t>(cooked.mipLevels.size());
+	header.compressed = cooked.compressed ? 1 : 0;
+	header.pixelsSize = pixelsSize;
+
+	uint64_t levelsEnd = sizeof(CacheHeader) + cooked.mipLevels.size() * sizeof(CacheLevel);
+	header.pixelsOffset = (levelsEnd + PixelsAlignment - 1) & ~(PixelsAlignment - 1);
+
+	std::vector<CacheLevel> cacheLevels(cooked.mipLevels.size());
+	for (size_t i = 0; i < cooked.mipLevels.size(); ++i)
+	{
+		const TextureMipLevel& level = cooked.mipLevels[i];
+		cacheLevels[i] = { level.width, level.height, level.offset, level.size };
+	}
+
+	std::string temporaryPath = cachePath + ".tmp";
+
+	std::error_code error;
+	fs::create_directories(fs::path(cachePath).parent_path(), error);
+
+	{
+		std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+		if (!file.is_open())
+		{
+			Logger::Warning("TextureCache - Can't write cache of " + sourcePath);
+			return false;
+		}
+
+		const char padding[PixelsAlignment] = { 0 };
+		file.write(reinterpret_cast<const char*>(&header), sizeof(CacheHeader));
+		file.write(reinterpret_cast<const char*>(cacheLevels.data()), cacheLevels.size() * sizeof(CacheLevel));
+		file.write(padding, header.pixelsOffset - levelsEnd);
+		file.write(reinterpret_cast<const char*>(cooked.data), pixelsSize);
+
+		if (!file.good())
+		{
+			file.close();
+			fs::remove(temporaryPath, error);
+			Logger::Warning("TextureCache - Can't write cache of " + sourcePath);
+			return false;
+		}
+	}
+
+	fs::rename(temporaryPath, cachePath, error);
+	if (error)
+	{
+		fs::remove(temporaryPath, error);
+		Logger::Warning("TextureCache - Can't replace cache of " + sourcePath);
+		return false;
+	}
+
+	return true;
+}
+
+void TextureCache::BuildMipChain(const TextureData& data, MipFilter filter, bool isSRGB, bool wrap,
+	std::vector<TextureMipLevel>& levels, std::vector<unsigned char>& pixels)
+{
+	const int channels = data.channels;
+	const size_t channelSize = data.type == GL_UNSIGNED_SHORT ? 2 : 1;
+	const float maxValue = channelSize == 2 ? 65535.f : 255.f;
+
+	int width = data.width;
+	int height = data.height;
+
+	levels.clear();
+	levels.push_back({ width, height, 0, static_cast<size_t>(width) * height * channels * channelSize });
+	pixels.assign(data.data, data.data + levels[0].size);
+
+	// 8 bits sRGB values are decoded with a table
+	std::array<float, 256> decodeTable;
+	for (int i = 0; i < 256; ++i)
+		decodeTable[i] = isSRGB ? SRGBToLinear(i / 255.f) : i / 255.f;
+
+	// Levels are filtered one from the other in linear floating point
+	std::vector<float> source(static_cast<size_t>(width) * height * channels);
+	for (size_t i = 0; i < source.size(); ++i)
+	{
+		int channel = static_cast<int>(i % channels);
+		bool decode = isSRGB && !IsAlphaChannel(channel, channels);
+
+		if (channelSize == 2)
+		{
+			uint16_t value;
+			std::memcpy(&value, data.data + i * 2, sizeof(uint16_t));
+			source[i] = decode ? SRGBToLinear(value / maxValue) : value / maxValue;
+		}
+		else
+		{
+			source[i] = IsAlphaChannel(channel, channels) ? data.data[i] / maxValue : decodeTable[data.data[i]];
+		}
+	}
+
+	std::vector<float> horizontal;
+	std::vector<float> destination;
+
+	while (width > 1 || height > 1)
+	{
+		const int nextWidth = std::max(width / 2, 1);
+		const int nextHeight = std::max(height / 2, 1);
+
+		FilterTaps columnTaps = ComputeTaps(width, nextWidth, filter, wrap);
+		FilterTaps rowTaps = ComputeTaps(height, nextHeight, filter, wrap);
+
+		// Horizontal pass : width x height -> nextWidth x height
+		horizontal.assign(static_cast<size_t>(nextWidth) * height * channels, 0.f);
+		for (int y = 0; y < height; ++y)
+		{
+			const float* sourceRow = &source[static_cast<size_t>(y) * width * channels];
+			float* row = &horizontal[static_cast<size_t>(y) * nextWidth * channels];
+
+			for (int x = 0; x < nextWidth; ++x)
+			{
+				const int* indices = &columnTaps.indices[static_cast<size_t>(x) * columnTaps.tapCount];
+				const float* weights = &columnTaps.weights[static_cast<size_t>(x) * columnTaps.tapCount];
+
+				for (int t = 0; t < columnTaps.tapCount; ++t)
+				{
+					if (weights[t] == 0.f)
+						continue;
+
+					const float* texel = sourceRow + static_cast<size_t>(indices[t]) * channels;
+					for (int c = 0; c < channels; ++c)
+						row[x * channels + c] += texel[c] * weights[t];
+				}
+			}
+		}
+
+		// Vertical pass : nextWidth x height -> nextWidth x nextHeight
+		destination.assign(static_cast<size_t>(nextWidth) * nextHeight * channels, 0.f);
+		const size_t rowSize = static_cast<size_t>(nextWidth) * channels;
+		for (int y = 0; y < nextHeight; ++y)
+		{
+			const int* indices = &rowTaps.indices[static_cast<size_t>(y) * rowTaps.tapCount];
+			const float* weights = &rowTaps.weights[static_cast<size_t>(y) * rowTaps.tapCount];
+			float* row = &destination[y * rowSize];
+
+			for (int t = 0; t < rowTaps.tapCount; ++t)
+			{
+				if (weights[t] == 0.f)
+					continue;
+
+				const float* sourceRow = &horizontal[static_cast<size_t>(indices[t]) * rowSize];
+				for (size_t i = 0; i < rowSize; ++i)
+					row[i] += sourceRow[i] * weights[t];
+			}
+		}
+
+		// Negative lobes may overshoot, clamp before the next level so ringing does not accumulate
+		for (float& value : destination)
+			value = std::clamp(value, 0.f, 1.f);
+
+		// Encode the level
+		TextureMipLevel level = { nextWidth, nextHeight, pixels.size(), destination.size() * channelSize };
+		pixels.resize(pixels.size() + level.size);
+		unsigned char* output = pixels.data() + level.offset;
+
+		for (size_t i = 0; i < destination.size(); ++i)
+		{
+			float value = destination[i];
+			if (isSRGB && !IsAlphaChannel(static_cast<int>(i % channels), channels))
+				value = LinearToSRGB(value);
+
+			if (channelSize == 2)
+			{
+				uint16_t encoded = static_cast<uint16_t>(value * maxValue + 0.5f);
+				std::memcpy(output + i * 2, &encoded, sizeof(uint16_t));
+			}
+			else
+			{
+				output[i] = static_cast<unsigned char>(value * maxValue + 0.5f);
+			}
+		}
+
+		levels.push_back(level);
+
+		source.swap(destination);
+		width = nextWidth;
+		height = nextHeight;
+	}
+}
@@ -0,0 +1,702 @@
+#include "Resources/Loaders/TextureCompressor.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <cfloat>
+#include <algorithm>
+#include <glad/gl.h>
+
+// S3TC formats come from an extension the loader may not expose
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
+namespace
+{
+	constexpr int BlockTexels = 16;
+
+	// Number of least squares refinements of the endpoints
+	constexpr int RefineIterations = 2;
+
+	// Interpolation weights of the 4 bits indices of BC7
+	constexpr int BC7Weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+	/**
+	@brief Mean and direction of largest variance of the texels of a block (power iteration on their covariance)
+	*/
+	template <int N>
+	void ComputePrincipalAxis(const float (&points)[BlockTexels][N], float (&mean)[N], float (&axis)[N])
+	{
+		float minimum[N], maximum[N];
+		for (int c = 0; c < N; ++c)
+		{
+			mean[c] = 0.f;
+			minimum[c] = FLT_MAX;
+			maximum[c] = -FLT_MAX;
+		}
+
+		for (int i = 0; i < BlockTexels; ++i)
+		{
+			for (int c = 0; c < N; ++c)
+			{
+				mean[c] += points[i][c];
+				minimum[c] = std::min(minimum[c], points[i][c]);
+				maximum[c] = std::max(maximum[c], points[i][c]);
+			}
+		}
+
+		for (int c = 0; c < N; ++c)
+			mean[c] /= BlockTexels;
+
+		float covariance[N][N] = {};
+		for (int i = 0; i < BlockTexels; ++i)
+		{
+			for (int a = 0; a < N; ++a)
+			{
+				float da = points[i][a] - mean[a];
+				for (int b = a; b < N; ++b)
+					covariance[a][b] += da * (points[i][b] - mean[b]);
+			}
+		}
+
+		for (int a = 0; a < N; ++a)
+		{
+			for (int b = 0; b < a; ++b)
+				covariance[a][b] = covariance[b][a];
+		}
+
+		// Start from the diagonal of the bounding box, close to the axis in most blocks
+		for (int c = 0; c < N; ++c)
+			axis[c] = maximum[c] - minimum[c];
+
+		for (int iteration = 0; iteration < 8; ++iteration)
+		{
+			float next[N] = {};
+			float length = 0.f;
+
+			for (int a = 0; a < N; ++a)
+			{
+				for (int b = 0; b < N; ++b)
+					next[a] += covariance[a][b] * axis[b];
+
+				length += next[a] * next[a];
+			}
+
+			if (length < 1e-12f)
+				break;
+
+			length = 1.f / std::sqrt(length);
+			for (int c = 0; c < N; ++c)
+				axis[c] = next[c] * length;
+		}
+
+		float length = 0.f;
+		for (int c = 0; c < N; ++c)
+			length += axis[c] * axis[c];
+
+		if (length < 1e-12f)
+		{
+			for (int c = 0; c < N; ++c)
+				axis[c] = 1.f;
+
+			length = static_cast<float>(N);
+		}
+
+		length = 1.f / std::sqrt(length);
+		for (int c = 0; c < N; ++c)
+			axis[c] *= length;
+	}
+
+	/**
+	@brief Extremities of the projection of the texels on an axis
+	*/
+	template <int N>
+	void ComputeAxisEndpoints(const float (&points)[BlockTexels][N], const float (&mean)[N], const float (&axis)[N], float (&endpoint0)[N], float (&endpoint1)[N])
+	{
+		float minT = FLT_MAX, maxT = -FLT_MAX;
+		for (int i = 0; i < BlockTexels; ++i)
+		{
+			float t = 0.f;
+			for (int c = 0; c < N; ++c)
+				t += (points[i][c] - mean[c]) * axis[c];
+
+			minT = std::min(minT, t);
+			maxT = std::max(maxT, t);
+		}
+
+		for (int c = 0; c < N; ++c)
+		{
+			endpoint0[c] = std::clamp(mean[c] + axis[c] * maxT, 0.f, 255.f);
+			endpoint1[c] = std::clamp(mean[c] + axis[c] * minT, 0.f, 255.f);
+		}
+	}
+
+	/**
+	@brief Least squares endpoints of texels interpolated with known weights
+
+	@param weights0 : Weight of the first endpoint for each texel
+	@return bool : false if the system is degenerate (every texel on one endpoint)
+	*/
+	template <int N>
+	bool SolveEndpoints(const float (&points)[BlockTexels][N], const float (&weights0)[BlockTexels], float (&endpoint0)[N], float (&endpoint1)[N])
+	{
+		float aa = 0.f, bb = 0.f, ab = 0.f;
+		float ax[N] = {}, bx[N] = {};
+
+		for (int i = 0; i < BlockTexels; ++i)
+		{
+			float a = weights0[i];
+			float b = 1.f - a;
+
+			aa += a * a;
+			bb += b * b;
+			ab += a * b;
+
+			for (int c = 0; c < N; ++c)
+			{
+				ax[c] += a * points[i][c];
+				bx[c] += b * points[i][c];
+			}
+		}
+
+		float determinant = aa * bb - ab * ab;
+		if (std::abs(determinant) < 1e-6f)
+			return false;
+
+		float inverse = 1.f / determinant;
+		for (int c = 0; c < N; ++c)
+		{
+			endpoint0[c] = std::clamp((ax[c] * bb - bx[c] * ab) * inverse, 0.f, 255.f);
+			endpoint1[c] = std::clamp((bx[c] * aa - ax[c] * ab) * inverse, 0.f, 255.f);
+		}
+
+		return true;
+	}
+
+	template <int N>
+	void LoadPoints(const uint8_t* rgba, float (&points)[BlockTexels][N])
+	{
+		for (int i = 0; i < BlockTexels; ++i)
+		{
+			for (int c = 0; c < N; ++c)
+				points[i][c] = rgba[i * 4 + c];
+		}
+	}
+
+#pragma region BC1
+
+	uint16_t PackColor565(const float (&color)[3])
+	{
+		int r = std::clamp(static_cast<int>(color[0] * 31.f / 255.f + 0.5f), 0, 31);
+		int g = std::clamp(static_cast<int>(color[1] * 63.f / 255.f + 0.5f), 0, 63);
+		int b = std::clamp(static_cast<int>(color[2] * 31.f / 255.f + 0.5f), 0, 31);
+		return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+	}
+
+	void UnpackColor565(uint16_t packed, int (&color)[3])
+	{
+		int r = packed >> 11, g = (packed >> 5) & 63, b = packed & 31;
+		color[0] = (r << 3) | (r >> 2);
+		color[1] = (g << 2) | (g >> 4);
+		color[2] = (b << 3) | (b >> 2);
+	}
+
+	/**
+	@brief Choose the indices of a BC1 color block, endpoints are swapped to stay in 4 colors mode
+
+	@return int : Squared error of the block
+	*/
+	int FitColorIndices(const uint8_t* rgba, uint16_t& color0, uint16_t& color1, uint32_t& indices)
+	{
+		if (color0 < color1)
+			std::swap(color0, color1);
+
+		int palette[4][3];
+		UnpackColor565(color0, palette[0]);
+		UnpackColor565(color1, palette[1]);
+
+		// Equal endpoints are in 3 colors mode, only the first index is usable
+		int paletteSize = color0 == color1 ? 1 : 4;
+		for (int c = 0; c < 3; ++c)
+		{
+			palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+			palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+		}
+
+		int error = 0;
+		indices = 0;
+		for (int i = 0; i < BlockTexels; ++i)
+		{
+			int bestIndex = 0, bestDistance = INT32_MAX;
+			for (int p = 0; p < paletteSize; ++p)
+			{
+				int dr = rgba[i * 4] - palette[p][0], dg = rgba[i * 4 + 1] - palette[p][1], db = rgba[i * 4 + 2] - palette[p][2];
+				int distance = dr * dr + dg * dg + db * db;
+				if (distance < bestDistance)
+				{
+					bestDistance = distance;
+					bestIndex = p;
+				}
+			}
+
+			error += bestDistance;
+			indices |= static_cast<uint32_t>(bestIndex) << (2 * i);
+		}
+
+		return error;
+	}
+
+	void EncodeColorBlock(const uint8_t* rgba, uint8_t* output)
+	{
+		float points[BlockTexels][3];
+		LoadPoints(rgba, points);
+
+		float mean[3], axis[3], endpoint0[3], endpoint1[3];
+		ComputePrincipalAxis(points, mean, axis);
+		ComputeAxisEndpoints(points, mean, axis, endpoint0, endpoint1);
+
+		uint16_t color0 = PackColor565(endpoint0), color1 = PackColor565(endpoint1);
+		uint32_t indices = 0;
+		int error = FitColorIndices(rgba, color0, color1, indices);
+
+		constexpr float Weights0[4] = { 1.f, 0.f, 2.f / 3.f, 1.f / 3.f };
+		for (int iteration = 0; iteration < RefineIterations && error > 0; ++iteration)
+		{
+			float weights0[BlockTexels];
+			for (int i = 0; i < BlockTexels; ++i)
+				weights0[i] = Weights0[(indices >> (2 * i)) & 3];
+
+			if (!SolveEndpoints(points, weights0, endpoint0, endpoint1))
+				break;
+
+			uint16_t refined0 = PackColor565(endpoint0), refined1 = PackColor565(endpoint1);
+			uint32_t refinedIndices = 0;
+			int refinedError = FitColorIndices(rgba, refined0, refined1, refinedIndices);
+			if (refinedError >= error)
+				break;
+
+			color0 = refined0;
+			color1 = refined1;
+			indices = refinedIndices;
+			error = refinedError;
+		}
+
+		std::memcpy(output, &color0, sizeof(uint16_t));
+		std::memcpy(output + 2, &color1, sizeof(uint16_t));
+		std::memcpy(output + 4, &indices, sizeof(uint32_t));
+	}
+
+#pragma endregion
+
+#pragma region BC4
+
+	/**
+	@brief Choose the indices of a BC4 block, 8 values mode if value0 > value1, else 6 values with 0 and 255
+
+	@return int : Squared error of the block
+	*/
+	int FitSingleChannelIndices(const uint8_t* values, int value0, int value1, uint64_t& indices)
+	{
+		int palette[8] = { value0, value1 };
+		if (value0 > value1)
+		{
+			for (int i = 2; i < 8; ++i)
+				palette[i] = ((8 - i) * value0 + (i - 1) * value1) / 7;
+		}
+		else
+		{
+			for (int i = 2; i < 6; ++i)
+				palette[i] = ((6 - i) * value0 + (i - 1) * value1) / 5;
+
+			palette[6] = 0;
+			palette[7] = 255;
+		}
+
+		int error = 0;
+		indices = 0;
+		for (int i = 0; i < BlockTexels; ++i)
+		{
+			int bestIndex = 0, bestDistance = INT32_MAX;
+			for (int p = 0; p < 8; ++p)
+			{
+				int distance = (values[i] - palette[p]) * (values[i] - palette[p]);
+				if (distance < bestDistance)
+				{
+					bestDistance = distance;
+					bestIndex = p;
+				}
+			}
+
+			error += bestDistance;
+			indices |= static_cast<uint64_t>(bestIndex) << (3 * i);
+		}
+
+		return error;
+	}
+
+	void EncodeSingleChannelBlock(const uint8_t* rgba, int channel, uint8_t* output)
+	{
+		uint8_t values[BlockTexels];
+		int minimum = 255, maximum = 0;
+		int minimumInner = 255, maximumInner = 0;
+
+		for (int i = 0; i < BlockTexels; ++i)
+		{
+			values[i] = rgba[i * 4 + channel];
+			minimum = std::min<int>(minimum, values[i]);
+			maximum = std::max<int>(maximum, values[i]);
+
+			if (values[i] != 0 && values[i] != 255)
+			{
+				minimumInner = std::min<int>(minimumInner, values[i]);
+				maximumInner = std::max<int>(maximumInner, values[i]);
+			}
+		}
+
+		int value0 = maximum, value1 = minimum;
+		uint64_t indices = 0;
+		int error = FitSingleChannelIndices(values, value0, value1, indices);
+
+		// 8 values mode refined with least squares
+		for (int iteration = 0; iteration < RefineIterations && error > 0 && value0 > value1; ++iteration)
+		{
+			float points[BlockTexels][1], weights0[BlockTexels];
+			for (int i = 0; i < BlockTexels; ++i)
+			{
+				int index = static_cast<int>((indices >> (3 * i)) & 7);
+				points[i][0] = values[i];
+				weights0[i] = index == 0 ? 1.f : (index == 1 ? 0.f : (8 - index) / 7.f);
+			}
+
+			float endpoint0[1], endpoint1[1];
+			if (!SolveEndpoints(points, weights0, endpoint0, endpoint1))
+				break;
+
+			int refined0 = static_cast<int>(endpoint0[0] + 0.5f), refined1 = static_cast<int>(endpoint1[0] + 0.5f);
+			if (refined0 <= refined1)
+				break;
+
+			uint64_t refinedIndices = 0;
+			int refinedError = FitSingleChannelIndices(values, refined0, refined1, refinedIndices);
+			if (refinedError >= error)
+				break;
+
+			value0 = refined0;
+			value1 = refined1;
+			indices = refinedIndices;
+			error = refinedError;
+		}
+
+		// 6 values mode, better when the block mixes extremes with a narrow range
+		if (error > 0)
+		{
+			int inner0 = minimumInner <= maximumInner ? minimumInner : 0;
+			int inner1 = minimumInner <= maximumInner ? maximumInner : 0;
+
+			uint64_t innerIndices = 0;
+			int innerError = FitSingleChannelIndices(values, inner0, inner1, innerIndices);
+			if (innerError < error)
+			{
+				value0 = inner0;
+				value1 = inner1;
+				indices = innerIndices;
+			}
+		}
+
+		output[0] = static_cast<uint8_t>(value0);
+		output[1] = static_cast<uint8_t>(value1);
+		for (int i = 0; i < 6; ++i)
+			output[2 + i] = static_cast<uint8_t>(indices >> (8 * i));
+	}
+
+#pragma endregion
+
+#pragma region BC7
+
+	struct BC7Endpoint
+	{
+		int values[4] = {};	// 7 bits
+		int pBit = 0;
+	};
+
+	BC7Endpoint QuantizeBC7Endpoint(const float (&color)[4])
+	{
+		BC7Endpoint best;
+		float bestError = FLT_MAX;
+
+		for (int pBit = 0; pBit < 2; ++pBit)
+		{
+			BC7Endpoint endpoint;
+			endpoint.pBit = pBit;
+
+			float error = 0.f;
+			for (int c = 0; c < 4; ++c)
+			{
+				endpoint.values[c] = std::clamp(static_cast<int>((color[c] - pBit) * 0.5f + 0.5f), 0, 127);
+				float difference = static_cast<float>(endpoint.values[c] * 2 + pBit) - color[c];
+				error += difference * difference;
+			}
+
+			if (error < bestError)
+			{
+				bestError = error;
+				best = endpoint;
+			}
+		}
+
+		return best;
+	}
+
+	/**
+	@brief Choose the indices of a BC7 mode 6 block
+
+	@return int : Squared error of the block
+	*/
+	int FitBC7Indices(const uint8_t* rgba, const BC7Endpoint& endpoint0, const BC7Endpoint& endpoint1, uint8_t (&indices)[BlockTexels])
+	{
+		int palette[16][4];
+		for (int c = 0; c < 4; ++c)
+		{
+			int value0 = endpoint0.values[c] * 2 + endpoint0.pBit;
+			int value1 = endpoint1.values[c] * 2 + endpoint1.pBit;
+
+			for (int i = 0; i < 16; ++i)
+				palette[i][c] = ((64 - BC7Weights[i]) * value0 + BC7Weights[i] * value1 + 32) >> 6;
+		}
+
+		int error = 0;
+		for (int i = 0; i < BlockTexels; ++i)
+		{
+			int bestIndex = 0, bestDistance = INT32_MAX;
+			for (int p = 0; p < 16; ++p)
+			{
+				int distance = 0;
+				for (int c = 0; c < 4; ++c)
+				{
+					int difference = rgba[i * 4 + c] - palette[p][c];
+					distance += difference * difference;
+				}
+
+				if (distance < bestDistance)
+				{
+					bestDistance = distance;
+					bestIndex = p;
+				}
+			}
+
+			error += bestDistance;
+			indices[i] = static_cast<uint8_t>(bestIndex);
+		}
+
+		return error;
+	}
+
+	/**
+	@brief Write bits from the least significant one of a 128 bits block
+	*/
+	class BitWriter
+	{
+	private:
+		uint8_t* m_output;
+		int m_position = 0;
+
+	public:
+		BitWriter(uint8_t* output)
+			: m_output(output)
+		{
+			std::memset(m_output, 0, 16);
+		}
+
+		void Write(uint32_t value, int bitCount)
+		{
+			for (int i = 0; i < bitCount; ++i, ++m_position)
+			{
+				if (value & (1u << i))
+					m_output[m_position >> 3] |= static_cast<uint8_t>(1u << (m_position & 7));
+			}
+		}
+	};
+
+	void EncodeBC7Block(const uint8_t* rgba, uint8_t* output)
+	{
+		float points[BlockTexels][4];
+		LoadPoints(rgba, points);
+
+		float mean[4], axis[4], color0[4], color1[4];
+		ComputePrincipalAxis(points, mean, axis);
+		ComputeAxisEndpoints(points, mean, axis, color0, color1);
+
+		BC7Endpoint endpoint0 = QuantizeBC7Endpoint(color0), endpoint1 = QuantizeBC7Endpoint(color1);
+		uint8_t indices[BlockTexels];
+		int error = FitBC7Indices(rgba, endpoint0, endpoint1, indices);
+
+		for (int iteration = 0; iteration < RefineIterations && error > 0; ++iteration)
+		{
+			float weights0[BlockTexels];
+			for (int i = 0; i < BlockTexels; ++i)
+				weights0[i] = (64 - BC7Weights[indices[i]]) / 64.f;
+
+			if (!SolveEndpoints(points, weights0, color0, color1))
+				break;
+
+			BC7Endpoint refined0 = QuantizeBC7Endpoint(color0), refined1 = QuantizeBC7Endpoint(color1);
+			uint8_t refinedIndices[BlockTexels];
+			int refinedError = FitBC7Indices(rgba, refined0, refined1, refinedIndices);
+			if (refinedError >= error)
+				break;
+
+			endpoint0 = refined0;
+			endpoint1 = refined1;
+			std::memcpy(indices, refinedIndices, sizeof(indices));
+			error = refinedError;
+		}
+
+		// The most significant bit of the first index is implicit and must be 0
+		if (indices[0] & 8)
+		{
+			std::swap(endpoint0, endpoint1);
+			for (uint8_t& index : indices)
+				index = static_cast<uint8_t>(15 - index);
+		}
+
+		BitWriter writer(output);
+		writer.Write(1u << 6, 7); // Mode 6
+
+		for (int c = 0; c < 4; ++c)
+		{
+			writer.Write(endpoint0.values[c], 7);
+			writer.Write(endpoint1.values[c], 7);
+		}
+
+		writer.Write(endpoint0.pBit, 1);
+		writer.Write(endpoint1.pBit, 1);
+
+		writer.Write(indices[0], 3);
+		for (int i = 1; i < BlockTexels; ++i)
+			writer.Write(indices[i], 4);
+	}
+
+#pragma endregion
+}
+
+BlockFormat TextureCompressor::ChooseFormat(const Flags<EImageSTB>& flags, int channels, bool is16Bits)
+{
+	if (is16Bits || channels <= 0)
+		return BlockFormat::NONE;
+
+	if (flags.TestBit(EImageSTB::IMG_COMPRESS_NORMAL))
+		return channels >= 2 ? BlockFormat::BC5 : BlockFormat::NONE;
+
+	if (flags.TestBit(EImageSTB::IMG_COMPRESS_MASK))
+		return BlockFormat::BC4;
+
+	if (flags.TestBit(EImageSTB::IMG_COMPRESS_COLOR))
+	{
+		if (flags.TestBit(EImageSTB::IMG_COMPRESS_FAST))
+			return channels == 4 ? BlockFormat::BC3 : BlockFormat::BC1;
+
+		return BlockFormat::BC7;
+	}
+
+	return BlockFormat::NONE;
+}
+
+int TextureCompressor::GetGLFormat(BlockFormat format)
+{
+	switch (format)
+	{
+	case BlockFormat::BC1:	return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+	case BlockFormat::BC3:	return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+	case BlockFormat::BC4:	return GL_COMPRESSED_RED_RGTC1;
+	case BlockFormat::BC5:	return GL_COMPRESSED_RG_RGTC2;
+	case BlockFormat::BC7:	return GL_COMPRESSED_RGBA_BPTC_UNORM;
+	default:				return 0;
+	}
+}
+
+size_t TextureCompressor::GetBlockSize(BlockFormat format)
+{
+	switch (format)
+	{
+	case BlockFormat::BC1:
+	case BlockFormat::BC4:
+		return 8;
+	case BlockFormat::BC3:
+	case BlockFormat::BC5:
+	case BlockFormat::BC7:
+		return 16;
+	default:
+		return 0;
+	}
+}
+
+size_t TextureCompressor::GetCompressedSize(BlockFormat format, int width, int height)
+{
+	size_t blocksX = (static_cast<size_t>(width) + 3) / 4;
+	size_t blocksY = (static_cast<size_t>(height) + 3) / 4;
+	return blocksX * blocksY * GetBlockSize(format);
+}
+
+void TextureCompressor::CompressBlock(BlockFormat format, const uint8_t* rgba, uint8_t* output)
+{
+	switch (format)
+	{
+	case BlockFormat::BC1:
+		EncodeColorBlock(rgba, output);
+		break;
+	case BlockFormat::BC3:
+		EncodeSingleChannelBlock(rgba, 3, output);
+		EncodeColorBlock(rgba, output + 8);
+		break;
+	case BlockFormat::BC4:
+		EncodeSingleChannelBlock(rgba, 0, output);
+		break;
+	case BlockFormat::BC5:
+		EncodeSingleChannelBlock(rgba, 0, output);
+		EncodeSingleChannelBlock(rgba, 1, output + 8);
+		break;
+	case BlockFormat::BC7:
+		EncodeBC7Block(rgba, output);
+		break;
+	default:
+		break;
+	}
+}
+
+void TextureCompressor::CompressImage(BlockFormat format, const uint8_t* pixels, int width, int height, int channels, uint8_t* output)
+{
+	const size_t blockSize = GetBlockSize(format);
+	const int blocksX = (width + 3) / 4;
+	const int blocksY = (height + 3) / 4;
+
+	uint8_t block[BlockTexels * 4];
+
+	for (int blockY = 0; blockY < blocksY; ++blockY)
+	{
+		for (int blockX = 0; blockX < blocksX; ++blockX)
+		{
+			for (int y = 0; y < 4; ++y)
+			{
+				int sourceY = std::min(blockY * 4 + y, height - 1);
+				for (int x = 0; x < 4; ++x)
+				{
+					int sourceX = std::min(blockX * 4 + x, width - 1);
+					const uint8_t* source = pixels + (static_cast<size_t>(sourceY) * width + sourceX) * channels;
+					uint8_t* texel = block + (y * 4 + x) * 4;
+
+					texel[0] = source[0];
+					texel[1] = channels > 1 ? source[1] : 0;
+					texel[2] = channels > 2 ? source[2] : 0;
+					texel[3] = channels > 3 ? source[3] : 255;
+				}
+			}
+
+			CompressBlock(format, block, output);
+			output += blockSize;
+		}
+	}
+}
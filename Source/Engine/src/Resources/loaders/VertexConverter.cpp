@@ -0,0 +1,57 @@
+#include "Resources/Loaders/VertexConverter.hpp"
+
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HY_IMPORT_SSE2
+#include <emmintrin.h>
+#endif
+
+// Vertices are written as floats by the SIMD conversion : position, normal, uvs, tangent then bitangent
+static_assert(sizeof(Vertex) == 14 * sizeof(float) && offsetof(Vertex, normal) == 3 * sizeof(float) && offsetof(Vertex, uvs) == 6 * sizeof(float)
+	&& offsetof(Vertex, tangent) == 8 * sizeof(float) && offsetof(Vertex, bitangent) == 11 * sizeof(float), "Unexpected Vertex layout");
+
+void VertexConverter::Convert(const Streams& streams, std::vector<Vertex>& vertices, bool useSIMD)
+{
+	const size_t count = streams.count;
+	vertices.resize(count);
+	if (count == 0)
+		return;
+
+	const float* positions = streams.positions;
+	const float* normals = streams.normals;
+	const float* uvs = streams.uvs;
+	const float* tangents = streams.tangents;
+
+	Vertex* dst = vertices.data();
+	size_t i = 0;
+
+#ifdef HY_IMPORT_SSE2
+	// Each stream element is loaded as 4 floats, the 4th one is the next element : the last vertex is converted by the scalar loop.
+	// Stores run in the order of the members, each one overwrites the junk lane of the previous one, the bitangent lanes are zeroed.
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 xyzMask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+
+	for (; useSIMD && i + 1 < count; ++i)
+	{
+		float* out = reinterpret_cast<float*>(dst + i);
+		const size_t element = i * 3;
+
+		_mm_storeu_ps(out + 0, _mm_loadu_ps(positions + element));
+		_mm_storeu_ps(out + 3, normals ? _mm_loadu_ps(normals + element) : zero);
+		_mm_storel_pi(reinterpret_cast<__m64*>(out + 6), uvs ? _mm_loadu_ps(uvs + element) : zero);
+		_mm_storeu_ps(out + 8, tangents ? _mm_and_ps(_mm_loadu_ps(tangents + element), xyzMask) : zero);
+		_mm_storel_pi(reinterpret_cast<__m64*>(out + 12), zero);
+	}
+#endif
+
+	for (; i < count; ++i)
+	{
+		const size_t element = i * 3;
+
+		Vertex& vertex = dst[i];
+		vertex.position = Vector3(positions[element], positions[element + 1], positions[element + 2]);
+		vertex.normal = normals ? Vector3(normals[element], normals[element + 1], normals[element + 2]) : Vector3(0, 0, 0);
+		vertex.uvs = uvs ? Vector2(uvs[element], uvs[element + 1]) : Vector2(0, 0);
+		vertex.tangent = tangents ? Vector3(tangents[element], tangents[element + 1], tangents[element + 2]) : Vector3(0, 0, 0);
+		vertex.bitangent = Vector3(0, 0, 0);
+	}
+}
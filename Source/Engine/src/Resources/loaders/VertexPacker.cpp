@@ -0,0 +1,316 @@
+#include "Resources/Loaders/VertexPacker.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+namespace
+{
+	// Bounds thinner than this on an axis are widened so the scale never divides by zero
+	constexpr float MinHalfExtent = 1e-6f;
+
+	constexpr uint16_t HalfOne = 0x3C00;
+	constexpr uint16_t HalfMinusOne = 0xBC00;
+
+	int16_t ToSnorm16(float value)
+	{
+		return static_cast<int16_t>(std::lround(std::clamp(value, -1.f, 1.f) * 32767.f));
+	}
+
+	float FromSnorm16(int16_t value)
+	{
+		return std::max(static_cast<float>(value) / 32767.f, -1.f);
+	}
+
+	float SignNotZero(float value)
+	{
+		return value >= 0.f ? 1.f : -1.f;
+	}
+
+	Vector3 GetHalfExtent(const Vector3& min, const Vector3& max)
+	{
+		Vector3 halfExtent = (max - min) * 0.5f;
+		return Vector3(std::max(halfExtent.x, MinHalfExtent), std::max(halfExtent.y, MinHalfExtent), std::max(halfExtent.z, MinHalfExtent));
+	}
+}
+
+size_t VertexPacker::GetVertexSize(EVertexLayout layout)
+{
+	return layout == EVertexLayout::FLOAT ? sizeof(Vertex) : sizeof(PackedVertex);
+}
+
+bool VertexPacker::CanUseShortIndices(size_t vertexCount)
+{
+	return vertexCount <= 65536;
+}
+
+void VertexPacker::ComputeBounds(std::span<const Vertex> vertices, Vector3& min, Vector3& max)
+{
+	if (vertices.empty())
+	{
+		min = max = Vector3();
+		return;
+	}
+
+	min = max = vertices[0].position;
+	for (const Vertex& vertex : vertices)
+	{
+		min = Vector3(std::min(min.x, vertex.position.x), std::min(min.y, vertex.position.y), std::min(min.z, vertex.position.z));
+		max = Vector3(std::max(max.x, vertex.position.x), std::max(max.y, vertex.position.y), std::max(max.z, vertex.position.z));
+	}
+}
+
+void VertexPacker::GetPositionTransform(EVertexLayout layout, const Vector3& min, const Vector3& max, Vector3& offset, Vector3& scale)
+{
+	if (layout == EVertexLayout::FLOAT)
+	{
+		offset = Vector3(0.f, 0.f, 0.f);
+		scale = Vector3(1.f, 1.f, 1.f);
+		return;
+	}
+
+	offset = (min + max) * 0.5f;
+	scale = GetHalfExtent(min, max);
+}
+
+
+#pragma region ENCODING
+
+void VertexPacker::Pack(EVertexLayout layout, std::span<const Vertex> vertices, const Vector3& min, const Vector3& max, unsigned char* output)
+{
+	if (layout == EVertexLayout::FLOAT)
+	{
+		std::memcpy(output, vertices.data(), vertices.size_bytes());
+		return;
+	}
+
+	Vector3 offset, scale;
+	GetPositionTransform(layout, min, max, offset, scale);
+
+	PackedVertex* packedVertices = reinterpret_cast<PackedVertex*>(output);
+	for (size_t i = 0; i < vertices.size(); ++i)
+	{
+		const Vertex& vertex = vertices[i];
+		PackedVertex& packed = packedVertices[i];
+
+		Vector3 position = (vertex.position - offset) / scale;
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			float value = std::clamp(position[axis], -1.f, 1.f);
+			packed.position[axis] = layout == EVertexLayout::PACKED_HALF ? FloatToHalf(value) : static_cast<uint16_t>(ToSnorm16(value));
+		}
+
+		// Mirrored UVs flip the bitangent
+		Vector3 bitangent = Vector3::CrossProduct(vertex.normal, vertex.tangent);
+		bool mirrored = Vector3::DotProduct(bitangent, vertex.bitangent) < 0.f;
+		if (layout == EVertexLayout::PACKED_HALF)
+			packed.position[3] = mirrored ? HalfMinusOne : HalfOne;
+		else
+			packed.position[3] = static_cast<uint16_t>(mirrored ? -32767 : 32767);
+
+		EncodeOctahedral(vertex.normal, packed.normal);
+		EncodeOctahedral(vertex.tangent, packed.tangent);
+
+		packed.uvs[0] = FloatToHalf(vertex.uvs.x);
+		packed.uvs[1] = FloatToHalf(vertex.uvs.y);
+	}
+}
+
+void VertexPacker::Unpack(EVertexLayout layout, const unsigned char* input, size_t count, const Vector3& min, const Vector3& max, Vertex* output)
+{
+	if (layout == EVertexLayout::FLOAT)
+	{
+		std::memcpy(output, input, count * sizeof(Vertex));
+		return;
+	}
+
+	Vector3 offset, scale;
+	GetPositionTransform(layout, min, max, offset, scale);
+
+	// The input may be a mapped file, it is read unaligned
+	for (size_t i = 0; i < count; ++i)
+	{
+		PackedVertex packed;
+		std::memcpy(&packed, input + i * sizeof(PackedVertex), sizeof(PackedVertex));
+
+		Vertex& vertex = output[i];
+
+		Vector3 position;
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			position[axis] = layout == EVertexLayout::PACKED_HALF ? HalfToFloat(packed.position[axis])
+				: FromSnorm16(static_cast<int16_t>(packed.position[axis]));
+		}
+		vertex.position = offset + position * scale;
+
+		float sign = layout == EVertexLayout::PACKED_HALF ? HalfToFloat(packed.position[3]) : FromSnorm16(static_cast<int16_t>(packed.position[3]));
+
+		vertex.normal = DecodeOctahedral(packed.normal);
+		vertex.tangent = DecodeOctahedral(packed.tangent);
+		vertex.bitangent = Vector3::CrossProduct(vertex.normal, vertex.tangent) * SignNotZero(sign);
+
+		vertex.uvs.x = HalfToFloat(packed.uvs[0]);
+		vertex.uvs.y = HalfToFloat(packed.uvs[1]);
+	}
+}
+
+#pragma endregion
+
+
+#pragma region HALF_FLOATS
+
+uint16_t VertexPacker::FloatToHalf(float value)
+{
+	uint32_t bits;
+	std::memcpy(&bits, &value, sizeof(float));
+
+	const uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+	const uint32_t exponent = (bits >> 23) & 0xFF;
+	uint32_t mantissa = bits & 0x7FFFFF;
+
+	// Infinity and NaN, NaN keeps a mantissa bit
+	if (exponent == 0xFF)
+		return sign | 0x7C00 | (mantissa ? 0x200 : 0);
+
+	const int halfExponent = static_cast<int>(exponent) - 127 + 15;
+
+	// Overflow to infinity
+	if (halfExponent >= 31)
+		return sign | 0x7C00;
+
+	// Denormals, or zero when even the denormals are too small
+	if (halfExponent <= 0)
+	{
+		if (halfExponent < -10)
+			return sign;
+
+		mantissa |= 0x800000;
+		const uint32_t shift = static_cast<uint32_t>(14 - halfExponent);
+		uint32_t halfMantissa = mantissa >> shift;
+
+		const uint32_t remainder = mantissa & ((1u << shift) - 1);
+		const uint32_t halfway = 1u << (shift - 1);
+		if (remainder > halfway || (remainder == halfway && (halfMantissa & 1)))
+			halfMantissa++;
+
+		return sign | static_cast<uint16_t>(halfMantissa);
+	}
+
+	uint32_t half = (static_cast<uint32_t>(halfExponent) << 10) | (mantissa >> 13);
+
+	// Round to nearest even, a carry in the exponent is still the right value
+	const uint32_t remainder = mantissa & 0x1FFF;
+	if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1)))
+		half++;
+
+	return sign | static_cast<uint16_t>(half);
+}
+
+float VertexPacker::HalfToFloat(uint16_t value)
+{
+	const uint32_t sign = static_cast<uint32_t>(value & 0x8000) << 16;
+	uint32_t exponent = (value >> 10) & 0x1F;
+	uint32_t mantissa = value & 0x3FF;
+
+	uint32_t bits;
+	if (exponent == 0x1F)
+	{
+		bits = sign | 0x7F800000 | (mantissa << 13);
+	}
+	else if (exponent == 0)
+	{
+		if (mantissa == 0)
+		{
+			bits = sign;
+		}
+		else
+		{
+			// Denormal, normalized for the float exponent
+			exponent = 127 - 15 + 1;
+			while ((mantissa & 0x400) == 0)
+			{
+				mantissa <<= 1;
+				exponent--;
+			}
+			bits = sign | (exponent << 23) | ((mantissa & 0x3FF) << 13);
+		}
+	}
+	else
+	{
+		bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+	}
+
+	float result;
+	std::memcpy(&result, &bits, sizeof(float));
+	return result;
+}
+
+#pragma endregion
+
+
+#pragma region OCTAHEDRAL
+
+void VertexPacker::EncodeOctahedral(const Vector3& vector, int16_t output[2])
+{
+	const float length = std::abs(vector.x) + std::abs(vector.y) + std::abs(vector.z);
+	if (length <= 0.f)
+	{
+		output[0] = 0;
+		output[1] = 32767;
+		return;
+	}
+
+	float x = vector.x / length;
+	float y = vector.y / length;
+
+	// The lower hemisphere is folded over the diagonals
+	if (vector.z < 0.f)
+	{
+		const float foldedX = (1.f - std::abs(y)) * SignNotZero(x);
+		const float foldedY = (1.f - std::abs(x)) * SignNotZero(y);
+		x = foldedX;
+		y = foldedY;
+	}
+
+	// Rounding each component alone is not always the closest direction, the four neighbours are tried
+	const Vector3 direction = vector / std::sqrt(Vector3::DotProduct(vector, vector));
+	const float baseX = std::floor(std::clamp(x, -1.f, 1.f) * 32767.f);
+	const float baseY = std::floor(std::clamp(y, -1.f, 1.f) * 32767.f);
+
+	float bestDot = -2.f;
+	for (int i = 0; i < 4; ++i)
+	{
+		int16_t candidate[2] = {
+			static_cast<int16_t>(std::clamp(baseX + (i & 1), -32767.f, 32767.f)),
+			static_cast<int16_t>(std::clamp(baseY + (i >> 1), -32767.f, 32767.f))
+		};
+
+		float dot = Vector3::DotProduct(DecodeOctahedral(candidate), direction);
+		if (dot > bestDot)
+		{
+			bestDot = dot;
+			output[0] = candidate[0];
+			output[1] = candidate[1];
+		}
+	}
+}
+
+Vector3 VertexPacker::DecodeOctahedral(const int16_t input[2])
+{
+	float x = FromSnorm16(input[0]);
+	float y = FromSnorm16(input[1]);
+	const float z = 1.f - std::abs(x) - std::abs(y);
+
+	if (z < 0.f)
+	{
+		const float unfoldedX = (1.f - std::abs(y)) * SignNotZero(x);
+		const float unfoldedY = (1.f - std::abs(x)) * SignNotZero(y);
+		x = unfoldedX;
+		y = unfoldedY;
+	}
+
+	Vector3 result(x, y, z);
+	return result / std::sqrt(Vector3::DotProduct(result, result));
+}
+
+#pragma endregion
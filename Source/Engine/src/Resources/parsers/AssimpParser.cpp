@@ -6,6 +6,10 @@
 #include <assimp/postprocess.h>
 #include <nlohmann/json.hpp>
 
+#include <fstream>
+#include <cctype>
+#include <algorithm>
+
 #include "Resources/Types.hpp"
 #include "Resources/Resource/Texture.hpp"
 #include "Resources/Resource/Material.hpp"
@@ -20,13 +24,136 @@
 #include "EngineContext.hpp"
 #include "Resources/ResourcesManager.hpp"
 #include "Resources/Loaders/ResourcesLoader.hpp"
+#include "Resources/Loaders/MeshOptimizer.hpp"
+#include "Resources/Loaders/MeshletBuilder.hpp"
+#include "Resources/Loaders/VertexConverter.hpp"
 
 #include "Renderer/RenderSystem.hpp"
 
 #include "Generated/ParserFlags.rfks.h"
 
+namespace
+{
+	/**
+	@brief Get the resource of the previous import of a model at a path
+
+	@return Resource* : the resource, nullptr if the path was not imported with this type
+	*/
+	Resource* FindReusedResource(const AssimpParser::ReusedResources& reused, const std::string& path, RESOURCE_TYPE type)
+	{
+		auto it = reused.find(path);
+		if (it == reused.end() || it->second->GetType() != type)
+			return nullptr;
+
+		return it->second;
+	}
+
+	// Texture slots of a material, in the order they are hashed
+	constexpr aiTextureType MaterialTextureTypes[] =
+	{
+		aiTextureType_AMBIENT,
+		aiTextureType_DIFFUSE,
+		aiTextureType_SPECULAR,
+		aiTextureType_EMISSIVE,
+		aiTextureType_METALNESS,
+		aiTextureType_DIFFUSE_ROUGHNESS,
+		aiTextureType_NORMALS,
+		aiTextureType_AMBIENT_OCCLUSION
+	};
+
+	/**
+	@brief Get the usage of the textures of a material slot, the channels read by the mesh shaders decide their compression
+	*/
+	ETextureUsage GetTextureUsage(aiTextureType type)
+	{
+		switch (type)
+		{
+		case aiTextureType_NORMALS:
+			return ETextureUsage::NORMAL;
+		case aiTextureType_SPECULAR:
+		case aiTextureType_METALNESS:
+		case aiTextureType_DIFFUSE_ROUGHNESS:
+		case aiTextureType_AMBIENT_OCCLUSION:
+			return ETextureUsage::MASK;
+		default:
+			return ETextureUsage::COLOR;
+		}
+	}
+
+	/**
+	@brief Get the size of the image of an embedded texture : compressed bytes, or raw texels
+	*/
+	size_t GetEmbeddedTextureSize(const aiTexture* aiTexture)
+	{
+		if (aiTexture->mHeight == 0)
+			return aiTexture->mWidth;
+
+		return static_cast<size_t>(aiTexture->mWidth) * aiTexture->mHeight * sizeof(aiTexel);
+	}
+
+	/**
+	@brief Get the size of the imported data of a sub mesh before its optimization : vertices, indices and bone data
+	*/
+	size_t GetSubMeshSize(const aiMesh* aimesh, bool isSkeletal)
+	{
+		size_t size = aimesh->mNumVertices * sizeof(Vertex) + static_cast<size_t>(aimesh->mNumFaces) * 3 * sizeof(int);
+		if (isSkeletal)
+			size += aimesh->mNumVertices * sizeof(VertexBoneData);
+
+		return size;
+	}
+
+	/**
+	@brief Append the hash of a memory range to a list of hashes, hashed again as a whole
+	*/
+	void AppendHash(std::vector<Hash128>& hashes, const void* data, size_t size)
+	{
+		hashes.emplace_back(ContentHash::Compute(data, size));
+	}
 
-bool AssimpParser::LoadModel(Model& model, int flags)
+	/**
+	@brief Append the hash of a memory range to a list of hashes, and chain it in the check of the content
+	*/
+	void AppendHash(std::vector<Hash128>& hashes, ImportContentIndex::ContentCheck& check, const void* data, size_t size)
+	{
+		AppendHash(hashes, data, size);
+		check.hash = ContentHash::ComputeCheck(data, size, check.hash);
+		check.size += size;
+	}
+
+	/**
+	@brief Get a path no resource is stored at : the path, or the path with a number appended to the file name
+
+	@return std::string : a path for a new resource, a sub-asset shared with another model keeps its own
+	*/
+	std::string GetFreeResourcePath(ResourcesManager* RM, const std::string& path)
+	{
+		if (!RM->HasResourceByPath(path))
+			return path;
+
+		const std::string pathWithoutExtension = StringHelper::GetFilePathWithoutExtension(path);
+		const std::string extension = StringHelper::GetFileExtensionFromPath(path);
+
+		std::string freePath;
+		for (uint32_t i = 1; freePath.empty() || RM->HasResourceByPath(freePath); ++i)
+			freePath = pathWithoutExtension + "_" + std::to_string(i) + extension;
+
+		return freePath;
+	}
+
+	std::string FormatBytes(size_t bytes)
+	{
+		if (bytes < 1024)
+			return std::to_string(bytes) + " B";
+		if (bytes < 1024 * 1024)
+			return std::to_string(bytes / 1024) + " KB";
+
+		return std::to_string(bytes / (1024 * 1024)) + "." + std::to_string(bytes % (1024 * 1024) * 10 / (1024 * 1024)) + " MB";
+	}
+}
+
+
+bool AssimpParser::LoadModel(Model& model, int flags, const ReusedResources& reused)
 {
 	// Importer aitextures and aiMeshes are used in another thread
 	// This is done to avoid copying the resources data
@@ -47,27 +174,60 @@ bool AssimpParser::LoadModel(Model& model, int flags)
 	}
 
 	// Load model
+	ImportState state = { reused };
 	model.GetJsonGraph().clear();
-	ProcessMaterials(model, scene);
-	ProcessNode(model, scene->mRootNode, scene, "0");
+	ProcessMaterials(model, scene, state);
+	ProcessNode(model, scene->mRootNode, scene, "0", state);
 
+	const DedupReport& report = state.report;
+	Logger::Info("Import dedup - " + model.GetFilename() + " : " + std::to_string(report.textures) + " textures, "
+		+ std::to_string(report.materials) + " materials, " + std::to_string(report.meshes) + " meshes shared, "
+		+ FormatBytes(report.savedBytes) + " saved");
+
+	ResourcesManager* RM = EngineContext::Instance().resourcesManager;
 	taskPool.AddSingleThreadTask([&model]() { model.ComputeBoudingBox(); });
 	taskPool.AddSingleThreadTask([&model]() { ResourcesLoader::CreateResourceFiles(&model); });
+	taskPool.AddSingleThreadTask([RM]() { RM->GetImportContentIndex().Save(); });
 
 	return true;
 }
 
-void AssimpParser::ProcessMaterials(Model& model, const aiScene* scene)
+void AssimpParser::ProcessMaterials(Model& model, const aiScene* scene, ImportState& state)
 {
 	ResourcesManager* RM = EngineContext::Instance().resourcesManager;
+	ImportContentIndex& contentIndex = RM->GetImportContentIndex();
 
 	for (uint32_t i = 0; i < scene->mNumMaterials; ++i)
 	{
 		aiMaterial* material = scene->mMaterials[i];
 
-		Material* mat = RM->CreateResource<Material>();
 		std::string matPath = StringHelper::GetDirectory(model.GetFilepath()) + std::string(material->GetName().C_Str()) + ".mat";
-		mat->SetFileInfo(matPath);
+		const Hash128 materialHash = HashMaterial(state, model, material, scene);
+
+		// A reimported material keeps its GUID, the meshes and scenes referencing it stay valid.
+		// One shared with another model is left as it is, the new content gets its own material
+		Material* mat = static_cast<Material*>(FindReusedResource(state.reused, matPath, RESOURCE_TYPE::MATERIAL));
+		if (mat && !contentIndex.Reuse(*mat, materialHash, {}, model.GetUID()))
+			mat = nullptr;
+
+		if (mat == nullptr)
+		{
+			// A material with the same colors and textures as an imported one is that material
+			bool created = false;
+			mat = static_cast<Material*>(contentIndex.FindOrCreate(RESOURCE_TYPE::MATERIAL, materialHash, {}, model.GetUID(), [RM, &matPath]() -> Resource* {
+				Material* newMaterial = RM->CreateResource<Material>();
+				newMaterial->SetFileInfo(GetFreeResourcePath(RM, matPath));
+				return newMaterial;
+				}, created));
+
+			if (!created)
+			{
+				state.report.materials++;
+				state.report.savedBytes += sizeof(MaterialData);
+				model.AddMaterial(*mat);
+				continue;
+			}
+		}
 
 		aiColor3D ambientColor;
 		material->Get(AI_MATKEY_COLOR_AMBIENT, ambientColor);
@@ -88,21 +248,21 @@ void AssimpParser::ProcessMaterials(Model& model, const aiScene* scene)
 		Texture* whiteTexture = static_cast<Texture*>(RM->GetResourceByFilename("White.texture"));
 		Texture* blackTexture = static_cast<Texture*>(RM->GetResourceByFilename("Black.texture"));
 
-		LoadMaterialTextures(&mat->data.ambientTexture, model, material, aiTextureType_AMBIENT, scene, whiteTexture);
-		LoadMaterialTextures(&mat->data.diffuseTexture, model, material, aiTextureType_DIFFUSE, scene, whiteTexture);
-		LoadMaterialTextures(&mat->data.specularTexture, model, material, aiTextureType_SPECULAR, scene, whiteTexture);
-		LoadMaterialTextures(&mat->data.emissiveTexture, model, material, aiTextureType_EMISSIVE, scene, whiteTexture);
-		LoadMaterialTextures(&mat->data.metallicTexture, model, material, aiTextureType_METALNESS, scene, whiteTexture);
-		LoadMaterialTextures(&mat->data.roughnessTexture, model, material, aiTextureType_DIFFUSE_ROUGHNESS, scene, whiteTexture);
-		LoadMaterialTextures(&mat->data.normalTexture, model, material, aiTextureType_NORMALS, scene, nullptr);
-		LoadMaterialTextures(&mat->data.aoTexture, model, material, aiTextureType_AMBIENT_OCCLUSION, scene, whiteTexture);
+		LoadMaterialTextures(&mat->data.ambientTexture, model, material, aiTextureType_AMBIENT, scene, whiteTexture, state);
+		LoadMaterialTextures(&mat->data.diffuseTexture, model, material, aiTextureType_DIFFUSE, scene, whiteTexture, state);
+		LoadMaterialTextures(&mat->data.specularTexture, model, material, aiTextureType_SPECULAR, scene, whiteTexture, state);
+		LoadMaterialTextures(&mat->data.emissiveTexture, model, material, aiTextureType_EMISSIVE, scene, whiteTexture, state);
+		LoadMaterialTextures(&mat->data.metallicTexture, model, material, aiTextureType_METALNESS, scene, whiteTexture, state);
+		LoadMaterialTextures(&mat->data.roughnessTexture, model, material, aiTextureType_DIFFUSE_ROUGHNESS, scene, whiteTexture, state);
+		LoadMaterialTextures(&mat->data.normalTexture, model, material, aiTextureType_NORMALS, scene, nullptr, state);
+		LoadMaterialTextures(&mat->data.aoTexture, model, material, aiTextureType_AMBIENT_OCCLUSION, scene, whiteTexture, state);
 
 		RM->CreateResourceFiles(mat);
 		model.AddMaterial(*mat);
 	}
 }
 
-void AssimpParser::ProcessNode(Model& model, aiNode* node, const aiScene* scene, const std::string& parentID)
+void AssimpParser::ProcessNode(Model& model, aiNode* node, const aiScene* scene, const std::string& parentID, ImportState& state)
 {
 	// Create model node prefab
 	json& root = model.GetJsonGraph();
@@ -136,6 +296,8 @@ void AssimpParser::ProcessNode(Model& model, aiNode* node, const aiScene* scene,
 
 	Mesh* modelMesh = nullptr;
 	bool isSkeletal = false;
+	bool isShared = false;
+	std::vector<Material*> subMeshMaterials;
 
 	if (node->mNumMeshes > 0) // CREATE MESH RESOURCE
 	{
@@ -143,28 +305,69 @@ void AssimpParser::ProcessNode(Model& model, aiNode* node, const aiScene* scene,
 		isSkeletal = mesh->HasBones();
 		std::string meshName = mesh->mName.C_Str();
 
-		if (isSkeletal)
+		std::string meshPath = StringHelper::GetDirectory(model.GetFilepath()) + meshName + (isSkeletal ? ".skmesh" : ".mesh");
+		const RESOURCE_TYPE meshType = isSkeletal ? RESOURCE_TYPE::SKELETALMESH : RESOURCE_TYPE::MESH;
+		ImportContentIndex::ContentCheck meshCheck;
+		const Hash128 meshHash = HashMesh(model, node, scene, isSkeletal, subMeshMaterials, meshCheck);
+
+		ImportContentIndex& contentIndex = RM->GetImportContentIndex();
+
+		// A reimported mesh keeps its GUID : its previous data is released and it is loaded again.
+		// One shared with another model is left as it is, the new content gets its own mesh
+		modelMesh = static_cast<Mesh*>(FindReusedResource(state.reused, meshPath, meshType));
+		if (modelMesh && contentIndex.Reuse(*modelMesh, meshHash, meshCheck, model.GetUID()))
 		{
-			modelMesh = RM->CreateResource<SkeletalMesh>();
-			modelMesh->SetFileInfo(StringHelper::GetDirectory(model.GetFilepath()) + meshName + ".skmesh");
-			//modelMesh->SetFilename(meshName + ".skmesh");
-			//modelMesh->SetFilepath(StringHelper::GetDirectory(model.GetFilepath()) + meshName + ".skmesh");
+			modelMesh->UnloadFromGPUMemory();
+			modelMesh->ClearSubMeshes();
+			modelMesh->TrySetState(RESOURCE_STATE::UNLOADED);
 		}
 		else
 		{
-			modelMesh = RM->CreateResource<Mesh>();
-			modelMesh->SetFileInfo(StringHelper::GetDirectory(model.GetFilepath()) + meshName + ".mesh");
-			//modelMesh->SetFilename(meshName + ".mesh");
-			//modelMesh->SetFilepath(StringHelper::GetDirectory(model.GetFilepath()) + meshName + ".mesh");
+			// The same sub meshes with the same materials and settings, from this model or another one, are one mesh
+			bool created = false;
+			modelMesh = static_cast<Mesh*>(contentIndex.FindOrCreate(meshType, meshHash, meshCheck, model.GetUID(), [RM, isSkeletal, &meshPath]() -> Resource* {
+				Mesh* newMesh = nullptr;
+				if (isSkeletal)
+					newMesh = RM->CreateResource<SkeletalMesh>();
+				else
+					newMesh = RM->CreateResource<Mesh>();
+
+				newMesh->SetFileInfo(GetFreeResourcePath(RM, meshPath));
+				return newMesh;
+				}, created));
+
+			isShared = !created;
+		}
+
+		if (isShared)
+		{
+			state.report.meshes++;
+			for (unsigned int i = 0; i < node->mNumMeshes; i++)
+				state.report.savedBytes += GetSubMeshSize(scene->mMeshes[node->mMeshes[i]], isSkeletal);
+		}
+		else
+		{
+			modelMesh->TrySetState(RESOURCE_STATE::LOADING);
+			if (!isSkeletal)
+				modelMesh->SetVertexLayout(model.GetVertexLayout());
 		}
 	}
 
 	ResourcesTaskPool& taskPool = RM->GetTaskPool();
 
+	// One slot per sub mesh, filled by its task : the order of the sub meshes does not depend on the threads
+	SkeletalMesh* skeletalMesh = isSkeletal ? static_cast<SkeletalMesh*>(modelMesh) : nullptr;
+	if (modelMesh && !isShared)
+	{
+		modelMesh->subMeshes.resize(node->mNumMeshes);
+		if (skeletalMesh)
+			skeletalMesh->skeletonDatas.resize(node->mNumMeshes);
+	}
+
 	Vector3 minAABB = Vector3::One * FLT_MAX, maxAABB = Vector3::One * (-FLT_MAX);
 
-	// Process all the node's mesh
-	for (unsigned int i = 0; i < node->mNumMeshes; i++)
+	// Process all the node's mesh, a shared mesh is already processed
+	for (unsigned int i = 0; i < node->mNumMeshes && !isShared; i++)
 	{
 		aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
 		
@@ -182,36 +385,44 @@ void AssimpParser::ProcessNode(Model& model, aiNode* node, const aiScene* scene,
 		if (subMeshMaxAABB.y > maxAABB.y) maxAABB.y = subMeshMaxAABB.y;
 		if (subMeshMaxAABB.z > maxAABB.z) maxAABB.z = subMeshMaxAABB.z;
 
+		MeshData* data = &modelMesh->subMeshes[i];
+		SkeletalData* skeletalData = skeletalMesh ? &skeletalMesh->skeletonDatas[i] : nullptr;
+
 		taskPool.AddMultiThreadTask([=, &model]() {
-			ProcessMesh(model, modelMesh, mesh, scene);
+			ProcessMesh(model, *data, skeletalData, mesh);
 			});
 	}
 
 	if (modelMesh)
 	{
-		modelMesh->SetBoudingBox(minAABB, maxAABB);
+		if (!isShared)
+			modelMesh->SetBoudingBox(minAABB, maxAABB);
 
-		taskPool.AddSingleThreadTask([modelMesh, &model, &goComponents, isSkeletal, transformOffset]() {
+		taskPool.AddSingleThreadTask([modelMesh, &model, &goComponents, isSkeletal, isShared, transformOffset, subMeshMaterials]() {
 			// Add the mesh to the model
 			model.AddMesh(modelMesh, transformOffset);
 
-			// Serialize in component
+			// Serialize in component, the materials of a shared mesh are the same as the ones of this import
 			json& meshCompoJson = goComponents[std::string(HYGUID::NewGUID())];
 			meshCompoJson["m_name"] = isSkeletal ? "SkeletalMeshComponent" : "MeshComponent";
 			meshCompoJson["m_mesh"] = std::string(modelMesh->GetUID());
 
 			json& materialsJonFile = meshCompoJson["materials"];
-			for (uint32_t i = 0; i < modelMesh->subMeshes.size(); ++i)
+			for (uint32_t i = 0; i < subMeshMaterials.size(); ++i)
 			{
-				MeshData& subMesh = modelMesh->subMeshes[i];
-
 				std::string matName = "v" + std::to_string(i);
-				materialsJonFile[matName] = std::string(subMesh.material->GetUID());
+				materialsJonFile[matName] = subMeshMaterials[i] ? std::string(subMeshMaterials[i]->GetUID()) : std::string("0");
 			}
 
+			if (isShared)
+				return;
+
 			// Create files and GPUData
 			ResourcesLoader::CreateResourceFiles(modelMesh);
+			modelMesh->TrySetState(RESOURCE_STATE::CPU_READY);
 			modelMesh->LoadInGPUMemory();
+			if (!modelMesh->IsGPUUploadPending())
+				modelMesh->TrySetState(RESOURCE_STATE::GPU_READY);
 
 			// Clear sub meshes data
 			for (auto& subMesh : modelMesh->subMeshes)
@@ -221,74 +432,131 @@ void AssimpParser::ProcessNode(Model& model, aiNode* node, const aiScene* scene,
 
 	// Then do the same for each of its children
 	for (unsigned int i = 0; i < node->mNumChildren; i++)
-		ProcessNode(model, node->mChildren[i], scene, id);
+		ProcessNode(model, node->mChildren[i], scene, id, state);
 }
 
-void AssimpParser::ProcessMesh(Model& model, Mesh* mesh, aiMesh* aimesh, const aiScene* scene)
+Hash128 AssimpParser::HashEmbeddedTexture(ImportState& state, const aiTexture* aiTexture)
 {
-	bool isSkeletal = aimesh->HasBones();
-	SkeletalMesh* skMesh = static_cast<SkeletalMesh*>(mesh);
-	if (skMesh == nullptr) isSkeletal = false;
+	auto [it, inserted] = state.textureHashes.try_emplace(aiTexture);
+	if (inserted)
+	{
+		// The size is in the seed : raw images of the same texels with other dimensions are other textures
+		const uint64_t seed = (static_cast<uint64_t>(aiTexture->mWidth) << 32) | aiTexture->mHeight;
+		it->second = ContentHash::Compute(aiTexture->pcData, GetEmbeddedTextureSize(aiTexture), seed);
+	}
 
-	MeshData data;
-	SkeletalData skeletalData;
+	return it->second;
+}
 
-	for (unsigned int i = 0; i < aimesh->mNumVertices; i++)
-	{
-		Vector3 v = Vector3(0, 0, 0);
-		Vector3 n = Vector3(0, 0, 0);
-		Vector2 uv = Vector2(0, 0);
-		Vector3 tan = Vector3(0, 0, 0);
-		Vector3 bit = Vector3(0, 0, 0);
+Hash128 AssimpParser::HashMaterial(ImportState& state, const Model& model, const aiMaterial* material, const aiScene* scene)
+{
+	std::vector<Hash128> hashes;
 
-		v.x = aimesh->mVertices[i].x;
-		v.y = aimesh->mVertices[i].y;
-		v.z = aimesh->mVertices[i].z;
+	aiColor3D colors[4];
+	material->Get(AI_MATKEY_COLOR_AMBIENT, colors[0]);
+	material->Get(AI_MATKEY_COLOR_DIFFUSE, colors[1]);
+	material->Get(AI_MATKEY_COLOR_SPECULAR, colors[2]);
+	material->Get(AI_MATKEY_COLOR_EMISSIVE, colors[3]);
+	AppendHash(hashes, colors, sizeof(colors));
 
-		if (aimesh->HasNormals())
+	// Embedded textures by content, the others by the path they are imported from, slots without texture keep an empty hash
+	for (aiTextureType type : MaterialTextureTypes)
+	{
+		aiString aiTexturePath;
+		if (material->Get(AI_MATKEY_TEXTURE(type, 0), aiTexturePath) != AI_SUCCESS)
 		{
-			n.x = aimesh->mNormals[i].x;
-			n.y = aimesh->mNormals[i].y;
-			n.z = aimesh->mNormals[i].z;
+			hashes.emplace_back();
+			continue;
 		}
-		if (aimesh->mTextureCoords[0])
+
+		const aiTexture* aiTexture = scene->GetEmbeddedTexture(aiTexturePath.C_Str());
+		if (aiTexture && aiTexture->pcData)
 		{
-			uv.x = aimesh->mTextureCoords[0][i].x;
-			uv.y = aimesh->mTextureCoords[0][i].y;
+			hashes.emplace_back(HashEmbeddedTexture(state, aiTexture));
 		}
-		if (aimesh->HasTangentsAndBitangents())
+		else
 		{
-			tan.x = aimesh->mTangents[i].x;
-			tan.y = aimesh->mTangents[i].y;
-			tan.z = aimesh->mTangents[i].z;
-
-			bit.x = aimesh->mBitangents[i].x;
-			bit.y = aimesh->mBitangents[i].y;
-			bit.z = aimesh->mBitangents[i].z;
+			std::string textureFilename = StringHelper::GetFileNameWithoutExtension(StringHelper::GetFileNameFromPath(aiTexturePath.C_Str()));
+			hashes.emplace_back(ContentHash::Compute(StringHelper::GetDirectory(model.GetFilepath()) + textureFilename));
 		}
+	}
 
-		Vertex vertex;
-		vertex.position = v;
-		vertex.normal = n;
-		vertex.uvs = uv;
-		vertex.tangent = tan;
+	return ContentHash::Compute(hashes.data(), hashes.size() * sizeof(Hash128));
+}
 
-		data.vertices.push_back(vertex);
+Hash128 AssimpParser::HashMesh(const Model& model, const aiNode* node, const aiScene* scene, bool isSkeletal, std::vector<Material*>& materials,
+	ImportContentIndex::ContentCheck& check)
+{
+	static_assert(sizeof(aiVector3D) == 3 * sizeof(float), "Vertex streams are hashed as packed floats");
+
+	std::vector<Hash128> hashes;
+	std::vector<unsigned int> indices;
+
+	const std::vector<Material*>& modelMaterials = model.GetMaterials();
+	materials.resize(node->mNumMeshes, nullptr);
+
+	for (unsigned int i = 0; i < node->mNumMeshes; i++)
+	{
+		const aiMesh* aimesh = scene->mMeshes[node->mMeshes[i]];
+		const size_t streamSize = aimesh->mNumVertices * sizeof(aiVector3D);
+
+		AppendHash(hashes, check, aimesh->mVertices, streamSize);
+		if (aimesh->HasNormals())
+			AppendHash(hashes, check, aimesh->mNormals, streamSize);
+		if (aimesh->mTextureCoords[0])
+			AppendHash(hashes, check, aimesh->mTextureCoords[0], streamSize);
+		if (aimesh->HasTangentsAndBitangents())
+			AppendHash(hashes, check, aimesh->mTangents, streamSize);
+
+		// Faces are triangulated by the import flags
+		indices.resize(static_cast<size_t>(aimesh->mNumFaces) * 3);
+		for (unsigned int faceID = 0; faceID < aimesh->mNumFaces; ++faceID)
+			std::copy_n(aimesh->mFaces[faceID].mIndices, 3, indices.data() + faceID * 3);
+		AppendHash(hashes, check, indices.data(), indices.size() * sizeof(unsigned int));
 
 		if (isSkeletal)
 		{
-			VertexBoneData vBoneData;
-			for (int i = 0; i < MAX_BONE_INFLUENCE; ++i)
+			for (unsigned int boneID = 0; boneID < aimesh->mNumBones; ++boneID)
 			{
-				vBoneData.boneIDs[i] = -1;
-				vBoneData.weights[i] = 0;
+				const aiBone* aibone = aimesh->mBones[boneID];
+				AppendHash(hashes, check, aibone->mName.data, aibone->mName.length);
+				AppendHash(hashes, check, &aibone->mOffsetMatrix, sizeof(aiMatrix4x4));
+				AppendHash(hashes, check, aibone->mWeights, aibone->mNumWeights * sizeof(aiVertexWeight));
 			}
-			skeletalData.vertexBoneData.emplace_back(vBoneData);
+		}
+
+		// Sub meshes keep their material, meshes are only shared between identical materials
+		if (aimesh->mMaterialIndex < modelMaterials.size())
+		{
+			materials[i] = modelMaterials[aimesh->mMaterialIndex];
+			const std::array<unsigned char, 16>& uid = materials[i]->GetUID().Bytes();
+			AppendHash(hashes, check, uid.data(), uid.size());
 		}
 	}
 
+	// Settings changing the processed data of the sub meshes
+	const MeshSimplifier::ChainSettings lodSettings = model.GetLODSettings();
+	const float settings[] = { static_cast<float>(model.GetVertexLayout()), static_cast<float>(lodSettings.levelCount), lodSettings.reduction,
+		lodSettings.maxError, model.GetBuildMeshlets() ? 1.f : 0.f, isSkeletal ? 1.f : 0.f };
+	AppendHash(hashes, check, settings, sizeof(settings));
+
+	return ContentHash::Compute(hashes.data(), hashes.size() * sizeof(Hash128));
+}
+
+void AssimpParser::ProcessMesh(Model& model, MeshData& data, SkeletalData* skeletalData, const aiMesh* aimesh)
+{
+	const bool isSkeletal = skeletalData != nullptr;
+
+	ConvertVertices(aimesh, data.vertices);
+
 	if (isSkeletal)
 	{
+		// Sub meshes without bones of a skeletal mesh keep unbound vertices, bone data is read with the same base vertex
+		VertexBoneData unbound;
+		std::fill(std::begin(unbound.boneIDs), std::end(unbound.boneIDs), -1);
+		skeletalData->vertexBoneData.assign(aimesh->mNumVertices, unbound);
+
+		skeletalData->boneTransforms.reserve(aimesh->mNumBones);
 		for (unsigned int i = 0; i < aimesh->mNumBones; ++i)
 		{
 			int boneIdx = i;
@@ -301,15 +569,15 @@ void AssimpParser::ProcessMesh(Model& model, Mesh* mesh, aiMesh* aimesh, const a
 								  m.a3, m.b3, m.c3, m.d3,
 								  m.a4, m.b4, m.c4, m.d4 };
 
-			skeletalData.boneLink[boneName] = { boneIdx, offsetMat };
-			skeletalData.boneTransforms.push_back(Matrix4::Identity);
+			skeletalData->boneLink[boneName] = { boneIdx, offsetMat };
+			skeletalData->boneTransforms.push_back(Matrix4::Identity);
 
 			for (unsigned int weightIdx = 0; weightIdx < aibone->mNumWeights; ++weightIdx)
 			{
 				unsigned int vertexID = aibone->mWeights[weightIdx].mVertexId;
 				float weight = aibone->mWeights[weightIdx].mWeight;
 
-				VertexBoneData& vertexBoneData = skeletalData.vertexBoneData[vertexID];
+				VertexBoneData& vertexBoneData = skeletalData->vertexBoneData[vertexID];
 				
 				for (int i = 0; i < MAX_BONE_INFLUENCE; ++i)
 				{
@@ -324,24 +592,128 @@ void AssimpParser::ProcessMesh(Model& model, Mesh* mesh, aiMesh* aimesh, const a
 		}
 	}
 
-	for (unsigned int faceID = 0; faceID < aimesh->mNumFaces; ++faceID)
+	// Faces are triangulated by the import flags
+	data.indices.resize(static_cast<size_t>(aimesh->mNumFaces) * 3);
+	int* indices = data.indices.data();
+	for (unsigned int faceID = 0; faceID < aimesh->mNumFaces; ++faceID, indices += 3)
 	{
-		aiFace& face = aimesh->mFaces[faceID];
-		for (size_t indexID = 0; indexID < 3; ++indexID)
-		{
-			data.indices.push_back(face.mIndices[indexID]);
-		}
+		const aiFace& face = aimesh->mFaces[faceID];
+		indices[0] = face.mIndices[0];
+		indices[1] = face.mIndices[1];
+		indices[2] = face.mIndices[2];
+	}
+
+	OptimizeMesh(data, skeletalData, aimesh->mName.C_Str());
+
+	// Skeletal meshes are drawn at full detail, and whole : their meshlets bounds would move with the bones
+	if (!isSkeletal)
+	{
+		if (model.GetBuildMeshlets())
+			GenerateMeshlets(data, aimesh->mName.C_Str());
+		GenerateLODs(data, model.GetLODSettings(), aimesh->mName.C_Str());
 	}
 
 	unsigned int matIDX = aimesh->mMaterialIndex;
 	if (matIDX >= 0 && matIDX < model.GetMaterials().size())
 	{
-		data.material = model.GetMaterials()[matIDX];;
+		data.material = model.GetMaterials()[matIDX];
 	}
+}
 
-	mesh->subMeshes.push_back(data);
-	if (isSkeletal)
-		skMesh->skeletonDatas.push_back(skeletalData);
+void AssimpParser::ConvertVertices(const aiMesh* aimesh, std::vector<Vertex>& vertices)
+{
+	static_assert(sizeof(aiVector3D) == 3 * sizeof(float), "Vertex streams are read as packed floats");
+
+	VertexConverter::Streams streams;
+	streams.positions = reinterpret_cast<const float*>(aimesh->mVertices);
+	streams.normals = aimesh->HasNormals() ? reinterpret_cast<const float*>(aimesh->mNormals) : nullptr;
+	streams.uvs = reinterpret_cast<const float*>(aimesh->mTextureCoords[0]);
+	streams.tangents = aimesh->HasTangentsAndBitangents() ? reinterpret_cast<const float*>(aimesh->mTangents) : nullptr;
+	streams.count = aimesh->mNumVertices;
+
+	VertexConverter::Convert(streams, vertices);
+}
+
+void AssimpParser::OptimizeMesh(MeshData& data, SkeletalData* skeletalData, const std::string& meshName)
+{
+	if (data.indices.empty())
+		return;
+
+	const MeshOptimizer::VertexCacheStats before = MeshOptimizer::AnalyzeVertexCache(data.indices, data.vertices.size());
+
+	MeshOptimizer::OptimizeVertexCache(data.indices, data.vertices.size());
+	MeshOptimizer::OptimizeOverdraw(data.indices, data.vertices);
+
+	std::vector<unsigned int> remap;
+	const size_t vertexCount = MeshOptimizer::OptimizeVertexFetch(data.indices, data.vertices.size(), remap);
+	MeshOptimizer::RemapVertices(data.vertices, remap, vertexCount);
+	if (skeletalData)
+		MeshOptimizer::RemapVertices(skeletalData->vertexBoneData, remap, vertexCount);
+
+	const MeshOptimizer::VertexCacheStats after = MeshOptimizer::AnalyzeVertexCache(data.indices, data.vertices.size());
+
+	Logger::Info("Mesh optimization - " + meshName + " (" + std::to_string(after.triangleCount) + " triangles) : ACMR "
+		+ std::to_string(before.ACMR) + " -> " + std::to_string(after.ACMR) + ", ATVR "
+		+ std::to_string(before.ATVR) + " -> " + std::to_string(after.ATVR));
+}
+
+void AssimpParser::GenerateLODs(MeshData& data, const MeshSimplifier::ChainSettings& settings, const std::string& meshName)
+{
+	if (settings.levelCount < 2 || data.indices.empty())
+		return;
+
+	const size_t fullIndexCount = data.indices.size();
+	std::vector<MeshLOD> lods = { { 0, static_cast<uint32_t>(fullIndexCount), 0.f } };
+
+	std::vector<int> previous = data.indices;
+	std::vector<int> simplified;
+	float error = 0.f;
+
+	while (lods.size() < settings.levelCount)
+	{
+		const size_t target = static_cast<size_t>(static_cast<float>(previous.size() / 3) * settings.reduction) * 3;
+		const float levelError = MeshSimplifier::Simplify(previous, data.vertices, target, settings.maxError - error, simplified);
+
+		// A level saving less than a tenth of the triangles is not worth its memory
+		if (simplified.empty() || simplified.size() * 10 > previous.size() * 9)
+			break;
+
+		// Errors add up along the chain, each level is simplified from the previous one
+		error += levelError;
+
+		MeshOptimizer::OptimizeVertexCache(simplified, data.vertices.size());
+
+		lods.push_back({ static_cast<uint32_t>(data.indices.size()), static_cast<uint32_t>(simplified.size()), error });
+		data.indices.insert(data.indices.end(), simplified.begin(), simplified.end());
+
+		Logger::Info("Mesh LOD - " + meshName + " LOD" + std::to_string(lods.size() - 1) + " : " + std::to_string(simplified.size() / 3)
+			+ " triangles (" + std::to_string(100 * simplified.size() / fullIndexCount) + "%), error " + std::to_string(error));
+
+		previous.swap(simplified);
+	}
+
+	if (lods.size() > 1)
+		data.lods = std::move(lods);
+}
+
+void AssimpParser::GenerateMeshlets(MeshData& data, const std::string& meshName)
+{
+	if (data.indices.size() / 3 < MeshletBuilder::MinTriangleCount)
+		return;
+
+	MeshletBuilder::Build(data.indices, data.vertices, data.meshlets);
+	if (data.meshlets.empty())
+		return;
+
+	// Triangles moved meshlet by meshlet, the vertices follow them. Ranges of indices are kept
+	std::vector<unsigned int> remap;
+	const size_t vertexCount = MeshOptimizer::OptimizeVertexFetch(data.indices, data.vertices.size(), remap);
+	MeshOptimizer::RemapVertices(data.vertices, remap, vertexCount);
+
+	const MeshOptimizer::VertexCacheStats stats = MeshOptimizer::AnalyzeVertexCache(data.indices, data.vertices.size());
+
+	Logger::Info("Mesh meshlets - " + meshName + " : " + std::to_string(data.meshlets.size()) + " meshlets, "
+		+ std::to_string(static_cast<float>(stats.triangleCount) / data.meshlets.size()) + " triangles each, ACMR " + std::to_string(stats.ACMR));
 }
 
 // Private function for getting GLint internal format according to desired channel number
@@ -380,9 +752,94 @@ GLint GetGLImageFormat(int desiredChannels)
 	return GLImageFormat[desiredChannels];
 }
 
-void AssimpParser::LoadMaterialTextures(Texture** texture, Model& model, aiMaterial* mat, aiTextureType type, const aiScene* scene, Texture*  defaultTexture)
+// Private function flipping an image upside down, stbi_set_flip_vertically_on_load is global and textures are loaded from several threads
+void FlipImageRows(unsigned char* pixels, int width, int height, size_t pixelSize)
+{
+	const size_t rowSize = static_cast<size_t>(width) * pixelSize;
+	std::vector<unsigned char> row(rowSize);
+
+	for (int top = 0, bottom = height - 1; top < bottom; ++top, --bottom)
+	{
+		unsigned char* topRow = pixels + top * rowSize;
+		unsigned char* bottomRow = pixels + bottom * rowSize;
+
+		memcpy(row.data(), topRow, rowSize);
+		memcpy(topRow, bottomRow, rowSize);
+		memcpy(bottomRow, row.data(), rowSize);
+	}
+}
+
+// Private function getting the format of a compressed embedded texture if stb_image can read it back from disk, empty otherwise
+std::string GetReadableEmbeddedFormat(const aiTexture* aiTexture)
+{
+	if (aiTexture->mHeight != 0)
+		return {};
+
+	std::string hint = aiTexture->achFormatHint;
+	std::transform(hint.begin(), hint.end(), hint.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+	for (const char* format : { "png", "jpg", "jpeg", "bmp", "tga", "psd", "gif", "hdr", "pic" })
+	{
+		if (hint == format)
+			return hint;
+	}
+
+	return {};
+}
+
+// Private function getting the extension of the file written for an embedded texture
+std::string GetEmbeddedTextureExtension(const aiTexture* aiTexture)
+{
+	const std::string format = GetReadableEmbeddedFormat(aiTexture);
+	return format.empty() ? "png" : format;
+}
+
+bool AssimpParser::WriteEmbeddedTexture(const aiTexture* aiTexture, const std::string& path)
+{
+	// Compressed image readable as is, its bytes are copied without decoding and encoding it again
+	if (!GetReadableEmbeddedFormat(aiTexture).empty())
+	{
+		std::ofstream file(path, std::ios::binary);
+		file.write(reinterpret_cast<const char*>(aiTexture->pcData), aiTexture->mWidth);
+		return static_cast<bool>(file);
+	}
+
+	int width = 0, height = 0, channelsCount = 0;
+	unsigned char* pixels = nullptr;
+
+	if (aiTexture->mHeight == 0)
+	{
+		// Compressed in a format stb_image cannot read back from disk, it is decoded once and written as a PNG
+		pixels = stbi_load_from_memory(&aiTexture->pcData->b, static_cast<int>(aiTexture->mWidth), &width, &height, &channelsCount, 0);
+		if (pixels == nullptr)
+			return false;
+
+		const bool written = stbi_write_png(path.c_str(), width, height, channelsCount, pixels, width * channelsCount) != 0;
+		stbi_image_free(pixels);
+		return written;
+	}
+
+	// Raw ARGB8888 texels, stored as BGRA bytes
+	width = static_cast<int>(aiTexture->mWidth);
+	height = static_cast<int>(aiTexture->mHeight);
+
+	std::vector<unsigned char> rgba(static_cast<size_t>(width) * height * 4);
+	for (size_t i = 0; i < static_cast<size_t>(width) * height; ++i)
+	{
+		const aiTexel& texel = aiTexture->pcData[i];
+		rgba[i * 4 + 0] = texel.r;
+		rgba[i * 4 + 1] = texel.g;
+		rgba[i * 4 + 2] = texel.b;
+		rgba[i * 4 + 3] = texel.a;
+	}
+
+	return stbi_write_png(path.c_str(), width, height, 4, rgba.data(), width * 4) != 0;
+}
+
+void AssimpParser::LoadMaterialTextures(Texture** texture, Model& model, aiMaterial* mat, aiTextureType type, const aiScene* scene, Texture*  defaultTexture, ImportState& state)
 {
 	ResourcesManager* RM = EngineContext::Instance().resourcesManager;
+	const ETextureUsage usage = GetTextureUsage(type);
 
 	aiString aiTexturePath;
 	if (mat->Get(AI_MATKEY_TEXTURE(type, 0), aiTexturePath) == AI_SUCCESS)
@@ -394,12 +851,17 @@ void AssimpParser::LoadMaterialTextures(Texture** texture, Model& model, aiMater
 		std::string subTexturePath = modelDirectory + R"(textures\)" + textureFilename + ".texture";
 
 		{
-			auto TryGetTexture = [RM, texture](const std::string& path)
+			auto TryGetTexture = [RM, texture, usage](const std::string& path)
 			{
 				Resource* existing = nullptr;
 				if (existing = RM->GetResourceByPath(path))
 				{
 					*texture = static_cast<Texture*>(existing);
+
+					// The first slot using a texture chose its compression
+					if (!(*texture)->CanBeUsedAs(usage))
+						Logger::Warning("AssimpParser - Texture '" + path + "' is compressed with fewer channels than another of its slots reads, change its loading flags");
+
 					return true;
 				}
 
@@ -415,43 +877,59 @@ void AssimpParser::LoadMaterialTextures(Texture** texture, Model& model, aiMater
 		const aiTexture* aiTexture = scene->GetEmbeddedTexture(aiTexturePath.C_Str());
 		if (aiTexture && aiTexture->pcData) // embedded texture
 		{
-			*texture = RM->CreateResource<Texture>();
-
-			Texture* texturePtr = *texture;
-			texturePtr->originalPath = StringHelper::GetFilePathWithoutExtension(texturePath) + ".png"; // we will write it on disk as a .png
-			texturePtr->SetFileInfo(texturePath);
-
-			RM->GetTaskPool().AddMultiThreadTask([=]() {
-
-				// Create PNG file
+			// The same image embedded in another model, or under another name, is that texture : it is not written and loaded again
+			const size_t textureSize = GetEmbeddedTextureSize(aiTexture);
+			const uint64_t textureSeed = (static_cast<uint64_t>(aiTexture->mWidth) << 32) | aiTexture->mHeight;
+			const ImportContentIndex::ContentCheck textureCheck = { textureSize, ContentHash::ComputeCheck(aiTexture->pcData, textureSize, textureSeed) };
+
+			bool created = false;
+			Texture* existing = nullptr;
+			Resource* indexed = RM->GetImportContentIndex().FindOrCreate(RESOURCE_TYPE::TEXTURE, HashEmbeddedTexture(state, aiTexture), textureCheck, model.GetUID(),
+				[RM, &texturePath, &existing]() -> Resource* {
+				// Another model importing a texture at this path may have created it since the lookup
+				bool pathCreated = false;
+				Texture* newTexture = RM->GetOrCreateResource<Texture>(texturePath, pathCreated);
+				if (pathCreated)
+					return newTexture;
+
+				existing = newTexture;
+				return nullptr;
+				}, created);
+
+			if (!created)
+			{
+				if (indexed)
 				{
-					stbi_set_flip_vertically_on_load(false);
+					state.report.textures++;
+					state.report.savedBytes += textureSize;
+				}
 
-					int channelsCount = 0;
-					int bufferLen = aiTexture->mHeight == 0 ? aiTexture->mWidth : aiTexture->mWidth * aiTexture->mHeight;
+				*texture = indexed ? static_cast<Texture*>(indexed) : existing;
+				return;
+			}
 
-					texturePtr->data.data = stbi_load_from_memory(&aiTexture->pcData->b, bufferLen, &(texturePtr->data.width), &(texturePtr->data.height), &channelsCount, 0);
+			*texture = static_cast<Texture*>(indexed);
 
-					if (texturePtr->data.data == nullptr)
-					{
-						RM->DeleteResource((*texture)->GetUID());
+			Texture* texturePtr = *texture;
+			texturePtr->TrySetState(RESOURCE_STATE::LOADING);
+			texturePtr->SetUsage(usage);
+			texturePtr->originalPath = StringHelper::GetFilePathWithoutExtension(texturePath) + "." + GetEmbeddedTextureExtension(aiTexture);
 
-						*texture = defaultTexture;
+			// Each embedded image is written and decoded by its own task
+			RM->GetTaskPool().AddMultiThreadTask([=]() {
 
-						return;
-					}
+				// Write the texture on disk so we don't have to parse again to get it back
+				if (!WriteEmbeddedTexture(aiTexture, texturePtr->originalPath))
+				{
+					RM->DeleteResource((*texture)->GetUID());
 
-					texturePtr->data.channels = channelsCount;
-					texturePtr->data.format = GetGLImageFormat(channelsCount);
-					texturePtr->data.internalFormat = GetGLImageInternalFormat(channelsCount);
+					*texture = defaultTexture;
 
-					// Write the texture on disk so we don't have to parse again to get it back
-					stbi_write_png(texturePtr->originalPath.c_str(), texturePtr->data.width, texturePtr->data.height, channelsCount, texturePtr->data.data, texturePtr->data.width * channelsCount);
-					stbi_image_free(texturePtr->data.data);
+					return;
 				}
 
-				// Load texture for storage, texture is free in the LoadInGpuMemory
-				if (!AssimpParser::LoadTexture(*texturePtr, texturePtr->GetLoadingFlags(), false))
+				// Load texture for storage, texture is free in the LoadInGpuMemory. It is cooked like the imported images
+				if (!ResourcesLoader::LoadTextureUnsafe(*texturePtr))
 				{
 					FreeTexture(*texturePtr);
 					RM->DeleteResource((*texture)->GetUID());
@@ -463,9 +941,14 @@ void AssimpParser::LoadMaterialTextures(Texture** texture, Model& model, aiMater
 
 				// Create texture files
 				ResourcesLoader::CreateResourceFiles(texturePtr);
+				texturePtr->TrySetState(RESOURCE_STATE::CPU_READY);
 
 				// Add loadGpu task
-				RM->GetTaskPool().AddSingleThreadTask([texturePtr]() { texturePtr->LoadInGPUMemory(); });
+				RM->GetTaskPool().AddSingleThreadTask([texturePtr]() {
+					texturePtr->LoadInGPUMemory();
+					if (!texturePtr->IsGPUUploadPending())
+						texturePtr->TrySetState(RESOURCE_STATE::GPU_READY);
+					});
 				});
 
 			return;
@@ -478,9 +961,9 @@ void AssimpParser::LoadMaterialTextures(Texture** texture, Model& model, aiMater
 
 				Logger::Warning(texturePath);
 
-				auto TryLoadTexture = [RM, texture](const std::string& path) {
+				auto TryLoadTexture = [RM, texture, usage](const std::string& path) {
 
-					RM->ImportResource<Texture>(path);
+					RM->ImportResource<Texture>(path, [usage](Texture& newTexture) { newTexture.SetUsage(usage); });
 					Resource* res = RM->GetResourceByPath(path);
 
 					if (res != nullptr)
@@ -513,8 +996,13 @@ void AssimpParser::LoadMaterialTextures(Texture** texture, Model& model, aiMater
 
 void AssimpParser::FreeTexture(Texture& texture)
 {
-	if (texture.data.data != nullptr)
+	// Pixels with an owner come from the texture cache, the others from stb_image
+	if (texture.data.storage)
+		texture.data.storage.reset();
+	else if (texture.data.data != nullptr)
 		stbi_image_free(texture.data.data);
+
+	texture.data.mipLevels.clear();
 }
 
 bool AssimpParser::LoadTexture(Texture& texture, const Flags<EImageSTB>& flags, bool shouldFreeData)
@@ -542,8 +1030,6 @@ bool AssimpParser::LoadTexture(Texture& texture, const Flags<EImageSTB>& flags,
 		Channels = 4;
 	}
 
-	stbi_set_flip_vertically_on_load(flags.TestBit(EImageSTB::IMG_FLIP));
-
 	bool is16 = stbi_is_16_bit(texture.originalPath.c_str());
 
 	if (is16)
@@ -562,6 +1048,9 @@ bool AssimpParser::LoadTexture(Texture& texture, const Flags<EImageSTB>& flags,
 		return false;
 	}
 
+	if (flags.TestBit(EImageSTB::IMG_FLIP))
+		FlipImageRows(texture.data.data, texture.data.width, texture.data.height, static_cast<size_t>(Channels) * (is16 ? 2 : 1));
+
 	texture.data.channels = Channels;
 	texture.data.format = GetGLImageFormat(Channels);
 	texture.data.internalFormat = GetGLImageInternalFormat(Channels);
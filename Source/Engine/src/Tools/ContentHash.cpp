@@ -0,0 +1,272 @@
+#include "Tools/ContentHash.hpp"
+
+#include <cstring>
+#include <filesystem>
+
+#include "Tools/MappedFile.hpp"
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+namespace
+{
+	constexpr size_t StripeSize = 64;
+	constexpr size_t LaneCount = StripeSize / sizeof(uint64_t);
+
+	// Stripes accumulated between two scrambles of the lanes
+	constexpr size_t StripesPerBlock = 16;
+
+	constexpr uint64_t Prime32_1 = 0x9E3779B1ull;
+	constexpr uint64_t Prime64_1 = 0x9E3779B185EBCA87ull;
+	constexpr uint64_t Prime64_2 = 0xC2B2AE3D27D4EB4Full;
+	constexpr uint64_t Prime64_3 = 0x165667B19E3779F9ull;
+	constexpr uint64_t Prime64_4 = 0x85EBCA77C2B2AE63ull;
+	constexpr uint64_t Prime64_5 = 0x27D4EB2F165667C5ull;
+
+	// Keys mixed with the stripes, one per lane and stripe of a block, then one for each scramble and fold
+	constexpr uint64_t Secret[LaneCount + StripesPerBlock + 4] = {
+		0xbe4ba423396cfeb8ull, 0x1cad21f72c81017cull, 0xdb979083e96dd4deull, 0x1f67b3b7a4a44072ull,
+		0x78e5c0cc4ee679cbull, 0x2172ffcc7dd05a82ull, 0x8e2443f7744608b8ull, 0x4c263a81e69035e0ull,
+		0xcb00c391bb52283cull, 0xa32e531b8b65d088ull, 0x4ef90da297486471ull, 0xd8acdea946ef1938ull,
+		0x3f349ce33f76faa8ull, 0x1d4f0bc7c7bbdcf9ull, 0x3159b4cd4be0518aull, 0x647378d9c97e9fc8ull,
+		0xc3ebd33483acc5eaull, 0xeb6313faffa081c5ull, 0x49daf0b751dd0d17ull, 0x9e68d429265516d3ull,
+		0xfca1477d58be162bull, 0xce31d07ad1b8f88full, 0x280416958f3acb45ull, 0x7e404bbbcafbd7afull,
+		0x81e8e1e4fd57e10cull, 0xa7b57ac4f63df1f6ull, 0x2e4d47bd5c8a1bb7ull, 0x3f3e4a4bc0ce4d0full,
+	};
+
+	uint64_t Read64(const unsigned char* data)
+	{
+		uint64_t value;
+		std::memcpy(&value, data, sizeof(value));
+		return value;
+	}
+
+	uint32_t Read32(const unsigned char* data)
+	{
+		uint32_t value;
+		std::memcpy(&value, data, sizeof(value));
+		return value;
+	}
+
+	uint64_t RotateLeft(uint64_t value, int bits)
+	{
+		return (value << bits) | (value >> (64 - bits));
+	}
+
+	/**
+	@brief 64x64 bits multiply, the high and low halves of the product are xored
+	*/
+	uint64_t MultiplyFold(uint64_t a, uint64_t b)
+	{
+#if defined(__SIZEOF_INT128__)
+		const __uint128_t product = static_cast<__uint128_t>(a) * b;
+		return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+		uint64_t high;
+		const uint64_t low = _umul128(a, b, &high);
+		return low ^ high;
+#else
+		const uint64_t aLow = a & 0xFFFFFFFF, aHigh = a >> 32;
+		const uint64_t bLow = b & 0xFFFFFFFF, bHigh = b >> 32;
+
+		const uint64_t lowLow = aLow * bLow;
+		const uint64_t highLow = aHigh * bLow;
+		const uint64_t lowHigh = aLow * bHigh;
+		const uint64_t highHigh = aHigh * bHigh;
+
+		const uint64_t cross = (lowLow >> 32) + (highLow & 0xFFFFFFFF) + lowHigh;
+		const uint64_t high = (highLow >> 32) + (cross >> 32) + highHigh;
+		const uint64_t low = (cross << 32) | (lowLow & 0xFFFFFFFF);
+		return low ^ high;
+#endif
+	}
+
+	uint64_t Avalanche(uint64_t hash)
+	{
+		hash ^= hash >> 37;
+		hash *= 0x165667919E3779F9ull;
+		hash ^= hash >> 32;
+		return hash;
+	}
+
+	uint64_t Mix16(const unsigned char* data, uint64_t key0, uint64_t key1, uint64_t seed)
+	{
+		return MultiplyFold(Read64(data) ^ (key0 + seed), Read64(data + 8) ^ (key1 - seed));
+	}
+
+	void AccumulateStripe(uint64_t* lanes, const unsigned char* stripe, size_t keyIndex)
+	{
+		for (size_t i = 0; i < LaneCount; ++i)
+		{
+			const uint64_t value = Read64(stripe + i * 8);
+			const uint64_t keyed = value ^ Secret[keyIndex + i];
+
+			// The raw value goes to the neighbour lane so that no input bit is lost by the multiply
+			lanes[i ^ 1] += value;
+			lanes[i] += (keyed & 0xFFFFFFFF) * (keyed >> 32);
+		}
+	}
+
+	void ScrambleLanes(uint64_t* lanes, uint64_t key)
+	{
+		for (size_t i = 0; i < LaneCount; ++i)
+		{
+			uint64_t lane = lanes[i];
+			lane ^= lane >> 47;
+			lane ^= key + Secret[i];
+			lanes[i] = lane * Prime32_1;
+		}
+	}
+
+	uint64_t MergeLanes(const uint64_t* lanes, uint64_t start, size_t keyIndex)
+	{
+		uint64_t result = start;
+		for (size_t i = 0; i < LaneCount; i += 2)
+			result += MultiplyFold(lanes[i] ^ Secret[keyIndex + i], lanes[i + 1] ^ Secret[keyIndex + i + 1]);
+
+		return Avalanche(result);
+	}
+
+	Hash128 HashShort(const unsigned char* data, size_t size, uint64_t seed)
+	{
+		// Up to 16 bytes, read as two possibly overlapping words
+		uint64_t first = 0, last = 0;
+		if (size >= 8)
+		{
+			first = Read64(data);
+			last = Read64(data + size - 8);
+		}
+		else if (size >= 4)
+		{
+			first = Read32(data);
+			last = Read32(data + size - 4);
+		}
+		else if (size > 0)
+		{
+			first = (static_cast<uint64_t>(data[0]) << 16) | (static_cast<uint64_t>(data[size >> 1]) << 8) | data[size - 1];
+			last = RotateLeft(first, 13);
+		}
+
+		const uint64_t low = MultiplyFold(first ^ (Secret[0] + seed), last ^ (Secret[1] - seed) ^ (size * Prime64_1));
+		const uint64_t high = MultiplyFold(last ^ (Secret[2] - seed), first ^ (Secret[3] + seed) ^ (size * Prime64_2));
+
+		return { Avalanche(low + size), Avalanche(high ^ low) };
+	}
+
+	Hash128 HashMedium(const unsigned char* data, size_t size, uint64_t seed)
+	{
+		// Up to 128 bytes, 16 bytes pairs read from both ends
+		uint64_t low = size * Prime64_1;
+		uint64_t high = 0;
+
+		const size_t pairCount = (size + 31) / 32;
+		for (size_t i = 0; i < pairCount; ++i)
+		{
+			const unsigned char* front = data + i * 16;
+			const unsigned char* back = data + size - 16 - i * 16;
+
+			low += Mix16(front, Secret[(4 * i) % 24], Secret[(4 * i + 1) % 24], seed);
+			low ^= Read64(back) + Read64(back + 8);
+			high += Mix16(back, Secret[(4 * i + 2) % 24], Secret[(4 * i + 3) % 24], seed);
+			high ^= Read64(front) + Read64(front + 8);
+		}
+
+		const uint64_t resultLow = low + high;
+		const uint64_t resultHigh = low * Prime64_1 + high * Prime64_4 + (size - seed) * Prime64_2;
+
+		return { Avalanche(resultLow), 0 - Avalanche(resultHigh) };
+	}
+
+	Hash128 HashLong(const unsigned char* data, size_t size, uint64_t seed)
+	{
+		uint64_t lanes[LaneCount] = { Prime32_1, Prime64_1, Prime64_2, Prime64_3, Prime64_4, Prime32_1 ^ seed, Prime64_5, Prime64_2 ^ seed };
+
+		constexpr size_t BlockSize = StripeSize * StripesPerBlock;
+		const size_t blockCount = (size - 1) / BlockSize;
+
+		for (size_t block = 0; block < blockCount; ++block)
+		{
+			const unsigned char* blockData = data + block * BlockSize;
+			for (size_t stripe = 0; stripe < StripesPerBlock; ++stripe)
+				AccumulateStripe(lanes, blockData + stripe * StripeSize, stripe);
+
+			ScrambleLanes(lanes, Secret[LaneCount + StripesPerBlock] + seed);
+		}
+
+		// Stripes of the last partial block, then the last 64 bytes, overlapping the previous stripes if needed
+		const unsigned char* lastBlock = data + blockCount * BlockSize;
+		const size_t stripeCount = (size - 1 - blockCount * BlockSize) / StripeSize;
+		for (size_t stripe = 0; stripe < stripeCount; ++stripe)
+			AccumulateStripe(lanes, lastBlock + stripe * StripeSize, stripe);
+
+		AccumulateStripe(lanes, data + size - StripeSize, StripesPerBlock - 1);
+
+		const uint64_t low = MergeLanes(lanes, size * Prime64_1, 3);
+		const uint64_t high = MergeLanes(lanes, ~(size * Prime64_2), 11);
+
+		return { low, high };
+	}
+}
+
+Hash128 ContentHash::Compute(const void* data, size_t size, uint64_t seed)
+{
+	const unsigned char* bytes = static_cast<const unsigned char*>(data);
+
+	if (size <= 16)
+		return HashShort(bytes, size, seed);
+
+	if (size <= 128)
+		return HashMedium(bytes, size, seed);
+
+	return HashLong(bytes, size, seed);
+}
+
+Hash128 ContentHash::Compute(const std::string& string, uint64_t seed)
+{
+	return Compute(string.data(), string.size(), seed);
+}
+
+uint64_t ContentHash::ComputeCheck(const void* data, size_t size, uint64_t seed)
+{
+	// One serial lane of rotate, xor and multiply : nothing is shared with the striped lanes of Compute
+	constexpr uint64_t Multiplier = 0x9FB21C651E98DF25ull;
+
+	const unsigned char* bytes = static_cast<const unsigned char*>(data);
+	uint64_t hash = seed ^ 0x243F6A8885A308D3ull;
+
+	size_t offset = 0;
+	for (; offset + sizeof(uint64_t) <= size; offset += sizeof(uint64_t))
+		hash = (RotateLeft(hash, 31) ^ Read64(bytes + offset)) * Multiplier;
+
+	if (offset < size)
+	{
+		uint64_t tail = 0;
+		std::memcpy(&tail, bytes + offset, size - offset);
+		hash = (RotateLeft(hash, 31) ^ tail) * Multiplier;
+	}
+
+	// Splitmix64 finalizer, with the size : contents ending with zeros differ from shorter ones
+	hash ^= static_cast<uint64_t>(size);
+	hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ull;
+	hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBull;
+	return hash ^ (hash >> 31);
+}
+
+bool ContentHash::ComputeFile(const std::string& path, Hash128& hash)
+{
+	MappedFile file;
+	if (file.Open(path))
+	{
+		hash = Compute(file.GetData(), file.GetSize());
+		return true;
+	}
+
+	// Empty files can't be mapped
+	std::error_code error;
+	if (std::filesystem::file_size(path, error) != 0 || error)
+		return false;
+
+	hash = Compute(nullptr, 0);
+	return true;
+}
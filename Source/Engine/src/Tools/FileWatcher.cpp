@@ -0,0 +1,625 @@
+#include "Tools/FileWatcher.hpp"
+
+#include <algorithm>
+#include <filesystem>
+
+#include "Core/Logger.hpp"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#elif defined(__linux__)
+#include <poll.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace
+{
+	// Longest wait of the backends, the watcher thread checks if it must stop and flushes the settled bursts in between
+	constexpr std::chrono::milliseconds WaitTimeout = std::chrono::milliseconds(50);
+
+	// Default time between two walks of the tree by the polling backend
+	constexpr std::chrono::milliseconds DefaultPollingInterval = std::chrono::milliseconds(1000);
+
+	// Size of the buffer the native backends read the events in
+	constexpr size_t EventBufferSize = 64 * 1024;
+}
+
+namespace
+{
+	/**
+	@brief Fallback backend : the tree is walked at a fixed interval and compared to the previous walk
+	*/
+	class PollingBackend : public FileWatcher::Backend
+	{
+		struct FileState
+		{
+			uintmax_t size = 0;
+			int64_t time = 0;
+		};
+
+		using FileStates = FlatHashMap<std::string, FileState, StringHelper::PathHash, StringHelper::PathEqual>;
+
+	private:
+		fs::path			m_rootPath;
+		FileWatcher::Filter m_filter;
+
+		FileStates m_files;
+		std::chrono::milliseconds m_interval;
+		FileWatcher::Clock::time_point m_nextWalk;
+		bool m_walked = false;
+
+	public:
+		PollingBackend(const std::string& rootPath, const FileWatcher::Filter& filter, std::chrono::milliseconds interval)
+			: m_rootPath(rootPath), m_filter(filter), m_interval(interval)
+		{
+
+		}
+
+	private:
+		void Walk(FileStates& files) const
+		{
+			std::error_code error;
+			for (fs::recursive_directory_iterator it(m_rootPath, fs::directory_options::skip_permission_denied, error), end; it != end; it.increment(error))
+			{
+				if (it->is_directory(error))
+					continue;
+
+				std::string path = it->path().string();
+				if (m_filter && !m_filter(path))
+					continue;
+
+				FileState state;
+				state.size = it->file_size(error);
+				state.time = static_cast<int64_t>(it->last_write_time(error).time_since_epoch().count());
+				files.try_emplace(std::move(path), state);
+			}
+		}
+
+	public:
+		void Wait(std::chrono::milliseconds timeout, std::vector<FileWatcher::Event>& events) override
+		{
+			FileWatcher::Clock::time_point now = FileWatcher::Clock::now();
+			if (m_walked && now < m_nextWalk)
+			{
+				std::this_thread::sleep_for(std::min<FileWatcher::Clock::duration>(timeout, m_nextWalk - now));
+				return;
+			}
+
+			FileStates files;
+			files.reserve(m_files.size());
+			Walk(files);
+
+			m_nextWalk = FileWatcher::Clock::now() + m_interval;
+
+			// The first walk is the reference of the next ones
+			if (!m_walked)
+			{
+				m_walked = true;
+				m_files = std::move(files);
+				return;
+			}
+
+			for (const auto& [path, state] : files)
+			{
+				auto it = m_files.find(path);
+				if (it == m_files.end())
+					events.push_back({ path, FileWatcher::EEvent::ADDED });
+				else if (it->second.size != state.size || it->second.time != state.time)
+					events.push_back({ path, FileWatcher::EEvent::MODIFIED });
+			}
+
+			for (const auto& [path, state] : m_files)
+			{
+				if (!files.contains(path))
+					events.push_back({ path, FileWatcher::EEvent::REMOVED });
+			}
+
+			m_files = std::move(files);
+		}
+	};
+
+#ifdef _WIN32
+
+	/**
+	@brief Windows backend : one overlapped ReadDirectoryChangesW on the root, watching its whole tree
+	*/
+	class WindowsBackend : public FileWatcher::Backend
+	{
+	private:
+		fs::path	m_rootPath;
+		HANDLE		m_directory = INVALID_HANDLE_VALUE;
+		OVERLAPPED	m_overlapped = {};
+		bool		m_reading = false;
+
+		// DWORD aligned, as required by ReadDirectoryChangesW
+		std::vector<DWORD> m_buffer = std::vector<DWORD>(EventBufferSize / sizeof(DWORD));
+
+	public:
+		~WindowsBackend() override
+		{
+			if (m_reading)
+			{
+				DWORD bytes = 0;
+				CancelIoEx(m_directory, &m_overlapped);
+				GetOverlappedResult(m_directory, &m_overlapped, &bytes, TRUE);
+			}
+
+			if (m_directory != INVALID_HANDLE_VALUE)
+				CloseHandle(m_directory);
+
+			if (m_overlapped.hEvent != nullptr)
+				CloseHandle(m_overlapped.hEvent);
+		}
+
+	private:
+		bool Read()
+		{
+			ResetEvent(m_overlapped.hEvent);
+
+			constexpr DWORD notifyFilter = FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME | FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE;
+			m_reading = ReadDirectoryChangesW(m_directory, m_buffer.data(), static_cast<DWORD>(m_buffer.size() * sizeof(DWORD)), TRUE, notifyFilter, nullptr, &m_overlapped, nullptr);
+			return m_reading;
+		}
+
+	public:
+		bool Open(const std::string& rootPath)
+		{
+			m_rootPath = rootPath;
+			m_directory = CreateFileW(m_rootPath.wstring().c_str(), FILE_LIST_DIRECTORY, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+				nullptr, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+			if (m_directory == INVALID_HANDLE_VALUE)
+				return false;
+
+			m_overlapped.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+			return m_overlapped.hEvent != nullptr && Read();
+		}
+
+		void Wait(std::chrono::milliseconds timeout, std::vector<FileWatcher::Event>& events) override
+		{
+			if (WaitForSingleObject(m_overlapped.hEvent, static_cast<DWORD>(timeout.count())) != WAIT_OBJECT_0)
+				return;
+
+			DWORD bytes = 0;
+			m_reading = false;
+
+			// No bytes : the events did not fit in the buffer and were dropped
+			if (!GetOverlappedResult(m_directory, &m_overlapped, &bytes, FALSE) || bytes == 0)
+			{
+				events.push_back({ m_rootPath.string(), FileWatcher::EEvent::RESCAN });
+				Read();
+				return;
+			}
+
+			const unsigned char* data = reinterpret_cast<const unsigned char*>(m_buffer.data());
+			for (;;)
+			{
+				const FILE_NOTIFY_INFORMATION* info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(data);
+				std::wstring name(info->FileName, info->FileNameLength / sizeof(WCHAR));
+				std::string path = (m_rootPath / name).string();
+
+				switch (info->Action)
+				{
+				case FILE_ACTION_ADDED:
+				case FILE_ACTION_RENAMED_NEW_NAME:
+					events.push_back({ std::move(path), FileWatcher::EEvent::ADDED });
+					break;
+				case FILE_ACTION_REMOVED:
+				case FILE_ACTION_RENAMED_OLD_NAME:
+					events.push_back({ std::move(path), FileWatcher::EEvent::REMOVED });
+					break;
+				case FILE_ACTION_MODIFIED:
+					events.push_back({ std::move(path), FileWatcher::EEvent::MODIFIED });
+					break;
+				default:
+					break;
+				}
+
+				if (info->NextEntryOffset == 0)
+					break;
+
+				data += info->NextEntryOffset;
+			}
+
+			// Read again right away, the changes made until then are queued by the system
+			if (!Read())
+				events.push_back({ m_rootPath.string(), FileWatcher::EEvent::RESCAN });
+		}
+	};
+
+	std::unique_ptr<FileWatcher::Backend> CreateNativeBackend(const std::string& rootPath)
+	{
+		std::unique_ptr<WindowsBackend> backend = std::make_unique<WindowsBackend>();
+		if (!backend->Open(rootPath))
+			return nullptr;
+
+		return backend;
+	}
+
+#elif defined(__linux__)
+
+	/**
+	@brief Linux backend : inotify does not watch sub directories, each directory of the tree has its own watch
+	*/
+	class InotifyBackend : public FileWatcher::Backend
+	{
+	private:
+		fs::path m_rootPath;
+		int		 m_descriptor = -1;
+
+		FlatHashMap<int, std::string> m_directories;
+
+		// Aligned for the inotify_event structures read in it
+		std::vector<uint64_t> m_buffer = std::vector<uint64_t>(EventBufferSize / sizeof(uint64_t));
+
+	public:
+		~InotifyBackend() override
+		{
+			if (m_descriptor >= 0)
+				close(m_descriptor);
+		}
+
+	private:
+		bool WatchDirectory(const fs::path& directory)
+		{
+			constexpr uint32_t mask = IN_CREATE | IN_DELETE | IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR;
+
+			const int watch = inotify_add_watch(m_descriptor, directory.c_str(), mask);
+			if (watch < 0)
+				return false;
+
+			// A directory moved in the tree keeps its watch, only its path changes
+			m_directories[watch] = directory.string();
+			return true;
+		}
+
+		bool WatchTree(const fs::path& directory)
+		{
+			if (!WatchDirectory(directory))
+				return false;
+
+			std::error_code error;
+			for (fs::recursive_directory_iterator it(directory, fs::directory_options::skip_permission_denied, error), end; it != end; it.increment(error))
+			{
+				if (it->is_directory(error) && !WatchDirectory(it->path()))
+					Logger::Warning("FileWatcher - Can't watch " + it->path().string());
+			}
+
+			return true;
+		}
+
+		void UnwatchTree(const std::string& directory)
+		{
+			std::vector<int> watches;
+			for (const auto& [watch, path] : m_directories)
+			{
+				if (path.size() >= directory.size() && path.compare(0, directory.size(), directory) == 0
+					&& (path.size() == directory.size() || path[directory.size()] == fs::path::preferred_separator))
+					watches.push_back(watch);
+			}
+
+			for (int watch : watches)
+			{
+				inotify_rm_watch(m_descriptor, watch);
+				m_directories.erase(watch);
+			}
+		}
+
+	public:
+		bool Open(const std::string& rootPath)
+		{
+			m_rootPath = rootPath;
+			m_descriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+			return m_descriptor >= 0 && WatchTree(m_rootPath);
+		}
+
+		void Wait(std::chrono::milliseconds timeout, std::vector<FileWatcher::Event>& events) override
+		{
+			pollfd descriptor = { m_descriptor, POLLIN, 0 };
+			if (poll(&descriptor, 1, static_cast<int>(timeout.count())) <= 0)
+				return;
+
+			for (;;)
+			{
+				const ssize_t size = read(m_descriptor, m_buffer.data(), m_buffer.size() * sizeof(uint64_t));
+				if (size <= 0)
+					return;
+
+				const unsigned char* data = reinterpret_cast<const unsigned char*>(m_buffer.data());
+				for (ssize_t offset = 0; offset < size; )
+				{
+					const inotify_event* event = reinterpret_cast<const inotify_event*>(data + offset);
+					offset += sizeof(inotify_event) + event->len;
+
+					if (event->mask & IN_Q_OVERFLOW)
+					{
+						events.push_back({ m_rootPath.string(), FileWatcher::EEvent::RESCAN });
+						continue;
+					}
+
+					auto directory = m_directories.find(event->wd);
+					if (directory == m_directories.end())
+						continue;
+
+					if (event->mask & IN_IGNORED)
+					{
+						m_directories.erase(event->wd);
+						continue;
+					}
+
+					// Events of the watched directory itself
+					if (event->len == 0)
+						continue;
+
+					std::string path = (fs::path(directory->second) / event->name).string();
+
+					if (event->mask & (IN_CREATE | IN_MOVED_TO))
+					{
+						if ((event->mask & IN_ISDIR) && !WatchTree(path))
+							Logger::Warning("FileWatcher - Can't watch " + path);
+
+						events.push_back({ std::move(path), FileWatcher::EEvent::ADDED });
+					}
+					else if (event->mask & (IN_DELETE | IN_MOVED_FROM))
+					{
+						if (event->mask & IN_ISDIR)
+							UnwatchTree(path);
+
+						events.push_back({ std::move(path), FileWatcher::EEvent::REMOVED });
+					}
+					else if (!(event->mask & IN_ISDIR))
+					{
+						events.push_back({ std::move(path), FileWatcher::EEvent::MODIFIED });
+					}
+				}
+			}
+		}
+	};
+
+	std::unique_ptr<FileWatcher::Backend> CreateNativeBackend(const std::string& rootPath)
+	{
+		std::unique_ptr<InotifyBackend> backend = std::make_unique<InotifyBackend>();
+		if (!backend->Open(rootPath))
+			return nullptr;
+
+		return backend;
+	}
+
+#else
+
+	std::unique_ptr<FileWatcher::Backend> CreateNativeBackend(const std::string& rootPath)
+	{
+		return nullptr;
+	}
+
+#endif
+}
+
+FileWatcher::FileWatcher(const std::string& rootPath, const Filter& filter, std::chrono::milliseconds debounceDelay, std::chrono::milliseconds maxLatency)
+	: m_rootPath(rootPath), m_filter(filter), m_debounceDelay(debounceDelay), m_maxLatency(maxLatency), m_pollingInterval(DefaultPollingInterval)
+{
+
+}
+
+FileWatcher::~FileWatcher()
+{
+	Stop();
+}
+
+void FileWatcher::Run()
+{
+	std::vector<Event> events;
+
+	while (m_running)
+	{
+		events.clear();
+		m_backend->Wait(WaitTimeout, events);
+
+		Clock::time_point now = Clock::now();
+		for (const Event& event : events)
+		{
+			if (event.type == EEvent::RESCAN)
+			{
+				if (m_pending.empty() && !m_rescanPending)
+					m_burstStart = now;
+
+				m_pending.clear();
+				m_rescanPending = true;
+				m_lastEvent = now;
+				continue;
+			}
+
+			// Removed paths can't be checked anymore, they may be directories
+			if (event.type != EEvent::REMOVED)
+			{
+				std::error_code error;
+				if (fs::is_directory(event.path, error))
+				{
+					if (event.type == EEvent::ADDED)
+						AddDirectory(event.path, now);
+
+					continue;
+				}
+
+				if (m_filter && !m_filter(event.path))
+					continue;
+			}
+
+			AddEvent(event.path, event.type, now);
+		}
+
+		FlushSettledEvents(now);
+	}
+}
+
+void FileWatcher::AddEvent(const std::string& path, EEvent type, Clock::time_point now)
+{
+	// The whole tree is checked again
+	if (m_rescanPending)
+		return;
+
+	if (m_pending.empty())
+		m_burstStart = now;
+
+	m_lastEvent = now;
+
+	auto [it, inserted] = m_pending.try_emplace(path, type);
+	if (inserted)
+		return;
+
+	// The state of the file before the burst decides of the merged event
+	switch (it->second)
+	{
+	case EEvent::ADDED:
+		// Created then deleted during the burst, like the temporary files of the saves
+		if (type == EEvent::REMOVED)
+			m_pending.erase(path);
+		break;
+
+	case EEvent::REMOVED:
+		// Deleted then written again : the file is replaced
+		if (type != EEvent::REMOVED)
+			it->second = EEvent::MODIFIED;
+		break;
+
+	default:
+		it->second = type == EEvent::REMOVED ? EEvent::REMOVED : EEvent::MODIFIED;
+		break;
+	}
+}
+
+void FileWatcher::AddDirectory(const std::string& path, Clock::time_point now)
+{
+	std::error_code error;
+	for (fs::recursive_directory_iterator it(path, fs::directory_options::skip_permission_denied, error), end; it != end; it.increment(error))
+	{
+		if (it->is_directory(error))
+			continue;
+
+		std::string filePath = it->path().string();
+		if (!m_filter || m_filter(filePath))
+			AddEvent(filePath, EEvent::ADDED, now);
+	}
+}
+
+void FileWatcher::FlushSettledEvents(Clock::time_point now)
+{
+	if (m_pending.empty() && !m_rescanPending)
+		return;
+
+	if (now - m_lastEvent < m_debounceDelay && now - m_burstStart < m_maxLatency)
+		return;
+
+	std::vector<Event> burst;
+	if (m_rescanPending)
+	{
+		burst.push_back({ m_rootPath, EEvent::RESCAN });
+	}
+	else
+	{
+		burst.reserve(m_pending.size());
+		for (const auto& [path, type] : m_pending)
+			burst.push_back({ path, type });
+
+		std::sort(burst.begin(), burst.end(), [](const Event& a, const Event& b) { return a.path < b.path; });
+	}
+
+	m_pending.clear();
+	m_rescanPending = false;
+
+	std::lock_guard guard(m_readyMutex);
+
+	// Nothing is added after a rescan, it covers the whole tree
+	if (!m_ready.empty() && m_ready.front().type == EEvent::RESCAN)
+		return;
+
+	if (burst.front().type == EEvent::RESCAN)
+		m_ready.clear();
+
+	m_ready.insert(m_ready.end(), std::make_move_iterator(burst.begin()), std::make_move_iterator(burst.end()));
+}
+
+bool FileWatcher::Start(bool forcePolling)
+{
+	if (m_running)
+		return true;
+
+	std::error_code error;
+	if (!fs::is_directory(m_rootPath, error))
+	{
+		Logger::Warning("FileWatcher - Can't watch " + m_rootPath + ", it is not a directory");
+		return false;
+	}
+
+	std::unique_ptr<Backend> backend = forcePolling ? nullptr : CreateNativeBackend(m_rootPath);
+	const bool polling = backend == nullptr;
+
+	if (polling)
+	{
+		if (!forcePolling)
+			Logger::Warning("FileWatcher - No file events for " + m_rootPath + ", the directory is polled");
+
+		backend = std::make_unique<PollingBackend>(m_rootPath, m_filter, m_pollingInterval);
+	}
+
+	Start(std::move(backend));
+	m_polling = polling;
+	return true;
+}
+
+bool FileWatcher::Start(std::unique_ptr<Backend> backend)
+{
+	if (m_running)
+		return true;
+
+	if (!backend)
+		return false;
+
+	m_backend = std::move(backend);
+	m_polling = false;
+
+	m_running = true;
+	m_thread = std::thread(&FileWatcher::Run, this);
+	return true;
+}
+
+void FileWatcher::Stop()
+{
+	if (!m_running)
+		return;
+
+	m_running = false;
+	m_thread.join();
+
+	m_backend.reset();
+	m_pending.clear();
+	m_rescanPending = false;
+}
+
+bool FileWatcher::IsRunning() const
+{
+	return m_running;
+}
+
+bool FileWatcher::IsPolling() const
+{
+	return m_polling;
+}
+
+void FileWatcher::SetPollingInterval(std::chrono::milliseconds interval)
+{
+	m_pollingInterval = interval;
+}
+
+bool FileWatcher::PollEvents(std::vector<Event>& events)
+{
+	events.clear();
+
+	std::lock_guard guard(m_readyMutex);
+	events.swap(m_ready);
+	return !events.empty();
+}
@@ -1,6 +1,105 @@
 #include "Types/GUID.hpp"
 
-#include <combaseapi.h>
+#include <random>
+#include <atomic>
+#include <cstring>
+#include <cstdint>
+
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HY_GUID_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+	// Length of "xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx"
+	constexpr size_t GUIDStringLength = 36;
+	constexpr size_t GUIDHexLength = 32;
+
+	uint64_t RotateLeft(uint64_t value, int shift)
+	{
+		return (value << shift) | (value >> (64 - shift));
+	}
+
+	uint64_t SplitMix64(uint64_t& state)
+	{
+		uint64_t value = (state += 0x9E3779B97F4A7C15ull);
+		value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+		value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+		return value ^ (value >> 31);
+	}
+
+	/**
+	@brief xoshiro256** generator, one instance per thread so no lock is needed
+	*/
+	class GUIDGenerator
+	{
+	private:
+		uint64_t m_state[4];
+
+	public:
+		GUIDGenerator()
+		{
+			// Entropy is asked once to the OS, each thread then derives its own stream from it
+			static uint64_t processSeed = []() {
+				std::random_device device;
+				return (static_cast<uint64_t>(device()) << 32) ^ device();
+			}();
+			static std::atomic<uint64_t> threadCounter = 0;
+
+			uint64_t seed = processSeed ^ (threadCounter.fetch_add(1) * 0xD1B54A32D192ED03ull);
+			for (uint64_t& state : m_state)
+				state = SplitMix64(seed);
+		}
+
+		uint64_t Next()
+		{
+			const uint64_t result = RotateLeft(m_state[1] * 5, 7) * 9;
+			const uint64_t t = m_state[1] << 17;
+
+			m_state[2] ^= m_state[0];
+			m_state[3] ^= m_state[1];
+			m_state[1] ^= m_state[2];
+			m_state[0] ^= m_state[3];
+			m_state[2] ^= t;
+			m_state[3] = RotateLeft(m_state[3], 45);
+
+			return result;
+		}
+
+		/**
+		@brief Fill 16 bytes with a RFC 4122 version 4 (random) GUID
+		*/
+		void Generate(std::array<unsigned char, 16>& bytes)
+		{
+			const uint64_t low = Next();
+			const uint64_t high = Next();
+			std::memcpy(bytes.data(), &low, sizeof(uint64_t));
+			std::memcpy(bytes.data() + sizeof(uint64_t), &high, sizeof(uint64_t));
+
+			bytes[6] = static_cast<unsigned char>((bytes[6] & 0x0F) | 0x40);	// Version 4
+			bytes[8] = static_cast<unsigned char>((bytes[8] & 0x3F) | 0x80);	// Variant 1
+		}
+	};
+
+	GUIDGenerator& GetThreadGenerator()
+	{
+		thread_local GUIDGenerator generator;
+		return generator;
+	}
+
+	/**
+	@brief Parse 32 hex characters into 16 bytes
+
+	@return bool : false if a character is not an hex digit
+	*/
+	bool ParseHex32(const char* hex, unsigned char* bytes);
+
+	/**
+	@brief Write 16 bytes as 32 lower case hex characters
+	*/
+	void FormatHex32(const unsigned char* bytes, char* hex);
+}
 
 
 HYGUID::HYGUID()
@@ -51,8 +150,129 @@ unsigned char hexPairToChar(char a, char b)
 	return hexDigitToChar(a) * 16 + hexDigitToChar(b);
 }
 
+namespace
+{
+#ifdef HY_GUID_SSE2
+
+	/**
+	@brief Convert 16 hex characters to 16 nibbles, mask is 0xFFFF if all characters are valid
+	*/
+	__m128i HexToNibbles(__m128i chars, int& validMask)
+	{
+		const __m128i lower = _mm_or_si128(chars, _mm_set1_epi8(0x20));
+
+		const __m128i isDigit = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(chars, _mm_set1_epi8('9' + 1)));
+		const __m128i isAlpha = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(lower, _mm_set1_epi8('f' + 1)));
+
+		validMask = _mm_movemask_epi8(_mm_or_si128(isDigit, isAlpha));
+
+		const __m128i digits = _mm_and_si128(isDigit, _mm_sub_epi8(chars, _mm_set1_epi8('0')));
+		const __m128i alphas = _mm_and_si128(isAlpha, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10)));
+		return _mm_or_si128(digits, alphas);
+	}
+
+	/**
+	@brief Pack pairs of nibbles (high first) of two vectors into 16 bytes
+	*/
+	__m128i PackNibbles(__m128i first, __m128i second)
+	{
+		// Each 16 bits lane holds (high nibble | low nibble << 8)
+		const __m128i lowByte = _mm_set1_epi16(0x00FF);
+
+		const __m128i firstBytes = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(first, lowByte), 4), _mm_srli_epi16(first, 8));
+		const __m128i secondBytes = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(second, lowByte), 4), _mm_srli_epi16(second, 8));
+
+		return _mm_packus_epi16(firstBytes, secondBytes);
+	}
+
+	bool ParseHex32(const char* hex, unsigned char* bytes)
+	{
+		int firstValid = 0, secondValid = 0;
+		const __m128i first = HexToNibbles(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hex)), firstValid);
+		const __m128i second = HexToNibbles(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hex + 16)), secondValid);
+
+		if ((firstValid & secondValid) != 0xFFFF)
+			return false;
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(bytes), PackNibbles(first, second));
+		return true;
+	}
+
+	void FormatHex32(const unsigned char* bytes, char* hex)
+	{
+		const __m128i nibbleMask = _mm_set1_epi8(0x0F);
+		const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes));
+
+		const __m128i high = _mm_and_si128(_mm_srli_epi16(input, 4), nibbleMask);
+		const __m128i low = _mm_and_si128(input, nibbleMask);
+
+		// Interleave to get nibbles in reading order
+		const __m128i nibbles[2] = { _mm_unpacklo_epi8(high, low), _mm_unpackhi_epi8(high, low) };
+
+		for (int i = 0; i < 2; ++i)
+		{
+			// '0' + n for digits, 'a' + n - 10 for letters
+			const __m128i letterOffset = _mm_and_si128(_mm_cmpgt_epi8(nibbles[i], _mm_set1_epi8(9)), _mm_set1_epi8('a' - '0' - 10));
+			const __m128i chars = _mm_add_epi8(_mm_add_epi8(nibbles[i], _mm_set1_epi8('0')), letterOffset);
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(hex + i * 16), chars);
+		}
+	}
+
+#else
+
+	bool ParseHex32(const char* hex, unsigned char* bytes)
+	{
+		for (size_t i = 0; i < GUIDHexLength; i += 2)
+		{
+			if (!isValidHexChar(hex[i]) || !isValidHexChar(hex[i + 1]))
+				return false;
+
+			bytes[i / 2] = hexPairToChar(hex[i], hex[i + 1]);
+		}
+
+		return true;
+	}
+
+	void FormatHex32(const unsigned char* bytes, char* hex)
+	{
+		constexpr char digits[] = "0123456789abcdef";
+
+		for (size_t i = 0; i < 16; ++i)
+		{
+			hex[i * 2] = digits[bytes[i] >> 4];
+			hex[i * 2 + 1] = digits[bytes[i] & 0x0F];
+		}
+	}
+
+#endif
+}
+
 HYGUID::HYGUID(const std::string_view& string)
 {
+	// Fast path for the canonical form used in json keys and .meta files
+	if (string.size() == GUIDStringLength && string[8] == '-' && string[13] == '-' && string[18] == '-' && string[23] == '-')
+	{
+		char hex[GUIDHexLength];
+		std::memcpy(hex, string.data(), 8);
+		std::memcpy(hex + 8, string.data() + 9, 4);
+		std::memcpy(hex + 12, string.data() + 14, 4);
+		std::memcpy(hex + 16, string.data() + 19, 4);
+		std::memcpy(hex + 20, string.data() + 24, 12);
+
+		if (!ParseHex32(hex, m_bytes.data()))
+			ResetToZero();
+		return;
+	}
+
+	if (string.size() == GUIDHexLength)
+	{
+		if (!ParseHex32(string.data(), m_bytes.data()))
+			ResetToZero();
+		return;
+	}
+
+	// Generic form, dashes can be anywhere
 	char charOne = '\0';
 	char charTwo = '\0';
 
@@ -102,36 +322,18 @@ void HYGUID::ResetToZero()
 
 HYGUID HYGUID::NewGUID()
 {
-	GUID newID;
-	HRESULT result = CoCreateGuid(&newID);
+	HYGUID guid;
+	GetThreadGenerator().Generate(guid.m_bytes);
 
-	if (result != S_OK)
-		return NewGUID();
+	return guid;
+}
 
-	std::array<unsigned char, 16> bytes =
-	{
-		static_cast<unsigned char>((newID.Data1 >> 24) & 0xFF),
-		static_cast<unsigned char>((newID.Data1 >> 16) & 0xFF),
-		static_cast<unsigned char>((newID.Data1 >> 8) & 0xFF),
-		static_cast<unsigned char>((newID.Data1) & 0xff),
-
-		static_cast<unsigned char>((newID.Data2 >> 8) & 0xFF),
-		static_cast<unsigned char>((newID.Data2) & 0xff),
-
-		static_cast<unsigned char>((newID.Data3 >> 8) & 0xFF),
-		static_cast<unsigned char>((newID.Data3) & 0xFF),
-
-		static_cast<unsigned char>(newID.Data4[0]),
-		static_cast<unsigned char>(newID.Data4[1]),
-		static_cast<unsigned char>(newID.Data4[2]),
-		static_cast<unsigned char>(newID.Data4[3]),
-		static_cast<unsigned char>(newID.Data4[4]),
-		static_cast<unsigned char>(newID.Data4[5]),
-		static_cast<unsigned char>(newID.Data4[6]),
-		static_cast<unsigned char>(newID.Data4[7])
-	};
+void HYGUID::NewMany(std::span<HYGUID> guids)
+{
+	GUIDGenerator& generator = GetThreadGenerator();
 
-	return HYGUID{ std::move(bytes) };
+	for (HYGUID& guid : guids)
+		generator.Generate(guid.m_bytes);
 }
 
 const std::array<unsigned char, 16>& HYGUID::Bytes() const
@@ -142,26 +344,16 @@ const std::array<unsigned char, 16>& HYGUID::Bytes() const
 
 std::string HYGUID::ToString() const
 {
-	char one[10], two[6], three[6], four[6], five[14];
-
-	snprintf(one, 10, "%02x%02x%02x%02x",
-		m_bytes[0], m_bytes[1], m_bytes[2], m_bytes[3]);
-	snprintf(two, 6, "%02x%02x",
-		m_bytes[4], m_bytes[5]);
-	snprintf(three, 6, "%02x%02x",
-		m_bytes[6], m_bytes[7]);
-	snprintf(four, 6, "%02x%02x",
-		m_bytes[8], m_bytes[9]);
-	snprintf(five, 14, "%02x%02x%02x%02x%02x%02x",
-		m_bytes[10], m_bytes[11], m_bytes[12], m_bytes[13], m_bytes[14], m_bytes[15]);
-
-	const std::string sep("-");
-	std::string out(one);
-
-	out += sep + two;
-	out += sep + three;
-	out += sep + four;
-	out += sep + five;
+	char hex[GUIDHexLength];
+	FormatHex32(m_bytes.data(), hex);
+
+	// 8-4-4-4-12 groups
+	std::string out(GUIDStringLength, '-');
+	std::memcpy(out.data(), hex, 8);
+	std::memcpy(out.data() + 9, hex + 8, 4);
+	std::memcpy(out.data() + 14, hex + 12, 4);
+	std::memcpy(out.data() + 19, hex + 16, 4);
+	std::memcpy(out.data() + 24, hex + 20, 12);
 
 	return out;
 }
@@ -0,0 +1,206 @@
+#pragma once
+
+#include <string>
+#include <chrono>
+#include <filesystem>
+#include <cstddef>
+#include <algorithm>
+#include <limits>
+
+/**
+@brief Minimal headless test and benchmark runner of the engine.
+Tests and benchmarks are registered by the TEST_CASE and BENCHMARK macros and run by the Tests executable :
+	Tests.exe					run every test
+	Tests.exe --bench			run every benchmark
+	Tests.exe [--bench] name	only run the tests (or benchmarks) whose name contains "name"
+*/
+namespace Tests
+{
+	using CaseFunction = void(*)();
+
+	/**
+	@brief Register a test, called by the TEST_CASE macro
+
+	@param name : Name of the test
+	@param function : Body of the test
+	@return bool : Always true, used to register at static initialization
+	*/
+	bool RegisterTest(const char* name, CaseFunction function);
+
+	/**
+	@brief Register a benchmark, called by the BENCHMARK macro
+
+	@param name : Name of the benchmark
+	@param function : Body of the benchmark
+	@return bool : Always true, used to register at static initialization
+	*/
+	bool RegisterBenchmark(const char* name, CaseFunction function);
+
+	/**
+	@brief Mark the running test as failed
+
+	@param expression : Failed expression
+	@param file : Source file of the check
+	@param line : Source line of the check
+	*/
+	void ReportFailure(const char* expression, const char* file, int line);
+
+	/**
+	@brief Print a benchmark result
+
+	@param label : Measured operation
+	@param nanoseconds : Time of one operation
+	@param note : Extra information printed after the time
+	*/
+	void Report(const std::string& label, double nanoseconds, const std::string& note = "");
+
+	/**
+	@brief Run the registered tests or benchmarks selected by the command line
+
+	@return int : Failed test count
+	*/
+	int Run(int argc, char** argv);
+
+	/**
+	@brief Warnings and errors logged since the last ResetLogCounters call, Logger is replaced by the Tests executable
+	*/
+	struct LogCounters
+	{
+		size_t warnings = 0;
+		size_t errors = 0;
+	};
+
+	LogCounters GetLogCounters();
+	void ResetLogCounters();
+
+	/**
+	@brief Directory created empty in the temporary folder of the system and removed with its content on destruction
+	*/
+	class TemporaryDirectory
+	{
+	private:
+		std::filesystem::path m_path;
+
+	public:
+		/**
+		@param name : Name of the directory, a unique suffix is added
+		*/
+		TemporaryDirectory(const std::string& name);
+		~TemporaryDirectory();
+
+		TemporaryDirectory(const TemporaryDirectory&) = delete;
+		TemporaryDirectory& operator=(const TemporaryDirectory&) = delete;
+
+		const std::filesystem::path& Path() const;
+
+		/**
+		@brief Write a file under the directory, its parent directories are created
+
+		@param relativePath : Path of the file in the directory
+		@param content : Content of the file
+		@return std::filesystem::path : Full path of the file
+		*/
+		std::filesystem::path WriteFile(const std::string& relativePath, const std::string& content) const;
+	};
+
+	/**
+	@brief Keep a value alive so the optimizer does not drop a measured computation
+	*/
+	template <typename T>
+	inline void DoNotOptimize(const T& value)
+	{
+		static volatile const void* sink = nullptr;
+		sink = &value;
+		static_cast<void>(sink);
+	}
+
+	/**
+	@brief Time a function, the best of several samples is kept to ignore scheduling noise
+
+	@param function : Function to time, called once per sample
+	@param operationCount : Operations done by one call of the function
+	@param samples : Sample count
+	@return double : Nanoseconds per operation
+	*/
+	template <typename TFunction>
+	inline double Measure(TFunction&& function, size_t operationCount = 1, int samples = 5)
+	{
+		double best = std::numeric_limits<double>::max();
+
+		for (int i = 0; i < samples; ++i)
+		{
+			auto start = std::chrono::steady_clock::now();
+			function();
+			std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+			best = std::min(best, elapsed.count());
+		}
+
+		return best / static_cast<double>(std::max<size_t>(operationCount, 1));
+	}
+
+	/**
+	@brief Time a function with a setup run before each sample, the setup is not timed
+
+	@param setup : Function preparing the sample
+	@param function : Function to time, called once per sample after the setup
+	@param operationCount : Operations done by one call of the function
+	@param samples : Sample count
+	@return double : Nanoseconds per operation
+	*/
+	template <typename TSetup, typename TFunction>
+	inline double MeasureWithSetup(TSetup&& setup, TFunction&& function, size_t operationCount = 1, int samples = 5)
+	{
+		double best = std::numeric_limits<double>::max();
+
+		for (int i = 0; i < samples; ++i)
+		{
+			setup();
+
+			auto start = std::chrono::steady_clock::now();
+			function();
+			std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+			best = std::min(best, elapsed.count());
+		}
+
+		return best / static_cast<double>(std::max<size_t>(operationCount, 1));
+	}
+}
+
+#define HY_TESTS_CONCAT_IMPL(a, b) a##b
+#define HY_TESTS_CONCAT(a, b) HY_TESTS_CONCAT_IMPL(a, b)
+
+#define HY_TESTS_REGISTER(registerFunction, name)																		\
+	static void HY_TESTS_CONCAT(TestCase_, __LINE__)();																	\
+	static const bool HY_TESTS_CONCAT(TestCaseRegistered_, __LINE__) =													\
+		Tests::registerFunction(name, &HY_TESTS_CONCAT(TestCase_, __LINE__));											\
+	static void HY_TESTS_CONCAT(TestCase_, __LINE__)()
+
+/**
+@brief Define a test, checks failing in its body fail the test
+*/
+#define TEST_CASE(name) HY_TESTS_REGISTER(RegisterTest, name)
+
+/**
+@brief Define a benchmark, only run with --bench
+*/
+#define BENCHMARK(name) HY_TESTS_REGISTER(RegisterBenchmark, name)
+
+/**
+@brief Fail the test if the expression is false, the test goes on
+*/
+#define CHECK(expression) ((expression) ? static_cast<void>(0) : Tests::ReportFailure(#expression, __FILE__, __LINE__))
+
+/**
+@brief Fail the test and leave it if the expression is false
+*/
+#define REQUIRE(expression)																								\
+	do																													\
+	{																													\
+		if (!(expression))																								\
+		{																												\
+			Tests::ReportFailure(#expression, __FILE__, __LINE__);														\
+			return;																										\
+		}																												\
+	} while (false)
@@ -0,0 +1,28 @@
+#pragma once
+
+struct GLFWwindow;
+
+namespace Tests
+{
+	/**
+	@brief Hidden window whose OpenGL 4.5 context is current while it lives, for the benchmarks of GL calls.
+	No profile is asked for, as the editor window : the compatibility context allows the client side arrays of the old draw paths.
+	*/
+	class GLContext
+	{
+	private:
+		GLFWwindow* m_window = nullptr;
+
+	public:
+		GLContext();
+		~GLContext();
+
+		GLContext(const GLContext&) = delete;
+		GLContext& operator=(const GLContext&) = delete;
+
+		/**
+		@brief Get if the context was created, the GL benchmarks are skipped without it
+		*/
+		bool IsValid() const;
+	};
+}
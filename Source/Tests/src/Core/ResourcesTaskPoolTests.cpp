@@ -0,0 +1,83 @@
+#include "TestFramework.hpp"
+
+#include <atomic>
+#include <vector>
+#include <numeric>
+
+#include "Core/ResourcesTaskPool.hpp"
+
+TEST_CASE("ResourcesTaskPool - ParallelFor visits every index once")
+{
+	ResourcesTaskPool pool;
+
+	for (size_t count : { 0, 1, 7, 1000, 100003 })
+	{
+		for (size_t chunkSize : { 0, 1, 16, 1000 })
+		{
+			//	Too many chunks of one element on the big range, it only tests the chunking
+			if (chunkSize <= 1 && count > 1000)
+				continue;
+
+			std::vector<std::atomic<int>> visits(count);
+			pool.ParallelFor(count, chunkSize, [&visits](size_t begin, size_t end) {
+				for (size_t i = begin; i < end; ++i)
+					visits[i]++;
+				});
+
+			bool once = true;
+			for (const std::atomic<int>& visit : visits)
+				once &= visit.load() == 1;
+
+			CHECK(once);
+		}
+	}
+}
+
+TEST_CASE("ResourcesTaskPool - ParallelFor called from its own tasks completes")
+{
+	ResourcesTaskPool pool;
+
+	//	Every worker runs an outer chunk which waits for an inner ParallelFor : the inner calls must not wait for the pool
+	std::vector<uint64_t> sums(64, 0);
+	pool.ParallelFor(sums.size(), 1, [&pool, &sums](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i)
+		{
+			std::atomic<uint64_t> sum = 0;
+			pool.ParallelFor(1000, 10, [&sum](size_t innerBegin, size_t innerEnd) {
+				uint64_t chunkSum = 0;
+				for (size_t j = innerBegin; j < innerEnd; ++j)
+					chunkSum += j;
+				sum += chunkSum;
+				});
+
+			sums[i] = sum;
+		}
+		});
+
+	for (uint64_t sum : sums)
+		CHECK(sum == 999 * 1000 / 2);
+}
+
+TEST_CASE("ResourcesTaskPool - Multi thread tasks run before the wait returns")
+{
+	ResourcesTaskPool pool;
+
+	std::atomic<int> done = 0;
+	for (int i = 0; i < 1000; ++i)
+		pool.AddMultiThreadTask([&done]() { done++; });
+
+	pool.WaitingForMultiTasksCompletion();
+	CHECK(done == 1000);
+	CHECK(!pool.IsRunning());
+
+	//	Single thread tasks only run on the caller of RunSingleTasks, in order
+	std::vector<int> order;
+	for (int i = 0; i < 10; ++i)
+		pool.AddSingleThreadTask([&order, i]() { order.push_back(i); });
+
+	pool.RunSingleTasks();
+
+	std::vector<int> expected(10);
+	std::iota(expected.begin(), expected.end(), 0);
+	CHECK(order == expected);
+}
@@ -0,0 +1,107 @@
+#include "TestFramework.hpp"
+
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+
+#include "Core/SlabPool.hpp"
+
+TEST_CASE("SlabPool - Blocks of one slab are contiguous")
+{
+	SlabPool pool(48, 16);
+
+	std::vector<std::byte*> blocks;
+	for (int i = 0; i < 16; ++i)
+		blocks.push_back(static_cast<std::byte*>(pool.Allocate()));
+
+	const size_t stride = static_cast<size_t>(blocks[1] - blocks[0]);
+	CHECK(stride >= 48);
+
+	for (size_t i = 1; i < blocks.size(); ++i)
+	{
+		CHECK(static_cast<size_t>(blocks[i] - blocks[i - 1]) == stride);
+		CHECK(reinterpret_cast<uintptr_t>(blocks[i]) % __STDCPP_DEFAULT_NEW_ALIGNMENT__ == 0);
+	}
+
+	PoolStats stats = pool.GetStats();
+	CHECK(stats.slabCount == 1 && stats.liveCount == 16 && stats.capacity == 16);
+
+	for (std::byte* block : blocks)
+		SlabPool::Free(block);
+
+	CHECK(pool.Release());
+}
+
+TEST_CASE("SlabPool - Release with live blocks is an error and keeps the memory")
+{
+	SlabPool pool(32, 8);
+
+	void* live = pool.Allocate();
+	std::memset(live, 0xAB, 32);
+
+	CHECK(!pool.Release());
+	CHECK(Tests::GetLogCounters().errors == 1);
+
+	//	The block is still usable and can be freed later
+	CHECK(static_cast<unsigned char*>(live)[31] == 0xAB);
+	CHECK(pool.GetStats().slabCount == 1);
+
+	SlabPool::Free(live);
+	CHECK(pool.Release());
+	CHECK(pool.GetStats().slabCount == 0);
+}
+
+TEST_CASE("SlabPool - Heap blocks are freed like pool blocks")
+{
+	void* heapBlock = SlabPool::AllocateFromHeap(4096);
+	CHECK(SlabPool::GetHeader(heapBlock).pool == nullptr);
+
+	SlabPool::Free(heapBlock);
+	SlabPool::Free(nullptr);
+}
+
+TEST_CASE("SlabPool - Concurrent allocations and frees")
+{
+	SlabPool pool(64, 32);
+
+	constexpr int ThreadCount = 8;
+	constexpr int Iterations = 20000;
+
+	std::vector<std::thread> threads;
+	for (int t = 0; t < ThreadCount; ++t)
+	{
+		threads.emplace_back([&pool, t]()
+			{
+				std::vector<int*> blocks;
+				for (int i = 0; i < Iterations; ++i)
+				{
+					int* block = static_cast<int*>(pool.Allocate());
+					*block = t;
+					blocks.push_back(block);
+
+					//	Free some blocks on the way so the free list is shared between threads
+					if (i % 3 == 0)
+					{
+						SlabPool::Free(blocks.back());
+						blocks.pop_back();
+					}
+				}
+
+				for (int* block : blocks)
+				{
+					//	A block given to two threads would have been overwritten
+					CHECK(*block == t);
+					SlabPool::Free(block);
+				}
+			});
+	}
+
+	for (std::thread& thread : threads)
+		thread.join();
+
+	PoolStats stats = pool.GetStats();
+	CHECK(stats.liveCount == 0);
+	CHECK(stats.peakCount <= static_cast<size_t>(ThreadCount * Iterations));
+	CHECK(pool.Release());
+}
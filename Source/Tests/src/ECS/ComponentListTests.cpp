@@ -0,0 +1,135 @@
+#include "TestFramework.hpp"
+
+#include <random>
+#include <vector>
+#include <memory>
+#include <string>
+#include <algorithm>
+
+#include "ECS/Systems/ComponentList.hpp"
+
+namespace
+{
+	struct TestComponent
+	{
+		int sceneID = 0;
+		int value = 0;
+
+		TestComponent(int scene, int v) : sceneID(scene), value(v) {}
+	};
+
+	//	Every owned component must be reachable and counted once
+	bool IsConsistent(const ComponentList<TestComponent>& components, size_t expectedSize)
+	{
+		size_t count = 0;
+		for (const std::unique_ptr<TestComponent>& component : components)
+		{
+			if (!components.Contains(*component))
+				return false;
+			count++;
+		}
+
+		return count == expectedSize && components.Size() == expectedSize;
+	}
+}
+
+TEST_CASE("ComponentList - Add and erase in random order")
+{
+	ComponentList<TestComponent> components;
+	std::vector<TestComponent*> added;
+
+	for (int i = 0; i < 1000; ++i)
+		added.push_back(&components.Add(std::make_unique<TestComponent>(0, i)));
+
+	REQUIRE(IsConsistent(components, 1000));
+
+	std::mt19937 random(42);
+	std::shuffle(added.begin(), added.end(), random);
+
+	for (size_t i = 0; i < added.size(); ++i)
+	{
+		CHECK(components.Erase(*added[i]));
+
+		if (i % 100 == 0)
+			CHECK(IsConsistent(components, added.size() - i - 1));
+	}
+
+	CHECK(components.Empty());
+}
+
+TEST_CASE("ComponentList - Erase of a foreign component")
+{
+	ComponentList<TestComponent> components;
+	components.Add(std::make_unique<TestComponent>(0, 0));
+
+	TestComponent foreign(0, 1);
+
+	CHECK(!components.Contains(foreign));
+	CHECK(!components.Erase(foreign));
+	CHECK(components.Size() == 1);
+}
+
+TEST_CASE("ComponentList - EraseIf keeps the other components")
+{
+	ComponentList<TestComponent> components;
+	for (int i = 0; i < 999; ++i)
+		components.Add(std::make_unique<TestComponent>(i % 3, i));
+
+	CHECK(components.EraseIf([](const TestComponent& component) { return component.sceneID == 1; }) == 333);
+	CHECK(IsConsistent(components, 666));
+
+	for (const std::unique_ptr<TestComponent>& component : components)
+		CHECK(component->sceneID != 1);
+}
+
+//	Removal of every component of a scene one by one (GameObject destruction),
+//	ComponentList against the vector and linear search previously used by the systems
+BENCHMARK("ComponentList - Remove components one by one")
+{
+	for (int count : { 1000, 10000, 50000 })
+	{
+		std::vector<int> order(count);
+		for (int i = 0; i < count; ++i)
+			order[i] = i;
+		std::shuffle(order.begin(), order.end(), std::mt19937(7));
+
+		std::vector<std::unique_ptr<TestComponent>> vectorComponents;
+		ComponentList<TestComponent> listComponents;
+		std::vector<TestComponent*> removed;
+
+		double vectorTime = Tests::MeasureWithSetup(
+			[&]()
+			{
+				vectorComponents.clear();
+				removed.clear();
+				for (int i = 0; i < count; ++i)
+					removed.push_back(vectorComponents.emplace_back(std::make_unique<TestComponent>(0, i)).get());
+			},
+			[&]()
+			{
+				for (int index : order)
+				{
+					TestComponent* component = removed[index];
+					auto it = std::find_if(vectorComponents.begin(), vectorComponents.end(),
+						[component](std::unique_ptr<TestComponent>& owned) { return owned.get() == component; });
+					vectorComponents.erase(it);
+				}
+			}, count, count > 10000 ? 1 : 3);
+
+		double listTime = Tests::MeasureWithSetup(
+			[&]()
+			{
+				removed.clear();
+				for (int i = 0; i < count; ++i)
+					removed.push_back(&listComponents.Add(std::make_unique<TestComponent>(0, i)));
+			},
+			[&]()
+			{
+				for (int index : order)
+					listComponents.Erase(*removed[index]);
+			}, count);
+
+		Tests::Report("vector + find_if, " + std::to_string(count) + " components", vectorTime, "per removal");
+		Tests::Report("ComponentList,    " + std::to_string(count) + " components", listTime, "per removal");
+	}
+}
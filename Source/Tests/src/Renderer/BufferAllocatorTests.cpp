@@ -0,0 +1,291 @@
+#include "TestFramework.hpp"
+
+#include <map>
+#include <random>
+#include <vector>
+
+#include "Renderer/BufferAllocator.hpp"
+
+namespace
+{
+	//	Ranges allocated, by offset, as the owner of the buffer keeps them
+	using Ranges = std::map<size_t, size_t>;
+
+	//	Free ranges between the allocated ones, up to the capacity
+	Ranges GetGaps(const Ranges& allocated, size_t capacity)
+	{
+		Ranges gaps;
+		size_t end = 0;
+		for (const auto& [offset, size] : allocated)
+		{
+			if (offset > end)
+				gaps[end] = offset - end;
+			end = offset + size;
+		}
+
+		if (capacity > end)
+			gaps[end] = capacity - end;
+
+		return gaps;
+	}
+
+	//	The allocator agrees with the ranges : aligned, in the buffer, not overlapping, with its stats matching
+	bool CheckRanges(const BufferAllocator& allocator, const Ranges& allocated)
+	{
+		bool valid = true;
+		size_t end = 0, used = 0;
+		for (const auto& [offset, size] : allocated)
+		{
+			valid = valid && offset >= end && offset % allocator.GetAlignment() == 0 && size % allocator.GetAlignment() == 0;
+			valid = valid && allocator.GetSize(offset) == size;
+			end = offset + size;
+			used += size;
+		}
+
+		const BufferAllocator::Stats stats = allocator.GetStats();
+		const Ranges gaps = GetGaps(allocated, allocator.GetCapacity());
+
+		size_t largestGap = 0;
+		for (const auto& [offset, size] : gaps)
+			largestGap = std::max(largestGap, size);
+
+		// Free neighbours are always merged, each gap is one free range
+		return valid && end <= allocator.GetCapacity() && stats.usedSize == used && stats.allocationCount == allocated.size()
+			&& stats.freeRangeCount == gaps.size() && stats.largestFreeRange == largestGap;
+	}
+}
+
+TEST_CASE("BufferAllocator - Ranges are allocated aligned one after the other")
+{
+	BufferAllocator allocator(1024, 4);
+
+	CHECK(allocator.Allocate(10) == 0);
+	CHECK(allocator.GetSize(0) == 12);
+	CHECK(allocator.Allocate(4) == 12);
+	CHECK(allocator.Allocate(1) == 16);
+
+	CHECK(allocator.Allocate(0) == BufferAllocator::InvalidOffset);
+	CHECK(allocator.Allocate(2048) == BufferAllocator::InvalidOffset);
+	CHECK(allocator.GetSize(8) == 0);
+
+	BufferAllocator::Stats stats = allocator.GetStats();
+	CHECK(stats.capacity == 1024);
+	CHECK(stats.usedSize == 20);
+	CHECK(stats.allocationCount == 3);
+	CHECK(stats.freeRangeCount == 1);
+	CHECK(stats.largestFreeRange == 1004);
+
+	// Offsets that are not the start of a range, and ranges already freed, are refused
+	CHECK(!allocator.Free(8));
+	CHECK(allocator.Free(12));
+	CHECK(!allocator.Free(12));
+	CHECK(allocator.GetSize(12) == 0);
+
+	// A freed range is reused by an allocation it fits
+	CHECK(allocator.Allocate(4) == 12);
+
+	// The whole buffer is allocated in one range. Requests are rounded up to their size class before the search,
+	// sizes on a class boundary, as here, are found in a range of the same size
+	BufferAllocator whole(4096);
+	CHECK(whole.Allocate(4096) == 0);
+	CHECK(whole.Allocate(1) == BufferAllocator::InvalidOffset);
+	CHECK(whole.GetStats().freeRangeCount == 0);
+}
+
+TEST_CASE("BufferAllocator - Freed ranges are merged with their free neighbours")
+{
+	// Every order of freeing three neighbours gives back one free range
+	const int orders[][3] = { { 0, 1, 2 }, { 0, 2, 1 }, { 1, 0, 2 }, { 1, 2, 0 }, { 2, 0, 1 }, { 2, 1, 0 } };
+	for (const auto& order : orders)
+	{
+		BufferAllocator allocator(384);
+		const size_t offsets[3] = { allocator.Allocate(128), allocator.Allocate(128), allocator.Allocate(128) };
+		CHECK(offsets[0] == 0 && offsets[1] == 128 && offsets[2] == 256);
+
+		for (int index : order)
+			CHECK(allocator.Free(offsets[index]));
+
+		BufferAllocator::Stats stats = allocator.GetStats();
+		CHECK(stats.freeRangeCount == 1);
+		CHECK(stats.largestFreeRange == 384);
+		CHECK(stats.usedSize == 0);
+		CHECK(allocator.Allocate(384) == 0);
+	}
+
+	// A range freed between two allocated ones stays apart, then merges once they are freed
+	BufferAllocator allocator(1024);
+	const size_t first = allocator.Allocate(256);
+	const size_t middle = allocator.Allocate(256);
+	const size_t last = allocator.Allocate(256);
+
+	allocator.Free(middle);
+	CHECK(allocator.GetStats().freeRangeCount == 2);
+	CHECK(allocator.Allocate(512) == BufferAllocator::InvalidOffset);
+
+	allocator.Free(last);
+	CHECK(allocator.GetStats().freeRangeCount == 1);
+	CHECK(allocator.Allocate(768) == middle);
+
+	allocator.Free(first);
+	CHECK(allocator.GetStats().largestFreeRange == 256);
+}
+
+TEST_CASE("BufferAllocator - Growing adds free space at the end")
+{
+	BufferAllocator allocator(256, 16);
+	CHECK(allocator.Allocate(256) == 0);
+	CHECK(allocator.Allocate(64) == BufferAllocator::InvalidOffset);
+
+	// Smaller capacities are ignored, new capacities are rounded down to the alignment
+	allocator.Grow(128);
+	CHECK(allocator.GetCapacity() == 256);
+	allocator.Grow(520);
+	CHECK(allocator.GetCapacity() == 512);
+
+	CHECK(allocator.Allocate(64) == 256);
+
+	// A free range at the end is extended rather than followed by another one
+	allocator.Grow(1024);
+	BufferAllocator::Stats stats = allocator.GetStats();
+	CHECK(stats.freeRangeCount == 1);
+	CHECK(stats.largestFreeRange == 1024 - 320);
+	CHECK(allocator.Allocate(1024 - 320) == 320);
+
+	// An empty allocator starts with no space
+	BufferAllocator empty;
+	CHECK(empty.Allocate(1) == BufferAllocator::InvalidOffset);
+	empty.Grow(64);
+	CHECK(empty.Allocate(64) == 0);
+}
+
+TEST_CASE("BufferAllocator - Random allocations and frees keep the ranges consistent")
+{
+	std::mt19937 random(7);
+	BufferAllocator allocator(1 << 16, 4);
+	Ranges allocated;
+
+	for (int step = 0; step < 20000; ++step)
+	{
+		if (allocated.empty() || random() % 3 != 0)
+		{
+			// Sizes spread over several size classes, from a few units to a few thousands
+			const size_t size = 1 + random() % (random() % 4 == 0 ? 4000 : 64);
+			const size_t offset = allocator.Allocate(size);
+			if (offset != BufferAllocator::InvalidOffset)
+			{
+				allocated[offset] = (size + 3) / 4 * 4;
+			}
+			else
+			{
+				// The allocator can only refuse when no gap holds the size
+				for (const auto& [gapOffset, gapSize] : GetGaps(allocated, allocator.GetCapacity()))
+					CHECK(gapSize < size * 2);
+			}
+		}
+		else
+		{
+			auto it = std::next(allocated.begin(), random() % allocated.size());
+			CHECK(allocator.Free(it->first));
+			allocated.erase(it);
+		}
+
+		if (step % 500 == 0)
+			CHECK(CheckRanges(allocator, allocated));
+	}
+
+	CHECK(CheckRanges(allocator, allocated));
+
+	for (const auto& [offset, size] : allocated)
+		CHECK(allocator.Free(offset));
+
+	BufferAllocator::Stats stats = allocator.GetStats();
+	CHECK(stats.freeRangeCount == 1 && stats.largestFreeRange == allocator.GetCapacity() && stats.usedSize == 0);
+}
+
+TEST_CASE("BufferAllocator - Planned moves compact the buffer")
+{
+	std::mt19937 random(11);
+	BufferAllocator allocator(1 << 14);
+	Ranges allocated;
+
+	// Holes left by freeing every other range
+	while (true)
+	{
+		const size_t offset = allocator.Allocate(16 + random() % 200);
+		if (offset == BufferAllocator::InvalidOffset)
+			break;
+		allocated[offset] = allocator.GetSize(offset);
+	}
+
+	bool keep = false;
+	for (auto it = allocated.begin(); it != allocated.end();)
+	{
+		keep = !keep;
+		if (keep)
+		{
+			++it;
+			continue;
+		}
+
+		allocator.Free(it->first);
+		it = allocated.erase(it);
+	}
+
+	CHECK(!allocator.IsCompacted());
+
+	size_t moveCount = 0;
+	BufferAllocator::Move move;
+	while (allocator.PlanMove(move))
+	{
+		// Each range moves down to a range allocated for it, the owner then frees the source
+		CHECK(move.destination < move.source);
+		CHECK(allocated.count(move.source) == 1 && allocated[move.source] == move.size);
+		CHECK(allocator.GetSize(move.destination) == move.size);
+
+		CHECK(allocator.Free(move.source));
+		allocated.erase(move.source);
+		allocated[move.destination] = move.size;
+		moveCount++;
+
+		CHECK(CheckRanges(allocator, allocated));
+	}
+
+	CHECK(moveCount > 0);
+	CHECK(allocator.IsCompacted());
+
+	// No range is left above a gap large enough to hold it
+	const Ranges gaps = GetGaps(allocated, allocator.GetCapacity());
+	for (const auto& [offset, size] : allocated)
+	{
+		for (const auto& [gapOffset, gapSize] : gaps)
+			CHECK(gapOffset > offset || gapSize < size * 2);
+	}
+
+	// A compacted buffer plans nothing until a range is freed
+	CHECK(!allocator.PlanMove(move));
+	allocator.Free(allocated.begin()->first);
+	CHECK(!allocator.IsCompacted());
+}
+
+TEST_CASE("BufferAllocator - Ranges that can't move yet are skipped and tried again")
+{
+	BufferAllocator allocator(1024);
+	const size_t first = allocator.Allocate(256);
+	const size_t pending = allocator.Allocate(256);
+	allocator.Free(first);
+
+	// The range is waiting for its upload : nothing moves, the buffer is not marked compacted
+	BufferAllocator::Move move;
+	CHECK(!allocator.PlanMove(move, [&](size_t offset) { return offset != pending; }));
+	CHECK(!allocator.IsCompacted());
+	CHECK(allocator.GetSize(pending) == 256);
+
+	// Once uploaded it moves down
+	CHECK(allocator.PlanMove(move, [](size_t) { return true; }));
+	CHECK(move.source == pending && move.destination == first && move.size == 256);
+	CHECK(allocator.Free(move.source));
+
+	CHECK(!allocator.PlanMove(move));
+	CHECK(allocator.IsCompacted());
+	CHECK(allocator.GetStats().largestFreeRange == 768);
+}
@@ -0,0 +1,201 @@
+#include "TestFramework.hpp"
+#include "TestGLContext.hpp"
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <limits>
+#include <iostream>
+#include <algorithm>
+
+#include <glad/gl.h>
+
+namespace
+{
+	//	Grid of quads drawn again and again, each draw with its own range of vertices and indices as the meshes in the shared buffers
+	struct DrawScene
+	{
+		GLuint program = 0;
+		GLuint framebuffer = 0;		// Drawn in a framebuffer of its own, a hidden window may have no default one
+		GLuint colorBuffer = 0;
+		GLuint vertexBuffer = 0;
+		GLuint indexBuffer = 0;
+		GLuint shortIndexBuffer = 0;
+		GLuint clientVAO = 0;		// Indices passed from memory on each draw, as before the index buffer
+		GLuint indexedVAO = 0;
+		GLuint shortIndexedVAO = 0;
+
+		GLsizei drawCount = 0;
+		GLsizei indexCount = 0;
+		GLint	vertexCount = 0;
+		std::vector<int> clientIndices;
+
+		DrawScene(int quads, GLsizei draws);
+		~DrawScene();
+
+		GLuint CreateVAO(GLuint elementBuffer) const;
+	};
+
+	GLuint CompileShader(GLenum type, const char* source)
+	{
+		GLuint shader = glCreateShader(type);
+		glShaderSource(shader, 1, &source, nullptr);
+		glCompileShader(shader);
+		return shader;
+	}
+
+	DrawScene::DrawScene(int quads, GLsizei draws) : drawCount(draws)
+	{
+		const GLuint vertex = CompileShader(GL_VERTEX_SHADER, "#version 450 core\nlayout(location = 0) in vec3 aPosition;\nvoid main() { gl_Position = vec4(aPosition, 1.0); }\n");
+		const GLuint fragment = CompileShader(GL_FRAGMENT_SHADER, "#version 450 core\nout vec4 oColor;\nvoid main() { oColor = vec4(1.0); }\n");
+		program = glCreateProgram();
+		glAttachShader(program, vertex);
+		glAttachShader(program, fragment);
+		glLinkProgram(program);
+		glDeleteShader(vertex);
+		glDeleteShader(fragment);
+
+		const int side = quads + 1;
+		vertexCount = side * side;
+
+		std::vector<float> positions;
+		for (GLsizei draw = 0; draw < draws; ++draw)
+		{
+			for (int y = 0; y < side; ++y)
+			{
+				for (int x = 0; x < side; ++x)
+					positions.insert(positions.end(), { static_cast<float>(x) / quads, static_cast<float>(y) / quads, 0.f });
+			}
+		}
+
+		std::vector<int> indices;
+		for (int y = 0; y < quads; ++y)
+		{
+			for (int x = 0; x < quads; ++x)
+			{
+				const int corner = y * side + x;
+				indices.insert(indices.end(), { corner, corner + 1, corner + side + 1, corner, corner + side + 1, corner + side });
+			}
+		}
+		indexCount = static_cast<GLsizei>(indices.size());
+
+		for (GLsizei draw = 0; draw < draws; ++draw)
+			clientIndices.insert(clientIndices.end(), indices.begin(), indices.end());
+
+		const std::vector<uint16_t> shortIndices(clientIndices.begin(), clientIndices.end());
+
+		glCreateBuffers(1, &vertexBuffer);
+		glNamedBufferStorage(vertexBuffer, positions.size() * sizeof(float), positions.data(), 0);
+		glCreateBuffers(1, &indexBuffer);
+		glNamedBufferStorage(indexBuffer, clientIndices.size() * sizeof(int), clientIndices.data(), 0);
+		glCreateBuffers(1, &shortIndexBuffer);
+		glNamedBufferStorage(shortIndexBuffer, shortIndices.size() * sizeof(uint16_t), shortIndices.data(), 0);
+
+		clientVAO = CreateVAO(0);
+		indexedVAO = CreateVAO(indexBuffer);
+		shortIndexedVAO = CreateVAO(shortIndexBuffer);
+
+		glCreateRenderbuffers(1, &colorBuffer);
+		glNamedRenderbufferStorage(colorBuffer, GL_RGBA8, 64, 64);
+		glCreateFramebuffers(1, &framebuffer);
+		glNamedFramebufferRenderbuffer(framebuffer, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer);
+		glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+
+		glUseProgram(program);
+		glEnable(GL_RASTERIZER_DISCARD);
+	}
+
+	DrawScene::~DrawScene()
+	{
+		glDisable(GL_RASTERIZER_DISCARD);
+		glUseProgram(0);
+		glBindVertexArray(0);
+
+		const GLuint vaos[] = { clientVAO, indexedVAO, shortIndexedVAO };
+		glDeleteVertexArrays(3, vaos);
+
+		const GLuint buffers[] = { vertexBuffer, indexBuffer, shortIndexBuffer };
+		glDeleteBuffers(3, buffers);
+		glDeleteProgram(program);
+
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		glDeleteFramebuffers(1, &framebuffer);
+		glDeleteRenderbuffers(1, &colorBuffer);
+	}
+
+	GLuint DrawScene::CreateVAO(GLuint elementBuffer) const
+	{
+		GLuint vao = 0;
+		glCreateVertexArrays(1, &vao);
+		glVertexArrayVertexBuffer(vao, 0, vertexBuffer, 0, 3 * sizeof(float));
+		glEnableVertexArrayAttrib(vao, 0);
+		glVertexArrayAttribFormat(vao, 0, 3, GL_FLOAT, GL_FALSE, 0);
+		glVertexArrayAttribBinding(vao, 0, 0);
+
+		if (elementBuffer != 0)
+			glVertexArrayElementBuffer(vao, elementBuffer);
+
+		return vao;
+	}
+}
+
+//	CPU time of a frame of draws, divided by the draws : indices passed from memory against indices in the index buffer.
+//	Fragments are discarded, only the draw calls and the vertex work they start are measured.
+BENCHMARK("IndexBuffer - Draws from client indices against the index buffer")
+{
+	Tests::GLContext context;
+	if (!context.IsValid())
+	{
+		std::cout << "    Skipped : no OpenGL 4.5 context" << std::endl;
+		return;
+	}
+
+	std::cout << "    " << glGetString(GL_RENDERER) << std::endl;
+
+	struct Case
+	{
+		int quads;
+		GLsizei draws;
+	};
+
+	for (const Case& test : { Case{ 7, 2048 }, Case{ 31, 512 }, Case{ 128, 64 } })
+	{
+		DrawScene scene(test.quads, test.draws);
+
+		auto drawClient = [&]() {
+			glBindVertexArray(scene.clientVAO);
+			for (GLsizei draw = 0; draw < scene.drawCount; ++draw)
+			{
+				glDrawElementsBaseVertex(GL_TRIANGLES, scene.indexCount, GL_UNSIGNED_INT,
+					scene.clientIndices.data() + static_cast<size_t>(draw) * scene.indexCount, draw * scene.vertexCount);
+			}
+			glFinish();
+			};
+
+		auto drawIndexed = [&](GLuint vao, GLenum type, size_t indexSize) {
+			glBindVertexArray(vao);
+			for (GLsizei draw = 0; draw < scene.drawCount; ++draw)
+			{
+				const size_t offset = static_cast<size_t>(draw) * scene.indexCount * indexSize;
+				glDrawElementsBaseVertex(GL_TRIANGLES, scene.indexCount, type, reinterpret_cast<const void*>(offset), draw * scene.vertexCount);
+			}
+			glFinish();
+			};
+
+		const std::string prefix = std::to_string(test.draws) + " draws of " + std::to_string(scene.indexCount / 3) + " triangles : ";
+		const size_t copiedBytes = static_cast<size_t>(scene.drawCount) * scene.indexCount * sizeof(int);
+
+		// Variants measured in turns, the load of the machine drifts more between runs than between the draw paths
+		double client = std::numeric_limits<double>::max(), indexed = client, shortIndexed = client;
+		for (int round = 0; round < 10; ++round)
+		{
+			client = std::min(client, Tests::Measure(drawClient, test.draws, 3));
+			indexed = std::min(indexed, Tests::Measure([&]() { drawIndexed(scene.indexedVAO, GL_UNSIGNED_INT, sizeof(int)); }, test.draws, 3));
+			shortIndexed = std::min(shortIndexed, Tests::Measure([&]() { drawIndexed(scene.shortIndexedVAO, GL_UNSIGNED_SHORT, sizeof(uint16_t)); }, test.draws, 3));
+		}
+
+		Tests::Report(prefix + "client indices", client, "per draw, " + std::to_string(copiedBytes / 1024) + " KB of indices sent per frame");
+		Tests::Report(prefix + "index buffer", indexed, "per draw");
+		Tests::Report(prefix + "index buffer, 16 bits", shortIndexed, "per draw");
+	}
+}
@@ -0,0 +1,199 @@
+#include "TestFramework.hpp"
+
+#include <vector>
+
+#include "Renderer/MeshLODSelector.hpp"
+
+namespace
+{
+	//	Levels whose error quadruples at each step, as the simplifier gives for halved triangle counts
+	const std::vector<MeshLOD> Lods = {
+		{ 0, 3000, 0.f },
+		{ 3000, 1500, 0.01f },
+		{ 4500, 750, 0.04f },
+		{ 5250, 375, 0.16f }
+	};
+
+	//	Cameras are only compared by address by the level of detail states
+	struct FakeCameras
+	{
+		char storage[8] = {};
+
+		const Camera& operator[](size_t index) const
+		{
+			return *reinterpret_cast<const Camera*>(storage + index);
+		}
+	};
+
+	//	Levels selected frame after frame for a radius on screen in pixels, from the finest level
+	std::vector<uint32_t> SelectSequence(const std::vector<float>& radii, const MeshLODSelector::Settings& settings)
+	{
+		std::vector<uint32_t> selected;
+		uint32_t lod = 0;
+		for (float radius : radii)
+		{
+			lod = MeshLODSelector::SelectLOD(Lods, radius, lod, settings);
+			selected.push_back(lod);
+		}
+
+		return selected;
+	}
+
+	size_t CountSwitches(const std::vector<uint32_t>& selected)
+	{
+		size_t switches = 0;
+		for (size_t i = 1; i < selected.size(); ++i)
+			switches += selected[i] != selected[i - 1];
+
+		return switches;
+	}
+}
+
+TEST_CASE("MeshLODSelector - Screen size thresholds")
+{
+	MeshLODSelector::Settings settings;
+	settings.hysteresis = 0.f;
+
+	// A level is drawn while its error covers at most a pixel : 0.01 of a 100 pixels radius
+	CHECK(MeshLODSelector::SelectLOD(Lods, 1000.f, 0, settings) == 0);
+	CHECK(MeshLODSelector::SelectLOD(Lods, 101.f, 0, settings) == 0);
+	CHECK(MeshLODSelector::SelectLOD(Lods, 100.f, 0, settings) == 1);
+	CHECK(MeshLODSelector::SelectLOD(Lods, 25.f, 0, settings) == 2);
+	CHECK(MeshLODSelector::SelectLOD(Lods, 6.f, 0, settings) == 3);
+	CHECK(MeshLODSelector::SelectLOD(Lods, 0.f, 0, settings) == 3);
+
+	// The level drawn last frame does not matter without hysteresis, finer levels are taken back at once
+	CHECK(MeshLODSelector::SelectLOD(Lods, 1000.f, 3, settings) == 0);
+	CHECK(MeshLODSelector::SelectLOD(Lods, 25.f, 3, settings) == 2);
+
+	// A larger error allowed moves every threshold
+	settings.maxPixelError = 4.f;
+	CHECK(MeshLODSelector::SelectLOD(Lods, 400.f, 0, settings) == 1);
+	CHECK(MeshLODSelector::SelectLOD(Lods, 401.f, 0, settings) == 0);
+
+	// Meshes with one level, a level out of range after a reimport, and the selection turned off
+	CHECK(MeshLODSelector::SelectLOD(std::span<const MeshLOD>(Lods.data(), 1), 0.f, 0, settings) == 0);
+	CHECK(MeshLODSelector::SelectLOD(Lods, 0.f, 12, settings) == 3);
+
+	settings.enabled = false;
+	CHECK(MeshLODSelector::SelectLOD(Lods, 0.f, 2, settings) == 0);
+}
+
+TEST_CASE("MeshLODSelector - Hysteresis keeps instances at a threshold from switching")
+{
+	MeshLODSelector::Settings settings;
+
+	// A coarser level is taken under 0.75 pixel, a finer one over 1 pixel
+	CHECK(MeshLODSelector::SelectLOD(Lods, 90.f, 0, settings) == 0);
+	CHECK(MeshLODSelector::SelectLOD(Lods, 90.f, 1, settings) == 1);
+	CHECK(MeshLODSelector::SelectLOD(Lods, 75.f, 0, settings) == 1);
+	CHECK(MeshLODSelector::SelectLOD(Lods, 101.f, 1, settings) == 0);
+
+	// A camera jitters around the 1 pixel limit of the first level
+	std::vector<float> jitter;
+	for (int frame = 0; frame < 100; ++frame)
+		jitter.push_back(frame % 2 ? 98.f : 102.f);
+
+	CHECK(CountSwitches(SelectSequence(jitter, settings)) == 0);
+
+	MeshLODSelector::Settings noHysteresis = settings;
+	noHysteresis.hysteresis = 0.f;
+	CHECK(CountSwitches(SelectSequence(jitter, noHysteresis)) == 99);
+
+	// A camera moving away then back switches once per level each way, at different sizes
+	std::vector<float> dolly;
+	for (float radius = 200.f; radius > 2.f; radius *= 0.95f)
+		dolly.push_back(radius);
+	for (float radius = 2.f; radius < 200.f; radius *= 1.05f)
+		dolly.push_back(radius);
+
+	const std::vector<uint32_t> selected = SelectSequence(dolly, settings);
+	CHECK(CountSwitches(selected) == 6);
+	CHECK(selected.front() == 0 && selected.back() == 0);
+
+	for (size_t i = 0; i < selected.size(); ++i)
+	{
+		// Every level drawn is within the error allowed
+		CHECK(Lods[selected[i]].error * dolly[i] <= settings.maxPixelError);
+	}
+}
+
+TEST_CASE("MeshLODSelector - Each camera keeps its own level of detail state")
+{
+	MeshLODSelector::Settings settings;
+	FakeCameras cameras;
+	std::vector<ViewLODState> views;
+	uint64_t renderCount = 0;
+
+	// A close camera and a far one render the same instance each frame
+	auto render = [&](size_t camera, float radius) {
+		MeshLODState& state = MeshLODSelector::GetViewState(views, cameras[camera], ++renderCount);
+		MeshLODSelector::Update(state, MeshLODSelector::SelectLOD(Lods, radius, state.lod, settings), 1.f / 60.f, settings);
+		return state.lod;
+		};
+
+	for (int frame = 0; frame < 10; ++frame)
+	{
+		CHECK(render(0, 500.f) == 0);
+		CHECK(render(1, 10.f) == 2);
+	}
+
+	CHECK(views.size() == 2);
+
+	// The far camera is at the limit of its level : its hysteresis is not reset by the close camera
+	for (int frame = 0; frame < 10; ++frame)
+	{
+		CHECK(render(0, 500.f) == 0);
+		CHECK(render(1, 24.f) == 2);
+	}
+
+	// Past the cameras kept, the least recently rendered one is forgotten and starts again at the finest level
+	for (size_t camera = 2; camera < MeshLODSelector::MaxViewStates + 1; ++camera)
+		render(camera, 10.f);
+
+	CHECK(views.size() == MeshLODSelector::MaxViewStates);
+	CHECK(MeshLODSelector::GetViewState(views, cameras[1], ++renderCount).lod == 2);
+	CHECK(views.size() == MeshLODSelector::MaxViewStates);
+
+	MeshLODState& restarted = MeshLODSelector::GetViewState(views, cameras[0], ++renderCount);
+	CHECK(restarted.lod == 0 && restarted.fade == 1.f);
+}
+
+TEST_CASE("MeshLODSelector - Crossfades between levels")
+{
+	MeshLODSelector::Settings settings;
+	settings.crossfade = true;
+	settings.crossfadeDuration = 0.25f;
+
+	MeshLODState state;
+	MeshLODDraw draws[2];
+	CHECK(MeshLODSelector::GetDraws(state, draws) == 1);
+
+	MeshLODSelector::Update(state, 2, 0.1f, settings);
+	CHECK(state.lod == 2 && state.previousLod == 0);
+	CHECK(MeshLODSelector::GetDraws(state, draws) == 2);
+	CHECK(draws[0].lod == 2 && draws[0].fadeDirection == 1.f);
+	CHECK(draws[1].lod == 0 && draws[1].fadeDirection == -1.f);
+	CHECK(draws[0].fade == draws[1].fade);
+
+	// A crossfade in progress finishes before another level is taken
+	MeshLODSelector::Update(state, 3, 0.1f, settings);
+	CHECK(state.lod == 2 && state.previousLod == 0 && state.fade < 1.f);
+
+	MeshLODSelector::Update(state, 3, 0.1f, settings);
+	CHECK(state.lod == 2 && state.previousLod == 2 && state.fade == 1.f);
+	CHECK(MeshLODSelector::GetDraws(state, draws) == 1);
+
+	MeshLODSelector::Update(state, 3, 0.1f, settings);
+	CHECK(state.lod == 3 && state.previousLod == 2);
+
+	// A frame longer than the crossfade switches at once, as does turning it off
+	MeshLODSelector::Update(state, 3, 1.f, settings);
+	MeshLODSelector::Update(state, 1, 1.f, settings);
+	CHECK(state.lod == 1 && state.previousLod == 1 && state.fade == 1.f);
+
+	settings.crossfade = false;
+	MeshLODSelector::Update(state, 0, 0.f, settings);
+	CHECK(state.lod == 0 && state.previousLod == 0);
+	CHECK(MeshLODSelector::GetDraws(state, draws) == 1 && draws[0].lod == 0);
+}
@@ -0,0 +1,191 @@
+#include "TestFramework.hpp"
+
+#include <cmath>
+#include <array>
+#include <vector>
+#include <string>
+#include <algorithm>
+
+#include "Renderer/MeshletCuller.hpp"
+#include "Resources/Loaders/MeshletBuilder.hpp"
+
+namespace
+{
+	constexpr float Pi = 3.14159265358979f;
+
+	struct TestTerrain
+	{
+		std::vector<Vertex> vertices;
+		std::vector<int> indices;
+		std::vector<Meshlet> meshlets;
+	};
+
+	//	Grid of hills laid out as PhysicsSimulation::GenerateTerrain does, one unit between the samples
+	TestTerrain MakeTerrain(int size, float heightScale)
+	{
+		TestTerrain terrain;
+		terrain.vertices.resize(static_cast<size_t>(size) * size);
+
+		for (int i = 0; i < size; ++i)
+		{
+			for (int j = 0; j < size; ++j)
+			{
+				const float row = static_cast<float>(i);
+				const float column = static_cast<float>(j);
+				const float height = (std::sin(row * 0.05f) * std::cos(column * 0.07f) + 0.3f * std::sin((row + column) * 0.2f)) * heightScale;
+
+				Vertex& vertex = terrain.vertices[i * size + j];
+				vertex.position = Vector3(row, height, column);
+				vertex.normal = Vector3(0.f, 1.f, 0.f);
+			}
+		}
+
+		for (int i = 0; i < size - 1; ++i)
+		{
+			for (int j = 0; j < size - 1; ++j)
+			{
+				terrain.indices.insert(terrain.indices.end(), {
+					(i + 1) * size + j, i * size + j, i * size + j + 1,
+					(i + 1) * size + j + 1, (i + 1) * size + j, i * size + j + 1 });
+			}
+		}
+
+		MeshletBuilder::Build(terrain.indices, terrain.vertices, terrain.meshlets);
+		return terrain;
+	}
+
+	struct View
+	{
+		std::string name;
+		Vector3 eye;
+		Vector3 target;
+	};
+
+	Matrix4 GetViewProjection(const View& view)
+	{
+		return Matrix4::Perspective(60.f * Pi / 180.f, 16.f / 9.f, 0.1f, 1000.f) * Matrix4::LookAt(view.eye, view.target, Vector3(0.f, 1.f, 0.f));
+	}
+
+	//	Clip space test of every corner independent of the frustum planes : all of them out of the same side
+	bool IsOutsideClipSpace(const TestTerrain& terrain, const Meshlet& meshlet, const Matrix4& viewProjection)
+	{
+		std::array<bool, 6> outside;
+		outside.fill(true);
+
+		for (uint32_t i = meshlet.indexOffset; i < meshlet.indexOffset + meshlet.indexCount; ++i)
+		{
+			const Vector4 clip = Matrix4::Multiply(Vector4(terrain.vertices[terrain.indices[i]].position, 1.f), viewProjection);
+			const std::array<bool, 6> sides = { clip.x < -clip.w, clip.x > clip.w, clip.y < -clip.w, clip.y > clip.w, clip.z < -clip.w, clip.z > clip.w };
+
+			for (size_t side = 0; side < sides.size(); ++side)
+				outside[side] = outside[side] && sides[side];
+		}
+
+		return std::any_of(outside.begin(), outside.end(), [](bool side) { return side; });
+	}
+
+	bool IsBackFacingFrom(const TestTerrain& terrain, const Meshlet& meshlet, const Vector3& cameraPosition)
+	{
+		for (uint32_t i = meshlet.indexOffset; i < meshlet.indexOffset + meshlet.indexCount; i += 3)
+		{
+			const Vector3& a = terrain.vertices[terrain.indices[i]].position;
+			const Vector3& b = terrain.vertices[terrain.indices[i + 1]].position;
+			const Vector3& c = terrain.vertices[terrain.indices[i + 2]].position;
+
+			if (Vector3::DotProduct(Vector3::CrossProduct(b - a, c - a), a - cameraPosition) < 0.f)
+				return false;
+		}
+
+		return true;
+	}
+
+	const std::vector<View> Views = {
+		{ "Whole terrain in view", Vector3(-100.f, 300.f, -100.f), Vector3(256.f, 0.f, 256.f) },
+		{ "Low over the hills", Vector3(128.f, 25.f, 128.f), Vector3(300.f, 0.f, 200.f) },
+		{ "Under the ground", Vector3(128.f, -40.f, 128.f), Vector3(140.f, 0.f, 170.f) }
+	};
+}
+
+TEST_CASE("MeshletCuller - Terrain meshlets cover every triangle")
+{
+	TestTerrain terrain = MakeTerrain(129, 8.f);
+	REQUIRE(!terrain.meshlets.empty());
+
+	// The meshlets follow each other over the whole index stream, bounded in triangles
+	uint32_t offset = 0;
+	for (const Meshlet& meshlet : terrain.meshlets)
+	{
+		CHECK(meshlet.indexOffset == offset);
+		CHECK(meshlet.indexCount > 0 && meshlet.indexCount <= MeshletBuilder::MaxTriangles * 3);
+		offset += meshlet.indexCount;
+	}
+
+	CHECK(offset == terrain.indices.size());
+
+	// The grid vertices are not moved, the terrain collider reads them row by row
+	CHECK(terrain.vertices[129 * 5 + 7].position.x == 5.f && terrain.vertices[129 * 5 + 7].position.z == 7.f);
+}
+
+TEST_CASE("MeshletCuller - Only meshlets out of the view or facing away are culled")
+{
+	TestTerrain terrain = MakeTerrain(257, 8.f);
+
+	for (const View& view : Views)
+	{
+		const Matrix4 viewProjection = GetViewProjection(view);
+		const MeshletCuller::Frustum frustum = MeshletCuller::ExtractFrustum(viewProjection);
+
+		size_t frustumCulled = 0, coneCulled = 0;
+		for (const Meshlet& meshlet : terrain.meshlets)
+		{
+			if (MeshletCuller::IsOutsideFrustum(meshlet, frustum))
+			{
+				frustumCulled++;
+				CHECK(IsOutsideClipSpace(terrain, meshlet, viewProjection));
+			}
+			else if (MeshletCuller::IsBackFacing(meshlet, view.eye))
+			{
+				coneCulled++;
+				CHECK(IsBackFacingFrom(terrain, meshlet, view.eye));
+			}
+		}
+
+		// The batch draws the rest, contiguous meshlets merged in one range
+		MeshletBatch batch;
+		MeshletCullingStats stats;
+		MeshletCuller::Cull(terrain.meshlets, frustum, view.eye, batch, &stats);
+
+		CHECK(stats.frustumCulled == frustumCulled && stats.coneCulled == coneCulled);
+		CHECK(batch.firstIndices.size() == batch.indexCounts.size() && batch.indexCounts.size() == stats.drawCount);
+
+		size_t drawnIndices = 0;
+		for (int32_t count : batch.indexCounts)
+			drawnIndices += static_cast<size_t>(count);
+
+		CHECK(drawnIndices == (stats.triangleCount - stats.culledTriangles) * 3);
+	}
+}
+
+//	Cost of the culling and triangles left against the whole terrain drawn, for views of a generated terrain
+BENCHMARK("MeshletCuller - Terrain culling")
+{
+	TestTerrain terrain = MakeTerrain(513, 16.f);
+	const size_t triangleCount = terrain.indices.size() / 3;
+
+	for (const View& view : Views)
+	{
+		const MeshletCuller::Frustum frustum = MeshletCuller::ExtractFrustum(GetViewProjection(view));
+
+		MeshletBatch batch;
+		MeshletCullingStats stats;
+		MeshletCuller::Cull(terrain.meshlets, frustum, view.eye, batch, &stats);
+
+		const double time = Tests::Measure([&]() { MeshletCuller::Cull(terrain.meshlets, frustum, view.eye, batch); }, terrain.meshlets.size(), 20);
+
+		const size_t drawnTriangles = stats.triangleCount - stats.culledTriangles;
+		Tests::Report(view.name, time, "per meshlet, " + std::to_string(terrain.meshlets.size()) + " meshlets, "
+			+ std::to_string(drawnTriangles) + " / " + std::to_string(triangleCount) + " triangles drawn ("
+			+ std::to_string(100 * drawnTriangles / triangleCount) + "%), " + std::to_string(stats.frustumCulled) + " out of the view, "
+			+ std::to_string(stats.coneCulled) + " facing away, " + std::to_string(stats.drawCount) + " draws");
+	}
+}
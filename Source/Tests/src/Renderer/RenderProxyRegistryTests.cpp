@@ -0,0 +1,116 @@
+#include "TestFramework.hpp"
+
+#include <random>
+#include <vector>
+#include <string>
+#include <algorithm>
+
+#include "Renderer/RenderProxyRegistry.hpp"
+
+namespace
+{
+	struct TestProxy
+	{
+		int value = 0;
+		size_t proxySlots[static_cast<size_t>(ERenderProxySlot::COUNT)] = { InvalidProxySlot, InvalidProxySlot, InvalidProxySlot };
+	};
+
+	using SystemRegistry = RenderProxyRegistry<TestProxy, ERenderProxySlot::System>;
+	using MaterialRegistry = RenderProxyRegistry<TestProxy, ERenderProxySlot::Material>;
+}
+
+TEST_CASE("RenderProxyRegistry - Back-indices stay valid across removals")
+{
+	std::vector<TestProxy> proxies(1000);
+	SystemRegistry registry;
+
+	for (TestProxy& proxy : proxies)
+		CHECK(registry.Add(&proxy));
+
+	CHECK(!registry.Add(&proxies[0]));
+	CHECK(!registry.Add(nullptr));
+
+	std::vector<TestProxy*> order;
+	for (TestProxy& proxy : proxies)
+		order.push_back(&proxy);
+	std::shuffle(order.begin(), order.end(), std::mt19937(3));
+
+	for (size_t i = 0; i < order.size(); ++i)
+	{
+		CHECK(registry.Remove(order[i]));
+		CHECK(!registry.Contains(order[i]));
+		CHECK(order[i]->proxySlots[static_cast<size_t>(ERenderProxySlot::System)] == InvalidProxySlot);
+
+		if (i % 100 == 0)
+		{
+			for (size_t index = 0; index < registry.Size(); ++index)
+				CHECK(registry.GetProxies()[index]->proxySlots[static_cast<size_t>(ERenderProxySlot::System)] == index);
+		}
+	}
+
+	CHECK(registry.Empty());
+}
+
+TEST_CASE("RenderProxyRegistry - Registries of another slot are independent")
+{
+	std::vector<TestProxy> proxies(10);
+	SystemRegistry systemRegistry;
+	MaterialRegistry materialRegistry;
+
+	for (TestProxy& proxy : proxies)
+	{
+		systemRegistry.Add(&proxy);
+		materialRegistry.Add(&proxy);
+	}
+
+	materialRegistry.Remove(&proxies[4]);
+
+	CHECK(systemRegistry.Contains(&proxies[4]));
+	CHECK(!materialRegistry.Contains(&proxies[4]));
+	CHECK(systemRegistry.Size() == 10 && materialRegistry.Size() == 9);
+
+	//	A registry of the same slot must not accept the back-index of another one
+	MaterialRegistry otherMaterialRegistry;
+	CHECK(!otherMaterialRegistry.Contains(&proxies[0]));
+	CHECK(!otherMaterialRegistry.Remove(&proxies[0]));
+}
+
+//	Registration then unregistration of every instance of a scene,
+//	RenderProxyRegistry against the vector with std::find and erase previously used by the render system
+BENCHMARK("RenderProxyRegistry - Register and unregister a scene")
+{
+	for (size_t count : { 1000, 10000, 50000 })
+	{
+		std::vector<TestProxy> proxies(count);
+		std::vector<TestProxy*> order;
+		for (TestProxy& proxy : proxies)
+			order.push_back(&proxy);
+		std::shuffle(order.begin(), order.end(), std::mt19937(7));
+
+		std::vector<TestProxy*> vectorProxies;
+		double vectorTime = Tests::Measure([&]()
+			{
+				for (TestProxy& proxy : proxies)
+				{
+					if (std::find(vectorProxies.begin(), vectorProxies.end(), &proxy) == vectorProxies.end())
+						vectorProxies.push_back(&proxy);
+				}
+
+				for (TestProxy* proxy : order)
+					vectorProxies.erase(std::find(vectorProxies.begin(), vectorProxies.end(), proxy));
+			}, count, count > 10000 ? 1 : 3);
+
+		SystemRegistry registry;
+		double registryTime = Tests::Measure([&]()
+			{
+				for (TestProxy& proxy : proxies)
+					registry.Add(&proxy);
+
+				for (TestProxy* proxy : order)
+					registry.Remove(proxy);
+			}, count);
+
+		Tests::Report("vector + find, " + std::to_string(count) + " instances", vectorTime, "per register and unregister");
+		Tests::Report("RenderProxyRegistry, " + std::to_string(count) + " instances", registryTime, "per register and unregister");
+	}
+}
@@ -0,0 +1,199 @@
+#include "TestFramework.hpp"
+#include "TestGLContext.hpp"
+
+#include <chrono>
+#include <vector>
+#include <string>
+#include <memory>
+#include <sstream>
+#include <iomanip>
+#include <iostream>
+#include <filesystem>
+
+#include <glad/gl.h>
+
+#include "Renderer/ShaderCache.hpp"
+#include "Renderer/Primitives/ShaderProgram.hpp"
+#include "Tools/PathConfig.hpp"
+
+namespace fs = std::filesystem;
+
+namespace
+{
+	constexpr size_t ProgramCount = 19;	// Programs of RenderSystem::Initialize
+
+	constexpr char VertexShader[] = R"GLSL(
+#version 450 core
+layout(location = 0) in vec3 aPosition;
+layout(location = 1) in vec3 aNormal;
+layout(location = 2) in vec2 aUV;
+
+uniform mat4 uModel;
+uniform mat4 uViewProj;
+
+out vec3 vNormal;
+out vec2 vUV;
+
+void main()
+{
+	vNormal = mat3(uModel) * aNormal;
+	vUV = aUV;
+	gl_Position = uViewProj * uModel * vec4(aPosition, 1.0);
+})GLSL";
+
+	//	Lighting loop of the size of the mesh shaders, the variant is replaced in each program
+	constexpr char FragmentShader[] = R"GLSL(
+#version 450 core
+out vec4 oColor;
+
+in vec3 vNormal;
+in vec2 vUV;
+
+uniform sampler2D uDiffuseTexture;
+uniform vec3 uLightDirections[8];
+uniform vec3 uLightColors[8];
+uniform float uRoughness;
+
+float Distribution(vec3 normal, vec3 halfway, float roughness)
+{
+	float a = roughness * roughness;
+	float nDotH = max(dot(normal, halfway), 0.0);
+	float denominator = nDotH * nDotH * (a * a - 1.0) + 1.0;
+	return a * a / (3.14159265 * denominator * denominator);
+}
+
+float Geometry(float nDotV, float roughness)
+{
+	float k = (roughness + 1.0) * (roughness + 1.0) / 8.0;
+	return nDotV / (nDotV * (1.0 - k) + k);
+}
+
+void main()
+{
+	vec3 normal = normalize(vNormal);
+	vec4 albedo = texture(uDiffuseTexture, vUV);
+	vec3 color = vec3(0.0);
+
+	for (int i = 0; i < 8; ++i)
+	{
+		vec3 halfway = normalize(uLightDirections[i] + vec3(0.0, 0.0, 1.0));
+		float nDotL = max(dot(normal, uLightDirections[i]), 0.0);
+		color += albedo.rgb * uLightColors[i] * nDotL * Distribution(normal, halfway, uRoughness) * Geometry(nDotL, uRoughness);
+	}
+
+	oColor = vec4(color * VARIANT, albedo.a);
+})GLSL";
+
+	//	Sources never built before : neither this cache nor the one of the driver knows them
+	std::vector<std::string> MakeFragmentShaders(size_t count, const std::string& run)
+	{
+		std::vector<std::string> shaders;
+		for (size_t i = 0; i < count; ++i)
+		{
+			std::string shader = FragmentShader;
+			shader.replace(shader.find("VARIANT"), 7, "(1.0 + " + std::to_string(i) + ".0 / 64.0)");
+			shaders.push_back(shader + "\n// " + run + "\n");
+		}
+
+		return shaders;
+	}
+
+	//	Path of the binary written by the cache, removed by the benchmark
+	std::string GetProgramPath(const std::string& fragmentShader)
+	{
+		const Hash128 hash = ShaderCache::HashSources(VertexShader, fragmentShader.c_str(), nullptr);
+
+		std::stringstream name;
+		name << std::hex << std::setfill('0') << std::setw(16) << hash.high << std::setw(16) << hash.low << ".bin";
+
+		return std::string(CACHE_ROOT) + R"(Shaders\)" + name.str();
+	}
+
+	//	Programs generated then used one by one, as before : each link is waited for before the next program is submitted
+	void GenerateOneByOne(std::vector<std::unique_ptr<ShaderProgram>>& programs, const std::vector<std::string>& fragmentShaders)
+	{
+		for (const std::string& fragmentShader : fragmentShaders)
+		{
+			programs.push_back(std::make_unique<ShaderProgram>());
+			programs.back()->Generate(VertexShader, fragmentShader.c_str());
+			Tests::DoNotOptimize(programs.back()->GetID());
+		}
+	}
+
+	//	Every program generated before the first one is used, as RenderSystem::Initialize
+	void GenerateAll(std::vector<std::unique_ptr<ShaderProgram>>& programs, const std::vector<std::string>& fragmentShaders)
+	{
+		for (const std::string& fragmentShader : fragmentShaders)
+		{
+			programs.push_back(std::make_unique<ShaderProgram>());
+			programs.back()->Generate(VertexShader, fragmentShader.c_str());
+		}
+
+		for (const std::unique_ptr<ShaderProgram>& program : programs)
+			Tests::DoNotOptimize(program->GetID());
+	}
+}
+
+//	Startup cost of the shader programs : compiled with a cold cache, one by one or all submitted before the first use,
+//	then read from the binaries of the warm cache
+BENCHMARK("ShaderCache - Programs compiled cold against loaded from the cache")
+{
+	Tests::GLContext context;
+	if (!context.IsValid())
+	{
+		std::cout << "    Skipped : no OpenGL 4.5 context" << std::endl;
+		return;
+	}
+
+	std::cout << "    " << glGetString(GL_RENDERER) << std::endl;
+	ShaderCache::Initialize();
+
+	GLint binaryFormatCount = 0;
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binaryFormatCount);
+
+	// Each sample compiles sources of its own, every binary written is removed at the end
+	const std::string run = std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+	size_t sample = 0;
+
+	std::vector<std::string> writtenBinaries;
+	std::vector<std::string> fragmentShaders;
+	std::vector<std::unique_ptr<ShaderProgram>> programs;
+
+	auto prepareCold = [&]() {
+		programs.clear();
+		fragmentShaders = MakeFragmentShaders(ProgramCount, run + " " + std::to_string(sample++));
+		for (const std::string& fragmentShader : fragmentShaders)
+			writtenBinaries.push_back(GetProgramPath(fragmentShader));
+		};
+
+	const std::string prefix = std::to_string(ProgramCount) + " programs : ";
+
+	const double oneByOne = Tests::MeasureWithSetup(prepareCold, [&]() { GenerateOneByOne(programs, fragmentShaders); }, ProgramCount, 3);
+	Tests::Report(prefix + "cold, each link waited for", oneByOne, "per program");
+
+	const ShaderCache::Stats coldStats = ShaderCache::GetStats();
+	const double submitted = Tests::MeasureWithSetup(prepareCold, [&]() { GenerateAll(programs, fragmentShaders); }, ProgramCount, 3);
+	Tests::Report(prefix + "cold, all submitted first", submitted, "per program");
+	CHECK(ShaderCache::GetStats().compiledPrograms - coldStats.compiledPrograms == ProgramCount * 3);
+
+	// The sources of the last cold sample, their binaries are in the cache
+	const ShaderCache::Stats warmStats = ShaderCache::GetStats();
+	const double warm = Tests::MeasureWithSetup([&]() { programs.clear(); }, [&]() { GenerateAll(programs, fragmentShaders); }, ProgramCount, 3);
+	Tests::Report(prefix + "warm cache", warm, binaryFormatCount > 0 ? "per program" : "per program, no binary format : compiled again");
+
+	if (binaryFormatCount > 0)
+		CHECK(ShaderCache::GetStats().loadedPrograms - warmStats.loadedPrograms == ProgramCount * 3);
+
+	for (const std::unique_ptr<ShaderProgram>& program : programs)
+	{
+		GLint linked = GL_FALSE;
+		glGetProgramiv(program->GetID(), GL_LINK_STATUS, &linked);
+		CHECK(linked == GL_TRUE);
+	}
+
+	programs.clear();
+
+	std::error_code error;
+	for (const std::string& path : writtenBinaries)
+		fs::remove(path, error);
+}
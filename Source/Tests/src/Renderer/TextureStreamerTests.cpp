@@ -0,0 +1,210 @@
+#include "TestFramework.hpp"
+
+#include <memory>
+#include <vector>
+#include <algorithm>
+
+#include "Renderer/TextureStreamer.hpp"
+
+namespace
+{
+	//	Cooked RGBA8 mip chain of a square texture, its pixels are never read by the simulation
+	TextureData MakeMipChain(int size)
+	{
+		TextureData data;
+		data.width = size;
+		data.height = size;
+		data.channels = 4;
+		data.storage = std::make_shared<int>(0);
+
+		size_t offset = 0;
+		for (int levelSize = size; ; levelSize /= 2)
+		{
+			TextureMipLevel& level = data.mipLevels.emplace_back();
+			level.width = levelSize;
+			level.height = levelSize;
+			level.offset = offset;
+			level.size = static_cast<size_t>(levelSize) * levelSize * 4;
+			offset += level.size;
+
+			if (levelSize == 1)
+				break;
+		}
+
+		return data;
+	}
+
+	struct StreamedTextures
+	{
+		TextureStreamer streamer{ true };
+		std::vector<std::unique_ptr<Texture>> textures;
+		TextureData source;
+
+		StreamedTextures(size_t count, const TextureStreamer::Settings& settings)
+		{
+			streamer.SetSettings(settings);
+			source = MakeMipChain(1024);
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				Texture& texture = *textures.emplace_back(std::make_unique<Texture>(HYGUID::NewGUID()));
+				streamer.Register(texture, source, streamer.GetInitialLevel(source));
+			}
+		}
+
+		int Level(size_t index) const
+		{
+			return streamer.GetResidentLevel(*textures[index]);
+		}
+	};
+}
+
+TEST_CASE("TextureStreamer - Textures are created at the level of the initial size")
+{
+	TextureStreamer streamer(true);
+	TextureStreamer::Settings settings;
+	settings.initialSize = 64;
+	streamer.SetSettings(settings);
+
+	TextureData data = MakeMipChain(1024);
+	CHECK(streamer.GetInitialLevel(data) == 4);
+
+	// Textures larger along one side only are sized by their largest side
+	data.mipLevels[4].height = 16;
+	CHECK(streamer.GetInitialLevel(data) == 4);
+
+	TextureData small = MakeMipChain(32);
+	CHECK(streamer.GetInitialLevel(small) == 0);
+
+	// Pixels owned by stb_image are freed after the upload, they can't be streamed later
+	TextureData decoded = MakeMipChain(1024);
+	decoded.storage = nullptr;
+	CHECK(streamer.GetInitialLevel(decoded) == 0);
+
+	settings.enabled = false;
+	streamer.SetSettings(settings);
+	CHECK(streamer.GetInitialLevel(data) == 0);
+}
+
+TEST_CASE("TextureStreamer - Requested texels choose the streamed level")
+{
+	StreamedTextures scene(1, TextureStreamer::Settings());
+	CHECK(scene.Level(0) == 4);
+
+	// 256 texels on screen are covered by the 256x256 level
+	scene.streamer.RequestTexels(scene.textures[0].get(), 256.f);
+	scene.streamer.Update();
+	CHECK(scene.Level(0) == 2);
+
+	// The largest request of the frame wins, a level between two others is rounded to the larger one
+	scene.streamer.RequestTexels(scene.textures[0].get(), 100.f);
+	scene.streamer.RequestTexels(scene.textures[0].get(), 600.f);
+	scene.streamer.Update();
+	CHECK(scene.Level(0) == 0);
+
+	// Under the budget, smaller requests and frames without a draw keep the resident levels
+	scene.streamer.RequestTexels(scene.textures[0].get(), 8.f);
+	scene.streamer.Update();
+	scene.streamer.Update();
+	CHECK(scene.Level(0) == 0);
+
+	TextureStreamingStats stats = scene.streamer.GetStats();
+	CHECK(stats.streamedInLevels == 4);
+	CHECK(stats.evictedLevels == 0);
+}
+
+TEST_CASE("TextureStreamer - Over the budget the least recently used then least covered textures are evicted")
+{
+	TextureStreamer::Settings settings;
+	const size_t chainSize = TextureStreamer::GetLevelsSize(MakeMipChain(1024).mipLevels, 0);
+	const size_t topLevelSize = static_cast<size_t>(1024) * 1024 * 4;
+
+	// Room for two whole chains and a third one without its top level
+	settings.budgetBytes = chainSize * 3 - topLevelSize;
+	StreamedTextures scene(3, settings);
+
+	scene.streamer.RequestTexels(scene.textures[0].get(), 1100.f);
+	scene.streamer.RequestTexels(scene.textures[1].get(), 2000.f);
+	scene.streamer.RequestTexels(scene.textures[2].get(), 3000.f);
+	scene.streamer.Update();
+
+	CHECK(scene.Level(0) == 1);
+	CHECK(scene.Level(1) == 0);
+	CHECK(scene.Level(2) == 0);
+
+	// The least covered texture is drawn again, the one left out since is the oldest and gives its top level
+	scene.streamer.RequestTexels(scene.textures[0].get(), 1100.f);
+	scene.streamer.RequestTexels(scene.textures[2].get(), 3000.f);
+	scene.streamer.Update();
+
+	CHECK(scene.Level(0) == 0);
+	CHECK(scene.Level(1) == 1);
+	CHECK(scene.Level(2) == 0);
+
+	TextureStreamingStats stats = scene.streamer.GetStats();
+	CHECK(stats.residentBytes <= settings.budgetBytes);
+	CHECK(stats.residentBytes == chainSize * 3 - topLevelSize);
+	CHECK(stats.evictedLevels == 1);
+}
+
+TEST_CASE("TextureStreamer - Initial levels are never evicted")
+{
+	TextureStreamer::Settings settings;
+	settings.budgetBytes = 0;
+	StreamedTextures scene(3, settings);
+
+	for (int frame = 0; frame < 3; ++frame)
+	{
+		for (const std::unique_ptr<Texture>& texture : scene.textures)
+			scene.streamer.RequestTexels(texture.get(), 4096.f);
+
+		scene.streamer.Update();
+
+		for (size_t i = 0; i < scene.textures.size(); ++i)
+			CHECK(scene.Level(i) == 4);
+	}
+
+	TextureStreamingStats stats = scene.streamer.GetStats();
+	CHECK(stats.streamedTextures == 3);
+	CHECK(stats.budgetBytes == 0);
+	CHECK(stats.residentBytes == 3 * TextureStreamer::GetLevelsSize(scene.source.mipLevels, 4));
+	CHECK(stats.wantedBytes == 3 * TextureStreamer::GetLevelsSize(scene.source.mipLevels, 0));
+	CHECK(stats.streamedInLevels == 0);
+	CHECK(stats.pendingStreamIns == 0);
+}
+
+TEST_CASE("TextureStreamer - Stream-ins are capped per frame, the most covered textures first")
+{
+	TextureStreamer::Settings settings;
+	settings.maxStreamInsPerFrame = 4;
+	StreamedTextures scene(6, settings);
+
+	for (int frame = 0; frame < 2; ++frame)
+	{
+		for (size_t i = 0; i < scene.textures.size(); ++i)
+			scene.streamer.RequestTexels(scene.textures[i].get(), 1024.f + 100.f * static_cast<float>(i));
+
+		scene.streamer.Update();
+
+		if (frame == 0)
+		{
+			CHECK(scene.Level(0) == 4);
+			CHECK(scene.Level(1) == 4);
+			for (size_t i = 2; i < scene.textures.size(); ++i)
+				CHECK(scene.Level(i) == 0);
+
+			CHECK(scene.streamer.GetStats().streamedInLevels == 16);
+		}
+	}
+
+	for (size_t i = 0; i < scene.textures.size(); ++i)
+		CHECK(scene.Level(i) == 0);
+
+	TextureStreamingStats stats = scene.streamer.GetStats();
+	CHECK(stats.streamedInLevels == 24);
+	CHECK(stats.residentBytes == 6 * TextureStreamer::GetLevelsSize(scene.source.mipLevels, 0));
+
+	scene.streamer.Unregister(*scene.textures[0]);
+	CHECK(scene.streamer.GetResidentLevel(*scene.textures[0]) == -1);
+	CHECK(scene.streamer.GetStats().streamedTextures == 5);
+}
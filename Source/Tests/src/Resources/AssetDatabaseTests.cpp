@@ -0,0 +1,239 @@
+#include "TestFramework.hpp"
+
+#include <string>
+#include <chrono>
+#include <vector>
+#include <fstream>
+#include <filesystem>
+
+#include <nlohmann/json.hpp>
+
+#include "Core/ResourcesTaskPool.hpp"
+#include "Resources/AssetDatabase.hpp"
+#include "Tools/ContentHash.hpp"
+
+namespace fs = std::filesystem;
+
+namespace
+{
+	std::string MakeMeta(const HYGUID& uid, const std::string& type)
+	{
+		return "{\n \"type\": \"" + type + "\",\n \"uid\": \"" + std::string(uid) + "\"\n}\n";
+	}
+
+	/**
+	@brief Fill a directory like a project : directories of directories of assets, each one a resource file and its .meta
+	*/
+	void MakeProject(const Tests::TemporaryDirectory& project, size_t directoryCount, size_t subDirectoryCount, size_t assetCount, size_t fileSize)
+	{
+		const std::string content(fileSize, 'x');
+
+		for (size_t d = 0; d < directoryCount; ++d)
+		{
+			for (size_t s = 0; s < subDirectoryCount; ++s)
+			{
+				const std::string directory = "Assets" + std::to_string(d) + "/Folder" + std::to_string(s) + "/";
+				for (size_t a = 0; a < assetCount; ++a)
+				{
+					const std::string name = directory + "Asset" + std::to_string(a) + ".mat";
+					project.WriteFile(name, content);
+					project.WriteFile(name + ".meta", MakeMeta(HYGUID::NewGUID(), "Material"));
+				}
+			}
+		}
+	}
+}
+
+TEST_CASE("AssetDatabase - Build, save and reload the manifest")
+{
+	Tests::TemporaryDirectory project("AssetDatabaseManifest");
+	MakeProject(project, 3, 2, 5, 16);
+
+	const std::string root = project.Path().string();
+	Tests::TemporaryDirectory cache("AssetDatabaseCache");
+	const std::string manifest = (cache.Path() / "Manifest.hydb").string();
+
+	ResourcesTaskPool pool;
+
+	AssetDatabase built(root, manifest);
+	built.Refresh(pool);
+	CHECK(!built.GetStats().manifestLoaded);
+	REQUIRE(built.GetRecords().size() == 30);
+
+	const HYGUID first = built.GetRecords()[0].uid;
+	const HYGUID second = built.GetRecords()[1].uid;
+	built.SetDependencies(first, { second });
+	CHECK(built.Save());
+
+	AssetDatabase loaded(root, manifest);
+	loaded.Refresh(pool);
+
+	const AssetDatabase::RefreshStats& stats = loaded.GetStats();
+	CHECK(stats.manifestLoaded);
+	CHECK(stats.reusedRecords == 30 && stats.parsedRecords == 0 && stats.removedRecords == 0 && stats.scannedDirectories == 0);
+
+	for (const AssetRecord& record : built.GetRecords())
+	{
+		const AssetRecord* reloaded = loaded.GetRecord(record.uid);
+		REQUIRE(reloaded != nullptr);
+		CHECK(reloaded->path == record.path);
+		CHECK(reloaded->typeName == "Material");
+		CHECK(reloaded->fileSize == 16);
+	}
+
+	REQUIRE(loaded.GetRecord(first) != nullptr);
+	CHECK(loaded.GetRecord(first)->dependencies == std::vector<HYGUID>{ second });
+}
+
+TEST_CASE("AssetDatabase - A .meta edited in place is parsed again")
+{
+	Tests::TemporaryDirectory project("AssetDatabaseMetaEdit");
+	MakeProject(project, 1, 1, 4, 16);
+
+	const std::string root = project.Path().string();
+	Tests::TemporaryDirectory cache("AssetDatabaseCache");
+	const std::string manifest = (cache.Path() / "Manifest.hydb").string();
+
+	ResourcesTaskPool pool;
+
+	AssetDatabase built(root, manifest);
+	built.Refresh(pool);
+	REQUIRE(built.GetRecords().size() == 4);
+	CHECK(built.Save());
+
+	//	Rewrite the .meta of an asset, with a write time set explicitly so it differs whatever the file system precision.
+	//	The time of the directory is restored : only the .meta tells that the asset changed
+	const AssetRecord edited = built.GetRecords()[2];
+	const fs::path metaPath = edited.path + ".meta";
+	const fs::path directory = metaPath.parent_path();
+	const fs::file_time_type directoryTime = fs::last_write_time(directory);
+	const fs::file_time_type metaTime = fs::last_write_time(metaPath);
+
+	const HYGUID newUID = HYGUID::NewGUID();
+	{
+		std::ofstream file(metaPath, std::ios::trunc);
+		file << MakeMeta(newUID, "Texture");
+	}
+	fs::last_write_time(metaPath, metaTime + std::chrono::seconds(2));
+	fs::last_write_time(directory, directoryTime);
+
+	AssetDatabase refreshed(root, manifest);
+	refreshed.Refresh(pool);
+
+	const AssetDatabase::RefreshStats& stats = refreshed.GetStats();
+	CHECK(stats.manifestLoaded);
+	CHECK(stats.scannedDirectories == 0);
+	CHECK(stats.parsedRecords == 1 && stats.reusedRecords == 3);
+
+	CHECK(refreshed.GetRecord(edited.uid) == nullptr);
+	REQUIRE(refreshed.GetRecord(newUID) != nullptr);
+	CHECK(refreshed.GetRecord(newUID)->typeName == "Texture");
+	CHECK(refreshed.GetRecords().size() == 4);
+}
+
+TEST_CASE("AssetDatabase - Added and removed directories and assets")
+{
+	Tests::TemporaryDirectory project("AssetDatabaseChanges");
+	MakeProject(project, 2, 2, 3, 16);
+
+	const std::string root = project.Path().string();
+	Tests::TemporaryDirectory cache("AssetDatabaseCache");
+	const std::string manifest = (cache.Path() / "Manifest.hydb").string();
+
+	ResourcesTaskPool pool;
+
+	AssetDatabase built(root, manifest);
+	built.Refresh(pool);
+	REQUIRE(built.GetRecords().size() == 12);
+	CHECK(built.Save());
+
+	//	A new directory with two assets, a removed directory of three assets and an asset added in a known directory
+	project.WriteFile("Assets0/New/Added0.mat", "x");
+	project.WriteFile("Assets0/New/Added0.mat.meta", MakeMeta(HYGUID::NewGUID(), "Material"));
+	project.WriteFile("Assets0/New/Deeper/Added1.mat", "x");
+	project.WriteFile("Assets0/New/Deeper/Added1.mat.meta", MakeMeta(HYGUID::NewGUID(), "Material"));
+	fs::remove_all(project.Path() / "Assets1" / "Folder0");
+	project.WriteFile("Assets1/Folder1/Added2.mat", "x");
+	project.WriteFile("Assets1/Folder1/Added2.mat.meta", MakeMeta(HYGUID::NewGUID(), "Material"));
+
+	//	Directory times may have a coarse precision, make sure the changed ones differ
+	for (const char* changed : { "Assets0", "Assets1", "Assets1/Folder1" })
+		fs::last_write_time(project.Path() / changed, fs::last_write_time(project.Path() / changed) + std::chrono::seconds(2));
+
+	AssetDatabase refreshed(root, manifest);
+	refreshed.Refresh(pool);
+
+	const AssetDatabase::RefreshStats& stats = refreshed.GetStats();
+	CHECK(stats.parsedRecords == 3);
+	CHECK(stats.removedRecords == 3);
+	CHECK(refreshed.GetRecords().size() == 12);
+
+	size_t added = 0;
+	for (const AssetRecord& record : refreshed.GetRecords())
+		added += record.path.find("Added") != std::string::npos;
+	CHECK(added == 3);
+}
+
+//	Startup loading stages on a generated project, on a warm file system cache :
+//	the scan and meta parsing of the previous loader (one thread, every .meta parsed) against the AssetDatabase build
+//	and refresh on the resources task pool, and the file reads of the deserialization on one thread and on the pool
+BENCHMARK("AssetDatabase - Loading stages")
+{
+	Tests::TemporaryDirectory project("LoadingStages");
+	MakeProject(project, 16, 4, 80, 4096);
+
+	const std::string root = project.Path().string();
+	Tests::TemporaryDirectory cache("AssetDatabaseCache");
+	const std::string manifest = (cache.Path() / "Manifest.hydb").string();
+
+	ResourcesTaskPool pool;
+
+	//	Times are given per asset
+	std::vector<std::string> paths;
+	double serialParse = Tests::Measure([&]()
+		{
+			paths.clear();
+			for (const auto& entry : fs::recursive_directory_iterator(root))
+			{
+				if (entry.is_directory() || entry.path().extension() != ".meta")
+					continue;
+
+				std::ifstream file(entry.path());
+				nlohmann::json json = nlohmann::json::parse(file, nullptr, false);
+				if (!json.is_discarded() && json.contains("uid") && json.contains("type"))
+					paths.emplace_back(entry.path().parent_path().string() + "/" + entry.path().stem().string());
+			}
+		}, 1, 3);
+
+	const size_t assetCount = paths.size();
+	const std::string assets = std::to_string(assetCount) + " assets";
+	Tests::Report("Scan and meta parse, serial (previous loader)", serialParse / assetCount, assets);
+
+	AssetDatabase built(root, manifest);
+	double build = Tests::MeasureWithSetup([&]() { fs::remove(manifest); }, [&]() { built.Refresh(pool); }, assetCount, 3);
+	Tests::Report("AssetDatabase build, task pool", build, std::to_string(built.GetRecords().size()) + " records");
+
+	built.Save();
+
+	AssetDatabase refreshed(root, manifest);
+	double refresh = Tests::Measure([&]() { refreshed.Refresh(pool); }, assetCount, 3);
+	Tests::Report("AssetDatabase refresh, nothing changed", refresh, std::to_string(refreshed.GetStats().reusedRecords) + " records reused");
+
+	//	Deserialization reads and decodes each resource file, the read and a hash of the content stand in for it
+	std::vector<Hash128> hashes(assetCount);
+	Tests::Report("Resource file reads, serial", Tests::Measure([&]()
+		{
+			for (size_t i = 0; i < assetCount; ++i)
+				ContentHash::ComputeFile(paths[i], hashes[i]);
+		}, assetCount, 3), assets);
+
+	Tests::Report("Resource file reads, ParallelFor", Tests::Measure([&]()
+		{
+			pool.ParallelFor(assetCount, 32, [&](size_t begin, size_t end) {
+				for (size_t i = begin; i < end; ++i)
+					ContentHash::ComputeFile(paths[i], hashes[i]);
+				});
+		}, assetCount, 3), assets);
+
+	Tests::DoNotOptimize(hashes);
+}
@@ -0,0 +1,237 @@
+#include "TestFramework.hpp"
+
+#include <cmath>
+#include <array>
+#include <random>
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <algorithm>
+
+#include "Resources/Loaders/MeshOptimizer.hpp"
+
+namespace
+{
+	constexpr float Pi = 3.14159265358979f;
+
+	struct TestMesh
+	{
+		std::vector<Vertex> vertices;
+		std::vector<int> indices;
+	};
+
+	//	Shuffled triangles, as the source order of an exported mesh often is
+	void ShuffleTriangles(std::vector<int>& indices, unsigned int seed)
+	{
+		std::vector<std::array<int, 3>> triangles(indices.size() / 3);
+		for (size_t i = 0; i < triangles.size(); ++i)
+			triangles[i] = { indices[i * 3], indices[i * 3 + 1], indices[i * 3 + 2] };
+
+		std::shuffle(triangles.begin(), triangles.end(), std::mt19937(seed));
+
+		for (size_t i = 0; i < triangles.size(); ++i)
+			std::copy(triangles[i].begin(), triangles[i].end(), indices.begin() + i * 3);
+	}
+
+	TestMesh MakeGrid(int size)
+	{
+		TestMesh mesh;
+		for (int y = 0; y <= size; ++y)
+		{
+			for (int x = 0; x <= size; ++x)
+			{
+				Vertex& vertex = mesh.vertices.emplace_back();
+				vertex.position = Vector3(static_cast<float>(x), static_cast<float>(y), 0.f);
+				vertex.normal = Vector3(0.f, 0.f, 1.f);
+			}
+		}
+
+		for (int y = 0; y < size; ++y)
+		{
+			for (int x = 0; x < size; ++x)
+			{
+				const int corner = y * (size + 1) + x;
+				mesh.indices.insert(mesh.indices.end(), { corner, corner + 1, corner + size + 2, corner, corner + size + 2, corner + size + 1 });
+			}
+		}
+
+		ShuffleTriangles(mesh.indices, 1);
+		return mesh;
+	}
+
+	TestMesh MakeSphere(int rings, int segments)
+	{
+		TestMesh mesh;
+		for (int ring = 0; ring <= rings; ++ring)
+		{
+			const float theta = Pi * static_cast<float>(ring) / static_cast<float>(rings);
+			for (int segment = 0; segment <= segments; ++segment)
+			{
+				const float phi = 2.f * Pi * static_cast<float>(segment) / static_cast<float>(segments);
+
+				Vertex& vertex = mesh.vertices.emplace_back();
+				vertex.normal = Vector3(std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi));
+				vertex.position = vertex.normal;
+			}
+		}
+
+		for (int ring = 0; ring < rings; ++ring)
+		{
+			for (int segment = 0; segment < segments; ++segment)
+			{
+				const int corner = ring * (segments + 1) + segment;
+				const int below = corner + segments + 1;
+				mesh.indices.insert(mesh.indices.end(), { corner, below, corner + 1, corner + 1, below, below + 1 });
+			}
+		}
+
+		ShuffleTriangles(mesh.indices, 2);
+		return mesh;
+	}
+
+	//	Triangles as the original vertices they use, rotated to start at the lowest one so the winding is kept
+	std::vector<std::array<int, 3>> GetTriangleSet(const std::vector<int>& indices, const std::vector<int>& originalVertices)
+	{
+		std::vector<std::array<int, 3>> triangles;
+		for (size_t i = 0; i + 2 < indices.size(); i += 3)
+		{
+			std::array<int, 3> triangle = { originalVertices[indices[i]], originalVertices[indices[i + 1]], originalVertices[indices[i + 2]] };
+			std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+			triangles.push_back(triangle);
+		}
+
+		std::sort(triangles.begin(), triangles.end());
+		return triangles;
+	}
+
+	//	Every pass of an import, the original index of each final vertex is returned
+	std::vector<int> Optimize(TestMesh& mesh)
+	{
+		MeshOptimizer::OptimizeVertexCache(mesh.indices, mesh.vertices.size());
+		MeshOptimizer::OptimizeOverdraw(mesh.indices, mesh.vertices);
+
+		std::vector<unsigned int> remap;
+		const size_t vertexCount = MeshOptimizer::OptimizeVertexFetch(mesh.indices, mesh.vertices.size(), remap);
+
+		std::vector<int> originalVertices(vertexCount);
+		for (size_t i = 0; i < remap.size(); ++i)
+		{
+			if (remap[i] != MeshOptimizer::UnusedVertex)
+				originalVertices[remap[i]] = static_cast<int>(i);
+		}
+
+		MeshOptimizer::RemapVertices(mesh.vertices, remap, vertexCount);
+		return originalVertices;
+	}
+
+	std::string Ratio(float value)
+	{
+		char buffer[16];
+		std::snprintf(buffer, sizeof(buffer), "%.2f", value);
+		return buffer;
+	}
+}
+
+TEST_CASE("MeshOptimizer - The passes keep every triangle and its winding")
+{
+	for (TestMesh mesh : { MakeGrid(40), MakeSphere(24, 32) })
+	{
+		std::vector<int> identity(mesh.vertices.size());
+		for (size_t i = 0; i < identity.size(); ++i)
+			identity[i] = static_cast<int>(i);
+
+		const std::vector<std::array<int, 3>> original = GetTriangleSet(mesh.indices, identity);
+		const std::vector<Vertex> originalVertices = mesh.vertices;
+
+		const std::vector<int> sources = Optimize(mesh);
+		CHECK(GetTriangleSet(mesh.indices, sources) == original);
+
+		// The vertices follow their new indices
+		for (size_t i = 0; i < mesh.vertices.size(); ++i)
+			CHECK(mesh.vertices[i].position == originalVertices[sources[i]].position);
+	}
+}
+
+TEST_CASE("MeshOptimizer - Vertex cache misses are cut")
+{
+	TestMesh grid = MakeGrid(100);
+	const MeshOptimizer::VertexCacheStats before = MeshOptimizer::AnalyzeVertexCache(grid.indices, grid.vertices.size());
+
+	MeshOptimizer::OptimizeVertexCache(grid.indices, grid.vertices.size());
+	const MeshOptimizer::VertexCacheStats after = MeshOptimizer::AnalyzeVertexCache(grid.indices, grid.vertices.size());
+
+	CHECK(before.triangleCount == after.triangleCount && before.vertexCount == after.vertexCount);
+	CHECK(before.ACMR > 2.5f);
+	CHECK(after.ACMR < 0.8f);
+	CHECK(after.ATVR < 1.5f);
+
+	// The overdraw clusters stay within their ACMR threshold of the cache optimized order
+	TestMesh sphere = MakeSphere(48, 64);
+	MeshOptimizer::OptimizeVertexCache(sphere.indices, sphere.vertices.size());
+	const float optimizedACMR = MeshOptimizer::AnalyzeVertexCache(sphere.indices, sphere.vertices.size()).ACMR;
+
+	MeshOptimizer::OptimizeOverdraw(sphere.indices, sphere.vertices);
+	CHECK(MeshOptimizer::AnalyzeVertexCache(sphere.indices, sphere.vertices.size()).ACMR <= optimizedACMR * 1.05f + 0.01f);
+}
+
+TEST_CASE("MeshOptimizer - Vertex fetch order and unused vertices")
+{
+	std::vector<int> indices = { 4, 2, 0, 0, 2, 3 };
+
+	std::vector<unsigned int> remap;
+	CHECK(MeshOptimizer::OptimizeVertexFetch(indices, 6, remap) == 4);
+	CHECK(indices == std::vector<int>({ 0, 1, 2, 2, 1, 3 }));
+	CHECK(remap == std::vector<unsigned int>({ 2, MeshOptimizer::UnusedVertex, 1, 3, 0, MeshOptimizer::UnusedVertex }));
+
+	std::vector<int> weights = { 10, 11, 12, 13, 14, 15 };
+	MeshOptimizer::RemapVertices(weights, remap, 4);
+	CHECK(weights == std::vector<int>({ 14, 12, 10, 13 }));
+}
+
+TEST_CASE("MeshOptimizer - The output is deterministic")
+{
+	TestMesh first = MakeSphere(32, 48);
+	TestMesh second = first;
+
+	Optimize(first);
+	Optimize(second);
+
+	CHECK(first.indices == second.indices);
+}
+
+//	Cost of the import passes and the cache misses before and after them, on shuffled meshes
+BENCHMARK("MeshOptimizer - ACMR and ATVR of the import passes")
+{
+	struct Case
+	{
+		std::string name;
+		TestMesh mesh;
+	};
+
+	for (const Case& test : { Case{ "Grid 256x256", MakeGrid(256) }, Case{ "Sphere 256x256", MakeSphere(256, 256) } })
+	{
+		const size_t triangleCount = test.mesh.indices.size() / 3;
+		const MeshOptimizer::VertexCacheStats source = MeshOptimizer::AnalyzeVertexCache(test.mesh.indices, test.mesh.vertices.size());
+
+		TestMesh mesh;
+		const double cacheTime = Tests::MeasureWithSetup([&]() { mesh = test.mesh; },
+			[&]() { MeshOptimizer::OptimizeVertexCache(mesh.indices, mesh.vertices.size()); }, triangleCount, 3);
+		const MeshOptimizer::VertexCacheStats cacheOptimized = MeshOptimizer::AnalyzeVertexCache(mesh.indices, mesh.vertices.size());
+
+		const std::vector<int> cacheOptimizedIndices = mesh.indices;
+		const double overdrawTime = Tests::MeasureWithSetup([&]() { mesh.indices = cacheOptimizedIndices; },
+			[&]() { MeshOptimizer::OptimizeOverdraw(mesh.indices, mesh.vertices); }, triangleCount, 3);
+		const MeshOptimizer::VertexCacheStats overdrawOptimized = MeshOptimizer::AnalyzeVertexCache(mesh.indices, mesh.vertices.size());
+
+		const std::vector<int> overdrawIndices = mesh.indices;
+		std::vector<unsigned int> remap;
+		const double fetchTime = Tests::MeasureWithSetup([&]() { mesh.indices = overdrawIndices; },
+			[&]() { MeshOptimizer::OptimizeVertexFetch(mesh.indices, mesh.vertices.size(), remap); }, triangleCount, 3);
+
+		const std::string prefix = test.name + ", " + std::to_string(triangleCount) + " triangles : ";
+		Tests::Report(prefix + "vertex cache", cacheTime, "per triangle, ACMR " + Ratio(source.ACMR) + " -> " + Ratio(cacheOptimized.ACMR)
+			+ ", ATVR " + Ratio(source.ATVR) + " -> " + Ratio(cacheOptimized.ATVR));
+		Tests::Report(prefix + "overdraw", overdrawTime, "per triangle, ACMR " + Ratio(overdrawOptimized.ACMR) + ", ATVR " + Ratio(overdrawOptimized.ATVR));
+		Tests::Report(prefix + "vertex fetch", fetchTime, "per triangle");
+	}
+}
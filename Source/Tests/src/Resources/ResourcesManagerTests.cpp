@@ -0,0 +1,220 @@
+#include "TestFramework.hpp"
+
+#include <atomic>
+#include <thread>
+#include <random>
+#include <string>
+#include <vector>
+#include <unordered_set>
+
+#include "Resources/ResourcesManager.hpp"
+
+namespace
+{
+	class TestResource : public Resource
+	{
+	public:
+		TestResource(const HYGUID& id) : Resource(id, "TestResource")
+		{
+			m_type = RESOURCE_TYPE::MATERIAL;
+		}
+	};
+
+	std::string SharedPath(size_t index)
+	{
+		return "Assets/Stress/Resource" + std::to_string(index) + ".test";
+	}
+
+	//	Every stored resource must be found by its GUID, path and type, and every indexed resource must be stored
+	void CheckIndexConsistency(ResourcesManager& manager)
+	{
+		std::vector<Resource*> resources = manager.GetResources();
+		std::unordered_set<Resource*> stored(resources.begin(), resources.end());
+
+		for (Resource* resource : resources)
+		{
+			CHECK(manager.GetResource(resource->GetUID()) == resource);
+
+			if (!resource->GetFilepath().empty())
+				CHECK(manager.GetResourceByPath(resource->GetFilepath()) != nullptr);
+		}
+
+		size_t listed = 0;
+		for (size_t type = 0; type <= static_cast<size_t>(RESOURCE_TYPE::UNKNOWN); ++type)
+		{
+			for (Resource* resource : manager.GetResourcesList(static_cast<RESOURCE_TYPE>(type)))
+			{
+				CHECK(stored.contains(resource));
+				CHECK(resource->GetType() == static_cast<RESOURCE_TYPE>(type));
+				listed++;
+			}
+		}
+
+		CHECK(listed == resources.size());
+	}
+}
+
+TEST_CASE("ResourcesManager - A path is created once")
+{
+	ResourcesManager manager;
+
+	constexpr int ThreadCount = 8;
+	std::vector<TestResource*> results(ThreadCount, nullptr);
+	std::atomic<int> createdCount = 0;
+
+	std::vector<std::thread> threads;
+	for (int t = 0; t < ThreadCount; ++t)
+	{
+		threads.emplace_back([&, t]()
+			{
+				bool created = false;
+				results[t] = manager.GetOrCreateResource<TestResource>("Assets/Shared.test", created);
+				createdCount += created;
+			});
+	}
+
+	for (std::thread& thread : threads)
+		thread.join();
+
+	CHECK(createdCount == 1);
+	for (TestResource* result : results)
+		CHECK(result != nullptr && result == results[0]);
+
+	CHECK(manager.GetResources().size() == 1);
+	CHECK(manager.GetResourceByPath("Assets/Shared.test") == results[0]);
+	CHECK(manager.GetResourceByFilename("Shared.test") == results[0]);
+}
+
+TEST_CASE("ResourcesManager - Destroyed and renamed resources leave the indices")
+{
+	ResourcesManager manager;
+
+	TestResource* resource = manager.CreateResource<TestResource>();
+	resource->SetFileInfo("Assets/Before.test");
+	CHECK(manager.GetResourceByPath("Assets/Before.test") == resource);
+
+	resource->SetFileInfo("Assets/After.test");
+	CHECK(!manager.HasResourceByPath("Assets/Before.test"));
+	CHECK(manager.GetResourceByFilename("After.test") == resource);
+
+	resource->SetType(RESOURCE_TYPE::TEXTURE);
+	CHECK(manager.GetResourcesList(RESOURCE_TYPE::MATERIAL).empty());
+	CHECK(manager.GetResourcesList(RESOURCE_TYPE::TEXTURE).size() == 1);
+
+	HYGUID id = resource->GetUID();
+	manager.DestroyResource(id);
+	manager.DestroyResource(id);
+
+	CHECK(!manager.HasResource(id));
+	CHECK(!manager.HasResourceByPath("Assets/After.test"));
+	CHECK(!manager.HasResourceByFilename("After.test"));
+	CHECK(manager.GetResourcesList(RESOURCE_TYPE::TEXTURE).empty());
+	CheckIndexConsistency(manager);
+}
+
+//	Creations by path and GUID and lookups on several threads, while one thread destroys whatever it finds in the registry,
+//	including resources being inserted and indexed at the same time, and renames and retypes its own resources.
+//	Only the mutating thread dereferences the resources, so none is read after being destroyed
+TEST_CASE("ResourcesManager - Concurrent creations, destructions and lookups")
+{
+	ResourcesManager manager;
+
+	constexpr int ThreadCount = 6;
+	constexpr int Iterations = 20000;
+	constexpr size_t PathCount = 64;
+
+	std::atomic<bool> running = true;
+	std::atomic<size_t> totalFound = 0;
+
+	std::thread mutator([&]()
+		{
+			std::mt19937 random(1);
+			size_t renamed = 0;
+
+			while (running)
+			{
+				//	Destroy anything, even a resource being inserted by another thread
+				for (Resource* resource : manager.GetResources())
+				{
+					if (random() % 4 == 0)
+						manager.DestroyResource(resource->GetUID());
+				}
+
+				//	Rename and retype its own resources, whose fields no other thread writes
+				for (int i = 0; i < 16; ++i)
+				{
+					TestResource* resource = manager.CreateResource<TestResource>();
+					resource->SetFileInfo("Assets/Renamed/Resource" + std::to_string(renamed++) + ".test");
+					resource->SetType(random() % 2 ? RESOURCE_TYPE::TEXTURE : RESOURCE_TYPE::MATERIAL);
+
+					if (random() % 2)
+						manager.DestroyResource(resource->GetUID());
+				}
+			}
+		});
+
+	std::vector<std::thread> threads;
+	for (int t = 0; t < ThreadCount; ++t)
+	{
+		threads.emplace_back([&, t]()
+			{
+				std::mt19937 random(100 + t);
+				size_t found = 0;
+
+				for (int i = 0; i < Iterations; ++i)
+				{
+					const std::string path = SharedPath(random() % PathCount);
+
+					switch (random() % 6)
+					{
+					case 0:
+					{
+						bool created = false;
+						found += manager.GetOrCreateResource<TestResource>(path, created) != nullptr;
+						break;
+					}
+					case 1:
+						found += manager.CreateResource<TestResource>() != nullptr;
+						break;
+					case 2:
+						found += manager.GetResourceByPath(path) != nullptr;
+						break;
+					case 3:
+						found += manager.HasResourceByFilename("Resource" + std::to_string(random() % PathCount) + ".test");
+						break;
+					case 4:
+						found += manager.GetResourcesList(RESOURCE_TYPE::MATERIAL).size();
+						break;
+					default:
+						found += manager.GetResourcesNamesList(RESOURCE_TYPE::TEXTURE).size();
+						break;
+					}
+				}
+
+				totalFound += found;
+			});
+	}
+
+	for (std::thread& thread : threads)
+		thread.join();
+
+	running = false;
+	mutator.join();
+
+	Tests::DoNotOptimize(totalFound);
+
+	CheckIndexConsistency(manager);
+
+	//	Renames never reuse a shared path, each one is owned by one resource at most
+	for (size_t i = 0; i < PathCount; ++i)
+	{
+		size_t owners = 0;
+		for (Resource* resource : manager.GetResources())
+			owners += resource->GetFilepath() == SharedPath(i);
+
+		CHECK(owners <= 1);
+		CHECK(manager.HasResourceByPath(SharedPath(i)) == (owners == 1));
+	}
+
+	CHECK(Tests::GetLogCounters().errors == 0);
+}
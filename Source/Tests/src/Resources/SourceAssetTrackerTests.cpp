@@ -0,0 +1,204 @@
+#include "TestFramework.hpp"
+
+#include <map>
+#include <chrono>
+#include <random>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <filesystem>
+
+#include "Core/ResourcesTaskPool.hpp"
+#include "Resources/SourceAssetTracker.hpp"
+#include "Resources/Loaders/ResourcesLoader.hpp"
+
+namespace fs = std::filesystem;
+
+namespace
+{
+	const char* SourceExtensions[] = { ".fbx", ".png", ".wav" };
+
+	//	Tree of source files with the resource files of their imports, spread over nested directories
+	std::vector<std::string> MakeProject(const Tests::TemporaryDirectory& directory, size_t directoryCount, size_t filesPerDirectory, size_t maxFileSize)
+	{
+		std::mt19937 random(3);
+		std::vector<std::string> sources;
+
+		for (size_t folder = 0; folder < directoryCount; ++folder)
+		{
+			const std::string folderPath = "Assets/Group" + std::to_string(folder % 8) + "/Folder" + std::to_string(folder) + "/";
+			for (size_t file = 0; file < filesPerDirectory; ++file)
+			{
+				const std::string name = folderPath + "Asset" + std::to_string(file);
+				const std::string content(maxFileSize / 8 + random() % maxFileSize, static_cast<char>('a' + random() % 26));
+
+				sources.push_back(directory.WriteFile(name + SourceExtensions[file % 3], content).string());
+				directory.WriteFile(name + ".texture", "resource");
+			}
+		}
+
+		return sources;
+	}
+
+	//	Work of LoadNotCachedResources on each focus before the tracker : every directory is enumerated and every source file
+	//	is checked for its resource file, the content is not read
+	size_t WalkProject(const fs::path& path)
+	{
+		size_t sourceCount = 0;
+		for (const auto& entry : fs::directory_iterator(path))
+		{
+			if (entry.is_directory())
+			{
+				sourceCount += WalkProject(entry.path());
+				continue;
+			}
+
+			const ExtensionType type = ResourcesLoader::GetExtensionType(entry.path().extension().string());
+			if (type == ExtensionType::MODEL || type == ExtensionType::TEXTURE || type == ExtensionType::SOUND)
+			{
+				fs::path resourcePath = entry.path();
+				sourceCount += fs::exists(resourcePath.replace_extension(".texture"));
+			}
+		}
+
+		return sourceCount;
+	}
+
+	//	Write times have a coarse resolution on some file systems : a modified file is moved forward in time
+	void ModifyFile(const std::string& path, const std::string& content)
+	{
+		const fs::file_time_type time = fs::last_write_time(path);
+		{
+			std::ofstream file(path, std::ios::binary | std::ios::trunc);
+			file << content;
+		}
+		fs::last_write_time(path, time + std::chrono::seconds(2));
+	}
+
+	size_t CountChanges(const std::vector<SourceAssetTracker::Change>& changes, SourceAssetTracker::EChange type)
+	{
+		size_t count = 0;
+		for (const SourceAssetTracker::Change& change : changes)
+			count += change.type == type;
+
+		return count;
+	}
+}
+
+TEST_CASE("SourceAssetTracker - Only changed contents and settings are reported")
+{
+	Tests::TemporaryDirectory directory("SourceAssetTracker");
+	const std::vector<std::string> sources = MakeProject(directory, 4, 6, 256);
+	const std::string root = (directory.Path() / "Assets").string();
+	const std::string manifest = (directory.Path() / "Manifest.hysa").string();
+
+	ResourcesTaskPool pool;
+	std::map<std::string, std::string> settings;
+	const SourceAssetTracker::SettingsGetter getSettings = [&settings](const std::string& path) {
+		auto it = settings.find(path);
+		return it == settings.end() ? std::string() : it->second;
+		};
+
+	std::vector<SourceAssetTracker::Change> changes;
+	{
+		// Every file is added by the refresh building the manifest
+		SourceAssetTracker tracker(root, manifest);
+		tracker.Refresh(pool, getSettings, changes);
+		CHECK(changes.size() == sources.size() && CountChanges(changes, SourceAssetTracker::EChange::ADDED) == sources.size());
+		CHECK(!tracker.GetStats().manifestLoaded);
+		CHECK(tracker.Save());
+	}
+
+	SourceAssetTracker tracker(root, manifest);
+	tracker.Refresh(pool, getSettings, changes);
+	CHECK(changes.empty());
+	CHECK(tracker.GetStats().manifestLoaded && tracker.GetStats().hashedFiles == 0);
+
+	// A file written again with the same content is hashed but not reported
+	std::ifstream input(sources[0], std::ios::binary);
+	const std::string firstContent((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+	input.close();
+
+	ModifyFile(sources[0], firstContent);
+	tracker.Refresh(pool, getSettings, changes);
+	CHECK(changes.empty());
+	CHECK(tracker.GetStats().hashedFiles == 1);
+
+	ModifyFile(sources[1], "changed");
+	settings[sources[2]] = "{ \"layout\": 1 }";
+	const std::string added = directory.WriteFile("Assets/Group1/Folder1/Added.png", "new").string();
+	fs::remove(sources[3]);
+
+	tracker.Refresh(pool, getSettings, changes);
+	REQUIRE(changes.size() == 4);
+	CHECK(CountChanges(changes, SourceAssetTracker::EChange::MODIFIED) == 2);
+	CHECK(CountChanges(changes, SourceAssetTracker::EChange::ADDED) == 1);
+	CHECK(CountChanges(changes, SourceAssetTracker::EChange::REMOVED) == 1);
+
+	// Paths of a file watcher are checked alone
+	ModifyFile(added, "newer");
+	tracker.RefreshFiles(pool, getSettings, { added }, changes);
+	REQUIRE(changes.size() == 1);
+	CHECK(changes[0].path == added && changes[0].type == SourceAssetTracker::EChange::MODIFIED);
+	CHECK(tracker.GetStats().checkedFiles == 1);
+
+	tracker.Refresh(pool, getSettings, changes);
+	CHECK(changes.empty());
+}
+
+//	Latency of a focus of the editor window on a project of source files : the walk done before the tracker, the first refresh
+//	hashing every file, then refreshes with nothing changed, one file modified, one file added, and one path from the file watcher
+BENCHMARK("SourceAssetTracker - Focus refresh against the full walk")
+{
+	Tests::TemporaryDirectory directory("SourceAssetTrackerBenchmark");
+	const std::vector<std::string> sources = MakeProject(directory, 64, 40, 32 * 1024);
+	const std::string root = (directory.Path() / "Assets").string();
+	const std::string manifest = (directory.Path() / "Manifest.hysa").string();
+
+	ResourcesTaskPool pool;
+	const SourceAssetTracker::SettingsGetter getSettings = [](const std::string&) { return std::string(); };
+	std::vector<SourceAssetTracker::Change> changes;
+
+	const std::string prefix = std::to_string(sources.size()) + " source files : ";
+
+	const double walk = Tests::Measure([&]() { Tests::DoNotOptimize(WalkProject(root)); }, 1, 5);
+	Tests::Report(prefix + "full walk, before", walk, "per focus");
+
+	// A first refresh without manifest hashes every file, then the records are saved
+	const double build = Tests::MeasureWithSetup([&]() { fs::remove(manifest); },
+		[&]() { SourceAssetTracker tracker(root, manifest); tracker.Refresh(pool, getSettings, changes); tracker.Save(); }, 1, 3);
+	CHECK(changes.size() == sources.size());
+	Tests::Report(prefix + "manifest build", build, "every file hashed");
+
+	SourceAssetTracker tracker(root, manifest);
+	tracker.Refresh(pool, getSettings, changes);
+
+	const double idle = Tests::Measure([&]() { tracker.Refresh(pool, getSettings, changes); }, 1, 5);
+	CHECK(changes.empty());
+	Tests::Report(prefix + "refresh, nothing changed", idle, "per focus");
+
+	// Each sample changes another file, with a content of another size
+	size_t modified = 0;
+	auto modifyNext = [&]() {
+		const std::string& path = sources[modified % sources.size()];
+		ModifyFile(path, "modified " + std::to_string(modified++));
+		return path;
+		};
+
+	const double modify = Tests::MeasureWithSetup([&]() { modifyNext(); },
+		[&]() { tracker.Refresh(pool, getSettings, changes); }, 1, 5);
+	CHECK(changes.size() == 1);
+	Tests::Report(prefix + "refresh, one file modified", modify, "per focus");
+
+	size_t addedCount = 0;
+	const double add = Tests::MeasureWithSetup([&]() { directory.WriteFile("Assets/Group0/Folder0/Added" + std::to_string(addedCount++) + ".png", "new"); },
+		[&]() { tracker.Refresh(pool, getSettings, changes); }, 1, 5);
+	CHECK(changes.size() == 1);
+	Tests::Report(prefix + "refresh, one file added", add, "per focus");
+
+	std::string watched;
+	const double watcher = Tests::MeasureWithSetup([&]() { watched = modifyNext(); },
+		[&]() { tracker.RefreshFiles(pool, getSettings, { watched }, changes); }, 1, 5);
+	CHECK(changes.size() == 1);
+	Tests::Report(prefix + "file watcher path", watcher, "per focus");
+}
@@ -0,0 +1,246 @@
+#include "TestFramework.hpp"
+
+#include <random>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <cstring>
+#include <cstdlib>
+#include <iterator>
+#include <glad/gl.h>
+#include <stb_image/stb_image.h>
+#include <stb_image/stb_image_write.h>
+
+#include "Resources/Loaders/TextureCache.hpp"
+#include "Resources/Resource/Texture.hpp"
+
+namespace
+{
+	//	Default flags of a texture
+	Flags<EImageSTB> DefaultFlags()
+	{
+		Flags<EImageSTB> flags;
+		flags.Enable(EImageSTB::IMG_FLIP, EImageSTB::IMG_GEN_MIPMAPS, EImageSTB::IMG_WRAP_REPEAT);
+		return flags;
+	}
+
+	/**
+	@brief RGBA image with a gradient and some noise, close to the content of a real texture
+	*/
+	std::vector<unsigned char> MakeImage(int width, int height, unsigned int seed)
+	{
+		std::mt19937 random(seed);
+		std::vector<unsigned char> pixels(static_cast<size_t>(width) * height * 4);
+
+		for (int y = 0; y < height; ++y)
+		{
+			for (int x = 0; x < width; ++x)
+			{
+				unsigned char* pixel = &pixels[(static_cast<size_t>(y) * width + x) * 4];
+				pixel[0] = static_cast<unsigned char>(x * 255 / width);
+				pixel[1] = static_cast<unsigned char>(y * 255 / height);
+				pixel[2] = static_cast<unsigned char>(random() % 64 + 96);
+				pixel[3] = 255;
+			}
+		}
+
+		return pixels;
+	}
+
+	TextureData MakeTextureData(std::vector<unsigned char>& pixels, int width, int height)
+	{
+		TextureData data;
+		data.width = width;
+		data.height = height;
+		data.channels = 4;
+		data.type = GL_UNSIGNED_BYTE;
+		data.format = GL_RGBA;
+		data.internalFormat = GL_RGBA;
+		data.data = pixels.data();
+		return data;
+	}
+}
+
+TEST_CASE("TextureCache - Cook, save and load round trip")
+{
+	Tests::TemporaryDirectory directory("TextureCache");
+	const std::string source = directory.WriteFile("Texture.png", "source image").string();
+	const std::string cachePath = (directory.Path() / "Texture.texcache").string();
+
+	std::vector<unsigned char> pixels = MakeImage(64, 32, 1);
+	TextureData decoded = MakeTextureData(pixels, 64, 32);
+
+	TextureData cooked;
+	REQUIRE(TextureCache::Cook(decoded, DefaultFlags(), cooked));
+
+	// 64x32 down to 1x1
+	REQUIRE(cooked.mipLevels.size() == 7);
+	CHECK(cooked.mipLevels[0].width == 64 && cooked.mipLevels[0].height == 32);
+	CHECK(cooked.mipLevels[5].width == 2 && cooked.mipLevels[5].height == 1);
+	CHECK(cooked.mipLevels[6].width == 1 && cooked.mipLevels[6].height == 1);
+	CHECK(std::memcmp(cooked.data, pixels.data(), pixels.size()) == 0);
+
+	REQUIRE(TextureCache::Save(cachePath, source, DefaultFlags(), cooked));
+
+	TextureData loaded;
+	REQUIRE(TextureCache::Load(cachePath, source, DefaultFlags(), loaded));
+	CHECK(loaded.width == 64 && loaded.height == 32 && loaded.channels == 4 && loaded.type == GL_UNSIGNED_BYTE && !loaded.compressed);
+	REQUIRE(loaded.mipLevels.size() == cooked.mipLevels.size());
+
+	for (size_t i = 0; i < loaded.mipLevels.size(); ++i)
+	{
+		const TextureMipLevel& level = loaded.mipLevels[i];
+		CHECK(level.width == cooked.mipLevels[i].width && level.height == cooked.mipLevels[i].height && level.size == cooked.mipLevels[i].size);
+		CHECK(std::memcmp(loaded.data + level.offset, cooked.data + cooked.mipLevels[i].offset, level.size) == 0);
+	}
+
+	// Other flags use another cache
+	Flags<EImageSTB> otherFlags;
+	otherFlags.Enable(EImageSTB::IMG_GEN_MIPMAPS);
+
+	TextureData other;
+	CHECK(!TextureCache::Load(cachePath, source, otherFlags, other));
+	CHECK(other.data == nullptr);
+}
+
+TEST_CASE("TextureCache - A changed source or a broken file is not loaded")
+{
+	Tests::TemporaryDirectory directory("TextureCache");
+	const std::string source = directory.WriteFile("Texture.png", "source image").string();
+	const std::string cachePath = (directory.Path() / "Texture.texcache").string();
+
+	std::vector<unsigned char> pixels = MakeImage(16, 16, 2);
+	TextureData cooked;
+	REQUIRE(TextureCache::Cook(MakeTextureData(pixels, 16, 16), DefaultFlags(), cooked));
+	REQUIRE(TextureCache::Save(cachePath, source, DefaultFlags(), cooked));
+
+	TextureData loaded;
+	CHECK(TextureCache::Load(cachePath, source, DefaultFlags(), loaded));
+	loaded = TextureData();
+
+	// The size of the source changes
+	directory.WriteFile("Texture.png", "new source image");
+	CHECK(!TextureCache::Load(cachePath, source, DefaultFlags(), loaded));
+
+	REQUIRE(TextureCache::Save(cachePath, source, DefaultFlags(), cooked));
+	CHECK(TextureCache::Load(cachePath, source, DefaultFlags(), loaded));
+	loaded = TextureData();
+
+	// Truncated file, its levels point past its end
+	std::vector<char> content;
+	{
+		std::ifstream file(cachePath, std::ios::binary);
+		content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	}
+	{
+		std::ofstream file(cachePath, std::ios::binary | std::ios::trunc);
+		file.write(content.data(), static_cast<std::streamsize>(content.size() / 2));
+	}
+	CHECK(!TextureCache::Load(cachePath, source, DefaultFlags(), loaded));
+	CHECK(!TextureCache::Load((directory.Path() / "Missing.texcache").string(), source, DefaultFlags(), loaded));
+}
+
+TEST_CASE("TextureCache - Mips of a uniform image keep its color")
+{
+	//	The filter weights of every texel sum to 1, in linear and in sRGB space
+	std::vector<unsigned char> pixels(static_cast<size_t>(40) * 24 * 4);
+	for (size_t i = 0; i < pixels.size(); i += 4)
+	{
+		pixels[i] = 200;
+		pixels[i + 1] = 90;
+		pixels[i + 2] = 15;
+		pixels[i + 3] = 128;
+	}
+
+	for (bool isSRGB : { false, true })
+	{
+		Flags<EImageSTB> flags = DefaultFlags();
+		if (isSRGB)
+			flags.Enable(EImageSTB::IMG_SRGB);
+
+		TextureData cooked;
+		REQUIRE(TextureCache::Cook(MakeTextureData(pixels, 40, 24), flags, cooked));
+		REQUIRE(cooked.mipLevels.size() == 6);
+
+		for (const TextureMipLevel& level : cooked.mipLevels)
+		{
+			for (size_t i = level.offset; i < level.offset + level.size; i += 4)
+			{
+				CHECK(std::abs(cooked.data[i] - 200) <= 1);
+				CHECK(std::abs(cooked.data[i + 1] - 90) <= 1);
+				CHECK(std::abs(cooked.data[i + 2] - 15) <= 1);
+				CHECK(std::abs(cooked.data[i + 3] - 128) <= 1);
+			}
+		}
+	}
+}
+
+//	Startup over 1,000 textures : decode of the source PNG with stb_image (previous loads, the driver then generated the mips),
+//	first load that decodes, cooks and saves the cache, then later loads that map the .texcache
+BENCHMARK("TextureCache - Startup over 1,000 textures")
+{
+	constexpr size_t Count = 1000;
+	constexpr int Size = 128;
+
+	Tests::TemporaryDirectory directory("TextureCacheBenchmark");
+
+	std::vector<std::string> sources;
+	std::vector<std::string> caches;
+	for (size_t i = 0; i < Count; ++i)
+	{
+		std::vector<unsigned char> pixels = MakeImage(Size, Size, static_cast<unsigned int>(i));
+		sources.push_back((directory.Path() / ("Texture" + std::to_string(i) + ".png")).string());
+		caches.push_back((directory.Path() / ("Texture" + std::to_string(i) + ".texcache")).string());
+		stbi_write_png(sources.back().c_str(), Size, Size, 4, pixels.data(), Size * 4);
+	}
+
+	const Flags<EImageSTB> flags = DefaultFlags();
+	size_t loadedCount = 0;
+
+	double decodeTime = Tests::Measure([&]()
+		{
+			for (const std::string& source : sources)
+			{
+				int width = 0, height = 0, channels = 0;
+				unsigned char* pixels = stbi_load(source.c_str(), &width, &height, &channels, STBI_rgb_alpha);
+				loadedCount += pixels != nullptr;
+				stbi_image_free(pixels);
+			}
+		}, Count, 3);
+
+	double cookTime = Tests::Measure([&]()
+		{
+			for (size_t i = 0; i < Count; ++i)
+			{
+				TextureData decoded;
+				decoded.data = stbi_load(sources[i].c_str(), &decoded.width, &decoded.height, &decoded.channels, STBI_rgb_alpha);
+				decoded.channels = 4;
+				decoded.type = GL_UNSIGNED_BYTE;
+
+				TextureData cooked;
+				if (TextureCache::Cook(decoded, flags, cooked) && TextureCache::Save(caches[i], sources[i], flags, cooked))
+					loadedCount++;
+
+				stbi_image_free(decoded.data);
+			}
+		}, Count, 1);
+
+	size_t cachedBytes = 0;
+	double cachedTime = Tests::Measure([&]()
+		{
+			cachedBytes = 0;
+			for (size_t i = 0; i < Count; ++i)
+			{
+				TextureData cached;
+				if (TextureCache::Load(caches[i], sources[i], flags, cached))
+					cachedBytes += cached.mipLevels.back().offset + cached.mipLevels.back().size;
+			}
+		}, Count, 3);
+
+	Tests::DoNotOptimize(loadedCount);
+
+	const std::string note = std::to_string(Size) + "x" + std::to_string(Size) + " RGBA, per texture";
+	Tests::Report("Decode with stb_image, mips left to the driver", decodeTime, note);
+	Tests::Report("First load : decode, cook the mips and save", cookTime, note);
+	Tests::Report("Cached load : map the .texcache", cachedTime, note + ", " + std::to_string(cachedBytes / Count) + " bytes with the mips");
+}
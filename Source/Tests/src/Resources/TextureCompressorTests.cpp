@@ -0,0 +1,334 @@
+#include "TestFramework.hpp"
+
+#include <cmath>
+#include <random>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+#include "Resources/Loaders/TextureCompressor.hpp"
+
+namespace
+{
+	//	Reference decoders written from the format specifications, independent of the encoder
+
+	void DecodeColor565(uint16_t packed, int (&color)[3])
+	{
+		int r = (packed >> 11) & 31, g = (packed >> 5) & 63, b = packed & 31;
+		color[0] = (r << 3) | (r >> 2);
+		color[1] = (g << 2) | (g >> 4);
+		color[2] = (b << 3) | (b >> 2);
+	}
+
+	void DecodeColorBlock(const uint8_t* block, bool forceFourColors, uint8_t (&rgba)[16][4])
+	{
+		uint16_t color0 = static_cast<uint16_t>(block[0] | (block[1] << 8));
+		uint16_t color1 = static_cast<uint16_t>(block[2] | (block[3] << 8));
+		uint32_t indices = block[4] | (block[5] << 8) | (block[6] << 16) | (static_cast<uint32_t>(block[7]) << 24);
+
+		int palette[4][3];
+		DecodeColor565(color0, palette[0]);
+		DecodeColor565(color1, palette[1]);
+
+		// BC3 color blocks are always in 4 colors mode, BC1 ones use 3 colors and transparent black if color0 <= color1
+		const bool fourColors = forceFourColors || color0 > color1;
+		for (int c = 0; c < 3; ++c)
+		{
+			if (fourColors)
+			{
+				palette[2][c] = (2 * palette[0][c] + palette[1][c] + 1) / 3;
+				palette[3][c] = (palette[0][c] + 2 * palette[1][c] + 1) / 3;
+			}
+			else
+			{
+				palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+				palette[3][c] = 0;
+			}
+		}
+
+		for (int i = 0; i < 16; ++i)
+		{
+			int index = (indices >> (2 * i)) & 3;
+			for (int c = 0; c < 3; ++c)
+				rgba[i][c] = static_cast<uint8_t>(palette[index][c]);
+			rgba[i][3] = (!fourColors && index == 3) ? 0 : 255;
+		}
+	}
+
+	void DecodeSingleChannelBlock(const uint8_t* block, int channel, uint8_t (&rgba)[16][4])
+	{
+		int value0 = block[0], value1 = block[1];
+		uint64_t indices = 0;
+		for (int i = 0; i < 6; ++i)
+			indices |= static_cast<uint64_t>(block[2 + i]) << (8 * i);
+
+		int palette[8] = { value0, value1 };
+		if (value0 > value1)
+		{
+			for (int i = 1; i < 7; ++i)
+				palette[i + 1] = static_cast<int>(std::lround(((7 - i) * value0 + i * value1) / 7.f));
+		}
+		else
+		{
+			for (int i = 1; i < 5; ++i)
+				palette[i + 1] = static_cast<int>(std::lround(((5 - i) * value0 + i * value1) / 5.f));
+			palette[6] = 0;
+			palette[7] = 255;
+		}
+
+		for (int i = 0; i < 16; ++i)
+			rgba[i][channel] = static_cast<uint8_t>(palette[(indices >> (3 * i)) & 7]);
+	}
+
+	void DecodeBC7Block(const uint8_t* block, uint8_t (&rgba)[16][4])
+	{
+		int bit = 0;
+		auto read = [block, &bit](int count)
+			{
+				uint32_t value = 0;
+				for (int i = 0; i < count; ++i, ++bit)
+					value |= static_cast<uint32_t>((block[bit / 8] >> (bit % 8)) & 1) << i;
+				return value;
+			};
+
+		// Only mode 6 is produced by the encoder
+		if (read(7) != (1u << 6))
+		{
+			std::memset(rgba, 0, sizeof(rgba));
+			return;
+		}
+
+		int endpoints[2][4];
+		for (int c = 0; c < 4; ++c)
+		{
+			endpoints[0][c] = static_cast<int>(read(7));
+			endpoints[1][c] = static_cast<int>(read(7));
+		}
+
+		int pBits[2] = { static_cast<int>(read(1)), static_cast<int>(read(1)) };
+		for (int e = 0; e < 2; ++e)
+		{
+			for (int c = 0; c < 4; ++c)
+				endpoints[e][c] = (endpoints[e][c] << 1) | pBits[e];
+		}
+
+		constexpr int Weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+		for (int i = 0; i < 16; ++i)
+		{
+			int index = static_cast<int>(read(i == 0 ? 3 : 4));
+			for (int c = 0; c < 4; ++c)
+				rgba[i][c] = static_cast<uint8_t>(((64 - Weights[index]) * endpoints[0][c] + Weights[index] * endpoints[1][c] + 32) >> 6);
+		}
+	}
+
+	/**
+	@brief Decode a compressed image to RGBA, channels missing from the format are 0 (alpha 255)
+	*/
+	std::vector<uint8_t> DecodeImage(BlockFormat format, const std::vector<uint8_t>& compressed, int width, int height)
+	{
+		std::vector<uint8_t> image(static_cast<size_t>(width) * height * 4);
+		const size_t blockSize = TextureCompressor::GetBlockSize(format);
+		const uint8_t* block = compressed.data();
+
+		for (int by = 0; by < (height + 3) / 4; ++by)
+		{
+			for (int bx = 0; bx < (width + 3) / 4; ++bx, block += blockSize)
+			{
+				uint8_t texels[16][4] = {};
+				for (uint8_t (&texel)[4] : texels)
+					texel[3] = 255;
+
+				switch (format)
+				{
+				case BlockFormat::BC1: DecodeColorBlock(block, false, texels); break;
+				case BlockFormat::BC3: DecodeColorBlock(block + 8, true, texels); DecodeSingleChannelBlock(block, 3, texels); break;
+				case BlockFormat::BC4: DecodeSingleChannelBlock(block, 0, texels); break;
+				case BlockFormat::BC5: DecodeSingleChannelBlock(block, 0, texels); DecodeSingleChannelBlock(block + 8, 1, texels); break;
+				case BlockFormat::BC7: DecodeBC7Block(block, texels); break;
+				default: break;
+				}
+
+				for (int i = 0; i < 16; ++i)
+				{
+					int x = bx * 4 + i % 4, y = by * 4 + i / 4;
+					if (x < width && y < height)
+						std::memcpy(&image[(static_cast<size_t>(y) * width + x) * 4], texels[i], 4);
+				}
+			}
+		}
+
+		return image;
+	}
+
+	/**
+	@brief Smooth RGBA image with details and noise, alpha is a soft mask
+	*/
+	std::vector<uint8_t> MakeImage(int width, int height, unsigned int seed)
+	{
+		std::mt19937 random(seed);
+		std::normal_distribution<float> noise(0.f, 4.f);
+		std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * 4);
+
+		auto toByte = [](float value) { return static_cast<uint8_t>(std::clamp(value, 0.f, 255.f)); };
+
+		for (int y = 0; y < height; ++y)
+		{
+			for (int x = 0; x < width; ++x)
+			{
+				float u = static_cast<float>(x) / width, v = static_cast<float>(y) / height;
+				uint8_t* pixel = &pixels[(static_cast<size_t>(y) * width + x) * 4];
+				pixel[0] = toByte(128.f + 100.f * std::sin(u * 9.f + v * 3.f) + noise(random));
+				pixel[1] = toByte(128.f + 90.f * std::cos(v * 7.f - u * 2.f) + noise(random));
+				pixel[2] = toByte(60.f + 150.f * u * v + noise(random));
+				pixel[3] = toByte(255.f * (0.5f + 0.5f * std::sin(u * 5.f)) + noise(random));
+			}
+		}
+
+		return pixels;
+	}
+
+	/**
+	@brief Peak signal to noise ratio in dB over the given RGBA channels
+	*/
+	double ComputePSNR(const std::vector<uint8_t>& reference, const std::vector<uint8_t>& decoded, int firstChannel, int channelCount)
+	{
+		double squaredError = 0.0;
+		size_t count = 0;
+		for (size_t i = 0; i < reference.size(); i += 4)
+		{
+			for (int c = firstChannel; c < firstChannel + channelCount; ++c, ++count)
+			{
+				double difference = static_cast<double>(reference[i + c]) - decoded[i + c];
+				squaredError += difference * difference;
+			}
+		}
+
+		double meanError = squaredError / static_cast<double>(count);
+		return meanError == 0.0 ? 99.0 : 10.0 * std::log10(255.0 * 255.0 / meanError);
+	}
+
+	double CompressAndMeasure(BlockFormat format, const std::vector<uint8_t>& image, int width, int height, int channelCount)
+	{
+		std::vector<uint8_t> compressed(TextureCompressor::GetCompressedSize(format, width, height));
+		TextureCompressor::CompressImage(format, image.data(), width, height, 4, compressed.data());
+		return ComputePSNR(image, DecodeImage(format, compressed, width, height), 0, channelCount);
+	}
+}
+
+TEST_CASE("TextureCompressor - Formats chosen by the loading flags")
+{
+	auto choose = [](EImageSTB usage, bool fast, int channels, bool is16Bits)
+		{
+			Flags<EImageSTB> flags;
+			flags.Enable(EImageSTB::IMG_GEN_MIPMAPS, usage);
+			if (fast)
+				flags.Enable(EImageSTB::IMG_COMPRESS_FAST);
+
+			return TextureCompressor::ChooseFormat(flags, channels, is16Bits);
+		};
+
+	CHECK(choose(EImageSTB::IMG_COMPRESS_COLOR, false, 4, false) == BlockFormat::BC7);
+	CHECK(choose(EImageSTB::IMG_COMPRESS_COLOR, false, 3, false) == BlockFormat::BC7);
+	CHECK(choose(EImageSTB::IMG_COMPRESS_COLOR, true, 4, false) == BlockFormat::BC3);
+	CHECK(choose(EImageSTB::IMG_COMPRESS_COLOR, true, 3, false) == BlockFormat::BC1);
+	CHECK(choose(EImageSTB::IMG_COMPRESS_NORMAL, false, 3, false) == BlockFormat::BC5);
+	CHECK(choose(EImageSTB::IMG_COMPRESS_NORMAL, false, 1, false) == BlockFormat::NONE);
+	CHECK(choose(EImageSTB::IMG_COMPRESS_MASK, false, 1, false) == BlockFormat::BC4);
+	CHECK(choose(EImageSTB::IMG_COMPRESS_COLOR, false, 4, true) == BlockFormat::NONE);
+	CHECK(choose(EImageSTB::IMG_SRGB, false, 4, false) == BlockFormat::NONE);
+
+	CHECK(TextureCompressor::GetCompressedSize(BlockFormat::BC1, 13, 6) == 4 * 2 * 8);
+	CHECK(TextureCompressor::GetCompressedSize(BlockFormat::BC7, 1, 1) == 16);
+}
+
+TEST_CASE("TextureCompressor - PSNR of every format")
+{
+	constexpr int Width = 256;
+	constexpr int Height = 128;
+	std::vector<uint8_t> image = MakeImage(Width, Height, 3);
+
+	//	Channels kept by each format : BC7 and BC3 keep RGBA, BC1 RGB, BC5 RG, BC4 R
+	//	The noise of the image limits the formats with one line of colors per block to about 38 dB
+	CHECK(CompressAndMeasure(BlockFormat::BC7, image, Width, Height, 4) > 35.0);
+	CHECK(CompressAndMeasure(BlockFormat::BC3, image, Width, Height, 4) > 35.0);
+	CHECK(CompressAndMeasure(BlockFormat::BC1, image, Width, Height, 3) > 34.0);
+	CHECK(CompressAndMeasure(BlockFormat::BC5, image, Width, Height, 2) > 45.0);
+	CHECK(CompressAndMeasure(BlockFormat::BC4, image, Width, Height, 1) > 45.0);
+}
+
+TEST_CASE("TextureCompressor - Flat, two color and partial blocks")
+{
+	//	A single color block, and a block of two colors that BC7 endpoints can represent, decode without error
+	uint8_t flat[16 * 4];
+	uint8_t twoColors[16 * 4];
+	for (int i = 0; i < 16; ++i)
+	{
+		const uint8_t color[4] = { 200, 100, 50, 255 };
+		const uint8_t other[4] = { 20, 40, 60, 128 };
+		std::memcpy(&flat[i * 4], color, 4);
+		std::memcpy(&twoColors[i * 4], i % 3 == 0 ? other : color, 4);
+	}
+
+	for (BlockFormat format : { BlockFormat::BC4, BlockFormat::BC5, BlockFormat::BC7 })
+	{
+		std::vector<uint8_t> compressed(TextureCompressor::GetBlockSize(format));
+		TextureCompressor::CompressBlock(format, flat, compressed.data());
+
+		std::vector<uint8_t> reference(flat, flat + sizeof(flat));
+		std::vector<uint8_t> decoded = DecodeImage(format, compressed, 4, 4);
+		const int channels = format == BlockFormat::BC4 ? 1 : format == BlockFormat::BC5 ? 2 : 4;
+		CHECK(ComputePSNR(reference, decoded, 0, channels) > 45.0);
+	}
+
+	std::vector<uint8_t> compressed(16);
+	TextureCompressor::CompressBlock(BlockFormat::BC7, twoColors, compressed.data());
+	std::vector<uint8_t> reference(twoColors, twoColors + sizeof(twoColors));
+	CHECK(ComputePSNR(reference, DecodeImage(BlockFormat::BC7, compressed, 4, 4), 0, 4) > 40.0);
+
+	//	Partial blocks repeat their edge texels : a 5x3 image compresses like the 8x4 image of its repeated edges
+	std::vector<uint8_t> small = MakeImage(5, 3, 4);
+	std::vector<uint8_t> padded(8 * 4 * 4);
+	for (int y = 0; y < 4; ++y)
+	{
+		for (int x = 0; x < 8; ++x)
+			std::memcpy(&padded[(y * 8 + x) * 4], &small[(std::min(y, 2) * 5 + std::min(x, 4)) * 4], 4);
+	}
+
+	for (BlockFormat format : { BlockFormat::BC1, BlockFormat::BC7 })
+	{
+		std::vector<uint8_t> smallBlocks(TextureCompressor::GetCompressedSize(format, 5, 3));
+		std::vector<uint8_t> paddedBlocks(TextureCompressor::GetCompressedSize(format, 8, 4));
+		REQUIRE(smallBlocks.size() == paddedBlocks.size());
+
+		TextureCompressor::CompressImage(format, small.data(), 5, 3, 4, smallBlocks.data());
+		TextureCompressor::CompressImage(format, padded.data(), 8, 4, 4, paddedBlocks.data());
+		CHECK(smallBlocks == paddedBlocks);
+	}
+}
+
+//	Encode speed of every format, with the quality it reaches on the same image
+BENCHMARK("TextureCompressor - Encode speed and quality")
+{
+	constexpr int Size = 512;
+	std::vector<uint8_t> image = MakeImage(Size, Size, 5);
+
+	const std::pair<BlockFormat, const char*> formats[] =
+	{
+		{ BlockFormat::BC1, "BC1" }, { BlockFormat::BC3, "BC3" }, { BlockFormat::BC4, "BC4" }, { BlockFormat::BC5, "BC5" }, { BlockFormat::BC7, "BC7" }
+	};
+
+	for (const auto& [format, name] : formats)
+	{
+		std::vector<uint8_t> compressed(TextureCompressor::GetCompressedSize(format, Size, Size));
+		double time = Tests::Measure([&]() { TextureCompressor::CompressImage(format, image.data(), Size, Size, 4, compressed.data()); },
+			static_cast<size_t>(Size) * Size, 3);
+
+		const int channels = format == BlockFormat::BC4 ? 1 : format == BlockFormat::BC5 ? 2 : format == BlockFormat::BC1 ? 3 : 4;
+		const double psnr = ComputePSNR(image, DecodeImage(format, compressed, Size, Size), 0, channels);
+
+		Tests::Report(std::string(name) + " encode, " + std::to_string(Size) + "x" + std::to_string(Size), time,
+			"per texel, " + std::to_string(static_cast<int>(psnr * 10.0) / 10.0).substr(0, 4) + " dB");
+	}
+}
@@ -0,0 +1,102 @@
+#include "TestFramework.hpp"
+
+#include <random>
+#include <vector>
+#include <cstring>
+
+#include "Resources/Loaders/VertexConverter.hpp"
+
+namespace
+{
+	struct TestStreams
+	{
+		std::vector<float> positions;
+		std::vector<float> normals;
+		std::vector<float> uvs;
+		std::vector<float> tangents;
+	};
+
+	TestStreams MakeStreams(size_t count, unsigned int seed)
+	{
+		std::mt19937 random(seed);
+		std::uniform_real_distribution<float> value(-100.f, 100.f);
+
+		TestStreams streams;
+		for (std::vector<float>* stream : { &streams.positions, &streams.normals, &streams.uvs, &streams.tangents })
+		{
+			stream->resize(count * 3);
+			for (float& element : *stream)
+				element = value(random);
+		}
+
+		return streams;
+	}
+
+	//	Vertices filled with junk, the conversion must overwrite every member
+	std::vector<Vertex> Convert(const VertexConverter::Streams& streams, bool useSIMD)
+	{
+		std::vector<Vertex> vertices(streams.count + 3);
+		std::memset(static_cast<void*>(vertices.data()), 0x7F, vertices.size() * sizeof(Vertex));
+
+		VertexConverter::Convert(streams, vertices, useSIMD);
+		return vertices;
+	}
+
+	bool SameBytes(const std::vector<Vertex>& a, const std::vector<Vertex>& b)
+	{
+		return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(Vertex)) == 0;
+	}
+}
+
+TEST_CASE("VertexConverter - The streams are interleaved")
+{
+	const TestStreams source = MakeStreams(5, 1);
+
+	VertexConverter::Streams streams;
+	streams.positions = source.positions.data();
+	streams.normals = source.normals.data();
+	streams.uvs = source.uvs.data();
+	streams.tangents = source.tangents.data();
+	streams.count = 5;
+
+	const std::vector<Vertex> vertices = Convert(streams, true);
+	REQUIRE(vertices.size() == 5);
+
+	for (size_t i = 0; i < vertices.size(); ++i)
+	{
+		const Vertex& vertex = vertices[i];
+		CHECK(vertex.position == Vector3(source.positions[i * 3], source.positions[i * 3 + 1], source.positions[i * 3 + 2]));
+		CHECK(vertex.normal == Vector3(source.normals[i * 3], source.normals[i * 3 + 1], source.normals[i * 3 + 2]));
+		CHECK(vertex.uvs == Vector2(source.uvs[i * 3], source.uvs[i * 3 + 1]));
+		CHECK(vertex.tangent == Vector3(source.tangents[i * 3], source.tangents[i * 3 + 1], source.tangents[i * 3 + 2]));
+		CHECK(vertex.bitangent == Vector3(0, 0, 0));
+	}
+}
+
+TEST_CASE("VertexConverter - The SIMD conversion gives the bytes of the scalar one")
+{
+	for (size_t count : { 0, 1, 2, 3, 4, 17, 1000 })
+	{
+		const TestStreams source = MakeStreams(count, static_cast<unsigned int>(count));
+
+		// Every combination of missing streams
+		for (int missing = 0; missing < 8; ++missing)
+		{
+			VertexConverter::Streams streams;
+			streams.positions = source.positions.data();
+			streams.normals = missing & 1 ? nullptr : source.normals.data();
+			streams.uvs = missing & 2 ? nullptr : source.uvs.data();
+			streams.tangents = missing & 4 ? nullptr : source.tangents.data();
+			streams.count = count;
+
+			const std::vector<Vertex> simd = Convert(streams, true);
+			const std::vector<Vertex> scalar = Convert(streams, false);
+
+			CHECK(simd.size() == count);
+			CHECK(SameBytes(simd, scalar));
+
+			if (count > 0 && streams.normals == nullptr)
+				CHECK(simd.front().normal == Vector3(0, 0, 0) && simd.back().normal == Vector3(0, 0, 0));
+		}
+	}
+}
@@ -0,0 +1,242 @@
+#include "TestFramework.hpp"
+
+#include <cmath>
+#include <random>
+#include <vector>
+#include <string>
+#include <algorithm>
+
+#include "Resources/Loaders/VertexPacker.hpp"
+
+namespace
+{
+	constexpr float Pi = 3.14159265358979f;
+
+	Vector3 RandomDirection(std::mt19937& random)
+	{
+		std::normal_distribution<float> normal;
+		Vector3 direction;
+		do
+		{
+			direction = Vector3(normal(random), normal(random), normal(random));
+		} while (Vector3::DotProduct(direction, direction) < 1e-6f);
+
+		return direction / std::sqrt(Vector3::DotProduct(direction, direction));
+	}
+
+	//	Vertices of a sub mesh with uneven bounds, orthonormal tangent frames and tiled UVs
+	std::vector<Vertex> MakeVertices(size_t count, unsigned int seed)
+	{
+		std::mt19937 random(seed);
+		std::uniform_real_distribution<float> x(-50.f, 50.f), y(0.f, 3.f), z(-1000.f, 1000.f), uv(-8.f, 8.f);
+
+		std::vector<Vertex> vertices(count);
+		for (Vertex& vertex : vertices)
+		{
+			vertex.position = Vector3(x(random), y(random), z(random));
+			vertex.normal = RandomDirection(random);
+
+			Vector3 tangent = Vector3::CrossProduct(vertex.normal, RandomDirection(random));
+			vertex.tangent = tangent / std::sqrt(Vector3::DotProduct(tangent, tangent));
+
+			// Half of the vertices have mirrored UVs
+			vertex.bitangent = Vector3::CrossProduct(vertex.normal, vertex.tangent) * (random() % 2 ? 1.f : -1.f);
+			vertex.uvs = Vector2(uv(random), uv(random));
+		}
+
+		return vertices;
+	}
+
+	//	Angle from the cross and dot products, acos of a float dot product can't tell angles under 0.02 degree
+	float AngleDegrees(const Vector3& lhs, const Vector3& rhs)
+	{
+		const double cross[3] = {
+			static_cast<double>(lhs.y) * rhs.z - static_cast<double>(lhs.z) * rhs.y,
+			static_cast<double>(lhs.z) * rhs.x - static_cast<double>(lhs.x) * rhs.z,
+			static_cast<double>(lhs.x) * rhs.y - static_cast<double>(lhs.y) * rhs.x
+		};
+		const double dot = static_cast<double>(lhs.x) * rhs.x + static_cast<double>(lhs.y) * rhs.y + static_cast<double>(lhs.z) * rhs.z;
+		const double sine = std::sqrt(cross[0] * cross[0] + cross[1] * cross[1] + cross[2] * cross[2]);
+
+		return static_cast<float>(std::atan2(sine, dot) * 180.0 / Pi);
+	}
+
+	struct RoundTripErrors
+	{
+		Vector3 position;		// Largest error on each axis
+		float normalDegrees = 0.f;
+		float tangentDegrees = 0.f;
+		float uv = 0.f;			// Largest error on a UV coordinate
+		size_t flippedBitangents = 0;
+	};
+
+	RoundTripErrors RoundTrip(EVertexLayout layout, const std::vector<Vertex>& vertices)
+	{
+		Vector3 min, max;
+		VertexPacker::ComputeBounds(vertices, min, max);
+
+		std::vector<unsigned char> packed(vertices.size() * VertexPacker::GetVertexSize(layout));
+		VertexPacker::Pack(layout, vertices, min, max, packed.data());
+
+		std::vector<Vertex> unpacked(vertices.size());
+		VertexPacker::Unpack(layout, packed.data(), vertices.size(), min, max, unpacked.data());
+
+		RoundTripErrors errors;
+		for (size_t i = 0; i < vertices.size(); ++i)
+		{
+			const Vertex& source = vertices[i];
+			const Vertex& result = unpacked[i];
+
+			for (int axis = 0; axis < 3; ++axis)
+				errors.position[axis] = std::max(errors.position[axis], std::abs(result.position[axis] - source.position[axis]));
+
+			errors.normalDegrees = std::max(errors.normalDegrees, AngleDegrees(result.normal, source.normal));
+			errors.tangentDegrees = std::max(errors.tangentDegrees, AngleDegrees(result.tangent, source.tangent));
+
+			for (float difference : { result.uvs.x - source.uvs.x, result.uvs.y - source.uvs.y })
+				errors.uv = std::max(errors.uv, std::abs(difference));
+
+			if (Vector3::DotProduct(result.bitangent, source.bitangent) <= 0.9f)
+				errors.flippedBitangents++;
+		}
+
+		return errors;
+	}
+}
+
+TEST_CASE("VertexPacker - Packed layouts cut the vertex size")
+{
+	CHECK(VertexPacker::GetVertexSize(EVertexLayout::FLOAT) == 56);
+	CHECK(VertexPacker::GetVertexSize(EVertexLayout::PACKED_SNORM) == 20);
+	CHECK(VertexPacker::GetVertexSize(EVertexLayout::PACKED_HALF) == 20);
+
+	CHECK(VertexPacker::CanUseShortIndices(65536));
+	CHECK(!VertexPacker::CanUseShortIndices(65537));
+}
+
+TEST_CASE("VertexPacker - Float layout is lossless")
+{
+	std::vector<Vertex> vertices = MakeVertices(1000, 1);
+	RoundTripErrors errors = RoundTrip(EVertexLayout::FLOAT, vertices);
+
+	CHECK(errors.position == Vector3(0.f, 0.f, 0.f));
+	CHECK(errors.uv == 0.f);
+	CHECK(errors.flippedBitangents == 0);
+}
+
+TEST_CASE("VertexPacker - Round trip precision of the packed layouts")
+{
+	std::vector<Vertex> vertices = MakeVertices(100000, 2);
+
+	Vector3 min, max;
+	VertexPacker::ComputeBounds(vertices, min, max);
+	const Vector3 halfExtent = (max - min) * 0.5f;
+
+	// Float rounding of the bounds transform, a few ulps of the largest coordinate
+	const float transformError = 1e-6f * 1000.f * 4.f;
+
+	for (EVertexLayout layout : { EVertexLayout::PACKED_SNORM, EVertexLayout::PACKED_HALF })
+	{
+		RoundTripErrors errors = RoundTrip(layout, vertices);
+
+		// snorm16 rounds to half a step of 1 / 32767, half floats in [-1, 1] to half a step of at most 2^-11
+		const float positionStep = layout == EVertexLayout::PACKED_SNORM ? 0.5f / 32767.f : 0.5f / 2048.f;
+		for (int axis = 0; axis < 3; ++axis)
+			CHECK(errors.position[axis] <= halfExtent[axis] * positionStep + transformError);
+
+		// 16 bits octahedral directions are within a few thousandths of a degree
+		CHECK(errors.normalDegrees < 0.01f);
+		CHECK(errors.tangentDegrees < 0.01f);
+
+		// Half float UVs up to 8 : steps of 2^-8 in [4, 8]
+		CHECK(errors.uv <= 0.5f / 256.f);
+
+		// The sign of the bitangent is kept, mirrored UVs stay mirrored
+		CHECK(errors.flippedBitangents == 0);
+	}
+}
+
+TEST_CASE("VertexPacker - Flat sub meshes and the bounds corners")
+{
+	// A plane has no extent on an axis, its positions must not be divided by zero
+	std::vector<Vertex> vertices = MakeVertices(100, 3);
+	for (Vertex& vertex : vertices)
+		vertex.position.y = 2.5f;
+
+	vertices[0].position = Vector3(-50.f, 2.5f, -1000.f);
+	vertices[1].position = Vector3(50.f, 2.5f, 1000.f);
+
+	for (EVertexLayout layout : { EVertexLayout::PACKED_SNORM, EVertexLayout::PACKED_HALF })
+	{
+		Vector3 min, max;
+		VertexPacker::ComputeBounds(vertices, min, max);
+
+		std::vector<unsigned char> packed(vertices.size() * VertexPacker::GetVertexSize(layout));
+		VertexPacker::Pack(layout, vertices, min, max, packed.data());
+
+		std::vector<Vertex> unpacked(vertices.size());
+		VertexPacker::Unpack(layout, packed.data(), vertices.size(), min, max, unpacked.data());
+
+		for (const Vertex& vertex : unpacked)
+			CHECK(std::abs(vertex.position.y - 2.5f) < 1e-5f);
+
+		// The corners of the bounds are exact in both layouts
+		CHECK(unpacked[0].position == vertices[0].position);
+		CHECK(unpacked[1].position == vertices[1].position);
+	}
+}
+
+TEST_CASE("VertexPacker - Half floats round to the nearest even")
+{
+	size_t mismatches = 0;
+	for (uint32_t bits = 0; bits < 0x10000; ++bits)
+	{
+		const uint16_t half = static_cast<uint16_t>(bits);
+		const float value = VertexPacker::HalfToFloat(half);
+
+		// Every half float comes back unchanged, NaNs stay NaNs
+		if (std::isnan(value))
+		{
+			mismatches += !std::isnan(VertexPacker::HalfToFloat(VertexPacker::FloatToHalf(value)));
+			continue;
+		}
+
+		mismatches += VertexPacker::FloatToHalf(value) != half;
+
+		// A value halfway to the next half float goes to the one with an even mantissa
+		const uint16_t next = static_cast<uint16_t>(half + 1);
+		if ((half & 0x7FFF) >= 0x7C00 || (next & 0x7FFF) >= 0x7C00)
+			continue;
+
+		const float halfway = (value + VertexPacker::HalfToFloat(next)) * 0.5f;
+		mismatches += VertexPacker::FloatToHalf(halfway) != ((half & 1) ? next : half);
+	}
+
+	CHECK(mismatches == 0);
+
+	CHECK(VertexPacker::FloatToHalf(65520.f) == 0x7C00);
+	CHECK(VertexPacker::FloatToHalf(-1e-10f) == 0x8000);
+	CHECK(VertexPacker::HalfToFloat(VertexPacker::FloatToHalf(1.f)) == 1.f);
+}
+
+TEST_CASE("VertexPacker - Octahedral encoding of the axes and the folds")
+{
+	// Axes and the edges of the octahedron, where the lower hemisphere is folded
+	const Vector3 directions[] = {
+		Vector3(1.f, 0.f, 0.f), Vector3(-1.f, 0.f, 0.f), Vector3(0.f, 1.f, 0.f), Vector3(0.f, -1.f, 0.f),
+		Vector3(0.f, 0.f, 1.f), Vector3(0.f, 0.f, -1.f), Vector3(0.7071068f, 0.f, -0.7071068f), Vector3(0.f, -0.7071068f, -0.7071068f)
+	};
+
+	for (const Vector3& direction : directions)
+	{
+		int16_t encoded[2];
+		VertexPacker::EncodeOctahedral(direction, encoded);
+		CHECK(AngleDegrees(VertexPacker::DecodeOctahedral(encoded), direction) < 0.01f);
+	}
+
+	// A zero vector gives a valid direction
+	int16_t encoded[2];
+	VertexPacker::EncodeOctahedral(Vector3(0.f, 0.f, 0.f), encoded);
+	const Vector3 decoded = VertexPacker::DecodeOctahedral(encoded);
+	CHECK(std::abs(Vector3::DotProduct(decoded, decoded) - 1.f) < 1e-5f);
+}
@@ -0,0 +1,129 @@
+#include "TestFramework.hpp"
+
+#include <vector>
+#include <cstring>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <random>
+
+namespace
+{
+	struct Case
+	{
+		const char* name;
+		Tests::CaseFunction function;
+	};
+
+	//	Function-local so registration works whatever the static initialization order of the test files
+	std::vector<Case>& GetTests()
+	{
+		static std::vector<Case> tests;
+		return tests;
+	}
+
+	std::vector<Case>& GetBenchmarks()
+	{
+		static std::vector<Case> benchmarks;
+		return benchmarks;
+	}
+
+	size_t g_failureCount = 0;
+}
+
+namespace Tests
+{
+	bool RegisterTest(const char* name, CaseFunction function)
+	{
+		GetTests().push_back({ name, function });
+		return true;
+	}
+
+	bool RegisterBenchmark(const char* name, CaseFunction function)
+	{
+		GetBenchmarks().push_back({ name, function });
+		return true;
+	}
+
+	void ReportFailure(const char* expression, const char* file, int line)
+	{
+		g_failureCount++;
+		std::cout << "    FAILED : " << expression << " (" << file << ":" << line << ")" << std::endl;
+	}
+
+	void Report(const std::string& label, double nanoseconds, const std::string& note)
+	{
+		std::cout << "    " << std::left << std::setw(56) << label << std::right << std::fixed << std::setprecision(2)
+			<< std::setw(14) << nanoseconds << " ns" << (note.empty() ? "" : "   ") << note << std::endl;
+	}
+
+	TemporaryDirectory::TemporaryDirectory(const std::string& name)
+	{
+		std::random_device device;
+		m_path = std::filesystem::temp_directory_path() / ("HydrillTests_" + name + "_" + std::to_string(device()));
+
+		std::error_code error;
+		std::filesystem::remove_all(m_path, error);
+		std::filesystem::create_directories(m_path);
+	}
+
+	TemporaryDirectory::~TemporaryDirectory()
+	{
+		std::error_code error;
+		std::filesystem::remove_all(m_path, error);
+	}
+
+	const std::filesystem::path& TemporaryDirectory::Path() const
+	{
+		return m_path;
+	}
+
+	std::filesystem::path TemporaryDirectory::WriteFile(const std::string& relativePath, const std::string& content) const
+	{
+		std::filesystem::path path = m_path / relativePath;
+		std::filesystem::create_directories(path.parent_path());
+
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		file.write(content.data(), static_cast<std::streamsize>(content.size()));
+
+		return path;
+	}
+
+	int Run(int argc, char** argv)
+	{
+		bool benchmarks = false;
+		const char* filter = nullptr;
+
+		for (int i = 1; i < argc; ++i)
+		{
+			if (std::strcmp(argv[i], "--bench") == 0)
+				benchmarks = true;
+			else
+				filter = argv[i];
+		}
+
+		int failedCount = 0;
+		int runCount = 0;
+
+		for (const Case& test : benchmarks ? GetBenchmarks() : GetTests())
+		{
+			if (filter && std::strstr(test.name, filter) == nullptr)
+				continue;
+
+			std::cout << (benchmarks ? "[BENCH] " : "[TEST]  ") << test.name << std::endl;
+
+			size_t failuresBefore = g_failureCount;
+			ResetLogCounters();
+
+			test.function();
+
+			runCount++;
+			if (g_failureCount != failuresBefore)
+				failedCount++;
+		}
+
+		std::cout << std::endl << runCount - failedCount << "/" << runCount << (benchmarks ? " benchmarks" : " tests") << " passed" << std::endl;
+
+		return failedCount;
+	}
+}
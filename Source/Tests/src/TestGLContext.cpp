@@ -0,0 +1,43 @@
+#include "TestGLContext.hpp"
+
+#include <glad/gl.h>
+
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+namespace Tests
+{
+	GLContext::GLContext()
+	{
+		if (!glfwInit())
+			return;
+
+		glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+		glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
+		glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+		m_window = glfwCreateWindow(64, 64, "Tests", nullptr, nullptr);
+		if (m_window == nullptr)
+			return;
+
+		glfwMakeContextCurrent(m_window);
+		if (gladLoaderLoadGL() == 0)
+		{
+			glfwDestroyWindow(m_window);
+			m_window = nullptr;
+		}
+	}
+
+	GLContext::~GLContext()
+	{
+		if (m_window != nullptr)
+			glfwDestroyWindow(m_window);
+
+		glfwTerminate();
+	}
+
+	bool GLContext::IsValid() const
+	{
+		return m_window != nullptr;
+	}
+}
@@ -0,0 +1,68 @@
+#include <Core/Logger.hpp>
+
+#include <iostream>
+#include <cassert>
+#include <atomic>
+
+#include "TestFramework.hpp"
+
+//	The engine sources compiled in the Tests executable log through this Logger : there is no engine context,
+//	messages go to the console and warnings and errors are counted so tests can check them
+
+namespace
+{
+	std::mutex g_logLock;
+
+	std::atomic<size_t> g_warningCount = 0;
+	std::atomic<size_t> g_errorCount = 0;
+
+	void PrintMessage(const char* prefix, const std::string& text)
+	{
+		std::lock_guard logGuard(g_logLock);
+		std::cout << "    " << prefix << text << std::endl;
+	}
+}
+
+namespace Tests
+{
+	LogCounters GetLogCounters()
+	{
+		return { g_warningCount.load(), g_errorCount.load() };
+	}
+
+	void ResetLogCounters()
+	{
+		g_warningCount = 0;
+		g_errorCount = 0;
+	}
+}
+
+void Logger::Success(const std::string& text)
+{
+	PrintMessage("Success : ", text);
+}
+
+void Logger::Info(const std::string& text)
+{
+	PrintMessage("Info    : ", text);
+}
+
+void Logger::Warning(const std::string& text)
+{
+	g_warningCount++;
+	PrintMessage("WARNING : ", text);
+}
+
+void Logger::Error(const std::string& text)
+{
+	g_errorCount++;
+	PrintMessage("ERROR   : ", text);
+}
+
+void Logger::AssertError(const std::string& text)
+{
+	g_errorCount++;
+	PrintMessage("ERROR   : ", text);
+
+	assert(nullptr);
+}
@@ -0,0 +1,36 @@
+#include <Resources/Loaders/ResourcesLoader.hpp>
+#include <Renderer/MeshShader.hpp>
+
+//	ResourcesManager is compiled in the Tests executable without the loaders and the renderer :
+//	the resources of the tests have no file and no GPU data, so their file and material functions do nothing
+
+void ResourcesLoader::LoadResourcesInDirectory(std::string_view path)
+{
+}
+
+void ResourcesLoader::CreateResourceFiles(Resource* resource)
+{
+}
+
+void ResourcesLoader::DeleteResourceFiles(Resource* resource)
+{
+}
+
+//	Source assets of the tests, the other extensions are not imported
+ExtensionType ResourcesLoader::GetExtensionType(const std::string& extension)
+{
+	if (extension == ".fbx" || extension == ".obj")
+		return ExtensionType::MODEL;
+
+	if (extension == ".png" || extension == ".jpg")
+		return ExtensionType::TEXTURE;
+
+	if (extension == ".wav")
+		return ExtensionType::SOUND;
+
+	return extension == ".texture" || extension == ".model" ? ExtensionType::RESOURCE : ExtensionType::UNKNOWN;
+}
+
+void MeshShader::SetDefaultMaterial(const MaterialData* material)
+{
+}
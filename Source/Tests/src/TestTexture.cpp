@@ -0,0 +1,76 @@
+#include <Resources/Resource/Texture.hpp>
+
+#include "Generated/Texture.rfks.h"
+#include "Generated/ParserFlags.rfks.h"
+
+//	Texture is compiled in the Tests executable without the loaders and the renderer :
+//	the textures of the tests only have their mip chain, their file and GPU functions do nothing
+
+rfk::UniquePtr<Texture> Texture::defaultInstantiator(const HYGUID& uid)
+{
+	return rfk::makeUnique<Texture>(uid);
+}
+
+Texture::Texture(const HYGUID& uid)
+	: Resource(uid, staticGetArchetype().getName())
+{
+	m_type = RESOURCE_TYPE::TEXTURE;
+}
+
+Flags<EImageSTB> const& Texture::GetLoadingFlags() const
+{
+	return m_flag;
+}
+
+void Texture::SetLoadingFlags(const Flags<EImageSTB>& flags)
+{
+	m_flag = flags;
+}
+
+void Texture::SetUsage(ETextureUsage usage)
+{
+}
+
+bool Texture::CanBeUsedAs(ETextureUsage usage) const
+{
+	return true;
+}
+
+bool Texture::Import(const std::string& path)
+{
+	return false;
+}
+
+void Texture::GetImportSettings(std::string& settings) const
+{
+}
+
+bool Texture::Reimport()
+{
+	return false;
+}
+
+void Texture::StageGPUData()
+{
+}
+
+void Texture::LoadInGPUMemory()
+{
+}
+
+void Texture::UnloadFromGPUMemory()
+{
+}
+
+bool Texture::IsGPUUploadPending() const
+{
+	return false;
+}
+
+void Texture::Serialize()
+{
+}
+
+void Texture::Deserialize()
+{
+}
@@ -0,0 +1,137 @@
+#include "TestFramework.hpp"
+
+#include <vector>
+#include <string>
+#include <thread>
+#include <cstring>
+#include <cstdint>
+
+#include "Tools/ContentHash.hpp"
+
+namespace
+{
+	//	Content built from its offsets, the same on every machine
+	std::vector<unsigned char> MakeContent(size_t size)
+	{
+		std::vector<unsigned char> data(size);
+		for (size_t i = 0; i < size; ++i)
+			data[i] = static_cast<unsigned char>((i * 131 + 7) ^ (i >> 8));
+
+		return data;
+	}
+
+	struct KnownHash
+	{
+		size_t size;
+		uint64_t low;
+		uint64_t high;
+		uint64_t check;
+	};
+
+	//	Hashes stored in the import indices of earlier runs : the short, medium and long paths, with partial blocks and stripes
+	constexpr KnownHash KnownHashes[] = {
+		{ 0, 0x323670f73d2b5f64ull, 0x808906728b2d2c93ull, 0xe9e0033e3badaf36ull },
+		{ 3, 0x41640de42631f90cull, 0xd8e97fb0e1ba45feull, 0x6ac58a1181f7b90dull },
+		{ 8, 0xdebdde4946d1d4c8ull, 0x8a7b640798ff35b8ull, 0x6872815d5c5ef9ffull },
+		{ 16, 0xc655c280f722a3d2ull, 0x8952a75d41d387ddull, 0x33c52cdc489cd7dbull },
+		{ 17, 0x8d96ef110fcdebb4ull, 0x66fc23f6439dbd77ull, 0xd4ccc19f2194bdbbull },
+		{ 100, 0x063a6a7b1916a235ull, 0x38d98bee619e09d4ull, 0xacb37808fe42d86aull },
+		{ 128, 0x8f1c53f4ec069f8full, 0x4c3fce84e44c8019ull, 0xfee5f2633a1c87e9ull },
+		{ 129, 0xda31a1307777060eull, 0x06895f7b39c088a0ull, 0xe7524dc2d5af0afeull },
+		{ 1024, 0x48b5666c649d1a1full, 0xd4a6af37f0a70046ull, 0xe2a1b6c4fdf896c0ull },
+		{ 1025, 0x8ff2485a3518cebcull, 0x7bd624d1373caee6ull, 0xcc44d09f6b0dfe8bull },
+		{ 5000, 0xe900d48020d68d15ull, 0x6ae0524201a88667ull, 0xbc29cf8cdbccaab8ull },
+	};
+}
+
+TEST_CASE("ContentHash - Hashes are the same from one run to the next")
+{
+	const std::vector<unsigned char> data = MakeContent(5000);
+
+	// The values do not depend on the process, the compiler or the 64 bits multiply used
+	for (const KnownHash& known : KnownHashes)
+	{
+		const Hash128 hash = ContentHash::Compute(data.data(), known.size);
+		CHECK(hash.low == known.low && hash.high == known.high);
+		CHECK(ContentHash::ComputeCheck(data.data(), known.size) == known.check);
+	}
+
+	const Hash128 seeded = ContentHash::Compute(data.data(), 1025, 42);
+	CHECK(seeded.low == 0x19a6605bd009f6a4ull && seeded.high == 0xcd4f3e3a7ef50bafull);
+
+	// Strings and files hash as their bytes
+	const std::string text(reinterpret_cast<const char*>(data.data()), 1025);
+	CHECK(ContentHash::Compute(text) == ContentHash::Compute(data.data(), 1025));
+
+	Tests::TemporaryDirectory directory("ContentHash");
+	Hash128 fileHash;
+	REQUIRE(ContentHash::ComputeFile(directory.WriteFile("Content.bin", text).string(), fileHash));
+	CHECK(fileHash == ContentHash::Compute(text));
+
+	REQUIRE(ContentHash::ComputeFile(directory.WriteFile("Empty.bin", "").string(), fileHash));
+	CHECK(fileHash.low == KnownHashes[0].low && fileHash.high == KnownHashes[0].high);
+	CHECK(!ContentHash::ComputeFile((directory.Path() / "Missing.bin").string(), fileHash));
+}
+
+TEST_CASE("ContentHash - Hashes do not depend on the address of the content")
+{
+	const std::vector<unsigned char> data = MakeContent(5000);
+	std::vector<unsigned char> shifted(data.size() + 16);
+
+	for (size_t offset = 1; offset < 16; ++offset)
+	{
+		std::memcpy(shifted.data() + offset, data.data(), data.size());
+
+		for (const KnownHash& known : KnownHashes)
+		{
+			CHECK(ContentHash::Compute(shifted.data() + offset, known.size) == ContentHash::Compute(data.data(), known.size));
+			CHECK(ContentHash::ComputeCheck(shifted.data() + offset, known.size) == known.check);
+		}
+	}
+}
+
+TEST_CASE("ContentHash - Threads hashing at once get the hashes of a single thread")
+{
+	// Contents of every size up to a few blocks, each thread hashes all of them from its own copy
+	std::vector<std::vector<unsigned char>> contents;
+	for (size_t size = 0; size < 3000; size += 7)
+		contents.push_back(MakeContent(size));
+
+	std::vector<Hash128> expected;
+	std::vector<uint64_t> expectedChecks;
+	for (const std::vector<unsigned char>& content : contents)
+	{
+		expected.push_back(ContentHash::Compute(content.data(), content.size(), content.size()));
+		expectedChecks.push_back(ContentHash::ComputeCheck(content.data(), content.size()));
+	}
+
+	constexpr size_t ThreadCount = 8;
+	std::vector<size_t> mismatches(ThreadCount, 0);
+	std::vector<std::thread> threads;
+
+	for (size_t thread = 0; thread < ThreadCount; ++thread)
+	{
+		threads.emplace_back([&, thread]() {
+			const std::vector<std::vector<unsigned char>> copies = contents;
+			for (int round = 0; round < 4; ++round)
+			{
+				// Each thread walks the contents from a different start
+				for (size_t i = 0; i < copies.size(); ++i)
+				{
+					const size_t index = (i + thread * 37) % copies.size();
+					const std::vector<unsigned char>& content = copies[index];
+
+					if (ContentHash::Compute(content.data(), content.size(), content.size()) != expected[index]
+						|| ContentHash::ComputeCheck(content.data(), content.size()) != expectedChecks[index])
+						mismatches[thread]++;
+				}
+			}
+			});
+	}
+
+	for (std::thread& thread : threads)
+		thread.join();
+
+	for (size_t count : mismatches)
+		CHECK(count == 0);
+}
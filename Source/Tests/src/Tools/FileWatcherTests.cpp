@@ -0,0 +1,235 @@
+#include "TestFramework.hpp"
+
+#include <deque>
+#include <mutex>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <string>
+#include <filesystem>
+
+#include "Tools/FileWatcher.hpp"
+
+namespace fs = std::filesystem;
+
+using namespace std::chrono_literals;
+
+namespace
+{
+	using Events = std::vector<FileWatcher::Event>;
+
+	//	Raw events pushed by the test, as a native backend sends them
+	struct EventScript
+	{
+		std::mutex mutex;
+		std::deque<Events> batches;
+
+		void Push(const Events& events)
+		{
+			std::lock_guard guard(mutex);
+			batches.push_back(events);
+		}
+	};
+
+	class ScriptedBackend : public FileWatcher::Backend
+	{
+	private:
+		std::shared_ptr<EventScript> m_script;
+
+	public:
+		ScriptedBackend(const std::shared_ptr<EventScript>& script) : m_script(script)
+		{
+
+		}
+
+		void Wait(std::chrono::milliseconds timeout, Events& events) override
+		{
+			{
+				std::lock_guard guard(m_script->mutex);
+				if (!m_script->batches.empty())
+				{
+					events = std::move(m_script->batches.front());
+					m_script->batches.pop_front();
+					return;
+				}
+			}
+
+			std::this_thread::sleep_for(std::min<std::chrono::milliseconds>(timeout, 5ms));
+		}
+	};
+
+	//	Events of the next settled burst, empty after the timeout
+	Events WaitForEvents(FileWatcher& watcher, std::chrono::milliseconds timeout = 5000ms)
+	{
+		Events events;
+		const FileWatcher::Clock::time_point end = FileWatcher::Clock::now() + timeout;
+		while (!watcher.PollEvents(events) && FileWatcher::Clock::now() < end)
+			std::this_thread::sleep_for(10ms);
+
+		return events;
+	}
+
+	//	Files created before the first walk of the polling backend are not reported : a file is written until it is seen
+	bool WaitForFirstWalk(FileWatcher& watcher, const Tests::TemporaryDirectory& directory, std::chrono::milliseconds settleTime)
+	{
+		Events events;
+		for (int attempt = 1; attempt < 100 && !watcher.PollEvents(events); ++attempt)
+		{
+			directory.WriteFile("Ready.txt", std::string(attempt, 'r'));
+			std::this_thread::sleep_for(50ms);
+		}
+
+		// The last writes may be reported in another burst
+		std::this_thread::sleep_for(settleTime);
+		Events late;
+		watcher.PollEvents(late);
+
+		return !events.empty();
+	}
+
+	std::string GetName(const FileWatcher::Event& event)
+	{
+		return fs::path(event.path).filename().string();
+	}
+}
+
+TEST_CASE("FileWatcher - Events of a burst are merged by file")
+{
+	Tests::TemporaryDirectory directory("FileWatcherMerge");
+	const std::string root = directory.Path().string();
+	const std::string a = (directory.Path() / "A.fbx").string();
+	const std::string b = (directory.Path() / "B.fbx").string();
+	const std::string c = (directory.Path() / "C.fbx").string();
+	const std::string d = (directory.Path() / "D.fbx").string();
+	const std::string e = (directory.Path() / "E.fbx").string();
+
+	auto script = std::make_shared<EventScript>();
+	FileWatcher watcher(root, nullptr, 150ms);
+	REQUIRE(watcher.Start(std::make_unique<ScriptedBackend>(script)));
+	CHECK(!watcher.IsPolling());
+
+	// Sent over several waits shorter than the debounce delay, reported together
+	script->Push({ { a, FileWatcher::EEvent::ADDED }, { b, FileWatcher::EEvent::MODIFIED } });
+	script->Push({ { a, FileWatcher::EEvent::MODIFIED }, { b, FileWatcher::EEvent::REMOVED }, { c, FileWatcher::EEvent::ADDED } });
+	script->Push({ { c, FileWatcher::EEvent::REMOVED }, { d, FileWatcher::EEvent::REMOVED }, { e, FileWatcher::EEvent::MODIFIED } });
+	script->Push({ { d, FileWatcher::EEvent::ADDED }, { e, FileWatcher::EEvent::MODIFIED } });
+
+	const Events events = WaitForEvents(watcher);
+	REQUIRE(events.size() == 4);
+
+	// Sorted by path : added then written stays added, a file created then deleted is not reported,
+	// deleted then written again is modified
+	CHECK(events[0].path == a && events[0].type == FileWatcher::EEvent::ADDED);
+	CHECK(events[1].path == b && events[1].type == FileWatcher::EEvent::REMOVED);
+	CHECK(events[2].path == d && events[2].type == FileWatcher::EEvent::MODIFIED);
+	CHECK(events[3].path == e && events[3].type == FileWatcher::EEvent::MODIFIED);
+
+	// Events of a file written continuously are reported after the longest latency
+	FileWatcher continuous(root, nullptr, 100ms, 300ms);
+	auto continuousScript = std::make_shared<EventScript>();
+	REQUIRE(continuous.Start(std::make_unique<ScriptedBackend>(continuousScript)));
+
+	Events held;
+	const FileWatcher::Clock::time_point start = FileWatcher::Clock::now();
+	while (!continuous.PollEvents(held) && FileWatcher::Clock::now() - start < 5000ms)
+	{
+		continuousScript->Push({ { a, FileWatcher::EEvent::MODIFIED } });
+		std::this_thread::sleep_for(20ms);
+	}
+
+	CHECK(held.size() == 1 && held[0].path == a);
+}
+
+TEST_CASE("FileWatcher - An overflow of the backend is reported as a RESCAN")
+{
+	Tests::TemporaryDirectory directory("FileWatcherRescan");
+	const std::string root = directory.Path().string();
+	const std::string a = (directory.Path() / "A.fbx").string();
+	const std::string b = (directory.Path() / "B.fbx").string();
+
+	auto script = std::make_shared<EventScript>();
+	FileWatcher watcher(root, nullptr, 100ms);
+	REQUIRE(watcher.Start(std::make_unique<ScriptedBackend>(script)));
+
+	// The events of the burst before the overflow and after it are replaced by the RESCAN
+	script->Push({ { a, FileWatcher::EEvent::MODIFIED } });
+	script->Push({ { root, FileWatcher::EEvent::RESCAN } });
+	script->Push({ { b, FileWatcher::EEvent::ADDED } });
+
+	Events events = WaitForEvents(watcher);
+	REQUIRE(events.size() == 1);
+	CHECK(events[0].type == FileWatcher::EEvent::RESCAN && events[0].path == root);
+
+	// Bursts settled before a RESCAN not taken yet are dropped, the ones after it too
+	script->Push({ { a, FileWatcher::EEvent::MODIFIED } });
+	std::this_thread::sleep_for(400ms);
+	script->Push({ { root, FileWatcher::EEvent::RESCAN } });
+	std::this_thread::sleep_for(400ms);
+	script->Push({ { b, FileWatcher::EEvent::MODIFIED } });
+	std::this_thread::sleep_for(400ms);
+
+	events = WaitForEvents(watcher);
+	REQUIRE(events.size() == 1);
+	CHECK(events[0].type == FileWatcher::EEvent::RESCAN);
+
+	// Events are reported again once the RESCAN is taken
+	script->Push({ { b, FileWatcher::EEvent::MODIFIED } });
+	events = WaitForEvents(watcher);
+	CHECK(events.size() == 1 && events[0].path == b && events[0].type == FileWatcher::EEvent::MODIFIED);
+}
+
+TEST_CASE("FileWatcher - The polling backend reports files and directories")
+{
+	constexpr std::chrono::milliseconds DebounceDelay = 300ms;
+
+	Tests::TemporaryDirectory directory("FileWatcherPolling");
+	FileWatcher watcher(directory.Path().string(), [](const std::string& path) { return fs::path(path).extension() != ".log"; }, DebounceDelay);
+	watcher.SetPollingInterval(20ms);
+
+	REQUIRE(watcher.Start(true));
+	CHECK(watcher.IsPolling());
+	REQUIRE(WaitForFirstWalk(watcher, directory, DebounceDelay * 2));
+
+	// A file written several times in a burst is added once, a temporary file of a save written then deleted in the same burst
+	// is not reported, filtered files are not reported
+	directory.WriteFile("Model.fbx", "v1");
+	directory.WriteFile("Model.fbx.tmp", "saving");
+	directory.WriteFile("Import.log", "log");
+	std::this_thread::sleep_for(60ms);
+	directory.WriteFile("Model.fbx", "version 2");
+	fs::remove(directory.Path() / "Model.fbx.tmp");
+	std::this_thread::sleep_for(60ms);
+	directory.WriteFile("Model.fbx", "the third version");
+
+	Events events = WaitForEvents(watcher);
+	REQUIRE(events.size() == 1);
+	CHECK(GetName(events[0]) == "Model.fbx" && events[0].type == FileWatcher::EEvent::ADDED);
+
+	// The files of an added directory, then of the removed one
+	directory.WriteFile("Textures/Albedo.png", "albedo");
+	directory.WriteFile("Textures/Normal.png", "normal");
+	directory.WriteFile("Textures/Sub/Roughness.png", "roughness");
+
+	events = WaitForEvents(watcher);
+	REQUIRE(events.size() == 3);
+	CHECK(GetName(events[0]) == "Albedo.png" && GetName(events[1]) == "Normal.png" && GetName(events[2]) == "Roughness.png");
+	for (const FileWatcher::Event& event : events)
+		CHECK(event.type == FileWatcher::EEvent::ADDED);
+
+	fs::remove_all(directory.Path() / "Textures");
+
+	events = WaitForEvents(watcher);
+	REQUIRE(events.size() == 3);
+	for (const FileWatcher::Event& event : events)
+		CHECK(event.type == FileWatcher::EEvent::REMOVED);
+
+	// A modified file, nothing after
+	directory.WriteFile("Model.fbx", "modified");
+	events = WaitForEvents(watcher);
+	CHECK(events.size() == 1 && GetName(events[0]) == "Model.fbx" && events[0].type == FileWatcher::EEvent::MODIFIED);
+
+	CHECK(WaitForEvents(watcher, DebounceDelay * 2).empty());
+
+	watcher.Stop();
+	CHECK(!watcher.IsRunning());
+}
@@ -0,0 +1,184 @@
+#include "TestFramework.hpp"
+
+#include <array>
+#include <random>
+#include <algorithm>
+#include <vector>
+#include <string>
+#include <memory>
+#include <unordered_map>
+
+#include "Tools/FlatHashMap.hpp"
+#include "Types/GUID.hpp"
+
+namespace
+{
+	std::vector<HYGUID> MakeGUIDs(size_t count)
+	{
+		std::vector<HYGUID> guids(count);
+		HYGUID::NewMany(guids);
+		return guids;
+	}
+}
+
+TEST_CASE("FlatHashMap - Random operations match std::unordered_map")
+{
+	FlatHashMap<uint64_t, uint64_t> map;
+	std::unordered_map<uint64_t, uint64_t> reference;
+
+	std::mt19937_64 random(11);
+
+	//	Few distinct keys so inserts, erases and lookups hit each other and leave tombstones
+	for (int i = 0; i < 200000; ++i)
+	{
+		uint64_t key = random() % 5000;
+
+		switch (random() % 3)
+		{
+		case 0:
+			CHECK(map.try_emplace(key, i).second == reference.try_emplace(key, i).second);
+			break;
+		case 1:
+			CHECK(map.erase(key) == reference.erase(key));
+			break;
+		default:
+		{
+			auto it = map.find(key);
+			auto referenceIt = reference.find(key);
+			REQUIRE((it == map.end()) == (referenceIt == reference.end()));
+			if (it != map.end())
+				CHECK(it->second == referenceIt->second);
+		}
+		}
+	}
+
+	CHECK(map.size() == reference.size());
+
+	size_t iterated = 0;
+	for (const auto& [key, value] : map)
+	{
+		CHECK(reference.at(key) == value);
+		iterated++;
+	}
+	CHECK(iterated == reference.size());
+}
+
+TEST_CASE("FlatHashMap - Non trivial values are destroyed")
+{
+	auto counter = std::make_shared<int>(0);
+
+	{
+		FlatHashMap<HYGUID, std::shared_ptr<int>> map;
+		std::vector<HYGUID> guids = MakeGUIDs(1000);
+
+		for (const HYGUID& guid : guids)
+			map.try_emplace(guid, counter);
+
+		CHECK(counter.use_count() == 1001);
+
+		for (size_t i = 0; i < guids.size(); i += 2)
+			map.erase(guids[i]);
+
+		CHECK(counter.use_count() == 501);
+
+		//	Moving the map must not copy or leak the values
+		FlatHashMap<HYGUID, std::shared_ptr<int>> moved(std::move(map));
+		CHECK(counter.use_count() == 501);
+		CHECK(moved.size() == 500);
+	}
+
+	CHECK(counter.use_count() == 1);
+}
+
+TEST_CASE("FlatHashMap - Erase while iterating")
+{
+	FlatHashMap<int, int> map;
+	for (int i = 0; i < 1000; ++i)
+		map[i] = i;
+
+	for (auto it = map.begin(); it != map.end();)
+	{
+		if (it->first % 2 == 0)
+			it = map.erase(it);
+		else
+			++it;
+	}
+
+	CHECK(map.size() == 500);
+	for (int i = 0; i < 1000; ++i)
+		CHECK(map.contains(i) == (i % 2 == 1));
+}
+
+TEST_CASE("FlatHashMap - GUID hash spreads the low and high bits")
+{
+	//	GUIDs differing by one byte must land in different groups of a large table
+	std::hash<HYGUID> hasher;
+
+	std::array<unsigned char, 16> bytes = {};
+	std::vector<size_t> lowBits(1 << 12, 0);
+	std::vector<size_t> highBits(1 << 12, 0);
+
+	for (int i = 0; i < (1 << 16); ++i)
+	{
+		bytes[15] = static_cast<unsigned char>(i);
+		bytes[7] = static_cast<unsigned char>(i >> 8);
+
+		size_t hash = hasher(HYGUID(bytes));
+		lowBits[hash & 0xFFF]++;
+		highBits[hash >> 52]++;
+	}
+
+	//	16 keys expected per bucket, a poor hash would pile them in a few buckets
+	size_t maxLow = 0, maxHigh = 0;
+	for (size_t i = 0; i < lowBits.size(); ++i)
+	{
+		maxLow = std::max(maxLow, lowBits[i]);
+		maxHigh = std::max(maxHigh, highBits[i]);
+	}
+
+	CHECK(maxLow < 48);
+	CHECK(maxHigh < 48);
+}
+
+//	Insert, successful and failed lookups and erase of GUID keys, FlatHashMap against std::unordered_map
+BENCHMARK("FlatHashMap - GUID keys against std::unordered_map")
+{
+	for (size_t count : { 10000, 100000, 1000000 })
+	{
+		std::vector<HYGUID> keys = MakeGUIDs(count);
+		std::vector<HYGUID> missingKeys = MakeGUIDs(count);
+
+		std::vector<HYGUID> shuffledKeys = keys;
+		std::shuffle(shuffledKeys.begin(), shuffledKeys.end(), std::mt19937(5));
+
+		const int samples = count >= 1000000 ? 2 : 5;
+		const std::string suffix = ", " + std::to_string(count) + " keys";
+
+		std::unordered_map<HYGUID, std::unique_ptr<int>> stdMap;
+		FlatHashMap<HYGUID, std::unique_ptr<int>> flatMap;
+
+		Tests::Report("std::unordered_map insert" + suffix, Tests::MeasureWithSetup([&]() { stdMap.clear(); },
+			[&]() { for (const HYGUID& key : keys) stdMap.try_emplace(key, nullptr); }, count, samples));
+		Tests::Report("FlatHashMap        insert" + suffix, Tests::MeasureWithSetup([&]() { flatMap.clear(); },
+			[&]() { for (const HYGUID& key : keys) flatMap.try_emplace(key, nullptr); }, count, samples));
+
+		size_t found = 0;
+		Tests::Report("std::unordered_map find hit" + suffix, Tests::Measure(
+			[&]() { for (const HYGUID& key : shuffledKeys) found += stdMap.find(key) != stdMap.end(); }, count, samples));
+		Tests::Report("FlatHashMap        find hit" + suffix, Tests::Measure(
+			[&]() { for (const HYGUID& key : shuffledKeys) found += flatMap.find(key) != flatMap.end(); }, count, samples));
+
+		Tests::Report("std::unordered_map find miss" + suffix, Tests::Measure(
+			[&]() { for (const HYGUID& key : missingKeys) found += stdMap.find(key) != stdMap.end(); }, count, samples));
+		Tests::Report("FlatHashMap        find miss" + suffix, Tests::Measure(
+			[&]() { for (const HYGUID& key : missingKeys) found += flatMap.find(key) != flatMap.end(); }, count, samples));
+		Tests::DoNotOptimize(found);
+
+		Tests::Report("std::unordered_map erase" + suffix, Tests::MeasureWithSetup(
+			[&]() { for (const HYGUID& key : keys) stdMap.try_emplace(key, nullptr); },
+			[&]() { for (const HYGUID& key : shuffledKeys) stdMap.erase(key); }, count, samples));
+		Tests::Report("FlatHashMap        erase" + suffix, Tests::MeasureWithSetup(
+			[&]() { for (const HYGUID& key : keys) flatMap.try_emplace(key, nullptr); },
+			[&]() { for (const HYGUID& key : shuffledKeys) flatMap.erase(key); }, count, samples));
+	}
+}
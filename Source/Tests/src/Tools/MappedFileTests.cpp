@@ -0,0 +1,173 @@
+#include "TestFramework.hpp"
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <cstring>
+#include <cstdint>
+#include <filesystem>
+#include <algorithm>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "Psapi.lib")
+#else
+#include <unistd.h>
+#endif
+
+#include "Tools/MappedFile.hpp"
+#include "Resources/Types.hpp"
+
+TEST_CASE("MappedFile - Views are bound and alignment checked")
+{
+	Tests::TemporaryDirectory directory("MappedFile");
+	const std::string path = directory.WriteFile("Data.bin", std::string(64, 'a')).string();
+
+	MappedFile file;
+	REQUIRE(file.Open(path));
+	CHECK(file.GetSize() == 64);
+
+	CHECK(file.View<uint32_t>(0, 16) != nullptr);
+	CHECK(file.View<uint32_t>(60) != nullptr);
+	CHECK(file.View<uint32_t>(4, 16) == nullptr);
+	CHECK(file.View<uint32_t>(62) == nullptr);
+	CHECK(file.View<uint32_t>(65, 0) == nullptr);
+	CHECK(file.View<uint32_t>(2) == nullptr);
+
+	// Empty files can't be mapped, a failed open leaves the file closed
+	const std::string emptyPath = directory.WriteFile("Empty.bin", "").string();
+	CHECK(!file.Open(emptyPath));
+	CHECK(!file.IsOpen() && file.GetData() == nullptr && file.GetSize() == 0);
+}
+
+TEST_CASE("MappedFile - A mapped file can be renamed and deleted")
+{
+	Tests::TemporaryDirectory directory("MappedFile");
+	const std::filesystem::path path = directory.WriteFile("Mesh.mesh", "mapped content");
+	const std::filesystem::path renamedPath = directory.Path() / "Renamed.mesh";
+
+	MappedFile file;
+	REQUIRE(file.Open(path.string()));
+
+	// Assets are renamed and deleted by the editor while their meshes are mapped
+	std::error_code error;
+	std::filesystem::rename(path, renamedPath, error);
+	CHECK(!error);
+
+	CHECK(std::filesystem::remove(renamedPath, error));
+	CHECK(!error);
+
+	// The mapping stays readable until it is closed
+	REQUIRE(file.IsOpen());
+	CHECK(std::memcmp(file.GetData(), "mapped content", 14) == 0);
+	file.Close();
+
+	// Then the path can be written again
+	directory.WriteFile("Renamed.mesh", "new content");
+	REQUIRE(file.Open(renamedPath.string()));
+	CHECK(std::memcmp(file.GetData(), "new content", 11) == 0);
+}
+
+namespace
+{
+	//	Memory of the process in RAM, file-backed pages of the mappings included
+	size_t GetResidentBytes()
+	{
+#ifdef _WIN32
+		PROCESS_MEMORY_COUNTERS counters = {};
+		GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+		return counters.WorkingSetSize;
+#else
+		size_t pages = 0, residentPages = 0;
+		std::ifstream statm("/proc/self/statm");
+		statm >> pages >> residentPages;
+		return residentPages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+	}
+
+	std::string Megabytes(size_t bytes)
+	{
+		return std::to_string(bytes / (1024 * 1024)) + " MB";
+	}
+
+	struct StreamHeader
+	{
+		uint64_t vertexCount;
+		uint64_t indexCount;
+		uint64_t verticesOffset;
+		uint64_t indicesOffset;
+	};
+}
+
+//	Load of a large mesh file up to the staging memory : reads in vectors then a copy, as the previous mesh format,
+//	against a mapping whose streams are copied in place. The page cache is warm, the file has just been written.
+BENCHMARK("MappedFile - Large mesh load against stream reads")
+{
+	constexpr uint64_t VertexCount = 1500000;
+	constexpr uint64_t IndexCount = 4500000;
+
+	Tests::TemporaryDirectory directory("MappedFileBenchmark");
+	const std::string path = (directory.Path() / "Large.mesh").string();
+
+	StreamHeader header = { VertexCount, IndexCount, 0, 0 };
+	header.verticesOffset = 64;
+	header.indicesOffset = header.verticesOffset + VertexCount * sizeof(Vertex);
+	const size_t streamsSize = VertexCount * sizeof(Vertex) + IndexCount * sizeof(int);
+	{
+		std::vector<char> content(header.verticesOffset + streamsSize);
+		std::memcpy(content.data(), &header, sizeof(header));
+		for (size_t i = header.verticesOffset; i < content.size(); ++i)
+			content[i] = static_cast<char>(i * 31);
+
+		std::ofstream file(path, std::ios::binary);
+		file.write(content.data(), static_cast<std::streamsize>(content.size()));
+	}
+
+	// Stands for the upload queue ring, allocated and touched before any measure
+	std::vector<unsigned char> staging(streamsSize, 1);
+
+	auto readStreams = [&]() {
+		std::ifstream file(path, std::ios::binary);
+		StreamHeader read;
+		file.read(reinterpret_cast<char*>(&read), sizeof(read));
+
+		std::vector<Vertex> vertices(read.vertexCount);
+		std::vector<int> indices(read.indexCount);
+		file.seekg(static_cast<std::streamoff>(read.verticesOffset));
+		file.read(reinterpret_cast<char*>(vertices.data()), static_cast<std::streamsize>(vertices.size() * sizeof(Vertex)));
+		file.read(reinterpret_cast<char*>(indices.data()), static_cast<std::streamsize>(indices.size() * sizeof(int)));
+
+		std::memcpy(staging.data(), vertices.data(), vertices.size() * sizeof(Vertex));
+		std::memcpy(staging.data() + vertices.size() * sizeof(Vertex), indices.data(), indices.size() * sizeof(int));
+
+		const size_t resident = GetResidentBytes();
+		Tests::DoNotOptimize(vertices);
+		return resident;
+		};
+
+	auto mapStreams = [&]() {
+		MappedFile file;
+		file.Open(path);
+		const StreamHeader* mapped = file.View<StreamHeader>(0);
+
+		const Vertex* vertices = file.View<Vertex>(mapped->verticesOffset, mapped->vertexCount);
+		const int* indices = file.View<int>(mapped->indicesOffset, mapped->indexCount);
+		std::memcpy(staging.data(), vertices, mapped->vertexCount * sizeof(Vertex));
+		std::memcpy(staging.data() + mapped->vertexCount * sizeof(Vertex), indices, mapped->indexCount * sizeof(int));
+
+		return GetResidentBytes();
+		};
+
+	// Resident memory while the loaded streams are held, the mapped pages are clean and can be dropped by the OS
+	size_t before = GetResidentBytes();
+	const size_t readGrowth = std::max(readStreams(), before) - before;
+	before = GetResidentBytes();
+	const size_t mapGrowth = std::max(mapStreams(), before) - before;
+
+	const std::string note = std::to_string(VertexCount) + " vertices, " + std::to_string(IndexCount) + " indices";
+	Tests::Report("ifstream reads in vectors, then staged", Tests::Measure(readStreams, 1, 5), note + ", resident +" + Megabytes(readGrowth) + " private");
+	Tests::Report("Mapped file staged in place", Tests::Measure(mapStreams, 1, 5), note + ", resident +" + Megabytes(mapGrowth) + " file-backed");
+}
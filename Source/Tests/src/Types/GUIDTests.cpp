@@ -0,0 +1,185 @@
+#include "TestFramework.hpp"
+
+#include <span>
+#include <cctype>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include <string>
+#include <random>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <unordered_set>
+
+#ifdef _WIN32
+#include <objbase.h>
+#pragma comment(lib, "Ole32.lib")
+#endif
+
+#include "Types/GUID.hpp"
+
+TEST_CASE("GUID - Version 4 and variant bits")
+{
+	std::vector<HYGUID> guids(10000);
+	HYGUID::NewMany(guids);
+
+	for (const HYGUID& guid : guids)
+	{
+		CHECK((guid.Bytes()[6] & 0xF0) == 0x40);
+		CHECK((guid.Bytes()[8] & 0xC0) == 0x80);
+	}
+}
+
+TEST_CASE("GUID - No duplicate across threads")
+{
+	constexpr int ThreadCount = 8;
+	constexpr size_t PerThread = 100000;
+
+	std::vector<std::vector<HYGUID>> generated(ThreadCount, std::vector<HYGUID>(PerThread));
+
+	std::vector<std::thread> threads;
+	for (int t = 0; t < ThreadCount; ++t)
+	{
+		threads.emplace_back([&generated, t]()
+			{
+				//	Half with the batch API, half one by one
+				HYGUID::NewMany(std::span<HYGUID>(generated[t]).first(PerThread / 2));
+				for (size_t i = PerThread / 2; i < PerThread; ++i)
+					generated[t][i] = HYGUID::NewGUID();
+			});
+	}
+
+	for (std::thread& thread : threads)
+		thread.join();
+
+	std::unordered_set<HYGUID> unique;
+	for (const std::vector<HYGUID>& guids : generated)
+		unique.insert(guids.begin(), guids.end());
+
+	CHECK(unique.size() == ThreadCount * PerThread);
+}
+
+TEST_CASE("GUID - String round trip")
+{
+	std::vector<HYGUID> guids(1000);
+	HYGUID::NewMany(guids);
+
+	for (const HYGUID& guid : guids)
+	{
+		std::string string = guid;
+		REQUIRE(string.size() == 36);
+		CHECK(string[8] == '-' && string[13] == '-' && string[18] == '-' && string[23] == '-');
+		CHECK(HYGUID(string) == guid);
+
+		//	Undashed, upper case and dashes at other places parse to the same GUID
+		std::string hex = string;
+		std::erase(hex, '-');
+		CHECK(HYGUID(hex) == guid);
+
+		std::string upper = string;
+		std::transform(upper.begin(), upper.end(), upper.begin(), [](char c) { return static_cast<char>(std::toupper(c)); });
+		CHECK(HYGUID(upper) == guid);
+
+		CHECK(HYGUID(hex.substr(0, 4) + "-" + hex.substr(4)) == guid);
+	}
+
+	CHECK(std::string(HYGUID(std::array<unsigned char, 16>{ 0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef, 0xfe, 0xdc, 0xba, 0x98, 0x76, 0x54, 0x32, 0x10 }))
+		== "01234567-89ab-cdef-fedc-ba9876543210");
+}
+
+TEST_CASE("GUID - Invalid strings give the zero GUID")
+{
+	const HYGUID zero;
+
+	CHECK(HYGUID("") == zero);
+	CHECK(HYGUID("0") == zero);
+	CHECK(HYGUID("0123456789abcdef0123456789abcdeg") == zero);
+	CHECK(HYGUID("01234567-89ab-cdef-fedc-ba987654321z") == zero);
+	CHECK(HYGUID("01234567-89ab-cdef-fedc-ba9876543210ff") == zero);
+	CHECK(HYGUID("01234567 89ab cdef fedc ba9876543210") == zero);
+}
+
+namespace
+{
+	//	Formatting of the original crossguid implementation, through a string stream
+	std::string FormatWithStream(const HYGUID& guid)
+	{
+		const auto& bytes = guid.Bytes();
+
+		std::stringstream stream;
+		stream << std::hex << std::setfill('0');
+		for (size_t i = 0; i < bytes.size(); ++i)
+		{
+			stream << std::setw(2) << static_cast<int>(bytes[i]);
+			if (i == 3 || i == 5 || i == 7 || i == 9)
+				stream << '-';
+		}
+
+		return stream.str();
+	}
+}
+
+//	GUID generation against an OS call per GUID, and string parsing and formatting against the generic scalar paths
+BENCHMARK("GUID - Generation, parsing and formatting")
+{
+	constexpr size_t Count = 100000;
+	std::vector<HYGUID> guids(Count);
+
+	Tests::Report("NewGUID", Tests::Measure([&]() { for (HYGUID& guid : guids) guid = HYGUID::NewGUID(); }, Count));
+	Tests::Report("NewMany", Tests::Measure([&]() { HYGUID::NewMany(guids); }, Count));
+
+#ifdef _WIN32
+	//	Previous implementation
+	Tests::Report("CoCreateGuid", Tests::Measure([&]()
+		{
+			for (HYGUID& guid : guids)
+			{
+				GUID newGuid;
+				(void)CoCreateGuid(&newGuid);
+				std::array<unsigned char, 16> bytes;
+				std::memcpy(bytes.data(), &newGuid, bytes.size());
+				guid = HYGUID(bytes);
+			}
+		}, Count));
+#else
+	//	No CoCreateGuid outside Windows, an OS entropy request per GUID is the closest equivalent
+	std::random_device device;
+	Tests::Report("std::random_device per GUID", Tests::Measure([&]()
+		{
+			for (HYGUID& guid : guids)
+			{
+				std::array<unsigned char, 16> bytes;
+				for (size_t i = 0; i < bytes.size(); i += 4)
+				{
+					unsigned int value = device();
+					std::memcpy(bytes.data() + i, &value, sizeof(value));
+				}
+				guid = HYGUID(bytes);
+			}
+		}, Count, 2));
+#endif
+
+	HYGUID::NewMany(guids);
+	std::vector<std::string> strings;
+	std::vector<std::string> genericStrings;
+	for (const HYGUID& guid : guids)
+	{
+		strings.emplace_back(guid);
+
+		//	A dash out of the canonical places goes through the generic character by character parser
+		std::string generic = strings.back();
+		std::erase(generic, '-');
+		genericStrings.emplace_back(generic.substr(0, 4) + "-" + generic.substr(4));
+	}
+
+	HYGUID parsed;
+	Tests::Report("Parse canonical string", Tests::Measure([&]() { for (const std::string& string : strings) parsed = HYGUID(string); }, Count));
+	Tests::Report("Parse with the generic path", Tests::Measure([&]() { for (const std::string& string : genericStrings) parsed = HYGUID(string); }, Count));
+	Tests::DoNotOptimize(parsed);
+
+	size_t length = 0;
+	Tests::Report("Format", Tests::Measure([&]() { for (const HYGUID& guid : guids) length += std::string(guid).size(); }, Count));
+	Tests::Report("Format with a string stream", Tests::Measure([&]() { for (const HYGUID& guid : guids) length += FormatWithStream(guid).size(); }, Count));
+	Tests::DoNotOptimize(length);
+}
@@ -0,0 +1,6 @@
+#include "TestFramework.hpp"
+
+int main(int argc, char** argv)
+{
+	return Tests::Run(argc, argv) == 0 ? 0 : 1;
+}